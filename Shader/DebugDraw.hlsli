@@ -0,0 +1,8 @@
+#include "Constants.hlsli"
+
+// ShapeRenderer::Flush ̃fobO`p (F͒_ECX^XƂɎ)
+struct DEBUG_DRAW_VS_OUT
+{
+    float4 position : SV_POSITION;
+    float4 color : COLOR;
+};
@@ -0,0 +1,6 @@
+#include "DebugDraw.hlsli"
+
+float4 main(DEBUG_DRAW_VS_OUT pin) : SV_TARGET
+{
+    return pin.color;
+}
@@ -0,0 +1,10 @@
+#include "DebugDraw.hlsli"
+
+// E_
+DEBUG_DRAW_VS_OUT main(float4 position : POSITION, float4 color : COLOR)
+{
+    DEBUG_DRAW_VS_OUT vout;
+    vout.position = mul(float4(position.xyz, 1), viewProjection);
+    vout.color = color;
+    return vout;
+}
@@ -0,0 +1,10 @@
+#include "DebugDraw.hlsli"
+
+// E~EȂǂ̌` (1 ނ̌` 1 ̃CX^X`ł܂Ƃ߂ĕ`)
+DEBUG_DRAW_VS_OUT main(float4 position : POSITION, row_major float4x4 instanceWorld : INSTANCE_WORLD, float4 instanceColor : INSTANCE_COLOR)
+{
+    DEBUG_DRAW_VS_OUT vout;
+    vout.position = mul(float4(position.xyz, 1), mul(instanceWorld, viewProjection));
+    vout.color = instanceColor;
+    return vout;
+}
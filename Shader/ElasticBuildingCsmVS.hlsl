@@ -74,6 +74,7 @@ float3 SafeNormalize(float3 v, float3 fallback)
 
 VS_OUT_CSM main(VS_IN vin, uint instanceId : SV_INSTANCEID)
 {
+    DecodePosition(vin.position);
     VS_OUT_CSM vout;
     
     // @ f[h
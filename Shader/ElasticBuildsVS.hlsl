@@ -47,6 +47,7 @@ float3 SafeNormalize(float3 v, float3 fallback)
 
 VS_OUT main(VS_IN vin)
 {
+    DecodeVertex(vin.position, vin.normal, vin.tangent);
     VS_OUT vout;
     float sigma = vin.tangent.w;
 
@@ -25,6 +25,18 @@ struct INSTANCE_VS_IN
     row_major float4x4 instance_matrix : INSTANCE_MATRIX;
 };
 
+// SceneRenderer ł܂Ƃ߂CX^X` (2 ԃXbgCX^XƂ̃f[^)
+struct AUTO_INSTANCE_VS_IN
+{
+    float4 position : POSITION;
+    float4 normal : NORMAL;
+    float4 tangent : TANGENT;
+    float2 texcoord : TEXCOORD;
+    row_major float4x4 instanceWorld : INSTANCE_WORLD;
+    float4 instanceColor : INSTANCE_COLOR;
+    float4 instanceParameters : INSTANCE_PARAMETERS; // x : emission, y : dissolve
+};
+
 struct VS_OUT
 {
     float4 position : SV_POSITION;
@@ -46,9 +58,53 @@ cbuffer PRIMITIVE_CONSTANT_BUFFER : register(b0)
     float dissolveValue;//fB]up
     
     float emission;
-    float3 pads;
+    uint vertexFlags; // VERTEX_FORMAT_* (VertexFormat::ShaderFlags)
+    float2 pads;
     
     row_major float4x4 invWorld;
+    
+    // ʎqʒu̕ (position = unorm * positionScale + positionOffset)
+    float4 positionScale;
+    float4 positionOffset;
+}
+
+// _tH[}bg (VertexFormat::ShaderFlag Ƒ)
+// 0 Ȃ] float ̒_
+static const uint VERTEX_FORMAT_QUANTIZED_POSITION = 0x01;
+static const uint VERTEX_FORMAT_OCTAHEDRAL_NORMAL = 0x02;
+static const uint VERTEX_FORMAT_OCTAHEDRAL_TANGENT = 0x04;
+
+// ʑ̃GR[hPʃxNg߂
+float3 OctDecode(float2 e)
+{
+    float3 v = float3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-v.z);
+    v.xy += float2(v.x >= 0.0 ? -t : t, v.y >= 0.0 ? -t : t);
+    return normalize(v);
+}
+
+void DecodePosition(inout float4 position)
+{
+    if (vertexFlags & VERTEX_FORMAT_QUANTIZED_POSITION)
+    {
+        position.xyz = position.xyz * positionScale.xyz + positionOffset.xyz;
+    }
+    position.w = 1;
+}
+
+// ̓AZu float ɂȂʎqς݂̑߂
+void DecodeVertex(inout float4 position, inout float4 normal, inout float4 tangent)
+{
+    DecodePosition(position);
+    if (vertexFlags & VERTEX_FORMAT_OCTAHEDRAL_NORMAL)
+    {
+        normal = float4(OctDecode(normal.xy), 0);
+    }
+    if (vertexFlags & VERTEX_FORMAT_OCTAHEDRAL_TANGENT)
+    {
+        // z ɏ]ڐ̕
+        tangent = float4(OctDecode(tangent.xy), tangent.z < 0.0 ? -1.0 : 1.0);
+    }
 }
 
 //cbuffer SCENE_CONSTANT_BUFFER : register(b1)
@@ -0,0 +1,34 @@
+// CASCADED_SHADOW_MAPS
+#include "GltfModel.hlsli"
+
+struct CsmConstants
+{
+    row_major float4x4 cascadedMatrices[4];
+    float4 cascadedPlaneDistances;
+};
+
+cbuffer csmConstants : register(b3)
+{
+    CsmConstants csmData;
+}
+
+// CASCADED_SHADOW_MAPS
+struct VS_OUT_CSM
+{
+    float4 position : SV_POSITION;
+    uint instanceId : INSTANCEID;
+};
+
+// SceneRenderer ̎CX^X`p
+// CX^X (܂Ƃ߂ x 4)BCX^XƂ̃f[^ 4 CX^X 1 i (InstanceDataStepRate = 4) ̂ŁA
+// SV_INSTANCEID ̉ʂJXP[h̔ԍɂȂ
+VS_OUT_CSM main(float4 position : POSITION, row_major float4x4 instanceWorld : INSTANCE_WORLD, uint instanceId : SV_INSTANCEID)
+{
+    DecodePosition(position);
+    VS_OUT_CSM voutCSM;
+
+    const uint cascade = instanceId % 4;
+    voutCSM.instanceId = cascade;
+    voutCSM.position = mul(position, mul(instanceWorld, csmData.cascadedMatrices[cascade]));
+    return voutCSM;
+}
@@ -0,0 +1,25 @@
+#include "GltfModel.hlsli"
+
+// SceneRenderer ̎CX^X`p (GltfModelStaticBatchingVS  world CX^XƂ̍sɂ)
+// 萔obt@ world ͎gȂB_tH[}bg̕ (positionScale Ȃ) ͒萔obt@ǂ
+VS_OUT main(AUTO_INSTANCE_VS_IN vsIn)
+{
+    DecodeVertex(vsIn.position, vsIn.normal, vsIn.tangent);
+    VS_OUT vout;
+
+    row_major float4x4 instanceWorld = vsIn.instanceWorld;
+
+    float4 position = float4(vsIn.position.xyz, 1);
+    vout.position = mul(position, mul(instanceWorld, viewProjection));
+    vout.wPosition = mul(position, instanceWorld);
+
+    vout.wNormal = normalize(mul(float4(vsIn.normal.xyz, 0), instanceWorld));
+
+    float sigma = vsIn.tangent.w;
+    vout.wTangent = normalize(mul(float4(vsIn.tangent.xyz, 0), instanceWorld));
+    vout.wTangent.w = sigma;
+
+    vout.texcoord = vsIn.texcoord;
+
+    return vout;
+}
@@ -28,6 +28,7 @@ struct GS_OUTPUT_CSM
 
 VS_OUT_CSM main(VS_IN vin, uint instanceId : SV_INSTANCEID)
 {
+    DecodePosition(vin.position);
     VS_OUT_CSM vout;
     
 #if 0
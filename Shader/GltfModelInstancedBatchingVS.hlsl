@@ -2,6 +2,7 @@
 
 VS_OUT main(INSTANCE_VS_IN vsIn)
 {
+    DecodeVertex(vsIn.position, vsIn.normal, vsIn.tangent);
     VS_OUT vsOut;
     
     //float4x4 worldTransform = mul(world, vsIn.instance_matrix);
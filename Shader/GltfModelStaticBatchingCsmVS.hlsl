@@ -28,6 +28,7 @@ struct GS_OUTPUT_CSM
 
 VS_OUT_CSM main(float4 position : POSITION, uint instanceId : SV_INSTANCEID)
 {
+    DecodePosition(position);
     VS_OUT_CSM voutCSM;
     VS_OUT vout;
     
@@ -2,6 +2,7 @@
 
 VS_OUT main(float4 position : POSITION, float4 normal : NORMAL, float4 tangent : TANGENT, float2 texcoord : TEXCOORD)
 {
+    DecodeVertex(position, normal, tangent);
     VS_OUT vout;
 
     position.w = 1;
@@ -2,6 +2,7 @@
 
 VS_OUT main(VS_IN vin)
 {
+    DecodeVertex(vin.position, vin.normal, vin.tangent);
     float sigma = vin.tangent.w;
     
     if (skin > -1)
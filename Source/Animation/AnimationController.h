@@ -9,6 +9,7 @@
 // vWFNg̑̃wb_
 #include "Components/Render/MeshComponent.h"
 #include "Graphics/Resource/InterleavedGltfModel.h"
+#include "Engine/Debug/Profiler.h"
 
 // Aj[ṼRg[[  
 class AnimationController
@@ -56,6 +57,7 @@ public:
 
     void OnUpdate(float deltaTime)
     {
+        PROFILE_ZONE("AnimationController::OnUpdate", "animation");
         animationTime += deltaTime * animationRate;
 
         if (target_->model->animations.size() == 0)
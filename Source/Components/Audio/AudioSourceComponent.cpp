@@ -3,6 +3,9 @@
 #include <Windows.h>
 #include <winerror.h>
 
+#include <algorithm>
+#include <cfloat>
+
 #ifdef X3DAUDIO
 #include "../../Core/Actor.h"  
 #endif // X3DAUDIO
@@ -107,6 +110,280 @@ void Audio::CreateAudioSource(std::shared_ptr<AudioBuffer> buffer,
 	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 }
 
+// XAudio2 ̃\[X{CXŖ炷foCX
+class XAudio2VoiceDevice : public AudioVoiceDevice
+{
+public:
+	~XAudio2VoiceDevice() override
+	{
+		for (Voice& voice : voices)
+		{
+			if (voice.sourceVoice)
+			{
+				voice.sourceVoice->DestroyVoice();
+			}
+		}
+	}
+
+	uint32_t CreateVoice(const VoiceClip& clip, SoundType type) override
+	{
+		XAUDIO2_SEND_DESCRIPTOR send = { 0, Audio::submixVoices[type] };
+		XAUDIO2_VOICE_SENDS sends = { 1, &send };
+		IXAudio2SourceVoice* sourceVoice = nullptr;
+		// 3D ̎ՕŃ[pX|̂ŃtB^[g悤ɂĂ
+		HRESULT hr = Audio::xaudio2->CreateSourceVoice(&sourceVoice, static_cast<const WAVEFORMATEX*>(clip.nativeFormat), XAUDIO2_VOICE_USEFILTER,
+			XAUDIO2_DEFAULT_FREQ_RATIO, nullptr, &sends, nullptr);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		if (FAILED(hr))
+		{
+			return InvalidVoice;
+		}
+		Voice voice;
+		voice.sourceVoice = sourceVoice;
+		voice.destination = Audio::submixVoices[type];
+		voice.channels = clip.format.channels;
+		voice.samplesPerSec = clip.format.samplesPerSec;
+		if (!freeVoices.empty())
+		{
+			const uint32_t index = freeVoices.back();
+			freeVoices.pop_back();
+			voices[index] = voice;
+			return index;
+		}
+		voices.push_back(voice);
+		return static_cast<uint32_t>(voices.size() - 1);
+	}
+
+	void DestroyVoice(uint32_t voice) override
+	{
+		voices[voice].sourceVoice->DestroyVoice();
+		voices[voice] = {};
+		freeVoices.push_back(voice);
+	}
+
+	bool Start(uint32_t voice, const VoiceClip& clip, float volume, uint32_t loopCount, uint32_t beginFrame) override
+	{
+		IXAudio2SourceVoice* sourceVoice = voices[voice].sourceVoice;
+		// O 3D Ŗ炵ȂAóEgEtB^[ɖ߂
+		if (voices[voice].isSpatial)
+		{
+			SetSpatial(voice, {});
+			voices[voice].isSpatial = false;
+		}
+
+		// L AudioBuffer::buffer ͏ɁA炷xɃobt@̐ݒ
+		XAUDIO2_BUFFER buffer = {};
+		buffer.AudioBytes = clip.bytes;
+		buffer.pAudioData = clip.data;
+		buffer.Flags = XAUDIO2_END_OF_STREAM;
+		buffer.PlayBegin = beginFrame;
+		buffer.LoopCount = loopCount;
+		if (loopCount > 0)
+		{
+			buffer.LoopBegin = clip.loopBegin;
+			buffer.LoopLength = clip.loopLength;
+		}
+
+		HRESULT hr = sourceVoice->SetVolume(volume);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		hr = sourceVoice->SubmitSourceBuffer(&buffer);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		if (FAILED(hr))
+		{
+			return false;
+		}
+		hr = sourceVoice->Start(0);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		return SUCCEEDED(hr);
+	}
+
+	void Stop(uint32_t voice) override
+	{
+		HRESULT hr = voices[voice].sourceVoice->Stop(0);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		hr = voices[voice].sourceVoice->FlushSourceBuffers();
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	}
+
+	bool IsPlaying(uint32_t voice) override
+	{
+		XAUDIO2_VOICE_STATE voiceState{};
+		voices[voice].sourceVoice->GetState(&voiceState, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		return voiceState.BuffersQueued > 0;
+	}
+
+	void SetVolume(uint32_t voice, float volume) override
+	{
+		HRESULT hr = voices[voice].sourceVoice->SetVolume(volume);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	}
+
+	void SetSpatial(uint32_t voice, const VoiceSpatial& spatial) override
+	{
+		Voice& target = voices[voice];
+		target.isSpatial = true;
+		IXAudio2SourceVoice* sourceVoice = target.sourceVoice;
+
+		HRESULT hr = sourceVoice->SetVolume(spatial.volume);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+		// Tu~bNX{CX̓XeI (Audio::Initialize)AXeỈ͍Ê܂ܑ
+		float matrix[4] = {};
+		if (target.channels == 1)
+		{
+			matrix[0] = spatial.left;
+			matrix[1] = spatial.right;
+		}
+		else
+		{
+			matrix[0] = spatial.left;
+			matrix[3] = spatial.right;
+		}
+		if (target.channels <= 2)
+		{
+			hr = sourceVoice->SetOutputMatrix(target.destination, target.channels, 2, matrix);
+			_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		}
+
+		hr = sourceVoice->SetFrequencyRatio((std::clamp)(spatial.frequencyRatio, XAUDIO2_MIN_FREQ_RATIO, XAUDIO2_DEFAULT_FREQ_RATIO));
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+		XAUDIO2_FILTER_PARAMETERS filter = { LowPassFilter, XAUDIO2_MAX_FILTER_FREQUENCY, 1.0f };
+		if (spatial.lowPassFrequency > 0.0f)
+		{
+			filter.Frequency = (std::min)(XAudio2CutoffFrequencyToRadians(spatial.lowPassFrequency, target.samplesPerSec), XAUDIO2_MAX_FILTER_FREQUENCY);
+		}
+		hr = sourceVoice->SetFilterParameters(&filter);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	}
+
+private:
+	struct Voice
+	{
+		IXAudio2SourceVoice* sourceVoice = nullptr;
+		IXAudio2Voice* destination = nullptr;
+		uint32_t channels = 0;
+		uint32_t samplesPerSec = 0;
+		bool isSpatial = false;
+	};
+	std::vector<Voice> voices;
+	std::vector<uint32_t> freeVoices;
+};
+
+// XAudio2 ̃\[X{CXŃXg[炷 (obt@Iǂݍ݂̃XbhN)
+class XAudio2StreamVoice : public AudioStreamVoice, public IXAudio2VoiceCallback
+{
+public:
+	XAudio2StreamVoice(const VoiceFormat& format, SoundType type)
+	{
+		WAVEFORMATEX wfx = {};
+		wfx.wFormatTag = format.formatTag;
+		wfx.nChannels = format.channels;
+		wfx.nSamplesPerSec = format.samplesPerSec;
+		wfx.nAvgBytesPerSec = format.samplesPerSec * format.blockAlign;
+		wfx.nBlockAlign = format.blockAlign;
+		wfx.wBitsPerSample = format.bitsPerSample;
+
+		XAUDIO2_SEND_DESCRIPTOR send = { 0, Audio::submixVoices[type] };
+		XAUDIO2_VOICE_SENDS sends = { 1, &send };
+		HRESULT hr = Audio::xaudio2->CreateSourceVoice(&voice, &wfx, 0, XAUDIO2_DEFAULT_FREQ_RATIO, this, &sends, nullptr);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	}
+	~XAudio2StreamVoice() override
+	{
+		if (voice)
+		{
+			voice->DestroyVoice();
+		}
+	}
+
+	bool IsValid() const { return voice != nullptr; }
+
+	bool Submit(const uint8_t* data, uint32_t bytes, bool isEndOfStream) override
+	{
+		XAUDIO2_BUFFER buffer = {};
+		buffer.AudioBytes = bytes;
+		buffer.pAudioData = data;
+		buffer.Flags = isEndOfStream ? XAUDIO2_END_OF_STREAM : 0;
+		HRESULT hr = voice->SubmitSourceBuffer(&buffer);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		return SUCCEEDED(hr);
+	}
+
+	uint32_t GetQueuedCount() override
+	{
+		XAUDIO2_VOICE_STATE voiceState{};
+		voice->GetState(&voiceState, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		return voiceState.BuffersQueued;
+	}
+
+	void Start() override
+	{
+		HRESULT hr = voice->Start(0);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	}
+
+	void Stop() override
+	{
+		HRESULT hr = voice->Stop(0);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		hr = voice->FlushSourceBuffers();
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		// ̂Ăobt@͎̏ŊÔŁAO܂ő҂Ăobt@g
+		for (int i = 0; i < 100 && GetQueuedCount() > 0; ++i)
+		{
+			Sleep(1);
+		}
+	}
+
+	void SetVolume(float volume) override
+	{
+		HRESULT hr = voice->SetVolume(volume);
+		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	}
+
+	void SetBufferEndCallback(std::function<void()> callback) override { bufferEnd = std::move(callback); }
+
+	// IXAudio2VoiceCallback (XAudio2 ̏XbhĂ΂)
+	void STDMETHODCALLTYPE OnBufferEnd(void*) override
+	{
+		if (bufferEnd)
+		{
+			bufferEnd();
+		}
+	}
+	void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+	void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+	void STDMETHODCALLTYPE OnStreamEnd() override {}
+	void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+	void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+	void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+private:
+	IXAudio2SourceVoice* voice = nullptr;
+	std::function<void()> bufferEnd;
+};
+
+std::unique_ptr<AudioStream> Audio::CreateStream(const wchar_t* filePath, SoundType type)
+{
+	_ASSERT_EXPR(xaudio2, L"Audio::Initialize has not been called");
+	std::unique_ptr<AudioStream> stream = std::make_unique<AudioStream>(filePath, [type](const VoiceFormat& format) -> std::unique_ptr<AudioStreamVoice>
+		{
+			std::unique_ptr<XAudio2StreamVoice> voice = std::make_unique<XAudio2StreamVoice>(format, type);
+			if (!voice->IsValid())
+			{
+				return nullptr;
+			}
+			return voice;
+		});
+	if (!stream->IsValid())
+	{
+		OutputDebugStringA(("Audio::CreateStream : " + stream->GetError() + "\n").c_str());
+	}
+	_ASSERT_EXPR(stream->IsValid(), L"Xg[J܂łB");
+	return stream;
+}
+
 void Audio::Initialize()
 {
 	HRESULT hr;
@@ -132,10 +409,21 @@ void Audio::Initialize()
 
 	X3DAudioInitialize(channelMask, X3DAUDIO_SPEED_OF_SOUND, x3dAudioHandle);
 #endif // X3DAUDIO
+
+	// ʉ̐̃v[ (̓Tu~bNX{CXɑ̂ŁAɍ)
+	voicePool.reset();
+	voiceDevice = std::make_unique<XAudio2VoiceDevice>();
+	voicePool = std::make_unique<AudioVoicePool>(voiceDevice.get());
+	// 3D ̉̓v[琺؂
+	spatializer = std::make_unique<AudioSpatializer>(voicePool.get());
+	hasListener = false;
 }
 
 Audio::~Audio()
 {
+	spatializer.reset();
+	voicePool.reset();
+	voiceDevice.reset();
 	masterVoice->DestroyVoice();
 	submixVoices[0]->DestroyVoice();
 	submixVoices[1]->DestroyVoice();
@@ -189,137 +477,160 @@ std::shared_ptr<Audio::AudioBuffer> Audio::AudioBuffer::GetResource(const wchar_
 		audioBuffer->buffer.pAudioData = data; //buffer containing audio data
 		audioBuffer->buffer.Flags = XAUDIO2_END_OF_STREAM; // tell the source voice not to expect any data after this buffer
 
+		const WAVEFORMATEX& format = audioBuffer->wfx.Format;
+		VoiceClip& clip = audioBuffer->clip;
+		clip.format = { format.wFormatTag, format.nChannels, format.nSamplesPerSec, format.wBitsPerSample, format.nBlockAlign };
+		clip.nativeFormat = &audioBuffer->wfx;
+		clip.data = data;
+		clip.bytes = chunkSize;
+		clip.seconds = format.nAvgBytesPerSec ? static_cast<float>(chunkSize) / format.nAvgBytesPerSec : 0.0f;
+
 		resources[filePath] = audioBuffer;
 		return audioBuffer;
 	}
 }
 
-void Audio::PlayOneShot(const wchar_t* filePath, float volume)
+SoundType Audio::GetSoundType(const wchar_t* filePath)
+{
+	return std::wstring(filePath).find(L"BGM") != std::wstring::npos ? SoundType::BGM : SoundType::SE;
+}
+
+AudioVoicePool::Handle Audio::PlayOneShot(const wchar_t* filePath, float volume, int priority, float distance)
 {
-	std::shared_ptr<StandaloneAudioSource> source = std::make_shared<StandaloneAudioSource>(filePath);
-	source->SetVolume(volume);
-	source->Play();
-	audioSources.emplace_back(source);
+	_ASSERT_EXPR(voicePool, L"Audio::Initialize has not been called");
+	std::shared_ptr<AudioBuffer> audioBuffer = AudioBuffer::GetResource(filePath);
+	AudioVoicePool::PlayParams params;
+	params.volume = volume;
+	params.priority = priority;
+	params.distance = distance;
+	// ĂԂ̓obt@Ȃ悤Ɏ
+	const VoiceClip& clip = audioBuffer->clip;
+	return voicePool->Play(clip, GetSoundType(filePath), params, std::move(audioBuffer));
+}
+
+void Audio::PrewarmOneShot(const wchar_t* filePath, uint32_t count)
+{
+	_ASSERT_EXPR(voicePool, L"Audio::Initialize has not been called");
+	std::shared_ptr<AudioBuffer> audioBuffer = AudioBuffer::GetResource(filePath);
+	voicePool->Prewarm(audioBuffer->clip, GetSoundType(filePath), count);
 }
 
 void Audio::Update(float deltaTime)
 {
-	//j
-	for (auto& source : audioSources)
+	//Iv[ɖ߂
+	if (voicePool)
 	{
-		if (!source->IsPlaying())
-		{
-			erases.emplace_back(source);
-		}
+		voicePool->Update(deltaTime);
 	}
-	audioSources.erase(std::remove_if(audioSources.begin(), audioSources.end(),
-		[&](const auto& audioSource) {
-			return std::find(erases.begin(), erases.end(), audioSource) != erases.end();
-		}), 
-		audioSources.end());
-	erases.clear();
+	//3D ̉܂Ƃ߂ČvZāA鉹ɐt
+	if (spatializer)
+	{
+		spatializer->Update(listener, deltaTime);
+	}
+	listenerDeltaTime = deltaTime;
+}
+
+void Audio::SetListener(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& front, const DirectX::XMFLOAT3& up)
+{
+	// ͑Õt[̈ړ (J؂ւĔ񂾎́Ag̔̏ŗ})
+	if (hasListener && listenerDeltaTime > 0.0f)
+	{
+		listener.velocity = {
+			(position.x - listener.position.x) / listenerDeltaTime,
+			(position.y - listener.position.y) / listenerDeltaTime,
+			(position.z - listener.position.z) / listenerDeltaTime };
+	}
+	else
+	{
+		listener.velocity = { 0.0f, 0.0f, 0.0f };
+	}
+	listener.position = position;
+	listener.front = front;
+	listener.up = up;
+	hasListener = true;
 }
 
 void AudioSourceComponent::SetSource(const wchar_t* filePath)
 {
+	Stop();
 	this->type = std::wstring(filePath).find(L"BGM") != std::wstring::npos ? SoundType::BGM : SoundType::SE;
 	this->filePath = filePath;
 	sptrBuffer = Audio::AudioBuffer::GetResource(filePath);
-	Audio::CreateAudioSource(Audio::AudioBuffer::GetResource(this->filePath), &sourceVoice, type);
+	clip = sptrBuffer->clip;
 }
 AudioSourceComponent::~AudioSourceComponent()
 {
 	Stop();
-	sourceVoice->DestroyVoice();
 }
 
 void AudioSourceComponent::Play(int loopCount)
 {
-	_ASSERT_EXPR(sourceVoice, L"\[Xݒ肳Ă܂B");
-
-	HRESULT hr;
+	_ASSERT_EXPR(sptrBuffer, L"\[Xݒ肳Ă܂B");
+	_ASSERT_EXPR(Audio::spatializer, L"Audio::Initialize has not been called");
 
 	Stop();
 
-	XAUDIO2_BUFFER* pBuffer = &sptrBuffer->buffer;
-
-	pBuffer->LoopCount = loopCount;
-	hr = sourceVoice->SubmitSourceBuffer(pBuffer);
-	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-
-	hr = sourceVoice->Start(0);
-	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	AudioEmitterSettings settings = spatialSettings;
+	if (type == SoundType::BGM)
+	{
+		// BGM  3D ɂȂ (ŌApƃhbv[|Ȃ)
+		settings.minDistance = settings.maxDistance = FLT_MAX;
+		settings.dopplerScale = 0.0f;
+	}
+	lastPosition = GetComponentLocation();
+	// ĂԂ̓obt@Ȃ悤Ɏ
+	emitter = Audio::spatializer->Play(clip, type, static_cast<uint32_t>(loopCount), lastPosition, settings, sptrBuffer);
 }
 
 void AudioSourceComponent::Stop(bool playTails, bool waitForBufferToUnqueue)
 {
-	XAUDIO2_VOICE_STATE voiceState{};
-	sourceVoice->GetState(&voiceState);
-	if (!voiceState.BuffersQueued)
+	// ̓v[ɕԂ (Ɏ~߂̂ playTails ͎gȂ)
+	if (Audio::spatializer && emitter != AudioSpatializer::InvalidEmitter)
 	{
-		return;
+		Audio::spatializer->Stop(emitter);
 	}
+	emitter = AudioSpatializer::InvalidEmitter;
+}
 
-	HRESULT hr;
-	hr = sourceVoice->Stop(playTails ? XAUDIO2_PLAY_TAILS : 0);
-	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-
-	hr = sourceVoice->FlushSourceBuffers();
-	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-
-	/*while (waitForBufferToUnqueue && voiceState.BuffersQueued)
+void AudioSourceComponent::SetVolume(float volume)
+{
+	spatialSettings.volume = volume;
+	if (Audio::spatializer)
 	{
-		sourceVoice->GetState(&voiceState);
-	}*/
+		Audio::spatializer->SetVolume(emitter, volume);
+	}
 }
 
-void AudioSourceComponent::SetVolume(float volume)
+void AudioSourceComponent::SetOcclusion(float occlusion)
 {
-	HRESULT hr = sourceVoice->SetVolume(volume);
-	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+	spatialSettings.occlusion = occlusion;
+	if (Audio::spatializer)
+	{
+		Audio::spatializer->SetOcclusion(emitter, occlusion);
+	}
 }
 
 uint32_t AudioSourceComponent::GetBufferQueueCount()
 {
-	XAUDIO2_VOICE_STATE voiceState{};
-	sourceVoice->GetState(&voiceState);
-	return voiceState.BuffersQueued;
+	// zĂԂĂ邱Ƃɂ
+	return Audio::spatializer && Audio::spatializer->IsPlaying(emitter) ? 1 : 0;
 }
 
 void AudioSourceComponent::Tick(float deltaTime)
 {
-	
-#ifdef X3DAUDIO
-	if (!AudioListenerComponent::currentActor.expired())
+	if (!Audio::spatializer || emitter == AudioSpatializer::InvalidEmitter)
 	{
-		std::shared_ptr<Actor> listenerActor = AudioListenerComponent::currentActor.lock();
-		X3DAUDIO_LISTENER listener{};
-		listener.OrientFront = { 0,0,1 };
-		listener.OrientTop = { 0,1,0 };
-		listener.Position = listenerActor->GetPosition();
-
-		X3DAUDIO_EMITTER emitter{};
-		emitter.Position = GetComponentLocation();
-		emitter.ChannelCount = 1;
-		emitter.CurveDistanceScaler = 1.0f;//J[ũXP[
-		emitter.pVolumeCurve = nullptr; //nullȂftHg̃J[uiɂČj
-
-		X3DAUDIO_DSP_SETTINGS dspSettings{};
-		FLOAT32 matrix[XAUDIO2_MAX_AUDIO_CHANNELS * 1] = {};
-		dspSettings.SrcChannelCount = 1;
-		dspSettings.DstChannelCount = 2;//XeIȂQ
-		dspSettings.pMatrixCoefficients = matrix;
-
-		X3DAudioCalculate(Audio::x3dAudioHandle, &listener, &emitter,
-			X3DAUDIO_CALCULATE_MATRIX | X3DAUDIO_CALCULATE_DOPPLER,
-			&dspSettings);
-
-		sourceVoice->SetOutputMatrix(Audio::masterVoice, 1, 2, matrix);
-		sourceVoice->SetFrequencyRatio(dspSettings.DopplerFactor); //hbv[
+		return;
 	}
-#endif // X3DAUDIO
-
-	
+	// ʒuƑ (hbv[) nAvZ Audio::Update ł܂Ƃ߂čs
+	const DirectX::XMFLOAT3 position = GetComponentLocation();
+	DirectX::XMFLOAT3 velocity = { 0.0f, 0.0f, 0.0f };
+	if (deltaTime > 0.0f)
+	{
+		velocity = { (position.x - lastPosition.x) / deltaTime, (position.y - lastPosition.y) / deltaTime, (position.z - lastPosition.z) / deltaTime };
+	}
+	lastPosition = position;
+	Audio::spatializer->SetPosition(emitter, position, velocity);
 }
 
 void AudioSourceComponent::DrawImGuiInspector()
@@ -345,13 +656,18 @@ void AudioSourceComponent::DrawImGuiInspector()
 		Stop();
 	}
 
-	static float volume;
-	if (sourceVoice)
+	if (ImGui::SliderFloat("Volume", &spatialSettings.volume, 0, 1)) {
+		SetVolume(spatialSettings.volume);
+	}
+	ImGui::DragFloatRange2("Distance", &spatialSettings.minDistance, &spatialSettings.maxDistance, 0.1f, 0.0f, 1000.0f);
+	if (ImGui::SliderFloat("Occlusion", &spatialSettings.occlusion, 0, 1)) {
+		SetOcclusion(spatialSettings.occlusion);
+	}
+	if (Audio::spatializer && Audio::spatializer->IsPlaying(emitter))
 	{
-		sourceVoice->GetVolume(&volume);
-		if (ImGui::SliderFloat("Volume", &volume, 0, 1)) {
-			sourceVoice->SetVolume(volume);
-		}
+		const AudioSpatializer::Result result = Audio::spatializer->GetResult(emitter);
+		ImGui::Text("Distance %.1f  Gain %.3f  L %.2f R %.2f  Doppler %.2f %s", result.distance, result.spatial.volume,
+			result.spatial.left, result.spatial.right, result.spatial.frequencyRatio, result.isVirtual ? "(virtual)" : "");
 	}
 
 	ImGui::Separator();
@@ -16,13 +16,9 @@
 #include "Engine/Utility/Win32Utils.h"
 
 #include "../Base/SceneComponent.h"
-
-enum SoundType
-{
-	BGM,
-	SE,
-	EnumCount
-};
+#include "AudioVoicePool.h"
+#include "AudioStream.h"
+#include "AudioSpatializer.h"
 
 class AudioSourceComponent;
 class StandaloneAudioSource;
@@ -40,6 +36,7 @@ public:
 
 		WAVEFORMATEXTENSIBLE wfx = { 0 };
 		XAUDIO2_BUFFER buffer = { 0 };
+		VoiceClip clip;	// ̃v[Ŗ炷̌`ƃf[^
 	public:
 		//I[fBI\[X擾
 		static std::shared_ptr<AudioBuffer> GetResource(const wchar_t* filePath);
@@ -73,21 +70,56 @@ public:
 
 public:
 
-	static void PlayOneShot(const wchar_t* filePath, float volume = 1.0f);
+	// ʉ 1 炷 (̓v[g񂷁Aɖ炷̏ȂDxႢE~߂)
+	static AudioVoicePool::Handle PlayOneShot(const wchar_t* filePath, float volume = 1.0f, int priority = 0, float distance = 0.0f);
+	// `̐OčĂ (V[̏ŌĂԂƁAŏɖ炵ɐȂ)
+	static void PrewarmOneShot(const wchar_t* filePath, uint32_t count);
 
 	static void Update(float deltaTime);
 	static void ClearAll() {
-		audioSources.clear();
-		erases.clear();
+		if (spatializer) {
+			spatializer->StopAll();
+		}
+		if (voicePool) {
+			voicePool->StopAll();
+		}
+	}
+	// ̃v[ (XAudio2 ɐ߁AIɌĂ)
+	static void Finalize() {
+		spatializer.reset();
+		voicePool.reset();
+		voiceDevice.reset();
+	}
+	static AudioVoicePool* GetVoicePool() { return voicePool.get(); }
+
+	// 3D ̉ (AudioSourceComponent) ܂Ƃ߂ČvZ鏊
+	static AudioSpatializer* GetSpatializer() { return spatializer.get(); }
+	// ʒu (1 t[ 1 AJ̈ʒuƌ)A͑Õt[̈ʒu狁߂
+	static void SetListener(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& front, const DirectX::XMFLOAT3& up);
+	// J̃r[s̋ts񂩂 (1 sڂA2 sڂʁA3 sڂʒu)
+	static void SetListener(const DirectX::XMFLOAT4X4& invView)
+	{
+		SetListener({ invView._41, invView._42, invView._43 }, { invView._31, invView._32, invView._33 }, { invView._21, invView._22, invView._23 });
 	}
+
+	// BGM Ȃǂ̒t@C班ǂŖ炷 (t@CŜɒuȂ)
+	static std::unique_ptr<AudioStream> CreateStream(const wchar_t* filePath, SoundType type);
 private:
-	static inline std::vector<std::shared_ptr<StandaloneAudioSource>> audioSources;
-	static inline std::vector<std::shared_ptr<StandaloneAudioSource>> erases;
+	static SoundType GetSoundType(const wchar_t* filePath);
+
+	static inline std::unique_ptr<AudioVoiceDevice> voiceDevice;
+	static inline std::unique_ptr<AudioVoicePool> voicePool;
+	static inline std::unique_ptr<AudioSpatializer> spatializer;
+	static inline AudioListener listener;
+	static inline bool hasListener = false;	// Õt[̈ʒu邩 (ŏ̃t[͑ 0 ɂ)
+	static inline float listenerDeltaTime = 0.0f;
 
 private:
 	friend class AudioSourceComponent;
 	friend class AudioSource;
 	friend class StandaloneAudioSource;
+	friend class XAudio2VoiceDevice;
+	friend class XAudio2StreamVoice;
 	static void CreateAudioSource(std::shared_ptr<AudioBuffer> buffer, IXAudio2SourceVoice** sourceVoice, SoundType type);
 
 private:
@@ -105,7 +137,7 @@ private:
 class AudioSourceComponent : public SceneComponent
 {
 public:
-	AudioSourceComponent(const std::string& name, std::shared_ptr<Actor> owner) : SceneComponent(name, owner), sourceVoice(nullptr) {}
+	AudioSourceComponent(const std::string& name, std::shared_ptr<Actor> owner) : SceneComponent(name, owner) {}
 	virtual ~AudioSourceComponent();
 
 	/// <summary>
@@ -123,14 +155,11 @@ public:
 	/// <returns>iĐȂO傫j</returns>
 	uint32_t GetBufferQueueCount();
 
+	// [v (̃R|[lg̃Nbvɐݒ肷At@C̑̉ɂ͉eȂ)
 	void SetLoopOption(float begin, float length)
 	{
-		XAUDIO2_BUFFER* pBuffer = &sptrBuffer->buffer;
-		const WAVEFORMATEX& format = sptrBuffer->wfx.Format;
-
-		const UINT32 sampleRate = format.nSamplesPerSec;
-		const UINT32 blockAlign = format.nBlockAlign;
-		const UINT32 totalSamples = pBuffer->AudioBytes / blockAlign;
+		const UINT32 sampleRate = clip.format.samplesPerSec;
+		const UINT32 totalSamples = clip.GetFrameCount();
 
 		UINT32 loopBegin = static_cast<UINT32>(sampleRate * begin);
 		UINT32 loopLength = static_cast<UINT32>(sampleRate * length);
@@ -139,16 +168,21 @@ public:
 		if (loopBegin >= totalSamples) {
 			loopBegin = 0;
 			loopLength = 0;
-			pBuffer->LoopCount = 0; // 
 		}
 		else if (loopBegin + loopLength > totalSamples) {
 			loopLength = totalSamples - loopBegin;
 		}
 
-		pBuffer->LoopBegin = loopBegin;
-		pBuffer->LoopLength = loopLength;
+		clip.loopBegin = loopBegin;
+		clip.loopLength = loopLength;
 	}
 
+	// ̌Ehbv[Ȃǂ̐ݒ ( Play g)
+	void SetSpatialSettings(const AudioEmitterSettings& settings) { spatialSettings = settings; }
+	const AudioEmitterSettings& GetSpatialSettings() const { return spatialSettings; }
+	// ՂĂ銄 (0`1AĂԂς)
+	void SetOcclusion(float occlusion);
+
 public:
 
 	void Tick(float deltaTime) override;
@@ -160,7 +194,12 @@ private:
 	SoundType type;
 
 	std::shared_ptr<Audio::AudioBuffer> sptrBuffer;
-	IXAudio2SourceVoice* sourceVoice;
+	VoiceClip clip;	// [vԂR|[lgƂɎ߂̃Rs[
+
+	//  Audio::GetSpatializer() ؂Ė炷 (ȂԂ͉zĐȂ)
+	AudioEmitterSettings spatialSettings;
+	AudioSpatializer::EmitterId emitter = AudioSpatializer::InvalidEmitter;
+	DirectX::XMFLOAT3 lastPosition = { 0.0f, 0.0f, 0.0f };
 
 	static inline float masterVolume = 1.0f;
 	static inline float bgmVolume = 1.0f;
@@ -0,0 +1,509 @@
+#include "AudioSpatializer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "Engine/Debug/Assert.h"
+
+using namespace DirectX;
+
+namespace
+{
+	constexpr float MinDistanceLimit = 0.001f;
+	constexpr float FadeRange = 0.1f;			// maxDistance ̍Ō 1  0 ܂ŉ
+	constexpr float MaxLowPass = 20000.0f;		// Ղn߂̃[pX (openLowPass  0 ̎)
+	constexpr float MinDopplerDenominator = 0.1f;	// ɑ΂銄 (ŋ߂ÂĂZł悤)
+
+	// Xi[̉EƐ (K)
+	void GetListenerAxes(const AudioListener& listener, XMFLOAT3& right, XMFLOAT3& front)
+	{
+		const XMVECTOR f = XMVector3Normalize(XMLoadFloat3(&listener.front));
+		const XMVECTOR u = XMLoadFloat3(&listener.up);
+		XMStoreFloat3(&right, XMVector3Normalize(XMVector3Cross(u, f)));
+		XMStoreFloat3(&front, f);
+	}
+
+	template<class Function>
+	void ForEachArray(AudioSpatializer::Batch& batch, Function function)
+	{
+		for (std::vector<float>* values : { &batch.positionX, &batch.positionY, &batch.positionZ, &batch.velocityX, &batch.velocityY, &batch.velocityZ,
+			&batch.volume, &batch.minDistance, &batch.maxDistance, &batch.rolloff, &batch.dopplerScale, &batch.occlusion,
+			&batch.gain, &batch.left, &batch.right, &batch.frequencyRatio, &batch.lowPass, &batch.distance })
+		{
+			function(*values);
+		}
+	}
+}
+
+void AudioSpatializer::Batch::Resize(size_t size)
+{
+	const size_t padded = (size + 3) & ~size_t(3);
+	ForEachArray(*this, [padded](std::vector<float>& values) { values.resize(padded, 0.0f); });
+	// ]̗vf͊ZĂȂlɂĂ
+	for (size_t i = size; i < padded; ++i)
+	{
+		minDistance[i] = maxDistance[i] = rolloff[i] = 1.0f;
+	}
+	count = size;
+}
+
+void AudioSpatializer::Batch::Set(size_t index, const XMFLOAT3& position, const XMFLOAT3& velocity, const AudioEmitterSettings& settings)
+{
+	positionX[index] = position.x;
+	positionY[index] = position.y;
+	positionZ[index] = position.z;
+	velocityX[index] = velocity.x;
+	velocityY[index] = velocity.y;
+	velocityZ[index] = velocity.z;
+	volume[index] = settings.volume;
+	minDistance[index] = settings.minDistance;
+	maxDistance[index] = settings.maxDistance;
+	rolloff[index] = settings.rolloff;
+	dopplerScale[index] = settings.dopplerScale;
+	occlusion[index] = settings.occlusion;
+}
+
+void AudioSpatializer::Batch::Move(size_t from, size_t to)
+{
+	ForEachArray(*this, [from, to](std::vector<float>& values) { values[to] = values[from]; });
+}
+
+
+AudioSpatializer::AudioSpatializer(AudioVoicePool* pool) : AudioSpatializer(pool, Settings{})
+{
+}
+
+AudioSpatializer::AudioSpatializer(AudioVoicePool* pool, const Settings& settings) : pool(pool), settings(settings)
+{
+	_ASSERT_EXPR(pool, L"AudioSpatializer needs a voice pool");
+}
+
+AudioSpatializer::~AudioSpatializer()
+{
+	StopAll();
+}
+
+void AudioSpatializer::ComputeOne(const AudioListener& listener, const Settings& settings, Batch& batch, size_t i)
+{
+	XMFLOAT3 right, front;
+	GetListenerAxes(listener, right, front);
+
+	const float dx = batch.positionX[i] - listener.position.x;
+	const float dy = batch.positionY[i] - listener.position.y;
+	const float dz = batch.positionZ[i] - listener.position.z;
+	const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+	const float inverse = distance > MinDistanceLimit ? 1.0f / distance : 0.0f;
+
+	// ̌ : minDistance ܂ł 1A͋ɔAmaxDistance ̎O 0 ɂ
+	const float minDistance = (std::max)(batch.minDistance[i], MinDistanceLimit);
+	const float maxDistance = (std::max)(batch.maxDistance[i], minDistance);
+	const float clamped = (std::clamp)(distance, minDistance, maxDistance);
+	const float attenuation = minDistance / (minDistance + batch.rolloff[i] * (clamped - minDistance));
+	const float fade = (std::clamp)((maxDistance - distance) / (maxDistance * FadeRange), 0.0f, 1.0f);
+	const float occlusion = (std::clamp)(batch.occlusion[i], 0.0f, 1.0f);
+	batch.gain[i] = batch.volume[i] * attenuation * fade * (1.0f - occlusion * (1.0f - settings.occlusionVolume));
+
+	// p : Eւ̌ (߂͒Ɋ񂹂)
+	const float pan = (dx * right.x + dy * right.y + dz * right.z) * inverse * (std::clamp)(distance / minDistance, 0.0f, 1.0f);
+	batch.left[i] = (std::min)(1.0f, std::sqrt((std::max)(0.0f, 1.0f - pan)));
+	batch.right[i] = (std::min)(1.0f, std::sqrt((std::max)(0.0f, 1.0f + pan)));
+
+	// hbv[ : Ɍ̃Xi[Ɖ̑
+	const float listenerSpeed = (listener.velocity.x * dx + listener.velocity.y * dy + listener.velocity.z * dz) * inverse;
+	const float emitterSpeed = (batch.velocityX[i] * dx + batch.velocityY[i] * dy + batch.velocityZ[i] * dz) * inverse;
+	const float c = settings.speedOfSound;
+	const float numerator = c + batch.dopplerScale[i] * listenerSpeed;
+	const float denominator = (std::max)(c + batch.dopplerScale[i] * emitterSpeed, c * MinDopplerDenominator);
+	batch.frequencyRatio[i] = (std::clamp)(numerator / denominator, settings.minFrequencyRatio, settings.maxFrequencyRatio);
+
+	// Օ̃[pX
+	const float openLowPass = settings.openLowPass > 0.0f ? settings.openLowPass : MaxLowPass;
+	batch.lowPass[i] = occlusion > 0.0f ? openLowPass + (settings.occludedLowPass - openLowPass) * occlusion : settings.openLowPass;
+	batch.distance[i] = distance;
+}
+
+void AudioSpatializer::ComputeBatch(const AudioListener& listener, const Settings& settings, Batch& batch)
+{
+	XMFLOAT3 rightAxis, frontAxis;
+	GetListenerAxes(listener, rightAxis, frontAxis);
+
+	const XMVECTOR zero = XMVectorZero();
+	const XMVECTOR one = XMVectorReplicate(1.0f);
+	const XMVECTOR listenerX = XMVectorReplicate(listener.position.x);
+	const XMVECTOR listenerY = XMVectorReplicate(listener.position.y);
+	const XMVECTOR listenerZ = XMVectorReplicate(listener.position.z);
+	const XMVECTOR rightX = XMVectorReplicate(rightAxis.x);
+	const XMVECTOR rightY = XMVectorReplicate(rightAxis.y);
+	const XMVECTOR rightZ = XMVectorReplicate(rightAxis.z);
+	const XMVECTOR listenerVelocityX = XMVectorReplicate(listener.velocity.x);
+	const XMVECTOR listenerVelocityY = XMVectorReplicate(listener.velocity.y);
+	const XMVECTOR listenerVelocityZ = XMVectorReplicate(listener.velocity.z);
+	const XMVECTOR minDistanceLimit = XMVectorReplicate(MinDistanceLimit);
+	const XMVECTOR fadeRange = XMVectorReplicate(FadeRange);
+	const XMVECTOR occlusionLoss = XMVectorReplicate(1.0f - settings.occlusionVolume);
+	const XMVECTOR speedOfSound = XMVectorReplicate(settings.speedOfSound);
+	const XMVECTOR minDenominator = XMVectorReplicate(settings.speedOfSound * MinDopplerDenominator);
+	const XMVECTOR minRatio = XMVectorReplicate(settings.minFrequencyRatio);
+	const XMVECTOR maxRatio = XMVectorReplicate(settings.maxFrequencyRatio);
+	const XMVECTOR openLowPass = XMVectorReplicate(settings.openLowPass);
+	const XMVECTOR occludedFrom = XMVectorReplicate(settings.openLowPass > 0.0f ? settings.openLowPass : MaxLowPass);
+	const XMVECTOR occludedLowPass = XMVectorReplicate(settings.occludedLowPass);
+
+	auto load = [](const std::vector<float>& values, size_t i) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&values[i])); };
+	auto store = [](std::vector<float>& values, size_t i, FXMVECTOR value) { XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&values[i]), value); };
+
+	for (size_t i = 0; i < batch.count; i += 4)
+	{
+		const XMVECTOR dx = XMVectorSubtract(load(batch.positionX, i), listenerX);
+		const XMVECTOR dy = XMVectorSubtract(load(batch.positionY, i), listenerY);
+		const XMVECTOR dz = XMVectorSubtract(load(batch.positionZ, i), listenerZ);
+		const XMVECTOR distance = XMVectorSqrt(XMVectorMultiplyAdd(dx, dx, XMVectorMultiplyAdd(dy, dy, XMVectorMultiply(dz, dz))));
+		const XMVECTOR inverse = XMVectorSelect(zero, XMVectorReciprocal(distance), XMVectorGreater(distance, minDistanceLimit));
+
+		// ̌
+		const XMVECTOR minDistance = XMVectorMax(load(batch.minDistance, i), minDistanceLimit);
+		const XMVECTOR maxDistance = XMVectorMax(load(batch.maxDistance, i), minDistance);
+		const XMVECTOR clamped = XMVectorClamp(distance, minDistance, maxDistance);
+		const XMVECTOR attenuation = XMVectorDivide(minDistance, XMVectorMultiplyAdd(load(batch.rolloff, i), XMVectorSubtract(clamped, minDistance), minDistance));
+		const XMVECTOR fade = XMVectorSaturate(XMVectorDivide(XMVectorSubtract(maxDistance, distance), XMVectorMultiply(maxDistance, fadeRange)));
+		const XMVECTOR occlusion = XMVectorSaturate(load(batch.occlusion, i));
+		XMVECTOR gain = XMVectorMultiply(load(batch.volume, i), XMVectorMultiply(attenuation, fade));
+		gain = XMVectorMultiply(gain, XMVectorNegativeMultiplySubtract(occlusion, occlusionLoss, one));
+		store(batch.gain, i, gain);
+
+		// p
+		XMVECTOR pan = XMVectorMultiplyAdd(dx, rightX, XMVectorMultiplyAdd(dy, rightY, XMVectorMultiply(dz, rightZ)));
+		pan = XMVectorMultiply(XMVectorMultiply(pan, inverse), XMVectorSaturate(XMVectorDivide(distance, minDistance)));
+		store(batch.left, i, XMVectorMin(one, XMVectorSqrt(XMVectorMax(zero, XMVectorSubtract(one, pan)))));
+		store(batch.right, i, XMVectorMin(one, XMVectorSqrt(XMVectorMax(zero, XMVectorAdd(one, pan)))));
+
+		// hbv[
+		const XMVECTOR dopplerScale = load(batch.dopplerScale, i);
+		XMVECTOR listenerSpeed = XMVectorMultiplyAdd(dx, listenerVelocityX, XMVectorMultiplyAdd(dy, listenerVelocityY, XMVectorMultiply(dz, listenerVelocityZ)));
+		listenerSpeed = XMVectorMultiply(listenerSpeed, inverse);
+		XMVECTOR emitterSpeed = XMVectorMultiplyAdd(dx, load(batch.velocityX, i), XMVectorMultiplyAdd(dy, load(batch.velocityY, i), XMVectorMultiply(dz, load(batch.velocityZ, i))));
+		emitterSpeed = XMVectorMultiply(emitterSpeed, inverse);
+		const XMVECTOR numerator = XMVectorMultiplyAdd(dopplerScale, listenerSpeed, speedOfSound);
+		const XMVECTOR denominator = XMVectorMax(XMVectorMultiplyAdd(dopplerScale, emitterSpeed, speedOfSound), minDenominator);
+		store(batch.frequencyRatio, i, XMVectorClamp(XMVectorDivide(numerator, denominator), minRatio, maxRatio));
+
+		// Օ̃[pX
+		const XMVECTOR lowPass = XMVectorLerpV(occludedFrom, occludedLowPass, occlusion);
+		store(batch.lowPass, i, XMVectorSelect(lowPass, openLowPass, XMVectorLessOrEqual(occlusion, zero)));
+		store(batch.distance, i, distance);
+	}
+}
+
+bool AudioSpatializer::Seek(const VoiceClip& clip, uint32_t loopCount, float elapsed, uint32_t& beginFrame, uint32_t& loopsLeft)
+{
+	const uint64_t frames = clip.GetFrameCount();
+	if (frames == 0)
+	{
+		return false;
+	}
+	const uint64_t loopBegin = (std::min)(static_cast<uint64_t>(clip.loopBegin), frames - 1);
+	const uint64_t loopEnd = clip.loopLength ? (std::min)(loopBegin + clip.loopLength, frames) : frames;
+	const uint64_t region = loopEnd - loopBegin;
+	const uint64_t frame = static_cast<uint64_t>((std::max)(elapsed, 0.0f) * static_cast<double>(clip.format.samplesPerSec) + 0.5);
+
+	// [vԂ̏I܂
+	if (loopCount == 0 || frame < loopEnd)
+	{
+		beginFrame = static_cast<uint32_t>(frame);
+		loopsLeft = loopCount;
+		return frame < frames;
+	}
+	// [vԂJԂĂ鏊
+	const uint64_t pass = (frame - loopEnd) / region;
+	if (loopCount == AudioVoiceDevice::LoopInfinite || pass < loopCount)
+	{
+		beginFrame = static_cast<uint32_t>(loopBegin + (frame - loopEnd) % region);
+		loopsLeft = loopCount == AudioVoiceDevice::LoopInfinite ? loopCount : static_cast<uint32_t>(loopCount - pass - 1);
+		return true;
+	}
+	// JԂI
+	const uint64_t after = loopEnd + (frame - loopEnd - region * loopCount);
+	beginFrame = static_cast<uint32_t>(after);
+	loopsLeft = 0;
+	return after < frames;
+}
+
+AudioSpatializer::EmitterId AudioSpatializer::Play(const VoiceClip& clip, SoundType type, uint32_t loopCount, const XMFLOAT3& position,
+	const AudioEmitterSettings& emitterSettings, std::shared_ptr<const void> resource)
+{
+	uint32_t slot;
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+	const uint32_t index = static_cast<uint32_t>(emitters.size());
+	slots[slot].index = index;
+
+	Emitter& emitter = emitters.emplace_back();
+	emitter.slot = slot;
+	emitter.clip = clip;
+	emitter.type = type;
+	emitter.loopCount = loopCount;
+	emitter.priority = emitterSettings.priority;
+	emitter.resource = std::move(resource);
+	//  : Ō܂ + [v ~ 
+	const uint32_t frames = clip.GetFrameCount();
+	const uint32_t loopBegin = (std::min)(clip.loopBegin, frames);
+	const uint32_t region = clip.loopLength ? (std::min)(clip.loopLength, frames - loopBegin) : frames - loopBegin;
+	emitter.duration = loopCount == AudioVoiceDevice::LoopInfinite ? std::numeric_limits<float>::infinity() :
+		clip.format.samplesPerSec ? static_cast<float>(frames + static_cast<double>(region) * loopCount) / clip.format.samplesPerSec : clip.seconds;
+
+	batch.Resize(emitters.size());
+	batch.Set(index, position, { 0.0f, 0.0f, 0.0f }, emitterSettings);
+	++statistics.started;
+
+	// Đɋ󂫂΁A Update ҂ɖ炷
+	ComputeOne(listener, settings, batch, index);
+	if (batch.gain[index] >= settings.audibleVolume && realCount < settings.maxRealVoices && !Acquire(index))
+	{
+		++statistics.rejected;
+	}
+	statistics.emitters = emitters.size();
+	return ((slot + 1) << 16) | slots[slot].generation;
+}
+
+void AudioSpatializer::Stop(EmitterId emitter)
+{
+	const uint32_t index = Find(emitter);
+	if (index != UINT32_MAX)
+	{
+		Remove(index);
+	}
+}
+
+void AudioSpatializer::StopAll()
+{
+	while (!emitters.empty())
+	{
+		Remove(static_cast<uint32_t>(emitters.size() - 1));
+	}
+}
+
+void AudioSpatializer::SetPosition(EmitterId emitter, const XMFLOAT3& position, const XMFLOAT3& velocity)
+{
+	const uint32_t index = Find(emitter);
+	if (index != UINT32_MAX)
+	{
+		batch.positionX[index] = position.x;
+		batch.positionY[index] = position.y;
+		batch.positionZ[index] = position.z;
+		batch.velocityX[index] = velocity.x;
+		batch.velocityY[index] = velocity.y;
+		batch.velocityZ[index] = velocity.z;
+	}
+}
+
+void AudioSpatializer::SetVolume(EmitterId emitter, float volume)
+{
+	const uint32_t index = Find(emitter);
+	if (index != UINT32_MAX)
+	{
+		batch.volume[index] = volume;
+	}
+}
+
+void AudioSpatializer::SetOcclusion(EmitterId emitter, float occlusion)
+{
+	const uint32_t index = Find(emitter);
+	if (index != UINT32_MAX)
+	{
+		batch.occlusion[index] = occlusion;
+	}
+}
+
+AudioSpatializer::Result AudioSpatializer::GetResult(EmitterId emitter) const
+{
+	Result result;
+	const uint32_t index = Find(emitter);
+	if (index != UINT32_MAX)
+	{
+		result.spatial = GetSpatial(index);
+		result.distance = batch.distance[index];
+		result.isAudible = batch.gain[index] >= settings.audibleVolume;
+		result.isVirtual = emitters[index].handle == AudioVoicePool::InvalidHandle;
+	}
+	return result;
+}
+
+void AudioSpatializer::Update(const AudioListener& newListener, float deltaTime)
+{
+	const auto begin = std::chrono::steady_clock::now();
+	listener = newListener;
+
+	// Ԃi߂āAIO (납猩̂ŁAւďĂƂȂ)
+	for (size_t i = emitters.size(); i-- > 0;)
+	{
+		Emitter& emitter = emitters[i];
+		emitter.elapsed += deltaTime;
+		if (emitter.handle != AudioVoicePool::InvalidHandle && !pool->IsPlaying(emitter.handle))
+		{
+			// I (Ō܂Ŗ炵Ảɐꂽ)
+			emitter.handle = AudioVoicePool::InvalidHandle;
+			--realCount;
+			if (emitter.loopCount != AudioVoiceDevice::LoopInfinite && emitter.elapsed + 0.25f >= emitter.duration)
+			{
+				emitter.elapsed = emitter.duration;
+			}
+			else
+			{
+				++statistics.virtualized;
+			}
+		}
+		if (emitter.elapsed >= emitter.duration)
+		{
+			Remove(static_cast<uint32_t>(i));
+			++statistics.finished;
+		}
+	}
+
+	ComputeBatch(listener, settings, batch);
+
+	// 鉹 Dx   ̏ɕׂāAォ maxRealVoices ɐt
+	// Ă鉹͏Ȃ܂Ŏc (ڂŕtOJԂȂ)
+	order.clear();
+	for (uint32_t i = 0; i < emitters.size(); ++i)
+	{
+		const bool isReal = emitters[i].handle != AudioVoicePool::InvalidHandle;
+		const float threshold = isReal ? settings.audibleVolume * settings.hysteresis : settings.audibleVolume;
+		if (batch.gain[i] >= threshold)
+		{
+			order.push_back(i);
+		}
+	}
+	statistics.audible = order.size();
+	auto isMoreImportant = [this](uint32_t a, uint32_t b)
+		{
+			return emitters[a].priority != emitters[b].priority ? emitters[a].priority > emitters[b].priority : batch.gain[a] > batch.gain[b];
+		};
+	if (order.size() > settings.maxRealVoices)
+	{
+		std::nth_element(order.begin(), order.begin() + settings.maxRealVoices, order.end(), isMoreImportant);
+		order.resize(settings.maxRealVoices);
+	}
+
+	// ɐԂĂAV悤ɂȂɐt
+	std::vector<bool> isWanted(emitters.size(), false);
+	for (uint32_t i : order)
+	{
+		isWanted[i] = true;
+	}
+	for (uint32_t i = 0; i < emitters.size(); ++i)
+	{
+		if (!isWanted[i] && emitters[i].handle != AudioVoicePool::InvalidHandle)
+		{
+			Virtualize(i);
+		}
+	}
+	for (uint32_t i : order)
+	{
+		if (emitters[i].handle == AudioVoicePool::InvalidHandle)
+		{
+			if (Acquire(i))
+			{
+				++statistics.restored;
+			}
+			else
+			{
+				++statistics.rejected;
+			}
+		}
+		else
+		{
+			pool->SetSpatial(emitters[i].handle, GetSpatial(i));
+		}
+	}
+
+	statistics.emitters = emitters.size();
+	statistics.real = realCount;
+	statistics.microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+uint32_t AudioSpatializer::Find(EmitterId emitter) const
+{
+	const uint32_t slot = (emitter >> 16) - 1;
+	if (emitter == InvalidEmitter || slot >= slots.size() || slots[slot].generation != static_cast<uint16_t>(emitter & 0xFFFF))
+	{
+		return UINT32_MAX;
+	}
+	return slots[slot].index;
+}
+
+bool AudioSpatializer::Acquire(uint32_t index)
+{
+	Emitter& emitter = emitters[index];
+	AudioVoicePool::PlayParams params;
+	if (!Seek(emitter.clip, emitter.loopCount, emitter.elapsed, params.beginFrame, params.loopCount))
+	{
+		return false;
+	}
+	// ͉ʂɓĂ̂ŁA~߂鐺IԎ͉ʂŔׂ
+	params.volume = batch.gain[index];
+	params.priority = emitter.priority;
+	emitter.handle = pool->Play(emitter.clip, emitter.type, params, emitter.resource);
+	if (emitter.handle == AudioVoicePool::InvalidHandle)
+	{
+		return false;
+	}
+	pool->SetSpatial(emitter.handle, GetSpatial(index));
+	++realCount;
+	return true;
+}
+
+void AudioSpatializer::Virtualize(uint32_t index)
+{
+	Emitter& emitter = emitters[index];
+	pool->Stop(emitter.handle);
+	emitter.handle = AudioVoicePool::InvalidHandle;
+	--realCount;
+	++statistics.virtualized;
+}
+
+void AudioSpatializer::Remove(uint32_t index)
+{
+	if (emitters[index].handle != AudioVoicePool::InvalidHandle)
+	{
+		pool->Stop(emitters[index].handle);
+		--realCount;
+	}
+	Slot& slot = slots[emitters[index].slot];
+	slot.index = UINT32_MAX;
+	// Â EmitterId ŐGȂ悤ɐi߂ (0 ͎gȂ)
+	slot.generation = slot.generation == UINT16_MAX ? 1 : static_cast<uint16_t>(slot.generation + 1);
+	freeSlots.push_back(emitters[index].slot);
+
+	// Ō̉ƓւĊO
+	const uint32_t last = static_cast<uint32_t>(emitters.size() - 1);
+	if (index != last)
+	{
+		emitters[index] = std::move(emitters[last]);
+		batch.Move(last, index);
+		slots[emitters[index].slot].index = index;
+	}
+	emitters.pop_back();
+	batch.Resize(emitters.size());
+	statistics.emitters = emitters.size();
+}
+
+VoiceSpatial AudioSpatializer::GetSpatial(uint32_t index) const
+{
+	VoiceSpatial spatial;
+	spatial.volume = batch.gain[index];
+	spatial.left = batch.left[index];
+	spatial.right = batch.right[index];
+	spatial.frequencyRatio = batch.frequencyRatio[index];
+	spatial.lowPassFrequency = batch.lowPass[index];
+	return spatial;
+}
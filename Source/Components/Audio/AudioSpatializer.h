@@ -0,0 +1,167 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AudioVoicePool.h"
+
+// ʒu (J)
+struct AudioListener
+{
+	DirectX::XMFLOAT3 position = { 0.0f, 0.0f, 0.0f };
+	DirectX::XMFLOAT3 front = { 0.0f, 0.0f, 1.0f };
+	DirectX::XMFLOAT3 up = { 0.0f, 1.0f, 0.0f };
+	DirectX::XMFLOAT3 velocity = { 0.0f, 0.0f, 0.0f };	// 1 b (hbv[)
+};
+
+// Ƃ 3D ̐ݒ
+struct AudioEmitterSettings
+{
+	float volume = 1.0f;
+	float minDistance = 2.0f;		// ܂ł͌Ȃ
+	float maxDistance = 80.0f;		// Ō 1  0 ܂ŉA艓ƕȂ
+	float rolloff = 1.0f;			// ̋ (1 Ȃ minDistance ̋ɔ)
+	float dopplerScale = 1.0f;		// 0 Ȃhbv[|Ȃ
+	float occlusion = 0.0f;			// ՂĂ銄 (0`1)Aʂă[pX|
+	int priority = 0;				// Ȃɑ傫炷
+};
+
+// Ă 3D ̉ 1 t[ 1 ܂Ƃ߂ČvZāAɔf
+//   ̌EẼpEhbv[EՕ̃[pXA̒lvfƂ̔zɕׂ 4 vZ
+//   Ȃ (E) ƁȀ (maxRealVoices) ꂽ͉z
+//   z͐ɎԂi߁A悤ɂȂ炻̎Ԃ̈ʒu炵
+//    AudioVoicePool ؂̂ŁA3D ̌ʂ AudioVoiceDevice::SetSpatial Ŕf
+class AudioSpatializer
+{
+public:
+	using EmitterId = uint32_t;
+	static constexpr EmitterId InvalidEmitter = 0;
+
+	struct Settings
+	{
+		float speedOfSound = 343.0f;			// m/s
+		float audibleVolume = 0.003f;			// 菬͉z ( -50dB)
+		float hysteresis = 0.7f;				// Ă鉹 audibleVolume ~ 菬Ȃ܂Ŏc
+		uint32_t maxRealVoices = 16;			// 3D ̉œɖ炷
+		float occlusionVolume = 0.5f;			// SɎՂꂽ̉
+		float openLowPass = 0.0f;				// ՂĂȂ̃[pX (0 Ȃ|Ȃ)
+		float occludedLowPass = 1200.0f;		// SɎՂꂽ̃[pX (Hz)
+		float minFrequencyRatio = 0.5f;
+		float maxFrequencyRatio = 2.0f;			// XAUDIO2_DEFAULT_FREQ_RATIO
+	};
+
+	// 1 ̉̌vZ
+	struct Result
+	{
+		VoiceSpatial spatial;
+		float distance = 0.0f;
+		bool isAudible = false;
+		bool isVirtual = true;
+	};
+
+	struct Statistics
+	{
+		size_t emitters = 0;
+		size_t real = 0;			// Ă鉹
+		size_t audible = 0;			// 鉹 (Ȃ real 葽)
+		size_t started = 0;
+		size_t finished = 0;
+		size_t virtualized = 0;		// Ԃĉz
+		size_t restored = 0;		// zĂɐt
+		size_t rejected = 0;		// ̂ɐ؂Ȃ
+		double microseconds = 0.0;	// Ō Update ̎
+	};
+
+	// vfƂ̔z (4 ǂ߂悤 4 ̔{̑傫ɂ)
+	struct Batch
+	{
+		std::vector<float> positionX, positionY, positionZ;
+		std::vector<float> velocityX, velocityY, velocityZ;
+		std::vector<float> volume, minDistance, maxDistance, rolloff, dopplerScale, occlusion;
+		// 
+		std::vector<float> gain, left, right, frequencyRatio, lowPass, distance;
+
+		size_t count = 0;
+		void Resize(size_t size);
+		void Set(size_t index, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& velocity, const AudioEmitterSettings& settings);
+		void Move(size_t from, size_t to);
+	};
+
+	explicit AudioSpatializer(AudioVoicePool* pool);
+	AudioSpatializer(AudioVoicePool* pool, const Settings& settings);
+	~AudioSpatializer();
+	AudioSpatializer(const AudioSpatializer&) = delete;
+	AudioSpatializer& operator=(const AudioSpatializer&) = delete;
+
+	// 炷 (Đ΂炵AΉzĎn߂)
+	// clip ̃[vԂ loopCount JԂ (AudioVoiceDevice::LoopInfinite Ȃ Stop ܂)
+	EmitterId Play(const VoiceClip& clip, SoundType type, uint32_t loopCount, const DirectX::XMFLOAT3& position, const AudioEmitterSettings& settings,
+		std::shared_ptr<const void> resource = nullptr);
+	void Stop(EmitterId emitter);
+	void StopAll();
+	// Ō܂Ŗ炵I܂ (zĂԂ) true
+	bool IsPlaying(EmitterId emitter) const { return Find(emitter) != UINT32_MAX; }
+
+	void SetPosition(EmitterId emitter, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& velocity);
+	void SetVolume(EmitterId emitter, float volume);
+	void SetOcclusion(EmitterId emitter, float occlusion);
+	Result GetResult(EmitterId emitter) const;
+
+	// 1 t[ 1  (AudioVoicePool::Update ̌)
+	void Update(const AudioListener& listener, float deltaTime);
+
+	const Statistics& GetStatistics() const { return statistics; }
+	const Settings& GetSettings() const { return settings; }
+	void SetSettings(const Settings& value) { settings = value; }
+	const AudioListener& GetListener() const { return listener; }
+
+	// batch  [0, batch.count)  4 vZ
+	static void ComputeBatch(const AudioListener& listener, const Settings& settings, Batch& batch);
+	// SIMD g킸 1 vZ (mFpƁAPlay łɖ炷߂鎞)
+	static void ComputeOne(const AudioListener& listener, const Settings& settings, Batch& batch, size_t index);
+
+	// elapsed b炵̈ʒuƁAJԂ[v̉ (Ō܂Ŗ炵 false)
+	static bool Seek(const VoiceClip& clip, uint32_t loopCount, float elapsed, uint32_t& beginFrame, uint32_t& loopsLeft);
+
+private:
+	struct Emitter
+	{
+		uint32_t slot = 0;
+		VoiceClip clip;
+		SoundType type = SoundType::SE;
+		uint32_t loopCount = 0;
+		int priority = 0;
+		float elapsed = 0.0f;
+		float duration = 0.0f;		// [vȂ疳
+		AudioVoicePool::Handle handle = AudioVoicePool::InvalidHandle;
+		std::shared_ptr<const void> resource;
+	};
+	struct Slot
+	{
+		uint32_t index = UINT32_MAX;	// emitters ̒̈ʒu (gĂȂ UINT32_MAX)
+		uint16_t generation = 1;
+	};
+
+	uint32_t Find(EmitterId emitter) const;
+	// ؂ elapsed ̈ʒu炷
+	bool Acquire(uint32_t index);
+	// Ԃĉz
+	void Virtualize(uint32_t index);
+	void Remove(uint32_t index);
+	VoiceSpatial GetSpatial(uint32_t index) const;
+
+	AudioVoicePool* pool;
+	Settings settings;
+	AudioListener listener;
+	std::vector<Emitter> emitters;	// batch Ɠ
+	Batch batch;
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+	std::vector<uint32_t> order;	// z邩߂鎞̕בւ
+	size_t realCount = 0;
+	Statistics statistics;
+};
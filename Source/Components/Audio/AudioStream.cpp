@@ -0,0 +1,521 @@
+#include "AudioStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Engine/Debug/Assert.h"
+
+namespace
+{
+	constexpr int ImaStepTable[89] =
+	{
+		7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+		50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+		337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+		2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+		15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+	};
+	constexpr int ImaIndexTable[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+	template<class T>
+	bool ReadValue(std::istream& stream, T& value)
+	{
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+}
+
+int16_t WavStreamReader::DecodeImaNibble(int nibble, int& predictor, int& index)
+{
+	const int step = ImaStepTable[index];
+	int difference = step >> 3;
+	if (nibble & 1) difference += step >> 2;
+	if (nibble & 2) difference += step >> 1;
+	if (nibble & 4) difference += step;
+	predictor = (std::clamp)(nibble & 8 ? predictor - difference : predictor + difference, -32768, 32767);
+	index = (std::clamp)(index + ImaIndexTable[nibble], 0, 88);
+	return static_cast<int16_t>(predictor);
+}
+
+int WavStreamReader::GetImaStep(int index)
+{
+	return ImaStepTable[index];
+}
+
+bool WavStreamReader::Open(const std::filesystem::path& path)
+{
+	stream.close();
+	stream.clear();
+	error.clear();
+	dataOffset = dataBytes = frameCount = position = 0;
+	adpcmDecodedBlock = UINT64_MAX;
+
+	stream.open(path, std::ios::binary);
+	if (!stream)
+	{
+		error = "failed to open " + path.string();
+		return false;
+	}
+	char riff[4] = {}, wave[4] = {};
+	uint32_t riffSize = 0;
+	stream.read(riff, 4);
+	ReadValue(stream, riffSize);
+	stream.read(wave, 4);
+	if (!stream || std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(wave, "WAVE", 4) != 0)
+	{
+		error = "not a RIFF/WAVE file";
+		stream.close();
+		return false;
+	}
+
+	// `NO珇 1 񂾂ǂ (fmt  data ȊO͔΂)
+	uint16_t channels = 0, blockAlign = 0, bitsPerSample = 0, samplesPerBlock = 0;
+	uint32_t samplesPerSec = 0;
+	bool hasFormat = false, hasData = false;
+	while (!(hasFormat && hasData))
+	{
+		char id[4] = {};
+		uint32_t size = 0;
+		stream.read(id, 4);
+		if (!ReadValue(stream, size))
+		{
+			break;
+		}
+		const std::streamoff next = static_cast<std::streamoff>(stream.tellg()) + size + (size & 1);
+		if (std::memcmp(id, "fmt ", 4) == 0 && size >= 16)
+		{
+			uint32_t averageBytesPerSec = 0;
+			ReadValue(stream, sourceFormatTag);
+			ReadValue(stream, channels);
+			ReadValue(stream, samplesPerSec);
+			ReadValue(stream, averageBytesPerSec);
+			ReadValue(stream, blockAlign);
+			ReadValue(stream, bitsPerSample);
+			uint16_t extraSize = 0;
+			if (size >= 18)
+			{
+				ReadValue(stream, extraSize);
+			}
+			if (sourceFormatTag == FormatImaAdpcm && extraSize >= 2)
+			{
+				ReadValue(stream, samplesPerBlock);
+			}
+			else if (sourceFormatTag == FormatExtensible && extraSize >= 22)
+			{
+				// WAVEFORMATEXTENSIBLE : Lrbg, `l}XN, SubFormat (擪 2 oCg`)
+				uint16_t validBits = 0;
+				uint32_t channelMask = 0;
+				ReadValue(stream, validBits);
+				ReadValue(stream, channelMask);
+				ReadValue(stream, sourceFormatTag);
+			}
+			hasFormat = static_cast<bool>(stream);
+		}
+		else if (std::memcmp(id, "data", 4) == 0)
+		{
+			dataOffset = static_cast<uint64_t>(stream.tellg());
+			dataBytes = size;
+			hasData = true;
+		}
+		stream.seekg(next);
+	}
+	if (!hasFormat || !hasData || channels == 0 || blockAlign == 0)
+	{
+		error = "missing fmt or data chunk";
+		stream.close();
+		return false;
+	}
+
+	format.channels = channels;
+	format.samplesPerSec = samplesPerSec;
+	switch (sourceFormatTag)
+	{
+	case FormatPcm:
+	case FormatIeeeFloat:
+		format.formatTag = sourceFormatTag;
+		format.bitsPerSample = bitsPerSample;
+		format.blockAlign = blockAlign;
+		frameCount = dataBytes / blockAlign;
+		break;
+	case FormatImaAdpcm:
+	{
+		// 16 rbg PCM ɂ
+		format.formatTag = FormatPcm;
+		format.bitsPerSample = 16;
+		format.blockAlign = static_cast<uint16_t>(channels * 2);
+		adpcmBlockAlign = blockAlign;
+		const uint32_t header = 4u * channels;
+		if (blockAlign <= header)
+		{
+			error = "invalid IMA ADPCM block";
+			stream.close();
+			return false;
+		}
+		adpcmFramesPerBlock = samplesPerBlock ? samplesPerBlock : (blockAlign - header) * 2 / channels + 1;
+		const uint64_t fullBlocks = dataBytes / blockAlign;
+		const uint64_t rest = dataBytes % blockAlign;
+		frameCount = fullBlocks * adpcmFramesPerBlock + (rest > header ? (rest - header) * 2 / channels + 1 : 0);
+		adpcmBlock.resize(blockAlign);
+		adpcmDecoded.resize(static_cast<size_t>(adpcmFramesPerBlock) * channels);
+		break;
+	}
+	default:
+		error = "unsupported format " + std::to_string(sourceFormatTag);
+		stream.close();
+		return false;
+	}
+	stream.clear();
+	stream.seekg(static_cast<std::streamoff>(dataOffset));
+	return true;
+}
+
+size_t WavStreamReader::Read(uint8_t* destination, size_t frames)
+{
+	frames = static_cast<size_t>((std::min)(static_cast<uint64_t>(frames), frameCount - (std::min)(position, frameCount)));
+	if (frames == 0)
+	{
+		return 0;
+	}
+	if (sourceFormatTag != FormatImaAdpcm)
+	{
+		// t@C珇ɓǂ (Seek ǂޏꏊ𓮂)
+		stream.read(reinterpret_cast<char*>(destination), static_cast<std::streamsize>(frames * format.blockAlign));
+		const size_t read = static_cast<size_t>(stream.gcount()) / format.blockAlign;
+		position += read;
+		return read;
+	}
+
+	size_t written = 0;
+	while (written < frames)
+	{
+		const uint64_t block = position / adpcmFramesPerBlock;
+		if (adpcmDecodedBlock != block && !DecodeAdpcmBlock(block))
+		{
+			break;
+		}
+		const size_t offset = static_cast<size_t>(position % adpcmFramesPerBlock);
+		const size_t count = (std::min)(frames - written, static_cast<size_t>(adpcmFramesPerBlock) - offset);
+		std::memcpy(destination + written * format.blockAlign, adpcmDecoded.data() + offset * format.channels, count * format.blockAlign);
+		written += count;
+		position += count;
+	}
+	return written;
+}
+
+bool WavStreamReader::Seek(uint64_t frame)
+{
+	position = (std::min)(frame, frameCount);
+	stream.clear();
+	if (sourceFormatTag != FormatImaAdpcm)
+	{
+		stream.seekg(static_cast<std::streamoff>(dataOffset + position * format.blockAlign));
+	}
+	return static_cast<bool>(stream);
+}
+
+bool WavStreamReader::DecodeAdpcmBlock(uint64_t block)
+{
+	const uint64_t offset = block * adpcmBlockAlign;
+	const size_t bytes = static_cast<size_t>((std::min)(static_cast<uint64_t>(adpcmBlockAlign), dataBytes - (std::min)(offset, dataBytes)));
+	const uint32_t channels = format.channels;
+	if (bytes <= 4u * channels)
+	{
+		return false;
+	}
+	stream.clear();
+	stream.seekg(static_cast<std::streamoff>(dataOffset + offset));
+	stream.read(reinterpret_cast<char*>(adpcmBlock.data()), static_cast<std::streamsize>(bytes));
+	if (static_cast<size_t>(stream.gcount()) != bytes)
+	{
+		return false;
+	}
+
+	// ubN̐擪 : `lƂɍŏ̃Tv step ̔ԍ
+	int predictors[8] = {}, indices[8] = {};
+	const uint32_t decodedChannels = (std::min)(channels, 8u);
+	for (uint32_t channel = 0; channel < decodedChannels; ++channel)
+	{
+		const uint8_t* header = &adpcmBlock[channel * 4];
+		predictors[channel] = static_cast<int16_t>(header[0] | (header[1] << 8));
+		indices[channel] = (std::clamp)(static_cast<int>(header[2]), 0, 88);
+		adpcmDecoded[channel] = static_cast<int16_t>(predictors[channel]);
+	}
+	// ̓`lƂ 4 oCg (8 Tv) ݂ɕ
+	const size_t frames = (bytes - 4u * channels) * 2 / channels + 1;
+	const uint8_t* data = adpcmBlock.data() + 4u * channels;
+	for (size_t group = 0; 1 + group * 8 < frames; ++group)
+	{
+		for (uint32_t channel = 0; channel < decodedChannels; ++channel)
+		{
+			const uint8_t* bytes4 = data + (group * channels + channel) * 4;
+			for (int i = 0; i < 8; ++i)
+			{
+				const size_t frame = 1 + group * 8 + i;
+				const int nibble = (bytes4[i >> 1] >> ((i & 1) * 4)) & 0x0F;
+				const int16_t sample = DecodeImaNibble(nibble, predictors[channel], indices[channel]);
+				if (frame < frames)
+				{
+					adpcmDecoded[frame * channels + channel] = sample;
+				}
+			}
+		}
+	}
+	adpcmDecodedBlock = block;
+	return true;
+}
+
+
+bool NullAudioStreamVoice::Submit(const uint8_t* data, uint32_t bytes, bool isEndOfStream)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	queue.push_back({ data, bytes, isEndOfStream });
+	isStarved = false;
+	return true;
+}
+
+uint32_t NullAudioStreamVoice::GetQueuedCount()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Consume();
+	return static_cast<uint32_t>(queue.size());
+}
+
+void NullAudioStreamVoice::Start()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	isRunning = true;
+	isEnded = false;
+	last = std::chrono::steady_clock::now();
+}
+
+void NullAudioStreamVoice::Stop()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	isRunning = false;
+	queue.clear();
+	pendingBytes = 0.0;
+}
+
+void NullAudioStreamVoice::Consume()
+{
+	if (!isRunning)
+	{
+		return;
+	}
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	pendingBytes += std::chrono::duration<double>(now - last).count() * timeScale * bytesPerSecond;
+	last = now;
+	while (!queue.empty() && pendingBytes >= queue.front().bytes)
+	{
+		const Buffer buffer = queue.front();
+		pendingBytes -= buffer.bytes;
+		consumedBytes += buffer.bytes;
+		if (consumer)
+		{
+			consumer(buffer.data, buffer.bytes);
+		}
+		isEnded = buffer.isEndOfStream;
+		queue.erase(queue.begin());
+	}
+	if (queue.empty())
+	{
+		// Ō̃obt@܂Ŗ炵ĂȂ̂ɖ炷
+		if (!isEnded && !isStarved && pendingBytes > 0.0)
+		{
+			++underruns;
+			isStarved = true;
+		}
+		pendingBytes = 0.0;
+	}
+}
+
+
+AudioStream::AudioStream(const std::filesystem::path& path, VoiceFactory voiceFactory, float bufferSeconds)
+{
+	if (!reader.Open(path))
+	{
+		return;
+	}
+	const VoiceFormat& format = reader.GetFormat();
+	const uint32_t framesPerBuffer = (std::max)(static_cast<uint32_t>(format.samplesPerSec * bufferSeconds), 256u);
+	bufferBytes = framesPerBuffer * format.blockAlign;
+	for (size_t i = 0; i < BufferCount; ++i)
+	{
+		buffers.emplace_back(std::make_unique<uint8_t[]>(bufferBytes));
+	}
+	voice = voiceFactory(format);
+	if (voice)
+	{
+		voice->SetBufferEndCallback([this]() { condition.notify_one(); });
+	}
+}
+
+AudioStream::~AudioStream()
+{
+	Stop();
+	voice.reset();
+}
+
+float AudioStream::GetDuration() const
+{
+	const uint32_t samplesPerSec = reader.GetFormat().samplesPerSec;
+	return samplesPerSec ? static_cast<float>(reader.GetFrameCount()) / samplesPerSec : 0.0f;
+}
+
+void AudioStream::SetLoop(float beginSeconds, float lengthSeconds)
+{
+	const uint64_t frames = reader.GetFrameCount();
+	const uint32_t samplesPerSec = reader.GetFormat().samplesPerSec;
+	uint64_t begin = static_cast<uint64_t>((std::max)(beginSeconds, 0.0f) * samplesPerSec);
+	uint64_t length = static_cast<uint64_t>((std::max)(lengthSeconds, 0.0f) * samplesPerSec);
+	// ͈̓`FbN (͈͊OȂŜ[v)
+	if (begin >= frames)
+	{
+		begin = 0;
+		length = 0;
+	}
+	else if (length == 0 || begin + length > frames)
+	{
+		length = frames - begin;
+	}
+	loopBegin = begin;
+	loopEnd = length ? begin + length : 0;
+}
+
+void AudioStream::Play(uint32_t loopCount)
+{
+	_ASSERT_EXPR(voice, L"Xg[JĂ܂B");
+	if (!voice)
+	{
+		return;
+	}
+	Stop();
+	isPlaying = true;
+	thread = std::thread(&AudioStream::ThreadMain, this, loopCount);
+}
+
+void AudioStream::Stop()
+{
+	if (thread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isStopRequested = true;
+		}
+		condition.notify_one();
+		thread.join();
+		isStopRequested = false;
+	}
+	if (voice)
+	{
+		voice->Stop();
+	}
+	isPlaying = false;
+}
+
+void AudioStream::SetVolume(float volume)
+{
+	if (voice)
+	{
+		voice->SetVolume(volume);
+	}
+}
+
+uint32_t AudioStream::Fill(uint8_t* destination, uint32_t& loopsLeft, bool& isEndOfStream)
+{
+	const uint32_t bytesPerFrame = reader.GetBytesPerFrame();
+	const size_t capacity = bufferBytes / bytesPerFrame;
+	size_t written = 0;
+	while (written < capacity)
+	{
+		// [vcĂԂ̓[vԂ̏I܂ŁAcĂȂ΍Ō܂œǂ
+		const uint64_t regionEnd = loopEnd.load();
+		const uint64_t end = loopsLeft > 0 && regionEnd > 0 ? regionEnd : reader.GetFrameCount();
+		if (reader.GetPosition() >= end)
+		{
+			if (loopsLeft == 0)
+			{
+				isEndOfStream = true;
+				break;
+			}
+			reader.Seek(loopBegin.load());
+			if (loopsLeft != LoopInfinite)
+			{
+				--loopsLeft;
+			}
+			continue;
+		}
+		const size_t frames = static_cast<size_t>((std::min)(static_cast<uint64_t>(capacity - written), end - reader.GetPosition()));
+		const size_t read = reader.Read(destination + written * bytesPerFrame, frames);
+		if (read == 0)
+		{
+			// t@CrŐ؂Ă
+			isEndOfStream = true;
+			break;
+		}
+		written += read;
+	}
+	// 傤ǍŌ܂œǂ񂾃obt@ɂÏt (̃obt@͑Ȃ)
+	if (loopsLeft == 0 && reader.GetPosition() >= reader.GetFrameCount())
+	{
+		isEndOfStream = true;
+	}
+	return static_cast<uint32_t>(written * bytesPerFrame);
+}
+
+void AudioStream::ThreadMain(uint32_t loopCount)
+{
+	reader.Seek(0);
+	uint32_t loopsLeft = loopCount;
+	bool isEndOfStream = false;
+	bool isStarted = false;
+	size_t next = 0;
+	// obt@ 1 ̒ 1/8 Ƃɋ󂫂 (XAudio2 ̓obt@IɂN)
+	const uint32_t bytesPerSecond = reader.GetFormat().samplesPerSec * reader.GetBytesPerFrame();
+	const auto interval = std::chrono::microseconds((std::max)(static_cast<long long>(1000000ll * bufferBytes / (std::max)(bytesPerSecond, 1u) / 8), 1000ll));
+	while (true)
+	{
+		uint32_t queued = 0;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			// Ō܂ő͋󂫂ł͂ȂSĖÎ҂ (󂫂邽тɋNĉ葱Ȃ悤)
+			condition.wait_for(lock, interval, [&]()
+				{
+					queued = voice->GetQueuedCount();
+					return isStopRequested || (isEndOfStream ? queued == 0 : queued < BufferCount);
+				});
+			if (isStopRequested)
+			{
+				break;
+			}
+		}
+		if (isEndOfStream)
+		{
+			// obt@SĖ炵II
+			if (queued == 0)
+			{
+				break;
+			}
+			continue;
+		}
+		if (queued >= BufferCount)
+		{
+			continue;
+		}
+
+		uint8_t* buffer = buffers[next].get();
+		const uint32_t bytes = Fill(buffer, loopsLeft, isEndOfStream);
+		if (bytes > 0)
+		{
+			voice->Submit(buffer, bytes, isEndOfStream);
+			next = (next + 1) % BufferCount;
+		}
+		// SẴobt@𖄂߂Ă (ZȂŌ܂œǂł) 炵n߂
+		if (!isStarted && (queued + 1 >= BufferCount || isEndOfStream))
+		{
+			voice->Start();
+			isStarted = true;
+		}
+	}
+	isPlaying = false;
+}
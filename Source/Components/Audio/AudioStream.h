@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AudioVoicePool.h"
+
+// WAV t@C PCM ɂēǂ
+//   Ή` : PCM (8/16/24/32 rbg), IEEE float, IMA ADPCM (16 rbg PCM ɂ)
+//   wb_[ɓǂ݁Af[^̓t@C珇ɓǂނ̂ŁAt@CŜɒuȂ
+class WavStreamReader
+{
+public:
+	static constexpr uint16_t FormatPcm = 0x0001;
+	static constexpr uint16_t FormatIeeeFloat = 0x0003;
+	static constexpr uint16_t FormatImaAdpcm = 0x0011;
+	static constexpr uint16_t FormatExtensible = 0xFFFE;
+
+	bool Open(const std::filesystem::path& path);
+	bool IsOpen() const { return stream.is_open(); }
+	const std::string& GetError() const { return error; }
+
+	// ǂݏo PCM ̌` (IMA ADPCM  16 rbg PCM)
+	const VoiceFormat& GetFormat() const { return format; }
+	uint16_t GetSourceFormatTag() const { return sourceFormatTag; }
+	uint32_t GetBytesPerFrame() const { return format.blockAlign; }
+	uint64_t GetFrameCount() const { return frameCount; }
+	uint64_t GetPosition() const { return position; }
+
+	// frames  (Ō܂œǂ񂾂班Ȃ) ̃Tv PCM ŏ݁AԂ
+	size_t Read(uint8_t* destination, size_t frames);
+	bool Seek(uint64_t frame);
+
+private:
+	// Source/Test/AudioStreamTest.cpp  IMA ADPCM ̃t@ĈɎg
+	friend class AudioStreamTest;
+
+	// IMA ADPCM  4 rbg 1 Tvɂ (predictor  index i߂)
+	static int16_t DecodeImaNibble(int nibble, int& predictor, int& index);
+	// index ̗̎ʎq̕
+	static int GetImaStep(int index);
+
+	bool DecodeAdpcmBlock(uint64_t block);
+
+	std::ifstream stream;
+	std::string error;
+	VoiceFormat format;
+	uint16_t sourceFormatTag = 0;
+	uint64_t dataOffset = 0;
+	uint64_t dataBytes = 0;
+	uint64_t frameCount = 0;
+	uint64_t position = 0;
+
+	// IMA ADPCM
+	uint32_t adpcmBlockAlign = 0;
+	uint32_t adpcmFramesPerBlock = 0;
+	std::vector<uint8_t> adpcmBlock;
+	std::vector<int16_t> adpcmDecoded;	// ̃ubN PCM ɂ
+	uint64_t adpcmDecodedBlock = UINT64_MAX;
+};
+
+// Xg[Đ̑ (XAudio2 ̃\[X{CXA܂͉炳ȂfoCX)
+//   Submit obt@́AGetQueuedCount ܂ŏȂ
+class AudioStreamVoice
+{
+public:
+	virtual ~AudioStreamVoice() = default;
+
+	virtual bool Submit(const uint8_t* data, uint32_t bytes, bool isEndOfStream) = 0;
+	// ܂IĂȂobt@̐ (ʂ̃XbhĂ)
+	virtual uint32_t GetQueuedCount() = 0;
+	virtual void Start() = 0;
+	// ~߂āAc̃obt@̂Ă
+	virtual void Stop() = 0;
+	virtual void SetVolume(float volume) = 0;
+	// obt@IɌĂԊ֐ (ǂݍ݂̃XbhN)
+	virtual void SetBufferEndCallback(std::function<void()> callback) {}
+};
+
+// 炳ȂfoCX : Start Ă̎Ԃ̕obt@gƂɂ
+class NullAudioStreamVoice : public AudioStreamVoice
+{
+public:
+	explicit NullAudioStreamVoice(const VoiceFormat& format, uint32_t bytesPerSecond) : format(format), bytesPerSecond(bytesPerSecond) {}
+
+	bool Submit(const uint8_t* data, uint32_t bytes, bool isEndOfStream) override;
+	uint32_t GetQueuedCount() override;
+	void Start() override;
+	void Stop() override;
+	void SetVolume(float volume) override {}
+
+	// gIobt@n (m߂pAobt@gIɌĂ)
+	void SetConsumer(std::function<void(const uint8_t* data, uint32_t bytes)> function) { consumer = std::move(function); }
+	// 炷Ȃ (ǂݍ݂ԂɍȂ)
+	uint32_t GetUnderrunCount() const { return underruns; }
+	uint64_t GetConsumedBytes() const { return consumedBytes; }
+	// Ԃ̐iݕ (1 ȂԁAmF𑁂I点鎞ɑ傫)
+	void SetTimeScale(double scale) { timeScale = scale; }
+
+private:
+	void Consume();
+
+	struct Buffer
+	{
+		const uint8_t* data;
+		uint32_t bytes;
+		bool isEndOfStream;
+	};
+	std::mutex mutex;
+	VoiceFormat format;
+	uint32_t bytesPerSecond;
+	std::vector<Buffer> queue;
+	bool isRunning = false;
+	bool isEnded = false;
+	double timeScale = 1.0;
+	double pendingBytes = 0.0;	// 炵Ԃ̕ł܂obt@g؂ĂȂ
+	std::chrono::steady_clock::time_point last;
+	std::function<void(const uint8_t*, uint32_t)> consumer;
+	bool isStarved = false;
+	uint32_t underruns = 0;
+	uint64_t consumedBytes = 0;
+};
+
+// BGM ̃Xg[Đ
+//   ܂傫̃obt@ BufferCount g񂵁Aǂݍ݂̃Xbh WAV ǂ (IMA ADPCM ̓fR[h) {CXɑ
+//   [v (SetLoop) ̏I܂œǂ񂾂Ԃ̎n܂ɖ߂ēǂݑ̂ŁAԂ̋ڂœr؂Ȃ
+class AudioStream
+{
+public:
+	static constexpr size_t BufferCount = 3;
+	static constexpr uint32_t LoopInfinite = 255;	// XAUDIO2_LOOP_INFINITE Ɠ
+
+	// voiceFactory ɂ͓ǂݏo`n̂ŁǍ`̃{CXĕԂ
+	using VoiceFactory = std::function<std::unique_ptr<AudioStreamVoice>(const VoiceFormat& format)>;
+
+	// wb_[ǂ (f[^ Play Ăǂݍ݂̃Xbhœǂ)
+	AudioStream(const std::filesystem::path& path, VoiceFactory voiceFactory, float bufferSeconds = 0.25f);
+	~AudioStream();
+	AudioStream(const AudioStream&) = delete;
+	AudioStream& operator=(const AudioStream&) = delete;
+
+	bool IsValid() const { return voice != nullptr; }
+	const std::string& GetError() const { return reader.GetError(); }
+	const VoiceFormat& GetFormat() const { return reader.GetFormat(); }
+	float GetDuration() const;
+	AudioStreamVoice* GetVoice() const { return voice.get(); }
+
+	// [v (bAlength  0 ȂŌ܂)AĐɕς玟ɋԂ̏Iǂގg
+	void SetLoop(float beginSeconds, float lengthSeconds);
+	// ŏ炷 (loopCount 񃋁[vALoopInfinite Ȃ~߂܂)
+	void Play(uint32_t loopCount = 0);
+	void Stop();
+	void SetVolume(float volume);
+	// Ō܂Ŗ炵IA~߂
+	bool IsPlaying() const { return isPlaying.load(); }
+
+	// ɒuĂ (obt@) ƁAt@CŜǂ񂾎̗
+	size_t GetResidentBytes() const { return buffers.size() * bufferBytes; }
+	uint64_t GetDecodedBytes() const { return reader.GetFrameCount() * reader.GetBytesPerFrame(); }
+
+private:
+	// Source/Test/AudioStreamTest.cpp ŏ̃obt@ǂގԂv
+	friend class AudioStreamTest;
+
+	void ThreadMain(uint32_t loopCount);
+	// ̃obt@ǂ ([vԂ̏IŎn܂ɖ߂)Aǂ񂾃oCg
+	uint32_t Fill(uint8_t* destination, uint32_t& loopsLeft, bool& isEndOfStream);
+
+	WavStreamReader reader;
+	std::unique_ptr<AudioStreamVoice> voice;
+	uint32_t bufferBytes = 0;
+	std::vector<std::unique_ptr<uint8_t[]>> buffers;
+
+	std::atomic<uint64_t> loopBegin = 0;	// t[
+	std::atomic<uint64_t> loopEnd = 0;		// t[ (0 ȂŌ)
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool isStopRequested = false;
+	std::atomic<bool> isPlaying = false;
+};
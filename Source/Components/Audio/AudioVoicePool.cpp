@@ -0,0 +1,357 @@
+#include "AudioVoicePool.h"
+
+#include <algorithm>
+
+#include "Engine/Debug/Assert.h"
+
+uint32_t NullAudioVoiceDevice::CreateVoice(const VoiceClip& clip, SoundType type)
+{
+	uint32_t voice;
+	if (!freeVoices.empty())
+	{
+		voice = freeVoices.back();
+		freeVoices.pop_back();
+	}
+	else
+	{
+		voice = static_cast<uint32_t>(voices.size());
+		voices.emplace_back();
+	}
+	voices[voice] = {};
+	voices[voice].isAlive = true;
+	++createdCount;
+	++liveCount;
+	return voice;
+}
+
+void NullAudioVoiceDevice::DestroyVoice(uint32_t voice)
+{
+	_ASSERT_EXPR(voice < voices.size() && voices[voice].isAlive, L"Destroying a dead voice");
+	voices[voice].isAlive = false;
+	freeVoices.push_back(voice);
+	--liveCount;
+}
+
+bool NullAudioVoiceDevice::Start(uint32_t voice, const VoiceClip& clip, float volume, uint32_t loopCount, uint32_t beginFrame)
+{
+	_ASSERT_EXPR(voice < voices.size() && voices[voice].isAlive, L"Starting a dead voice");
+	_ASSERT_EXPR(!voices[voice].isPlaying, L"Starting a voice that is still playing");
+	Voice& target = voices[voice];
+	target.isPlaying = true;
+	target.loop = loopCount == LoopInfinite;
+	target.spatial = {};
+	lastBeginFrame = beginFrame;
+
+	// c̒ : n߂ʒuŌ܂ + [v ~ 
+	const uint32_t frames = clip.GetFrameCount();
+	const uint32_t loopLength = clip.loopLength ? clip.loopLength : frames - (std::min)(clip.loopBegin, frames);
+	const float secondsPerFrame = frames ? clip.seconds / frames : 0.0f;
+	target.remaining = (frames - (std::min)(beginFrame, frames) + static_cast<float>(loopLength) * loopCount) * secondsPerFrame;
+	return true;
+}
+
+void NullAudioVoiceDevice::Stop(uint32_t voice)
+{
+	voices[voice].isPlaying = false;
+}
+
+bool NullAudioVoiceDevice::IsPlaying(uint32_t voice)
+{
+	return voices[voice].isPlaying;
+}
+
+void NullAudioVoiceDevice::SetVolume(uint32_t voice, float volume)
+{
+}
+
+void NullAudioVoiceDevice::SetSpatial(uint32_t voice, const VoiceSpatial& spatial)
+{
+	voices[voice].spatial = spatial;
+}
+
+void NullAudioVoiceDevice::Update(float deltaTime)
+{
+	for (Voice& voice : voices)
+	{
+		if (voice.isPlaying && !voice.loop)
+		{
+			voice.remaining -= deltaTime;
+			voice.isPlaying = voice.remaining > 0.0f;
+		}
+	}
+}
+
+
+AudioVoicePool::AudioVoicePool(AudioVoiceDevice* device) : AudioVoicePool(device, Budget{})
+{
+}
+
+AudioVoicePool::AudioVoicePool(AudioVoiceDevice* device, const Budget& budget) : device(device), budget(budget)
+{
+	_ASSERT_EXPR(device, L"AudioVoicePool needs a device");
+	voices.reserve(budget.maxVoices);
+	active.reserve(budget.maxVoices);
+}
+
+AudioVoicePool::~AudioVoicePool()
+{
+	StopAll();
+	for (Voice& voice : voices)
+	{
+		if (voice.deviceVoice != AudioVoiceDevice::InvalidVoice)
+		{
+			device->DestroyVoice(voice.deviceVoice);
+		}
+	}
+}
+
+void AudioVoicePool::Prewarm(const VoiceClip& clip, SoundType type, uint32_t count)
+{
+	std::vector<uint32_t>& freeList = freeLists[clip.format.Key(type)];
+	while (count-- > 0 && statistics.voices < budget.maxVoices)
+	{
+		const uint32_t slot = CreateSlot(clip, type);
+		if (slot == UINT32_MAX)
+		{
+			break;
+		}
+		freeList.push_back(slot);
+	}
+}
+
+AudioVoicePool::Handle AudioVoicePool::Play(const VoiceClip& clip, SoundType type, const PlayParams& params, std::shared_ptr<const void> resource)
+{
+	++statistics.plays;
+	const float audibility = params.volume / (1.0f + (std::max)(params.distance, 0.0f));
+
+	// ȂĂ鐺 1 ~߂Ďg (~߂鐺Ζ炳Ȃ)
+	const bool isTypeFull = playingCount[type] >= budget.maxPlaying[type];
+	if (isTypeFull || active.size() >= budget.maxVoices)
+	{
+		const uint32_t victim = FindVictim(isTypeFull ? type : SoundType::EnumCount, params.priority, audibility);
+		if (victim == UINT32_MAX)
+		{
+			++statistics.rejected;
+			return InvalidHandle;
+		}
+		device->Stop(voices[victim].deviceVoice);
+		Release(victim);
+		++statistics.stolen;
+	}
+
+	const uint32_t slot = AcquireSlot(clip, type);
+	if (slot == UINT32_MAX)
+	{
+		++statistics.rejected;
+		return InvalidHandle;
+	}
+	Voice& voice = voices[slot];
+	if (!device->Start(voice.deviceVoice, clip, params.volume, params.loopCount, params.beginFrame))
+	{
+		freeLists[voice.key].push_back(slot);
+		++statistics.rejected;
+		return InvalidHandle;
+	}
+	voice.isPlaying = true;
+	voice.priority = params.priority;
+	voice.audibility = audibility;
+	voice.order = ++playOrder;
+	voice.resource = std::move(resource);
+	voice.activeIndex = static_cast<uint32_t>(active.size());
+	active.push_back(slot);
+	++playingCount[type];
+	statistics.playing = active.size();
+	statistics.peakPlaying = (std::max)(statistics.peakPlaying, statistics.playing);
+	return MakeHandle(slot, voice.generation);
+}
+
+void AudioVoicePool::Stop(Handle handle)
+{
+	if (Voice* voice = Resolve(handle))
+	{
+		device->Stop(voice->deviceVoice);
+		Release(static_cast<uint32_t>(voice - voices.data()));
+	}
+}
+
+void AudioVoicePool::StopAll()
+{
+	while (!active.empty())
+	{
+		const uint32_t slot = active.back();
+		device->Stop(voices[slot].deviceVoice);
+		Release(slot);
+	}
+}
+
+bool AudioVoicePool::IsPlaying(Handle handle) const
+{
+	return Resolve(handle) != nullptr;
+}
+
+void AudioVoicePool::SetVolume(Handle handle, float volume)
+{
+	if (Voice* voice = Resolve(handle))
+	{
+		device->SetVolume(voice->deviceVoice, volume);
+	}
+}
+
+void AudioVoicePool::SetSpatial(Handle handle, const VoiceSpatial& spatial)
+{
+	if (Voice* voice = Resolve(handle))
+	{
+		device->SetSpatial(voice->deviceVoice, spatial);
+		voice->audibility = spatial.volume;
+	}
+}
+
+void AudioVoicePool::Update(float deltaTime)
+{
+	device->Update(deltaTime);
+	// 납猩̂ŁAւďĂƂȂ
+	for (size_t i = active.size(); i-- > 0;)
+	{
+		const uint32_t slot = active[i];
+		if (!device->IsPlaying(voices[slot].deviceVoice))
+		{
+			Release(slot);
+		}
+	}
+}
+
+AudioVoicePool::Voice* AudioVoicePool::Resolve(Handle handle)
+{
+	return const_cast<Voice*>(static_cast<const AudioVoicePool*>(this)->Resolve(handle));
+}
+
+const AudioVoicePool::Voice* AudioVoicePool::Resolve(Handle handle) const
+{
+	const uint32_t slot = (handle >> 16) - 1;
+	if (handle == InvalidHandle || slot >= voices.size())
+	{
+		return nullptr;
+	}
+	const Voice& voice = voices[slot];
+	return voice.isPlaying && voice.generation == static_cast<uint16_t>(handle & 0xFFFF) ? &voice : nullptr;
+}
+
+uint32_t AudioVoicePool::FindVictim(SoundType type, int priority, float audibility) const
+{
+	// DxႢ  ɂ  Â ̏Ɏ~߂
+	uint32_t victim = UINT32_MAX;
+	for (uint32_t slot : active)
+	{
+		const Voice& voice = voices[slot];
+		if (type != SoundType::EnumCount && voice.type != type)
+		{
+			continue;
+		}
+		if (victim == UINT32_MAX)
+		{
+			victim = slot;
+			continue;
+		}
+		const Voice& current = voices[victim];
+		if (voice.priority != current.priority ? voice.priority < current.priority :
+			voice.audibility != current.audibility ? voice.audibility < current.audibility : voice.order < current.order)
+		{
+			victim = slot;
+		}
+	}
+	// V̕厖Ȏ~߂ (ȂÂ~߂)
+	if (victim != UINT32_MAX)
+	{
+		const Voice& voice = voices[victim];
+		if (voice.priority > priority || (voice.priority == priority && voice.audibility > audibility))
+		{
+			return UINT32_MAX;
+		}
+	}
+	return victim;
+}
+
+uint32_t AudioVoicePool::AcquireSlot(const VoiceClip& clip, SoundType type)
+{
+	std::vector<uint32_t>& freeList = freeLists[clip.format.Key(type)];
+	if (!freeList.empty())
+	{
+		const uint32_t slot = freeList.back();
+		freeList.pop_back();
+		++statistics.reused;
+		return slot;
+	}
+	// ̐ȂAʂ̌`̋󂫂̐č
+	if (statistics.voices >= budget.maxVoices)
+	{
+		for (auto& [key, slots] : freeLists)
+		{
+			if (slots.empty())
+			{
+				continue;
+			}
+			const uint32_t slot = slots.back();
+			slots.pop_back();
+			device->DestroyVoice(voices[slot].deviceVoice);
+			voices[slot].deviceVoice = AudioVoiceDevice::InvalidVoice;
+			voices[slot].resource.reset();
+			freeSlots.push_back(slot);
+			--statistics.voices;
+			++statistics.evicted;
+			break;
+		}
+		if (statistics.voices >= budget.maxVoices)
+		{
+			return UINT32_MAX;
+		}
+	}
+	return CreateSlot(clip, type);
+}
+
+uint32_t AudioVoicePool::CreateSlot(const VoiceClip& clip, SoundType type)
+{
+	const uint32_t deviceVoice = device->CreateVoice(clip, type);
+	if (deviceVoice == AudioVoiceDevice::InvalidVoice)
+	{
+		return UINT32_MAX;
+	}
+	uint32_t slot;
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast<uint32_t>(voices.size());
+		voices.emplace_back();
+	}
+	Voice& voice = voices[slot];
+	voice.deviceVoice = deviceVoice;
+	voice.key = clip.format.Key(type);
+	voice.type = type;
+	voice.isPlaying = false;
+	++statistics.voices;
+	++statistics.created;
+	return slot;
+}
+
+void AudioVoicePool::Release(uint32_t slot)
+{
+	Voice& voice = voices[slot];
+	_ASSERT_EXPR(voice.isPlaying, L"Releasing a voice that is not playing");
+
+	// Ă鐺̕тւĊO
+	const uint32_t last = active.back();
+	active[voice.activeIndex] = last;
+	voices[last].activeIndex = voice.activeIndex;
+	active.pop_back();
+
+	voice.isPlaying = false;
+	// Â Handle ŐGȂ悤ɐi߂ (0 ͎gȂ)
+	voice.generation = voice.generation == UINT16_MAX ? 1 : static_cast<uint16_t>(voice.generation + 1);
+	voice.resource.reset();
+	--playingCount[voice.type];
+	statistics.playing = active.size();
+	freeLists[voice.key].push_back(slot);
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum SoundType
+{
+	BGM,
+	SE,
+	EnumCount
+};
+
+//  (\[X{CX) 邩ǂ߂g`̌`
+// `E (SoundType) ̐ȂAʂ̃Nbv𑱂Ė点
+struct VoiceFormat
+{
+	uint16_t formatTag = 0;
+	uint16_t channels = 0;
+	uint32_t samplesPerSec = 0;
+	uint16_t bitsPerSample = 0;
+	uint16_t blockAlign = 0;
+
+	uint64_t Key(SoundType type) const
+	{
+		return (static_cast<uint64_t>(formatTag) << 48) ^ (static_cast<uint64_t>(channels) << 40) ^ (static_cast<uint64_t>(bitsPerSample) << 32) ^
+			(static_cast<uint64_t>(blockAlign) << 24) ^ (static_cast<uint64_t>(samplesPerSec) << 2) ^ static_cast<uint64_t>(type);
+	}
+};
+
+// 炷g` (f[^͎ (Audio::AudioBuffer) )
+struct VoiceClip
+{
+	VoiceFormat format;
+	const void* nativeFormat = nullptr;	// foCX鎞Ɏg` (XAudio2 Ȃ WAVEFORMATEXTENSIBLE)
+	const uint8_t* data = nullptr;
+	uint32_t bytes = 0;
+	float seconds = 0.0f;				// 1 炷
+	uint32_t loopBegin = 0;				// [v (TvA 0 ȂS)
+	uint32_t loopLength = 0;
+
+	uint32_t GetFrameCount() const { return format.blockAlign ? bytes / format.blockAlign : 0; }
+};
+
+// 3D ̌vZ (AudioSpatializer) ̌ʂ𐺂ɔfl
+struct VoiceSpatial
+{
+	float volume = 1.0f;			// ƎՕŌ
+	float left = 1.0f;				// Eւ̏o (Ȃ痼 1)
+	float right = 1.0f;
+	float frequencyRatio = 1.0f;	// hbv[
+	float lowPassFrequency = 0.0f;	// [pX̎g (HzA0 Ȃ|Ȃ)
+};
+
+// Ė炷 (XAudio2 ̑ɉ炳ȂfoCXn΁ȀoȂłv[m߂)
+class AudioVoiceDevice
+{
+public:
+	static constexpr uint32_t InvalidVoice = UINT32_MAX;
+	static constexpr uint32_t LoopInfinite = 255;	// XAUDIO2_LOOP_INFINITE Ɠ
+
+	virtual ~AudioVoiceDevice() = default;
+
+	//  (Ȃ InvalidVoice)
+	virtual uint32_t CreateVoice(const VoiceClip& clip, SoundType type) = 0;
+	virtual void DestroyVoice(uint32_t voice) = 0;
+	// Nbv beginFrame 炷 (loopCount Nbṽ[vԂJԂ)
+	virtual bool Start(uint32_t voice, const VoiceClip& clip, float volume, uint32_t loopCount, uint32_t beginFrame) = 0;
+	// Ɏ~߂āAc̃obt@̂Ă (ɕʂ̃Nbv点悤)
+	virtual void Stop(uint32_t voice) = 0;
+	virtual bool IsPlaying(uint32_t voice) = 0;
+	virtual void SetVolume(uint32_t voice, float volume) = 0;
+	// ȄóEg̔E[pX ( Start ܂Ŏc)
+	virtual void SetSpatial(uint32_t voice, const VoiceSpatial& spatial) = 0;
+	virtual void Update(float deltaTime) {}
+};
+
+// 炳ȂfoCX (Nbv̒Ԃi߂āAIƂɂ)
+class NullAudioVoiceDevice : public AudioVoiceDevice
+{
+public:
+	uint32_t CreateVoice(const VoiceClip& clip, SoundType type) override;
+	void DestroyVoice(uint32_t voice) override;
+	bool Start(uint32_t voice, const VoiceClip& clip, float volume, uint32_t loopCount, uint32_t beginFrame) override;
+	void Stop(uint32_t voice) override;
+	bool IsPlaying(uint32_t voice) override;
+	void SetVolume(uint32_t voice, float volume) override;
+	void SetSpatial(uint32_t voice, const VoiceSpatial& spatial) override;
+	void Update(float deltaTime) override;
+
+	size_t GetCreatedCount() const { return createdCount; }
+	size_t GetLiveCount() const { return liveCount; }
+	// m߂p : Ō Start ̈ʒuƁAɔfl
+	uint32_t GetLastBeginFrame() const { return lastBeginFrame; }
+	const VoiceSpatial& GetSpatial(uint32_t voice) const { return voices[voice].spatial; }
+
+private:
+	struct Voice
+	{
+		bool isAlive = false;
+		bool isPlaying = false;
+		bool loop = false;
+		float remaining = 0.0f;
+		VoiceSpatial spatial;
+	};
+	std::vector<Voice> voices;
+	std::vector<uint32_t> freeVoices;
+	size_t createdCount = 0;
+	size_t liveCount = 0;
+	uint32_t lastBeginFrame = 0;
+};
+
+// ʉ̐g񂷃v[
+//   I͌`Ƒ悲Ƃ̋󂫃Xgɖ߂āAɓ`炷ɍ炸Ɏg
+//   SoundType ƂƑŜœɖ炷̏A̎͗DxႢEEÂ~߂Ďg
+//   炵 Handle (ԍƐ) ŎŵŁA~߂Ďg񂳂ꂽɐGĂʂ̉ɂ͉eȂ
+class AudioVoicePool
+{
+public:
+	using Handle = uint32_t;
+	static constexpr Handle InvalidHandle = 0;
+
+	struct Budget
+	{
+		uint32_t maxVoices = 32;							// Ă̐̏ (󂫂̐܂)
+		uint32_t maxPlaying[SoundType::EnumCount] = { 4, 24 };	// SoundType Ƃɓɖ炷
+	};
+
+	struct PlayParams
+	{
+		float volume = 1.0f;
+		int priority = 0;		// 傫قǎ~߂ɂ
+		float distance = 0.0f;	// Xi[̋ (قǎ~߂₷)
+		uint32_t loopCount = 0;	// AudioVoiceDevice::LoopInfinite Ȃ~߂܂
+		uint32_t beginFrame = 0;	// r炷 (zĂ߂)
+	};
+
+	struct Statistics
+	{
+		size_t plays = 0;
+		size_t created = 0;		// 
+		size_t reused = 0;		// 󂫂̐g
+		size_t stolen = 0;		// Ă鐺~߂Ďg
+		size_t rejected = 0;	// Ŗ炳Ȃ
+		size_t evicted = 0;		// ʂ̌`̋󂫂̐
+		size_t playing = 0;
+		size_t peakPlaying = 0;
+		size_t voices = 0;
+	};
+
+	explicit AudioVoicePool(AudioVoiceDevice* device);
+	AudioVoicePool(AudioVoiceDevice* device, const Budget& budget);
+	~AudioVoicePool();
+	AudioVoicePool(const AudioVoicePool&) = delete;
+	AudioVoicePool& operator=(const AudioVoicePool&) = delete;
+
+	// `̐OčĂ (ŏɖ炵ɍ̂)
+	void Prewarm(const VoiceClip& clip, SoundType type, uint32_t count);
+
+	// 炷 (Ŗ点Ȃ InvalidHandle)
+	// resource ͖ĂԃNbṽf[^Ă߂̂
+	Handle Play(const VoiceClip& clip, SoundType type, const PlayParams& params, std::shared_ptr<const void> resource = nullptr);
+	void Stop(Handle handle);
+	void StopAll();
+	bool IsPlaying(Handle handle) const;
+	void SetVolume(Handle handle, float volume);
+	// 3D ̌vZʂ𔽉f (~߂鐺IԎ̕₷ʂɂ)
+	void SetSpatial(Handle handle, const VoiceSpatial& spatial);
+
+	// I󂫃Xgɖ߂ (1 t[ 1 )
+	void Update(float deltaTime);
+
+	const Statistics& GetStatistics() const { return statistics; }
+	size_t GetPlayingCount(SoundType type) const { return playingCount[type]; }
+	const Budget& GetBudget() const { return budget; }
+	void SetBudget(const Budget& value) { budget = value; }
+
+private:
+	struct Voice
+	{
+		uint32_t deviceVoice = AudioVoiceDevice::InvalidVoice;
+		uint64_t key = 0;
+		SoundType type = SoundType::SE;
+		uint16_t generation = 1;
+		bool isPlaying = false;
+		int priority = 0;
+		float audibility = 0.0f;	//  / (1 + )
+		uint64_t order = 0;			// 炵
+		uint32_t activeIndex = 0;	// active ̒̈ʒu
+		std::shared_ptr<const void> resource;
+	};
+
+	static Handle MakeHandle(uint32_t slot, uint16_t generation) { return ((slot + 1) << 16) | generation; }
+	Voice* Resolve(Handle handle);
+	const Voice* Resolve(Handle handle) const;
+
+	// ~߂鐺I (type  EnumCount ȂSĂ̎ނA UINT32_MAX)
+	uint32_t FindVictim(SoundType type, int priority, float audibility) const;
+	uint32_t AcquireSlot(const VoiceClip& clip, SoundType type);
+	uint32_t CreateSlot(const VoiceClip& clip, SoundType type);
+	void Release(uint32_t slot);
+
+	AudioVoiceDevice* device;
+	Budget budget;
+	std::vector<Voice> voices;
+	std::vector<uint32_t> active;								// Ă鐺
+	std::unordered_map<uint64_t, std::vector<uint32_t>> freeLists;	// `Ƒ悲Ƃ̋󂫂̐
+	std::vector<uint32_t> freeSlots;							// ̏ꏊ
+	size_t playingCount[SoundType::EnumCount] = {};
+	uint64_t playOrder = 0;
+	Statistics statistics;
+};
@@ -82,15 +82,15 @@ void DebugCameraComponent::HandleKeyboardInput(float deltaTime)
 
     DirectX::XMVECTOR move = DirectX::XMVectorZero();
 
-    if (InputSystem::GetInputState("W")) { move += forward; }
-    if (InputSystem::GetInputState("S")) { move -= forward; }
-    if (InputSystem::GetInputState("D")) { move += right; }
-    if (InputSystem::GetInputState("A")) { move -= right; }
+    if (InputSystem::GetInputState(INPUT_ACTION("W"))) { move += forward; }
+    if (InputSystem::GetInputState(INPUT_ACTION("S"))) { move -= forward; }
+    if (InputSystem::GetInputState(INPUT_ACTION("D"))) { move += right; }
+    if (InputSystem::GetInputState(INPUT_ACTION("A"))) { move -= right; }
     //
-    if (InputSystem::GetInputState("E")) { move += up; }
-    if (InputSystem::GetInputState("Q")) { move -= up; }
+    if (InputSystem::GetInputState(INPUT_ACTION("E"))) { move += up; }
+    if (InputSystem::GetInputState(INPUT_ACTION("Q"))) { move -= up; }
 
-    if (InputSystem::GetInputState("Shift")) { move = DirectX::XMVectorScale(move, 2.5f); }
+    if (InputSystem::GetInputState(INPUT_ACTION("Shift"))) { move = DirectX::XMVectorScale(move, 2.5f); }
 
     move = DirectX::XMVectorScale(move, moveSpeed * deltaTime);
 
@@ -230,7 +230,7 @@ private:
 
     void HandleMouseInput(float deltaTime)
     {
-        if (InputSystem::GetInputState("MouseRight"))
+        if (InputSystem::GetInputState(INPUT_ACTION("MouseRight")))
         {
             int deltaX, deltaY;
             InputSystem::GetMouseDelta(deltaX, deltaY);
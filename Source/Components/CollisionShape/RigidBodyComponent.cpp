@@ -1,5 +1,6 @@
 #include "RigidBodyComponent.h"
 
+#include <algorithm>
 #include <PxPhysicsAPI.h>
 #include "Physics/PhysicsHelper.h"
 #include "ShapeComponent.h"
@@ -410,7 +411,7 @@ void MultiRigidBodyComponent::Initialize(physx::PxPhysics* physics)
 
         for (const auto& primitive : mesh.primitives)
         {
-            PxConvexMesh* convexMesh = ToPxConvexMesh(physics, primitive.cachedVertices);
+            PxConvexMesh* convexMesh = ToPxConvexMesh(physics, primitive.DecodeVertices());
             PxConvexMeshGeometry geometry(convexMesh, PxMeshScale(pxScale));
 
             PxShape* shape = physics->createShape(geometry, material);
@@ -625,7 +626,7 @@ void TriangleMeshRigidBodyComponent::Initialize(physx::PxPhysics* physics)
     size_t totalVertexCount = 0;
     for (const auto& mesh : model->batchMeshes)
     {
-        totalVertexCount += mesh.cachedVertices.size();
+        totalVertexCount += mesh.VertexCount();
     }
     // _ɉĕ򂷂
     bool use32BitIndex = (totalVertexCount >= 65536);
@@ -639,28 +640,32 @@ void TriangleMeshRigidBodyComponent::Initialize(physx::PxPhysics* physics)
 
     for (const auto& mesh : model->batchMeshes)
     {
-        for (const auto& vertex : mesh.cachedVertices)
+        for (size_t vertexIndex = 0; vertexIndex < mesh.VertexCount(); ++vertexIndex)
         {
-            vertices.emplace_back(vertex.position.x * unitScale, vertex.position.y * unitScale, vertex.position.z * unitScale);
+            const DirectX::XMFLOAT3 position = mesh.GetPosition(vertexIndex);
+            vertices.emplace_back(position.x * unitScale, position.y * unitScale, position.z * unitScale);
         }
 
+        // CfbNX̌ɂ LOD ̒i͊܂߂Ȃ
+        const MeshSimplifier::Lod lod = mesh.GetLod(0);
+        const size_t indexCount = (std::min)(static_cast<size_t>(lod.indexCount), mesh.cachedIndices.size());
         if (use32BitIndex)
         {
-            for (const auto& index : mesh.cachedIndices)
+            for (size_t i = 0; i < indexCount; ++i)
             {
-                indices32.push_back(index + vertexOffset);
+                indices32.push_back(mesh.cachedIndices[i] + vertexOffset);
             }
         }
         else
         {
-            for (const auto& index : mesh.cachedIndices)
+            for (size_t i = 0; i < indexCount; ++i)
             {
-                indices16.push_back(static_cast<PxU16>(index + vertexOffset));
+                indices16.push_back(static_cast<PxU16>(mesh.cachedIndices[i] + vertexOffset));
             }
         }
 
         // _ItZbg݂ŉZ
-        vertexOffset += static_cast<PxU32>(mesh.cachedVertices.size());
+        vertexOffset += static_cast<PxU32>(mesh.VertexCount());
     }
 
     PxTriangleMeshDesc pxMeshDesc;
@@ -488,13 +488,14 @@ private:
 
         for (auto& primitive : mesh.primitives)
         {
-            for (auto& vertex : primitive.cachedVertices)
+            for (size_t vertexIndex = 0; vertexIndex < primitive.VertexCount(); ++vertexIndex)
             {
+                const DirectX::XMFLOAT3 position = primitive.GetPosition(vertexIndex);
                 DirectX::XMFLOAT3 scaledPos =
                 {
-                    vertex.position.x /** unitScale*/,
-                    vertex.position.y /** unitScale*/,
-                    vertex.position.z /** unitScale*/,
+                    position.x /** unitScale*/,
+                    position.y /** unitScale*/,
+                    position.z /** unitScale*/,
                 };
 
                 uniquePositions.insert(scaledPos);
@@ -32,22 +32,22 @@ public:
 
         if (!CameraManager::IsUseDebug())
         {
-            if (InputSystem::GetInputState("W"))
+            if (InputSystem::GetInputState(INPUT_ACTION("W")))
             {
                 inputDir.z += 1.0f;
                 //position.z += 2.0f * deltaTime;
             }
-            if (InputSystem::GetInputState("S"))
+            if (InputSystem::GetInputState(INPUT_ACTION("S")))
             {
                 inputDir.z -= 1.0f;
                 //position.z -= 2.0f * deltaTime;
             }
-            if (InputSystem::GetInputState("D"))
+            if (InputSystem::GetInputState(INPUT_ACTION("D")))
             {
                 inputDir.x += 1.0f;
                 //position.x += 2.0f * deltaTime;
             }
-            if (InputSystem::GetInputState("A"))
+            if (InputSystem::GetInputState(INPUT_ACTION("A")))
             {
                 inputDir.x -= 1.0f;
                 //position.x -= 2.0f * deltaTime;
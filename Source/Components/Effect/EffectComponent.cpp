@@ -2,10 +2,34 @@
 
 #include "Graphics/Core/Graphics.h"
 #include "Core/Actor.h"
+
+EffectComponent::~EffectComponent()
+{
+    EffectComponent::OnUnregister();
+}
+
 void EffectComponent::Initialize()
 {
 }
 
+void EffectComponent::OnRegister()
+{
+    if (registryHandle_ == EffectRegistry::InvalidHandle)
+    {
+        registryHandle_ = EffectRegistry::Instance().Register(this);
+    }
+}
+
+void EffectComponent::OnUnregister()
+{
+    // Destroy  Actor ̔j̗Ă΂̂ 2 ڂ͉Ȃ
+    if (registryHandle_ != EffectRegistry::InvalidHandle)
+    {
+        EffectRegistry::Instance().Unregister(registryHandle_);
+        registryHandle_ = EffectRegistry::InvalidHandle;
+    }
+}
+
 void EffectComponent::Tick(float deltaTime)
 {
     switch (effectState_)
@@ -37,6 +61,10 @@ void EffectComponent::Activate()
 {
     effectState_ = EffectState::Initlaizeing;
     //isActivated_ = true;
+
+    // NewSceneComponent ȊOōꂽ́Aœo^
+    OnRegister();
+    EffectRegistry::Instance().Push(registryHandle_, EffectRegistry::RequestType::Play);
 }
 
 void EffectComponent::Initialized()
@@ -48,6 +76,7 @@ void EffectComponent::Deactivate()
 {
     effectState_ = EffectState::Finished;
     //effectState_ = EffectState::InActive;
+    EffectRegistry::Instance().Push(registryHandle_, EffectRegistry::RequestType::Stop);
 
 }
 
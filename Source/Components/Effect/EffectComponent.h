@@ -8,6 +8,7 @@
 #include <wrl.h>
 
 #include "Components/Base/SceneComponent.h"
+#include "Components/Effect/EffectRegistry.h"
 #include "Graphics/Effect/Particles.h"
 #include "Graphics/Resource/Texture.h"
 
@@ -35,17 +36,24 @@ public:
 public:
     EffectComponent(const std::string& name, std::shared_ptr<Actor> owner) :SceneComponent(name, owner) {}
 
-    virtual ~EffectComponent() = default;
+    virtual ~EffectComponent();
 
     virtual void Initialize() override;
 
     virtual void Tick(float deltaTime) override;
 
+    // EffectRegistry ɓo^E (EffectSystem ͓o^ꂽR|[lg̗v)
+    virtual void OnRegister() override;
+    virtual void OnUnregister() override;
+
+    // Đ̗v EffectRegistry ɐς (EffectSystem::Update ŏ)
+    // o^ƏԂ̂ŃCXbhĂ
     void Activate();
 
     // particlët[̏IĂԊ֐
     void Initialized();
 
+    // ~̗v EffectRegistry ɐς (CXbh)
     void Deactivate();
 
     bool  IsPlay() const;
@@ -92,7 +100,9 @@ private:
 
     bool isFinished_ = false;   // oI
 
-    EffectComponent::EffectState effectState_;
+    EffectComponent::EffectState effectState_ = EffectState::InActive;
+
+    EffectRegistry::Handle registryHandle_ = EffectRegistry::InvalidHandle;
 
     float power_=0.0f;
 
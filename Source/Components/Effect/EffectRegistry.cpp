@@ -0,0 +1,81 @@
+#include "EffectRegistry.h"
+
+#include "Engine/Debug/Assert.h"
+
+EffectRegistry::EffectRegistry(size_t queueCapacity)
+{
+    requests.reserve(queueCapacity);
+}
+
+EffectRegistry::Handle EffectRegistry::Register(EffectComponent* component)
+{
+    uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        _ASSERT_EXPR(slots.size() < 0xFFFF, L"EffectRegistry : too many effect components");
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    Slot& slot = slots[index];
+    slot.component = component;
+    ++registeredCount;
+    return index | (static_cast<uint32_t>(slot.generation) << 16);
+}
+
+void EffectRegistry::Unregister(Handle handle)
+{
+    if (!Resolve(handle))
+    {
+        return;
+    }
+    const uint32_t index = handle & 0xFFFF;
+    Slot& slot = slots[index];
+    slot.component = nullptr;
+    // cĂv⃊Xg̃nhȂȂ悤ɐi߂ (0 ͎gȂ)
+    slot.generation = slot.generation == 0xFFFF ? 1 : slot.generation + 1;
+    freeSlots.push_back(index);
+    --registeredCount;
+}
+
+EffectComponent* EffectRegistry::Resolve(Handle handle) const
+{
+    const uint32_t index = handle & 0xFFFF;
+    if (handle == InvalidHandle || index >= slots.size() || slots[index].generation != (handle >> 16))
+    {
+        return nullptr;
+    }
+    return slots[index].component;
+}
+
+void EffectRegistry::Push(Handle handle, RequestType type)
+{
+    requests.push_back({ handle, type });
+    ++pushed;
+}
+
+bool EffectRegistry::Pop(Request& request)
+{
+    if (readIndex >= requests.size())
+    {
+        requests.clear();
+        readIndex = 0;
+        return false;
+    }
+    request = requests[readIndex++];
+    ++popped;
+    return true;
+}
+
+EffectRegistry::Statistics EffectRegistry::GetStatistics() const
+{
+    Statistics statistics;
+    statistics.registered = registeredCount;
+    statistics.pushed = pushed;
+    statistics.popped = popped;
+    return statistics;
+}
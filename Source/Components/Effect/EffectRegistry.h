@@ -0,0 +1,77 @@
+#ifndef EFFECT_REGISTRY_H
+#define EFFECT_REGISTRY_H
+
+#include <cstdint>
+#include <vector>
+
+class EffectComponent;
+
+// EffectComponent ̓o^ƁAĐE~̗ṽL[
+//   EffectComponent  OnRegister œo^AOnUnregister (DestroyEfXgN^) ŉ
+//   v̓CXbhG郊Xgɐς (Activate / Deactivate ͓o^ƃR|[lg̏ԂĜŃCXbhĂ)
+//   EffectSystem::Update vočĐ̃GtFNgAActor SČĉȂ
+//   nh Xbg +  Ȃ̂ŁAɎcvĐ̃Xg̃nh Resolve  nullptr ɂȂ
+class EffectRegistry
+{
+public:
+    using Handle = uint32_t;    //  16 rbg : XbgA 16 rbg :  (0 ɂȂȂ)
+    static constexpr Handle InvalidHandle = 0;
+    static constexpr size_t DefaultQueueCapacity = 1024;
+
+    enum class RequestType : uint8_t
+    {
+        Play,
+        Stop,
+    };
+    struct Request
+    {
+        Handle handle = InvalidHandle;
+        RequestType type = RequestType::Play;
+    };
+
+    struct Statistics
+    {
+        size_t registered = 0;  // o^Ă鐔
+        uint64_t pushed = 0;
+        uint64_t popped = 0;
+    };
+
+    // IɐÓIɎꂽ Actor ɏȂ悤ɁAȂ
+    static EffectRegistry& Instance() { static EffectRegistry* instance = new EffectRegistry(); return *instance; }
+
+    // queueCapacity ͍ŏɊmۂĂv̐ (ȂΑ)
+    explicit EffectRegistry(size_t queueCapacity = DefaultQueueCapacity);
+    EffectRegistry(const EffectRegistry&) = delete;
+    EffectRegistry& operator=(const EffectRegistry&) = delete;
+
+    // SăCXbh (R|[lg̐Ej EffectSystem::Update)
+    Handle Register(EffectComponent* component);
+    void Unregister(Handle handle);
+    // Ă nullptr
+    EffectComponent* Resolve(Handle handle) const;
+
+    void Push(Handle handle, RequestType type);
+    // ς񂾏Ɏo (Ȃ false)
+    bool Pop(Request& request);
+
+    Statistics GetStatistics() const;
+
+private:
+    struct Slot
+    {
+        EffectComponent* component = nullptr;
+        uint16_t generation = 1;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    size_t registeredCount = 0;
+
+    // Pop ŎoIɂ (mۂ͎g)
+    std::vector<Request> requests;
+    size_t readIndex = 0;
+    uint64_t pushed = 0;
+    uint64_t popped = 0;
+};
+
+#endif //EFFECT_REGISTRY_H
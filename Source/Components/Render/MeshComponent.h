@@ -39,9 +39,12 @@ public:
     std::optional<std::string> overrideCascadeShadowPipelineName;
 public:
     MeshComponent(const std::string& name, const std::shared_ptr<Actor>& owner) :SceneComponent(name, owner) {};
+    // t@C MeshComponent ԂŋL
     std::shared_ptr<InterleavedGltfModel> model;
     // f̃m[h
     std::vector<InterleavedGltfModel::Node> modelNodes = {};
+    // CX^XƂ̕`p[^ (color, emission, dissolve Ȃ)
+    InterleavedGltfModel::InstanceParameters instanceParameters;
 
     virtual void Tick(float deltaTime)override
     {
@@ -75,6 +78,57 @@ public:
 
     PipeLineStateDesc GetPipeLineState()const { return pipeLineState_; }
 
+    // f̍Wnݒ肷 (Lf͏ɁAWn̕L)
+    void SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem coordinateSystem)
+    {
+        if (!model || model->modelCoordinateSystem == coordinateSystem)
+        {
+            return;
+        }
+        model = InterleavedGltfModel::MakeVariant(model, "cs" + std::to_string(static_cast<int>(coordinateSystem)),
+            [coordinateSystem](InterleavedGltfModel& variant) { variant.modelCoordinateSystem = coordinateSystem; });
+    }
+
+    // SẴ}eA alphaMode ς (0 : OPAQUE, 1 : MASK, 2 : BLENDBL̎d SetCoordinateSystem Ɠ)
+    void SetMaterialsAlphaMode(int alphaMode)
+    {
+        if (!model)
+        {
+            return;
+        }
+        model = InterleavedGltfModel::MakeVariant(model, "alpha" + std::to_string(alphaMode),
+            [alphaMode](InterleavedGltfModel& variant)
+            {
+                for (InterleavedGltfModel::Material& material : variant.materials)
+                {
+                    material.data.alphaMode = alphaMode;
+                }
+            });
+    }
+
+    // SẴ}eÃsNZVF[_[ւ (Lf͏ɁÃR|[lgpɕĂ珑)
+    void ReplaceMaterialsPS(const Microsoft::WRL::ComPtr<ID3D11PixelShader>& pixelShader)
+    {
+        if (!model)
+        {
+            return;
+        }
+        bool isReplaced = true;
+        for (const InterleavedGltfModel::Material& material : model->materials)
+        {
+            isReplaced &= material.replacedPixelShader == pixelShader;
+        }
+        if (isReplaced)
+        {// ɍւĂ (t[Ă΂ĂȂ)
+            return;
+        }
+        model = InterleavedGltfModel::MakeUnique(model);
+        for (InterleavedGltfModel::Material& material : model->materials)
+        {
+            material.replacedPixelShader = pixelShader;
+        }
+    }
+
     void SetIsCastShadow(bool isCastShadow) { this->isCastShadow_ = isCastShadow; }
 
     virtual bool IsCastShadow() const { return isCastShadow_; }
@@ -95,7 +149,7 @@ public:
     void SetModel(const std::string& filename, bool isSaveVerticesData = false)override
     {
         ID3D11Device* device = Graphics::GetDevice();
-        model = std::make_shared<InterleavedGltfModel>(device, filename, InterleavedGltfModel::Mode::SkeltalMesh, isSaveVerticesData);
+        model = InterleavedGltfModel::Load(device, filename, InterleavedGltfModel::Mode::SkeltalMesh, isSaveVerticesData);
         modelNodes = model->GetNodes();
     }
 
@@ -109,9 +163,11 @@ public:
 
     }
 
-    void SetMaterialPS(const std::string& psFilename, const std::string& materialName) const
+    void SetMaterialPS(const std::string& psFilename, const std::string& materialName)
     {
         ID3D11Device* device = Graphics::GetDevice();
+        // }eÂŋLf؂藣
+        model = InterleavedGltfModel::MakeUnique(model);
         for (InterleavedGltfModel::Material& material : model->materials)
         {
             if (material.name == materialName)
@@ -126,17 +182,17 @@ public:
     void RenderOpaque(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
     {
         //model->Render(immediateContext, world, model->nodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_);
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_, instanceParameters);
     }
     void RenderMask(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
     {
         //model->Render(immediateContext, world, model->nodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_);
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_, instanceParameters);
     }
     void RenderBlend(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
     {
         //model->Render(immediateContext, world, model->nodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_);
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_, instanceParameters);
     }
 
     void CastShadow(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
@@ -174,6 +230,9 @@ public:
     // f̃m[h
     std::vector<InterleavedGltfModel::Node> modelNodes = {};
 
+    // CX^XƂ̕`p[^ (alpha, }eA̍ւȂ)
+    InterleavedGltfModel::InstanceParameters instanceParameters;
+
     BuildMeshComponent(const std::string& name, const std::shared_ptr<Actor>& owner) :SceneComponent(name, owner)
     {
     }
@@ -183,7 +242,7 @@ public:
     void SetModel(const std::string& filename, bool isSaveVerticesData = false)
     {
         ID3D11Device* device = Graphics::GetDevice();
-        model = std::make_shared<InterleavedGltfModel>(device, filename, InterleavedGltfModel::Mode::SkeltalMesh, isSaveVerticesData);
+        model = InterleavedGltfModel::Load(device, filename, InterleavedGltfModel::Mode::SkeltalMesh, isSaveVerticesData);
         modelNodes = model->GetNodes();
     }
 
@@ -197,9 +256,11 @@ public:
 
     }
 
-    void SetMaterialPS(const std::string& psFilename, const std::string& materialName) const
+    void SetMaterialPS(const std::string& psFilename, const std::string& materialName)
     {
         ID3D11Device* device = Graphics::GetDevice();
+        // }eÂŋLf؂藣
+        model = InterleavedGltfModel::MakeUnique(model);
         for (InterleavedGltfModel::Material& material : model->materials)
         {
             if (material.name == materialName)
@@ -213,19 +274,19 @@ public:
     void RenderOpaque(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world) const
     {
         //model->Animate(animationClip, animationTime, model->nodes);
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_, instanceParameters);
     }
     void RenderMask(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world) const
     {
         //const DirectX::XMFLOAT4X4 world = CreateWorldMatrix();
         //model->Animate(animationClip, animationTime, model->nodes);
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_, instanceParameters);
     }
     void RenderBlend(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world) const
     {
         //const DirectX::XMFLOAT4X4 world = CreateWorldMatrix();
         //model->Animate(animationClip, animationTime, model->nodes);
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_, instanceParameters);
     }
 
     void CastShadow(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world) const
@@ -277,6 +338,34 @@ public:
 
     PipeLineStateDesc GetPipeLineState()const { return pipeLineState_; }
 
+    // MeshComponent::SetCoordinateSystem Ɠ (Lf͏Ȃ)
+    void SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem coordinateSystem)
+    {
+        if (!model || model->modelCoordinateSystem == coordinateSystem)
+        {
+            return;
+        }
+        model = InterleavedGltfModel::MakeVariant(model, "cs" + std::to_string(static_cast<int>(coordinateSystem)),
+            [coordinateSystem](InterleavedGltfModel& variant) { variant.modelCoordinateSystem = coordinateSystem; });
+    }
+
+    // MeshComponent::SetMaterialsAlphaMode Ɠ (Lf͏Ȃ)
+    void SetMaterialsAlphaMode(int alphaMode)
+    {
+        if (!model)
+        {
+            return;
+        }
+        model = InterleavedGltfModel::MakeVariant(model, "alpha" + std::to_string(alphaMode),
+            [alphaMode](InterleavedGltfModel& variant)
+            {
+                for (InterleavedGltfModel::Material& material : variant.materials)
+                {
+                    material.data.alphaMode = alphaMode;
+                }
+            });
+    }
+
 protected:
     //`悷邩ǂ
     bool isVisible_ = true;
@@ -296,7 +385,7 @@ public:
     void SetModel(const std::string& filename, bool isSaveVerticesData = false)override
     {
         ID3D11Device* device = Graphics::GetDevice();
-        model = std::make_shared<InterleavedGltfModel>(device, filename, InterleavedGltfModel::Mode::StaticMesh, isSaveVerticesData);
+        model = InterleavedGltfModel::Load(device, filename, InterleavedGltfModel::Mode::StaticMesh, isSaveVerticesData);
         modelNodes = model->GetNodes();
     }
 
@@ -305,17 +394,17 @@ public:
     void RenderOpaque(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
     {
         //const DirectX::XMFLOAT4X4 world = CreateWorldMatrix();
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Opaque, pipeLineState_, instanceParameters);
     }
     void RenderMask(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
     {
         //const DirectX::XMFLOAT4X4 world = CreateWorldMatrix();
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Mask, pipeLineState_, instanceParameters);
     }
     void RenderBlend(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
     {
         //const DirectX::XMFLOAT4X4 world = CreateWorldMatrix();
-        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_);
+        model->Render(immediateContext, world, modelNodes, InterleavedGltfModel::RenderPass::Blend, pipeLineState_, instanceParameters);
     }
 
     void CastShadow(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4 world) const override
@@ -338,7 +427,7 @@ public:
     void SetModel(const std::string& filename, bool isSaveVerticesData = false)override
     {
         ID3D11Device* device = Graphics::GetDevice();
-        model = std::make_shared<InterleavedGltfModel>(device, filename, InterleavedGltfModel::Mode::InstancedStaticMesh, isSaveVerticesData);
+        model = InterleavedGltfModel::Load(device, filename, InterleavedGltfModel::Mode::InstancedStaticMesh, isSaveVerticesData);
         model->SetMeshComponent(this);
         modelNodes = model->GetNodes();
     }
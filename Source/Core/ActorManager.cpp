@@ -100,7 +100,7 @@ void Renderer::RenderMask(ID3D11DeviceContext* immediateContext)
                     convexComponent = dynamic_cast<ConvexCollisionComponent*>(convexComponent);
                     DirectX::XMFLOAT4X4 world;
                     DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixIdentity());
-                    convexComponent->GetMeshComponent()->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask);
+                    convexComponent->GetMeshComponent()->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask, {}, convexComponent->GetMeshComponent()->instanceParameters);
                     //meshComponent->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask);
                     rendered = true;
                 }
@@ -154,7 +154,7 @@ void Renderer::RenderBlend(ID3D11DeviceContext* immediateContext)
                     convexComponent = dynamic_cast<ConvexCollisionComponent*>(convexComponent);
                     DirectX::XMFLOAT4X4 world;
                     DirectX::XMStoreFloat4x4(&world, DirectX::XMMatrixIdentity());
-                    convexComponent->GetMeshComponent()->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Blend);
+                    convexComponent->GetMeshComponent()->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Blend, {}, convexComponent->GetMeshComponent()->instanceParameters);
                     //meshComponent->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Blend);
                     rendered = true;
                 }
@@ -195,19 +195,9 @@ void Renderer::RenderInstanced(ID3D11DeviceContext* immediateContext)
             }
         }
     }
-    HRESULT hr{ S_OK };
-    D3D11_MAPPED_SUBRESOURCE mapped_subresource{};
-    hr = immediateContext->Map(itemModel->instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD,
-        0, &mapped_subresource);
-    _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-
-
-    //DirectX::XMFLOAT4X4* p = reinterpret_cast<DirectX::XMFLOAT4X4*>(mapped_subresource.pData);
-
-    memcpy_s(mapped_subresource.pData, sizeof(DirectX::XMFLOAT4X4) * 1000, instanceDatas.data(), sizeof(DirectX::XMFLOAT4X4) * instanceDatas.size());
-    itemModel->instanceCount_ = static_cast<int>(instanceDatas.size());
-    immediateContext->Unmap(itemModel->instanceBuffer.Get(), 0);
-    itemModel->InstancedStaticBatchRender(immediateContext, InterleavedGltfModel::RenderPass::All, pipeLineState_);
+    // 1000 𒴂Ăobt@傫đSĕ`
+    itemModel->UpdateInstances(immediateContext, instanceDatas);
+    itemModel->InstancedStaticBatchRender(immediateContext, InterleavedGltfModel::RenderPass::All, pipeLineState_, itemInstanceParameters);
     //char buf[256];
     //sprintf_s(buf, "instanceSize:%d\n", static_cast<int>(instanceDatas.size()));
     //OutputDebugStringA(buf);
@@ -357,4 +347,7 @@ void ActorColliderManager::DebugRender(ID3D11DeviceContext* immediateContext)
             }
         }
     }
+
+    // ߂`ނƂɂ܂Ƃ߂ĕ`
+    ShapeRenderer::Flush(immediateContext);
 }
@@ -14,6 +14,7 @@
 #include "Game/Utils/ShockWaveTargetRegistry.h"
 
 #include "Engine/Camera/CameraConstants.h"
+#include "Engine/Debug/Profiler.h"
 
 class Scene;
 
@@ -188,6 +189,8 @@ public:
     // SAN^[UpdateĂяoiRootComponentOwnedComponentj
     void Update(float deltaTime)
     {
+        PROFILE_ZONE("ActorManager::Update", "actor");
+        PROFILE_COUNTER("Actors", allActors_.size());
         // allActors_ ̃Rs[iQƂȂshared_ptrRs[j
         auto updateActors = allActors_;
 
@@ -285,7 +288,7 @@ public:
         itemModel = std::make_shared<InterleavedGltfModel>(device, "./Data/Models/Items/PickUpEnergyCore/pick_up_item.gltf", InterleavedGltfModel::Mode::InstancedStaticMesh);
         HRESULT hr = CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelEmissionPS.cso", pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-        itemModel->emission = 3.0f;
+        itemInstanceParameters.emission = 3.0f;
 
         viewBuffer = std::make_unique<ConstantBuffer<ViewConstants>>(device);
     }
@@ -471,7 +474,7 @@ public:
                     {
                         // INTERLEAVED_GLTF_MODEL
                         immediateContext->IASetIndexBuffer(buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
-                        immediateContext->DrawIndexed(primitive.indexBufferView.sizeInBytes / _SizeofComponent(primitive.indexBufferView.format), 0, 0);
+                        immediateContext->DrawIndexed(primitive.GetLod(0).indexCount, 0, 0);
                     }
                     else
                     {
@@ -495,6 +498,7 @@ public:
 #endif // 0
 private:
     std::shared_ptr<InterleavedGltfModel> itemModel;
+    InterleavedGltfModel::InstanceParameters itemInstanceParameters;
     PipeLineStateDesc pipeLineState_ = {};
 public:
     void RenderBuilding(ID3D11DeviceContext* immediateContext)
@@ -1,8 +1,10 @@
 #include "World.h"
 #include "Core/Actor.h"
+#include "Engine/Debug/Profiler.h"
 
 void World::Tick(float deltaTime)
 {
+    PROFILE_ZONE("World::Tick", "actor");
     // SAN^[UpdateĂяoiRootComponentOwnedComponentj
     {
         for (std::shared_ptr<Actor>& actor : allActors_)
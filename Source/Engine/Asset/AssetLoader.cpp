@@ -0,0 +1,362 @@
+#include "AssetLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
+
+#include "Engine/Debug/Assert.h"
+#include "Engine/Debug/Profiler.h"
+
+namespace
+{
+    long long NowMicroseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const char* StageName(AssetLoader::Stage stage)
+    {
+        switch (stage)
+        {
+        case AssetLoader::Stage::Read: return "read";
+        case AssetLoader::Stage::Parse: return "parse";
+        case AssetLoader::Stage::Process: return "process";
+        case AssetLoader::Stage::Upload: return "upload";
+        }
+        return "";
+    }
+
+    // ȉd (ǂރt@C̑傫 MBALbV΃LbV̑傫)
+    float EstimateWeight(const AssetLoader::ModelRequest& request)
+    {
+        std::error_code error;
+        std::filesystem::path path = InterleavedGltfModel::GetCacheFilename(request.filename, request.mode);
+        if (!std::filesystem::exists(path, error))
+        {
+            path = request.filename;
+        }
+        const uintmax_t bytes = std::filesystem::file_size(path, error);
+        const float megabytes = error ? 0.0f : static_cast<float>(bytes) / (1024.0f * 1024.0f);
+        return (std::max)(megabytes, 0.1f);
+    }
+}
+
+AssetLoader::AssetLoader(ID3D11Device* device) : device(device)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+    // Wũ[_[QƂĂ̂ŁArŔjꍇI܂ő҂
+    if (graph && !graph->IsFinished())
+    {
+        graph->Wait();
+    }
+}
+
+void AssetLoader::RequestModel(const ModelRequest& request)
+{
+    _ASSERT_EXPR(graph == nullptr, L"AssetLoader::RequestModel must be called before Start");
+    for (Entry& entry : entries)
+    {
+        if (entry.request.filename == request.filename && entry.request.mode == request.mode && entry.request.isSaveVerticesData == request.isSaveVerticesData)
+        {
+            for (const std::string& animationFilename : request.animationFilenames)
+            {
+                if (std::find(entry.request.animationFilenames.begin(), entry.request.animationFilenames.end(), animationFilename) == entry.request.animationFilenames.end())
+                {
+                    entry.request.animationFilenames.push_back(animationFilename);
+                }
+            }
+            return;
+        }
+    }
+    entries.push_back({ request });
+}
+
+void AssetLoader::Measure(Stage stage, const std::function<void()>& function)
+{
+    // iKƂɋԂ𕪂ăg[Xɏo
+    static const Profiler::ZoneId zones[] =
+    {
+        Profiler::RegisterZone("AssetLoader::Read", "loading", __FILE__, __LINE__),
+        Profiler::RegisterZone("AssetLoader::Parse", "loading", __FILE__, __LINE__),
+        Profiler::RegisterZone("AssetLoader::Process", "loading", __FILE__, __LINE__),
+        Profiler::RegisterZone("AssetLoader::Upload", "loading", __FILE__, __LINE__),
+    };
+    static_assert(_countof(zones) == static_cast<size_t>(Stage::Count));
+    const Profiler::ScopedZone zone(zones[static_cast<size_t>(stage)]);
+    const long long begin = NowMicroseconds();
+    function();
+    stageMicroseconds[static_cast<size_t>(stage)] += NowMicroseconds() - begin;
+}
+
+void AssetLoader::Start(JobSystem& jobSystem)
+{
+    _ASSERT_EXPR(graph == nullptr, L"AssetLoader::Start has already been called");
+    graph = std::make_unique<JobGraph>();
+    startTime = NowMicroseconds();
+
+    std::vector<std::string> animationFilenames;
+    // .modelCache ƂɍŏɏGg process Wu
+    // (isSaveVerticesData ႤGg͓LbVt@CɂȂ̂ŁÂ̂͏IĂǂ)
+    std::unordered_map<std::string, JobGraph::JobId> cacheWriters;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        Entry& entry = entries[i];
+        const ModelRequest& request = entry.request;
+        for (const std::string& animationFilename : request.animationFilenames)
+        {
+            if (std::find(animationFilenames.begin(), animationFilenames.end(), animationFilename) == animationFilenames.end())
+            {
+                animationFilenames.push_back(animationFilename);
+            }
+        }
+
+        if (device)
+        {// ɓǂݍ܂Ă͎̂QƂ
+            entry.model = InterleavedGltfModel::FindCached(request.filename, request.mode, request.isSaveVerticesData);
+        }
+        if (entry.model)
+        {
+            entry.isCached = true;
+            continue;
+        }
+
+        entry.model = InterleavedGltfModel::CreateUnloaded(request.filename, request.mode, request.isSaveVerticesData);
+        entry.weight = EstimateWeight(request);
+        const float weight = entry.weight;
+        InterleavedGltfModel* model = entry.model.get();
+
+        const std::string cacheFilename = InterleavedGltfModel::GetCacheFilename(request.filename, request.mode).string();
+        const auto cacheWriter = cacheWriters.find(cacheFilename);
+        std::vector<JobGraph::JobId> readDependencies;
+        if (cacheWriter != cacheWriters.end())
+        {
+            readDependencies.push_back(cacheWriter->second);
+        }
+
+        // ͂ CPU d̂ŏd݂傫
+        const JobGraph::JobId read = graph->Add("read " + request.filename, [this, model]()
+            {
+                Measure(Stage::Read, [model]() { model->ReadSourceFile(); });
+            }, readDependencies, JobGraph::Lane::Worker, weight * 1.0f);
+        const JobGraph::JobId parse = graph->Add("parse " + request.filename, [this, model]()
+            {
+                Measure(Stage::Parse, [model]() { model->ParseSource(); });
+            }, { read }, JobGraph::Lane::Worker, weight * 2.0f);
+        const JobGraph::JobId process = graph->Add("process " + request.filename, [this, model]()
+            {
+                Measure(Stage::Process, [model]() { model->ProcessSource(); });
+            }, { parse }, JobGraph::Lane::Worker, weight * 2.0f);
+        if (cacheWriter == cacheWriters.end())
+        {
+            cacheWriters.emplace(cacheFilename, process);
+        }
+        if (device)
+        {
+            const JobGraph::JobId upload = graph->Add("upload " + request.filename, [this, model]()
+                {
+                    Measure(Stage::Upload, [this, model]() { model->UploadResources(device); });
+                }, { process }, JobGraph::Lane::Owner, weight * 1.0f);
+            // LLbVɓo^ ( MeshComponent::SetModel œǂ܂Ă΂g)
+            graph->Add("publish " + request.filename, [this, i]()
+                {
+                    const double milliseconds = static_cast<double>(NowMicroseconds() - startTime) / 1000.0;
+                    std::shared_ptr<InterleavedGltfModel> published = InterleavedGltfModel::Publish(entries[i].model, milliseconds);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    entries[i].model = published;
+                }, { upload }, JobGraph::Lane::Worker, 0.0f);
+        }
+    }
+
+    // Aj[V̓LbVĂɂ
+    // (Lf̃Aj[V̕т͎g AppendAnimations ̏ԂŌ܂邽߁Ał͒ǉȂ)
+    for (const std::string& animationFilename : animationFilenames)
+    {
+        graph->Add("animation " + animationFilename, [this, animationFilename]()
+            {
+                Measure(Stage::Process, [&]() { InterleavedGltfModel::PrepareAnimationCache(animationFilename); });
+            }, {}, JobGraph::Lane::Worker, 0.2f);
+    }
+
+    // SďIL^
+    std::vector<JobGraph::JobId> all(graph->JobCount());
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        all[i] = i;
+    }
+    graph->Add("finish", [this]() { finishTime = NowMicroseconds(); }, all, JobGraph::Lane::Worker, 0.0f);
+
+    graph->Run(jobSystem);
+}
+
+bool AssetLoader::Update()
+{
+    return graph ? graph->Pump() : true;
+}
+
+void AssetLoader::Wait()
+{
+    if (graph)
+    {
+        graph->Wait();
+    }
+}
+
+bool AssetLoader::IsFinished() const
+{
+    return !graph || graph->IsFinished();
+}
+
+float AssetLoader::Progress() const
+{
+    return graph ? graph->Progress() : 0.0f;
+}
+
+std::shared_ptr<InterleavedGltfModel> AssetLoader::GetModel(const std::string& filename, InterleavedGltfModel::Mode mode) const
+{
+    if (!IsFinished())
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Entry& entry : entries)
+    {
+        if (entry.request.filename == filename && entry.request.mode == mode)
+        {
+            return entry.model;
+        }
+    }
+    return nullptr;
+}
+
+double AssetLoader::StageMilliseconds(Stage stage) const
+{
+    return static_cast<double>(stageMicroseconds[static_cast<size_t>(stage)].load()) / 1000.0;
+}
+
+double AssetLoader::ElapsedMilliseconds() const
+{
+    const long long end = IsFinished() && finishTime.load() != 0 ? finishTime.load() : NowMicroseconds();
+    return static_cast<double>(end - startTime) / 1000.0;
+}
+
+std::string AssetLoader::Report() const
+{
+    size_t cachedCount = 0;
+    for (const Entry& entry : entries)
+    {
+        cachedCount += entry.isCached ? 1 : 0;
+    }
+    char buf[512];
+    sprintf_s(buf, "AssetLoader : %zu models (%zu already loaded), %.2f ms elapsed\n", entries.size(), cachedCount, ElapsedMilliseconds());
+    std::string text = buf;
+    for (size_t stage = 0; stage < static_cast<size_t>(Stage::Count); ++stage)
+    {
+        sprintf_s(buf, "  %-8s : %9.2f ms\n", StageName(static_cast<Stage>(stage)), StageMilliseconds(static_cast<Stage>(stage)));
+        text += buf;
+    }
+    return text;
+}
+
+std::string AssetLoader::Benchmark(const std::vector<ModelRequest>& requests, int iterations)
+{
+    iterations = (std::max)(iterations, 1);
+
+    // ЕLbVЕǂނƑׂȂ̂ŁA
+    // ǂLbVĂǂ (cold) ꍇƁALbVԂœǂ (warm) ꍇv
+    auto removeCaches = [&requests]()
+        {
+            std::error_code ec;
+            for (const ModelRequest& request : requests)
+            {
+                std::filesystem::remove(InterleavedGltfModel::GetCacheFilename(request.filename, request.mode), ec);
+                for (const std::string& animationFilename : request.animationFilenames)
+                {
+                    std::filesystem::path cacheFilename(animationFilename);
+                    cacheFilename.replace_extension("animationCache");
+                    std::filesystem::remove(cacheFilename, ec);
+                }
+            }
+        };
+    // ]ǂ 1 Xbh 1 fǂ
+    auto runSerial = [&requests]()
+        {
+            const long long begin = NowMicroseconds();
+            for (const ModelRequest& request : requests)
+            {
+                std::shared_ptr<InterleavedGltfModel> model = InterleavedGltfModel::CreateUnloaded(request.filename, request.mode, request.isSaveVerticesData);
+                model->ReadSourceFile();
+                model->ParseSource();
+                model->ProcessSource();
+                for (const std::string& animationFilename : request.animationFilenames)
+                {
+                    InterleavedGltfModel::PrepareAnimationCache(animationFilename);
+                }
+            }
+            return static_cast<double>(NowMicroseconds() - begin) / 1000.0;
+        };
+    // WuOtŕɓǂ
+    auto runParallel = [&requests](double* stageMilliseconds)
+        {
+            AssetLoader loader(nullptr);
+            for (const ModelRequest& request : requests)
+            {
+                loader.RequestModel(request);
+            }
+            loader.Start();
+            loader.Wait();
+            for (size_t stage = 0; stage < static_cast<size_t>(Stage::Count); ++stage)
+            {
+                stageMilliseconds[stage] += loader.StageMilliseconds(static_cast<Stage>(stage));
+            }
+            return loader.ElapsedMilliseconds();
+        };
+
+    enum { Cold, Warm, StateCount };
+    double serialMilliseconds[StateCount] = {};
+    double parallelMilliseconds[StateCount] = {};
+    double stageMilliseconds[StateCount][static_cast<size_t>(Stage::Count)] = {};
+    for (int iteration = 0; iteration < iterations; ++iteration)
+    {
+        // OS ̃t@CLbVŌɓǂޕLɂȂȂ悤ɁAɓǂޕ𖈉ւ
+        const bool isSerialFirst = iteration % 2 == 0;
+        for (int variant = 0; variant < 2; ++variant)
+        {
+            const bool isSerial = (variant == 0) == isSerialFirst;
+            removeCaches();
+            for (int state = Cold; state < StateCount; ++state)
+            {
+                if (isSerial)
+                {
+                    serialMilliseconds[state] += runSerial();
+                }
+                else
+                {
+                    parallelMilliseconds[state] += runParallel(stageMilliseconds[state]);
+                }
+            }
+        }
+    }
+
+    char buf[512];
+    sprintf_s(buf, "AssetLoader benchmark : %zu models, %d iterations, %zu workers (upload excluded)\n",
+        requests.size(), iterations, JobSystem::Instance().WorkerCount());
+    std::string text = buf;
+    for (int state = Cold; state < StateCount; ++state)
+    {
+        sprintf_s(buf, "  %s\n    serial   : %9.2f ms\n    parallel : %9.2f ms (x%.2f)\n",
+            state == Cold ? "cold (no cache files)" : "warm (cache files written by the cold run)",
+            serialMilliseconds[state] / iterations, parallelMilliseconds[state] / iterations,
+            parallelMilliseconds[state] > 0.0 ? serialMilliseconds[state] / parallelMilliseconds[state] : 0.0);
+        text += buf;
+        for (size_t stage = 0; stage < static_cast<size_t>(Stage::Upload); ++stage)
+        {
+            sprintf_s(buf, "      %-8s : %9.2f ms (sum of jobs)\n", StageName(static_cast<Stage>(stage)), stageMilliseconds[state][stage] / iterations);
+            text += buf;
+        }
+    }
+    return text;
+}
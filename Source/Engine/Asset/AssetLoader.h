@@ -0,0 +1,95 @@
+#pragma once
+
+#include <d3d11.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Engine/Job/JobSystem.h"
+#include "Graphics/Resource/InterleavedGltfModel.h"
+
+// V[ŎgAZbgiɕĕɓǂݍ
+//   t@Cǂݍ ->  -> CPU  (_̎oEob`EʎqELbV̏o) -> GPU Abv[h
+// t@Cǂݍ݁`CPU ̓[J[AAbv[h Update / Wait Ă񂾃Xbhōŝ
+// 郂fAbv[hĂԂɎ̃f̉͂i
+// ǂݍ񂾃f͋LLbVɓo^̂ŁAォ MeshComponent::SetModel œt@Cw肷ƃLbV擾
+class AssetLoader
+{
+public:
+    enum class Stage
+    {
+        Read,
+        Parse,
+        Process,
+        Upload,
+        Count,
+    };
+
+    struct ModelRequest
+    {
+        std::string filename;
+        InterleavedGltfModel::Mode mode = InterleavedGltfModel::Mode::SkeltalMesh;
+        bool isSaveVerticesData = false;
+        // SkeletalMeshComponent::AppendAnimations ŒǉAj[V (LbVɍĂ)
+        std::vector<std::string> animationFilenames;
+    };
+
+    // device  nullptr ̎ GPU ւ̃Abv[hƋLLbVւ̓o^sȂ (x`}[Np)
+    explicit AssetLoader(ID3D11Device* device);
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    ~AssetLoader();
+
+    // Start ̑Oɓo^ (t@CEMode ̓do^̓Aj[V܂Ƃ߂)
+    void RequestModel(const ModelRequest& request);
+
+    // WuOtgŎsn߂
+    void Start(JobSystem& jobSystem = JobSystem::Instance());
+    // Abv[h̒ĩXbhŐi߂ (SďIĂ true)
+    bool Update();
+    // SďI܂ŃAbv[h̒isȂ҂
+    void Wait();
+
+    bool IsFinished() const;
+    // 0 - 1 (ǂݍރt@C̑傫ŏdݕtĂ)
+    float Progress() const;
+    size_t RequestCount() const { return entries.size(); }
+
+    // ǂݍݏIf (IĂȂ nullptr)
+    std::shared_ptr<InterleavedGltfModel> GetModel(const std::string& filename, InterleavedGltfModel::Mode mode) const;
+
+    // iƂ̍v (eWu̎sԂ̍vȂ̂ŕɓ͌oߎԂ蒷Ȃ)
+    double StageMilliseconds(Stage stage) const;
+    // Start SďI܂ł̌oߎ
+    double ElapsedMilliseconds() const;
+    std::string Report() const;
+
+    // GPU g킸ɓǂݍݎԂv (Abv[h̒i͊܂܂Ȃ)
+    // 1 XbhŏԂɓǂ񂾏ꍇƃWuOtŕɓǂ񂾏ꍇALbV (cold) ƃLbVL (warm) Ŕׂ
+    // (vO .modelCache / .animationCache )
+    static std::string Benchmark(const std::vector<ModelRequest>& requests, int iterations = 3);
+
+private:
+    struct Entry
+    {
+        ModelRequest request;
+        std::shared_ptr<InterleavedGltfModel> model;
+        bool isCached = false;  // Start ̎_ŋLLbVɂ
+        float weight = 1.0f;
+    };
+
+    // vȂȉs
+    void Measure(Stage stage, const std::function<void()>& function);
+
+    ID3D11Device* device = nullptr;
+    std::vector<Entry> entries;
+    std::unique_ptr<JobGraph> graph;
+    mutable std::mutex mutex;
+
+    std::atomic<long long> stageMicroseconds[static_cast<size_t>(Stage::Count)] = {};
+    long long startTime = 0;
+    std::atomic<long long> finishTime = 0;
+};
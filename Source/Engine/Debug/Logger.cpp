@@ -6,18 +6,37 @@
 #endif
 
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <chrono>
 #include <format>
+#include <vector>
 
 
 static constexpr const char* fmt = "%Y-%m-%d__%H-%M-%S";
+// 1 回にまとめて書くレコードの数
+static constexpr size_t BatchRecords = 256;
+// ファイルの書き込みバッファ
+static constexpr size_t FileBufferSize = 64 * 1024;
 
 using namespace std::chrono;
 
-Logger::Logger() {
-	logThread_ = std::thread(&Logger::LogThreadFunc);
+Logger::Logger(size_t capacity, OverflowPolicy policy) : overflowPolicy(policy) {
+	//2 のべき乗に切り上げる
+	size_t size = 2;
+	while (size < capacity) {
+		size <<= 1;
+	}
+	cells = std::make_unique<Cell[]>(size);
+	mask = size - 1;
+	for (size_t i = 0; i < size; ++i) {
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	batch.reserve(BatchRecords * (MessageCapacity + 64));
+	logThread_ = std::thread(&Logger::LogThreadFunc, this);
 }
 
 Logger::~Logger() {
@@ -45,77 +64,269 @@ void Logger::Initialize() {
 	filename += timeStr;
 	filename += ".txt";
 
-	instance.logfilePath = OutputPath;
-	instance.logfilePath /= filename;
+	std::filesystem::path path = OutputPath;
+	path /= filename;
 
 	//絶対パス化
-	instance.logfilePath = std::filesystem::absolute(instance.logfilePath);
+	path = std::filesystem::absolute(path);
 
 	//ディレクトリがなければ作成
-	std::filesystem::create_directories(instance.logfilePath.parent_path());
-
-	instance.log.clear();
-	//instance.log.reserve(SIZE_MAX);//無限にログを貯められるようにする 大きすぎるので小さくする
-	instance.log.reserve(INT_MAX);//無限にログを貯められるようにする
+	std::filesystem::create_directories(path.parent_path());
 
+	instance.Open(path);
 }
 
 void Logger::Log(const char* message) {
-	std::lock_guard lock(Instance().mtx);
-	Instance().logQueue.emplace(std::time(nullptr), message);
+	Instance().Push(Level::Info, message, nullptr);
 }
 
 void Logger::Warning(const char* message) {
-	std::lock_guard lock(Instance().mtx);
-	Instance().logQueue.emplace(std::time(nullptr), std::format("[WARNING] {}", message));
+	Instance().Push(Level::Warning, message, nullptr);
 }
 
 void Logger::Error(const char* message,std::source_location location) {
-	std::lock_guard lock(Instance().mtx);
-	Instance().logQueue.emplace(std::time(nullptr), std::format("[ERROR]\n\n\n ErrorLocation: \n\n\n\t File : {}\n\n\n\t Function : {}\n\n\n\t Line : {}\n\n\n Message :\n\n\n\t {}",location.file_name(),location.function_name(),location.line(), message));
+	Instance().Push(Level::Error, message, &location);
+}
+
+bool Logger::Push(Level level, const char* message, const std::source_location* location) {
+	Cell* cell = nullptr;
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	for (;;) {
+		cell = &cells[pos & mask];
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+		if (difference == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (difference < 0) {
+			//満杯
+			if (overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::DropNewest) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			//一番古いものを取り出して捨てる (読む側と取り合っても、どちらかが取れば空きができる)
+			Record discarded;
+			if (Pop(discarded)) {
+				overwritten.fetch_add(1, std::memory_order_relaxed);
+				processed.fetch_add(1, std::memory_order_release);
+			}
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+		else {
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	Record& record = cell->record;
+	record.time = static_cast<int64_t>(std::time(nullptr));
+	record.level = level;
+	record.file = location ? location->file_name() : nullptr;
+	record.function = location ? location->function_name() : nullptr;
+	record.line = location ? location->line() : 0;
+	const char* text = message ? message : "";
+	size_t length = strnlen(text, MessageCapacity);
+	record.isTruncated = length == MessageCapacity;
+	if (record.isTruncated) {
+		--length;
+		truncated.fetch_add(1, std::memory_order_relaxed);
+	}
+	std::memcpy(record.message, text, length);
+	record.length = static_cast<uint16_t>(length);
+	accepted.fetch_add(1, std::memory_order_relaxed);
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+bool Logger::Pop(Record& record) {
+	Cell* cell = nullptr;
+	size_t pos = dequeuePos.load(std::memory_order_relaxed);
+	for (;;) {
+		cell = &cells[pos & mask];
+		const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+		if (difference == 0) {
+			if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if (difference < 0) {
+			//空
+			return false;
+		}
+		else {
+			pos = dequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+	record = cell->record;
+	cell->sequence.store(pos + mask + 1, std::memory_order_release);
+	return true;
+}
+
+void Logger::Open(const std::filesystem::path& path) {
+	std::lock_guard lock(fileMutex);
+	if (file.is_open()) {
+		file.close();
+	}
+	if (!fileBuffer) {
+		fileBuffer = std::make_unique<char[]>(FileBufferSize);
+	}
+	//書き込みは自前のバッファでまとめる
+	file.rdbuf()->pubsetbuf(fileBuffer.get(), FileBufferSize);
+	file.open(path, std::ios::out | std::ios::app | std::ios::binary);
+	logfilePath = path;
+}
+
+size_t Logger::Drain() {
+	batch.clear();
+	std::vector<TailLine> lines;
+	Record record;
+	size_t count = 0;
+	bool hasError = false;
+	while (count < BatchRecords && Pop(record)) {
+		if (formattedTime != record.time) {
+			formattedTime = record.time;
+			const time_t currentTime = static_cast<time_t>(record.time);
+			//const auto* localTime = std::localtime(&currentTime);
+			std::tm localTime{};
+			localtime_s(&localTime, &currentTime);
+			//std::strftime(buf, sizeof(buf), fmt, localTime);
+			std::strftime(timeStr, sizeof(timeStr), fmt, &localTime);
+		}
+
+		const std::string_view message(record.message, record.length);
+		const size_t begin = batch.size();
+		//エラーメッセージや警告は前に空行を入れて目立たせる
+		switch (record.level) {
+		case Level::Info:
+			std::format_to(std::back_inserter(batch), "{} : {}", timeStr, message);
+			break;
+		case Level::Warning:
+			std::format_to(std::back_inserter(batch), "\n{} : [WARNING] {}", timeStr, message);
+			break;
+		case Level::Error:
+			hasError = true;
+			std::format_to(std::back_inserter(batch), "\n\n{} : [ERROR] {}\n\tFile : {}\n\tFunction : {}\n\tLine : {}", timeStr, message,
+				record.file ? record.file : "", record.function ? record.function : "", record.line);
+			break;
+		}
+		if (record.isTruncated) {
+			batch += " ...";
+		}
+		batch += '\n';
+		lines.push_back({ record.level, batch.substr(batch.find_first_not_of('\n', begin)) });
+		++count;
+	}
+	if (count == 0) {
+		return 0;
+	}
+
+	{
+		std::lock_guard lock(fileMutex);
+		if (file.is_open()) {
+			file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+			isFileDirty = true;
+			statistics.bytes += batch.size();
+			++statistics.batches;
+		}
+	}
+	//エラーの後に落ちてもファイルに残るように、すぐに flush する
+	FlushFile(hasError);
+	{
+		std::lock_guard lock(tailMutex);
+		for (TailLine& line : lines) {
+			if (!line.text.empty() && line.text.back() == '\n') {
+				line.text.pop_back();
+			}
+			tail.push_back(std::move(line));
+		}
+		while (tail.size() > TailCapacity) {
+			tail.pop_front();
+		}
+		statistics.written += count;
+	}
+	processed.fetch_add(count, std::memory_order_release);
+	return count;
+}
+
+void Logger::FlushFile(bool force) {
+	const int64_t now = duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+	std::lock_guard lock(fileMutex);
+	if (!file.is_open() || !isFileDirty || (!force && now - lastFlushTime < FlushIntervalMilliseconds)) {
+		return;
+	}
+	file.flush();
+	isFileDirty = false;
+	lastFlushTime = now;
+	++statistics.flushes;
+}
+
+void Logger::WaitDrained() {
+	const uint64_t target = accepted.load(std::memory_order_acquire);
+	while (processed.load(std::memory_order_acquire) < target) {
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+}
+
+Logger::Statistics Logger::CollectStatistics() {
+	Statistics result;
+	{
+		std::lock_guard lock(tailMutex);
+		result.written = statistics.written;
+	}
+	{
+		std::lock_guard lock(fileMutex);
+		result.bytes = statistics.bytes;
+		result.batches = statistics.batches;
+		result.flushes = statistics.flushes;
+	}
+	result.dropped = dropped.load(std::memory_order_relaxed);
+	result.overwritten = overwritten.load(std::memory_order_relaxed);
+	result.truncated = truncated.load(std::memory_order_relaxed);
+	return result;
+}
+
+std::string Logger::Statistics::ToString() const {
+	char buf[256];
+	sprintf_s(buf, "written %llu, dropped %llu, overwritten %llu, truncated %llu, %llu bytes in %llu batches, %llu flushes",
+		static_cast<unsigned long long>(written), static_cast<unsigned long long>(dropped), static_cast<unsigned long long>(overwritten),
+		static_cast<unsigned long long>(truncated), static_cast<unsigned long long>(bytes), static_cast<unsigned long long>(batches),
+		static_cast<unsigned long long>(flushes));
+	return buf;
 }
 
 void Logger::RenderIMGUI() {
+#ifdef USE_IMGUI
 	if (ImGui::TreeNode(reinterpret_cast<const char*>(u8"ログ情報")))
 	{
 		auto& instance = Instance();
+		ImGui::TextUnformatted(instance.CollectStatistics().ToString().c_str());
 		ImGui::BeginChild("", ImVec2(), true, ImGuiWindowFlags_::ImGuiWindowFlags_HorizontalScrollbar);
 
-		//1行ずつ取得する
-		size_t start = 0,end = 0;
-		while ((end = instance.log.find('\n',start))!=std::string::npos)
+		//直近の行だけを表示する
+		std::lock_guard lock(instance.tailMutex);
+		for (const TailLine& line : instance.tail)
 		{
-			std::string_view str(instance.log.c_str() + start, end - start);
-			bool cmd = false;
-			if (str.size()==0)
+			const bool cmd = line.level != Level::Info;
+			if (line.level == Level::Error)
+			{
+				ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.2f, 0.2f, 1.0f));
+			}
+			else if (line.level == Level::Warning)
 			{
-				if (*str.data() =='\n'&&*(str.data()+1)=='\n')//Error
-				{
-					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.2f, 0.2f, 1.0f));
-					start = start + 2;//2文字分進める
-					end = instance.log.find('\n', start);
-					str = std::string_view(instance.log.c_str() + start, end - start);
-					cmd = true;
-				}
-				else if (*str.data() == '\n')//Warning
-				{
-					ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.2f, 1.0f));
-					start = start + 1;//1文字分進める
-					end = instance.log.find('\n', start);
-					str = std::string_view(instance.log.c_str() + start, end - start);
-					cmd = true;
-				}
+				ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.2f, 1.0f));
 			}
 
-			ImGui::TextUnformatted(str.data(),str.data() + (end - start));
+			ImGui::TextUnformatted(line.text.data(), line.text.data() + line.text.size());
 
 			if (cmd)ImGui::PopStyleColor();
-			start = end + 1;
 		}
 
 		ImGui::EndChild();
 		ImGui::TreePop();
 	}
+#endif
 }
 
 //void Logger::Log(const wchar_t* message) {
@@ -141,47 +352,18 @@ void Logger::RenderIMGUI() {
 void Logger::LogThreadFunc() {
 	while (logThreadLoop)
 	{
-		if (Instance().logQueue.empty())continue;
-
-		auto& instance = Instance();
-		std::lock_guard lock(instance.mtx);
-		std::ofstream ofs(instance.logfilePath, std::ios::out | std::ios::app);
-		if (!ofs.is_open())return;
-
-		time_t currentTime = 0;
-		std::string timeStr;
-
-		while (!instance.logQueue.empty())
-		{
-			auto [time, message] = instance.logQueue.front();
-			if (currentTime != time) {
-				currentTime = time;
-				//const auto* localTime = std::localtime(&currentTime);
-				std::tm localTime{};
-				localtime_s(&localTime, &currentTime);
-			    char buf[80];
-				//std::strftime(buf, sizeof(buf), fmt, localTime);
-				std::strftime(buf, sizeof(buf), fmt, &localTime);
-				timeStr = buf;
-			}
-
-			std::string str = std::format("{} : {}\n", timeStr, message);
-			if (message[0] == '[')//エラーメッセージや警告は特別扱い
-			{
-				if (message.find("[WARNING]")!=std::string::npos)
-				{
-					str = "\n" + str;
-				}
-				else if (message.find("[ERROR]")!=std::string::npos)
-				{
-					str = "\n\n" + str;
-				}
-			}
-
-			ofs << str;
-			instance.log += str;
-			instance.logQueue.pop();
+		//空の時は少し待つ (書く側は待たせない)
+		if (Drain() == 0) {
+			//ログが途切れても間隔ごとにはファイルに出す
+			FlushFile(false);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
 		}
-		ofs.close();
+	}
+	//終了時は残りを全て書く (close で flush される)
+	while (Drain() > 0) {
+	}
+	std::lock_guard lock(fileMutex);
+	if (file.is_open()) {
+		file.close();
 	}
 }
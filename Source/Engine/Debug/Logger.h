@@ -1,38 +1,153 @@
 ﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <fstream>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <source_location>
+#include <string>
+#include <thread>
 
 
+// ログを固定長のレコードにしてリングバッファ (複数のスレッドから書いて、ログのスレッドだけが読む) に積む
+//   書く側はロックを取らず、文字列をコピーするだけ (時刻の文字列化や書式はログのスレッドで行う)
+//   リングバッファがあふれた時は新しいものを捨てるか、古いものを上書きするかを選べる
+//   ファイルにはまとめて書き、ImGui で見るための直近の行だけをメモリに残す
+//   ファイルの flush は FlushInterval ごと・エラーを書いた時・Flush を呼んだ時・終了時だけ (毎回 flush すると書き込みバッファの意味がない)
 class Logger
 {
 public:
 	constexpr static const char* OutputPath = ".\\Data\\Log";
+	// リングバッファのレコードの数 (2 のべき乗)
+	constexpr static size_t RecordCapacity = 4096;
+	// 1 レコードに入るメッセージの長さ (終端を含む)
+	// これより長いメッセージは先頭の MessageCapacity - 1 (215) バイトだけを残し、行の最後に " ..." を付ける (Statistics::truncated で数える)
+	constexpr static size_t MessageCapacity = 216;
+	// 書いたログをファイルに flush する間隔 (ミリ秒)
+	constexpr static int64_t FlushIntervalMilliseconds = 500;
+	// ImGui 用に残す行の数
+	constexpr static size_t TailCapacity = 1024;
+
+	enum class Level : uint8_t
+	{
+		Info,
+		Warning,
+		Error,
+	};
+
+	enum class OverflowPolicy : uint8_t
+	{
+		DropNewest,		// あふれたら新しいログを捨てる
+		OverwriteOldest,// あふれたら一番古いログを捨てて書く
+	};
+
+	struct Statistics
+	{
+		uint64_t written = 0;		// ファイル・直近の行に出した数
+		uint64_t dropped = 0;		// あふれて捨てた新しいログ
+		uint64_t overwritten = 0;	// あふれて上書きした古いログ
+		uint64_t truncated = 0;		// 切り詰めたメッセージ
+		uint64_t bytes = 0;			// ファイルに書いたバイト数
+		uint64_t batches = 0;		// まとめて書いた回数
+		uint64_t flushes = 0;		// ファイルを flush した回数
+
+		std::string ToString() const;
+	};
+
 public:
-	Logger();
+	explicit Logger(size_t capacity = RecordCapacity, OverflowPolicy policy = OverflowPolicy::DropNewest);
 	~Logger();
+	Logger(const Logger&) = delete;
+	Logger& operator=(const Logger&) = delete;
 
+	// ファイルを作って書き出しを始める (呼ぶ前のログは直近の行にだけ残る)
 	static void Initialize();
 
+	// メッセージは MessageCapacity - 1 バイトまで (長いものは切り詰める)
 	static void Log(const char* message);
 	static void Warning(const char* message);
 	static void Error(const char* message,std::source_location location = std::source_location::current());
 	//static void Log(const wchar_t* message);
 
+	static void SetOverflowPolicy(OverflowPolicy policy) { Instance().overflowPolicy.store(policy, std::memory_order_relaxed); }
+	static Statistics GetStatistics() { return Instance().CollectStatistics(); }
+	// 積んだログを全て書き終わるまで待ち、ファイルを flush する
+	static void Flush() { Instance().WaitDrained(); Instance().FlushFile(true); }
+
 	static void RenderIMGUI();
 
 private:
+	// Source/Test/LoggerTest.cpp が自前の Logger に直接積んで計る
+	friend class LoggerTest;
+
 	static Logger& Instance() { static Logger instance; return instance; }
 
-	static void LogThreadFunc();
+	// 書く側でコピーするのはここまで (書式はログのスレッドで作る)
+	struct Record
+	{
+		int64_t time = 0;				// time_t
+		const char* file = nullptr;		// source_location の文字列は静的なのでポインタだけ持つ
+		const char* function = nullptr;
+		uint32_t line = 0;
+		uint16_t length = 0;
+		Level level = Level::Info;
+		bool isTruncated = false;
+		char message[MessageCapacity];
+	};
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		Record record;
+	};
+	struct TailLine
+	{
+		Level level = Level::Info;
+		std::string text;
+	};
+
+	bool Push(Level level, const char* message, const std::source_location* location);
+	bool Pop(Record& record);
+	void Open(const std::filesystem::path& path);
+	// 積まれたレコードをまとめて書式にして書く (書いた数を返す)
+	size_t Drain();
+	// 書いたものが残っていれば flush する (force でなければ FlushInterval が過ぎた時だけ)
+	void FlushFile(bool force);
+	void WaitDrained();
+	Statistics CollectStatistics();
+
+	void LogThreadFunc();
 private:
 	std::filesystem::path logfilePath;
 
-	std::string log;
-	std::queue<std::pair<time_t,std::string>> logQueue;
-	std::mutex mtx;
+	// リングバッファ (Vyukov の有界キュー : セルごとの番号で書き終わり・読み終わりを判定する)
+	std::unique_ptr<Cell[]> cells;
+	size_t mask = 0;
+	alignas(64) std::atomic<size_t> enqueuePos = 0;
+	alignas(64) std::atomic<size_t> dequeuePos = 0;
+	alignas(64) std::atomic<uint64_t> accepted = 0;	// 積んだ数
+	std::atomic<uint64_t> processed = 0;			// 書いた・上書きで捨てた数
+	std::atomic<uint64_t> dropped = 0;
+	std::atomic<uint64_t> overwritten = 0;
+	std::atomic<uint64_t> truncated = 0;
+	std::atomic<OverflowPolicy> overflowPolicy;
+
+	// ログのスレッドだけが触る
+	std::string batch;
+	std::unique_ptr<char[]> fileBuffer;
+	int64_t formattedTime = -1;
+	char timeStr[80] = {};
+
+	// ファイルと直近の行 (ログのスレッドと ImGui・Initialize の間だけで使う)
+	std::mutex fileMutex;
+	std::ofstream file;
+	bool isFileDirty = false;		// flush していない書き込みがある
+	int64_t lastFlushTime = 0;		// steady_clock のミリ秒
+	std::mutex tailMutex;
+	std::deque<TailLine> tail;
+	Statistics statistics;
 
 	std::thread logThread_;
-	inline static bool logThreadLoop = true;
+	std::atomic<bool> logThreadLoop = true;
 };
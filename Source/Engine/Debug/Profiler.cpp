@@ -0,0 +1,529 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Engine/Debug/Assert.h"
+
+namespace
+{
+    // 1 ̃Xbh̃Oobt@ (͎̂̃XbhAǂނ̂ Collect )
+    struct ThreadBuffer
+    {
+        std::vector<Profiler::Event> events = std::vector<Profiler::Event>(Profiler::RingCapacity);
+        std::atomic<size_t> writeIndex = 0;
+        std::atomic<size_t> readIndex = 0;
+        std::atomic<uint64_t> dropped = 0;
+        std::atomic<bool> isAlive = false;
+        uint32_t threadId = 0;  // g[Xɏoԍ (g񂵂͐Vԍɂ)
+    };
+
+    // Ԃ (JE^[͒l) ̒߂̋L^
+    struct History
+    {
+        std::vector<float> samples;
+        size_t next = 0;
+        uint64_t totalCount = 0;
+        bool isCounter = false;
+
+        void Push(float sample)
+        {
+            if (samples.size() < Profiler::HistoryLength)
+            {
+                samples.push_back(sample);
+            }
+            else
+            {
+                samples[next] = sample;
+            }
+            next = (next + 1) % Profiler::HistoryLength;
+            ++totalCount;
+        }
+        // Âɕׂ
+        std::vector<float> Ordered() const
+        {
+            if (samples.size() < Profiler::HistoryLength)
+            {
+                return samples;
+            }
+            std::vector<float> ordered(samples.begin() + next, samples.end());
+            ordered.insert(ordered.end(), samples.begin(), samples.begin() + next);
+            return ordered;
+        }
+    };
+
+    struct State
+    {
+        // ԂƃXbh̓o^ (o^͌ĂяoꏊEXbhƂ 1 񂾂Ȃ̂ŃbNŎ)
+        std::mutex registryMutex;
+        std::deque<Profiler::ZoneInfo> zones;   // QƂԂ̂ deque (ǉĂȂ)
+        std::vector<std::unique_ptr<ThreadBuffer>> threads;
+        std::unordered_map<uint32_t, std::string> threadNames;
+        uint32_t nextThreadId = 1;
+
+        // W߂L^ (Collect ƏWvŎg)
+        std::mutex collectMutex;
+        std::vector<History> histories;
+        History frameHistory;
+        std::deque<Profiler::TraceEvent> trace;
+        uint64_t lastFrameStart = 0;
+        uint64_t droppedEvents = 0;
+    };
+
+    State& GetState()
+    {
+        static State state;
+        return state;
+    }
+
+    // XbhIobt@g񂹂悤ɂ
+    struct ThreadHandle
+    {
+        ThreadBuffer* buffer = nullptr;
+        uint8_t depth = 0;
+
+        ~ThreadHandle()
+        {
+            if (buffer)
+            {
+                buffer->isAlive.store(false, std::memory_order_release);
+            }
+        }
+    };
+    thread_local ThreadHandle threadHandle;
+
+    ThreadBuffer& AcquireThreadBuffer()
+    {
+        if (threadHandle.buffer)
+        {
+            return *threadHandle.buffer;
+        }
+        State& state = GetState();
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+        ThreadBuffer* buffer = nullptr;
+        for (const std::unique_ptr<ThreadBuffer>& candidate : state.threads)
+        {// IXbh̃obt@́ACollect œǂݏIĂΎg
+            if (!candidate->isAlive.load(std::memory_order_acquire) &&
+                candidate->readIndex.load(std::memory_order_acquire) == candidate->writeIndex.load(std::memory_order_acquire))
+            {
+                buffer = candidate.get();
+                break;
+            }
+        }
+        if (!buffer)
+        {
+            buffer = state.threads.emplace_back(std::make_unique<ThreadBuffer>()).get();
+        }
+        buffer->threadId = state.nextThreadId++;
+        buffer->isAlive.store(true, std::memory_order_release);
+        char name[32];
+        std::snprintf(name, sizeof(name), "Thread %u", buffer->threadId);
+        state.threadNames.emplace(buffer->threadId, name);
+        threadHandle.buffer = buffer;
+        return *buffer;
+    }
+
+    void Write(const Profiler::Event& event)
+    {
+        ThreadBuffer& buffer = AcquireThreadBuffer();
+        const size_t write = buffer.writeIndex.load(std::memory_order_relaxed);
+        if (write - buffer.readIndex.load(std::memory_order_acquire) >= Profiler::RingCapacity)
+        {// ӂꂽ̂ĂĐ (҂Ȃ)
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[write & (Profiler::RingCapacity - 1)] = event;
+        buffer.writeIndex.store(write + 1, std::memory_order_release);
+    }
+
+    // nearest-rank @̃p[Z^C (sorted ͏)
+    double Percentile(const std::vector<float>& sorted, double percent)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+        return sorted[(std::clamp)(rank, static_cast<size_t>(1), sorted.size()) - 1];
+    }
+
+    Profiler::ZoneSummary Summarize(const History& history)
+    {
+        Profiler::ZoneSummary summary;
+        std::vector<float> sorted = history.samples;
+        std::sort(sorted.begin(), sorted.end());
+        summary.totalCount = history.totalCount;
+        summary.samples = sorted.size();
+        if (!sorted.empty())
+        {
+            double total = 0.0;
+            for (float sample : sorted)
+            {
+                total += sample;
+            }
+            summary.mean = total / sorted.size();
+            summary.p50 = Percentile(sorted, 50.0);
+            summary.p95 = Percentile(sorted, 95.0);
+            summary.p99 = Percentile(sorted, 99.0);
+            summary.max = sorted.back();
+        }
+        return summary;
+    }
+
+    void WriteJsonString(std::ostream& stream, const std::string& text)
+    {
+        stream << '"';
+        for (unsigned char c : text)
+        {
+            switch (c)
+            {
+            case '"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n"; break;
+            case '\r': stream << "\\r"; break;
+            case '\t': stream << "\\t"; break;
+            default:
+                if (c < 0x20)
+                {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    stream << escaped;
+                }
+                else
+                {
+                    stream << static_cast<char>(c);
+                }
+                break;
+            }
+        }
+        stream << '"';
+    }
+}
+
+Profiler::ZoneId Profiler::RegisterZone(const char* name, const char* category, const char* file, int line)
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.registryMutex);
+    _ASSERT_EXPR(state.zones.size() < UINT16_MAX, L"vt@C̋Ԃ܂");
+    ZoneInfo& info = state.zones.emplace_back();
+    info.name = name;
+    info.category = category;
+    info.file = file;
+    info.line = line;
+    return static_cast<ZoneId>(state.zones.size() - 1);
+}
+
+const Profiler::ZoneInfo& Profiler::GetZoneInfo(ZoneId zone)
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.registryMutex);
+    return state.zones.at(zone);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+    ThreadBuffer& buffer = AcquireThreadBuffer();
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.registryMutex);
+    state.threadNames[buffer.threadId] = name;
+}
+
+uint64_t Profiler::BeginZone()
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+    ++threadHandle.depth;
+    return Now();
+}
+
+void Profiler::EndZone(ZoneId zone, uint64_t start)
+{
+    Event event;
+    event.end = Now();
+    event.start = start;
+    event.zone = zone;
+    event.type = EventType::Zone;
+    event.depth = --threadHandle.depth;
+    Write(event);
+}
+
+void Profiler::RecordCounter(ZoneId counter, double value)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+    Event event;
+    event.start = event.end = Now();
+    event.value = value;
+    event.zone = counter;
+    event.type = EventType::Counter;
+    Write(event);
+}
+
+void Profiler::NewFrame()
+{
+    if (IsEnabled())
+    {
+        Event event;
+        event.start = event.end = Now();
+        event.type = EventType::Frame;
+        Write(event);
+    }
+    Collect();
+}
+
+void Profiler::Collect()
+{
+    State& state = GetState();
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : state.threads)
+        {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+    for (ThreadBuffer* buffer : buffers)
+    {
+        size_t read = buffer->readIndex.load(std::memory_order_relaxed);
+        const size_t write = buffer->writeIndex.load(std::memory_order_acquire);
+        for (; read != write; ++read)
+        {
+            const Event& event = buffer->events[read & (RingCapacity - 1)];
+            // ͑̃Xbhłło^̂ŁAȂ΂ő₷
+            if (event.type != EventType::Frame && state.histories.size() <= event.zone)
+            {
+                state.histories.resize(event.zone + 1);
+            }
+            switch (event.type)
+            {
+            case EventType::Zone:
+                state.histories[event.zone].Push(static_cast<float>((event.end - event.start) / 1.0e6));
+                break;
+            case EventType::Counter:
+                state.histories[event.zone].isCounter = true;
+                state.histories[event.zone].Push(static_cast<float>(event.value));
+                break;
+            case EventType::Frame:
+                if (state.lastFrameStart != 0)
+                {
+                    state.frameHistory.Push(static_cast<float>((event.start - state.lastFrameStart) / 1.0e6));
+                }
+                state.lastFrameStart = event.start;
+                break;
+            }
+            if (state.trace.size() >= TraceCapacity)
+            {
+                state.trace.pop_front();
+            }
+            state.trace.push_back({ event, buffer->threadId });
+        }
+        buffer->readIndex.store(read, std::memory_order_release);
+        state.droppedEvents += buffer->dropped.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::Reset()
+{
+    Collect();
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+    state.histories.clear();
+    state.frameHistory = {};
+    state.trace.clear();
+    state.lastFrameStart = 0;
+    state.droppedEvents = 0;
+}
+
+Profiler::Summary Profiler::Summarize()
+{
+    State& state = GetState();
+    Summary summary;
+    std::vector<ZoneInfo> zones;
+    {
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+        zones.assign(state.zones.begin(), state.zones.end());
+        for (const std::unique_ptr<ThreadBuffer>& buffer : state.threads)
+        {
+            summary.threads += buffer->isAlive.load(std::memory_order_relaxed) ? 1 : 0;
+        }
+    }
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+    for (size_t zone = 0; zone < state.histories.size() && zone < zones.size(); ++zone)
+    {
+        const History& history = state.histories[zone];
+        if (history.totalCount == 0)
+        {
+            continue;
+        }
+        if (history.isCounter)
+        {
+            CounterSummary& counter = summary.counters.emplace_back();
+            counter.name = zones[zone].name;
+            const ZoneSummary values = ::Summarize(history);
+            counter.last = history.samples[(history.next + HistoryLength - 1) % HistoryLength];
+            counter.mean = values.mean;
+            counter.max = values.max;
+            continue;
+        }
+        ZoneSummary& zoneSummary = summary.zones.emplace_back(::Summarize(history));
+        zoneSummary.name = zones[zone].name;
+        zoneSummary.category = zones[zone].category;
+    }
+    // ߂̍vԂ̒
+    std::sort(summary.zones.begin(), summary.zones.end(), [](const ZoneSummary& a, const ZoneSummary& b)
+        {
+            return a.mean * a.samples > b.mean * b.samples;
+        });
+    summary.frame = ::Summarize(state.frameHistory);
+    summary.frame.name = "Frame";
+    summary.frames = state.frameHistory.totalCount;
+    summary.droppedEvents = state.droppedEvents;
+    return summary;
+}
+
+std::string Profiler::Report()
+{
+    const Summary summary = Summarize();
+    std::string text;
+    char buf[256];
+    std::snprintf(buf, sizeof(buf), "frame : n=%llu mean %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f ms (threads %zu, dropped %llu)\n",
+        static_cast<unsigned long long>(summary.frames), summary.frame.mean, summary.frame.p50, summary.frame.p95, summary.frame.p99, summary.frame.max,
+        summary.threads, static_cast<unsigned long long>(summary.droppedEvents));
+    text += buf;
+    for (const ZoneSummary& zone : summary.zones)
+    {
+        std::snprintf(buf, sizeof(buf), "  %-32s [%s] n=%llu mean %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f ms\n", zone.name.c_str(), zone.category.c_str(),
+            static_cast<unsigned long long>(zone.totalCount), zone.mean, zone.p50, zone.p95, zone.p99, zone.max);
+        text += buf;
+    }
+    for (const CounterSummary& counter : summary.counters)
+    {
+        std::snprintf(buf, sizeof(buf), "  %-32s last %.2f mean %.2f max %.2f\n", counter.name.c_str(), counter.last, counter.mean, counter.max);
+        text += buf;
+    }
+    return text;
+}
+
+std::vector<float> Profiler::GetCounterHistory(const std::string& name)
+{
+    State& state = GetState();
+    std::vector<size_t> matches;
+    {
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+        for (size_t zone = 0; zone < state.zones.size(); ++zone)
+        {
+            if (state.zones[zone].name == name)
+            {
+                matches.push_back(zone);
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+    for (size_t zone : matches)
+    {
+        if (zone < state.histories.size() && state.histories[zone].isCounter)
+        {
+            return state.histories[zone].Ordered();
+        }
+    }
+    return {};
+}
+
+void Profiler::ExportChromeTrace(std::ostream& stream)
+{
+    State& state = GetState();
+    std::vector<ZoneInfo> zones;
+    std::unordered_map<uint32_t, std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(state.registryMutex);
+        zones.assign(state.zones.begin(), state.zones.end());
+        threadNames = state.threadNames;
+    }
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+
+    uint64_t origin = UINT64_MAX;
+    for (const TraceEvent& trace : state.trace)
+    {
+        origin = (std::min)(origin, trace.event.start);
+    }
+    // ts, dur ̓}CNb
+    auto microseconds = [origin](uint64_t nanoseconds) { return static_cast<double>(nanoseconds - origin) / 1000.0; };
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]()
+        {
+            stream << (first ? "" : ",\n");
+            first = false;
+        };
+    for (const std::pair<const uint32_t, std::string>& thread : threadNames)
+    {
+        separator();
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first << ",\"args\":{\"name\":";
+        WriteJsonString(stream, thread.second);
+        stream << "}}";
+    }
+    char buf[96];
+    for (const TraceEvent& trace : state.trace)
+    {
+        const Event& event = trace.event;
+        separator();
+        stream << "{\"name\":";
+        switch (event.type)
+        {
+        case EventType::Zone:
+            WriteJsonString(stream, event.zone < zones.size() ? zones[event.zone].name : "?");
+            stream << ",\"cat\":";
+            WriteJsonString(stream, event.zone < zones.size() ? zones[event.zone].category : "");
+            std::snprintf(buf, sizeof(buf), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", microseconds(event.start), (event.end - event.start) / 1000.0);
+            stream << buf << ",\"args\":{\"depth\":" << static_cast<int>(event.depth) << "}";
+            break;
+        case EventType::Counter:
+            WriteJsonString(stream, event.zone < zones.size() ? zones[event.zone].name : "?");
+            std::snprintf(buf, sizeof(buf), ",\"ph\":\"C\",\"ts\":%.3f,\"args\":{\"value\":%.6g}", microseconds(event.start), event.value);
+            stream << buf;
+            break;
+        case EventType::Frame:
+            std::snprintf(buf, sizeof(buf), "\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f", microseconds(event.start));
+            stream << buf;
+            break;
+        }
+        stream << ",\"pid\":1,\"tid\":" << trace.threadId << "}";
+    }
+    stream << "\n]}\n";
+}
+
+bool Profiler::ExportChromeTrace(const std::filesystem::path& path)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        return false;
+    }
+    ExportChromeTrace(stream);
+    return static_cast<bool>(stream);
+}
+
+std::vector<Profiler::TraceEvent> Profiler::GetTrace()
+{
+    State& state = GetState();
+    std::lock_guard<std::mutex> lock(state.collectMutex);
+    return std::vector<TraceEvent>(state.trace.begin(), state.trace.end());
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// XbhƂ̌v (][) L^ CPU vt@C
+//   Ԃ̖O͌ĂяoꏊƂ 1 񂾂o^Ĕԍ (ZoneId) ŋL^
+//   L^̓XbhƂ̃Oobt@ (̂͂̃XbhAǂނ̂ Collect ) ɏ̂ŃbNȂ
+//   NewFrame (Framework::Update) ŃOobt@W߂āAԂƂɒ߂̎Ԃ p50/p95/p99 o
+//   W߂L^ Chrome ̃g[X` (chrome://tracing, Perfetto)  JSON ɏo
+// g : PROFILE_ZONE("Physics::Update", "physics"); ŃXR[v̏I܂łv
+class Profiler
+{
+public:
+    using ZoneId = uint16_t;
+
+    // XbhƂ̃Oobt@̑傫 (2 ׂ̂Aӂꂽ͐Ď̂Ă)
+    static constexpr size_t RingCapacity = 1 << 15;
+    // ԂƂ p50/p95/p99 o߂Ɏc߂̉
+    static constexpr size_t HistoryLength = 600;
+    // o߂ɎcL^̐
+    static constexpr size_t TraceCapacity = 1 << 18;
+
+    enum class EventType : uint8_t
+    {
+        Zone,       //  (JnƏI)
+        Counter,    // l̋L^ (Ot)
+        Frame,      // t[̋؂
+    };
+
+    // 1 ̋L^ (Ԃ͏I 1 񂾂)
+    struct Event
+    {
+        uint64_t start = 0;     // imb
+        uint64_t end = 0;
+        double value = 0.0;     // Counter ̒l
+        ZoneId zone = 0;
+        EventType type = EventType::Zone;
+        uint8_t depth = 0;      // q̐[
+    };
+
+    // W߂L^ (ǂ̃Xbh̋L^)
+    struct TraceEvent
+    {
+        Event event;
+        uint32_t threadId = 0;
+    };
+
+    struct ZoneInfo
+    {
+        std::string name;
+        std::string category;
+        const char* file = "";
+        int line = 0;
+    };
+
+    // ԂƂ̒߂̏Wv
+    struct ZoneSummary
+    {
+        std::string name;
+        std::string category;
+        uint64_t totalCount = 0;    // NẲ
+        size_t samples = 0;         // WvɎg߂̉
+        double mean = 0.0;          // ~b
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    struct CounterSummary
+    {
+        std::string name;
+        double last = 0.0;
+        double mean = 0.0;
+        double max = 0.0;
+    };
+
+    struct Summary
+    {
+        std::vector<ZoneSummary> zones;
+        std::vector<CounterSummary> counters;
+        ZoneSummary frame;          // t[̊Ԋu
+        uint64_t frames = 0;
+        uint64_t droppedEvents = 0; // Oobt@ӂĎ̂Ă
+        size_t threads = 0;
+    };
+
+    static uint64_t Now()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // ĂяoꏊƂ 1 񂾂Ă (}N̒Ŋ֐ static ɓ)
+    static ZoneId RegisterZone(const char* name, const char* category, const char* file = "", int line = 0);
+    static const ZoneInfo& GetZoneInfo(ZoneId zone);
+
+    // ̃Xbh̖O (g[Xɏo)
+    static void SetThreadName(const char* name);
+
+    static void SetEnabled(bool enabled) { isEnabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return isEnabled.load(std::memory_order_relaxed); }
+
+    // Ԃ̊JnƏI (ScopedZone Ă)
+    static uint64_t BeginZone();
+    static void EndZone(ZoneId zone, uint64_t start);
+    static void RecordCounter(ZoneId counter, double value);
+
+    // t[̋؂L^āASẴXbh̋L^W߂ (CXbh 1 t[ 1 )
+    static void NewFrame();
+    // SẴXbh̃Oobt@W߂ (NewFrame Ă)
+    static void Collect();
+    // W߂L^ƏWv (XbhƋԂ̓o^͎c)
+    static void Reset();
+
+    static Summary Summarize();
+    static std::string Report();
+    // Otp̃JE^[̒߂̒l (Â)
+    static std::vector<float> GetCounterHistory(const std::string& name);
+
+    // Chrome ̃g[X`ŏo (Collect ς݂̋L^)
+    static void ExportChromeTrace(std::ostream& stream);
+    static bool ExportChromeTrace(const std::filesystem::path& path);
+    // Collect ς݂̋L^̎ʂ (Â)
+    static std::vector<TraceEvent> GetTrace();
+
+    class ScopedZone
+    {
+    public:
+        explicit ScopedZone(ZoneId zone) : zone(zone), start(Profiler::BeginZone()) {}
+        ~ScopedZone()
+        {
+            if (start != 0)
+            {
+                Profiler::EndZone(zone, start);
+            }
+        }
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        ZoneId zone;
+        uint64_t start;
+    };
+
+private:
+    inline static std::atomic<bool> isEnabled = true;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifndef DISABLE_PROFILER
+// XR[v̏I܂ł 1 ̋ԂƂċL^
+#define PROFILE_ZONE(name, category) \
+    static const Profiler::ZoneId PROFILE_CONCAT(profileZone, __LINE__) = Profiler::RegisterZone(name, category, __FILE__, __LINE__); \
+    const Profiler::ScopedZone PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+// lL^ (g[X̃OtƏWvɏo)
+#define PROFILE_COUNTER(name, value) \
+    do { \
+        static const Profiler::ZoneId profileCounter = Profiler::RegisterZone(name, "counter", __FILE__, __LINE__); \
+        Profiler::RecordCounter(profileCounter, static_cast<double>(value)); \
+    } while (false)
+#else
+#define PROFILE_ZONE(name, category) ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#endif
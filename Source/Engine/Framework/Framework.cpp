@@ -11,6 +11,7 @@
 #include "Graphics/Core/RenderState.h"
 
 #include "Engine/Input/InputSystem.h"
+#include "Engine/Debug/Profiler.h"
 #include "Graphics/Renderer/ShapeRenderer.h"
 #include "../../Components/Audio/AudioSourceComponent.h"
 
@@ -48,6 +49,7 @@ bool Framework::Initialize()
     //vt@C
     ProfileInitialize(&isPaused, Framework::SetPause/*, ImGuiControl::Profiler::DefaultMaxThreads*/);
     ProfileThreadName(0, "Main Thread");
+    Profiler::SetThreadName("Main Thread");
 
     return true;
 }
@@ -57,12 +59,20 @@ bool Framework::Update(float deltaTime/*Elapsed seconds from last frame*/)
     //foCXReNXg擾
     ID3D11DeviceContext* immediateContext = Graphics::GetDeviceContext();
 
+    // Õt[̋L^W߂āAt[̋؂t
+    Profiler::NewFrame();
+    PROFILE_ZONE("Framework::Update", "frame");
+
     //I[fBIXV
-    Audio::Update(deltaTime);
+    {
+        PROFILE_ZONE("Audio::Update", "audio");
+        Audio::Update(deltaTime);
+    }
     bool skipRendering;
     // SCENE_TRANSITION
     {
         ProfileScopedSection_2(0, "SceneUpdate", ImGuiControl::Profiler::Blue);
+        PROFILE_ZONE("SceneUpdate", "frame");
         skipRendering = Scene::_update(immediateContext, deltaTime * timeScale);
     }
 
@@ -78,6 +88,7 @@ bool Framework::Update(float deltaTime/*Elapsed seconds from last frame*/)
     //}
     {
         ProfileScopedSection_2(0, "InputUpdate", ImGuiControl::Profiler::Green);
+        PROFILE_ZONE("InputUpdate", "input");
         InputSystem::Update(deltaTime);
     }
 
@@ -113,6 +124,7 @@ void Framework::Render(float elapsed_time/*Elapsed seconds from last frame*/, bo
     {
         {
             ProfileScopedSection_2(0, "Render", ImGuiControl::Profiler::Red);
+            PROFILE_ZONE("Render", "render");
             Scene::_render(immediateContext, elapsed_time);
         }
         //gameManager->GenerateOutputAll();
@@ -122,6 +134,7 @@ void Framework::Render(float elapsed_time/*Elapsed seconds from last frame*/, bo
     //ImGui::Begin("ImGUI");
     {
         ProfileScopedSection_2(0, "ImGui", ImGuiControl::Profiler::Yellow);
+        PROFILE_ZONE("ImGui", "ui");
         ProfileDrawUI();
         Scene::_drawGUI();
     }
@@ -161,6 +174,7 @@ bool Framework::Uninitialize()
     //gameManager->UninitAll();
     // SCENE_TRANSITION
     Scene::_uninitialize(device);
+    Audio::Finalize();
     return true;
 }
 
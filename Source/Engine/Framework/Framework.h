@@ -43,6 +43,8 @@ extern ImWchar glyphRangesJapanese[];
 #include "Graphics/Sprite/SpriteBatch.h"
 #include "Graphics/Resource/GeometricPrimitive.h"
 
+#include "Engine/Input/InputSystem.h"
+
 #ifndef _DEBUG
 CONST LONG SCREEN_WIDTH{ 1920 };
 CONST LONG SCREEN_HEIGHT{ 1080 };
@@ -169,6 +171,30 @@ public:
             {
                 PostMessage(hwnd, WM_CLOSE, 0, 0);
             }
+            // ςȂ̌JԂ͋L^Ȃ
+            if (!(lparam & (1 << 30)))
+            {
+                InputSystem::OnKeyMessage(static_cast<int>(wparam), true);
+            }
+            break;
+        case WM_KEYUP:
+            InputSystem::OnKeyMessage(static_cast<int>(wparam), false);
+            break;
+        case WM_SYSKEYDOWN:
+        case WM_SYSKEYUP:
+            // Alt Ȃ (Alt+F4 ̂Ŋ̏ɂn)
+            if (msg == WM_SYSKEYUP || !(lparam & (1 << 30)))
+            {
+                InputSystem::OnKeyMessage(static_cast<int>(wparam), msg == WM_SYSKEYDOWN);
+            }
+            return DefWindowProc(hwnd, msg, wparam, lparam);
+        case WM_LBUTTONDOWN:
+        case WM_LBUTTONUP:
+            InputSystem::OnKeyMessage(VK_LBUTTON, msg == WM_LBUTTONDOWN);
+            break;
+        case WM_RBUTTONDOWN:
+        case WM_RBUTTONUP:
+            InputSystem::OnKeyMessage(VK_RBUTTON, msg == WM_RBUTTONDOWN);
             break;
         case WM_ENTERSIZEMOVE:
             tictoc.stop();
@@ -0,0 +1,341 @@
+#include "HeadlessRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "Components/Audio/AudioSourceComponent.h"
+#include "Engine/Debug/Profiler.h"
+#include "Engine/Framework/SelfTest.h"
+#include "Engine/Input/InputSystem.h"
+#include "Engine/Scene/Scene.h"
+#include "Engine/Utility/Deterministic.h"
+#include "Game/Actors/Base/Character.h"
+#include "Graphics/Core/Graphics.h"
+#include "Graphics/Core/RenderState.h"
+#include "Graphics/Renderer/ShapeRenderer.h"
+
+namespace
+{
+    void HashFloat(uint64_t& hash, float value)
+    {
+        // -0  0 ͓lƂĈ
+        if (value == 0.0f)
+        {
+            value = 0.0f;
+        }
+        const uint32_t bits = Deterministic::FloatBits(value);
+        Deterministic::Fnv1a64(hash, &bits, sizeof(bits));
+    }
+
+    // "--key=value" o ("..." ň͂񂾒l͋󔒂܂߂)
+    std::vector<std::pair<std::string, std::string>> ParseArguments(const char* commandLine)
+    {
+        std::vector<std::pair<std::string, std::string>> arguments;
+        std::string token;
+        bool inQuotes = false;
+        auto flush = [&]()
+            {
+                if (token.rfind("--", 0) == 0)
+                {
+                    const size_t equal = token.find('=');
+                    arguments.emplace_back(token.substr(2, equal == std::string::npos ? std::string::npos : equal - 2),
+                        equal == std::string::npos ? "" : token.substr(equal + 1));
+                }
+                token.clear();
+            };
+        for (const char* c = commandLine ? commandLine : ""; *c; ++c)
+        {
+            if (*c == '"')
+            {
+                inQuotes = !inQuotes;
+            }
+            else if ((*c == ' ' || *c == '\t') && !inQuotes)
+            {
+                flush();
+            }
+            else
+            {
+                token += *c;
+            }
+        }
+        flush();
+        return arguments;
+    }
+
+    // R\[Nꂽ͂ɏo (CI ̃Op)
+    void WriteOutput(const std::string& text)
+    {
+        if (AttachConsole(ATTACH_PARENT_PROCESS))
+        {
+            FILE* console = nullptr;
+            if (freopen_s(&console, "CONOUT$", "w", stdout) == 0)
+            {
+                std::fputs(text.c_str(), stdout);
+                std::fflush(stdout);
+            }
+        }
+        OutputDebugStringA(text.c_str());
+    }
+}
+
+std::string HeadlessRunner::Result::ToString() const
+{
+    std::string text;
+    char buf[256];
+    if (!error.empty())
+    {
+        return "HeadlessRunner : " + error + "\n";
+    }
+    std::vector<double> sorted;
+    double total = 0.0;
+    for (const Frame& frame : frames)
+    {
+        sorted.push_back(frame.milliseconds);
+        total += frame.milliseconds;
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double percent)
+        {
+            if (sorted.empty())
+            {
+                return 0.0;
+            }
+            const size_t rank = static_cast<size_t>(percent / 100.0 * sorted.size() + 0.999999);
+            return sorted[(std::clamp)(rank, static_cast<size_t>(1), sorted.size()) - 1];
+        };
+    sprintf_s(buf, "HeadlessRunner : %zu frames in %.3f s, update mean %.3f p50 %.3f p95 %.3f p99 %.3f max %.3f ms\n", frames.size(), totalSeconds,
+        frames.empty() ? 0.0 : total / frames.size(), percentile(50.0), percentile(95.0), percentile(99.0), sorted.empty() ? 0.0 : sorted.back());
+    text += buf;
+    sprintf_s(buf, "  final checksum %016llx, %u actors%s\n", frames.empty() ? 0ull : static_cast<unsigned long long>(frames.back().checksum),
+        frames.empty() ? 0u : frames.back().actors, isReplayFinished ? ", replay finished" : "");
+    text += buf;
+    if (divergedFrame >= 0)
+    {
+        sprintf_s(buf, "  DIVERGED at frame %d\n", divergedFrame);
+        text += buf;
+    }
+    return text;
+}
+
+uint64_t HeadlessRunner::ComputeChecksum(const Scene& scene)
+{
+    uint64_t hash = Deterministic::Fnv1a64Offset;
+    const ActorManager* actorManager = scene.GetActorManager();
+    if (!actorManager)
+    {
+        return hash;
+    }
+    for (const std::shared_ptr<Actor>& actor : actorManager->GetAllActors())
+    {
+        if (!actor)
+        {
+            continue;
+        }
+        const std::string& name = actor->GetName();
+        Deterministic::Fnv1a64(hash, name.data(), name.size());
+        const uint8_t active = actor->GetActive() ? 1 : 0;
+        Deterministic::Fnv1a64(hash, &active, sizeof(active));
+        const DirectX::XMFLOAT4X4& world = actor->GetWorldTransform();
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                HashFloat(hash, world.m[row][column]);
+            }
+        }
+        if (const Character* character = dynamic_cast<const Character*>(actor.get()))
+        {
+            const int hp = character->GetHp();
+            Deterministic::Fnv1a64(hash, &hp, sizeof(hp));
+        }
+    }
+    return hash;
+}
+
+HeadlessRunner::Result HeadlessRunner::Run(const Options& options)
+{
+    Result result;
+
+    std::vector<InputSnapshot> replayFrames;
+    if (!options.replayPath.empty() && !InputSystem::LoadRecording(options.replayPath, replayFrames))
+    {
+        result.error = "failed to load replay " + options.replayPath.string();
+        return result;
+    }
+    std::vector<uint64_t> reference;
+    if (!options.referencePath.empty() && !ReadChecksums(options.referencePath, reference))
+    {
+        result.error = "failed to load reference " + options.referencePath.string();
+        return result;
+    }
+    if (!Scene::_is_enrolled(options.sceneName))
+    {
+        result.error = "scene " + options.sceneName + " is not enrolled";
+        return result;
+    }
+
+    // ÉEt[ԂŒ肷
+    std::srand(options.seed);
+    Graphics::InitializeHeadless(options.width, options.height);
+    RenderState::Initialize();
+    Audio::Initialize();
+    InputSystem::Initialize();
+    if (options.replayPath.empty())
+    {
+        InputSystem::SetMode(InputMode::Null);
+    }
+    else
+    {
+        InputSystem::StartReplay(std::move(replayFrames));
+    }
+    ID3D11Device* device = Graphics::GetDevice();
+    ID3D11DeviceContext* immediateContext = Graphics::GetDeviceContext();
+    ShapeRenderer::Initialize(device);
+    Scene::_boot(device, options.sceneName, options.width, options.height, {});
+    Profiler::SetThreadName("Main Thread");
+
+    const auto runBegin = std::chrono::steady_clock::now();
+    result.frames.reserve(options.frames);
+    for (int frame = 0; frame < options.frames; ++frame)
+    {
+        const float recordedDeltaTime = InputSystem::GetReplayDeltaTime();
+        const float deltaTime = options.useRecordedDeltaTime && recordedDeltaTime > 0.0f ? recordedDeltaTime : options.fixedDeltaTime;
+
+        Profiler::NewFrame();
+        const auto begin = std::chrono::steady_clock::now();
+        {
+            // Framework::Update ƓōXV
+            PROFILE_ZONE("HeadlessRunner::Frame", "frame");
+            Audio::Update(deltaTime);
+            Scene::_update(immediateContext, deltaTime);
+            InputSystem::Update(deltaTime);
+        }
+        Frame& record = result.frames.emplace_back();
+        record.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        const Scene* scene = Scene::GetCurrentScene();
+        record.checksum = scene ? ComputeChecksum(*scene) : 0;
+        record.actors = scene && scene->GetActorManager() ? static_cast<uint32_t>(scene->GetActorManager()->GetAllActors().size()) : 0;
+        if (result.divergedFrame < 0 && static_cast<size_t>(frame) < reference.size() && reference[frame] != record.checksum)
+        {
+            result.divergedFrame = frame;
+        }
+    }
+    result.totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runBegin).count();
+    result.isReplayFinished = InputSystem::IsReplayFinished();
+    Profiler::Collect();
+
+    Audio::ClearAll();
+    Scene::_uninitialize(device);
+    Audio::Finalize();
+    InputSystem::SetMode(InputMode::Live);
+
+    if (!options.outputPath.empty() && !WriteCsv(options.outputPath, result))
+    {
+        result.error = "failed to write " + options.outputPath.string();
+    }
+    return result;
+}
+
+bool HeadlessRunner::WriteCsv(const std::filesystem::path& path, const Result& result)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    std::ofstream stream(path);
+    if (!stream)
+    {
+        return false;
+    }
+    stream << "frame,milliseconds,checksum,actors\n";
+    char buf[96];
+    for (size_t frame = 0; frame < result.frames.size(); ++frame)
+    {
+        const Frame& record = result.frames[frame];
+        sprintf_s(buf, "%zu,%.4f,%016llx,%u\n", frame, record.milliseconds, static_cast<unsigned long long>(record.checksum), record.actors);
+        stream << buf;
+    }
+    return static_cast<bool>(stream);
+}
+
+bool HeadlessRunner::ReadChecksums(const std::filesystem::path& path, std::vector<uint64_t>& checksums)
+{
+    std::ifstream stream(path);
+    if (!stream)
+    {
+        return false;
+    }
+    checksums.clear();
+    std::string line;
+    std::getline(stream, line);// o
+    while (std::getline(stream, line))
+    {
+        std::istringstream fields(line);
+        std::string frame, milliseconds, checksum;
+        if (!std::getline(fields, frame, ',') || !std::getline(fields, milliseconds, ',') || !std::getline(fields, checksum, ','))
+        {
+            return false;
+        }
+        checksums.push_back(std::strtoull(checksum.c_str(), nullptr, 16));
+    }
+    return true;
+}
+
+bool HeadlessRunner::IsRequested(const char* commandLine)
+{
+    for (const auto& [key, value] : ParseArguments(commandLine))
+    {
+        if (key == "headless" || key == "selftest")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int HeadlessRunner::RunFromCommandLine(const char* commandLine)
+{
+    Options options;
+    for (const auto& [key, value] : ParseArguments(commandLine))
+    {
+        if (key == "selftest")
+        {
+            std::string report;
+            const bool succeeded = SelfTest::Run(value.empty() ? "all" : value, report);
+            WriteOutput(report);
+            return succeeded ? 0 : 1;
+        }
+    }
+    for (const auto& [key, value] : ParseArguments(commandLine))
+    {
+        if (key == "scene") options.sceneName = value;
+        else if (key == "frames") options.frames = std::atoi(value.c_str());
+        else if (key == "dt") options.fixedDeltaTime = static_cast<float>(std::atof(value.c_str()));
+        else if (key == "recorded-dt") options.useRecordedDeltaTime = true;
+        else if (key == "seed") options.seed = static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (key == "width") options.width = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else if (key == "height") options.height = static_cast<unsigned int>(std::atoi(value.c_str()));
+        else if (key == "replay") options.replayPath = value;
+        else if (key == "reference") options.referencePath = value;
+        else if (key == "output") options.outputPath = value;
+    }
+    options.frames = (std::max)(options.frames, 0);
+    if (options.fixedDeltaTime <= 0.0f)
+    {
+        options.fixedDeltaTime = 1.0f / 60.0f;
+    }
+
+    const Result result = Run(options);
+    WriteOutput(result.ToString() + Profiler::Report());
+    if (!result.error.empty())
+    {
+        return 2;
+    }
+    return result.divergedFrame >= 0 ? 1 : 0;
+}
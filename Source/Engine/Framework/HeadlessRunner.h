@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+class Scene;
+
+// EBhEƕ`斳ŃQ[[v (Scene::_update) Œ̃t[Ԃŉ
+//   OtBbNX͕`悵ȂfoCX (Graphics::InitializeHeadless) ŏA` Present ͌Ă΂Ȃ
+//   ͂͋L^t@C (InputSystem::SaveRecording) Đ邩AȂ
+//   t[Ƃ̍XVԂƁAAN^[̏ (gXtH[EHP) ̃`FbNTo
+//   ǑʂƔׂāAŏɃ`FbNTt[ (V~[V̂) 
+// R}hC : 3dgp.exe --headless --scene=MainScene --frames=600 --replay=input.rec --reference=base.csv --output=result.csv
+// --selftest=O (all ȂS) ̎̓V[񂳂 SelfTest s : 3dgp.exe --selftest=all
+class HeadlessRunner
+{
+public:
+    struct Options
+    {
+        std::string sceneName = "MainScene";
+        int frames = 600;
+        float fixedDeltaTime = 1.0f / 60.0f;
+        bool useRecordedDeltaTime = false;  // Đ鎞ɋL^̃t[Ԃg (L^𓯂ԂōČ)
+        unsigned int seed = 1;              // srand ̎ (WinMain ͎ŏ̂ŌŒ肷)
+        unsigned int width = 1280;
+        unsigned int height = 720;
+        std::filesystem::path replayPath;   // Ȃ͖
+        std::filesystem::path referencePath;// Ǒ (CSV)AȂׂȂ
+        std::filesystem::path outputPath;   // t[Ƃ̎Ԃƃ`FbNT (CSV)AȂ珑Ȃ
+    };
+
+    struct Frame
+    {
+        double milliseconds = 0.0;  // ͂ Scene::_update ̎
+        uint64_t checksum = 0;
+        uint32_t actors = 0;
+    };
+
+    struct Result
+    {
+        std::vector<Frame> frames;
+        int divergedFrame = -1;     // ǑʂƍŏɈt[ (Ȃ -1)
+        bool isReplayFinished = false;
+        std::string error;          // Eǂݍ݂̎s
+        double totalSeconds = 0.0;
+
+        bool Succeeded() const { return error.empty() && divergedFrame < 0; }
+        std::string ToString() const;
+    };
+
+    static Result Run(const Options& options);
+
+    // V[̑SẴAN^[̃gXtH[ HP ̃`FbNT (FNV-1a)
+    static uint64_t ComputeChecksum(const Scene& scene);
+
+    // ʂ CSV (frame,milliseconds,checksum,actors)
+    static bool WriteCsv(const std::filesystem::path& path, const Result& result);
+    static bool ReadChecksums(const std::filesystem::path& path, std::vector<uint64_t>& checksums);
+
+    // R}hC --headless  --selftest 邩
+    static bool IsRequested(const char* commandLine);
+    // R}hC̐ݒŎsďIR[hԂ (0 : , 1 : ǑʂƂꂽESelfTest ̎s, 2 : Eǂݍ݂̎s)
+    static int RunFromCommandLine(const char* commandLine);
+};
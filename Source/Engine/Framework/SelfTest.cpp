@@ -0,0 +1,111 @@
+#include "SelfTest.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <utility>
+
+namespace
+{
+    struct Entry
+    {
+        std::string name;
+        SelfTest::Function function;
+    };
+
+    // ÓIȕϐ̏̏ԂɈ˂Ȃ悤ɁAŏɎgɍ
+    std::vector<Entry>& GetEntries()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+}
+
+SelfTest::Registrar::Registrar(const char* name, Function function)
+{
+    GetEntries().push_back({ name, function });
+}
+
+bool SelfTest::Check(bool condition, const char* message)
+{
+    if (!condition && errorCount++ < MaxReportedErrors)
+    {
+        lines += "  FAILED : ";
+        lines += message;
+        lines += "\n";
+    }
+    return condition;
+}
+
+void SelfTest::Print(const char* format, ...)
+{
+    char buf[512];
+    va_list arguments;
+    va_start(arguments, format);
+    vsnprintf(buf, sizeof(buf), format, arguments);
+    va_end(arguments);
+    lines += "  ";
+    lines += buf;
+    lines += "\n";
+}
+
+void SelfTest::Append(const std::string& text)
+{
+    lines += text;
+    if (!text.empty() && text.back() != '\n')
+    {
+        lines += "\n";
+    }
+}
+
+bool SelfTest::Run(const std::string& name, std::string& report)
+{
+    bool succeeded = true;
+    size_t count = 0;
+    for (const Entry& entry : GetEntries())
+    {
+        if (name != "all" && name != entry.name)
+        {
+            continue;
+        }
+        SelfTest test;
+        const auto begin = std::chrono::steady_clock::now();
+        entry.function(test);
+        const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        char buf[256];
+        if (test.errorCount == 0)
+        {
+            sprintf_s(buf, "%s : OK (%.1f ms)\n", entry.name.c_str(), milliseconds);
+        }
+        else
+        {
+            sprintf_s(buf, "%s : FAILED (%zu errors, %.1f ms)\n", entry.name.c_str(), test.errorCount, milliseconds);
+            succeeded = false;
+        }
+        report += buf;
+        report += test.lines;
+        ++count;
+    }
+    if (count == 0)
+    {
+        report += "SelfTest : " + name + " is not registered (";
+        for (const std::string& registered : GetNames())
+        {
+            report += " " + registered;
+        }
+        report += " )\n";
+        return false;
+    }
+    return succeeded;
+}
+
+std::vector<std::string> SelfTest::GetNames()
+{
+    std::vector<std::string> names;
+    for (const Entry& entry : GetEntries())
+    {
+        names.push_back(entry.name);
+    }
+    return names;
+}
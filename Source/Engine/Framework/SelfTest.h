@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// GPU ƃEBhEgȂmFEv (HeadlessRunner  --selftest=O Ŏs)
+//   eXg Source/Test  SELF_TEST(O) { ... } ŏAtest.Check Ŋm߂ test.Print Ōvʂc
+//   ʂ "O : OK"  "O : FAILED (N errors)" ̌oƁẢ̍s
+class SelfTest
+{
+public:
+    using Function = void(*)(SelfTest& test);
+
+    // s̓ec (葽s͐)
+    static constexpr size_t MaxReportedErrors = 8;
+
+    // SELF_TEST ̐ÓIȕϐo^
+    struct Registrar
+    {
+        Registrar(const char* name, Function function);
+    };
+
+    // condition UȂ玸sɂ (condition ̂܂ܕԂ)
+    bool Check(bool condition, const char* message);
+    // ʂ 1 s (printf ̏AƉs͂ŕt)
+    void Print(const char* format, ...);
+    // sƂɏ𐮂 (Statistics::ToString Ȃ) ̂܂ܑ
+    void Append(const std::string& text);
+
+    size_t GetErrorCount() const { return errorCount; }
+
+    // name ̃eXg ("all" ȂS) o^ɎsČʂ report ɑ
+    // SĐȂ true (name ̃eXgΓo^Ă閼O false)
+    static bool Run(const std::string& name, std::string& report);
+    static std::vector<std::string> GetNames();
+
+private:
+    std::string lines;
+    size_t errorCount = 0;
+};
+
+// g : SELF_TEST(EffectRegistry) { test.Check(registry.Resolve(handle) == component, "..."); }
+#define SELF_TEST(name) \
+    static void SelfTest_##name(SelfTest& test); \
+    static const SelfTest::Registrar selfTestRegistrar_##name(#name, SelfTest_##name); \
+    static void SelfTest_##name(SelfTest& test)
@@ -1,5 +1,9 @@
 #include "InputSystem.h"
 #include <Windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include "Graphics/Core/Graphics.h"
 
 // zIȍXeBbÑL[R[h
@@ -55,7 +59,7 @@ static void ApplyStickDeadzone(float x, float y, DeadZoneMode deadZoneMode, floa
 void InputKey::Update(float deltaTime)
 {
     oldPressTime_ = pressTime_;
-    pressTime_ = (static_cast<USHORT>(GetAsyncKeyState(vkey_)) & 0x8000) ? pressTime_ + deltaTime : 0.0f;
+    pressTime_ = InputSystem::IsKeyDown(vkey_) ? pressTime_ + deltaTime : 0.0f;
 }
 
 void Gamepad::Update(float deltaTime)
@@ -105,64 +109,75 @@ void Gamepad::Update(float deltaTime)
 
 }
 
+InputSystem InputSystem::live;
+InputSystem* InputSystem::active = &InputSystem::live;
+
 //  
 void InputSystem::Initialize()
 {
-    directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Up)] = std::make_unique<Keyboard>('W');
-    directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Left)] = std::make_unique<Keyboard>('A');
-    directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Down)] = std::make_unique<Keyboard>('S');
-    directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Right)] = std::make_unique<Keyboard>('D');
-
-    directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Up)] = std::make_unique<Keyboard>('I');
-    directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Left)] = std::make_unique<Keyboard>('J');
-    directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Down)] = std::make_unique<Keyboard>('K');
-    directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Right)] = std::make_unique<Keyboard>('L');
-
-
-    inputKeys.clear();
-
-    inputKeys["MouseRight"].emplace_back(std::make_unique<Mouse>(VK_RBUTTON));
-    inputKeys["MouseLeft"].emplace_back(std::make_unique<Mouse>(VK_LBUTTON));
-
-
-    inputKeys["F8"].emplace_back(std::make_unique<Keyboard>(VK_F8));
-    inputKeys["Alt"].emplace_back(std::make_unique<Keyboard>(VK_MENU));
-    inputKeys["Enter"].emplace_back(std::make_unique<Keyboard>(VK_RETURN));
-    inputKeys["Shift"].emplace_back(std::make_unique<Keyboard>(VK_SHIFT));
-
-    inputKeys["Space"].emplace_back(std::make_unique<Keyboard>(VK_SPACE));
-    inputKeys["Space"].emplace_back(std::make_unique<Gamepad>(XINPUT_GAMEPAD_X));
-
-    inputKeys["Up"].emplace_back(std::make_unique<Keyboard>(VK_UP));
-    inputKeys["W"].emplace_back(std::make_unique<Keyboard>('W'));
-    inputKeys["Left"].emplace_back(std::make_unique<Keyboard>(VK_LEFT));
-    inputKeys["A"].emplace_back(std::make_unique<Keyboard>('A'));
-    inputKeys["Down"].emplace_back(std::make_unique<Keyboard>(VK_DOWN));
-    inputKeys["S"].emplace_back(std::make_unique<Keyboard>('S'));
-    inputKeys["Right"].emplace_back(std::make_unique<Keyboard>(VK_RIGHT));
-    inputKeys["D"].emplace_back(std::make_unique<Keyboard>('D'));
-
-
-    inputKeys["W"].emplace_back(std::make_unique<Gamepad>(GAMEPAD_AXIS_UP));     // XeBbN
-    inputKeys["A"].emplace_back(std::make_unique<Gamepad>(GAMEPAD_AXIS_LEFT));   // XeBbN
-    inputKeys["S"].emplace_back(std::make_unique<Gamepad>(GAMEPAD_AXIS_DOWN));   // XeBbN
-    inputKeys["D"].emplace_back(std::make_unique<Gamepad>(GAMEPAD_AXIS_RIGHT));  // XeBbNE
-
-    inputKeys["E"].emplace_back(std::make_unique<Keyboard>('E'));
-    inputKeys["Q"].emplace_back(std::make_unique<Keyboard>('Q'));
-    inputKeys["Z"].emplace_back(std::make_unique<Keyboard>('Z'));
-    inputKeys["R"].emplace_back(std::make_unique<Keyboard>('R'));
-    inputKeys["X"].emplace_back(std::make_unique<Keyboard>('X'));
-    inputKeys["T"].emplace_back(std::make_unique<Keyboard>('T'));
-    inputKeys["Y"].emplace_back(std::make_unique<Keyboard>('Y'));
-    inputKeys["Z"].emplace_back(std::make_unique<Keyboard>('Z'));
-    inputKeys["Backspace"].emplace_back(std::make_unique<Keyboard>(VK_BACK));
-    inputKeys["Backspace"].emplace_back(std::make_unique<Keyboard>(XINPUT_GAMEPAD_B));
-    inputKeys["Enter"].emplace_back(std::make_unique<Gamepad>(XINPUT_GAMEPAD_A));
-
-    inputKeys["ok"].emplace_back(std::make_unique<Mouse>(VK_LBUTTON));
-    inputKeys["ok"].emplace_back(std::make_unique<Keyboard>(VK_RETURN));
-    inputKeys["ok"].emplace_back(std::make_unique<Gamepad>(XINPUT_GAMEPAD_A));
+    active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Up)] = std::make_unique<Keyboard>('W');
+    active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Left)] = std::make_unique<Keyboard>('A');
+    active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Down)] = std::make_unique<Keyboard>('S');
+    active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Right)] = std::make_unique<Keyboard>('D');
+
+    active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Up)] = std::make_unique<Keyboard>('I');
+    active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Left)] = std::make_unique<Keyboard>('J');
+    active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Down)] = std::make_unique<Keyboard>('K');
+    active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Right)] = std::make_unique<Keyboard>('L');
+
+
+    // ԍ͎căL[̊蓖Ă蒼
+    for (auto& keys : active->actionKeys)
+    {
+        keys.clear();
+    }
+    for (auto& actions : active->virtualKeyActions)
+    {
+        actions.clear();
+    }
+
+    BindKey("MouseRight", std::make_unique<Mouse>(VK_RBUTTON));
+    BindKey("MouseLeft", std::make_unique<Mouse>(VK_LBUTTON));
+
+
+    BindKey("F8", std::make_unique<Keyboard>(VK_F8));
+    BindKey("Alt", std::make_unique<Keyboard>(VK_MENU));
+    BindKey("Enter", std::make_unique<Keyboard>(VK_RETURN));
+    BindKey("Shift", std::make_unique<Keyboard>(VK_SHIFT));
+
+    BindKey("Space", std::make_unique<Keyboard>(VK_SPACE));
+    BindKey("Space", std::make_unique<Gamepad>(XINPUT_GAMEPAD_X));
+
+    BindKey("Up", std::make_unique<Keyboard>(VK_UP));
+    BindKey("W", std::make_unique<Keyboard>('W'));
+    BindKey("Left", std::make_unique<Keyboard>(VK_LEFT));
+    BindKey("A", std::make_unique<Keyboard>('A'));
+    BindKey("Down", std::make_unique<Keyboard>(VK_DOWN));
+    BindKey("S", std::make_unique<Keyboard>('S'));
+    BindKey("Right", std::make_unique<Keyboard>(VK_RIGHT));
+    BindKey("D", std::make_unique<Keyboard>('D'));
+
+
+    BindKey("W", std::make_unique<Gamepad>(GAMEPAD_AXIS_UP));     // XeBbN
+    BindKey("A", std::make_unique<Gamepad>(GAMEPAD_AXIS_LEFT));   // XeBbN
+    BindKey("S", std::make_unique<Gamepad>(GAMEPAD_AXIS_DOWN));   // XeBbN
+    BindKey("D", std::make_unique<Gamepad>(GAMEPAD_AXIS_RIGHT));  // XeBbNE
+
+    BindKey("E", std::make_unique<Keyboard>('E'));
+    BindKey("Q", std::make_unique<Keyboard>('Q'));
+    BindKey("Z", std::make_unique<Keyboard>('Z'));
+    BindKey("R", std::make_unique<Keyboard>('R'));
+    BindKey("X", std::make_unique<Keyboard>('X'));
+    BindKey("T", std::make_unique<Keyboard>('T'));
+    BindKey("Y", std::make_unique<Keyboard>('Y'));
+    BindKey("Z", std::make_unique<Keyboard>('Z'));
+    BindKey("Backspace", std::make_unique<Keyboard>(VK_BACK));
+    BindKey("Backspace", std::make_unique<Keyboard>(XINPUT_GAMEPAD_B));
+    BindKey("Enter", std::make_unique<Gamepad>(XINPUT_GAMEPAD_A));
+
+    BindKey("ok", std::make_unique<Mouse>(VK_LBUTTON));
+    BindKey("ok", std::make_unique<Keyboard>(VK_RETURN));
+    BindKey("ok", std::make_unique<Gamepad>(XINPUT_GAMEPAD_A));
 
 }
 
@@ -170,26 +185,55 @@ void InputSystem::Initialize()
 // XV
 void InputSystem::Update(float deltaTime)
 {
-    DWORD xinputResult = XInputGetState(static_cast<DWORD>(slot), &state);
-    isGamePadConnected = (xinputResult == ERROR_SUCCESS);
+    // ܂łɃEBhEbZ[WL^̃t[̕ɂ
+    ++active->frameIndex;
+    active->frameEventBegin = active->pendingEventBegin;
+
+    // ̃t[̃foCX̓͂߂
+    switch (active->mode)
+    {
+    case InputMode::Live:
+    case InputMode::Recording:
+    {
+        active->current = {};
+        active->current.deltaTime = deltaTime;
+        DWORD xinputResult = XInputGetState(static_cast<DWORD>(active->slot), &active->xinputState);
+        active->isGamePadConnected = (xinputResult == ERROR_SUCCESS);
+        active->current.gamepad = active->xinputState.Gamepad;
+        active->current.gamepadConnected = active->isGamePadConnected ? 1 : 0;
+        break;
+    }
+    case InputMode::Replaying:
+        active->current = active->replayFrame < active->replay.size() ? active->replay[active->replayFrame] : InputSnapshot{};
+        ++active->replayFrame;
+        active->xinputState = {};
+        active->xinputState.Gamepad = active->current.gamepad;
+        active->isGamePadConnected = active->current.gamepadConnected != 0;
+        break;
+    case InputMode::Null:
+        active->current = {};
+        active->xinputState = {};
+        active->isGamePadConnected = false;
+        break;
+    }
 
     //͏̍XV
     {
-        if (isGamePadConnected)
+        if (active->isGamePadConnected)
         {
             //Q[pbhAxisLeftXV
-            ApplyStickDeadzone(static_cast<float>(state.Gamepad.sThumbLX), static_cast<float>(state.Gamepad.sThumbLY),
-                deadZoneMode, 32767.f, static_cast<float>(XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE),
-                mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::X)], mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::Y)]);
+            ApplyStickDeadzone(static_cast<float>(active->xinputState.Gamepad.sThumbLX), static_cast<float>(active->xinputState.Gamepad.sThumbLY),
+                active->deadZoneMode, 32767.f, static_cast<float>(XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE),
+                active->mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::X)], active->mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::Y)]);
             //Q[pbhAxisRightXV
-            ApplyStickDeadzone(static_cast<float>(state.Gamepad.sThumbRX), static_cast<float>(state.Gamepad.sThumbRY),
-                deadZoneMode, 32767.f, static_cast<float>(XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE),
-                mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::X)], mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::Y)]);
+            ApplyStickDeadzone(static_cast<float>(active->xinputState.Gamepad.sThumbRX), static_cast<float>(active->xinputState.Gamepad.sThumbRY),
+                active->deadZoneMode, 32767.f, static_cast<float>(XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE),
+                active->mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::X)], active->mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::Y)]);
         }
         else
         {
             //ړL[XV
-            for (auto& keys : directionKeys) {
+            for (auto& keys : active->directionKeys) {
                 for (auto& key : keys) {
                     key->Update(deltaTime);
                 }
@@ -197,58 +241,64 @@ void InputSystem::Update(float deltaTime)
 
             //lXV
             ApplyStickDeadzone(
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Right)]->IsPressed()) -
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Left)]->IsPressed()),
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Up)]->IsPressed()) -
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Down)]->IsPressed()),
-                deadZoneMode, 1.f, 0.f,
-                mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::X)], mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::Y)]);
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Right)]->IsPressed()) -
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Left)]->IsPressed()),
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Up)]->IsPressed()) -
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Left)][static_cast<size_t>(Direction::Down)]->IsPressed()),
+                active->deadZoneMode, 1.f, 0.f,
+                active->mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::X)], active->mAxis[static_cast<size_t>(Side::Left)][static_cast<size_t>(Axis::Y)]);
 
             ApplyStickDeadzone(
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Right)]->IsPressed()) -
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Left)]->IsPressed()),
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Up)]->IsPressed()) -
-                static_cast<float>(directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Down)]->IsPressed()),
-                deadZoneMode, 1.f, 0.f,
-                mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::X)], mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::Y)]);
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Right)]->IsPressed()) -
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Left)]->IsPressed()),
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Up)]->IsPressed()) -
+                static_cast<float>(active->directionKeys[static_cast<size_t>(Side::Right)][static_cast<size_t>(Direction::Down)]->IsPressed()),
+                active->deadZoneMode, 1.f, 0.f,
+                active->mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::X)], active->mAxis[static_cast<size_t>(Side::Right)][static_cast<size_t>(Axis::Y)]);
         }
         //{^͍̓XV
-        for (auto& actionKeys : inputKeys) {
-            for (auto& key : actionKeys.second) {
+        for (auto& keys : active->actionKeys) {
+            for (auto& key : keys) {
                 key->Update(deltaTime);
             }
         }
+        UpdateActionStates();
 
     }
     // J[\ʒu̎擾
-    POINT cursor;
-    ::GetCursorPos(&cursor);
-    ScreenToClient(Graphics::GetWindowHandle(), &cursor);
+    POINT cursor{ active->current.mouseX, active->current.mouseY };
+    if (active->mode == InputMode::Live || active->mode == InputMode::Recording)
+    {
+        ::GetCursorPos(&cursor);
+        ScreenToClient(Graphics::GetWindowHandle(), &cursor);
+        active->current.mouseX = cursor.x;
+        active->current.mouseY = cursor.y;
+    }
 
     // }EXWXV
-    mousePositionX[1] = mousePositionX[0];
-    mousePositionY[1] = mousePositionY[0];
-    mousePositionX[0] = (LONG)cursor.x;
-    mousePositionY[0] = (LONG)cursor.y;
+    active->mousePositionX[1] = active->mousePositionX[0];
+    active->mousePositionY[1] = active->mousePositionY[0];
+    active->mousePositionX[0] = (LONG)cursor.x;
+    active->mousePositionY[0] = (LONG)cursor.y;
 
     //ANeBufoCX
 
 #if 0
     //Rg[[
     {
-        auto buttons = state.Gamepad.wButtons;
-        auto lx = state.Gamepad.sThumbLX;
-        auto ly = state.Gamepad.sThumbLY;
+        auto buttons = active->xinputState.Gamepad.wButtons;
+        auto lx = active->xinputState.Gamepad.sThumbLX;
+        auto ly = active->xinputState.Gamepad.sThumbLY;
         // {^ꂽ or XeBbNANeBufoCX؂ւ
         if (buttons != 0 || abs(lx) > XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE || abs(ly) > XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE) {
-            activeDevice = InputDeviceType::Gamepad;
+            active->activeDevice = InputDeviceType::Gamepad;
         }
     }
     //L[{[h
     {
         for (int vk = 0x08; vk <= 0xFE; ++vk) {
             if (GetAsyncKeyState(vk) & 0x8000) {
-                activeDevice = InputDeviceType::Keyboard;
+                active->activeDevice = InputDeviceType::Keyboard;
             }
         }
     }
@@ -256,23 +306,23 @@ void InputSystem::Update(float deltaTime)
     {
         if (GetAsyncKeyState(VK_LBUTTON) & 0x8000 ||
             GetAsyncKeyState(VK_RBUTTON) & 0x8000 ||
-            mousePositionX[0] != mousePositionX[1] ||
-            mousePositionY[0] != mousePositionY[1]) {
-            activeDevice = InputDeviceType::Mouse;
+            active->mousePositionX[0] != active->mousePositionX[1] ||
+            active->mousePositionY[0] != active->mousePositionY[1]) {
+            active->activeDevice = InputDeviceType::Mouse;
         }
     }
 #else
     // 1. Gamepad
     {
-        auto buttons = state.Gamepad.wButtons;
-        auto lx = state.Gamepad.sThumbLX;
-        auto ly = state.Gamepad.sThumbLY;
+        auto buttons = active->xinputState.Gamepad.wButtons;
+        auto lx = active->xinputState.Gamepad.sThumbLX;
+        auto ly = active->xinputState.Gamepad.sThumbLY;
 
         if (buttons != 0 ||
             abs(lx) > XINPUT_GAMEPAD_LEFT_THUMB_DEADZONE ||
             abs(ly) > XINPUT_GAMEPAD_RIGHT_THUMB_DEADZONE)
         {
-            activeDevice = InputDeviceType::Gamepad;
+            active->activeDevice = InputDeviceType::Gamepad;
         }
     }
 
@@ -283,60 +333,303 @@ void InputSystem::Update(float deltaTime)
 
     // 3. Mouse
     {
-        if (GetAsyncKeyState(VK_LBUTTON) & 0x8000 ||
-            GetAsyncKeyState(VK_RBUTTON) & 0x8000 ||
-            mousePositionX[0] != mousePositionX[1] ||
-            mousePositionY[0] != mousePositionY[1])
+        if (IsKeyDown(VK_LBUTTON) ||
+            IsKeyDown(VK_RBUTTON) ||
+            active->mousePositionX[0] != active->mousePositionX[1] ||
+            active->mousePositionY[0] != active->mousePositionY[1])
         {
-            activeDevice = InputDeviceType::Mouse;
+            active->activeDevice = InputDeviceType::Mouse;
         }
     }
 
 
 #endif // 0
+
+    if (active->mode == InputMode::Recording)
+    {
+        active->recording.push_back(active->current);
+    }
+    active->pendingEventBegin = active->eventEnd;
+}
+
+InputActionId InputSystem::RegisterAction(const std::string& action)
+{
+    auto it = active->actionIds.find(action);
+    if (it != active->actionIds.end())
+    {
+        return it->second;
+    }
+    if (active->actionNames.empty())
+    {
+        active->actionNames.reserve(MaxActions);
+        active->actionKeys.reserve(MaxActions);
+        active->actionStates.reserve(MaxActions);
+    }
+    _ASSERT_EXPR(active->actionNames.size() < MaxActions, L"Too many input actions");
+    if (active->actionNames.size() >= MaxActions)
+    {
+        return InvalidInputAction;
+    }
+    const InputActionId id = static_cast<InputActionId>(active->actionNames.size());
+    active->actionNames.push_back(action);
+    active->actionKeys.emplace_back();
+    active->actionStates.push_back(0);
+    active->actionIds.emplace(action, id);
+    return id;
 }
 
-bool InputSystem::GetInputState(const std::string& action, InputStateMask state, DeviceFlags flag)
+InputActionId InputSystem::FindAction(const std::string& action)
 {
-    auto it = inputKeys.find(action);
-    if (it != inputKeys.end())
+    auto it = active->actionIds.find(action);
+    return it != active->actionIds.end() ? it->second : InvalidInputAction;
+}
+
+const std::string& InputSystem::GetActionName(InputActionId action)
+{
+    static const std::string empty;
+    return action < active->actionNames.size() ? active->actionNames[action] : empty;
+}
+
+void InputSystem::BindKey(const std::string& action, std::unique_ptr<InputKey> key)
+{
+    const InputActionId id = RegisterAction(action);
+    if (id == InvalidInputAction)
+    {
+        return;
+    }
+    const int vkey = key->GetVirtualKey();
+    if (key->GetDeviceType() != InputDeviceType::Gamepad && vkey >= 0 && vkey <= 0xFF)
     {
-        const auto& keys = it->second;
-        for (auto& key : keys) {
-            switch (flag)
+        std::vector<InputActionId>& actions = active->virtualKeyActions[vkey];
+        if (std::find(actions.begin(), actions.end(), id) == actions.end())
+        {
+            actions.push_back(id);
+        }
+    }
+    active->actionKeys[id].emplace_back(std::move(key));
+}
+
+void InputSystem::UpdateActionStates()
+{
+    // Live  Recording ̃L[{[hƃ}EX̓EBhEbZ[WL^̂ŁAł͂ȊO
+    const bool isMessageDriven = active->mode == InputMode::Live || active->mode == InputMode::Recording;
+    const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    for (size_t action = 0; action < active->actionKeys.size(); ++action)
+    {
+        uint16_t bits = 0;
+        for (const auto& key : active->actionKeys[action])
+        {
+            const int shift = static_cast<int>(key->GetDeviceType()) * 3;
+            bits |= static_cast<uint16_t>((key->IsPressed() ? 1u : 0u) << shift);
+            bits |= static_cast<uint16_t>((key->IsTrigger() ? 2u : 0u) << shift);
+            bits |= static_cast<uint16_t>((key->IsRelease() ? 4u : 0u) << shift);
+        }
+        active->actionStates[action] = bits;
+
+        for (int device = 0; device < 3; ++device)
+        {
+            const uint16_t deviceBits = (bits >> (device * 3)) & 0b111;
+            if (!deviceBits || (isMessageDriven && device != static_cast<int>(InputDeviceType::Gamepad)))
             {
-            case DeviceFlags::KeyboardOnly:
-                if (key->GetDeviceType() != InputDeviceType::Keyboard) continue;
-                break;
-            case DeviceFlags::MouseOnly:
-                if (key->GetDeviceType() != InputDeviceType::Mouse) continue;
-                break;
-            case DeviceFlags::GamePadOnly:
-                if (key->GetDeviceType() != InputDeviceType::Gamepad) continue;
-                break;
-            case DeviceFlags::KeyboardAndMouse:
-                if (key->GetDeviceType() == InputDeviceType::Gamepad) continue;
-                break;
-            case DeviceFlags::KeyboardAndGamePad:
-                if (key->GetDeviceType() == InputDeviceType::Mouse) continue;
-                break;
-            case DeviceFlags::MouseAndGamePad:
-                if (key->GetDeviceType() == InputDeviceType::Keyboard) continue;
-                break;
+                continue;
             }
-            switch (state)
+            if (deviceBits & 2u)
             {
-            case InputStateMask::Trigger:
-                if (key->IsTrigger()) return true;
-                break;
-            case InputStateMask::Release:
-                if (key->IsRelease()) return true;
-                break;
-            default:
-                if (key->IsPressed()) return true;
+                PushEvent(static_cast<InputActionId>(action), static_cast<InputDeviceType>(device), InputEventType::Press, now, active->frameIndex);
+            }
+            if (deviceBits & 4u)
+            {
+                PushEvent(static_cast<InputActionId>(action), static_cast<InputDeviceType>(device), InputEventType::Release, now, active->frameIndex);
+            }
+        }
+    }
+}
+
+void InputSystem::PushEvent(InputActionId action, InputDeviceType device, InputEventType type, uint64_t time, uint32_t frame)
+{
+    InputEvent& event = active->events[active->eventEnd & (EventCapacity - 1)];
+    event.time = time;
+    event.frame = frame;
+    event.action = action;
+    event.device = device;
+    event.type = type;
+    ++active->eventEnd;
+}
+
+void InputSystem::OnKeyMessage(int vkey, bool isDown)
+{
+    if ((active->mode != InputMode::Live && active->mode != InputMode::Recording) || vkey < 0 || vkey > 0xFF)
+    {
+        return;
+    }
+    const uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    const InputEventType type = isDown ? InputEventType::Press : InputEventType::Release;
+    for (InputActionId action : active->virtualKeyActions[vkey])
+    {
+        for (const auto& key : active->actionKeys[action])
+        {
+            if (key->GetVirtualKey() == vkey && key->GetDeviceType() != InputDeviceType::Gamepad)
+            {
+                //  Update œǂ
+                PushEvent(action, key->GetDeviceType(), type, now, active->frameIndex + 1);
                 break;
             }
         }
     }
+}
+
+bool InputSystem::QueryKeys(InputActionId action, InputStateMask state, DeviceFlags flag)
+{
+    if (action >= active->actionKeys.size())
+    {
+        return false;
+    }
+    for (auto& key : active->actionKeys[action]) {
+        switch (flag)
+        {
+        case DeviceFlags::KeyboardOnly:
+            if (key->GetDeviceType() != InputDeviceType::Keyboard) continue;
+            break;
+        case DeviceFlags::MouseOnly:
+            if (key->GetDeviceType() != InputDeviceType::Mouse) continue;
+            break;
+        case DeviceFlags::GamePadOnly:
+            if (key->GetDeviceType() != InputDeviceType::Gamepad) continue;
+            break;
+        case DeviceFlags::KeyboardAndMouse:
+            if (key->GetDeviceType() == InputDeviceType::Gamepad) continue;
+            break;
+        case DeviceFlags::KeyboardAndGamePad:
+            if (key->GetDeviceType() == InputDeviceType::Mouse) continue;
+            break;
+        case DeviceFlags::MouseAndGamePad:
+            if (key->GetDeviceType() == InputDeviceType::Keyboard) continue;
+            break;
+        }
+        switch (state)
+        {
+        case InputStateMask::Trigger:
+            if (key->IsTrigger()) return true;
+            break;
+        case InputStateMask::Release:
+            if (key->IsRelease()) return true;
+            break;
+        default:
+            if (key->IsPressed()) return true;
+            break;
+        }
+    }
     return false;
-}
\ No newline at end of file
+}
+
+bool InputSystem::IsKeyDown(int vkey)
+{
+    // zL[͈̔͊O (Q[pbh̃{^̒lnȂ) ͉ĂȂ
+    if (vkey < 0 || vkey > 0xFF)
+    {
+        return false;
+    }
+    switch (active->mode)
+    {
+    case InputMode::Live:
+    case InputMode::Recording:
+        if (static_cast<USHORT>(GetAsyncKeyState(vkey)) & 0x8000)
+        {
+            active->current.SetKeyDown(vkey);
+            return true;
+        }
+        return false;
+    case InputMode::Replaying:
+        return active->current.IsKeyDown(vkey);
+    default:
+        return false;
+    }
+}
+
+void InputSystem::SetMode(InputMode inputMode)
+{
+    _ASSERT_EXPR(inputMode == InputMode::Live || inputMode == InputMode::Null, L"Use StartRecording/StartReplay");
+    active->mode = inputMode;
+    active->recording.clear();
+    active->replay.clear();
+    active->replayFrame = 0;
+    // O̓ǂݕ̎ɃEBhEbZ[WL^͓ǂ܂Ȃ
+    active->pendingEventBegin = active->eventEnd;
+}
+
+void InputSystem::StartRecording()
+{
+    active->recording.clear();
+    active->mode = InputMode::Recording;
+}
+
+std::vector<InputSnapshot> InputSystem::StopRecording()
+{
+    std::vector<InputSnapshot> frames;
+    frames.swap(active->recording);
+    if (active->mode == InputMode::Recording)
+    {
+        active->mode = InputMode::Live;
+    }
+    return frames;
+}
+
+void InputSystem::StartReplay(std::vector<InputSnapshot> frames)
+{
+    active->replay = std::move(frames);
+    active->replayFrame = 0;
+    active->mode = InputMode::Replaying;
+    active->pendingEventBegin = active->eventEnd;
+}
+
+float InputSystem::GetReplayDeltaTime()
+{
+    return active->mode == InputMode::Replaying && active->replayFrame < active->replay.size() ? active->replay[active->replayFrame].deltaTime : 0.0f;
+}
+
+namespace
+{
+    // L^t@C̐擪 : ʎq, , 1 t[̑傫, t[
+    constexpr char InputRecordingMagic[4] = { 'I', 'N', 'P', 'R' };
+    constexpr uint32_t InputRecordingVersion = 1;
+}
+
+bool InputSystem::SaveRecording(const std::filesystem::path& path, const std::vector<InputSnapshot>& frames)
+{
+    std::error_code error;
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path(), error);
+    }
+    std::ofstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        return false;
+    }
+    const uint32_t header[3] = { InputRecordingVersion, static_cast<uint32_t>(sizeof(InputSnapshot)), static_cast<uint32_t>(frames.size()) };
+    stream.write(InputRecordingMagic, sizeof(InputRecordingMagic));
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(InputSnapshot)));
+    return static_cast<bool>(stream);
+}
+
+bool InputSystem::LoadRecording(const std::filesystem::path& path, std::vector<InputSnapshot>& frames)
+{
+    std::ifstream stream(path, std::ios::binary);
+    char magic[4] = {};
+    uint32_t header[3] = {};
+    stream.read(magic, sizeof(magic));
+    stream.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!stream || memcmp(magic, InputRecordingMagic, sizeof(magic)) != 0 || header[0] != InputRecordingVersion || header[1] != sizeof(InputSnapshot))
+    {
+        return false;
+    }
+    frames.resize(header[2]);
+    stream.read(reinterpret_cast<char*>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(InputSnapshot)));
+    if (!stream)
+    {
+        frames.clear();
+        return false;
+    }
+    return true;
+}
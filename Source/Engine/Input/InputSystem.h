@@ -7,6 +7,9 @@
 #pragma comment(lib, "xinput.lib")
 
 #include <DirectXMath.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -31,6 +34,7 @@ public:
     virtual bool IsRelease() const { return (pressTime_ == 0 && oldPressTime_ > 0); }
 
     virtual InputDeviceType GetDeviceType() const { return deviceType_; }
+    int GetVirtualKey() const { return vkey_; }
 };
 
 class Keyboard :public InputKey
@@ -77,15 +81,76 @@ enum class DeviceFlags { All, KeyboardOnly, MouseOnly, GamePadOnly, KeyboardAndM
 enum class InputStateMask { None, Trigger, Release };
 enum class Direction { Up, Left, Down, Right, None };
 
+// ANV ("W", "ok" Ȃ) ̔ԍ
+//   O͓o^ 1 񂾂ԍɂāAt[̖₢킹͔ԍň (INPUT_ACTION g)
+//   ԍ͋NƕςȂ (InputSystem::Initialize 蒼Ăԍ)
+using InputActionId = uint16_t;
+constexpr InputActionId InvalidInputAction = 0xFFFF;
+
+// ANVꂽEꂽԂ̋L^
+//   Live  Recording ł̓EBhEbZ[W (WM_KEYDOWN Ȃ) ̂ŁA1 t[̒ŉėL[ԒʂɎc
+//   Q[pbhƁAReplayingENull ̎ Update ŉꂽEꂽ̂č (t[̒̓ANV̔ԍ)
+enum class InputEventType : uint8_t { Press, Release };
+struct InputEvent
+{
+    uint64_t time = 0;              // imb (steady_clock)
+    uint32_t frame = 0;             // ڂ InputSystem::Update œǂ܂邩
+    InputActionId action = InvalidInputAction;
+    InputDeviceType device = InputDeviceType::Keyboard;
+    InputEventType type = InputEventType::Press;
+};
+
+// ͂̓ǂݕ
+//   Live      : foCXǂ
+//   Recording : foCXǂŁAt[Ƃ InputSnapshot Ɏc
+//   Replaying : c InputSnapshot ǂ (foCX͓ǂ܂Ȃ)
+//   Null      : ĂȂ (HeadlessRunner œ͂^Ȃ)
+enum class InputMode { Live, Recording, Replaying, Null };
+
+// 1 t[̃foCX̓ (L^EĐp)
+// foCXǂ񂾒lAANVEE}EẌړʂ͍ĐɓvZō蒼
+struct InputSnapshot
+{
+    float deltaTime = 0.0f;         // L^̃t[
+    uint32_t keys[8] = {};          // zL[ 256 Ă邩 (GetAsyncKeyState)
+    XINPUT_GAMEPAD gamepad = {};
+    uint8_t gamepadConnected = 0;
+    int32_t mouseX = 0;             // NCAgW
+    int32_t mouseY = 0;
+
+    bool IsKeyDown(int vkey) const { return (keys[vkey >> 5] >> (vkey & 31)) & 1u; }
+    void SetKeyDown(int vkey) { keys[vkey >> 5] |= 1u << (vkey & 31); }
+};
+
 
 class InputSystem
 {
+public:
+    // o^łANV̐ (o^ɖ₢킹Ăz񂪓Ȃ悤ɍŏɊmۂ)
+    static constexpr size_t MaxActions = 256;
+    // ꂽEꂽL^c (2 ׂ̂AÂ̂㏑)
+    static constexpr size_t EventCapacity = 256;
+
 private:
-    static inline std::unordered_map<std::string, std::vector<std::unique_ptr<InputKey>>> inputKeys;
-    static inline std::unique_ptr<InputKey> directionKeys[2][4];
+    // ֐͑S static ̂܂܂ŁAԂ active  InputSystem 
+    //   i live (foCX̓) gASource/Test/InputSystemTest.cpp ͕ʂ InputSystem ɐ؂ւ live GȂ
+    static InputSystem live;
+    static InputSystem* active;
+
+    // ANV̔ԍɁA蓖ĂL[ƍ̃t[̏Ԃ
+    std::vector<std::string> actionNames;
+    std::unordered_map<std::string, InputActionId> actionIds;
+    std::vector<std::vector<std::unique_ptr<InputKey>>> actionKeys;
+    // foCXƂ 3 rbg (Ă, ꂽ, ꂽ) ܂Ƃ߂ (Update  1 񂾂)
+    std::vector<uint16_t> actionStates;
+    // zL[ANV (EBhEbZ[Wp)
+    std::vector<InputActionId> virtualKeyActions[256];
+    std::unique_ptr<InputKey> directionKeys[2][4];
 private:
     InputSystem() = default;
     virtual ~InputSystem() = default;
+    InputSystem(const InputSystem&) = delete;
+    InputSystem& operator=(const InputSystem&) = delete;
 
 public:
     //  
@@ -97,11 +162,47 @@ public:
     // XV
     static void Update(float deltaTime);
 
-    // ͏Ԃ̎擾
-    static bool GetInputState(const std::string& action, InputStateMask state = InputStateMask::None, DeviceFlags flag = DeviceFlags::All);
+    // ANV̔ԍo^ (OȂ瓯ԍԂAĂяoꏊƂ 1 񂾂ACXbhĂ)
+    static InputActionId RegisterAction(const std::string& action);
+    // o^ς݂̃ANV̔ԍ ( InvalidInputAction)
+    static InputActionId FindAction(const std::string& action);
+    static const std::string& GetActionName(InputActionId action);
+    static size_t GetActionCount() { return active->actionNames.size(); }
+
+    // ͏Ԃ̎擾 (Update ōԂ)
+    static bool GetInputState(InputActionId action, InputStateMask state = InputStateMask::None, DeviceFlags flag = DeviceFlags::All)
+    {
+        return action < active->actionStates.size() && (active->actionStates[action] & GetStateMask(state, flag)) != 0;
+    }
+    // Oň (񖼑ÕnbVvẐŁAt[Ăԏ INPUT_ACTION g)
+    static bool GetInputState(const std::string& action, InputStateMask state = InputStateMask::None, DeviceFlags flag = DeviceFlags::All)
+    {
+        return GetInputState(FindAction(action), state, flag);
+    }
+
+    // Ԃ̃rbg : foCX (Keyboard, Mouse, Gamepad) Ƃ 3 rbg (Ă, ꂽ, ꂽ)
+    static constexpr uint16_t GetStateMask(InputStateMask state, DeviceFlags flag)
+    {
+        // DeviceFlags ̏ɁA܂ރfoCX́uĂṽrbg
+        constexpr uint16_t devices[] = { 0b001001001, 0b000000001, 0b000001000, 0b001000000, 0b000001001, 0b001000001, 0b001001000 };
+        return static_cast<uint16_t>(devices[static_cast<size_t>(flag)] << static_cast<int>(state));
+    }
+
+    // ---- ꂽEꂽ ----
+    // EBhEbZ[WĂ (Framework::handle_message)
+    static void OnKeyMessage(int vkey, bool isDown);
+    // ̃t[ (Ō Update) œǂ񂾋L^ [GetFrameEventBegin(), GetEventEnd()) ̒ʂԍ
+    static uint64_t GetFrameEventBegin() { return active->frameEventBegin; }
+    static uint64_t GetEventEnd() { return active->eventEnd; }
+    // ʂԍ̋L^ (㏑ĎcĂȂ nullptr)
+    static const InputEvent* FindEvent(uint64_t sequence)
+    {
+        return sequence < active->eventEnd && active->eventEnd - sequence <= EventCapacity ? &active->events[sequence & (EventCapacity - 1)] : nullptr;
+    }
+    static uint32_t GetFrameIndex() { return active->frameIndex; }
 
     // XeBbNԂ̎擾
-    static float GetAxis(Side side, Axis axis) { return mAxis[static_cast<size_t>(side)][static_cast<size_t>(axis)]; }
+    static float GetAxis(Side side, Axis axis) { return active->mAxis[static_cast<size_t>(side)][static_cast<size_t>(axis)]; }
     static int GetAxisRaw(Side side, Axis axis) { return static_cast<int>(round(GetAxis(side, axis))); }
     static Direction GetAxisDirection()
     {
@@ -124,38 +225,58 @@ public:
     }
 
     // }EXJ[\̈ړʎ擾
-    static void GetMouseDelta(int& x, int& y) { (x = mousePositionX[0] - mousePositionX[1], y = mousePositionY[0] - mousePositionY[1]); }
+    static void GetMouseDelta(int& x, int& y) { (x = active->mousePositionX[0] - active->mousePositionX[1], y = active->mousePositionY[0] - active->mousePositionY[1]); }
 
     // }EXJ[\XW擾
-    static int GetMousePositionX() { return mousePositionX[0]; }
+    static int GetMousePositionX() { return active->mousePositionX[0]; }
 
     // }EXJ[\YW擾
-    static int GetMousePositionY() { return mousePositionY[0]; }
+    static int GetMousePositionY() { return active->mousePositionY[0]; }
 
     // }EXJ[\̈ʒu擾
     static DirectX::XMFLOAT2 GetMousePosition()
     {
         DirectX::XMFLOAT2 mousePosition;
-        mousePosition.x = static_cast<float>(mousePositionX[0]);
-        mousePosition.y = static_cast<float>(mousePositionY[0]);
+        mousePosition.x = static_cast<float>(active->mousePositionX[0]);
+        mousePosition.y = static_cast<float>(active->mousePositionY[0]);
         return mousePosition;
     }
 
     // Õ}EXJ[\XW擾
-    static int GetOldMousePositionX() { return mousePositionX[1]; }
+    static int GetOldMousePositionX() { return active->mousePositionX[1]; }
 
     // Õ}EXJ[\YW擾
-    static int GetOldMousePositionY() { return mousePositionY[1]; }
+    static int GetOldMousePositionY() { return active->mousePositionY[1]; }
 
     // J[\\Ă邩
-    static bool IsCursolVisible() { return cursolVisible; }
+    static bool IsCursolVisible() { return active->cursolVisible; }
+
+    // ---- ͂̋L^ƍĐ ----
+    static InputMode GetMode() { return active->mode; }
+    // Live  Null ɂ (L^EĐ͎~߂)
+    static void SetMode(InputMode inputMode);
+    //  Update t[Ƃ̓͂L^
+    static void StartRecording();
+    // L^~߂āAL^͂Ԃ
+    static std::vector<InputSnapshot> StopRecording();
+    static size_t GetRecordedFrameCount() { return active->recording.size(); }
+    //  Update L^͂Đ (Ō܂ōĐ牽ĂȂԂɂȂ)
+    static void StartReplay(std::vector<InputSnapshot> frames);
+    static bool IsReplayFinished() { return active->mode == InputMode::Replaying && active->replayFrame >= active->replay.size(); }
+    static size_t GetReplayFrame() { return active->replayFrame; }
+    // Đ̃t[ŋL^̃t[ (ĐłȂ 0)
+    static float GetReplayDeltaTime();
+
+    // L^͂̃t@C (oCi)
+    static bool SaveRecording(const std::filesystem::path& path, const std::vector<InputSnapshot>& frames);
+    static bool LoadRecording(const std::filesystem::path& path, std::vector<InputSnapshot>& frames);
 
 private:
 
     // J[\̕\\ύX
     static void SetCursolVisible(bool visible)
     {
-        cursolVisible = visible;
+        active->cursolVisible = visible;
         int count = 0;
 
         do
@@ -166,30 +287,58 @@ private:
 
 public:
     // Q[pbhڑĂ邩
-    static bool IsGamepadConnected() { return isGamePadConnected; }
+    static bool IsGamepadConnected() { return active->isGamePadConnected; }
 
     // ANeBuȃfoCX擾
-    static InputDeviceType GetActiveDevice() { return activeDevice; }
+    static InputDeviceType GetActiveDevice() { return active->activeDevice; }
 
 private:
-    static inline InputDeviceType activeDevice = InputDeviceType::Keyboard;
+    InputDeviceType activeDevice = InputDeviceType::Keyboard;
 
     friend class Gamepad;
-    static XINPUT_STATE GetXInputState() { return state; }
-
-    static inline float mAxis[2][2];
-    static inline XINPUT_STATE state;
-    static inline DeadZoneMode deadZoneMode = DeadZoneMode::Circular;
-    static inline int slot = 0;
-
-    static inline int mousePositionX[2];
-    static inline int mousePositionY[2];
-
-    static inline bool isGamePadConnected = false;
-
-    static inline bool cursolLock = false;
-    static inline bool cursolVisible = true;
+    friend class InputKey;
+    friend class InputSystemTest;
+    static XINPUT_STATE GetXInputState() { return active->xinputState; }
+    // zL[Ă邩 (L^EĐʂ)
+    static bool IsKeyDown(int vkey);
+
+    // ANVɃL[蓖Ă (Initialize Ă)
+    static void BindKey(const std::string& action, std::unique_ptr<InputKey> key);
+    // L[̏ԂANV̏Ԃ (Update Ă)
+    static void UpdateActionStates();
+    static void PushEvent(InputActionId action, InputDeviceType device, InputEventType type, uint64_t time, uint32_t frame);
+    // ȑO̖₢킹 (L[ 1 ׂ)AvƊmFp
+    static bool QueryKeys(InputActionId action, InputStateMask state, DeviceFlags flag);
+
+    std::array<InputEvent, EventCapacity> events;
+    uint64_t eventEnd = 0;
+    uint64_t frameEventBegin = 0;
+    uint64_t pendingEventBegin = 0;   //  Update œǂދL^̎n܂
+    uint32_t frameIndex = 0;
+
+    InputMode mode = InputMode::Live;
+    InputSnapshot current;                // ̃t[̓
+    std::vector<InputSnapshot> recording;
+    std::vector<InputSnapshot> replay;
+    size_t replayFrame = 0;
+
+    float mAxis[2][2];
+    XINPUT_STATE xinputState;
+    DeadZoneMode deadZoneMode = DeadZoneMode::Circular;
+    int slot = 0;
+
+    int mousePositionX[2];
+    int mousePositionY[2];
+
+    bool isGamePadConnected = false;
+
+    bool cursolLock = false;
+    bool cursolVisible = true;
 
 };
 
+// ANV̔ԍĂяoꏊƂ 1 񂾂o^ĕԂ
+// g : if (InputSystem::GetInputState(INPUT_ACTION("W"))) { ... }
+#define INPUT_ACTION(name) ([]() { static const InputActionId inputAction = InputSystem::RegisterAction(name); return inputAction; }())
+
 #endif // INPUT_SYSTEM_H
\ No newline at end of file
@@ -0,0 +1,239 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+#include "Engine/Debug/Assert.h"
+#include "Engine/Debug/Profiler.h"
+
+void JobSystem::Initialize(size_t workerCount)
+{
+    if (!workers.empty())
+    {
+        return;
+    }
+    if (workerCount == 0)
+    {
+        const size_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+    isStopping = false;
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(&JobSystem::WorkerThread, this, i);
+    }
+}
+
+void JobSystem::Finalize()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+    condition.notify_all();
+    for (std::thread& worker : workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+void JobSystem::Submit(std::function<void()> job, const void* owner)
+{
+    // ɎgꂽɃ[J[
+    std::call_once(initializeFlag, [this]()
+        {
+            if (workers.empty())
+            {
+                Initialize();
+            }
+        });
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({ std::move(job), owner });
+    }
+    condition.notify_one();
+}
+
+bool JobSystem::ExecuteOne(const void* owner)
+{
+    std::function<void()> job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find_if(jobs.begin(), jobs.end(), [owner](const QueuedJob& queued) { return queued.owner == owner; });
+        if (it == jobs.end())
+        {
+            return false;
+        }
+        job = std::move(it->function);
+        jobs.erase(it);
+    }
+    job();
+    return true;
+}
+
+void JobSystem::WorkerThread(size_t index)
+{
+    Profiler::SetThreadName(("Job Worker " + std::to_string(index)).c_str());
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return isStopping || !jobs.empty(); });
+            // IL[ɎcĂWu͎sĂ甲
+            if (jobs.empty())
+            {
+                return;
+            }
+            job = std::move(jobs.front().function);
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+JobGraph::~JobGraph()
+{
+    if (jobSystem)
+    {
+        Wait();
+    }
+    // Ō̃WuI[J[ mutex 𗣂܂ő҂Ăj
+    std::lock_guard<std::mutex> lock(mutex);
+}
+
+JobGraph::JobId JobGraph::Add(const std::string& name, std::function<void()> function, std::initializer_list<JobId> dependencies, Lane lane, float weight)
+{
+    return Add(name, std::move(function), std::vector<JobId>(dependencies), lane, weight);
+}
+
+JobGraph::JobId JobGraph::Add(const std::string& name, std::function<void()> function, const std::vector<JobId>& dependencies, Lane lane, float weight)
+{
+    _ASSERT_EXPR(jobSystem == nullptr, L"JobGraph::Add must be called before Run");
+    const JobId id = jobs.size();
+    Job& job = jobs.emplace_back();
+    job.name = name;
+    job.function = std::move(function);
+    job.lane = lane;
+    job.weight = (std::max)(weight, 0.0f);
+    for (JobId dependency : dependencies)
+    {
+        _ASSERT_EXPR(dependency < id, L"A job can only depend on jobs added before it");
+        jobs[dependency].successors.push_back(id);
+        ++job.remainingDependencies;
+    }
+    totalWeight += job.weight;
+    return id;
+}
+
+void JobGraph::Run(JobSystem& jobSystem)
+{
+    _ASSERT_EXPR(this->jobSystem == nullptr, L"JobGraph::Run has already been called");
+    this->jobSystem = &jobSystem;
+    // s remainingDependencies ̂ŐɍW߂Ă
+    std::vector<JobId> roots;
+    for (JobId id = 0; id < jobs.size(); ++id)
+    {
+        if (jobs[id].remainingDependencies.load() == 0)
+        {
+            roots.push_back(id);
+        }
+    }
+    for (JobId id : roots)
+    {
+        Schedule(id);
+    }
+}
+
+void JobGraph::Schedule(JobId id)
+{
+    if (jobs[id].lane == Lane::Owner)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ownerJobs.push_back(id);
+        }
+        condition.notify_all();
+    }
+    else
+    {
+        jobSystem->Submit([this, id]() { Execute(id); }, this);
+    }
+}
+
+void JobGraph::Execute(JobId id)
+{
+    Job& job = jobs[id];
+    if (job.function)
+    {
+        PROFILE_ZONE("JobGraph::Execute", "job");
+        job.function();
+        // Lv`
+        job.function = nullptr;
+    }
+    for (JobId successor : job.successors)
+    {
+        if (--jobs[successor].remainingDependencies == 0)
+        {
+            Schedule(successor);
+        }
+    }
+    finishedWeight.fetch_add(job.weight);
+    // Wait Ȃ悤ɃbN̒ŐĒʒm
+    // ҂Ă鑤͊bN̒łȂ̂ŁÃbN𗣂܂ŃOt͔jȂ
+    std::lock_guard<std::mutex> lock(mutex);
+    ++finishedCount;
+    condition.notify_all();
+}
+
+bool JobGraph::IsFinished() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return finishedCount.load() == jobs.size();
+}
+
+bool JobGraph::Pump()
+{
+    _ASSERT_EXPR(jobSystem, L"JobGraph::Run has not been called");
+    for (;;)
+    {
+        JobId id;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ownerJobs.empty())
+            {
+                break;
+            }
+            id = ownerJobs.front();
+            ownerJobs.pop_front();
+        }
+        Execute(id);
+    }
+    return IsFinished();
+}
+
+void JobGraph::Wait()
+{
+    while (!Pump())
+    {
+        // [J[SčǂĂĂiނ悤ɁA҂ĂԂ͂̃Ot̃Wu`
+        if (jobSystem->ExecuteOne(this))
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]() { return !ownerJobs.empty() || finishedCount.load() == jobs.size(); });
+    }
+}
+
+float JobGraph::Progress() const
+{
+    if (jobs.empty() || totalWeight <= 0.0f)
+    {
+        return IsFinished() ? 1.0f : 0.0f;
+    }
+    return (std::min)(finishedWeight.load() / totalWeight, 1.0f);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// [J[Xbh̃v[
+// JobGraph ˑ֌W̉Wu
+class JobSystem
+{
+public:
+    static JobSystem& Instance()
+    {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // workerCount  0 ȂRA - 1 (Œ 1)
+    void Initialize(size_t workerCount = 0);
+    void Finalize();
+
+    // owner :  (JobGraph Ȃ)BExecuteOne Ŏ̃Wu`̂Ɏg
+    void Submit(std::function<void()> job, const void* owner = nullptr);
+    // ҂ĂXbhL[ɂ owner ̃Wu 1 s ( false)
+    // ̎̃Wu͎sȂ̂ŁA҂ĂԂɊ֌W̖Ot֓荞܂Ȃ
+    bool ExecuteOne(const void* owner);
+
+    size_t WorkerCount() const { return workers.size(); }
+
+    ~JobSystem() { Finalize(); }
+
+private:
+    JobSystem() = default;
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void WorkerThread(size_t index);
+
+    struct QueuedJob
+    {
+        std::function<void()> function;
+        const void* owner = nullptr;
+    };
+
+    std::vector<std::thread> workers;
+    // ŏ Submit ̃Xbh瓯ɗĂ[J[x
+    std::once_flag initializeFlag;
+    std::deque<QueuedJob> jobs;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isStopping = false;
+};
+
+// ˑ֌W̃WȕW܂
+// Add ŃWuo^Ă Run  (Run  Add łȂ)
+class JobGraph
+{
+public:
+    using JobId = size_t;
+
+    enum class Lane
+    {
+        Worker, // JobSystem ̃[J[Ŏs
+        Owner,  // Pump / Wait Ă񂾃XbhŎs (GPU ւ̃Abv[hȂ 1 {ɂ܂Ƃ߂)
+    };
+
+    JobGraph() = default;
+    JobGraph(const JobGraph&) = delete;
+    JobGraph& operator=(const JobGraph&) = delete;
+    // s̃WucĂԂ͔jłȂ
+    ~JobGraph();
+
+    // weight : ȉd (t@C̑傫Ȃ)
+    JobId Add(const std::string& name, std::function<void()> function, std::initializer_list<JobId> dependencies = {}, Lane lane = Lane::Worker, float weight = 1.0f);
+    JobId Add(const std::string& name, std::function<void()> function, const std::vector<JobId>& dependencies, Lane lane = Lane::Worker, float weight = 1.0f);
+
+    // ˑ̖Wusn߂
+    void Run(JobSystem& jobSystem = JobSystem::Instance());
+    // Owner [̎słWuSĎs (SďIĂ true)
+    bool Pump();
+    // SďI܂ Owner [̃WusȂ҂
+    void Wait();
+
+    // Ō̃WuI[J[bN𗣂łȂ true ɂȂȂ (true ȂjĂ悢)
+    bool IsFinished() const;
+    // 0 - 1 (IWȕd݂̊)
+    float Progress() const;
+    size_t JobCount() const { return jobs.size(); }
+    size_t FinishedCount() const { return finishedCount.load(); }
+
+private:
+    struct Job
+    {
+        std::string name;
+        std::function<void()> function;
+        std::vector<JobId> successors;
+        std::atomic<int> remainingDependencies = 0;
+        Lane lane = Lane::Worker;
+        float weight = 1.0f;
+    };
+
+    void Schedule(JobId id);
+    void Execute(JobId id);
+
+    // WũAhXςȂ悤 deque ɒu
+    std::deque<Job> jobs;
+    float totalWeight = 0.0f;
+    std::atomic<float> finishedWeight = 0.0f;
+    std::atomic<size_t> finishedCount = 0;
+    JobSystem* jobSystem = nullptr;
+
+    // Owner [̎s҂
+    std::deque<JobId> ownerJobs;
+    // finishedCount ̑ƒʒm͂̃bN̒ōŝŁA̓bN̒Ō
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+};
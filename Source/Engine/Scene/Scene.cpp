@@ -1,8 +1,11 @@
 #include "Scene.h"
 
 #include <chrono>
+#include <sstream>
 
 #include "Graphics/Resource/Texture.h"
+#include "Engine/Asset/AssetLoader.h"
+#include "Engine/Debug/Logger.h"
 
 bool Scene::_update(ID3D11DeviceContext* immediateContext, float deltaTime)
 {
@@ -39,6 +42,7 @@ bool Scene::_update(ID3D11DeviceContext* immediateContext, float deltaTime)
         if (_preload_scene)
         {
             _next_scene = std::move(_preload_scene);
+            _preload_assets.reset();
         }
 
         // ̃V[܂ĂȂꍇAs
@@ -54,6 +58,8 @@ bool Scene::_update(ID3D11DeviceContext* immediateContext, float deltaTime)
             // ActorManager ̐
             _next_scene->actorManager_ = std::make_unique<ActorManager>();
             _next_scene->actorManager_->SetOwnerScene(_next_scene.get());
+            // V[ŎgAZbgɓǂݍ
+            _load_assets(_next_scene.get(), _request_assets(_next_scene.get(), device.Get()));
             // V[̏ifoCXAʃTCYAvpeBnj
             _next_scene->Initialize(device.Get(), static_cast<UINT64>(viewport.Width), static_cast<UINT64>(viewport.Height), _payload);
             // V[̏Ԃuς݁vɕύX
@@ -96,11 +102,15 @@ bool Scene::_async_preload_scene(ID3D11Device* device, UINT64 width, UINT height
         // v[hpV[̏Ԃuҋ@iawaitingjvȂ񓯊Ń[hJn
         if (_preload_scene->State() == SCENE_STATE::awaiting)
         {
-            _future = std::async(std::launch::async, [device, name, width, height]() {
+            // i\ł悤ɁAǂݍރAZbg̓o^͂̃Xbhōs
+            _preload_assets = _request_assets(_preload_scene.get(), device);
+            _future = std::async(std::launch::async, [device, name, width, height, assets = _preload_assets]() {
                 // ActorManager ̐
                 _preload_scene->actorManager_ = std::make_unique<ActorManager>();
                 _preload_scene->actorManager_->SetOwnerScene(_preload_scene.get());
                 _preload_scene->State(SCENE_STATE::initializing);// Ԃuvɐݒ
+                // AZbg[J[ŕɓǂݍ݁AGPU ւ̃Abv[h͂̃Xbhōs
+                _load_assets(_preload_scene.get(), assets);
                 bool success = _preload_scene->Initialize(device, width, height, {});
                 _preload_scene->State(SCENE_STATE::initialized);// Ԃuvɐݒ
                 return success;
@@ -111,4 +121,38 @@ bool Scene::_async_preload_scene(ID3D11Device* device, UINT64 width, UINT height
     return _preload_scene->State() > SCENE_STATE::initializing;
 }
 
+float Scene::_preload_progress()
+{
+    if (!_preload_scene || _preload_scene->State() >= SCENE_STATE::initialized)
+    {
+        return 1.0f;
+    }
+    // AZbg̓ǂݍ݂ 9 AInitialize cƂ
+    const float assetProgress = _preload_assets && _preload_assets->RequestCount() > 0 ? _preload_assets->Progress() : 1.0f;
+    return assetProgress * 0.9f;
+}
+
+std::shared_ptr<AssetLoader> Scene::_request_assets(Scene* scene, ID3D11Device* device)
+{
+    std::shared_ptr<AssetLoader> assets = std::make_shared<AssetLoader>(device);
+    scene->RequestAssets(*assets);
+    return assets;
+}
 
+void Scene::_load_assets(Scene* scene, const std::shared_ptr<AssetLoader>& assets)
+{
+    if (assets->RequestCount() == 0)
+    {
+        return;
+    }
+    assets->Start();
+    assets->Wait();
+    // Logger  1 s󂯎̂ōsƂɕďo
+    std::istringstream report(assets->Report());
+    std::string line;
+    while (std::getline(report, line))
+    {
+        Logger::Log(line.c_str());
+    }
+    scene->assetLoader_ = assets;
+}
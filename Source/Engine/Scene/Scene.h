@@ -17,6 +17,8 @@
 
 #include "Core/ActorManager.h"
 
+class AssetLoader;
+
 //V[̏Ԃ\񋓌^
 enum class SCENE_STATE
 {
@@ -67,6 +69,8 @@ public:
 private:
     // z֐FV[̏
     virtual bool Initialize(ID3D11Device* device, UINT64 width, UINT height, const std::unordered_map<std::string, std::string>& props) = 0;
+    // z֐FInitialize ̑OɕœǂݍރAZbgo^
+    virtual void RequestAssets(AssetLoader& loader) {}
     //V[n܂Ƃ
     virtual void Start() {};
     // z֐FV[̍XV
@@ -111,6 +115,7 @@ public:
         _current_scene->actorManager_ = std::make_unique<ActorManager>();
         _current_scene->actorManager_->SetOwnerScene(_current_scene.get());
 
+        _load_assets(_current_scene.get(), _request_assets(_current_scene.get(), device));
         _current_scene->Initialize(device, width, height, props);
         if (!_current_scene->GetActorManager())
         {
@@ -232,6 +237,14 @@ public:
     }
     // 񓯊ŃV[v[h
     static bool _async_preload_scene(ID3D11Device* device, UINT64 width, UINT height, const std::string& name);
+    // v[h̐i݋ (0 - 1)
+    static float _preload_progress();
+
+    // V[o^Ă邩
+    static bool _is_enrolled(const std::string& name)
+    {
+        return _reflections().find(name) != _reflections().end();
+    }
 
 
 private:
@@ -273,6 +286,12 @@ private:
     static inline std::future<bool> _future;
     // V[ɓnǉiL[ƒl̃}bvj
     static inline std::unordered_map<std::string, std::string> _payload;
+    // v[h̃V[̃AZbg (i̕\pACXbhŏ)
+    static inline std::shared_ptr<AssetLoader> _preload_assets;
+
+    // RequestAssets œo^ꂽAZbgWuOtœǂݍ (GPU ւ̃Abv[h͌ĂяoXbhōs)
+    static std::shared_ptr<AssetLoader> _request_assets(Scene* scene, ID3D11Device* device);
+    static void _load_assets(Scene* scene, const std::shared_ptr<AssetLoader>& assets);
 
 protected:
     // : ÓI̖邽߂̎dg
@@ -289,6 +308,8 @@ protected:
 
 private:
     std::unique_ptr<ActorManager> actorManager_;
+    // RequestAssets œǂݍ񂾃AZbg (LLbV͎QƂȂ̂ŁAV[I܂łŕێ)
+    std::shared_ptr<AssetLoader> assetLoader_;
 };
 
 
@@ -1,13 +1,48 @@
 #include "SceneBase.h"
 
+#include <filesystem>
+
 #include "ImGuizmo.h"
 
+#include "Components/Audio/AudioSourceComponent.h"
+#include "Engine/Asset/AssetLoader.h"
+#include "Engine/Debug/Logger.h"
+#include "Engine/Debug/Profiler.h"
 #include "Engine/Input/InputSystem.h"
 #include "Graphics/PostProcess/BloomEffect.h"
 #include "Graphics/PostProcess/FogEffect.h"
 #include "Graphics/PostProcess/SSAOEffect.h"
 #include "Graphics/PostProcess/SSREffect.h"
-
+#include "Graphics/Renderer/MeshletCulling.h"
+#include "Graphics/Renderer/ShapeRenderer.h"
+#include "Graphics/Resource/InterleavedGltfModel.h"
+#include "Graphics/Sprite/TextureAtlas.h"
+#include "Widgets/Canvas.h"
+#include "Widgets/Image.h"
+#include "Widgets/Mask.h"
+#include "Widgets/ObjectManager.h"
+
+namespace
+{
+    // s̃|[g 1 sOɏo
+    void LogLines(const std::string& text)
+    {
+        size_t begin = 0;
+        while (begin < text.size())
+        {
+            size_t end = text.find('\n', begin);
+            if (end == std::string::npos)
+            {
+                end = text.size();
+            }
+            if (end > begin)
+            {
+                Logger::Log(text.substr(begin, end - begin).c_str());
+            }
+            begin = end + 1;
+        }
+    }
+}
 
 bool SceneBase::Initialize(ID3D11Device* device, UINT64 width, UINT height, const std::unordered_map<std::string, std::string>& props)
 {
@@ -80,8 +115,10 @@ void SceneBase::Update(float deltaTime)
     sceneCBuffer->data.elapsedTime += deltaTime;
     sceneCBuffer->data.deltaTime = deltaTime;
 
+    UpdateAudioListener();
+
 #ifdef _DEBUG
-    if (InputSystem::GetInputState("F8", InputStateMask::Trigger))
+    if (InputSystem::GetInputState(INPUT_ACTION("F8"), InputStateMask::Trigger))
     {
         CameraManager::ToggleCamera();
     }
@@ -103,6 +140,37 @@ bool SceneBase::OnSizeChanged(ID3D11Device* device, UINT64 width, UINT height)
     return true;
 }
 
+void SceneBase::PrepareVisibility(SceneRenderer& renderer)
+{
+    culledRenderer_ = &renderer;
+    auto camera = CameraManager::GetCurrentCamera();
+    if (!camera)
+    {
+        renderer.ClearVisibility();
+        return;
+    }
+    ViewConstants data = camera->GetViewConstants();
+
+    // ẽpXƓJXP[h̍sɋ߂Ă
+    std::vector<DirectX::XMFLOAT4X4> cascadeViewProjections;
+    if (enableCascadedShadowMaps)
+    {
+        cascadedShadowMaps->UpdateCascades(data.view, data.projection, lightDirection, criticalDepthValue);
+        cascadeViewProjections = cascadedShadowMaps->GetCascadedMatrices();
+    }
+    renderer.PrepareVisibility(data.viewProjection, cascadeViewProjections);
+}
+
+void SceneBase::UpdateAudioListener()
+{
+    auto camera = CameraManager::GetCurrentCamera();
+    if (!camera)
+    {
+        return;
+    }
+    Audio::SetListener(camera->GetViewConstants().invView);
+}
+
 void SceneBase::UpdateConstantBuffer(ID3D11DeviceContext* immediateContext)
 {
     RenderState::BindSamplerStates(immediateContext);
@@ -247,6 +315,195 @@ void SceneBase::DrawSceneSettingsTab()
             shaderCBuffer->data.colorizeCascadedLayer = colorize ? 1 : 0;
         }
     }
+
+    // -------------------------
+    // JO
+    // -------------------------
+    if (ImGui::CollapsingHeader("Visibility Culling"))
+    {
+        if (culledRenderer_)
+        {
+            ImGui::Checkbox("Enable Culling", &culledRenderer_->enableCulling);
+            ImGui::DragFloat("Skinned Bounds Margin", &culledRenderer_->skinnedBoundsMargin, 0.01f, 0.0f, 10.0f);
+            // LOD (ʏ̌덷ŒiI)
+            ImGui::Checkbox("Enable LOD", &culledRenderer_->enableLod);
+            ImGui::DragFloat("LOD Pixel Error", &culledRenderer_->lodPixelError, 0.05f, 0.1f, 16.0f);
+            ImGui::SliderFloat("LOD Hysteresis", &culledRenderer_->lodHysteresis, 0.0f, 0.9f);
+            const std::array<size_t, MeshSimplifier::MaxLodCount>& lodHistogram = culledRenderer_->GetLodHistogram();
+            ImGui::Text("LOD0 %zu / LOD1 %zu / LOD2 %zu / LOD3 %zu", lodHistogram[0], lodHistogram[1], lodHistogram[2], lodHistogram[3]);
+            // bVbg (傫ȃob`bV̌򂾂`)
+            ImGui::Checkbox("Enable Meshlet Culling", &culledRenderer_->enableMeshletCulling);
+            ImGui::SliderInt("Meshlet Max Ranges", &culledRenderer_->meshletMaxRanges, 1, 128);
+            ImGui::TextWrapped("Meshlets : %s", culledRenderer_->GetMeshletStatistics().ToString().c_str());
+            const VisibilityCulling& visibility = culledRenderer_->GetVisibility();
+            ImGui::TextUnformatted(visibility.Report().c_str());
+        }
+        else
+        {
+            ImGui::TextUnformatted("PrepareVisibility is not called in this scene.");
+        }
+    }
+
+    // -------------------------
+    // `L[ (\[gL[ƃXe[g̐؂ւ)
+    // -------------------------
+    if (ImGui::CollapsingHeader("Render Queue"))
+    {
+        if (culledRenderer_)
+        {
+            // oɑSĐݒ肷ꍇƁAבւēXe[gȂꍇ̔r
+            const RenderQueue::SubmitStatistics statistics = culledRenderer_->GetRenderQueue().Measure();
+            ImGui::TextUnformatted(statistics.ToString().c_str());
+            // ob`bVE}eA̓CX^X`ɂ܂Ƃ߂ (inst : ܂Ƃ߂`, items : ܂Ƃ߂ACe)
+            ImGui::Checkbox("Automatic Instancing", &culledRenderer_->enableInstancing);
+            ImGui::TextUnformatted(culledRenderer_->GetInstanceBuffer().GetStatistics().ToString().c_str());
+        }
+    }
+
+    // -------------------------
+    // CPU vt@C (ԂƂ̒߂ p50/p95/p99  Chrome ̃g[X̏o)
+    // -------------------------
+    if (ImGui::CollapsingHeader("CPU Profiler"))
+    {
+        bool enabled = Profiler::IsEnabled();
+        if (ImGui::Checkbox("Enable", &enabled))
+        {
+            Profiler::SetEnabled(enabled);
+        }
+        ImGui::TextUnformatted(Profiler::Report().c_str());
+        for (const char* counter : { "Actors", "Drawables", "Camera visible" })
+        {
+            const std::vector<float> history = Profiler::GetCounterHistory(counter);
+            if (!history.empty())
+            {
+                ImGui::PlotLines(counter, history.data(), static_cast<int>(history.size()), 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+            }
+        }
+        if (ImGui::Button("Export Chrome trace"))
+        {
+            const std::filesystem::path path = ".\\Data\\Profile\\trace.json";
+            if (Profiler::ExportChromeTrace(path))
+            {
+                Logger::Log(("Profiler : exported " + path.string()).c_str());
+            }
+            else
+            {
+                Logger::Warning(("Profiler : failed to export " + path.string()).c_str());
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset"))
+        {
+            Profiler::Reset();
+        }
+    }
+
+    // -------------------------
+    // O (Oobt@̃OƏ݂̑)
+    // -------------------------
+    if (ImGui::CollapsingHeader("Logger"))
+    {
+        Logger::RenderIMGUI();
+    }
+
+    // -------------------------
+    // ʉ̐̃v[ (Audio::PlayOneShot)
+    // -------------------------
+    if (ImGui::CollapsingHeader("Audio Voices"))
+    {
+        if (const AudioVoicePool* pool = Audio::GetVoicePool())
+        {
+            const AudioVoicePool::Statistics& statistics = pool->GetStatistics();
+            ImGui::Text("voices %zu / %u, playing BGM %zu SE %zu (peak %zu)", statistics.voices, pool->GetBudget().maxVoices,
+                pool->GetPlayingCount(BGM), pool->GetPlayingCount(SE), statistics.peakPlaying);
+            ImGui::Text("plays %zu : created %zu, reused %zu, stolen %zu, rejected %zu, evicted %zu", statistics.plays,
+                statistics.created, statistics.reused, statistics.stolen, statistics.rejected, statistics.evicted);
+        }
+        if (const AudioSpatializer* spatializer = Audio::GetSpatializer())
+        {
+            const AudioSpatializer::Statistics& statistics = spatializer->GetStatistics();
+            ImGui::Text("3D emitters %zu : real %zu / %u, audible %zu (%.1f us)", statistics.emitters, statistics.real,
+                spatializer->GetSettings().maxRealVoices, statistics.audible, statistics.microseconds);
+            ImGui::Text("started %zu, finished %zu, virtualized %zu, restored %zu, rejected %zu", statistics.started, statistics.finished,
+                statistics.virtualized, statistics.restored, statistics.rejected);
+        }
+    }
+
+    // -------------------------
+    // ͂̋L^ƍĐ (L^t@C HeadlessRunner  --replay ōĐł)
+    // -------------------------
+    if (ImGui::CollapsingHeader("Input Record / Replay"))
+    {
+        static const char* modeNames[] = { "Live", "Recording", "Replaying", "Null" };
+        const std::filesystem::path path = ".\\Data\\Replay\\input.rec";
+        ImGui::Text("mode : %s, recorded %zu frames, replay frame %zu", modeNames[static_cast<int>(InputSystem::GetMode())],
+            InputSystem::GetRecordedFrameCount(), InputSystem::GetReplayFrame());
+        if (InputSystem::GetMode() != InputMode::Recording)
+        {
+            if (ImGui::Button("Start recording"))
+            {
+                InputSystem::StartRecording();
+            }
+        }
+        else if (ImGui::Button("Stop and save"))
+        {
+            const std::vector<InputSnapshot> frames = InputSystem::StopRecording();
+            if (InputSystem::SaveRecording(path, frames))
+            {
+                Logger::Log(("InputSystem : saved " + path.string()).c_str());
+            }
+            else
+            {
+                Logger::Warning(("InputSystem : failed to save " + path.string()).c_str());
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Replay"))
+        {
+            std::vector<InputSnapshot> frames;
+            if (InputSystem::LoadRecording(path, frames))
+            {
+                InputSystem::StartReplay(std::move(frames));
+            }
+            else
+            {
+                Logger::Warning(("InputSystem : failed to load " + path.string()).c_str());
+            }
+        }
+        if (InputSystem::GetMode() == InputMode::Replaying)
+        {
+            ImGui::SameLine();
+            if (ImGui::Button(InputSystem::IsReplayFinished() ? "Back to live" : "Stop replay"))
+            {
+                InputSystem::SetMode(InputMode::Live);
+            }
+        }
+        ImGui::Text("actions : %zu, events this frame : %llu", InputSystem::GetActionCount(),
+            static_cast<unsigned long long>(InputSystem::GetEventEnd() - InputSystem::GetFrameEventBegin()));
+    }
+
+    // -------------------------
+    // fobO` (ShapeRenderer ̂܂Ƃߕ`)
+    // -------------------------
+    if (ImGui::CollapsingHeader("Debug Draw"))
+    {
+        ImGui::Checkbox("Batch Debug Draw", &ShapeRenderer::enableBatching);
+        // Oɂ GUI oĂ (1 t[)  Flush ̍v
+        ImGui::TextUnformatted(ShapeRenderer::GetFlushStatistics().ToString().c_str());
+        ShapeRenderer::ResetFlushStatistics();
+    }
+
+    // -------------------------
+    // UI (eLXg̕ו̃LbVELoXƂ̂܂Ƃߕ`EKw̍XVEAgX)
+    // -------------------------
+    if (ImGui::CollapsingHeader("UI"))
+    {
+        ImGui::Checkbox("Batch UI per Canvas", &Canvas::enableBatching);
+        ImGui::Checkbox("Cache RectTransform Layout", &RectTransform::enableLayoutCache);
+        ImGui::Checkbox("Draw Images from Texture Atlas", &Image::enableAtlas);
+        ImGui::Checkbox("Clip Masks on CPU", &Mask::enableCpuClip);
+        ImGui::Text("Atlas %s", TextureAtlas::Get().GetStatistics().ToString().c_str());
+    }
 }
 
 
@@ -280,6 +537,12 @@ void SceneBase::DrawInspector()
             ImGui::EndTabItem();
         }
 
+        if (ImGui::BeginTabItem("Assets"))
+        {
+            DrawAssetsTab();
+            ImGui::EndTabItem();
+        }
+
         ImGui::EndTabBar();
     }
     ImGui::End();
@@ -297,6 +560,110 @@ void SceneBase::DrawPostEffectTab()
     postEffectManager->DrawGui();
 }
 
+void SceneBase::DrawAssetsTab()
+{
+    if (ImGui::CollapsingHeader("Model Cache", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        const InterleavedGltfModel::CacheStatistics statistics = InterleavedGltfModel::GetCacheStatistics();
+        ImGui::Text("Hit %d / Miss %d", statistics.hitCount, statistics.missCount);
+        ImGui::Text("Live models %d (%.2f MB)", statistics.liveModelCount, statistics.liveGpuBufferBytes / (1024.0f * 1024.0f));
+        ImGui::Text("Total load %.2f ms", statistics.totalLoadMilliseconds);
+
+        ImGui::Separator();
+        ImGui::InputText("glTF", modelCachePath_, sizeof(modelCachePath_));
+        const char* modes[] = { "SkeltalMesh", "StaticMesh" };
+        ImGui::Combo("Mode", &modelCacheMode_, modes, _countof(modes));
+        const InterleavedGltfModel::Mode mode = static_cast<InterleavedGltfModel::Mode>(modelCacheMode_);
+        if (ImGui::Button("Validate"))
+        {
+            std::string report;
+            const bool isValid = InterleavedGltfModel::ValidateCacheFile(modelCachePath_, mode, report);
+            LogLines(report);
+            if (!isValid)
+            {
+                Logger::Warning(("InterleavedGltfModel : invalid cache for " + std::string(modelCachePath_)).c_str());
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Benchmark (.cereal / .modelCache)"))
+        {
+            LogLines(InterleavedGltfModel::BenchmarkCacheLoad(modelCachePath_, mode));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Vertex formats"))
+        {
+            LogLines(InterleavedGltfModel::ReportVertexFormats(modelCachePath_, mode));
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Job graph benchmark"))
+        {// w肵fƓtH_ glTF ܂Ƃ߂ēǂ
+            std::vector<AssetLoader::ModelRequest> requests;
+            std::error_code error;
+            const std::filesystem::path directory = std::filesystem::path(modelCachePath_).parent_path();
+            for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+            {
+                const std::filesystem::path extension = entry.path().extension();
+                if (extension == ".gltf" || extension == ".glb")
+                {
+                    AssetLoader::ModelRequest request;
+                    request.filename = entry.path().generic_string();
+                    request.mode = mode;
+                    requests.push_back(request);
+                }
+            }
+            LogLines(AssetLoader::Benchmark(requests));
+        }
+        // ɓǂݍރf甽f (ݒ肪ςLbV͍蒼)
+        VertexFormatBuilder::Options& options = InterleavedGltfModel::vertexFormatOptions;
+        ImGui::Checkbox("Quantize position", &options.quantizePosition);
+        ImGui::SameLine();
+        ImGui::Checkbox("Octahedral normal", &options.octahedralNormal);
+        ImGui::SameLine();
+        ImGui::Checkbox("Octahedral tangent", &options.octahedralTangent);
+        ImGui::Checkbox("Half texcoord", &options.halfTexcoord);
+        ImGui::SameLine();
+        ImGui::Checkbox("Compact skin", &options.compactSkin);
+        ImGui::SameLine();
+        bool unorm16Weights = options.weightBits == 16;
+        if (ImGui::Checkbox("16bit weights", &unorm16Weights))
+        {
+            options.weightBits = unorm16Weights ? 16 : 8;
+        }
+        // CfbNXE_̕בւ (ɍLbV甽f)
+        MeshOptimizer::Options& meshOptions = InterleavedGltfModel::meshOptimizerOptions;
+        ImGui::Checkbox("Vertex cache", &meshOptions.optimizeVertexCache);
+        ImGui::SameLine();
+        ImGui::Checkbox("Overdraw", &meshOptions.optimizeOverdraw);
+        ImGui::SameLine();
+        ImGui::Checkbox("Vertex fetch", &meshOptions.optimizeVertexFetch);
+        ImGui::SliderInt("Cache size", &meshOptions.cacheSize, 8, 32);
+        if (ImGui::Button("Mesh optimization (ACMR / ATVR)"))
+        {
+            LogLines(InterleavedGltfModel::ReportMeshOptimization(modelCachePath_, mode));
+        }
+        // LOD ̍ (ɍLbV甽f)
+        MeshSimplifier::Options& lodOptions = InterleavedGltfModel::meshSimplifierOptions;
+        ImGui::Checkbox("Generate LODs", &lodOptions.enable);
+        ImGui::SliderInt("LOD levels", &lodOptions.levelCount, 1, static_cast<int>(MeshSimplifier::MaxLodCount) - 1);
+        ImGui::SliderFloat("LOD reduction", &lodOptions.reduction, 0.1f, 0.9f);
+        ImGui::SliderFloat("LOD max error", &lodOptions.maxError, 0.001f, 0.2f, "%.3f");
+        if (ImGui::Button("LOD simplification (tris / error)"))
+        {
+            LogLines(InterleavedGltfModel::ReportLods(modelCachePath_, mode));
+        }
+        // bVbg̕ (ɍLbV甽f)
+        MeshletBuilder::Options& meshletOptions = InterleavedGltfModel::meshletBuilderOptions;
+        ImGui::Checkbox("Build meshlets", &meshletOptions.enable);
+        ImGui::SliderInt("Meshlet max verts", &meshletOptions.maxVertices, 16, static_cast<int>(MeshletBuilder::MaxVertices));
+        ImGui::SliderInt("Meshlet max tris", &meshletOptions.maxTriangles, 16, static_cast<int>(MeshletBuilder::MaxTriangles));
+        ImGui::DragInt("Meshlet min batch tris", &meshletOptions.minTriangles, 64.0f, 0, 1 << 20);
+        if (ImGui::Button("Meshlets (count / size)"))
+        {
+            LogLines(InterleavedGltfModel::ReportMeshlets(modelCachePath_, mode));
+        }
+    }
+}
+
 
 void SceneBase::DrawGizmo()
 {
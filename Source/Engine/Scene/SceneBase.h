@@ -27,6 +27,10 @@ public:
     virtual void Update(float deltaTime) override;
 
     void UpdateConstantBuffer(ID3D11DeviceContext* immediateContext);
+    // ̃JƃJXP[h̍s renderer ̕`ΏۂIʂ (`pX̑O 1 Ă)
+    void PrepareVisibility(SceneRenderer& renderer);
+    // ̃J̃Xi[ɂ (Update ŌĂ)
+    void UpdateAudioListener();
 
     virtual bool Uninitialize(ID3D11Device* device) override { return true; }
     virtual bool OnSizeChanged(ID3D11Device* device, UINT64 width, UINT height) override;
@@ -43,6 +47,8 @@ private:
 
     void DrawPostEffectTab();
 
+    void DrawAssetsTab();
+
     void SetupImGuiStyle();
 
     void DrawGizmo();
@@ -115,6 +121,13 @@ protected:
 
     std::shared_ptr<Actor> selectedActor_;  // I𒆂̃AN^[ێ
 
+    // fLbV̌/x`}[Np
+    char modelCachePath_[256] = "./Data/Models/Building/bomb_bill.gltf";
+    int modelCacheMode_ = 0;
+
+    // JO̕\p (Ō PrepareVisibility  renderer)
+    SceneRenderer* culledRenderer_ = nullptr;
+
 
     //==============================
     // o[֐
@@ -0,0 +1,510 @@
+#include "MappedCache.h"
+
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+
+namespace MappedCache
+{
+    namespace
+    {
+        uint64_t AlignUp(uint64_t value)
+        {
+            return (value + Alignment - 1) & ~(Alignment - 1);
+        }
+
+        void SetError(std::string* error, const std::string& message)
+        {
+            if (error)
+            {
+                *error = message;
+            }
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const std::filesystem::path& path)
+    {
+        Close();
+
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+        mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL)
+        {
+            Close();
+            return false;
+        }
+        data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!data)
+        {
+            Close();
+            return false;
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (data)
+        {
+            UnmapViewOfFile(data);
+            data = nullptr;
+        }
+        if (mapping != NULL)
+        {
+            CloseHandle(mapping);
+            mapping = NULL;
+        }
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file);
+            file = INVALID_HANDLE_VALUE;
+        }
+        size = 0;
+    }
+
+    StringRef Writer::AddString(std::string_view text)
+    {
+        auto it = internedStrings.find(std::string(text));
+        if (it != internedStrings.end())
+        {
+            return it->second;
+        }
+        StringRef ref = { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size()) };
+        strings.insert(strings.end(), text.begin(), text.end());
+        // I[ĂƃfobKœǂ݂₷
+        strings.push_back('\0');
+        internedStrings.emplace(std::string(text), ref);
+        return ref;
+    }
+
+    BlobRef Writer::AddBlob(const void* data, size_t size)
+    {
+        BlobRef ref = { AlignUp(blobs.size()), size };
+        blobs.resize(static_cast<size_t>(ref.offset + size));
+        if (size > 0)
+        {
+            memcpy(blobs.data() + ref.offset, data, size);
+        }
+        return ref;
+    }
+
+    bool Writer::Save(const std::filesystem::path& path) const
+    {
+        // ZNV id ɕׂ
+        struct OrderedSection
+        {
+            uint32_t id;
+            uint32_t elementSize;
+            const std::vector<unsigned char>* bytes;
+        };
+        std::vector<OrderedSection> ordered;
+        ordered.push_back({ static_cast<uint32_t>(SectionId::Strings), 1, &strings });
+        ordered.push_back({ static_cast<uint32_t>(SectionId::Blobs), 1, &blobs });
+        for (const auto& [id, section] : sections)
+        {
+            ordered.push_back({ id, section.elementSize, &section.bytes });
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const OrderedSection& a, const OrderedSection& b) { return a.id < b.id; });
+
+        Header header;
+        header.contentType = contentType;
+        header.sectionCount = static_cast<uint32_t>(ordered.size());
+
+        std::vector<SectionEntry> table;
+        uint64_t offset = AlignUp(sizeof(Header));
+        for (const OrderedSection& section : ordered)
+        {
+            SectionEntry& entry = table.emplace_back();
+            entry.id = section.id;
+            entry.elementSize = section.elementSize;
+            entry.offset = offset;
+            entry.size = section.bytes->size();
+            offset = AlignUp(offset + entry.size);
+        }
+        header.sectionTableOffset = offset;
+        header.fileSize = offset + sizeof(SectionEntry) * table.size();
+
+        // rŎsĂÂLbV󂳂Ȃ悤Ɉꎞt@CɏĂuB
+        // LbV𕡐̃XbhEvZXɏƂ̂ŁAꎞt@C͏育Ƃɕ
+        static std::atomic<uint32_t> temporaryCounter = 0;
+        std::filesystem::path temporaryPath = path;
+        temporaryPath += "." + std::to_string(GetCurrentProcessId()) + "_" + std::to_string(GetCurrentThreadId()) + "_" + std::to_string(temporaryCounter++) + ".tmp";
+        {
+            std::ofstream ofs(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!ofs)
+            {
+                return false;
+            }
+            const char padding[Alignment] = {};
+            auto writeAt = [&](uint64_t position) {
+                const uint64_t current = static_cast<uint64_t>(ofs.tellp());
+                ofs.write(padding, static_cast<std::streamsize>(position - current));
+                };
+            ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (size_t i = 0; i < ordered.size(); ++i)
+            {
+                writeAt(table[i].offset);
+                ofs.write(reinterpret_cast<const char*>(ordered[i].bytes->data()), static_cast<std::streamsize>(table[i].size));
+            }
+            writeAt(header.sectionTableOffset);
+            ofs.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(sizeof(SectionEntry) * table.size()));
+            if (!ofs)
+            {
+                ofs.close();
+                std::error_code removeError;
+                std::filesystem::remove(temporaryPath, removeError);
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temporaryPath, path, ec);
+        if (ec)
+        {
+            std::error_code removeError;
+            std::filesystem::remove(temporaryPath, removeError);
+            // ̓ǂݎ肪}bvĂԂ͒uȂBɒNLbV̂ŁAg
+            return std::filesystem::exists(path, removeError);
+        }
+        return true;
+    }
+
+    bool Reader::Open(const std::filesystem::path& path, uint32_t contentType, std::string* error)
+    {
+        header = nullptr;
+        sections.clear();
+        strings = nullptr;
+        blobs = nullptr;
+
+        if (!file.Open(path))
+        {
+            SetError(error, "failed to map file");
+            return false;
+        }
+        const unsigned char* data = file.Data();
+        const uint64_t fileSize = file.Size();
+        if (fileSize < sizeof(Header))
+        {
+            SetError(error, "file is smaller than header");
+            file.Close();
+            return false;
+        }
+        const Header* candidate = reinterpret_cast<const Header*>(data);
+        if (candidate->magic != Magic)
+        {
+            SetError(error, "bad magic");
+            file.Close();
+            return false;
+        }
+        if (candidate->version != Version)
+        {
+            SetError(error, "version mismatch (file " + std::to_string(candidate->version) + ", expected " + std::to_string(Version) + ")");
+            file.Close();
+            return false;
+        }
+        if (contentType != 0 && candidate->contentType != contentType)
+        {
+            SetError(error, "content type mismatch");
+            file.Close();
+            return false;
+        }
+        if (candidate->fileSize != fileSize)
+        {
+            SetError(error, "file size mismatch (header " + std::to_string(candidate->fileSize) + ", actual " + std::to_string(fileSize) + ")");
+            file.Close();
+            return false;
+        }
+        const uint64_t tableSize = sizeof(SectionEntry) * static_cast<uint64_t>(candidate->sectionCount);
+        if (candidate->sectionTableOffset % Alignment != 0 || candidate->sectionTableOffset > fileSize || tableSize > fileSize - candidate->sectionTableOffset)
+        {
+            SetError(error, "section table out of range");
+            file.Close();
+            return false;
+        }
+
+        const SectionEntry* table = reinterpret_cast<const SectionEntry*>(data + candidate->sectionTableOffset);
+        sections.assign(table, table + candidate->sectionCount);
+        for (const SectionEntry& entry : sections)
+        {
+            if (entry.offset % Alignment != 0 || entry.offset < sizeof(Header) || entry.offset > candidate->sectionTableOffset || entry.size > candidate->sectionTableOffset - entry.offset)
+            {
+                SetError(error, std::string("section out of range : ") + GetSectionName(entry.id));
+                sections.clear();
+                file.Close();
+                return false;
+            }
+            if (entry.elementSize == 0 || entry.size % entry.elementSize != 0)
+            {
+                SetError(error, std::string("section size is not a multiple of its element size : ") + GetSectionName(entry.id));
+                sections.clear();
+                file.Close();
+                return false;
+            }
+        }
+        header = candidate;
+        strings = FindSection(SectionId::Strings);
+        blobs = FindSection(SectionId::Blobs);
+        return true;
+    }
+
+    const SectionEntry* Reader::FindSection(SectionId id) const
+    {
+        for (const SectionEntry& entry : sections)
+        {
+            if (entry.id == static_cast<uint32_t>(id))
+            {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    bool Reader::IsValid(const StringRef& ref) const
+    {
+        if (ref.length == 0)
+        {
+            return true;
+        }
+        return strings && static_cast<uint64_t>(ref.offset) + ref.length <= strings->size;
+    }
+
+    bool Reader::IsValid(const BlobRef& ref) const
+    {
+        if (ref.size == 0)
+        {
+            return true;
+        }
+        return blobs && ref.offset % Alignment == 0 && ref.offset <= blobs->size && ref.size <= blobs->size - ref.offset;
+    }
+
+    std::string_view Reader::String(const StringRef& ref) const
+    {
+        if (ref.length == 0 || !strings)
+        {
+            return {};
+        }
+        return { reinterpret_cast<const char*>(file.Data() + strings->offset + ref.offset), ref.length };
+    }
+
+    const unsigned char* Reader::Blob(const BlobRef& ref) const
+    {
+        if (ref.size == 0 || !blobs)
+        {
+            return nullptr;
+        }
+        return file.Data() + blobs->offset + ref.offset;
+    }
+
+    const char* GetSectionName(uint32_t id)
+    {
+        switch (static_cast<SectionId>(id))
+        {
+        case SectionId::Strings: return "Strings";
+        case SectionId::Blobs: return "Blobs";
+        case SectionId::Model: return "Model";
+        case SectionId::Scenes: return "Scenes";
+        case SectionId::Nodes: return "Nodes";
+        case SectionId::Materials: return "Materials";
+        case SectionId::Meshes: return "Meshes";
+        case SectionId::Primitives: return "Primitives";
+        case SectionId::Attributes: return "Attributes";
+        case SectionId::BatchMeshes: return "BatchMeshes";
+        case SectionId::Textures: return "Textures";
+        case SectionId::Images: return "Images";
+        case SectionId::Skins: return "Skins";
+        case SectionId::Animations: return "Animations";
+        case SectionId::AnimationChannels: return "AnimationChannels";
+        case SectionId::AnimationSamplers: return "AnimationSamplers";
+        case SectionId::AnimationKeys: return "AnimationKeys";
+        }
+        return "Unknown";
+    }
+
+    bool ValidateModelRecords(const Reader& reader, std::string& report, size_t materialDataSize)
+    {
+        bool succeeded = true;
+        auto fail = [&](const char* section, size_t index, const char* what) {
+            report += std::string(section) + "[" + std::to_string(index) + "] : " + what + "\n";
+            succeeded = false;
+            };
+
+        std::span<const SceneRecord> scenes = reader.Section<SceneRecord>(SectionId::Scenes);
+        for (size_t i = 0; i < scenes.size(); ++i)
+        {
+            if (!reader.IsValid(scenes[i].name)) fail("Scenes", i, "name out of range");
+            if (!reader.IsValid(scenes[i].nodes)) fail("Scenes", i, "nodes out of range");
+        }
+        // Yő̃R[hŵ́Aǂݍ񂾌ɔ͈͊Oǂ܂Ȃ悤ɐƓ˂킹
+        std::span<const NodeRecord> nodes = reader.Section<NodeRecord>(SectionId::Nodes);
+        std::span<const MeshRecord> meshes = reader.Section<MeshRecord>(SectionId::Meshes);
+        std::span<const SkinRecord> skins = reader.Section<SkinRecord>(SectionId::Skins);
+        std::span<const MaterialRecord> materials = reader.Section<MaterialRecord>(SectionId::Materials);
+        auto isIndex = [](int32_t index, size_t count, bool optional) {
+            return (optional && index == -1) || (index >= 0 && static_cast<size_t>(index) < count);
+            };
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (!reader.IsValid(nodes[i].name)) fail("Nodes", i, "name out of range");
+            if (!isIndex(nodes[i].mesh, meshes.size(), true)) fail("Nodes", i, "mesh index out of range");
+            if (!isIndex(nodes[i].skin, skins.size(), true)) fail("Nodes", i, "skin index out of range");
+            if (!reader.IsValid(nodes[i].children)) fail("Nodes", i, "children out of range");
+            for (int child : reader.Blob<int>(nodes[i].children))
+            {
+                if (child < 0 || static_cast<size_t>(child) >= nodes.size()) fail("Nodes", i, "child index out of range");
+            }
+        }
+        for (size_t i = 0; i < materials.size(); ++i)
+        {
+            if (!reader.IsValid(materials[i].name)) fail("Materials", i, "name out of range");
+            if (!reader.IsValid(materials[i].data)) fail("Materials", i, "data out of range");
+            // 傫Ⴄ ReadMaterials  memcpy ͈͊Oǂނ̂ŁA蒼
+            if (materialDataSize != 0 && materials[i].data.size != materialDataSize) fail("Materials", i, "data size mismatch");
+        }
+        std::span<const AttributeRecord> attributes = reader.Section<AttributeRecord>(SectionId::Attributes);
+        // Primitives  BatchMeshes ͓R[h
+        for (SectionId id : { SectionId::Primitives, SectionId::BatchMeshes })
+        {
+            const char* name = GetSectionName(static_cast<uint32_t>(id));
+            std::span<const PrimitiveRecord> primitives = reader.Section<PrimitiveRecord>(id);
+            for (size_t i = 0; i < primitives.size(); ++i)
+            {
+                const PrimitiveRecord& primitive = primitives[i];
+                if (!reader.IsValid(primitive.indices)) fail(name, i, "indices out of range");
+                if (!reader.IsValid(primitive.vertices)) fail(name, i, "vertices out of range");
+                if (primitive.indices.size != 0 && primitive.indices.size != primitive.indexSizeInBytes) fail(name, i, "index size mismatch");
+                if (primitive.vertices.size != 0 && primitive.vertices.size != primitive.vertexSizeInBytes) fail(name, i, "vertex size mismatch");
+                if (!reader.IsValid<AttributeRecord>(primitive.attributes, SectionId::Attributes)) fail(name, i, "attributes out of range");
+                if (!isIndex(primitive.material, materials.size(), true)) fail(name, i, "material index out of range");
+                if (primitive.lodCount > MaxLodCount) fail(name, i, "too many LODs");
+                const uint32_t indexSize = primitive.indexFormat == DXGI_FORMAT_R16_UINT ? 2 : 4;
+                for (uint32_t level = 0; level < (std::min)(primitive.lodCount, MaxLodCount); ++level)
+                {
+                    const LodRecord& lod = primitive.lods[level];
+                    if (static_cast<uint64_t>(lod.firstIndex) + lod.indexCount > primitive.indexSizeInBytes / indexSize) fail(name, i, "LOD range out of index buffer");
+                }
+                if (!reader.IsValid(primitive.meshlets) || primitive.meshlets.size % sizeof(MeshletRecord) != 0)
+                {
+                    fail(name, i, "meshlets out of range");
+                }
+                else
+                {
+                    for (const MeshletRecord& meshlet : reader.Blob<MeshletRecord>(primitive.meshlets))
+                    {
+                        if (static_cast<uint64_t>(meshlet.firstIndex) + meshlet.indexCount > primitive.indexSizeInBytes / indexSize) fail(name, i, "meshlet range out of index buffer");
+                    }
+                }
+            }
+        }
+        for (size_t i = 0; i < attributes.size(); ++i)
+        {
+            if (!reader.IsValid(attributes[i].name)) fail("Attributes", i, "name out of range");
+        }
+        for (size_t i = 0; i < meshes.size(); ++i)
+        {
+            if (!reader.IsValid(meshes[i].name)) fail("Meshes", i, "name out of range");
+            if (!reader.IsValid<PrimitiveRecord>(meshes[i].primitives, SectionId::Primitives)) fail("Meshes", i, "primitives out of range");
+        }
+        std::span<const TextureRecord> textures = reader.Section<TextureRecord>(SectionId::Textures);
+        std::span<const ImageRecord> images = reader.Section<ImageRecord>(SectionId::Images);
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            if (!reader.IsValid(textures[i].name)) fail("Textures", i, "name out of range");
+            if (textures[i].source >= static_cast<int32_t>(images.size())) fail("Textures", i, "source out of range");
+        }
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            if (!reader.IsValid(images[i].name) || !reader.IsValid(images[i].mimeType) || !reader.IsValid(images[i].uri)) fail("Images", i, "string out of range");
+            if (!reader.IsValid(images[i].data)) fail("Images", i, "data out of range");
+        }
+        for (size_t i = 0; i < skins.size(); ++i)
+        {
+            if (!reader.IsValid(skins[i].inverseBindMatrices) || !reader.IsValid(skins[i].joints))
+            {
+                fail("Skins", i, "data out of range");
+                continue;
+            }
+            for (int joint : reader.Blob<int>(skins[i].joints))
+            {
+                if (!isIndex(joint, nodes.size(), false)) fail("Skins", i, "joint index out of range");
+            }
+        }
+        std::span<const AnimationRecord> animations = reader.Section<AnimationRecord>(SectionId::Animations);
+        std::span<const AnimationChannelRecord> channels = reader.Section<AnimationChannelRecord>(SectionId::AnimationChannels);
+        std::span<const AnimationSamplerRecord> samplers = reader.Section<AnimationSamplerRecord>(SectionId::AnimationSamplers);
+        std::span<const AnimationKeyRecord> keys = reader.Section<AnimationKeyRecord>(SectionId::AnimationKeys);
+        for (size_t i = 0; i < animations.size(); ++i)
+        {
+            if (!reader.IsValid(animations[i].name)) fail("Animations", i, "name out of range");
+            if (!reader.IsValid<AnimationSamplerRecord>(animations[i].samplers, SectionId::AnimationSamplers)) fail("Animations", i, "samplers out of range");
+            if (!reader.IsValid<AnimationChannelRecord>(animations[i].channels, SectionId::AnimationChannels))
+            {
+                fail("Animations", i, "channels out of range");
+            }
+            else
+            {
+                // channel  sampler ͂̃Aj[V samplers ̒̓YB
+                // Aj[ṼLbVɂ Nodes ̂ŁA͍̎Đ͈̔̓`FbNɔC
+                const bool hasNodes = !nodes.empty();
+                for (const AnimationChannelRecord& channel : channels.subspan(animations[i].channels.first, animations[i].channels.count))
+                {
+                    if (!isIndex(channel.sampler, animations[i].samplers.count, false)) fail("Animations", i, "channel sampler index out of range");
+                    if (hasNodes && !isIndex(channel.targetNode, nodes.size(), true)) fail("Animations", i, "channel target node out of range");
+                }
+            }
+            if (!reader.IsValid<AnimationKeyRecord>(animations[i].keys, SectionId::AnimationKeys)) fail("Animations", i, "keys out of range");
+        }
+        for (size_t i = 0; i < channels.size(); ++i)
+        {
+            if (!reader.IsValid(channels[i].targetPath)) fail("AnimationChannels", i, "targetPath out of range");
+        }
+        for (size_t i = 0; i < samplers.size(); ++i)
+        {
+            if (!reader.IsValid(samplers[i].interpolation)) fail("AnimationSamplers", i, "interpolation out of range");
+        }
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            if (!reader.IsValid(keys[i].values)) fail("AnimationKeys", i, "values out of range");
+            if (keys[i].kind > AnimationKeyKind::Translation) fail("AnimationKeys", i, "unknown kind");
+        }
+        return succeeded;
+    }
+
+    bool ValidateFile(const std::filesystem::path& path, std::string& report)
+    {
+        Reader reader;
+        std::string error;
+        if (!reader.Open(path, 0, &error))
+        {
+            report += path.string() + " : " + error + "\n";
+            return false;
+        }
+        const Header* header = reader.GetHeader();
+        const uint32_t type = header->contentType;
+        const char typeName[5] = { static_cast<char>(type & 0xff), static_cast<char>((type >> 8) & 0xff), static_cast<char>((type >> 16) & 0xff), static_cast<char>((type >> 24) & 0xff), '\0' };
+        report += path.string() + " : version " + std::to_string(header->version) + ", type " + typeName + ", " + std::to_string(reader.FileSize()) + " bytes\n";
+        for (const SectionEntry& entry : reader.Sections())
+        {
+            char line[128];
+            sprintf_s(line, "  %-18s offset %10llu size %10llu stride %u\n", GetSectionName(entry.id), entry.offset, entry.size, entry.elementSize);
+            report += line;
+        }
+        const bool succeeded = ValidateModelRecords(reader, report);
+        report += succeeded ? "  OK\n" : "  INVALID\n";
+        return succeeded;
+    }
+}
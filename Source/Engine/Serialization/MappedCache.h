@@ -0,0 +1,769 @@
+#pragma once
+
+#include <windows.h>
+#include <directxmath.h>
+#include <dxgiformat.h>
+#include <crtdbg.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <unordered_map>
+#include <span>
+
+// }bvœǂݍރfLbV
+// cereal ̂悤ɗvfƂɕAt@Ĉ܂܃}bvĎQƂ
+//
+// [Header][Section][Section]...[SectionTable]
+//  EZNV 16 byte Eɔzu
+//  ER[h̎QƂׂ͂ăZNV擪̃ItZbgȂ̂ŁAǂɃ}bvĂg
+//  E_/CfbNX/摜Ȃǂ̑傫ȃf[^ Blobs ZNVɂ܂Ƃ߂ 16 byte EŒu
+namespace MappedCache
+{
+    constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+    {
+        return static_cast<uint32_t>(static_cast<uint8_t>(a)) | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+            (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+    }
+
+    constexpr uint32_t Magic = MakeFourCC('G', 'M', 'C', 'H');
+    // R[h̃CAEgςグ
+    constexpr uint32_t Version = 6;
+    constexpr uint64_t Alignment = 16;
+
+    struct Header
+    {
+        uint32_t magic = Magic;
+        uint32_t version = Version;
+        uint32_t contentType = 0;   // ǂ̃NX̃LbV
+        uint32_t sectionCount = 0;
+        uint64_t fileSize = 0;
+        uint64_t sectionTableOffset = 0;
+    };
+
+    struct SectionEntry
+    {
+        uint32_t id = 0;
+        uint32_t elementSize = 0;   // R[h̃TCY (Strings / Blobs  1)
+        uint64_t offset = 0;        // t@C擪
+        uint64_t size = 0;          // byte 
+    };
+
+    // e[uւ̎Q
+    struct StringRef
+    {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+    // Blobs ZNVւ̎Q
+    struct BlobRef
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+    // ʃZNṼR[h͈
+    struct RangeRef
+    {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    enum class SectionId : uint32_t
+    {
+        Strings = 1,
+        Blobs,
+        Model,
+        Scenes,
+        Nodes,
+        Materials,
+        Meshes,
+        Primitives,
+        Attributes,
+        BatchMeshes,
+        Textures,
+        Images,
+        Skins,
+        Animations,
+        AnimationChannels,
+        AnimationSamplers,
+        AnimationKeys,
+    };
+
+    // ǂݎp̃t@C}bsO
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::filesystem::path& path);
+        void Close();
+
+        const unsigned char* Data() const { return data; }
+        size_t Size() const { return size; }
+    private:
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = NULL;
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+    };
+
+    class Writer
+    {
+    public:
+        explicit Writer(uint32_t contentType) : contentType(contentType) {}
+
+        StringRef AddString(std::string_view text);
+        BlobRef AddBlob(const void* data, size_t size);
+        template<class T>
+        BlobRef AddBlob(const std::vector<T>& values)
+        {
+            return AddBlob(values.data(), values.size() * sizeof(T));
+        }
+
+        template<class T>
+        void AddSection(SectionId id, const std::vector<T>& records)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Section records must be trivially copyable.");
+            Section& section = sections[static_cast<uint32_t>(id)];
+            section.elementSize = sizeof(T);
+            section.bytes.resize(records.size() * sizeof(T));
+            if (!records.empty())
+            {
+                memcpy(section.bytes.data(), records.data(), section.bytes.size());
+            }
+        }
+
+        // ̓ǂݎ肪}bvĂĒuȂAɃLbV true Ԃ
+        bool Save(const std::filesystem::path& path) const;
+    private:
+        struct Section
+        {
+            uint32_t elementSize = 0;
+            std::vector<unsigned char> bytes;
+        };
+        uint32_t contentType;
+        std::vector<unsigned char> strings;
+        std::vector<unsigned char> blobs;
+        std::unordered_map<std::string, StringRef> internedStrings;
+        std::unordered_map<uint32_t, Section> sections;
+    };
+
+    class Reader
+    {
+    public:
+        // t@C}bvăwb_ƃZNVe[u؂
+        bool Open(const std::filesystem::path& path, uint32_t contentType, std::string* error = nullptr);
+
+        bool IsOpen() const { return file.Data() != nullptr; }
+        uint32_t ContentType() const { return header ? header->contentType : 0; }
+
+        template<class T>
+        std::span<const T> Section(SectionId id) const
+        {
+            const SectionEntry* entry = FindSection(id);
+            if (!entry || entry->elementSize != sizeof(T))
+            {
+                return {};
+            }
+            return { reinterpret_cast<const T*>(file.Data() + entry->offset), static_cast<size_t>(entry->size / sizeof(T)) };
+        }
+
+        std::string_view String(const StringRef& ref) const;
+        const unsigned char* Blob(const BlobRef& ref) const;
+        template<class T>
+        std::span<const T> Blob(const BlobRef& ref) const
+        {
+            return { reinterpret_cast<const T*>(Blob(ref)), static_cast<size_t>(ref.size / sizeof(T)) };
+        }
+        template<class T>
+        std::vector<T> BlobToVector(const BlobRef& ref) const
+        {
+            std::span<const T> values = Blob<T>(ref);
+            return { values.begin(), values.end() };
+        }
+
+        // R[h̎QƂ͈͓
+        bool IsValid(const StringRef& ref) const;
+        bool IsValid(const BlobRef& ref) const;
+        template<class T>
+        bool IsValid(const RangeRef& ref, SectionId id) const
+        {
+            return static_cast<uint64_t>(ref.first) + ref.count <= Section<T>(id).size();
+        }
+
+        const std::vector<SectionEntry>& Sections() const { return sections; }
+        const Header* GetHeader() const { return header; }
+        size_t FileSize() const { return file.Size(); }
+    private:
+        const SectionEntry* FindSection(SectionId id) const;
+
+        MappedFile file;
+        const Header* header = nullptr;
+        std::vector<SectionEntry> sections;
+        const SectionEntry* strings = nullptr;
+        const SectionEntry* blobs = nullptr;
+    };
+
+    // wb_/ZNVe[u/ZNVzǔ،ʂ𕶎ŕԂ
+    bool ValidateFile(const std::filesystem::path& path, std::string& report);
+
+    const char* GetSectionName(uint32_t id);
+
+    //
+    // glTF nfŋʂ̃R[h
+    // InterleavedGltfModel / SoftBodySimulate / ClothSimulate ͓`̍\̂Ă̂Ńev[gŋL
+    //
+    struct ModelRecord
+    {
+        int32_t defaultScene = 0;
+        int32_t mode = 0;
+        // VertexFormatBuilder::Options::Hash (ʎq̐ݒ肪ς蒼)
+        uint32_t vertexOptions = 0;
+        // MeshOptimizer::Options::Hash (CfbNXE_̕בւ̐ݒ)
+        uint32_t meshOptions = 0;
+        // MeshSimplifier::Options::Hash (LOD ̍)
+        uint32_t lodOptions = 0;
+        // MeshletBuilder::Options::Hash (bVbg̕)
+        uint32_t meshletOptions = 0;
+        // InterleavedGltfModel::localBounds (min > max Ȃ疳)
+        DirectX::XMFLOAT3 boundsMin = { 1, 1, 1 };
+        DirectX::XMFLOAT3 boundsMax = { -1, -1, -1 };
+    };
+    struct SceneRecord
+    {
+        StringRef name;
+        BlobRef nodes; // int32
+    };
+    struct NodeRecord
+    {
+        StringRef name;
+        int32_t skin = -1;
+        int32_t mesh = -1;
+        BlobRef children; // int32
+        DirectX::XMFLOAT4 rotation;
+        DirectX::XMFLOAT3 scale;
+        DirectX::XMFLOAT3 translation;
+        DirectX::XMFLOAT4X4 globalTransform;
+        DirectX::XMFLOAT3 maxValue;
+        DirectX::XMFLOAT3 minValue;
+    };
+    struct MaterialRecord
+    {
+        StringRef name;
+        BlobRef data; // Material::Cbuffer
+    };
+    struct MeshRecord
+    {
+        StringRef name;
+        RangeRef primitives;
+    };
+    // ̃bV܂߂ LOD ̍ő̒i (MeshSimplifier::MaxLodCount Ƒ)
+    constexpr uint32_t MaxLodCount = 4;
+    struct LodRecord
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;
+        uint32_t pad = 0;
+    };
+    // MeshletBuilder::Meshlet Ɠ
+    struct MeshletRecord
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        DirectX::XMFLOAT3 center = { 0, 0, 0 };
+        float radius = 0.0f;
+        DirectX::XMFLOAT3 coneAxis = { 0, 0, 1 };
+        float coneCutoff = 1.0f;
+    };
+    struct PrimitiveRecord
+    {
+        int32_t material = -1;
+        int32_t indexFormat = 0;
+        uint32_t indexSizeInBytes = 0;
+        uint32_t vertexSizeInBytes = 0;
+        uint32_t vertexStrideInBytes = 0;
+        // ClothSimulate p
+        uint32_t clothVertexOffset = 0;
+        uint32_t startIndexLocation = 0;
+        uint32_t indexCount = 0;
+        // InterleavedGltfModel p (VertexFormat::LayoutKey ƈʒu̕l)
+        uint32_t vertexLayout = 0;
+        DirectX::XMFLOAT3 positionScale = { 1, 1, 1 };
+        DirectX::XMFLOAT3 positionOffset = { 0, 0, 0 };
+        // InterleavedGltfModel p (CfbNXobt@̒ LOD ͈̔́B0 ȂŜ 1 i)
+        uint32_t lodCount = 0;
+        LodRecord lods[MaxLodCount];
+        // InterleavedGltfModel::BatchMesh p (MeshletRecordBȂ烁bVbgɕĂȂ)
+        BlobRef meshlets;
+        BlobRef indices;
+        BlobRef vertices;
+        RangeRef attributes;
+    };
+    struct AttributeRecord
+    {
+        StringRef name;
+        int32_t format = 0;
+        uint32_t pad = 0;
+    };
+    struct TextureRecord
+    {
+        StringRef name;
+        int32_t source = -1;
+        uint32_t pad = 0;
+    };
+    struct ImageRecord
+    {
+        StringRef name;
+        StringRef mimeType;
+        StringRef uri;
+        int32_t width = -1;
+        int32_t height = -1;
+        int32_t component = -1;
+        int32_t bits = -1;
+        int32_t pixelType = -1;
+        int32_t asIs = 0;
+        BlobRef data;
+    };
+
+    template<class SceneT>
+    void WriteScenes(Writer& writer, const std::vector<SceneT>& scenes)
+    {
+        std::vector<SceneRecord> records;
+        for (const SceneT& scene : scenes)
+        {
+            records.push_back({ writer.AddString(scene.name), writer.AddBlob(scene.nodes) });
+        }
+        writer.AddSection(SectionId::Scenes, records);
+    }
+    template<class SceneT>
+    void ReadScenes(const Reader& reader, std::vector<SceneT>& scenes)
+    {
+        for (const SceneRecord& record : reader.Section<SceneRecord>(SectionId::Scenes))
+        {
+            SceneT& scene = scenes.emplace_back();
+            scene.name = reader.String(record.name);
+            scene.nodes = reader.BlobToVector<int>(record.nodes);
+        }
+    }
+
+    template<class NodeT>
+    void WriteNodes(Writer& writer, const std::vector<NodeT>& nodes)
+    {
+        std::vector<NodeRecord> records;
+        for (const NodeT& node : nodes)
+        {
+            NodeRecord& record = records.emplace_back();
+            record.name = writer.AddString(node.name);
+            record.skin = node.skin;
+            record.mesh = node.mesh;
+            record.children = writer.AddBlob(node.children);
+            record.rotation = node.rotation;
+            record.scale = node.scale;
+            record.translation = node.translation;
+            record.globalTransform = node.globalTransform;
+            record.maxValue = node.maxValue;
+            record.minValue = node.minValue;
+        }
+        writer.AddSection(SectionId::Nodes, records);
+    }
+    template<class NodeT>
+    void ReadNodes(const Reader& reader, std::vector<NodeT>& nodes)
+    {
+        for (const NodeRecord& record : reader.Section<NodeRecord>(SectionId::Nodes))
+        {
+            NodeT& node = nodes.emplace_back();
+            node.name = reader.String(record.name);
+            node.skin = record.skin;
+            node.mesh = record.mesh;
+            node.children = reader.BlobToVector<int>(record.children);
+            node.rotation = record.rotation;
+            node.scale = record.scale;
+            node.translation = record.translation;
+            node.globalTransform = record.globalTransform;
+            node.maxValue = record.maxValue;
+            node.minValue = record.minValue;
+        }
+    }
+
+    template<class MaterialT>
+    void WriteMaterials(Writer& writer, const std::vector<MaterialT>& materials)
+    {
+        std::vector<MaterialRecord> records;
+        for (const MaterialT& material : materials)
+        {
+            records.push_back({ writer.AddString(material.name), writer.AddBlob(&material.data, sizeof(material.data)) });
+        }
+        writer.AddSection(SectionId::Materials, records);
+    }
+    template<class MaterialT>
+    void ReadMaterials(const Reader& reader, std::vector<MaterialT>& materials)
+    {
+        for (const MaterialRecord& record : reader.Section<MaterialRecord>(SectionId::Materials))
+        {
+            MaterialT& material = materials.emplace_back();
+            material.name = reader.String(record.name);
+            _ASSERT_EXPR(record.data.size == sizeof(material.data), L"Material layout mismatch.");
+            memcpy(&material.data, reader.Blob(record.data), sizeof(material.data));
+        }
+    }
+
+    // primitive / batchMesh ܂Ƃ߂ď (attributes  Attributes ZNVɑĒu)
+    template<class PrimitiveT>
+    PrimitiveRecord MakePrimitiveRecord(Writer& writer, const PrimitiveT& primitive, std::vector<AttributeRecord>& attributes)
+    {
+        PrimitiveRecord record;
+        record.material = primitive.material;
+        record.indexFormat = static_cast<int32_t>(primitive.indexBufferView.format);
+        record.indexSizeInBytes = primitive.indexBufferView.sizeInBytes;
+        record.vertexSizeInBytes = primitive.vertexBufferView.sizeInBytes;
+        record.vertexStrideInBytes = primitive.vertexBufferView.strideInBytes;
+        if constexpr (requires { primitive.clothVertexOffset; })
+        {
+            record.clothVertexOffset = primitive.clothVertexOffset;
+            record.startIndexLocation = primitive.startIndexLocation;
+            record.indexCount = primitive.indexCount;
+        }
+        if constexpr (requires { primitive.vertexFormat; })
+        {
+            record.vertexLayout = primitive.vertexFormat.LayoutKey();
+            record.positionScale = primitive.vertexFormat.positionScale;
+            record.positionOffset = primitive.vertexFormat.positionOffset;
+        }
+        if constexpr (requires { primitive.lods; })
+        {
+            record.lodCount = static_cast<uint32_t>((std::min)(primitive.lods.size(), static_cast<size_t>(MaxLodCount)));
+            for (uint32_t level = 0; level < record.lodCount; ++level)
+            {
+                record.lods[level] = { primitive.lods[level].firstIndex, primitive.lods[level].indexCount, primitive.lods[level].error };
+            }
+        }
+        if constexpr (requires { primitive.meshlets; })
+        {
+            std::vector<MeshletRecord> meshlets;
+            for (const auto& meshlet : primitive.meshlets)
+            {
+                meshlets.push_back({ meshlet.firstIndex, meshlet.indexCount, meshlet.center, meshlet.radius, meshlet.coneAxis, meshlet.coneCutoff });
+            }
+            record.meshlets = writer.AddBlob(meshlets);
+        }
+        record.indices = writer.AddBlob(primitive.cachedIndices);
+        record.vertices = writer.AddBlob(primitive.cachedVertices);
+        record.attributes.first = static_cast<uint32_t>(attributes.size());
+        for (const auto& [name, format] : primitive.attributes)
+        {
+            attributes.push_back({ writer.AddString(name), static_cast<int32_t>(format) });
+        }
+        record.attributes.count = static_cast<uint32_t>(attributes.size()) - record.attributes.first;
+        return record;
+    }
+
+    // copyVertices  false Ȃ cachedIndices / cachedVertices ͋̂܂܂ɂ
+    // mappedIndices / mappedVertices ΃}bṽf[^w
+    template<class PrimitiveT>
+    void ReadPrimitive(const Reader& reader, const PrimitiveRecord& record, PrimitiveT& primitive, bool copyVertices)
+    {
+        primitive.material = record.material;
+        primitive.indexBufferView.format = static_cast<DXGI_FORMAT>(record.indexFormat);
+        primitive.indexBufferView.sizeInBytes = record.indexSizeInBytes;
+        primitive.vertexBufferView.sizeInBytes = record.vertexSizeInBytes;
+        primitive.vertexBufferView.strideInBytes = record.vertexStrideInBytes;
+        if constexpr (requires { primitive.clothVertexOffset; })
+        {
+            primitive.clothVertexOffset = record.clothVertexOffset;
+            primitive.startIndexLocation = record.startIndexLocation;
+            primitive.indexCount = record.indexCount;
+        }
+        if constexpr (requires { primitive.vertexFormat; })
+        {
+            using FormatT = decltype(primitive.vertexFormat);
+            primitive.vertexFormat = FormatT::FromLayoutKey(record.vertexLayout);
+            primitive.vertexFormat.positionScale = record.positionScale;
+            primitive.vertexFormat.positionOffset = record.positionOffset;
+        }
+        if constexpr (requires { primitive.lods; })
+        {
+            primitive.lods.clear();
+            for (uint32_t level = 0; level < record.lodCount; ++level)
+            {
+                primitive.lods.push_back({ record.lods[level].firstIndex, record.lods[level].indexCount, record.lods[level].error });
+            }
+        }
+        if constexpr (requires { primitive.meshlets; })
+        {
+            // ̂ŁA_f[^cȂRs[
+            primitive.meshlets.clear();
+            for (const MeshletRecord& meshlet : reader.Blob<MeshletRecord>(record.meshlets))
+            {
+                primitive.meshlets.push_back({ meshlet.firstIndex, meshlet.indexCount, meshlet.center, meshlet.radius, meshlet.coneAxis, meshlet.coneCutoff });
+            }
+        }
+        if (copyVertices)
+        {
+            using IndexT = typename decltype(primitive.cachedIndices)::value_type;
+            using VertexT = typename decltype(primitive.cachedVertices)::value_type;
+            primitive.cachedIndices = reader.BlobToVector<IndexT>(record.indices);
+            primitive.cachedVertices = reader.BlobToVector<VertexT>(record.vertices);
+        }
+        else if constexpr (requires { primitive.mappedIndices; })
+        {
+            primitive.mappedIndices = reader.Blob(record.indices);
+            primitive.mappedVertices = reader.Blob(record.vertices);
+        }
+        for (const AttributeRecord& attribute : reader.Section<AttributeRecord>(SectionId::Attributes).subspan(record.attributes.first, record.attributes.count))
+        {
+            primitive.attributes.emplace(reader.String(attribute.name), static_cast<DXGI_FORMAT>(attribute.format));
+        }
+    }
+
+    template<class MeshT>
+    void WriteMeshes(Writer& writer, const std::vector<MeshT>& meshes, std::vector<PrimitiveRecord>& primitives, std::vector<AttributeRecord>& attributes)
+    {
+        std::vector<MeshRecord> records;
+        for (const MeshT& mesh : meshes)
+        {
+            MeshRecord& record = records.emplace_back();
+            record.name = writer.AddString(mesh.name);
+            record.primitives.first = static_cast<uint32_t>(primitives.size());
+            for (const auto& primitive : mesh.primitives)
+            {
+                primitives.push_back(MakePrimitiveRecord(writer, primitive, attributes));
+            }
+            record.primitives.count = static_cast<uint32_t>(primitives.size()) - record.primitives.first;
+        }
+        writer.AddSection(SectionId::Meshes, records);
+    }
+    template<class MeshT>
+    void ReadMeshes(const Reader& reader, std::vector<MeshT>& meshes, bool copyVertices)
+    {
+        std::span<const PrimitiveRecord> primitives = reader.Section<PrimitiveRecord>(SectionId::Primitives);
+        for (const MeshRecord& record : reader.Section<MeshRecord>(SectionId::Meshes))
+        {
+            MeshT& mesh = meshes.emplace_back();
+            mesh.name = reader.String(record.name);
+            for (const PrimitiveRecord& primitiveRecord : primitives.subspan(record.primitives.first, record.primitives.count))
+            {
+                ReadPrimitive(reader, primitiveRecord, mesh.primitives.emplace_back(), copyVertices);
+            }
+        }
+    }
+
+    template<class TextureT, class ImageT>
+    void WriteTextures(Writer& writer, const std::vector<TextureT>& textures, const std::vector<ImageT>& images)
+    {
+        std::vector<TextureRecord> textureRecords;
+        for (const TextureT& texture : textures)
+        {
+            textureRecords.push_back({ writer.AddString(texture.name), texture.source });
+        }
+        writer.AddSection(SectionId::Textures, textureRecords);
+
+        std::vector<ImageRecord> imageRecords;
+        for (const ImageT& image : images)
+        {
+            ImageRecord& record = imageRecords.emplace_back();
+            record.name = writer.AddString(image.name);
+            record.mimeType = writer.AddString(image.mimeType);
+            record.uri = writer.AddString(image.uri);
+            record.width = image.width;
+            record.height = image.height;
+            record.component = image.component;
+            record.bits = image.bits;
+            record.pixelType = image.pixelType;
+            record.asIs = image.asIs ? 1 : 0;
+            record.data = writer.AddBlob(image.cacheData);
+        }
+        writer.AddSection(SectionId::Images, imageRecords);
+    }
+    // copyImageData  false Ȃ cacheData ̓Rs[AmappedData ΃}bṽf[^w
+    template<class TextureT, class ImageT>
+    void ReadTextures(const Reader& reader, std::vector<TextureT>& textures, std::vector<ImageT>& images, bool copyImageData)
+    {
+        for (const TextureRecord& record : reader.Section<TextureRecord>(SectionId::Textures))
+        {
+            TextureT& texture = textures.emplace_back();
+            texture.name = reader.String(record.name);
+            texture.source = record.source;
+        }
+        for (const ImageRecord& record : reader.Section<ImageRecord>(SectionId::Images))
+        {
+            ImageT& image = images.emplace_back();
+            image.name = reader.String(record.name);
+            image.mimeType = reader.String(record.mimeType);
+            image.uri = reader.String(record.uri);
+            image.width = record.width;
+            image.height = record.height;
+            image.component = record.component;
+            image.bits = record.bits;
+            image.pixelType = record.pixelType;
+            image.asIs = record.asIs != 0;
+            if (copyImageData)
+            {
+                image.cacheData = reader.BlobToVector<unsigned char>(record.data);
+            }
+            else if constexpr (requires { image.mappedData; })
+            {
+                image.mappedData = reader.Blob(record.data);
+                image.mappedSize = static_cast<size_t>(record.data.size);
+            }
+        }
+    }
+
+    struct SkinRecord
+    {
+        BlobRef inverseBindMatrices; // XMFLOAT4X4
+        BlobRef joints; // int32
+    };
+    struct AnimationRecord
+    {
+        StringRef name;
+        float duration = 0.0f;
+        uint32_t pad = 0;
+        RangeRef channels;
+        RangeRef samplers;
+        RangeRef keys;
+    };
+    struct AnimationChannelRecord
+    {
+        int32_t sampler = -1;
+        int32_t targetNode = -1;
+        StringRef targetPath;
+    };
+    struct AnimationSamplerRecord
+    {
+        int32_t input = -1;
+        int32_t output = -1;
+        StringRef interpolation;
+    };
+    // timelines / scales / rotations / translations ̊evf
+    enum class AnimationKeyKind : uint32_t
+    {
+        Timeline,    // float
+        Scale,       // XMFLOAT3
+        Rotation,    // XMFLOAT4
+        Translation, // XMFLOAT3
+    };
+    struct AnimationKeyRecord
+    {
+        AnimationKeyKind kind = AnimationKeyKind::Timeline;
+        int32_t key = -1;
+        BlobRef values;
+    };
+
+    template<class SkinT>
+    void WriteSkins(Writer& writer, const std::vector<SkinT>& skins)
+    {
+        std::vector<SkinRecord> records;
+        for (const SkinT& skin : skins)
+        {
+            records.push_back({ writer.AddBlob(skin.inverseBindMatrices), writer.AddBlob(skin.joints) });
+        }
+        writer.AddSection(SectionId::Skins, records);
+    }
+    template<class SkinT>
+    void ReadSkins(const Reader& reader, std::vector<SkinT>& skins)
+    {
+        for (const SkinRecord& record : reader.Section<SkinRecord>(SectionId::Skins))
+        {
+            SkinT& skin = skins.emplace_back();
+            skin.inverseBindMatrices = reader.BlobToVector<DirectX::XMFLOAT4X4>(record.inverseBindMatrices);
+            skin.joints = reader.BlobToVector<int>(record.joints);
+        }
+    }
+
+    template<class AnimationT>
+    void WriteAnimations(Writer& writer, const std::vector<AnimationT>& animations)
+    {
+        std::vector<AnimationRecord> records;
+        std::vector<AnimationChannelRecord> channels;
+        std::vector<AnimationSamplerRecord> samplers;
+        std::vector<AnimationKeyRecord> keys;
+        for (const AnimationT& animation : animations)
+        {
+            AnimationRecord& record = records.emplace_back();
+            record.name = writer.AddString(animation.name);
+            record.duration = animation.duration;
+
+            record.channels = { static_cast<uint32_t>(channels.size()), static_cast<uint32_t>(animation.channels.size()) };
+            for (const auto& channel : animation.channels)
+            {
+                channels.push_back({ channel.sampler, channel.targetNode, writer.AddString(channel.targetPath) });
+            }
+            record.samplers = { static_cast<uint32_t>(samplers.size()), static_cast<uint32_t>(animation.samplers.size()) };
+            for (const auto& sampler : animation.samplers)
+            {
+                samplers.push_back({ sampler.input, sampler.output, writer.AddString(sampler.interpolation) });
+            }
+            record.keys.first = static_cast<uint32_t>(keys.size());
+            for (const auto& [key, values] : animation.timelines)
+            {
+                keys.push_back({ AnimationKeyKind::Timeline, key, writer.AddBlob(values) });
+            }
+            for (const auto& [key, values] : animation.scales)
+            {
+                keys.push_back({ AnimationKeyKind::Scale, key, writer.AddBlob(values) });
+            }
+            for (const auto& [key, values] : animation.rotations)
+            {
+                keys.push_back({ AnimationKeyKind::Rotation, key, writer.AddBlob(values) });
+            }
+            for (const auto& [key, values] : animation.translations)
+            {
+                keys.push_back({ AnimationKeyKind::Translation, key, writer.AddBlob(values) });
+            }
+            record.keys.count = static_cast<uint32_t>(keys.size()) - record.keys.first;
+        }
+        writer.AddSection(SectionId::Animations, records);
+        writer.AddSection(SectionId::AnimationChannels, channels);
+        writer.AddSection(SectionId::AnimationSamplers, samplers);
+        writer.AddSection(SectionId::AnimationKeys, keys);
+    }
+    template<class AnimationT>
+    void ReadAnimations(const Reader& reader, std::vector<AnimationT>& animations)
+    {
+        std::span<const AnimationChannelRecord> channels = reader.Section<AnimationChannelRecord>(SectionId::AnimationChannels);
+        std::span<const AnimationSamplerRecord> samplers = reader.Section<AnimationSamplerRecord>(SectionId::AnimationSamplers);
+        std::span<const AnimationKeyRecord> keys = reader.Section<AnimationKeyRecord>(SectionId::AnimationKeys);
+        for (const AnimationRecord& record : reader.Section<AnimationRecord>(SectionId::Animations))
+        {
+            AnimationT& animation = animations.emplace_back();
+            animation.name = reader.String(record.name);
+            animation.duration = record.duration;
+            for (const AnimationChannelRecord& channelRecord : channels.subspan(record.channels.first, record.channels.count))
+            {
+                auto& channel = animation.channels.emplace_back();
+                channel.sampler = channelRecord.sampler;
+                channel.targetNode = channelRecord.targetNode;
+                channel.targetPath = reader.String(channelRecord.targetPath);
+            }
+            for (const AnimationSamplerRecord& samplerRecord : samplers.subspan(record.samplers.first, record.samplers.count))
+            {
+                auto& sampler = animation.samplers.emplace_back();
+                sampler.input = samplerRecord.input;
+                sampler.output = samplerRecord.output;
+                sampler.interpolation = reader.String(samplerRecord.interpolation);
+            }
+            for (const AnimationKeyRecord& key : keys.subspan(record.keys.first, record.keys.count))
+            {
+                switch (key.kind)
+                {
+                case AnimationKeyKind::Timeline: animation.timelines.emplace(key.key, reader.BlobToVector<float>(key.values)); break;
+                case AnimationKeyKind::Scale: animation.scales.emplace(key.key, reader.BlobToVector<DirectX::XMFLOAT3>(key.values)); break;
+                case AnimationKeyKind::Rotation: animation.rotations.emplace(key.key, reader.BlobToVector<DirectX::XMFLOAT4>(key.values)); break;
+                case AnimationKeyKind::Translation: animation.translations.emplace(key.key, reader.BlobToVector<DirectX::XMFLOAT3>(key.values)); break;
+                }
+            }
+        }
+    }
+
+    // ʃZNV̎QƂ؂
+    // materialDataSize : ReadMaterials œǂ Material::data ̑傫 (0 Ȃm߂Ȃ)
+    bool ValidateModelRecords(const Reader& reader, std::string& report, size_t materialDataSize = 0);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+// sƁE}VƂɓʂɂȂnbVƗ
+//   nbV : LbVɏݒ̒l (Options::Hash) ⃊vC̏Ԃ̔rɎg FNV-1a
+//    : GPU gȂmFEv (Source/Test  SELF_TEST) Ŗ񓯂͂`@
+namespace Deterministic
+{
+    // 32 rbg̒lɍ FNV-1a (32 rbg)
+    inline uint32_t Fnv1a32(std::initializer_list<uint32_t> values)
+    {
+        uint32_t hash = 2166136261u;
+        for (uint32_t value : values)
+        {
+            hash = (hash ^ value) * 16777619u;
+        }
+        return hash;
+    }
+
+    // float rbĝ܂ uint32_t ɂ (Fnv1a32 ɓnp)
+    inline uint32_t FloatBits(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // oCg FNV-1a (64 rbg) : Fnv1a64Offset n߂ hash ɑčĂ
+    constexpr uint64_t Fnv1a64Offset = 14695981039346656037ull;
+    inline void Fnv1a64(uint64_t& hash, const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    }
+
+    // `@ (W Numerical Recipes ̂)
+    class Random
+    {
+    public:
+        static constexpr uint32_t DefaultSeed = 12345u;
+
+        explicit Random(uint32_t seed = DefaultSeed) : state(seed) {}
+
+        // ̏ (ʂ̃rbg͎ẐŁAgŏʂ̃rbg)
+        uint32_t Next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return state;
+        }
+        // [0, 1)
+        float NextFloat() { return static_cast<float>(Next() >> 8) / static_cast<float>(1u << 24); }
+        // [0, range)
+        uint32_t NextRange(uint32_t range) { return (Next() >> 8) % range; }
+
+    private:
+        uint32_t state;
+    };
+}
@@ -2,6 +2,8 @@
 
 #include <windows.h>
 
+#include <chrono>
+
 class HighResTimer
 {
 public:
@@ -136,16 +138,12 @@ private:
 
 class benchmark
 {
-	LARGE_INTEGER ticks_per_second;
-	LARGE_INTEGER start_ticks;
-	LARGE_INTEGER current_ticks;
+	// QueryPerformanceCounter gȂ̂ŁAEBhE (HeadlessRunner) ł̊ł悤Ɍv
+	std::chrono::steady_clock::time_point start_ticks;
 
 public:
-	benchmark()
+	benchmark() : start_ticks(std::chrono::steady_clock::now())
 	{
-		QueryPerformanceFrequency(&ticks_per_second);
-		QueryPerformanceCounter(&start_ticks);
-		QueryPerformanceCounter(&current_ticks);
 	}
 	~benchmark() = default;
 	benchmark(const benchmark&) = delete;
@@ -155,11 +153,10 @@ public:
 
 	void begin()
 	{
-		QueryPerformanceCounter(&start_ticks);
+		start_ticks = std::chrono::steady_clock::now();
 	}
 	float end()
 	{
-		QueryPerformanceCounter(&current_ticks);
-		return static_cast<float>(current_ticks.QuadPart - start_ticks.QuadPart) / static_cast<float>(ticks_per_second.QuadPart);
+		return std::chrono::duration<float>(std::chrono::steady_clock::now() - start_ticks).count();
 	}
 };
@@ -5,6 +5,7 @@
 #include "Components/Render/MeshComponent.h"
 #include "Components/CollisionShape/ShapeComponent.h"
 #include "Components/Effect/EffectComponent.h"
+#include "Game/Utils/ModelAssets.h"
 
 //  enemy ɂ
 // boxComponent->SetResponseToLayer(CollisionLayer::Projectile, CollisionComponent::CollisionResponse::Trigger);
@@ -28,7 +29,7 @@ public:
     {
         // `pR|[lgǉ
         skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent");
-        skeltalMeshComponent->SetModel("./Data/Models/Beam/beam.gltf");
+        ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::Beam);
         //skeltalMeshComponent->model->isModelInMeters = false;
         SetPosition(transform.GetLocation());
         //skeltalMeshComponent->SetIsVisible(false);
@@ -182,11 +182,11 @@ public:
             {
                 if (auto build = dynamic_cast<Building*>(result.actor))
                 {
-                    build->preSkeltalMeshComponent->model->SetAlpha(0.3f);
+                    build->preSkeltalMeshComponent->instanceParameters.SetAlpha(0.3f);
                 }
                 else if (auto bossBuild = dynamic_cast<BossBuilding*>(result.actor))
                 {
-                    bossBuild->preSkeltalMeshComponent->model->SetAlpha(0.3f);
+                    bossBuild->preSkeltalMeshComponent->instanceParameters.SetAlpha(0.3f);
                 }
             }
             else
@@ -195,11 +195,11 @@ public:
                 {
                     if (auto build = std::dynamic_pointer_cast<Building>(actor))
                     {
-                        build->preSkeltalMeshComponent->model->SetAlpha(1.0f);
+                        build->preSkeltalMeshComponent->instanceParameters.SetAlpha(1.0f);
                     }
                     else if (auto bossBuild = std::dynamic_pointer_cast<BossBuilding>(actor))
                     {
-                        bossBuild->preSkeltalMeshComponent->model->SetAlpha(1.0f);
+                        bossBuild->preSkeltalMeshComponent->instanceParameters.SetAlpha(1.0f);
                     }
                 }
             }
@@ -16,7 +16,7 @@ public:
     {
         skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent");
         skeltalMeshComponent->SetModel("./Data/Effect/Models/ring.gltf");
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
 
         SetPosition(transform.GetLocation());
         SetQuaternionRotation(transform.GetRotation());
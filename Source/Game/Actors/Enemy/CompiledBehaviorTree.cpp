@@ -0,0 +1,375 @@
+#include "CompiledBehaviorTree.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+#include "ActionBase.h"
+#include "EnemyMath.h"
+#include "JudgmentBase.h"
+
+#include "Engine/Debug/Assert.h"
+
+void CompiledBehaviorTree::Builder::AddNode(const std::string& parentName, const std::string& entryName, int priority, BehaviorTree::SelectRule selectRule,
+	JudgmentFactory judgment, ActionFactory action)
+{
+	uint16_t parent = InvalidIndex;
+	if (parentName != "")
+	{
+		//eΒǉȂ (BehaviorTree::AddNode Ɠ)
+		auto it = indices.find(parentName);
+		if (it == indices.end())
+		{
+			return;
+		}
+		parent = it->second;
+	}
+	else if (!entries.empty())
+	{
+		// 1 
+		return;
+	}
+	_ASSERT_EXPR(entries.size() < InvalidIndex, L"CompiledBehaviorTree : too many nodes");
+
+	const uint16_t index = static_cast<uint16_t>(entries.size());
+	Entry& entry = entries.emplace_back();
+	entry.name = entryName;
+	entry.priority = priority;
+	entry.selectRule = selectRule;
+	entry.judgment = judgment;
+	entry.action = action;
+	indices.emplace(entryName, index);
+	if (parent != InvalidIndex)
+	{
+		_ASSERT_EXPR(entries[parent].children.size() < MaxChildren, L"CompiledBehaviorTree : too many children");
+		entries[parent].children.push_back(index);
+	}
+}
+
+std::shared_ptr<const CompiledBehaviorTree> CompiledBehaviorTree::Builder::Compile() const
+{
+	std::shared_ptr<CompiledBehaviorTree> tree = std::make_shared<CompiledBehaviorTree>();
+	if (entries.empty())
+	{
+		return tree;
+	}
+
+	//Dŕׂ (qĕ)
+	std::vector<uint16_t> order;
+	order.reserve(entries.size());
+	order.push_back(0);
+	std::vector<uint16_t> compiledIndex(entries.size(), InvalidIndex);
+	compiledIndex[0] = 0;
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		for (uint16_t child : entries[order[i]].children)
+		{
+			compiledIndex[child] = static_cast<uint16_t>(order.size());
+			order.push_back(child);
+		}
+	}
+
+	tree->nodes.resize(order.size());
+	tree->names.resize(order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		const Entry& entry = entries[order[i]];
+		Node& node = tree->nodes[i];
+		node.priority = entry.priority;
+		node.selectRule = entry.selectRule;
+		node.childCount = static_cast<uint16_t>(entry.children.size());
+		node.firstChild = entry.children.empty() ? InvalidIndex : compiledIndex[entry.children.front()];
+		if (entry.judgment)
+		{
+			node.judgment = static_cast<uint16_t>(tree->judgmentFactories.size());
+			tree->judgmentFactories.push_back(entry.judgment);
+		}
+		if (entry.action)
+		{
+			node.action = static_cast<uint16_t>(tree->actionFactories.size());
+			tree->actionFactories.push_back(entry.action);
+		}
+		if (entry.selectRule == BehaviorTree::SelectRule::Sequence || entry.selectRule == BehaviorTree::SelectRule::SequentialLooping)
+		{
+			node.sequenceSlot = tree->sequenceCount++;
+		}
+		tree->names[i] = entry.name;
+	}
+	return tree;
+}
+
+uint16_t CompiledBehaviorTree::FindNode(const std::string& name) const
+{
+	auto it = std::find(names.begin(), names.end(), name);
+	return it == names.end() ? InvalidIndex : static_cast<uint16_t>(it - names.begin());
+}
+
+BehaviorAgent::BehaviorAgent(std::shared_ptr<const CompiledBehaviorTree> tree, RiderEnemy* owner) : tree(std::move(tree))
+{
+	const CompiledBehaviorTree& compiled = *this->tree;
+	judgments.resize(compiled.GetJudgmentCount());
+	for (uint16_t slot = 0; slot < compiled.GetJudgmentCount(); ++slot)
+	{
+		judgments[slot] = compiled.GetJudgmentFactory(slot)(owner);
+	}
+	actions.resize(compiled.GetActionCount());
+	for (uint16_t slot = 0; slot < compiled.GetActionCount(); ++slot)
+	{
+		actions[slot] = compiled.GetActionFactory(slot)(owner);
+	}
+	sequenceSteps.resize(compiled.GetSequenceCount(), 0);
+}
+
+BehaviorAgent::~BehaviorAgent() = default;
+
+const std::string& BehaviorAgent::GetActiveNodeName() const
+{
+	static const std::string empty;
+	return HasActiveNode() ? tree->GetName(activeNode) : empty;
+}
+
+void BehaviorAgent::ResetBlackboard()
+{
+	std::fill(sequenceSteps.begin(), sequenceSteps.end(), 0);
+	sequenceStack.clear();
+}
+
+uint32_t BehaviorAgent::JudgeChildren(uint16_t node)
+{
+	const CompiledBehaviorTree::Node& parent = tree->GetNode(node);
+	uint32_t passed = 0;
+	for (uint16_t i = 0; i < parent.childCount; ++i)
+	{
+		const uint16_t judgment = tree->GetNode(parent.firstChild + i).judgment;
+		//NXȂΖɒǉ
+		if (judgment == CompiledBehaviorTree::InvalidIndex || judgments[judgment]->Judgment())
+		{
+			passed |= 1u << i;
+		}
+	}
+	return passed;
+}
+
+uint16_t BehaviorAgent::Select(uint16_t node, uint32_t passed)
+{
+	const CompiledBehaviorTree::Node& parent = tree->GetNode(node);
+	switch (parent.selectRule)
+	{
+	case BehaviorTree::SelectRule::Priority:
+	{
+		//ԗD揇ʂ (l) m[hAȂɓo^m[h
+		uint16_t selectNode = CompiledBehaviorTree::InvalidIndex;
+		int priority = INT_MAX;
+		for (uint16_t i = 0; i < parent.childCount; ++i)
+		{
+			const int nodePriority = tree->GetNode(parent.firstChild + i).priority;
+			if ((passed & (1u << i)) && nodePriority < priority)
+			{
+				priority = nodePriority;
+				selectNode = parent.firstChild + i;
+			}
+		}
+		return selectNode;
+	}
+	case BehaviorTree::SelectRule::Random:
+	{
+		if (passed == 0)
+		{
+			return CompiledBehaviorTree::InvalidIndex;
+		}
+		//NodeBase::SelectRandom ƓŁAʂq̒I
+		int passedCount = 0;
+		for (uint32_t bits = passed; bits; bits &= bits - 1)
+		{
+			++passedCount;
+		}
+		int selectNo = static_cast<int>(Mathf::RandomRange(0.0f, static_cast<float>(passedCount)));
+		if (selectNo >= passedCount) selectNo = passedCount - 1;
+		for (uint16_t i = 0; i < parent.childCount; ++i)
+		{
+			if ((passed & (1u << i)) && selectNo-- == 0)
+			{
+				return parent.firstChild + i;
+			}
+		}
+		return CompiledBehaviorTree::InvalidIndex;
+	}
+	case BehaviorTree::SelectRule::Sequence:
+	case BehaviorTree::SelectRule::SequentialLooping:
+	{
+		int32_t step = sequenceSteps[parent.sequenceSlot];
+		if (step >= parent.childCount)
+		{
+			//SequentialLooping ͍ŏASequence ͎Ɏsłm[hȂ
+			if (parent.selectRule == BehaviorTree::SelectRule::Sequence)
+			{
+				return CompiledBehaviorTree::InvalidIndex;
+			}
+			step = 0;
+		}
+		if (!(passed & (1u << step)))
+		{
+			return CompiledBehaviorTree::InvalidIndex;
+		}
+		//s̒ԃm[hƁAɎsXebvɕۑ
+		sequenceStack.push_back(node);
+		sequenceSteps[parent.sequenceSlot] = step + 1;
+		return parent.firstChild + static_cast<uint16_t>(step);
+	}
+	default:
+		return CompiledBehaviorTree::InvalidIndex;
+	}
+}
+
+uint16_t BehaviorAgent::Inference(uint16_t node)
+{
+	while (node != CompiledBehaviorTree::InvalidIndex)
+	{
+		const uint16_t result = Select(node, JudgeChildren(node));
+		//sΏIAΌ܂m[hŐ_𑱂
+		if (result == CompiledBehaviorTree::InvalidIndex || tree->GetNode(result).action != CompiledBehaviorTree::InvalidIndex)
+		{
+			return result;
+		}
+		node = result;
+	}
+	return CompiledBehaviorTree::InvalidIndex;
+}
+
+uint16_t BehaviorAgent::Run(uint16_t node, float elapsedTime)
+{
+	const uint16_t action = tree->GetNode(node).action;
+	if (action == CompiledBehaviorTree::InvalidIndex)
+	{
+		return CompiledBehaviorTree::InvalidIndex;
+	}
+	const ActionBase::State state = actions[action]->Run(elapsedTime);
+	if (state == ActionBase::State::Complete)
+	{
+		//V[PX̓rȂ炻n߂
+		if (sequenceStack.empty())
+		{
+			return CompiledBehaviorTree::InvalidIndex;
+		}
+		const uint16_t sequenceNode = sequenceStack.back();
+		sequenceStack.pop_back();
+		return Inference(sequenceNode);
+	}
+	else if (state == ActionBase::State::Failed)
+	{
+		return CompiledBehaviorTree::InvalidIndex;
+	}
+	//ێ
+	return node;
+}
+
+void BehaviorAgent::Tick(float elapsedTime)
+{
+	if (!HasActiveNode())
+	{
+		ResetBlackboard();
+		activeNode = Inference(tree->GetRoot());
+	}
+	if (HasActiveNode())
+	{
+		activeNode = Run(activeNode, elapsedTime);
+	}
+}
+
+void BehaviorAgent::TickBatch(BehaviorAgent* const* agents, size_t count, float elapsedTime)
+{
+	struct Pending
+	{
+		BehaviorAgent* agent;
+		uint16_t node;
+	};
+	//t[mۂȂ悤Ɏg
+	thread_local std::vector<Pending> pending;
+	thread_local std::vector<Pending> next;
+	thread_local std::vector<uint32_t> passed;
+	pending.clear();
+
+	//_KvȓGn߂
+	for (size_t i = 0; i < count; ++i)
+	{
+		BehaviorAgent* agent = agents[i];
+		if (!agent->HasActiveNode())
+		{
+			agent->ResetBlackboard();
+			const uint16_t root = agent->tree->GetRoot();
+			if (root != CompiledBehaviorTree::InvalidIndex)
+			{
+				pending.push_back({ agent, root });
+			}
+		}
+	}
+
+	//c[̓ԃm[hɂG܂Ƃ߂āAq̔qƂɑčs
+	while (!pending.empty())
+	{
+		std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b)
+			{
+				return a.agent->tree.get() != b.agent->tree.get() ? a.agent->tree.get() < b.agent->tree.get() : a.node < b.node;
+			});
+		next.clear();
+		for (size_t begin = 0; begin < pending.size();)
+		{
+			const CompiledBehaviorTree* tree = pending[begin].agent->tree.get();
+			const uint16_t node = pending[begin].node;
+			size_t end = begin + 1;
+			while (end < pending.size() && pending[end].agent->tree.get() == tree && pending[end].node == node)
+			{
+				++end;
+			}
+
+			const CompiledBehaviorTree::Node& parent = tree->GetNode(node);
+			passed.assign(end - begin, 0);
+			for (uint16_t i = 0; i < parent.childCount; ++i)
+			{
+				const uint16_t judgment = tree->GetNode(parent.firstChild + i).judgment;
+				const uint32_t bit = 1u << i;
+				if (judgment == CompiledBehaviorTree::InvalidIndex)
+				{
+					for (size_t k = begin; k < end; ++k)
+					{
+						passed[k - begin] |= bit;
+					}
+					continue;
+				}
+				for (size_t k = begin; k < end; ++k)
+				{
+					if (pending[k].agent->judgments[judgment]->Judgment())
+					{
+						passed[k - begin] |= bit;
+					}
+				}
+			}
+
+			for (size_t k = begin; k < end; ++k)
+			{
+				BehaviorAgent* agent = pending[k].agent;
+				const uint16_t result = agent->Select(node, passed[k - begin]);
+				if (result == CompiledBehaviorTree::InvalidIndex || tree->GetNode(result).action != CompiledBehaviorTree::InvalidIndex)
+				{
+					agent->activeNode = result;
+				}
+				else
+				{
+					next.push_back({ agent, result });
+				}
+			}
+			begin = end;
+		}
+		pending.swap(next);
+	}
+
+	//ss
+	for (size_t i = 0; i < count; ++i)
+	{
+		BehaviorAgent* agent = agents[i];
+		if (agent->HasActiveNode())
+		{
+			agent->activeNode = agent->Run(agent->activeNode, elapsedTime);
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BehaviorTree.h"
+
+class ActionBase;
+class JudgmentBase;
+class RiderEnemy;
+
+//xgݗĂāAނ̓G̑SĂŋLrwCrAc[
+//	m[h͕D 1 ̔zɕׁAq firstChild  childCount  (OŒT̂͑gݗĂ鎞)
+//	Es͓GƂɏԂ (ownerAActionBase::step) ̂ŁAc[ɂ͍֐A
+//	BehaviorAgent ԍ (Xbg) ƂɍĎ
+//	_Es̋K BehaviorTree / NodeBase Ɠ
+class CompiledBehaviorTree
+{
+public:
+	using JudgmentFactory = std::unique_ptr<JudgmentBase>(*)(RiderEnemy* owner);
+	using ActionFactory = std::unique_ptr<ActionBase>(*)(RiderEnemy* owner);
+
+	template<class T>
+	static std::unique_ptr<JudgmentBase> MakeJudgment(RiderEnemy* owner) { return std::make_unique<T>(owner); }
+	template<class T>
+	static std::unique_ptr<ActionBase> MakeAction(RiderEnemy* owner) { return std::make_unique<T>(owner); }
+
+	static constexpr uint16_t InvalidIndex = 0xFFFF;
+	static constexpr uint16_t MaxChildren = 32;		//_Ŏq̔茋ʂrbgŎ
+
+	struct Node
+	{
+		uint16_t firstChild = InvalidIndex;
+		uint16_t childCount = 0;
+		uint16_t judgment = InvalidIndex;		//̃Xbg (Ζ)
+		uint16_t action = InvalidIndex;			//s̃Xbg (Βԃm[h)
+		uint16_t sequenceSlot = InvalidIndex;	//V[PX̃Xebv̃Xbg
+		BehaviorTree::SelectRule selectRule = BehaviorTree::SelectRule::Non;
+		int priority = 0;
+	};
+
+	//BehaviorTree::AddNode ƓԁEőgݗĂ
+	class Builder
+	{
+	public:
+		void AddNode(const std::string& parentName, const std::string& entryName, int priority, BehaviorTree::SelectRule selectRule,
+			JudgmentFactory judgment, ActionFactory action);
+		std::shared_ptr<const CompiledBehaviorTree> Compile() const;
+	private:
+		struct Entry
+		{
+			std::string name;
+			int priority = 0;
+			BehaviorTree::SelectRule selectRule = BehaviorTree::SelectRule::Non;
+			JudgmentFactory judgment = nullptr;
+			ActionFactory action = nullptr;
+			std::vector<uint16_t> children;
+		};
+		std::vector<Entry> entries;
+		std::unordered_map<std::string, uint16_t> indices;
+	};
+
+	uint16_t GetRoot() const { return nodes.empty() ? InvalidIndex : 0; }
+	const Node& GetNode(uint16_t index) const { return nodes[index]; }
+	size_t GetNodeCount() const { return nodes.size(); }
+	const std::string& GetName(uint16_t index) const { return names[index]; }
+	uint16_t FindNode(const std::string& name) const;
+
+	uint16_t GetJudgmentCount() const { return static_cast<uint16_t>(judgmentFactories.size()); }
+	uint16_t GetActionCount() const { return static_cast<uint16_t>(actionFactories.size()); }
+	uint16_t GetSequenceCount() const { return sequenceCount; }
+	JudgmentFactory GetJudgmentFactory(uint16_t slot) const { return judgmentFactories[slot]; }
+	ActionFactory GetActionFactory(uint16_t slot) const { return actionFactories[slot]; }
+
+private:
+	std::vector<Node> nodes;
+	std::vector<std::string> names;		//\Ep (_ł͎gȂ)
+	std::vector<JudgmentFactory> judgmentFactories;
+	std::vector<ActionFactory> actionFactories;
+	uint16_t sequenceCount = 0;
+};
+
+//1 ̂̓ǴALc[s
+//	ɂ V[PX̃Xebv (Xbg)  ߂钆ԃm[h̃X^bN ԍŎ (BehaviorData ̑)
+class BehaviorAgent
+{
+public:
+	BehaviorAgent(std::shared_ptr<const CompiledBehaviorTree> tree, RiderEnemy* owner);
+	~BehaviorAgent();
+	BehaviorAgent(const BehaviorAgent&) = delete;
+	BehaviorAgent& operator=(const BehaviorAgent&) = delete;
+
+	//s̃m[hΐ_AΎs (RiderEnemy::Update ŌĂł ActiveNodeInference + Run Ɠ)
+	void Tick(float elapsedTime);
+
+	//܂Ƃ߂čXV : _KvȓG𓯂ԃm[hƂɏW߁Aq̔G܂őčs
+	//	(1 ̂̒ł̔̏Ԃ Tick Ɠ)Ǎōss
+	static void TickBatch(BehaviorAgent* const* agents, size_t count, float elapsedTime);
+
+	uint16_t GetActiveNode() const { return activeNode; }
+	bool HasActiveNode() const { return activeNode != CompiledBehaviorTree::InvalidIndex; }
+	//s̃m[h̖O (΋)
+	const std::string& GetActiveNodeName() const;
+	const CompiledBehaviorTree& GetTree() const { return *tree; }
+
+private:
+	//ɂ (BehaviorData::Init)
+	void ResetBlackboard();
+	//q̔ : ʂrbg𗧂Ă
+	uint32_t JudgeChildren(uint16_t node);
+	//茋ʂI[ŎqI (V[PXȂ獕i߂)
+	uint16_t Select(uint16_t node, uint32_t passed);
+	//node sm[h܂Ő_ (NodeBase::Inference)
+	uint16_t Inference(uint16_t node);
+	//ssāA̎sm[hԂ (BehaviorTree::Run)
+	uint16_t Run(uint16_t node, float elapsedTime);
+
+	std::shared_ptr<const CompiledBehaviorTree> tree;
+	std::vector<std::unique_ptr<JudgmentBase>> judgments;
+	std::vector<std::unique_ptr<ActionBase>> actions;
+
+	//
+	std::vector<int32_t> sequenceSteps;
+	std::vector<uint16_t> sequenceStack;
+
+	uint16_t activeNode = CompiledBehaviorTree::InvalidIndex;
+};
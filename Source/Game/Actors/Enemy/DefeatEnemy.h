@@ -23,10 +23,10 @@ public:
         skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss_defeat.gltf");
         skeltalMeshComponent->SetMaterialPS("./Shader/TestPS.cso", "L_emission2");
         skeltalMeshComponent->SetMaterialPS("./Shader/TestPS.cso", "L_boss_emission");
-        skeltalMeshComponent->model->cpuColor.x = 0.0f;
+        skeltalMeshComponent->instanceParameters.cpuColor.x = 0.0f;
         //skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_emission2");
         //skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_boss_emission");
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         //skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss_defeat.gltf");
         const std::vector<std::string> animationFilenames =
         {
@@ -66,7 +66,7 @@ public:
         elapsedTime += deltaTime;
         if (elapsedTime >= 4.09f)
         {
-            skeltalMeshComponent->model->cpuColor.x = 1.0f;
+            skeltalMeshComponent->instanceParameters.cpuColor.x = 1.0f;
         }
 
         if (!animationController_->IsPlayAnimation())
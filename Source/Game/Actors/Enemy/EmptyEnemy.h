@@ -9,6 +9,7 @@
 #include "Components/Transform/Transform.h"
 #include "Game/Actors/Beam/Beam.h"
 #include "Game/Managers/TutorialSystem.h"
+#include "Game/Utils/ModelAssets.h"
 
 class EmptyEnemy :public Enemy
 {
@@ -27,11 +28,11 @@ public:
     {
         std::shared_ptr<SkeletalMeshComponent> skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent");
         // fmF
-        skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss_idle.gltf");
+        ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::Boss);
         skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_emission2");
         skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_boss_emission");
 
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         // Aj[VRg[[쐬
 
         const std::vector<std::string> animationFilenames =
@@ -25,6 +25,39 @@
 //             [ Idle  i[j
 
 #if 1
+std::shared_ptr<const CompiledBehaviorTree> RiderEnemy::GetSharedBehaviorTree()
+{
+    static const std::shared_ptr<const CompiledBehaviorTree> tree = []()
+        {
+            using Tree = CompiledBehaviorTree;
+            Tree::Builder builder;
+
+            builder.AddNode("", "Root", 0, BehaviorTree::SelectRule::Priority, nullptr, nullptr);
+
+            builder.AddNode("Root", "StartPerf", 0, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<StartPerfJudgment>, &Tree::MakeAction<StartPerfAction>);
+            builder.AddNode("Root", "Damage", 1, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<DamageJudgment>, &Tree::MakeAction<DamageAction>);
+            //builder.AddNode("Root", "Change", 1, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<ChangeJudgment>, &Tree::MakeAction<ChangeAction>);
+            builder.AddNode("Root", "Battle", 2, BehaviorTree::SelectRule::Priority, &Tree::MakeJudgment<BattleJudgment>, nullptr);
+            builder.AddNode("Root", "Scout", 3, BehaviorTree::SelectRule::Priority, nullptr, nullptr);
+
+            builder.AddNode("Battle", "Special", 0, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<SpecialJudgment>, &Tree::MakeAction<SpecialAction>);
+            builder.AddNode("Battle", "Terrain", 1, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<TerrainJudgment>, &Tree::MakeAction<TerrainAction>);
+            builder.AddNode("Battle", "Pursuit", 2, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<PursuitJudgment>, &Tree::MakeAction<PursuitAction>);
+            builder.AddNode("Battle", "Attack", 3, BehaviorTree::SelectRule::Random, &Tree::MakeJudgment<AttackJudgment>, nullptr);
+
+            builder.AddNode("Attack", "Normal", 0, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<NormalJudgment>, &Tree::MakeAction<NormalAction>);
+            builder.AddNode("Attack", "Dash", 1, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<ChargeJudgment>, &Tree::MakeAction<DashAction>);
+            builder.AddNode("Attack", "Bombing", 2, BehaviorTree::SelectRule::Non, nullptr, &Tree::MakeAction<BombingAction>);
+            builder.AddNode("Attack", "Summon", 3, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<SummonJudgment>, &Tree::MakeAction<SummonAction>);
+
+            builder.AddNode("Scout", "CoolPursuit", 0, BehaviorTree::SelectRule::Non, &Tree::MakeJudgment<CoolPursuitJudgment>, &Tree::MakeAction<CoolPursuitAction>);
+            builder.AddNode("Scout", "Idle", 1, BehaviorTree::SelectRule::Non, nullptr, &Tree::MakeAction<IdleAction>);
+
+            return builder.Compile();
+        }();
+    return tree;
+}
+
 RiderEnemy::RiderEnemy(const std::string& modelName) :Enemy(modelName)
 {
     //// œ蔻ǉ
@@ -34,32 +67,7 @@ RiderEnemy::RiderEnemy(const std::string& modelName) :Enemy(modelName)
     //SphereShape enemyColliderShape;
     //colliderComponent.SetShape(enemyColliderShape);
 
-    behaviorData = new BehaviorData();
-    aiTree = new BehaviorTree(this);
-
-    aiTree->AddNode("", "Root", 0, BehaviorTree::SelectRule::Priority, nullptr, nullptr);
-
-    aiTree->AddNode("Root", "StartPerf", 0, BehaviorTree::SelectRule::Non, new StartPerfJudgment(this), new StartPerfAction(this));
-    aiTree->AddNode("Root", "Damage", 1, BehaviorTree::SelectRule::Non, new DamageJudgment(this), new DamageAction(this));
-    //aiTree->AddNode("Root", "Change", 1, BehaviorTree::SelectRule::Non, new ChangeJudgment(this), new ChangeAction(this));
-    aiTree->AddNode("Root", "Battle", 2, BehaviorTree::SelectRule::Priority, new BattleJudgment(this), nullptr);
-    aiTree->AddNode("Root", "Scout", 3, BehaviorTree::SelectRule::Priority, nullptr, nullptr);
-
-    aiTree->AddNode("Battle", "Special", 0, BehaviorTree::SelectRule::Non, new SpecialJudgment(this), new SpecialAction(this));
-    aiTree->AddNode("Battle", "Terrain", 1, BehaviorTree::SelectRule::Non, new TerrainJudgment(this), new TerrainAction(this));
-    aiTree->AddNode("Battle", "Pursuit", 2, BehaviorTree::SelectRule::Non, new PursuitJudgment(this), new PursuitAction(this));
-    aiTree->AddNode("Battle", "Attack", 3, BehaviorTree::SelectRule::Random, new AttackJudgment(this), nullptr);
-
-    aiTree->AddNode("Attack", "Normal", 0, BehaviorTree::SelectRule::Non, new NormalJudgment(this), new NormalAction(this));
-    aiTree->AddNode("Attack", "Dash", 1, BehaviorTree::SelectRule::Non, new ChargeJudgment(this), new DashAction(this));
-    aiTree->AddNode("Attack", "Bombing", 2, BehaviorTree::SelectRule::Non, nullptr, new BombingAction(this));
-    aiTree->AddNode("Attack", "Summon", 3, BehaviorTree::SelectRule::Non, new SummonJudgment(this), new SummonAction(this));
-
-    //aiTree->AddNode("Charge", "Dash", 0, BehaviorTree::SelectRule::Non, nullptr, new DashAction(this));
-    //aiTree->AddNode("Charge", "Normal", 1, BehaviorTree::SelectRule::Non, nullptr, new NormalAction(this));
-
-    aiTree->AddNode("Scout", "CoolPursuit", 0, BehaviorTree::SelectRule::Non, new CoolPursuitJudgment(this), new CoolPursuitAction(this));
-    aiTree->AddNode("Scout", "Idle", 1, BehaviorTree::SelectRule::Non, nullptr, new IdleAction(this));
+    behaviorAgent = std::make_unique<BehaviorAgent>(GetSharedBehaviorTree(), this);
 
     hp = maxHp;
     radius = 1.0f;
@@ -96,8 +104,6 @@ RiderEnemy::RiderEnemy(const std::string& modelName) :Enemy(modelName)
 void RiderEnemy::Finalize()
 {
     walkAudioComponent->Stop();
-    delete aiTree;
-    delete behaviorData;
 }
 
 void RiderEnemy::Update(float elapsedTime)
@@ -108,17 +114,10 @@ void RiderEnemy::Update(float elapsedTime)
 
     hasHitThisFrame = false;
 
-    // ݎsĂm[h
-    if (activeNode == nullptr)
+    // s̃m[hΐ_A΃rwCrAc[m[hsB
+    if (behaviorAgent)
     {
-        // Ɏsm[h𐄘_B
-        activeNode = aiTree->ActiveNodeInference(behaviorData);
-    }
-    // ݎsm[h
-    if (activeNode != nullptr)
-    {
-        // rwCrAc[m[hsB
-        activeNode = aiTree->Run(activeNode, behaviorData, elapsedTime);
+        behaviorAgent->Tick(elapsedTime);
     }
 
     if (!canTerrain && GameManager::GetGameTimerStart())
@@ -189,9 +188,9 @@ void RiderEnemy::Update(float elapsedTime)
 
     //UI
     float normalizedHp = static_cast<float>(GetHP() / static_cast<float>(GetMaxHP()));
-    ObjectManager::Find("BossHP")->GetComponent<Mask>()->valueX = normalizedHp;
+    bossHpUI->GetComponent<Mask>()->valueX = normalizedHp;
     float normalizedEnergy = specialGauge / static_cast<float>(maxSpecialGauge);
-    ObjectManager::Find("BossEnergy")->GetComponent<Mask>()->valueX = normalizedEnergy;
+    bossEnergyUI->GetComponent<Mask>()->valueX = normalizedEnergy;
 
 
     // oꏊɃMÃfo
@@ -241,11 +240,7 @@ void RiderEnemy::Update(float elapsedTime)
     //ImGui::Checkbox("animtionIsLoop", &GetModelComponent().isAnimationLoop);
     //ImGui::Checkbox("animtionIsBlending", &GetModelComponent().isBlendingAnimation);
     //ImGui::InputInt("Current Animation Clip:", (int*)&GetModelComponent().animationClip);
-    std::string str = "";
-    if (activeNode != nullptr)
-    {
-        str = activeNode->GetName();
-    }
+    std::string str = GetActiveNodeName();
     auto player = std::dynamic_pointer_cast<Player>(GetOwnerScene()->GetActorManager()->GetActorByName("actor"));
     DirectX::XMFLOAT3 pos = player->GetPosition();
     ImGui::Begin("Rider Enemy");
@@ -270,6 +265,7 @@ void RiderEnemy::Update(float elapsedTime)
     ImGui::InputFloat("distMid", &distMid);
     ImGui::InputFloat("distFar", &distFar/*, 0.5f*/);
     ImGui::InputFloat3("playerPos", &pos.x);
+    ImGui::Text("behavior tree : %zu nodes shared, %ld agents", behaviorAgent ? behaviorAgent->GetTree().GetNodeCount() : 0, GetSharedBehaviorTree().use_count() - 1);
     ImGui::End();
 
 #endif
@@ -375,11 +371,7 @@ void RiderEnemy::UpdateParticle(ID3D11DeviceContext* immediate_context, float de
     {
         p->Initialize(immediate_context, deltaTime);
     }
-    std::string str = "";
-    if (activeNode != nullptr)
-    {
-        str = activeNode->GetName();
-    }
+    std::string str = GetActiveNodeName();
     if (str == "Attack")
     {//U̎
         p->Integrate(immediate_context, deltaTime);
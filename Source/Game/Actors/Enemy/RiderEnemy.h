@@ -7,11 +7,14 @@
 #include "BehaviorTree.h"
 #include "BehaviorData.h"
 #include "NodeBase.h"
+#include "CompiledBehaviorTree.h"
 #include "JudgmentDerived.h"
 #include "ActionDerived.h"
 
 #include "Components/Audio/AudioSourceComponent.h"
 #include "Components/Controller/ControllerComponent.h"
+#include "Widgets/ObjectManager.h"
+#include "Game/Utils/ModelAssets.h"
 
 struct ParticleSystem;
 
@@ -50,13 +53,13 @@ public:
         //skeltalMeshComponent->SetModel("..\\glTF-Sample-Models-main\\original\\EnemyTest\\Idle_Relaxed_B_HS.gltf");
         skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/plantune.gltf");
         //skeltalMeshComponent->model->isModelInMeters = false;
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         SetScale(DirectX::XMFLOAT3(0.5f, 0.5f, 0.5f));
 #else // fmF
-        skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss_idle.gltf");
+        ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::Boss);
         skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_emission2");
         skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_boss_emission");
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         //SetScale(DirectX::XMFLOAT3(0.5f, 0.5f, 0.5f));
 #endif
         SetPosition(transform.GetLocation());
@@ -69,28 +72,7 @@ public:
         SetPosition({ 0,10,0.1f });
 
         //SetPosition(DirectX::XMFLOAT3(3.0f, 0.0f, -5.0f));
-        const std::vector<std::string> animationFilenames =
-        {
-            "./Data/Models/Characters/Enemy/BOS_walk.gltf",
-            "./Data/Models/Characters/Enemy/BOS_punch.gltf",
-            "./Data/Models/Characters/Enemy/yobi.gltf",
-            "./Data/Models/Characters/Enemy/rotate.gltf",
-            "./Data/Models/Characters/Enemy/rotate_end.gltf",
-            "./Data/Models/Characters/Enemy/jump_yobi.gltf",
-            "./Data/Models/Characters/Enemy/jump_air.gltf",
-            "./Data/Models/Characters/Enemy/jump_landing.gltf",
-            "./Data/Models/Characters/Enemy/jump_landing2.gltf",
-            "./Data/Models/Characters/Enemy/specal_move.gltf",
-            "./Data/Models/Characters/Enemy/aristrike.gltf",
-            "./Data/Models/Characters/Enemy/BOS_damage.gltf",
-
-            //"./Data/Models/Characters/Enemy/.gltf",
-
-            //"..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Ability_E_InMotion.glb",
-            //"..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Primary_Attack_Fast_A.glb",
-        };
-
-        skeltalMeshComponent->AppendAnimations(animationFilenames);
+        skeltalMeshComponent->AppendAnimations(ModelAssets::Boss.animationFilenames);
 
         // Aj[VRg[[쐬
         auto controller = std::make_shared<AnimationController>(skeltalMeshComponent.get());
@@ -173,11 +155,11 @@ public:
 
         // MÃfR|[lgǉ
         gearInMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("gearInComponent", "skeltalComponent");
-        gearInMeshComponent->SetModel("./Data/Effect/Models/gear_effect_in.gltf");
+        ModelAssets::SetModel(*gearInMeshComponent, ModelAssets::GearEffectIn);
         gearInMeshComponent->SetIsCastShadow(false);
         gearInMeshComponent->SetIsVisible(false);
         gearOutMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("gearOutComponent", "skeltalComponent");
-        gearOutMeshComponent->SetModel("./Data/Effect/Models/gear_effect.gltf");
+        ModelAssets::SetModel(*gearOutMeshComponent, ModelAssets::GearEffectOut);
         gearOutMeshComponent->SetIsCastShadow(false);
         gearOutMeshComponent->SetIsVisible(false);
 
@@ -481,6 +463,9 @@ private:
     float specialGauge = 0;
     //őKEQ[W
     const float maxSpecialGauge = 40;
+    // HUD (t[̂Ńnhň)
+    GameObjectRef bossHpUI{ "BossHP" };
+    GameObjectRef bossEnergyUI{ "BossEnergy" };
     //KEZoǂ
     bool canSpecial = false;
 
@@ -572,10 +557,15 @@ public:
     // GĂ邩ǂ
     bool isStartEnemyFall = false;
 private:
-    BehaviorTree* aiTree = nullptr;
-    BehaviorData* behaviorData = nullptr;
+    //c[͑SĂ RiderEnemy ŋLAGƂɂ͔Esƍ
+    std::unique_ptr<BehaviorAgent> behaviorAgent;
 public:
-    NodeBase* activeNode = nullptr;
+    //s̍s邩
+    bool HasActiveNode() const { return behaviorAgent && behaviorAgent->HasActiveNode(); }
+    //s̍s̖O (΋)
+    std::string GetActiveNodeName() const { return behaviorAgent ? behaviorAgent->GetActiveNodeName() : std::string(); }
+    //RiderEnemy ̃rwCrAc[ (ŏɌĂ񂾎ɈxgݗĂ)
+    static std::shared_ptr<const CompiledBehaviorTree> GetSharedBehaviorTree();
 private:
     DirectX::XMFLOAT3 angle = { 0.0f,0.0f,0.0f };
 
@@ -13,6 +13,7 @@
 #include "Widgets/Mask.h"
 
 #include "Engine/Scene/Scene.h"
+#include "Game/Utils/ModelAssets.h"
 
 class TutorialEnemy :public Enemy
 {
@@ -30,7 +31,7 @@ public:
     {
         skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent");
         // fmF
-        skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss_idle.gltf");
+        ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::Boss);
         skeltalMeshComponent->SetMaterialPS("./Shader/TestPS.cso", "L_emission2");
         skeltalMeshComponent->SetMaterialPS("./Shader/TestPS.cso", "L_boss_emission");
         //skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_emission2");
@@ -40,7 +41,7 @@ public:
         {
             "./Data/Models/Characters/Enemy/jump_landing2.gltf",
         };
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::RH_Y_UP;
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::RH_Y_UP);
         skeltalMeshComponent->AppendAnimations(animationFilenames);
 
         // Aj[VRg[[쐬
@@ -101,20 +102,23 @@ public:
         buildAudioComponet->SetSource(L"./Data/Sound/SE/bill_spawn.wav");
     }
     std::shared_ptr<AudioSourceComponent> buildAudioComponet;
+    // HUD (t[̂Ńnhň)
+    GameObjectRef bossHpUI{ "BossHP" };
+    GameObjectRef bossEnergyUI{ "BossEnergy" };
     void Update(float deltaTime)override
     {
         float normalizedHP = static_cast<float>(GetHp() / 210.0f);
-        if (auto hpGauge = ObjectManager::Find("BossHP"))
+        if (auto hpGauge = bossHpUI.Get())
         {
             hpGauge->GetComponent<Mask>()->valueX = normalizedHP;
-            ObjectManager::Find("BossEnergy")->GetComponent<Mask>()->valueX = 0.0f;
+            bossEnergyUI->GetComponent<Mask>()->valueX = 0.0f;
         }
 
         Character::Update(deltaTime);
         if (TutorialSystem::GetCurrentStep() == TutorialStep::BossBuild && !isPlayAnimation)
         {
             // VF[_[ύX
-            skeltalMeshComponent->model->cpuColor.x = 0.0f;
+            skeltalMeshComponent->instanceParameters.cpuColor.x = 0.0f;
             PlayAnimation("JumpLanding", false);
             isPlayAnimation = true;
         }
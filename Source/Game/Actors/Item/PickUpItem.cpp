@@ -12,7 +12,7 @@ void PickUpItem::Initialize(const Transform& transform)
     //skeltalMeshComponent->SetIsVisible(false); // ACeɈt[`悳Ă܂
     HRESULT hr= CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelEmissionPS.cso", skeltalMeshComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-    skeltalMeshComponent->model->emission = 15.0f;
+    skeltalMeshComponent->instanceParameters.emission = 15.0f;
     skeltalMeshComponent->SetIsCastShadow(false);
 
     SetPosition(transform.GetLocation());
@@ -49,7 +49,7 @@ void PickUpItem::Initialize()
     HRESULT hr= CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelEmissionPS.cso", skeltalMeshComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 
-    skeltalMeshComponent->model->emission = 15.0f;
+    skeltalMeshComponent->instanceParameters.emission = 15.0f;
     SetPosition(tempPosition);    // g[[[
 
     // 蔻̃R|[lgǉ
@@ -20,6 +20,7 @@
 
 // `[gAɎgp
 #include "Game/Managers/TutorialSystem.h"
+#include "Game/Utils/ModelAssets.h"
 
 void Player::Initialize(const Transform& transform)
 {
@@ -27,9 +28,9 @@ void Player::Initialize(const Transform& transform)
     skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent");
     //skeltalMeshComponent->SetModel("./Data/Models/Characters/Player/karichara.gltf");
 
-    skeltalMeshComponent->SetModel("./Data/Models/Characters/Player/chara_animation.gltf");
+    ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::Player);
     //CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelEmissionPS.cso", skeltalMeshComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
-    skeltalMeshComponent->model->emission = 5.0f;
+    skeltalMeshComponent->instanceParameters.emission = 5.0f;
     //skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss.gltf");
     //skeltalMeshComponent->SetModel("./Data/Models/Characters/Enemy/boss_idle.gltf");
     //skeltalMeshComponent->SetMaterialPS("./Shader/GltfModelEmissionPS.cso", "L_emission2");
@@ -47,7 +48,7 @@ void Player::Initialize(const Transform& transform)
         //"..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Ability_E_InMotion.glb",
         //"..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Primary_Attack_Fast_A.glb",
     };
-    skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+    skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
     //skeltalMeshComponent->AppendAnimations(animationFilenames);
     // Aj[VRg[[쐬
     auto controller = std::make_shared<AnimationController>(skeltalMeshComponent.get());
@@ -63,13 +64,13 @@ void Player::Initialize(const Transform& transform)
 
     // vC[̍̌
     leftComponent = this->NewSceneComponent<class SkeletalMeshComponent>("leftComponent", "skeltalComponent");
-    leftComponent->SetModel("./Data/Models/Characters/Player/PlayerSide/player_side_left.gltf");
+    ModelAssets::SetModel(*leftComponent, ModelAssets::PlayerSideLeft);
     leftComponent->SetRelativeLocationDirect(leftFirstPos);
     //CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelEmissionPS.cso", leftComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
     hr=CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelPlayerSidePS.cso", leftComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-    leftComponent->model->emission = 0.0f;
-    leftComponent->model->cpuColor = { 1.0f,1.0f,1.0f };
+    leftComponent->instanceParameters.emission = 0.0f;
+    leftComponent->instanceParameters.cpuColor = { 1.0f,1.0f,1.0f };
     // G̍U鍶 
     playerDamageLeft = this->NewSceneComponent<class SphereComponent>("playerDamageLeft", "skeltalComponent");
     playerDamageLeft->SetRadius(0.01f);
@@ -109,12 +110,12 @@ void Player::Initialize(const Transform& transform)
 
     // vC[̉Ě
     rightComponent = this->NewSceneComponent<class SkeletalMeshComponent>("rightComponent", "skeltalComponent");
-    rightComponent->SetModel("./Data/Models/Characters/Player/PlayerSide/player_side_right.gltf");
+    ModelAssets::SetModel(*rightComponent, ModelAssets::PlayerSideRight);
     rightComponent->SetRelativeLocationDirect(rightFirstPos);
     hr=CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelPlayerSidePS.cso", rightComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-    rightComponent->model->emission = 0.0f;
-    leftComponent->model->cpuColor = { 1.0f,1.0f,1.0f };
+    rightComponent->instanceParameters.emission = 0.0f;
+    leftComponent->instanceParameters.cpuColor = { 1.0f,1.0f,1.0f };
     // G̍UE 
     playerDamageRight = this->NewSceneComponent<class SphereComponent>("playerDamageRight", "skeltalComponent");
     playerDamageRight->SetRadius(0.01f);
@@ -336,7 +337,7 @@ void Player::Initialize(const Transform& transform)
             {// {XƓ
                 if (hitPair.second->name() == "capsuleComponent")
                 {
-                    if (auto node = boss->activeNode)
+                    if (boss->HasActiveNode())
                     {
                         // GԒǂ
                         if (IsBossInvincible())
@@ -415,7 +416,7 @@ void Player::Initialize(const Transform& transform)
                 }
                 else if (hitPair.second->name() == "bossHand")
                 {// {X̎ɓ
-                    if (auto node = boss->activeNode)
+                    if (boss->HasActiveNode())
                     {
                         // GԒǂ
                         if (IsBossInvincible())
@@ -537,10 +538,10 @@ void Player::Update(float elapsedTime)
 
     float leftT = std::clamp(static_cast<float>(leftItemCount) / static_cast<float>(leftItemMax), 0.0f, 1.0f);
     float curveT = 1.0f - (1.0f - leftT) * (1.0f - leftT);
-    leftComponent->model->emission = std::lerp(0.0f, 5.0f, curveT);
+    leftComponent->instanceParameters.emission = std::lerp(0.0f, 5.0f, curveT);
     float rightT = std::clamp(static_cast<float>(rightItemCount) / static_cast<float>(rightItemMax), 0.0f, 1.0f);
     float curveRT = 1.0f - (1.0f - rightT) * (1.0f - rightT);
-    rightComponent->model->emission = std::lerp(0.0f, 5.0f, curveRT);
+    rightComponent->instanceParameters.emission = std::lerp(0.0f, 5.0f, curveRT);
     // ԋE
     //if (auto enemy = std::dynamic_pointer_cast<RiderEnemy>(ActorManager::GetActorByName("enemy")))
     //{
@@ -584,15 +585,15 @@ void Player::Update(float elapsedTime)
 
 
     {// UI
-        if (GameObject* hpGuage = ObjectManager::Find("HPGuage"))
+        if (GameObject* hpGuage = hpGaugeUI.Get())
         {
             float normalizeHp = static_cast<float>(hp / static_cast<float>(maxHp));
             hpGuage->GetComponent<Mask>()->valueX = normalizeHp;
 
             float normalizedLeftItem = static_cast<float>(leftItemCount / static_cast<float>(leftItemMax));
-            ObjectManager::Find("LeftGauge")->GetComponent<Mask>()->valueY = normalizedLeftItem;
+            leftGaugeUI->GetComponent<Mask>()->valueY = normalizedLeftItem;
             float normalizedRightItem = static_cast<float>(rightItemCount / static_cast<float>(rightItemMax));
-            ObjectManager::Find("RightGauge")->GetComponent<Mask>()->valueY = normalizedRightItem;
+            rightGaugeUI->GetComponent<Mask>()->valueY = normalizedRightItem;
         }
     }
     {// GԂ̍XV
@@ -706,7 +707,7 @@ void Player::Update(float elapsedTime)
     case Player::State::StartCharge:
         currentTurnSpeed = minTurnSpeed;
         //if (effectChargeComponent->GetEffectState() == EffectComponent::EffectState::Ending)
-        if (InputSystem::GetInputState("MouseLeft", InputStateMask::Release))
+        if (InputSystem::GetInputState(INPUT_ACTION("MouseLeft"), InputStateMask::Release))
         {// `[WI
             state = Player::State::FireBeam;
         }
@@ -738,7 +739,7 @@ void Player::Update(float elapsedTime)
     float itemCount = static_cast<float>(rightItemCount + leftItemCount);
 
 
-    if (InputSystem::GetInputState("Enter", InputStateMask::Trigger) && itemCount > 0)
+    if (InputSystem::GetInputState(INPUT_ACTION("Enter"), InputStateMask::Trigger) && itemCount > 0)
     {
         DirectX::XMFLOAT3 dir = GetForward();
         DirectX::XMFLOAT3 pos = GetPosition();
@@ -821,9 +822,9 @@ void Player::Update(float elapsedTime)
         color.y = 1.0f;
         color.z = 1.0f;
     }
-    skeltalMeshComponent->model->cpuColor.x = color.x;
-    skeltalMeshComponent->model->cpuColor.y = color.y;
-    skeltalMeshComponent->model->cpuColor.z = color.z;
+    skeltalMeshComponent->instanceParameters.cpuColor.x = color.x;
+    skeltalMeshComponent->instanceParameters.cpuColor.y = color.y;
+    skeltalMeshComponent->instanceParameters.cpuColor.z = color.z;
 
     //MyQueryCallback callback;
 
@@ -909,7 +910,7 @@ void Player::Update(float elapsedTime)
 void Player::TryStartCharge()
 {
     float itemCount = static_cast<float>(rightItemCount + leftItemCount);
-    if (InputSystem::GetInputState("MouseLeft", InputStateMask::Trigger) && itemCount > 0)
+    if (InputSystem::GetInputState(INPUT_ACTION("MouseLeft"), InputStateMask::Trigger) && itemCount > 0)
     {
         // `[W̉Đ
         beamChargeAudioComponent->Play(XAUDIO2_LOOP_INFINITE);
@@ -26,6 +26,7 @@
 
 #include "Core/ActorManager.h"
 #include "Components/Audio/AudioSourceComponent.h"
+#include "Widgets/ObjectManager.h"
 
 
 
@@ -474,6 +475,11 @@ public:
     int leftItemMax = 15;
     int rightItemMax = 15;
 
+    // HUD (t[̂Ńnhň)
+    GameObjectRef hpGaugeUI{ "HPGuage" };
+    GameObjectRef leftGaugeUI{ "LeftGauge" };
+    GameObjectRef rightGaugeUI{ "RightGauge" };
+
     // ̃TCY
     DirectX::XMFLOAT3 leftFirstPos = { -0.5f,-0.5f,0.2f };
     DirectX::XMFLOAT3 rightFirstPos = { 0.5f,-0.5f,0.2f };
@@ -562,8 +568,8 @@ private:
                 return colorStops.front().second; 
             };
 
-        leftComponent->model->cpuColor = GetColor(leftItemCount);
-        rightComponent->model->cpuColor = GetColor(rightItemCount);
+        leftComponent->instanceParameters.cpuColor = GetColor(leftItemCount);
+        rightComponent->instanceParameters.cpuColor = GetColor(rightItemCount);
     }
 
 
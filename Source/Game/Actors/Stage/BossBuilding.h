@@ -27,6 +27,7 @@
 
 #include "Game/Utils/SpawnValidator.h"
 #include "Game/Utils/ShockWaveTargetRegistry.h"
+#include "Game/Utils/ModelAssets.h"
 #include "Stage.h"
 
 class BossBuilding :public Actor
@@ -69,16 +70,13 @@ public:
         auto t1 = std::chrono::high_resolution_clock::now();
         // ŏɕ`悳Õf
         preSkeltalMeshComponent = this->NewSceneComponent<class BuildMeshComponent>("preSkeltalMeshComponent");
-        preSkeltalMeshComponent->SetModel("./Data/Models/Building/bomb_bill.gltf", false);
+        ModelAssets::SetModel(*preSkeltalMeshComponent, ModelAssets::BossBuilding);
         //preSkeltalMeshComponent->SetModel("./Data/Effect/Models/bom_effect_out.gltf", false);
-        preSkeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        preSkeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         HRESULT hr= CreatePsFromCSO(Graphics::GetDevice(), "./Data/Shaders/BuildingPS.cso", preSkeltalMeshComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-        auto& model = preSkeltalMeshComponent->model;
-        for (auto& material : model->materials)
-        {// material S BLEND ɕύX
-            material.data.alphaMode = 2; // BLEND
-        }
+        // material S BLEND ɕύX
+        preSkeltalMeshComponent->SetMaterialsAlphaMode(2);
         float radius = 0.5f;
         float height = 3.0f;
         auto t2 = std::chrono::high_resolution_clock::now();
@@ -93,8 +91,8 @@ public:
         //auto t3 = std::chrono::high_resolution_clock::now();
         // IɎgp郂f
         skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent", "preSkeltalMeshComponent");
-        skeltalMeshComponent->SetModel("./Data/Models/Building/bomb_bill_hahen3.gltf", true);
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::BossBuildingFragments);
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         skeltalMeshComponent->SetRelativeLocationDirect(riseEnd);
         skeltalMeshComponent->SetIsVisible(false);
         auto t4 = std::chrono::high_resolution_clock::now();
@@ -144,8 +142,8 @@ public:
 
         //        
         shockWaveMeshComponent = this->NewSceneComponent<class ShockWaveModelComponent>("shockWaveMeshComponent", "preSkeltalMeshComponent");
-        shockWaveMeshComponent->SetModel("./Data/Effect/Models/blast_effect_test2.gltf");
-        shockWaveMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        ModelAssets::SetModel(*shockWaveMeshComponent, ModelAssets::BlastEffect);
+        shockWaveMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         shockWaveMeshComponent->SetRelativeScaleDirect(DirectX::XMFLOAT3(0.0f, 0.5f, 0.0f));
         // (2.5f, 1.0f, 2.5f)
 
@@ -166,8 +164,8 @@ public:
         auto t7 = std::chrono::high_resolution_clock::now();
 
         bombTimerMeshComponentUnder = this->NewSceneComponent<class SkeletalMeshComponent>("bombTimerMeshComponentUnder", "preSkeltalMeshComponent");
-        bombTimerMeshComponentUnder->SetModel("./Data/Effect/Models/bom_effect_out.gltf", true);
-        bombTimerMeshComponentUnder->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        ModelAssets::SetModel(*bombTimerMeshComponentUnder, ModelAssets::BombTimerOut);
+        bombTimerMeshComponentUnder->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         bombTimerMeshComponentUnder->SetIsCastShadow(false);
         bombTimerMeshComponentUnder->SetIsVisible(false);
         //bombTimerMeshComponentUnder->SetRelativeLocationDirect(DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f));
@@ -177,8 +175,8 @@ public:
         explodeTimer = MathHelper::RandomRange(3.0f, 5.0f);
 
         bombTimerMeshComponent= this->NewSceneComponent<class ShockWaveModelComponent>("bombTimerMeshComponent", "preSkeltalMeshComponent");
-        bombTimerMeshComponent->SetModel("./Data/Effect/Models/bom_effect_in.gltf");
-        bombTimerMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        ModelAssets::SetModel(*bombTimerMeshComponent, ModelAssets::BombTimerIn);
+        bombTimerMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         bombTimerMeshComponent->SetRelativeScaleDirect(DirectX::XMFLOAT3(0.0f, 0.5f, 0.0f));
         bombTimerMeshComponent->SetRelativeLocationDirect(DirectX::XMFLOAT3(0.0f, 1.0f, 0.02f));
         bombTimerMeshComponent->Initialize(0.1f, 2.15f, explodeTimer, 0.0f);
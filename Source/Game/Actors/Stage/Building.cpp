@@ -12,13 +12,13 @@ void Building::Update(float delta_time)
     case 0:
         break;
     case 1:
-        preSkeltalMeshComponent->model->meshes[0].primitives[0].material = 2;
+        preSkeltalMeshComponent->instanceParameters.SetPrimitiveMaterial(0, 0, 2);
         break;
     case 2:
-        preSkeltalMeshComponent->model->meshes[0].primitives[0].material = 1;
+        preSkeltalMeshComponent->instanceParameters.SetPrimitiveMaterial(0, 0, 1);
         break;
     case 3:
-        preSkeltalMeshComponent->model->meshes[0].primitives[0].material = 0;
+        preSkeltalMeshComponent->instanceParameters.SetPrimitiveMaterial(0, 0, 0);
         break;
     case 4:
         break;
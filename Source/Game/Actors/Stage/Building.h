@@ -25,6 +25,7 @@
 
 #include "Game/Utils/SpawnValidator.h"
 #include "Game/Utils/ShockWaveTargetRegistry.h"
+#include "Game/Utils/ModelAssets.h"
 #include "Stage.h"
 #include "Game/Managers/TutorialSystem.h"
 
@@ -55,15 +56,12 @@ public:
     {
         // ŏɕ`悳Õf
         preSkeltalMeshComponent = this->NewSceneComponent<class BuildMeshComponent>("preSkeltalMeshComponent");
-        preSkeltalMeshComponent->SetModel("./Data/Models/Building/build_materials.gltf", false);
-        preSkeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::RH_Y_UP;
+        ModelAssets::SetModel(*preSkeltalMeshComponent, ModelAssets::Building);
+        preSkeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::RH_Y_UP);
         HRESULT hr= CreatePsFromCSO(Graphics::GetDevice(), "./Data/Shaders/BuildingPS.cso", preSkeltalMeshComponent->pipeLineState_.pixelShader.ReleaseAndGetAddressOf());
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
-        auto& model = preSkeltalMeshComponent->model;
-        for (auto& material : model->materials)
-        {// material S BLEND ɕύX
-            material.data.alphaMode = 2; // BLEND
-        }
+        // material S BLEND ɕύX
+        preSkeltalMeshComponent->SetMaterialsAlphaMode(2);
         //preSkeltalMeshComponent->SetIsVisible(false);
         float radius = 0.5f;
         float height = 3.0f;
@@ -80,8 +78,8 @@ public:
 
         // r̂ꂫɎgp郂f
         skeltalMeshComponent = this->NewSceneComponent<class SkeletalMeshComponent>("skeltalComponent", "preSkeltalMeshComponent");
-        skeltalMeshComponent->SetModel("./Data/Models/TestCollision/test_hahen1.gltf", true);
-        skeltalMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        ModelAssets::SetModel(*skeltalMeshComponent, ModelAssets::BuildingFragments);
+        skeltalMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         skeltalMeshComponent->SetRelativeLocationDirect(riseEnd);
         skeltalMeshComponent->SetIsVisible(false);
 
@@ -133,9 +131,9 @@ public:
         //        
         shockWaveMeshComponent = this->NewSceneComponent<class ShockWaveModelComponent>("shockWaveMeshComponent", "preSkeltalMeshComponent");
         //shockWaveMeshComponent->SetModel("./Data/Effect/Models/blast_effect_test.gltf");  // blend
-        shockWaveMeshComponent->SetModel("./Data/Effect/Models/blast_effect_test2.gltf"); // opaque
+        ModelAssets::SetModel(*shockWaveMeshComponent, ModelAssets::BlastEffect); // opaque
         //shockWaveMeshComponent->SetModel("./Data/Effect/Models/ring.gltf");
-        shockWaveMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::LH_Y_UP;
+        shockWaveMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::LH_Y_UP);
         //shockWaveMeshComponent->SetRelativeScaleDirect(DirectX::XMFLOAT3(2.5f, 1.0f, 2.5f));
         shockWaveMeshComponent->SetRelativeScaleDirect(DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f));
         shockWaveMeshComponent->SetIsCastShadow(false);
@@ -259,7 +259,7 @@ private:
         {
             for (const auto& primitive : mesh.primitives)
             {
-                for (const auto& vertex : primitive.cachedVertices)
+                for (const auto& vertex : primitive.DecodeVertices())
                 {
                     ClothVertex clothVertex;
                     clothVertex.position = { vertex.position.x,vertex.position.y,vertex.position.z,1.0f };
@@ -648,7 +648,7 @@ public:
         using namespace DirectX;
         //clothMesh->Simulate(Graphics::GetDeviceContext());
 
-        if (InputSystem::GetInputState("Enter"))
+        if (InputSystem::GetInputState(INPUT_ACTION("Enter")))
         {
             SetPosition({ 0.0f,10.0f,0.0f });
         }
@@ -49,10 +49,20 @@ bool nullLoadImageData(tinygltf::Image*, const int, std::string*, std::string*,
 
 ClothSimulate::ClothSimulate(ID3D11Device* device, const std::string& filename) : filename(filename)
 {
+    std::filesystem::path cacheFilename(filename);
+    cacheFilename.replace_extension("clothCache");
+    // `̃LbV
     std::filesystem::path cerealFilename(filename);
     cerealFilename.replace_extension("clothCereal");
-    if (std::filesystem::exists(cerealFilename.c_str()))
+    // 摜̓}bṽf[^璼ڃeNX`̂ CreateAndUploadResources I܂ŊJĂ
+    MappedCache::Reader cache;
+    if (LoadMappedCache(cache, cacheFilename))
     {
+        // V~[VŎĝŒ_̓Rs[ς
+    }
+    else if (std::filesystem::exists(cerealFilename.c_str()))
+    {
+        // `ǂݍŐV`ɏ
         std::ifstream ifs(cerealFilename.c_str(), std::ios::binary);
         cereal::BinaryInputArchive deserialization(ifs);
         deserialization(
@@ -63,6 +73,7 @@ ClothSimulate::ClothSimulate(ID3D11Device* device, const std::string& filename)
         );
         deserialization(cereal::make_nvp("meshes", meshes));
         deserialization(cereal::make_nvp("textures", textures), cereal::make_nvp("images", images));
+        SaveMappedCache(cacheFilename);
     }
     else
     {
@@ -111,21 +122,58 @@ ClothSimulate::ClothSimulate(ID3D11Device* device, const std::string& filename)
         FetchTextures(device, *gltfModel);
         FetchMeshes(device, *gltfModel);
 
-        std::ofstream ofs(cerealFilename.c_str(), std::ios::binary);
-        cereal::BinaryOutputArchive serialization(ofs);
-        serialization(
-            cereal::make_nvp("scenes", scenes),
-            cereal::make_nvp("defaultScene", defaultScene),
-            cereal::make_nvp("nodes", nodes),
-            cereal::make_nvp("materials", materials)
-        );
-        serialization(cereal::make_nvp("meshes", meshes));
-        serialization(cereal::make_nvp("textures", textures), cereal::make_nvp("images", images));
+        SaveMappedCache(cacheFilename);
     }
     cbuffer = std::make_unique<ConstantBuffer<ClothSimulateCBuffer>>(device);
 
     CreateAndUploadResources(device);
 }
+
+namespace
+{
+    constexpr uint32_t ClothSimulateCacheType = MappedCache::MakeFourCC('C', 'L', 'T', 'H');
+}
+
+bool ClothSimulate::LoadMappedCache(MappedCache::Reader& reader, const std::filesystem::path& cacheFilename)
+{
+    if (!std::filesystem::exists(cacheFilename))
+    {
+        return false;
+    }
+    std::string report;
+    if (!reader.Open(cacheFilename, ClothSimulateCacheType, &report) || !MappedCache::ValidateModelRecords(reader, report, sizeof(Material::data)))
+    {// ĂEÂLbV͍蒼
+        OutputDebugStringA(("ClothSimulate : " + cacheFilename.string() + " : " + report + "\n").c_str());
+        return false;
+    }
+    std::span<const MappedCache::ModelRecord> model = reader.Section<MappedCache::ModelRecord>(MappedCache::SectionId::Model);
+    defaultScene = model.empty() ? 0 : model[0].defaultScene;
+    MappedCache::ReadScenes(reader, scenes);
+    MappedCache::ReadNodes(reader, nodes);
+    MappedCache::ReadMaterials(reader, materials);
+    MappedCache::ReadMeshes(reader, meshes, true);
+    MappedCache::ReadTextures(reader, textures, images, false);
+    return true;
+}
+
+void ClothSimulate::SaveMappedCache(const std::filesystem::path& cacheFilename) const
+{
+    MappedCache::Writer writer(ClothSimulateCacheType);
+    writer.AddSection(MappedCache::SectionId::Model, std::vector<MappedCache::ModelRecord>{ { defaultScene, 0 } });
+    MappedCache::WriteScenes(writer, scenes);
+    MappedCache::WriteNodes(writer, nodes);
+    MappedCache::WriteMaterials(writer, materials);
+    std::vector<MappedCache::PrimitiveRecord> primitives;
+    std::vector<MappedCache::AttributeRecord> attributes;
+    MappedCache::WriteMeshes(writer, meshes, primitives, attributes);
+    writer.AddSection(MappedCache::SectionId::Primitives, primitives);
+    writer.AddSection(MappedCache::SectionId::Attributes, attributes);
+    MappedCache::WriteTextures(writer, textures, images);
+    if (!writer.Save(cacheFilename))
+    {
+        OutputDebugStringA(("ClothSimulate : failed to write " + cacheFilename.string() + "\n").c_str());
+    }
+}
 void ClothSimulate::FetchNodes(const tinygltf::Model& gltfModel)
 {
     for (const tinygltf::Node& gltfNode : gltfModel.nodes)
@@ -702,15 +750,20 @@ void ClothSimulate::CreateAndUploadResources(ID3D11Device* device)
     // Create and upload textures on GPU
     for (Image& image : images)
     {
-        if (image.cacheData.size() > 0)
+        // LbV}bv摜̓Rs[ɂ̂܂ܓn
+        const unsigned char* imageData = image.cacheData.empty() ? image.mappedData : image.cacheData.data();
+        const size_t imageSize = image.cacheData.empty() ? image.mappedSize : image.cacheData.size();
+        if (imageSize > 0)
         {
             ID3D11ShaderResourceView* textureResourceView = NULL;
-            hr = LoadTextureFromMemory(device, image.cacheData.data(), image.cacheData.size(), &textureResourceView);
+            hr = LoadTextureFromMemory(device, imageData, imageSize, &textureResourceView);
             if (hr == S_OK)
             {
                 textureResourceViews.emplace_back().Attach(textureResourceView);
             }
             image.cacheData.clear();
+            image.mappedData = nullptr;
+            image.mappedSize = 0;
         }
         else
         {
@@ -25,6 +25,7 @@
 #include "Physics/Collider.h"
 #include "Graphics/Core/PipelineState.h"
 #include "Graphics/Core/ConstantBuffer.h"
+#include "Engine/Serialization/MappedCache.h"
 
 
 class ClothSimulate
@@ -514,6 +515,9 @@ public:
         bool asIs = false;
 
         std::vector<unsigned char> cacheData;
+        // }bvLbV̉摜f[^ (CreateAndUploadResources ܂ŗL)
+        const unsigned char* mappedData = nullptr;
+        size_t mappedSize = 0;
 
         template<class T>
         void serialize(T& archive)
@@ -539,6 +543,10 @@ private:
     void FetchNodes(const tinygltf::Model& gltf_model);
     void CumulateTransforms(std::vector<Node>& nodes);
     void FetchMeshes(ID3D11Device* device, const tinygltf::Model& gltf_model);
+
+    // LbV̓ǂݏ
+    bool LoadMappedCache(MappedCache::Reader& reader, const std::filesystem::path& cacheFilename);
+    void SaveMappedCache(const std::filesystem::path& cacheFilename) const;
 public:
     // CascadedShadowMaps
     Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShaderCSM;
@@ -3,6 +3,7 @@
 #include "Components/Render/MeshComponent.h"
 #include "Components/CollisionShape/StaticMeshCollisionComponent.h"
 #include "Components/CollisionShape/ShapeComponent.h"
+#include "Game/Utils/ModelAssets.h"
 class Stage :public Actor
 {
 public:
@@ -18,10 +19,10 @@ public:
     void Initialize(const Transform& transform)override
     {
         std::shared_ptr<StaticMeshComponent> staticMeshComponent = this->NewSceneComponent<class StaticMeshComponent>("staticMeshComponent");
-        staticMeshComponent->SetModel("./Data/Models/Stage/ExampleStage.gltf", true);
+        ModelAssets::SetModel(*staticMeshComponent, ModelAssets::ExampleStage);
         //staticMeshComponent->SetModel("./Data/Models/Stage/stage.gltf", true);
         //staticMeshComponent->model->isModelInMeters = false;
-        staticMeshComponent->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::RH_Y_UP;
+        staticMeshComponent->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::RH_Y_UP);
         SetEulerRotation(DirectX::XMFLOAT3(0.0f, 180.0f, 0.0f));
         //std::shared_ptr<SkeletalMeshComponent> staticMeshComponent = this->NewComponent<class SkeletalMeshComponent>("staticMeshComponent");
         //staticMeshComponent->SetModel("./Assets/Models/Stage/ExampleStage.gltf", true);
@@ -28,12 +28,12 @@ public:
         //stage->SetModel("./Data/Models/Title/title_yuka_kabe.gltf");
         stage->SetModel("./Data/Models/Objects/bmw_m4_dtm.glb");
         //stage->SetModel("./Data/Models/Stage/SpotLightStage/stydio_6.gltf");
-        stage->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::RH_Y_UP;
+        stage->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::RH_Y_UP);
         stage->SetRelativeScaleDirect({ -1.0f,1.0f,-1.0f });
 
         titleLogo = this->NewSceneComponent<StaticMeshComponent>("logoComponent", "empty");
         titleLogo->SetModel("./Data/Models/Title/title_rogo.gltf");
-        titleLogo->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::RH_Y_UP;
+        titleLogo->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::RH_Y_UP);
         titleLogo->SetRelativeScaleDirect({ -1.0f,1.0f,-1.0f });
         titleLogo->SetRelativeLocationDirect({ 0.0f,0.1f,-0.1f });      // yW 1.9f Ŕ͈͊O
         titleLogo->SetRelativeEulerRotationDirect({ 0.0f,-9.0f,0.0f });
@@ -47,8 +47,8 @@ public:
         //trafficLight = this->NewSceneComponent<SkeletalMeshComponent>("trafficLight", "empty");
         trafficLight = this->NewSceneComponent<StaticMeshComponent>("trafficLight", "empty");
         trafficLight->SetModel("./Data/Models/Stage/Props/traffic_light.gltf");
-        trafficLight->model->modelCoordinateSystem = InterleavedGltfModel::CoordinateSystem::RH_Y_UP;
-        trafficLight->model->emission = 1.0f;
+        trafficLight->SetCoordinateSystem(InterleavedGltfModel::CoordinateSystem::RH_Y_UP);
+        trafficLight->instanceParameters.emission = 1.0f;
         trafficLight->SetRelativeScaleDirect({ 2.0f,2.0f,2.0f });
         trafficLight->SetRelativeLocationDirect({ 4.25f,0.09f,7.27f });
         trafficLight->SetRelativeEulerRotationDirect({ -12.4f,8.169f,53.431f });
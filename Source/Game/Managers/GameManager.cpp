@@ -44,6 +44,7 @@ void GameManager::DebugRender(ID3D11DeviceContext* immediateContext)
 {
     itemManager_->DebugRender(immediateContext);
     buildingManager_->DebugRender(immediateContext);
+    ShapeRenderer::Flush(immediateContext);
 }
 
 void GameManager::Finalize()
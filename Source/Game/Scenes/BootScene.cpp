@@ -400,7 +400,7 @@ void BootScene::Update(float deltaTime)
     objectManager.Update(deltaTime);//ǉ
 
 #ifdef _DEBUG
-    if (InputSystem::GetInputState("Space", InputStateMask::Trigger))
+    if (InputSystem::GetInputState(INPUT_ACTION("Space"), InputStateMask::Trigger))
     {
         const char* types[] = { "0", "1" };
         Scene::_transition("LoadingScene", { std::make_pair("preload", "MainScene"), std::make_pair("type", types[rand() % 2]) });
@@ -471,6 +471,8 @@ void BootScene::Render(ID3D11DeviceContext* immediateContext, float deltaTime)
         ViewConstants data = camera->GetViewConstants();
         sceneRender.UpdateViewConstants(immediateContext, data);
     }
+    // epX̑OɃJEJXP[h̎őIʂĂ
+    PrepareVisibility(sceneRender);
 
     UpdateConstantBuffer(immediateContext);
 
@@ -33,6 +33,7 @@ bool LoadingScene::Initialize(ID3D11Device* device, UINT64 width, UINT height, c
     //hit_space_key = std::make_unique<Sprite>(device, L"./Data/Textures/Screens/LoadingScene/230x0w.png");
 
     bit_block_transfer = std::make_unique<FullScreenQuad>(device);
+    progressBar = std::make_unique<Sprite>(device, L"./Data/Textures/square.png");
     //CreatePsFromCSO(device, "./Shader/DiscoTunnelPS.cso", pixel_shaders[0].ReleaseAndGetAddressOf());
     //CreatePsFromCSO(device, "./Shader/RoundedLoadingPS.cso", pixel_shaders[1].ReleaseAndGetAddressOf());
     //renderingState = std::make_unique<decltype(renderingState)::element_type>(device);
@@ -88,6 +89,8 @@ void LoadingScene::Update(float deltaTime)
     shaderToy.iTime += deltaTime;
     shaderToy.iResolution.x = Graphics::GetScreenWidth();
     shaderToy.iResolution.y = Graphics::GetScreenHeight();
+    // v[h̐i݋ (\߂Ȃ悤ɑ傫g)
+    loadingProgress = (std::max)(loadingProgress, _preload_progress());
     if (_has_finished_preloading()/* && !enemy->GetAnimationController()->IsPlayAnimation()*/)
     {// ]O񂵂
         _transition(preload_scene, {});
@@ -109,6 +112,8 @@ void LoadingScene::Render(ID3D11DeviceContext* immediateContext, float deltaTime
         ViewConstants data = camera->GetViewConstants();
         sceneRender.UpdateViewConstants(immediateContext, data);
     }
+    // epX̑OɃJEJXP[h̎őIʂĂ
+    PrepareVisibility(sceneRender);
 
     UpdateConstantBuffer(immediateContext);
 
@@ -430,10 +435,32 @@ void LoadingScene::Render(ID3D11DeviceContext* immediateContext, float deltaTime
             fullscreenQuad->Blit(immediateContext, shader_resource_views, 0, _countof(shader_resource_views), finalPs.Get());
         }
     }
+
+    // ǂݍ݂̐i݋ (n̏ɐi񂾕d˂)
+    {
+        RenderState::BindBlendState(immediateContext, BLEND_STATE::ALPHA);
+        RenderState::BindDepthStencilState(immediateContext, DEPTH_STATE::ZT_OFF_ZW_OFF);
+        RenderState::BindRasterizerState(immediateContext, RASTERRIZER_STATE::SOLID_CULL_NONE);
+        const float screenWidth = static_cast<float>(Graphics::GetScreenWidth());
+        const float screenHeight = static_cast<float>(Graphics::GetScreenHeight());
+        const float barWidth = screenWidth * 0.6f;
+        const float barHeight = 12.0f;
+        const float barX = (screenWidth - barWidth) * 0.5f;
+        const float barY = screenHeight - 60.0f;
+        progressBar->Render(immediateContext, barX, barY, barWidth, barHeight, 0.1f, 0.1f, 0.1f, 0.6f, 0.0f);
+        progressBar->Render(immediateContext, barX, barY, barWidth * loadingProgress, barHeight, 1.0f, 1.0f, 1.0f, 0.9f, 0.0f);
+    }
 }
 
 
 void LoadingScene::DrawGui()
 {
     SceneBase::DrawGui();
+#ifdef USE_IMGUI
+    ImGui::Begin("Loading");
+    char overlay[32];
+    sprintf_s(overlay, "%.0f%%", loadingProgress * 100.0f);
+    ImGui::ProgressBar(loadingProgress, ImVec2(-1.0f, 0.0f), overlay);
+    ImGui::End();
+#endif
 }
@@ -79,6 +79,10 @@ class LoadingScene : public SceneBase
 
 public:
     size_t type = 1;
+    // v[h̃V[̓ǂݍ݂̐i݋ (0 - 1)
+    float loadingProgress = 0.0f;
+    // ǂݍ݂̐i݋ʉɏoo[ (ImGui gȂrhł悤)
+    std::unique_ptr<Sprite> progressBar;
     bool Initialize(ID3D11Device* device, UINT64 width, UINT height, const std::unordered_map<std::string, std::string>& props) override;
 
     void Update(float deltaTime) override;
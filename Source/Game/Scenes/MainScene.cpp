@@ -12,6 +12,8 @@
 #include "Graphics/Resource/GltfModelStaticBatching.h"
 #include "Engine/Utility/Win32Utils.h"
 #include "Engine/Utility/Timer.h"
+#include "Engine/Asset/AssetLoader.h"
+#include "Game/Utils/ModelAssets.h"
 //#include "Camera.h"
 #include "Physics/Physics.h"
 #include "Physics/PhysicsUtility.h"
@@ -152,6 +154,9 @@ void MainScene::Start()
     AudioSource* warning = warningObj->AddComponent<AudioSource>(L"./Data/Sound/SE/warning.wav");
     warning->SetVolume(1.0f);
     warning->Play();
+
+    //dȂɐȂ悤ɁAʉ̐OčĂ
+    Audio::PrewarmOneShot(L"./Data/Sound/SE/missile_explosion.wav", 8);
 }
 
 void MainScene::Update(float deltaTime)
@@ -194,7 +199,7 @@ void MainScene::Update(float deltaTime)
     waitHandler.Update(dummy, deltaTime);
     if (isBossDeath || isPlayerDeath)
     {
-        ObjectManager::Find("Fade")->GetComponent<Image>()->color.a = fadeValue;
+        fadeUI->GetComponent<Image>()->color.a = fadeValue;
     }
 
     if (waitHandler.IsCompleted())
@@ -262,7 +267,7 @@ void MainScene::Update(float deltaTime)
     }
 #ifdef _DEBUG
     //fobOp
-    if (InputSystem::GetInputState("E", InputStateMask::Trigger))
+    if (InputSystem::GetInputState(INPUT_ACTION("E"), InputStateMask::Trigger))
     {
         //player->ApplyDirectHpDamage(100);
     }
@@ -656,6 +661,8 @@ void MainScene::Render(ID3D11DeviceContext* immediateContext, float elapsedTime)
         ViewConstants data = camera->GetViewConstants();
         actorRender.UpdateViewConstants(immediateContext, data);
     }
+    // epX̑OɃJEJXP[h̎őIʂĂ
+    PrepareVisibility(actorRender);
 
     UpdateConstantBuffer(immediateContext);
 
@@ -934,15 +941,12 @@ void MainScene::Render(ID3D11DeviceContext* immediateContext, float elapsedTime)
 
                         debri->GetMeshComponent()->SetPipeLineState(pipelineState);
 
-                        for (auto& material : debri->GetMeshComponent()->model->materials)
-                        {
-                            material.replacedPixelShader = effectSystem->dissolvePixelShader;
-                        }
+                        debri->GetMeshComponent()->ReplaceMaterialsPS(effectSystem->dissolvePixelShader);
                         //if (value > 1.f) value = 1.f;
-                        debri->GetMeshComponent()->model->SetDisolveFactor(build->GetDissolveRate());
+                        debri->GetMeshComponent()->instanceParameters.SetDisolveFactor(build->GetDissolveRate());
 
                         //`
-                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState);
+                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState, debri->GetMeshComponent()->instanceParameters);
 
                         //effectSystem->computeParticles[9]->PixelEmitEnd(immediateContext);
                         //meshComponent->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask);
@@ -967,15 +971,12 @@ void MainScene::Render(ID3D11DeviceContext* immediateContext, float elapsedTime)
 
                         debri->GetMeshComponent()->SetPipeLineState(pipelineState);
 
-                        for (auto& material : debri->GetMeshComponent()->model->materials)
-                        {
-                            material.replacedPixelShader = effectSystem->dissolvePixelShader;
-                        }
+                        debri->GetMeshComponent()->ReplaceMaterialsPS(effectSystem->dissolvePixelShader);
                         //if (value > 1.f) value = 1.f;
-                        debri->GetMeshComponent()->model->SetDisolveFactor(build->GetDissolveRate());
+                        debri->GetMeshComponent()->instanceParameters.SetDisolveFactor(build->GetDissolveRate());
 
                         //`
-                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState);
+                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState, debri->GetMeshComponent()->instanceParameters);
 
                         //effectSystem->computeParticles[9]->PixelEmitEnd(immediateContext);
                         //meshComponent->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask);
@@ -1187,15 +1188,12 @@ void MainScene::Render(ID3D11DeviceContext* immediateContext, float elapsedTime)
 
                         debri->GetMeshComponent()->SetPipeLineState(pipelineState);
 
-                        for (auto& material : debri->GetMeshComponent()->model->materials)
-                        {
-                            material.replacedPixelShader = effectSystem->dissolvePixelShader;
-                        }
+                        debri->GetMeshComponent()->ReplaceMaterialsPS(effectSystem->dissolvePixelShader);
                         //if (value > 1.f) value = 1.f;
-                        debri->GetMeshComponent()->model->SetDisolveFactor(build->GetDissolveRate());
+                        debri->GetMeshComponent()->instanceParameters.SetDisolveFactor(build->GetDissolveRate());
 
                         //`
-                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState);
+                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState, debri->GetMeshComponent()->instanceParameters);
 
                         //effectSystem->computeParticles[9]->PixelEmitEnd(immediateContext);
                         //meshComponent->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask);
@@ -1220,15 +1218,12 @@ void MainScene::Render(ID3D11DeviceContext* immediateContext, float elapsedTime)
 
                         debri->GetMeshComponent()->SetPipeLineState(pipelineState);
 
-                        for (auto& material : debri->GetMeshComponent()->model->materials)
-                        {
-                            material.replacedPixelShader = effectSystem->dissolvePixelShader;
-                        }
+                        debri->GetMeshComponent()->ReplaceMaterialsPS(effectSystem->dissolvePixelShader);
                         //if (value > 1.f) value = 1.f;
-                        debri->GetMeshComponent()->model->SetDisolveFactor(build->GetDissolveRate());
+                        debri->GetMeshComponent()->instanceParameters.SetDisolveFactor(build->GetDissolveRate());
 
                         //`
-                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState);
+                        debri->GetMeshComponent()->model->Render(immediateContext, world, debri->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::All, pipelineState, debri->GetMeshComponent()->instanceParameters);
 
                         //effectSystem->computeParticles[9]->PixelEmitEnd(immediateContext);
                         //meshComponent->model->Render(immediateContext, world, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Mask);
@@ -1400,93 +1395,13 @@ bool MainScene::Uninitialize(ID3D11Device* device)
 }
 
 
-void MainScene::LoadModel()
+void MainScene::RequestAssets(AssetLoader& loader)
 {
-    //char aaa[256];
-    //DWORD time = timeGetTime();
-    benchmark actor_timer;
-    benchmark stage_timer;
-    benchmark enemy_timer;
-
-    //foCX擾
-    ID3D11Device* device = Graphics::GetDevice();
-    std::thread actorThread = std::thread([&]()
-        {
-            actor_timer.begin();
-
-            models["actor"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Idle.gltf"); //Idle,@
-            //models["actor"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\Aurora_Frozen_Health_Resuce_Mesh\\untitled.gltf"); //Idle,@
-            //models["actor"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\CharacterReduceMesh\\Idle.gltf"); //Idle,@
-            //models["actor"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\CharacterAnimationCopy\\Idle.gltf"); //Idle,  DDS
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jog_Fwd.glb");//Running,
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Ability_E_InMotion.glb");//Attack,
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Primary_Attack_Fast_A.glb");//Attack_First,
-            //models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jump_Start.glb");//Jump_Start,
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jump_Apex.glb");//Jump_Start,
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jump_Apex.glb"); //Jump_Apex,
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jump_Land.glb"); //Jump_Land,
-            models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jump_Recovery.glb"); //Jump_Recovering,
-            //models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Jump_Pad.glb"); //Jump_Attack,
-            //models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\HitReact_Front.glb"); //Hit_Damaged,
-            //models["actor"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\Emote_Slice.glb"); //Emote,
-            actor_timer.end();
-        });
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\chicken_gun_supermarket\\superMarket1.gltf");
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\ExampleStage.gltf");
-    std::thread stageThread = std::thread([&]()
-        {
-            stage_timer.begin();
-            models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\ExampleStage.gltf");
-            //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\3d_model_of_trim_castle\\scene.gltf");
-            //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\Stage0430\\stageMesh0430.gltf");
-            //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\sika\\StageParagon.gltf");
-            //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\sika1\\Shika_reduce_pollygon0213.gltf");
-            //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\ParagonSample\\ParagonSample.gltf");
-            stage_timer.end();
-        });
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\stage_miplevel8\\MAP_Demo_test.gltf");
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\stage_miplevel8\\MAP_Demo.gltf");
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\stage_miplevel8_blender\\untitled.gltf");
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\SICKA\\MAP_Demo.gltf");//؂̗t
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\SICKACOPY\\MAP_Demo.gltf");//؂̗t  DDSĂȂ
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\SICKA_DYNASTY\\MAP_Demo2.gltf");//؂̗t
-    //models["stage"] = std::make_shared<GltfModelStaticBatching>(device, "..\\glTF-Sample-Models-main\\original\\SICKA_DYNASTY\\MAP_Demo.gltf");
-    //models["actor"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\character.glb");
-    //models["actor"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\CharacterAnimation\\characterAnimation.gltf");
-
-    //models["enemy"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\EnemyAnimation\\Idle_test.gltf"); //Idle,
-    //models["enemy"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\EnemyAnimation\\Jog_Fwd.glb"); //Jog_Fwd,
-    //models["enemy"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\EnemyAnimation\\Idle_test.gltf"); //Idle,
-    enemy_timer.begin();
-    models["enemy"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\EnemyTest\\Idle_Relaxed_B_HS.gltf"); //Idle,
-    models["enemy"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\EnemyTest\\Jog_Fwd.gltf"); //Jog_Fwd,
-    //models["enemy"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\EnemyTest\\Primary_Fast_Fire.glb"); //Attack_Fast,
-    models["enemy"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\EnemyTest\\R_Ability_Fire.glb"); //Attack_Fast,
-    //models["enemy"]->AddAnimation("..\\glTF-Sample-Models-main\\original\\EnemyTest\\Jog_Fwd.glb"); //Jog_Fwd,
-    enemy_timer.end();
-
-
-    //models["boss"] = std::make_shared<GltfModel>(device, "..\\glTF-Sample-Models-main\\original\\Boss\\Idle.gltf"); //Idle,
-    //models["enemy"] = std::make_shared<GltfModel>(device, ".\\resources\\Sitting Laughing.glb");
-    //models["enemy"]->AddAnimation(".\\resources\\Taunt.glb");
-    actorThread.join();
-    stageThread.join();
-    float elapsed_actor_time = actor_timer.end();
-    float elapsed_stage_time = stage_timer.end();
-    float elapsed_enemy_time = enemy_timer.end();
-
-    char debugActorMessage[256];
-    char debugStageMessage[256];
-    char debugEnemyMessage[256];
-    sprintf_s(debugActorMessage, sizeof(debugActorMessage), "Actor loading time = %.6f sec\n", elapsed_actor_time);
-    sprintf_s(debugStageMessage, sizeof(debugStageMessage), "Stage loading time = %.6f sec\n", elapsed_stage_time);
-    sprintf_s(debugEnemyMessage, sizeof(debugEnemyMessage), "Enemy loading time = %.6f sec\n", elapsed_enemy_time);
-    //sprintf_s(aaa, sizeof(aaa), "time = %d\n", timeGetTime() - time);
-    //time = timeGetTime();
-    //OutputDebugStringA(aaa);
-    OutputDebugStringA(debugActorMessage);
-    OutputDebugStringA(debugStageMessage);
-    OutputDebugStringA(debugEnemyMessage);
+    // AN^[ SetModel Ɠ\o^ (Mode / isSaveVerticesData ȂƋLLbV擾łȂ)
+    for (const AssetLoader::ModelRequest* request : ModelAssets::MainScene())
+    {
+        loader.RequestModel(*request);
+    }
 }
 
 void MainScene::SetUpActors()
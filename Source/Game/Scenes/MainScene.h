@@ -101,8 +101,8 @@ private:
     //V[Ŏgf
     std::map<std::string, std::shared_ptr<GltfModelBase>> models;
 
-    //f[h
-    void LoadModel();
+    //Initialize ̑Oɕœǂݍރfo^
+    void RequestAssets(AssetLoader& loader) override;
 
     //ActorZbg
     void SetUpActors() override;
@@ -147,6 +147,7 @@ public:
     //tF[h
     EasingHandler fadeHandler;
     float fadeValue = 0.0f;
+    GameObjectRef fadeUI{ "Fade" };
     EasingHandler waitHandler;
 
     //p[eBN
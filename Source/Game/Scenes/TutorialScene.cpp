@@ -377,6 +377,12 @@ void TutorialScene::Update(float deltaTime)
 
     effectSystem->Update(deltaTime);
 
+    // ̃J̃Xi[ɂ (SceneBase::Update Ɠ)
+    if (auto currentCamera = CameraManager::GetCurrentCamera())
+    {
+        Audio::SetListener(currentCamera->GetViewConstants().invView);
+    }
+
     //if (InputSystem::GetInputState("Space", InputStateMask::Trigger))
     //{
     //    const char* types[] = { "0", "1" };
@@ -24,6 +24,7 @@
 #include "Physics/Collider.h"
 #include "Graphics/Core/PipelineState.h"
 #include "Graphics/Core/ConstantBuffer.h"
+#include "Engine/Serialization/MappedCache.h"
 
 
 
@@ -539,6 +540,9 @@ public:
         bool asIs = false;
 
         std::vector<unsigned char> cacheData;
+        // }bvLbV̉摜f[^ (CreateAndUploadResources ܂ŗL)
+        const unsigned char* mappedData = nullptr;
+        size_t mappedSize = 0;
 
         template<class T>
         void serialize(T& archive)
@@ -565,6 +569,10 @@ private:
     void CumulateTransforms(std::vector<Node>& nodes);
     void FetchMeshes(ID3D11Device* device, const tinygltf::Model& gltf_model);
 
+    // LbV̓ǂݏ
+    bool LoadMappedCache(MappedCache::Reader& reader, const std::filesystem::path& cacheFilename);
+    void SaveMappedCache(const std::filesystem::path& cacheFilename) const;
+
 
     DXGI_FORMAT DxgiFormat(const tinygltf::Accessor& accessor)
     {
@@ -0,0 +1,78 @@
+#ifndef MODEL_ASSETS_H
+#define MODEL_ASSETS_H
+
+#include <string>
+#include <vector>
+
+#include "Engine/Asset/AssetLoader.h"
+
+// AN^[gf̓ǂݍݕ
+// AN^[ SetModel  MainScene::RequestAssets ̐ǂ݂œ̂g
+// (Mode / isSaveVerticesData ႤƋLLbV̕ʂ̃fɂȂ̂ŁAł܂Ƃ߂Č߂)
+namespace ModelAssets
+{
+    using Mode = InterleavedGltfModel::Mode;
+    using Request = AssetLoader::ModelRequest;
+
+    // Stage
+    inline const Request ExampleStage = { "./Data/Models/Stage/ExampleStage.gltf", Mode::StaticMesh, true };
+    // Player
+    inline const Request Player = { "./Data/Models/Characters/Player/chara_animation.gltf", Mode::SkeltalMesh };
+    inline const Request PlayerSideLeft = { "./Data/Models/Characters/Player/PlayerSide/player_side_left.gltf", Mode::SkeltalMesh };
+    inline const Request PlayerSideRight = { "./Data/Models/Characters/Player/PlayerSide/player_side_right.gltf", Mode::SkeltalMesh };
+    inline const Request Beam = { "./Data/Models/Beam/beam.gltf", Mode::SkeltalMesh };
+    // RiderEnemy (TutorialEnemy / EmptyEnemy fg)
+    inline const Request Boss = { "./Data/Models/Characters/Enemy/boss_idle.gltf", Mode::SkeltalMesh, false,
+        {
+            "./Data/Models/Characters/Enemy/BOS_walk.gltf",
+            "./Data/Models/Characters/Enemy/BOS_punch.gltf",
+            "./Data/Models/Characters/Enemy/yobi.gltf",
+            "./Data/Models/Characters/Enemy/rotate.gltf",
+            "./Data/Models/Characters/Enemy/rotate_end.gltf",
+            "./Data/Models/Characters/Enemy/jump_yobi.gltf",
+            "./Data/Models/Characters/Enemy/jump_air.gltf",
+            "./Data/Models/Characters/Enemy/jump_landing.gltf",
+            "./Data/Models/Characters/Enemy/jump_landing2.gltf",
+            "./Data/Models/Characters/Enemy/specal_move.gltf",
+            "./Data/Models/Characters/Enemy/aristrike.gltf",
+            "./Data/Models/Characters/Enemy/BOS_damage.gltf",
+        }
+    };
+    inline const Request GearEffectIn = { "./Data/Effect/Models/gear_effect_in.gltf", Mode::SkeltalMesh };
+    inline const Request GearEffectOut = { "./Data/Effect/Models/gear_effect.gltf", Mode::SkeltalMesh };
+    // Building
+    inline const Request Building = { "./Data/Models/Building/build_materials.gltf", Mode::SkeltalMesh };
+    inline const Request BuildingFragments = { "./Data/Models/TestCollision/test_hahen1.gltf", Mode::SkeltalMesh, true };
+    // BossBuilding
+    inline const Request BossBuilding = { "./Data/Models/Building/bomb_bill.gltf", Mode::SkeltalMesh };
+    inline const Request BossBuildingFragments = { "./Data/Models/Building/bomb_bill_hahen3.gltf", Mode::SkeltalMesh, true };
+    inline const Request BombTimerOut = { "./Data/Effect/Models/bom_effect_out.gltf", Mode::SkeltalMesh, true };
+    inline const Request BombTimerIn = { "./Data/Effect/Models/bom_effect_in.gltf", Mode::SkeltalMesh };
+    // Building / BossBuilding ̏Ռg
+    inline const Request BlastEffect = { "./Data/Effect/Models/blast_effect_test2.gltf", Mode::SkeltalMesh };
+
+    // MainScene  SetUpActors ƗVłԂɏoĂAN^[̃f
+    inline const std::vector<const Request*>& MainScene()
+    {
+        static const std::vector<const Request*> requests =
+        {
+            &ExampleStage,
+            &Player, &PlayerSideLeft, &PlayerSideRight, &Beam,
+            &Boss, &GearEffectIn, &GearEffectOut,
+            &Building, &BuildingFragments,
+            &BossBuilding, &BossBuildingFragments, &BombTimerOut, &BombTimerIn,
+            &BlastEffect,
+        };
+        return requests;
+    }
+
+    // request  filename / isSaveVerticesData Ńfݒ肷
+    // (Mode ̓R|[lg̎ނŌ܂̂ŁArequest.mode Ɠނ̃R|[lgɎg)
+    template<class MeshComponentT>
+    void SetModel(MeshComponentT& component, const Request& request)
+    {
+        component.SetModel(request.filename, request.isSaveVerticesData);
+    }
+}
+
+#endif // !MODEL_ASSETS_H
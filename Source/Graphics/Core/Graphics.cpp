@@ -215,6 +215,42 @@ void Graphics::Initialize(HWND hwnd, BOOL fullscreen)
 
 
 // NA  ʂ̏
+void Graphics::InitializeHeadless(UINT width, UINT height)
+{
+    hWnd = nullptr;
+    fullscreenMode = FALSE;
+    isHeadless = true;
+
+    framebufferDimensions.cx = static_cast<LONG>(width);
+    framebufferDimensions.cy = static_cast<LONG>(height);
+    screenWidth = static_cast<float>(width);
+    screenHeight = static_cast<float>(height);
+
+    UINT createDeviceFlags{ 0 };
+#ifdef ENABLE_DIRECT2D
+    createDeviceFlags |= D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+#endif
+
+    // \[X͍邪`悵Ȃ NULL hCog (V[̏Ń\[X̂ŃfoCX͗v)
+    D3D_FEATURE_LEVEL featureLevels{ D3D_FEATURE_LEVEL_11_1 };
+    HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_NULL, 0, createDeviceFlags, &featureLevels, 1, D3D11_SDK_VERSION, &device, NULL, &immediateContext);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Graphics::InitializeHeadless : NULL driver is not available, falling back to WARP\n");
+        hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, 0, createDeviceFlags, &featureLevels, 1, D3D11_SDK_VERSION, &device, NULL, &immediateContext);
+    }
+    _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+    // V[̐؂ւŃr[|[gʃTCŶŐݒ肵Ă
+    viewport.TopLeftX = 0;
+    viewport.TopLeftY = 0;
+    viewport.Width = static_cast<float>(width);
+    viewport.Height = static_cast<float>(height);
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+    immediateContext->RSSetViewports(1, &viewport);
+}
+
 void Graphics::Clear(float r, float g, float b, float a)
 {
     // ʂiFw肵ă_[^[QbgNAj
@@ -31,6 +31,13 @@ public:
 	// 
 	static void Initialize(HWND hWnd, BOOL fullscreen);
 
+	// EBhEƃXbv`F[Ȃ (HeadlessRunner p)
+	// `悵Ȃ̂ NULL hCõfoCXAȂ WARP (\tgEFA) ɂ
+	static void InitializeHeadless(UINT width, UINT height);
+
+	// InitializeHeadless ŏ (` Present Ȃ)
+	static bool IsHeadless() { return isHeadless; }
+
 	// NA
 	static void Clear(float r, float g, float b, float a);
 
@@ -70,6 +77,7 @@ public:
 
 
 	static inline BOOL fullscreenMode{ FALSE };// tXN[[hǂ
+	static inline bool isHeadless = false;// EBhEŏ
 private:
 	static inline HWND hWnd = nullptr;// EBhẼnh
 	static inline SIZE framebufferDimensions;// t[obt@̃TCYiʉ𑜓xj
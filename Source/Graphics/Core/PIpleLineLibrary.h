@@ -405,6 +405,13 @@ public:
         RenderState::BindRasterizerState(immediateContext, sets_[name].rasterState);
     }
 
+    // Ȃ nullptr
+    const PipeLineStateDesc* FindPipeLineState(const std::string& name) const
+    {
+        auto it = sets_.find(name);
+        return it != sets_.end() ? &it->second : nullptr;
+    }
+
 
 private:
     std::unordered_map<std::string, PipeLineStateDesc> sets_;
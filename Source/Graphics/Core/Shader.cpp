@@ -40,6 +40,27 @@ HRESULT CreateVsFromCSO(ID3D11Device* device,
     return hr;
 }
 
+HRESULT CreateInputLayoutFromCSO(ID3D11Device* device,
+    const char* csoName, ID3D11InputLayout** inputLayout,
+    const D3D11_INPUT_ELEMENT_DESC* inputElementDesc, UINT numElements)
+{
+    FILE* fp{ nullptr };
+    fopen_s(&fp, csoName, "rb");
+    _ASSERT_EXPR_A(fp, "CSO File not found");
+
+    fseek(fp, 0, SEEK_END);
+    long csoSz{ ftell(fp) };
+    fseek(fp, 0, SEEK_SET);
+
+    std::unique_ptr<unsigned char[]> csoData{ std::make_unique<unsigned char[]>(csoSz) };
+    fread(csoData.get(), csoSz, 1, fp);
+    fclose(fp);
+
+    // ̓VOl`Ɠ˂킹ē̓CAEg쐬
+    HRESULT hr = device->CreateInputLayout(inputElementDesc, numElements, csoData.get(), csoSz, inputLayout);
+    _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    return hr;
+}
 
 HRESULT CreatePsFromCSO(ID3D11Device* device,
     const char* csoName, ID3D11PixelShader** pixelShader)
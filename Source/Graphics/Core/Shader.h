@@ -8,6 +8,11 @@ _NODISCARD HRESULT CreateVsFromCSO(ID3D11Device* device,
     ID3D11InputLayout** inputLayout, D3D11_INPUT_ELEMENT_DESC* inputElementDesc,
     UINT numElements);
 
+// _VF[_[͍炸A̓CAEg (_tH[}bgƂɍ鎞p)
+_NODISCARD HRESULT CreateInputLayoutFromCSO(ID3D11Device* device,
+    const char* csoName, ID3D11InputLayout** inputLayout,
+    const D3D11_INPUT_ELEMENT_DESC* inputElementDesc, UINT numElements);
+
 _NODISCARD HRESULT CreatePsFromCSO(ID3D11Device* device,
     const char* csoName, ID3D11PixelShader** pixelShader);
 
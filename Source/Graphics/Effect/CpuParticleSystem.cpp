@@ -0,0 +1,361 @@
+#include "CpuParticleSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "Engine/Debug/Assert.h"
+
+using namespace DirectX;
+
+namespace
+{
+    constexpr float Pi = 3.14159265358979f;
+    constexpr float NoFade = 1e30f;     // tF[h̎Ԃ 0 ̎ 1 /  ( 1 ɂȂ)
+
+    float Lerp(const XMFLOAT2& range, float t)
+    {
+        return range.x + (range.y - range.x) * t;
+    }
+
+    float SmoothStep(float x)
+    {
+        x = (std::clamp)(x, 0.0f, 1.0f);
+        return x * x * (3.0f - 2.0f * x);
+    }
+
+    XMVECTOR SmoothStep(FXMVECTOR value)
+    {
+        const XMVECTOR x = XMVectorSaturate(value);
+        return XMVectorMultiply(XMVectorMultiply(x, x), XMVectorNegativeMultiplySubtract(XMVectorReplicate(2.0f), x, XMVectorReplicate(3.0f)));
+    }
+
+    // _̐[AƂĕׂɉɂȂL[ɂ
+    uint32_t ToFarFirstKey(float depth)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        const uint32_t ascending = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+        return ~ascending;
+    }
+}
+
+CpuParticleSystem::CpuParticleSystem(uint32_t capacity, uint32_t seed) : capacity((capacity + 3) & ~3u), limit(this->capacity), seed(seed), random(seed)
+{
+    for (std::vector<float>* values : { &positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+        &age, &lifespan, &angle, &angularSpeed, &sizeStart, &sizeEnd, &colorT, &alpha })
+    {
+        values->resize(this->capacity, 0.0f);
+    }
+    chip.resize(this->capacity, 0);
+    ClearPadding();
+}
+
+void CpuParticleSystem::Reset(uint32_t particleCount)
+{
+    _ASSERT_EXPR(particleCount <= capacity, L"CpuParticleSystem::Reset : count is larger than the capacity");
+    limit = (std::min)(particleCount, capacity);
+    count = 0;
+    emissionRate = 0.0f;
+    emissionCarry = 0.0f;
+    settings = {};
+    random.seed(seed);      // g񂵂ĂVƓqɂ
+    distribution.reset();
+    drawOrder.clear();
+    statistics = {};
+    ClearPadding();
+}
+
+uint32_t CpuParticleSystem::Emit(uint32_t emitCount)
+{
+    const uint32_t spawned = (std::min)(emitCount, limit - count);
+    for (uint32_t i = 0; i < spawned; ++i)
+    {
+        Spawn(count++);
+    }
+    ClearPadding();
+    drawOrder.clear();
+    statistics.spawned += spawned;
+    return spawned;
+}
+
+void CpuParticleSystem::Spawn(uint32_t index)
+{
+    // ʒu : S XZ ʂ̗ւ̏
+    const float radius = Lerp(settings.emissionOffset, Random());
+    const float ring = 2.0f * Pi * Random();
+    positionX[index] = settings.emissionPosition.x + radius * std::cos(ring);
+    positionY[index] = settings.emissionPosition.y;
+    positionZ[index] = settings.emissionPosition.z + radius * std::sin(ring);
+
+    //  : Y 𒆐Sɂ~ direction ɉ
+    const float phi = 2.0f * Pi * Random();
+    const float theta = Lerp(settings.emissionConeAngle, Random());
+    const XMFLOAT3 local = { std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+    XMFLOAT3 world = { 0.0f, 0.0f, 0.0f };
+    const XMVECTOR direction = XMLoadFloat3(&settings.direction);
+    if (XMVectorGetX(XMVector3LengthSq(direction)) >= 1e-6f)
+    {
+        const XMVECTOR dir = XMVector3Normalize(direction);
+        const XMVECTOR up = std::fabs(XMVectorGetY(dir)) < 0.999f ? XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f) : XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f);
+        const XMVECTOR right = XMVector3Normalize(XMVector3Cross(up, dir));
+        const XMVECTOR forward = XMVector3Normalize(XMVector3Cross(dir, right));
+        XMStoreFloat3(&world, XMVectorAdd(XMVectorScale(right, local.x), XMVectorAdd(XMVectorScale(dir, local.y), XMVectorScale(forward, local.z))));
+    }
+    const float speed = Lerp(settings.emissionSpeed, Random());
+    velocityX[index] = world.x * speed;
+    velocityY[index] = world.y * speed;
+    velocityZ[index] = world.z * speed;
+
+    angle[index] = Pi * Random();
+    angularSpeed[index] = Lerp(settings.emissionAngularSpeed, Random());
+    lifespan[index] = Lerp(settings.lifespan, Random());
+    age[index] = -Lerp(settings.spawnDelay, Random());
+    sizeStart[index] = settings.emissionSize.x * Random();
+    sizeEnd[index] = settings.emissionSize.y * Random();
+    const uint32_t cells = (std::max)(settings.spriteSheetGrid.x * settings.spriteSheetGrid.y, 1u);
+    chip[index] = (std::min)(static_cast<uint32_t>(Random() * cells), cells - 1);
+    colorT[index] = 0.0f;
+    alpha[index] = 0.0f;
+}
+
+void CpuParticleSystem::Move(uint32_t from, uint32_t to)
+{
+    for (std::vector<float>* values : { &positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+        &age, &lifespan, &angle, &angularSpeed, &sizeStart, &sizeEnd, &colorT, &alpha })
+    {
+        (*values)[to] = (*values)[from];
+    }
+    chip[to] = chip[from];
+}
+
+void CpuParticleSystem::ClearPadding()
+{
+    const uint32_t padded = (count + 3) & ~3u;
+    for (uint32_t i = count; i < padded; ++i)
+    {
+        positionX[i] = positionY[i] = positionZ[i] = 0.0f;
+        velocityX[i] = velocityY[i] = velocityZ[i] = 0.0f;
+        age[i] = 0.0f;
+        lifespan[i] = NoFade;   // Ȃ
+    }
+}
+
+void CpuParticleSystem::RemoveExpired()
+{
+    for (uint32_t i = 0; i < count;)
+    {
+        if (age[i] <= lifespan[i])
+        {
+            ++i;
+            continue;
+        }
+        ++statistics.expired;
+        if (settings.loop)
+        {
+            Spawn(i++);
+            ++statistics.respawned;
+        }
+        else
+        {
+            // Ō̗qƓւĊO (ւqx)
+            Move(--count, i);
+        }
+    }
+    ClearPadding();
+}
+
+void CpuParticleSystem::Update(float deltaTime)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    drawOrder.clear();
+
+    // 1 b̐Ő
+    if (emissionRate > 0.0f)
+    {
+        emissionCarry += emissionRate * deltaTime;
+        const uint32_t emitCount = static_cast<uint32_t>(emissionCarry);
+        emissionCarry -= static_cast<float>(emitCount);
+        Emit(emitCount);
+    }
+
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR dt = XMVectorReplicate(deltaTime);
+    const XMVECTOR gravityDt = XMVectorReplicate(settings.gravity * deltaTime);
+    const XMVECTOR strengthDt = XMVectorReplicate(settings.strength * deltaTime);
+    const XMVECTOR inverseFadeIn = XMVectorReplicate(settings.fadeDuration.x > 0.0f ? 1.0f / settings.fadeDuration.x : NoFade);
+    const XMVECTOR inverseFadeOut = XMVectorReplicate(settings.fadeDuration.y > 0.0f ? 1.0f / settings.fadeDuration.y : NoFade);
+
+    auto load = [](const std::vector<float>& values, uint32_t i) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&values[i])); };
+    auto store = [](std::vector<float>& values, uint32_t i, FXMVECTOR value) { XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&values[i]), value); };
+
+    bool hasExpired = false;
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const XMVECTOR currentAge = XMVectorAdd(load(age, i), dt);
+        const XMVECTOR currentLifespan = load(lifespan, i);
+        // ̒xIĂāAĂȂq
+        const XMVECTOR active = XMVectorAndInt(XMVectorGreater(currentAge, zero), XMVectorLessOrEqual(currentAge, currentLifespan));
+        hasExpired |= !XMVector4LessOrEqual(currentAge, currentLifespan);
+        store(age, i, currentAge);
+
+        if (!settings.isStatic)
+        {
+            const XMVECTOR velocityY0 = XMVectorAdd(load(velocityY, i), XMVectorSelect(zero, gravityDt, active));
+            const XMVECTOR step = XMVectorSelect(zero, strengthDt, active);
+            const XMVECTOR vx = load(velocityX, i);
+            const XMVECTOR vz = load(velocityZ, i);
+            store(velocityY, i, velocityY0);
+            store(positionX, i, XMVectorMultiplyAdd(vx, step, load(positionX, i)));
+            store(positionY, i, XMVectorMultiplyAdd(velocityY0, step, load(positionY, i)));
+            store(positionZ, i, XMVectorMultiplyAdd(vz, step, load(positionZ, i)));
+        }
+        else
+        {
+            store(velocityX, i, XMVectorSelect(load(velocityX, i), zero, active));
+            store(velocityY, i, XMVectorSelect(load(velocityY, i), zero, active));
+            store(velocityZ, i, XMVectorSelect(load(velocityZ, i), zero, active));
+        }
+        store(angle, i, XMVectorMultiplyAdd(load(angularSpeed, i), XMVectorSelect(zero, dt, active), load(angle, i)));
+
+        // F̕Ԃ̊ƁAtF[hCEtF[hAEg
+        store(colorT, i, XMVectorSaturate(XMVectorDivide(currentAge, currentLifespan)));
+        const XMVECTOR fadeIn = SmoothStep(XMVectorMultiply(currentAge, inverseFadeIn));
+        const XMVECTOR fadeOut = SmoothStep(XMVectorMultiply(XMVectorSubtract(currentLifespan, currentAge), inverseFadeOut));
+        store(alpha, i, XMVectorSelect(zero, XMVectorMultiply(fadeIn, fadeOut), active));
+    }
+    if (hasExpired)
+    {
+        RemoveExpired();
+    }
+    statistics.updateMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void CpuParticleSystem::UpdateScalar(float deltaTime)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    drawOrder.clear();
+
+    if (emissionRate > 0.0f)
+    {
+        emissionCarry += emissionRate * deltaTime;
+        const uint32_t emitCount = static_cast<uint32_t>(emissionCarry);
+        emissionCarry -= static_cast<float>(emitCount);
+        Emit(emitCount);
+    }
+
+    const float inverseFadeIn = settings.fadeDuration.x > 0.0f ? 1.0f / settings.fadeDuration.x : NoFade;
+    const float inverseFadeOut = settings.fadeDuration.y > 0.0f ? 1.0f / settings.fadeDuration.y : NoFade;
+    bool hasExpired = false;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        age[i] += deltaTime;
+        const bool active = age[i] > 0.0f && age[i] <= lifespan[i];
+        hasExpired |= age[i] > lifespan[i];
+        if (active)
+        {
+            if (!settings.isStatic)
+            {
+                velocityY[i] += settings.gravity * deltaTime;
+                const float step = settings.strength * deltaTime;
+                positionX[i] += velocityX[i] * step;
+                positionY[i] += velocityY[i] * step;
+                positionZ[i] += velocityZ[i] * step;
+            }
+            else
+            {
+                velocityX[i] = velocityY[i] = velocityZ[i] = 0.0f;
+            }
+            angle[i] += angularSpeed[i] * deltaTime;
+        }
+        colorT[i] = (std::clamp)(age[i] / lifespan[i], 0.0f, 1.0f);
+        alpha[i] = active ? SmoothStep(age[i] * inverseFadeIn) * SmoothStep((lifespan[i] - age[i]) * inverseFadeOut) : 0.0f;
+    }
+    if (hasExpired)
+    {
+        RemoveExpired();
+    }
+    statistics.updateMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void CpuParticleSystem::SortByDepth(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraForward)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    depthKeys.resize(count);
+    keyScratch.resize(count);
+    drawOrder.resize(count);
+    orderScratch.resize(count);
+
+    // [ (J̐ʕ̋)  4 ߂ăL[ɂ
+    const XMVECTOR cameraX = XMVectorReplicate(cameraPosition.x);
+    const XMVECTOR cameraY = XMVectorReplicate(cameraPosition.y);
+    const XMVECTOR cameraZ = XMVectorReplicate(cameraPosition.z);
+    const XMVECTOR forwardX = XMVectorReplicate(cameraForward.x);
+    const XMVECTOR forwardY = XMVectorReplicate(cameraForward.y);
+    const XMVECTOR forwardZ = XMVectorReplicate(cameraForward.z);
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        const XMVECTOR dx = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&positionX[i])), cameraX);
+        const XMVECTOR dy = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&positionY[i])), cameraY);
+        const XMVECTOR dz = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&positionZ[i])), cameraZ);
+        XMFLOAT4 depth;
+        XMStoreFloat4(&depth, XMVectorMultiplyAdd(dx, forwardX, XMVectorMultiplyAdd(dy, forwardY, XMVectorMultiply(dz, forwardZ))));
+        const float depths[4] = { depth.x, depth.y, depth.z, depth.w };
+        for (uint32_t j = 0; j < 4 && i + j < count; ++j)
+        {
+            depthKeys[i + j] = ToFarFirstKey(depths[j]);
+            drawOrder[i + j] = i + j;
+        }
+    }
+
+    // 8 rbg 4 ̊\[g (SĂ̗qœ͔΂)
+    uint32_t histograms[4][256] = {};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const uint32_t key = depthKeys[i];
+        ++histograms[0][key & 0xFF];
+        ++histograms[1][(key >> 8) & 0xFF];
+        ++histograms[2][(key >> 16) & 0xFF];
+        ++histograms[3][key >> 24];
+    }
+    for (uint32_t pass = 0; pass < 4 && count > 1; ++pass)
+    {
+        const uint32_t shift = pass * 8;
+        uint32_t* histogram = histograms[pass];
+        if (histogram[(depthKeys[0] >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+        uint32_t offsets[256];
+        uint32_t sum = 0;
+        for (uint32_t bucket = 0; bucket < 256; ++bucket)
+        {
+            offsets[bucket] = sum;
+            sum += histogram[bucket];
+        }
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t key = depthKeys[i];
+            const uint32_t destination = offsets[(key >> shift) & 0xFF]++;
+            keyScratch[destination] = key;
+            orderScratch[destination] = drawOrder[i];
+        }
+        depthKeys.swap(keyScratch);
+        drawOrder.swap(orderScratch);
+    }
+    statistics.sortMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+}
+
+CpuParticleSystem::Sample CpuParticleSystem::GetSample(uint32_t index) const
+{
+    Sample sample;
+    sample.position = { positionX[index], positionY[index], positionZ[index] };
+    sample.velocity = { velocityX[index], velocityY[index], velocityZ[index] };
+    sample.age = age[index];
+    sample.lifespan = lifespan[index];
+    sample.angle = angle[index];
+    sample.colorT = colorT[index];
+    sample.alpha = alpha[index];
+    return sample;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// GPU g킸ɓp[eBN (qȂG~b^[ƁAGPU ̖ł̊mFEvp)
+//   q̒lvfƂ̔zɕׂāAړEFEtF[h 4 vZ
+//   q loop Ȃ琶AłȂ΍Ō̗qƓւĊO
+//   `̑O SortByDepth ŉ珇ɕ (\[g)AWrite  GPU  Particle ɏo
+//   ƈړ IntegrateParticleCS / Particle.hlsli  SpawnTest (type 0) Ɠ
+class CpuParticleSystem
+{
+public:
+    // ParticleSystem::ParticleSystemConstants ̂ CPU Ŏgl
+    struct EmitterSettings
+    {
+        DirectX::XMFLOAT3 emissionPosition{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT2 emissionOffset{ 0.0f, 0.0f };         // ʒu̔a (XZ )
+        DirectX::XMFLOAT2 emissionSize{ 0.02f, 0.5f };          // x : Ay : Ŏ
+        DirectX::XMFLOAT2 emissionConeAngle{ 0.0f, 0.2f };      // direction ̊px (WA)
+        DirectX::XMFLOAT2 emissionSpeed{ 0.5f, 1.0f };
+        DirectX::XMFLOAT2 emissionAngularSpeed{ 0.0f, 1.0f };
+        DirectX::XMFLOAT2 lifespan{ 2.2f, 2.2f };
+        DirectX::XMFLOAT2 spawnDelay{ 0.0f, 0.0f };
+        DirectX::XMFLOAT2 fadeDuration{ 0.0f, 0.63f };          // x : tF[hCAy : tF[hAEg
+        DirectX::XMFLOAT4 startColor{ 1.0f, 1.0f, 1.0f, 1.0f };
+        DirectX::XMFLOAT4 endColor{ 1.0f, 1.0f, 1.0f, 1.0f };
+        float gravity = 0.17f;
+        DirectX::XMFLOAT3 direction{ 0.0f, 1.0f, 0.0f };
+        float strength = 0.6f;                                  // ړ̑Ɋ|l
+        DirectX::XMUINT2 spriteSheetGrid{ 1, 1 };
+        bool loop = false;                                      // q𐶐
+        bool isStatic = false;                                  // Ȃ
+    };
+
+    struct Statistics
+    {
+        size_t spawned = 0;
+        size_t respawned = 0;
+        size_t expired = 0;
+        double updateMicroseconds = 0.0;    // Ō Update
+        double sortMicroseconds = 0.0;      // Ō SortByDepth
+    };
+
+    explicit CpuParticleSystem(uint32_t capacity, uint32_t seed = 1);
+
+    // ParticleEmitterPool Ŏg񂷎 : qɂ count ܂Ŏg (eʂ͕ςȂA͍ŏ)
+    void Reset(uint32_t count);
+    uint32_t GetCapacity() const { return capacity; }
+    uint32_t GetParticleLimit() const { return limit; }
+    uint32_t GetParticleCount() const { return count; }
+
+    EmitterSettings settings;
+
+    // q count  (𒴂镪͐Ȃ)A
+    uint32_t Emit(uint32_t count);
+    // 1 bɐ鐔 (Update Ő)
+    void SetEmissionRate(float particlesPerSecond) { emissionRate = particlesPerSecond; }
+    // qcĂ邩Aꂩ琶邩 (false ȂԂĂ悢)
+    bool IsAlive() const { return count > 0 || emissionRate > 0.0f; }
+
+    // 4 vZ
+    void Update(float deltaTime);
+    // SIMD g킸 1 vZ (mFpAUpdate ƓʂɂȂ)
+    void UpdateScalar(float deltaTime);
+
+    // J牓ɕׂ (`)
+    void SortByDepth(const DirectX::XMFLOAT3& cameraPosition, const DirectX::XMFLOAT3& cameraForward);
+    // ׂ (SortByDepth ̌ゾ)
+    const std::vector<uint32_t>& GetDrawOrder() const { return drawOrder; }
+
+    // GPU  Particle (Particles.h) ɏo (SortByDepth ̌Ȃ牜)A
+    template<class ParticleType>
+    uint32_t Write(ParticleType* destination, uint32_t destinationCapacity) const
+    {
+        const uint32_t written = count < destinationCapacity ? count : destinationCapacity;
+        const bool isSorted = drawOrder.size() == count;
+        for (uint32_t i = 0; i < written; ++i)
+        {
+            const uint32_t j = isSorted ? drawOrder[i] : i;
+            ParticleType& p = destination[i];
+            const float t = colorT[j];
+            p.state = 0;
+            p.color.x = settings.startColor.x + (settings.endColor.x - settings.startColor.x) * t;
+            p.color.y = settings.startColor.y + (settings.endColor.y - settings.startColor.y) * t;
+            p.color.z = settings.startColor.z + (settings.endColor.z - settings.startColor.z) * t;
+            p.color.w = alpha[j];
+            p.position = { positionX[j], positionY[j], positionZ[j] };
+            p.mass = 1.0f;
+            p.angle = angle[j];
+            p.angularSpeed = angularSpeed[j];
+            p.velocity = { velocityX[j], velocityY[j], velocityZ[j] };
+            p.lifespan = lifespan[j];
+            p.age = age[j];
+            p.size = { sizeStart[j], sizeEnd[j] };
+            p.chip = static_cast<int>(chip[j]);
+        }
+        return written;
+    }
+
+    const Statistics& GetStatistics() const { return statistics; }
+
+    // 1 ̗q̒l (mFp)
+    struct Sample
+    {
+        DirectX::XMFLOAT3 position;
+        DirectX::XMFLOAT3 velocity;
+        float age, lifespan, angle, colorT, alpha;
+    };
+    Sample GetSample(uint32_t index) const;
+
+private:
+    void Spawn(uint32_t index);
+    void Move(uint32_t from, uint32_t to);
+    // [count, 4 ̔{) ̗]vZĂȂlɂ
+    void ClearPadding();
+    // q𐶐O
+    void RemoveExpired();
+    float Random() { return distribution(random); }
+
+    uint32_t capacity;      // z̑傫 (4 ̔{)
+    uint32_t limit;         // g (Reset Ō߂)
+    uint32_t seed;
+    uint32_t count = 0;
+    float emissionRate = 0.0f;
+    float emissionCarry = 0.0f;
+
+    // vfƂ̔z
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> velocityX, velocityY, velocityZ;
+    std::vector<float> age, lifespan, angle, angularSpeed, sizeStart, sizeEnd;
+    std::vector<float> colorT, alpha;   // F̕Ԃ̊ƃtF[h (Update ŋ߂)
+    std::vector<uint32_t> chip;
+
+    // [̃\[g
+    std::vector<uint32_t> depthKeys, keyScratch;
+    std::vector<uint32_t> drawOrder, orderScratch;
+
+    std::mt19937 random;
+    std::uniform_real_distribution<float> distribution{ 0.0f, 1.0f };
+    Statistics statistics;
+};
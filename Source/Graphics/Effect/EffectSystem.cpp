@@ -1,5 +1,7 @@
 #include "EffectSystem.h"
 
+#include <algorithm>
+
 #ifdef USE_IMGUI
 #define IMGUI_ENABLE_DOCKING
 #include "../External/imgui/imgui.h"
@@ -7,6 +9,8 @@
 
 #include "../../Core/ActorManager.h"
 #include "../../Components/Effect/EffectComponent.h"
+#include "Engine/Camera/CameraManager.h"
+#include "Game/Actors/Camera/Camera.h"
 #include "Game/Actors/Player/Player.h"
 
 void EffectSystem::Initialize()
@@ -63,6 +67,21 @@ void EffectSystem::Initialize()
             splitCounts[i]);
     }
 
+    //Ή (computeParticles[4] ɏoĂ̂ɐFE傫EL킹)
+    sparkPreset.blendMode = 1;
+    sparkPreset.texture = shaderResourceViews[4];
+    sparkPreset.data.direction = { 0, 1, 0 };
+    sparkPreset.data.emissionConeAngle = { 0.0f, 1.2f };
+    sparkPreset.data.emissionSpeed = { 1.2f, 5.0f };
+    sparkPreset.data.strength = 1.0f;
+    sparkPreset.data.gravity = -2.0f;
+    sparkPreset.data.emissionSize = { 0.3f, 0.3f };
+    sparkPreset.data.lifespan = { 0.6f, 1.0f };
+    sparkPreset.data.spawnDelay = { 0.0f, 0.0f };
+    sparkPreset.data.fadeDuration = { 0.0f, 0.3f };
+    sparkPreset.data.emissionStartColor = { 1, 0.5f, 0, 1 };
+    sparkPreset.data.emissionEndColor = { 1, 0.5f, 0, 1 };
+
     //
     model = std::make_unique<GltfModel>(Graphics::GetDevice(), "./Data/Models/Items/HeldEnergyCore/heldEnergyCore.gltf");
     HRESULT hr = CreatePsFromCSO(Graphics::GetDevice(), "./Shader/GltfModelEmitParticlePS.cso", model->pixelShader.ReleaseAndGetAddressOf());
@@ -280,40 +299,59 @@ void EffectSystem::Update(float deltaTime)
 {
     Scene* currentScene = Scene::GetCurrentScene();  // ݂̃V[擾
     if (!currentScene) return;
-    auto actorManager = currentScene->GetActorManager();  // ActorManager擾
 
-    for (auto& actor : actorManager->allActors_) {
-        if (!actor->rootComponent_ || !actor->isActive) {
-            continue;
-        }
-
-        std::vector<EffectComponent*> effectComponents;
-        actor->GetComponents<EffectComponent>(effectComponents);
-
-        for (EffectComponent* effectComponent : effectComponents)
+    //ĐE~̗vo (EffectComponent::Activate / Deactivate ς)
+    EffectRegistry& registry = EffectRegistry::Instance();
+    EffectRegistry::Request request;
+    while (registry.Pop(request))
+    {
+        auto it = std::find(activeEffects.begin(), activeEffects.end(), request.handle);
+        if (request.type == EffectRegistry::RequestType::Play)
         {
-            if (effectComponent->IsPlay())
+            if (it == activeEffects.end())
             {
-                size_t index = static_cast<size_t>(effectComponent->GetEffectType());
-                if (ARRAYSIZE(computeParticles) > index)
-                {
-                    //ParticleSystem* particle = particles[index].get();
+                activeEffects.push_back(request.handle);
+            }
+        }
+        else if (it != activeEffects.end())
+        {
+            *it = activeEffects.back();
+            activeEffects.pop_back();
+        }
+    }
 
-                    //DirectX::XMFLOAT3 pos = effectComponent->GetComponentLocation();
-                    //particle->particleSystemData = particle->presetData;
-                    //particle->particleSystemData.emissionPosition = { pos.x, pos.y, pos.z, 1.f };
+    //Đ̃GtFNg (ꂽE~߂ꂽ̂̓XgO)
+    for (size_t i = 0; i < activeEffects.size();)
+    {
+        EffectComponent* effectComponent = registry.Resolve(activeEffects[i]);
+        std::shared_ptr<Actor> actor = effectComponent ? effectComponent->GetActor() : nullptr;
+        if (!actor || !effectComponent->IsPlay())
+        {
+            activeEffects[i] = activeEffects.back();
+            activeEffects.pop_back();
+            continue;
+        }
+        if (!actor->rootComponent_ || !actor->isActive)
+        {
+            ++i;
+            continue;
+        }
 
-                    //particle->Initialize(Graphics::GetDeviceContext(), 0);
-                    SpawnEmitter(effectComponent);
+        size_t index = static_cast<size_t>(effectComponent->GetEffectType());
+        if (ARRAYSIZE(computeParticles) > index)
+        {
+            SpawnEmitter(effectComponent);
 
-                    //r[̃[vȊO
-                    if (index > 1)
-                    {
-                        effectComponent->Initialized();
-                    }
-                }
+            //r[̃[vȊO
+            if (index > 1)
+            {
+                effectComponent->Initialized();
+                activeEffects[i] = activeEffects.back();
+                activeEffects.pop_back();
+                continue;
             }
         }
+        ++i;
     }
 #if 1
 #if 0
@@ -330,6 +368,22 @@ void EffectSystem::Update(float deltaTime)
 #endif // 0
 
 
+    //CPU ̃G~b^[XV (qȂG~b^[̓v[ɕԂ)
+    for (size_t i = 0; i < cpuEmitters.size();)
+    {
+        CpuEmitter& emitter = cpuEmitters[i];
+        emitter.simulation->Update(deltaTime);
+        if (emitter.simulation->IsAlive())
+        {
+            ++i;
+            continue;
+        }
+        cpuEmitterPool.Release(std::move(emitter.simulation));
+        emitterPool.Release(std::move(emitter.renderer));
+        emitter = std::move(cpuEmitters.back());
+        cpuEmitters.pop_back();
+    }
+
     //p[eBNXV
     if (integrateParticles)
     {
@@ -584,6 +638,53 @@ void EffectSystem::Update(float deltaTime)
     }
 }
 
+void EffectSystem::ReleaseEmitter(ParticleSystem* emitter)
+{
+    auto it = std::find_if(particles.begin(), particles.end(), [emitter](const std::unique_ptr<ParticleSystem>& particle) { return particle.get() == emitter; });
+    if (it == particles.end())
+    {
+        return;
+    }
+    particles.erase(it);
+}
+
+CpuParticleSystem* EffectSystem::SpawnCpuEmitter(const EmitterData& data)
+{
+    const ParticleSystem::ParticleSystemConstants& constants = data.data;
+    _ASSERT_EXPR(constants.type == 0, L"CpuParticleSystem supports only the Normal type");
+
+    CpuEmitter emitter;
+    emitter.simulation = cpuEmitterPool.Acquire(static_cast<uint32_t>(data.count));
+    CpuParticleSystem::EmitterSettings& settings = emitter.simulation->settings;
+    settings.emissionPosition = { constants.emissionPosition.x, constants.emissionPosition.y, constants.emissionPosition.z };
+    settings.emissionOffset = constants.emissionOffset;
+    settings.emissionSize = constants.emissionSize;
+    settings.emissionConeAngle = constants.emissionConeAngle;
+    settings.emissionSpeed = constants.emissionSpeed;
+    settings.emissionAngularSpeed = constants.emissionAngularSpeed;
+    settings.lifespan = constants.lifespan;
+    settings.spawnDelay = constants.spawnDelay;
+    settings.fadeDuration = constants.fadeDuration;
+    settings.startColor = constants.emissionStartColor;
+    settings.endColor = constants.emissionEndColor;
+    settings.gravity = constants.gravity;
+    settings.direction = constants.direction;
+    settings.strength = constants.strength;
+    settings.spriteSheetGrid = constants.spriteSheetGrid;
+    settings.loop = constants.loop;
+    settings.isStatic = constants.isStatic != 0;
+    // InitializeParticleCS ƓAŏɑSĂ̗q𐶐 (spawnDelay ŏo鎞Ԃ炷)
+    emitter.simulation->Emit(static_cast<uint32_t>(data.count));
+
+    emitter.renderer = emitterPool.Acquire(static_cast<uint32_t>(data.count));
+    emitter.renderer->particleTexture = data.texture ? data.texture : GetWhiteTexture();
+    emitter.renderer->blendMode = data.blendMode;
+    emitter.renderer->particleSystemData = constants;
+    emitter.renderer->particleCount = 0;
+
+    return cpuEmitters.emplace_back(std::move(emitter)).simulation.get();
+}
+
 void EffectSystem::SpawnEmitter(EffectComponent* effectComponent)
 {
     DirectX::XMFLOAT3 pos = effectComponent->GetActor()->GetPosition();
@@ -742,6 +843,11 @@ void EffectSystem::SpawnEmitter(EffectComponent* effectComponent)
     }
     case EffectComponent::EffectType::Spark:
     {
+        //xô CPU ̃G~b^[v[؂ (q Update ŕԂ)
+        EmitterData spark = sparkPreset;
+        spark.data.emissionPosition = { pos.x, pos.y, pos.z, 1.0f };
+        SpawnCpuEmitter(spark);
+#if 0
         int max = 100;
         for (int i = 0; i < max; i++)
         {
@@ -784,6 +890,7 @@ void EffectSystem::SpawnEmitter(EffectComponent* effectComponent)
 
             computeParticles[4]->Emit(data);
         }
+#endif // 0
         break;
     }
     default:
@@ -988,6 +1095,31 @@ void EffectSystem::Render(ID3D11DeviceContext* immediateContext)
     }
 #endif // 0
 
+    //CPU ̃G~b^[`揈 (J牓ɕׂď)
+    if (!cpuEmitters.empty())
+    {
+        Camera* camera = CameraManager::GetCurrentCamera();
+        DirectX::XMFLOAT3 cameraPosition{ 0.0f, 0.0f, 0.0f };
+        DirectX::XMFLOAT3 cameraForward{ 0.0f, 0.0f, 1.0f };
+        if (camera)
+        {
+            const ViewConstants viewConstants = camera->GetViewConstants();
+            cameraPosition = { viewConstants.cameraPosition.x, viewConstants.cameraPosition.y, viewConstants.cameraPosition.z };
+            cameraForward = { viewConstants.invView._31, viewConstants.invView._32, viewConstants.invView._33 };
+        }
+        for (CpuEmitter& emitter : cpuEmitters)
+        {
+            CpuParticleSystem* simulation = emitter.simulation.get();
+            simulation->SortByDepth(cameraPosition, cameraForward);
+            stagingParticles.resize(simulation->GetParticleCount());
+            const uint32_t count = simulation->Write(stagingParticles.data(), static_cast<uint32_t>(stagingParticles.size()));
+            emitter.renderer->Upload(immediateContext, stagingParticles.data(), static_cast<int>(count));
+
+            immediateContext->PSSetShaderResources(0, 1, emitter.renderer->particleTexture.GetAddressOf());
+            immediateContext->GSSetShaderResources(0, 1, colorTemperChart.GetAddressOf());
+            emitter.renderer->Render(immediateContext);
+        }
+    }
 
     //Rs[gp[eBN`揈
     for (auto& computeParticle : computeParticles)
@@ -1024,8 +1156,31 @@ void EffectSystem::DrawGUI()
     ImGui::SameLine();
     if (ImGui::Button("-", ImVec2(30, 30)) && particles.size() > 0)
     {
-        particles.pop_back();
+        ReleaseEmitter(particles.back().get());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("+ cpu", ImVec2(60, 30)) && count > 0)
+    {
+        EmitterData data{ count };
+        SpawnCpuEmitter(data);
+    }
+
+    const EffectRegistry::Statistics registryStatistics = EffectRegistry::Instance().GetStatistics();
+    ImGui::Text("effect components : %zu registered, %zu playing, requests %llu", registryStatistics.registered, activeEffects.size(),
+        static_cast<unsigned long long>(registryStatistics.pushed));
+
+    const ParticleEmitterPool<ParticleSystem>::Statistics& poolStatistics = emitterPool.GetStatistics();
+    ImGui::Text("emitter pool : acquired %zu, created %zu, reused %zu, pooled %zu",
+        poolStatistics.acquired, poolStatistics.created, poolStatistics.reused, poolStatistics.pooled);
+    size_t cpuParticleCount = 0;
+    double cpuUpdateMicroseconds = 0.0;
+    for (const CpuEmitter& emitter : cpuEmitters)
+    {
+        cpuParticleCount += emitter.simulation->GetParticleCount();
+        cpuUpdateMicroseconds += emitter.simulation->GetStatistics().updateMicroseconds + emitter.simulation->GetStatistics().sortMicroseconds;
     }
+    ImGui::Text("cpu emitters : %zu (%zu particles, %.1f us), pooled %zu",
+        cpuEmitters.size(), cpuParticleCount, cpuUpdateMicroseconds, cpuEmitterPool.GetStatistics().pooled);
 
 
     ImGui::Separator();
@@ -16,7 +16,10 @@
 //
 #include "Graphics/Resource/GltfModel.h"
 
+#include "Components/Effect/EffectRegistry.h"
 #include "ComputeParticleSystem.h"
+#include "CpuParticleSystem.h"
+#include "ParticleEmitterPool.h"
 class EffectComponent;
 
 class EffectSystem
@@ -34,6 +37,8 @@ public:
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture;
     };
     std::vector<EmitterData> presets;
+    // ẻΉ (xô SpawnCpuEmitter Ńv[؂)
+    EmitterData sparkPreset{ 100 };
 public:
     EffectSystem() = default;
     virtual ~EffectSystem() = default;
@@ -43,6 +48,7 @@ public:
     void Update(float deltaTime);
     void Render(ID3D11DeviceContext* immediateContext);
 
+    // ƎgG~b^[͗v傤ǂ̃obt@ō (ꎞIȂ̂ SpawnCpuEmitter  emitterPool ؂)
     ParticleSystem* SpawnEmitter(EmitterData data) {
         std::unique_ptr<ParticleSystem> effect = std::make_unique<ParticleSystem>(Graphics::GetDevice(), data.count);
         effect->particleTexture = data.texture;
@@ -53,11 +59,17 @@ public:
 
     ParticleSystem* CreateEmitter(int count) {
         std::unique_ptr<ParticleSystem> effect = std::make_unique<ParticleSystem>(Graphics::GetDevice(), count);
-        HRESULT hr= MakeDummyTexture(Graphics::GetDevice(), effect->particleTexture.GetAddressOf(), 0xFFFFFFFF, 16);
-        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+        effect->particleTexture = GetWhiteTexture();
         return particles.emplace_back(std::move(effect)).get();
     }
 
+    // gIG~b^[ particles Oď
+    void ReleaseEmitter(ParticleSystem* emitter);
+
+    // xoꎞIȃG~b^[ (CpuParticleSystem ŌvZA`̑Oɗq)
+    //   vZpƕ`p̃obt@ cpuEmitterPool / emitterPool ؂AqSď Update ŕԂ
+    CpuParticleSystem* SpawnCpuEmitter(const EmitterData& data);
+
     void SpawnEmitter(EffectComponent* effectComponent);
 
     //{X`[Wp
@@ -76,10 +88,35 @@ public:
 
     std::vector<std::unique_ptr<ParticleSystem>> particles;
 
+    // Đ EffectComponent (EffectRegistry ̗vŏoꂷ)
+    std::vector<EffectRegistry::Handle> activeEffects;
+
+    ParticleEmitterPool<ParticleSystem> emitterPool{ [](uint32_t capacity) { return std::make_unique<ParticleSystem>(Graphics::GetDevice(), static_cast<int>(capacity)); } };
+
+    struct CpuEmitter
+    {
+        std::unique_ptr<CpuParticleSystem> simulation;
+        std::unique_ptr<ParticleSystem> renderer;     // 񂾗q`悷 (emitterPool ؂)
+    };
+    std::vector<CpuEmitter> cpuEmitters;
+    ParticleEmitterPool<CpuParticleSystem> cpuEmitterPool{ [](uint32_t capacity) { return std::make_unique<CpuParticleSystem>(capacity); } };
+    std::vector<Particle> stagingParticles;
+
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> colorTemperChart;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> projectionTexture;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> maskTexture;
 
+    // eNX`w肵ȂG~b^[p (ŏɎgɍ)
+    const Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& GetWhiteTexture() {
+        if (!whiteTexture)
+        {
+            HRESULT hr = MakeDummyTexture(Graphics::GetDevice(), whiteTexture.GetAddressOf(), 0xFFFFFFFF, 16);
+            _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+        }
+        return whiteTexture;
+    }
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> whiteTexture;
+
     //
     std::unique_ptr<GltfModel> model;
 };
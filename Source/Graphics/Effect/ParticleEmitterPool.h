@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// gIG~b^[ (q̃obt@) eʂ̒iKƂɒuĂAiK̗vŎg񂷃v[
+//   iK MinCapacity ȏ 2 ̗ݏ (v͂̒iK̃obt@̒Ŏg)
+//   iKƂɒuĂ maxFreePerClass ܂ (葽Ԃꂽ)
+//   ɏꎞIȃG~b^[pBƎgG~b^[͒iKɊۂ߂ɗvō
+//   (iK̗eʂłȂԂꂽuɏ)
+//   System  GetCapacity() AReset(count) Ŏgςčŏ̏Ԃɖ߂邱
+template<class System>
+class ParticleEmitterPool
+{
+public:
+    static constexpr uint32_t MinCapacity = 64;
+
+    // iK̗eʂ̃G~b^[֐
+    using Factory = std::function<std::unique_ptr<System>(uint32_t capacity)>;
+
+    struct Statistics
+    {
+        size_t acquired = 0;
+        size_t created = 0;     // V
+        size_t reused = 0;      // uĂg
+        size_t released = 0;
+        size_t destroyed = 0;   // iK̏Œuɏ
+        size_t pooled = 0;      // uĂ鐔
+    };
+
+    explicit ParticleEmitterPool(Factory factory, uint32_t maxFreePerClass = 8) : factory(std::move(factory)), maxFreePerClass(maxFreePerClass) {}
+
+    static uint32_t GetCapacityClass(uint32_t count)
+    {
+        uint32_t capacity = MinCapacity;
+        while (capacity < count)
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    // count ̗qgG~b^[ (Reset(count) ς)
+    std::unique_ptr<System> Acquire(uint32_t count)
+    {
+        ++statistics.acquired;
+        const uint32_t capacity = GetCapacityClass(count);
+        std::unique_ptr<System> system;
+        auto it = freeLists.find(capacity);
+        if (it != freeLists.end() && !it->second.empty())
+        {
+            system = std::move(it->second.back());
+            it->second.pop_back();
+            --statistics.pooled;
+            ++statistics.reused;
+        }
+        else
+        {
+            system = factory(capacity);
+            ++statistics.created;
+        }
+        system->Reset(count);
+        return system;
+    }
+
+    void Release(std::unique_ptr<System> system)
+    {
+        if (!system)
+        {
+            return;
+        }
+        ++statistics.released;
+        const uint32_t capacity = system->GetCapacity();
+        if (capacity != GetCapacityClass(capacity))
+        {
+            ++statistics.destroyed;
+            return;
+        }
+        std::vector<std::unique_ptr<System>>& freeList = freeLists[capacity];
+        if (freeList.size() >= maxFreePerClass)
+        {
+            ++statistics.destroyed;
+            return;
+        }
+        freeList.push_back(std::move(system));
+        ++statistics.pooled;
+    }
+
+    // uĂ镨Sď
+    void Clear()
+    {
+        freeLists.clear();
+        statistics.pooled = 0;
+    }
+
+    const Statistics& GetStatistics() const { return statistics; }
+
+private:
+    Factory factory;
+    uint32_t maxFreePerClass;
+    std::unordered_map<uint32_t, std::vector<std::unique_ptr<System>>> freeLists;
+    Statistics statistics;
+};
@@ -1,4 +1,7 @@
 #include "Particles.h"
+
+#include <algorithm>
+
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/Core/Shader.h"
 #include "Engine/Utility/Win32Utils.h"
@@ -16,7 +19,7 @@
 
 using namespace DirectX;
 
-ParticleSystem::ParticleSystem(ID3D11Device* device, int particleCount) :maxParticleCount(particleCount)
+ParticleSystem::ParticleSystem(ID3D11Device* device, int particleCount) :maxParticleCount(particleCount), particleCount(particleCount)
 {
     HRESULT hr{ S_OK };
     D3D11_BUFFER_DESC bufferDesc{};
@@ -82,13 +85,15 @@ UINT Align(UINT num, UINT alignment)
 // p[eBN̕XVs֐
 void ParticleSystem::Integrate(ID3D11DeviceContext* immediateContext, float deltaTime)
 {
+    ClearPendingParticles(immediateContext);
+
     // UAV (Unordered Access View) Rs[gVF[_[ɃoCh
     immediateContext->CSSetUnorderedAccessViews(0, 1, particleBufferUav.GetAddressOf(), NULL);
 
     // p[eBNVXẽf[^XV
     particleSystemData.time += deltaTime;
     particleSystemData.deltaTime = deltaTime;
-    particleSystemData.maxParticleCount = maxParticleCount;
+    particleSystemData.maxParticleCount = particleCount;
 
     // RX^gobt@XV
     immediateContext->UpdateSubresource(constantBuffer.Get(), 0, 0, &particleSystemData, 0, 0);
@@ -98,7 +103,7 @@ void ParticleSystem::Integrate(ID3D11DeviceContext* immediateContext, float delt
     immediateContext->CSSetShader(particleComputeShader.Get(), NULL, 0);
 
     // XbhO[vvZARs[gVF[_[s
-    const UINT threadGroupCountX = Align(static_cast<UINT>(maxParticleCount), NUMTHREAD_X) / NUMTHREAD_X;
+    const UINT threadGroupCountX = Align(static_cast<UINT>(particleCount), NUMTHREAD_X) / NUMTHREAD_X;
     immediateContext->Dispatch(threadGroupCountX, 1, 1);
 
     // UAV ȉɉe^Ȃ悤ɂ邽߁j
@@ -109,13 +114,15 @@ void ParticleSystem::Integrate(ID3D11DeviceContext* immediateContext, float delt
 // p[eBN̏s֐
 void ParticleSystem::Initialize(ID3D11DeviceContext* immediateContext, float deltaTime)
 {
+    ClearPendingParticles(immediateContext);
+
     // UAV (Unordered Access View) Rs[gVF[_[ɃoCh
     immediateContext->CSSetUnorderedAccessViews(0, 1, particleBufferUav.GetAddressOf(), NULL);
 
     // p[eBNVXẽf[^
     particleSystemData.time = 0;
     particleSystemData.deltaTime = deltaTime;
-    particleSystemData.maxParticleCount = maxParticleCount;
+    particleSystemData.maxParticleCount = particleCount;
 
     // RX^gobt@XV
     immediateContext->UpdateSubresource(constantBuffer.Get(), 0, 0, &particleSystemData, 0, 0);
@@ -125,7 +132,7 @@ void ParticleSystem::Initialize(ID3D11DeviceContext* immediateContext, float del
     immediateContext->CSSetShader(particleInitializerComputeShader.Get(), NULL, 0);
 
     // XbhO[vvZARs[gVF[_[s
-    const UINT threadGroupCountX = Align(static_cast<UINT>(maxParticleCount), NUMTHREAD_X) / NUMTHREAD_X;
+    const UINT threadGroupCountX = Align(static_cast<UINT>(particleCount), NUMTHREAD_X) / NUMTHREAD_X;
     immediateContext->Dispatch(threadGroupCountX, 1, 1);
 
     // UAV 
@@ -136,6 +143,8 @@ void ParticleSystem::Initialize(ID3D11DeviceContext* immediateContext, float del
 // p[eBN̕`s֐
 void ParticleSystem::Render(ID3D11DeviceContext* immediateContext)
 {
+    ClearPendingParticles(immediateContext);
+
     //uhXe[gݒ
     if (blendMode == 0)
     {
@@ -167,7 +176,7 @@ void ParticleSystem::Render(ID3D11DeviceContext* immediateContext)
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
 
     // p[eBN`
-    immediateContext->Draw(static_cast<UINT>(maxParticleCount), 0);
+    immediateContext->Draw(static_cast<UINT>(particleCount), 0);
 
     // gpSRV
     ID3D11ShaderResourceView* nullShaderResourceView{};
@@ -179,6 +188,48 @@ void ParticleSystem::Render(ID3D11DeviceContext* immediateContext)
     immediateContext->GSSetShader(NULL, NULL, 0);
 }
 
+void ParticleSystem::Reset(uint32_t count)
+{
+    _ASSERT_EXPR(count <= static_cast<uint32_t>(maxParticleCount), L"ParticleSystem::Reset : count is larger than the buffer");
+    particleCount = static_cast<int>(count);
+    particleSystemData = {};
+    presetData = {};
+    blendMode = 1;
+    particleTexture.Reset();
+    // OɎg̗qcȂ悤ɁAɎgReLXg 0 ɂ
+    isClearPending = true;
+}
+
+void ParticleSystem::ClearPendingParticles(ID3D11DeviceContext* immediateContext)
+{
+    if (!isClearPending)
+    {
+        return;
+    }
+    // age  0 ̗q͕`悳Ȃ
+    const UINT zero[4] = { 0, 0, 0, 0 };
+    immediateContext->ClearUnorderedAccessViewUint(particleBufferUav.Get(), zero);
+    isClearPending = false;
+}
+
+void ParticleSystem::Upload(ID3D11DeviceContext* immediateContext, const Particle* source, int count)
+{
+    ClearPendingParticles(immediateContext);
+    particleCount = (std::min)(count, maxParticleCount);
+    if (particleCount <= 0)
+    {
+        return;
+    }
+    D3D11_BOX box{};
+    box.left = 0;
+    box.right = static_cast<UINT>(sizeof(Particle) * particleCount);
+    box.top = 0;
+    box.bottom = 1;
+    box.front = 0;
+    box.back = 1;
+    immediateContext->UpdateSubresource(particleBuffer.Get(), 0, &box, source, 0, 0);
+}
+
 void ParticleSystem::DrawGUI()
 {
 #ifdef USE_IMGUI
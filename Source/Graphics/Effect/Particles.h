@@ -4,6 +4,7 @@
 #include <wrl.h>
 #include <DirectXMath.h>
 
+#include <cstdint>
 #include <vector>
 
 #define NUMTHREAD_X 16
@@ -36,8 +37,12 @@ struct Particle
 
 struct ParticleSystem
 {
-    // q̍ő吔
+    // q̍ő吔 (obt@̑傫)
     const int maxParticleCount;
+    // gq̐ (vZE`悷鐔AParticleEmitterPool Ŏg񂷎 maxParticleCount 菭Ȃ)
+    int particleCount;
+    // Reset ŏƂɂq܂ĂȂ (ɓnꂽReLXgŏ)
+    bool isClearPending = false;
     // qVXe̒萔obt@p\
     struct ParticleSystemConstants
     {
@@ -143,7 +148,17 @@ struct ParticleSystem
     // q`悷֐
     void Render(ID3D11DeviceContext* immediateContext);
 
+    // ParticleEmitterPool Ŏg񂷎 : ݒŏ̒lɖ߂Aq count ܂Ŏg
+    // (obt@̂́A Integrate / Initialize / Render / Upload ֓nꂽReLXgōs)
+    void Reset(uint32_t count);
+    uint32_t GetCapacity() const { return static_cast<uint32_t>(maxParticleCount); }
+    // CPU ŌvZq (CpuParticleSystem::Write) ݁Acount `悷
+    void Upload(ID3D11DeviceContext* immediateContext, const Particle* source, int count);
+
     //GUI`
     void DrawGUI();
 
+private:
+    void ClearPendingParticles(ID3D11DeviceContext* immediateContext);
+
 };
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "DebugDrawBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using namespace DirectX;
+
+namespace
+{
+    std::atomic<uint64_t> nextBufferId{ 1 };
+}
+
+void DebugDrawBuffer::Batch::Clear()
+{
+    lines.clear();
+    points.clear();
+    for (std::vector<ShapeInstance>& instances : shapes)
+    {
+        instances.clear();
+    }
+}
+
+bool DebugDrawBuffer::Batch::Empty() const
+{
+    return lines.empty() && points.empty() && ShapeInstanceCount() == 0;
+}
+
+size_t DebugDrawBuffer::Batch::ShapeInstanceCount() const
+{
+    size_t count = 0;
+    for (const std::vector<ShapeInstance>& instances : shapes)
+    {
+        count += instances.size();
+    }
+    return count;
+}
+
+std::string DebugDrawBuffer::Statistics::ToString() const
+{
+    char buf[256];
+    sprintf_s(buf, "  debug draw : %zu lines, %zu points, %zu shapes, %zu dropped, %zu threads\n", lineVertices / 2, points, shapes, dropped, threads);
+    return buf;
+}
+
+DebugDrawBuffer::DebugDrawBuffer() : id(nextBufferId++)
+{
+}
+
+DebugDrawBuffer::~DebugDrawBuffer() = default;
+
+DebugDrawBuffer::ThreadBuffer& DebugDrawBuffer::LocalBuffer()
+{
+    // XbhƂɁAǂ̃obt@ɂǂ ThreadBuffer o^oĂ
+    // (id ̓obt@ƂɈႤ̂ŁAjobt@̃AhXėpĂႦȂ)
+    struct Entry
+    {
+        uint64_t owner;
+        ThreadBuffer* buffer;
+    };
+    thread_local std::vector<Entry> entries;
+    for (const Entry& entry : entries)
+    {
+        if (entry.owner == id)
+        {
+            return *entry.buffer;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    ThreadBuffer* buffer = threadBuffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+    entries.push_back({ id, buffer });
+    return *buffer;
+}
+
+bool DebugDrawBuffer::Reserve(std::atomic<size_t>& counter, size_t max, size_t count)
+{
+    if (counter.fetch_add(count, std::memory_order_relaxed) + count > max)
+    {
+        droppedCount.fetch_add(count, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void DebugDrawBuffer::AddLine(const XMFLOAT3& start, const XMFLOAT3& end, const XMFLOAT4& color)
+{
+    if (!Reserve(lineVertexCount, budget.maxLineVertices, 2))
+    {
+        return;
+    }
+    WriteLocal([&](Batch& batch)
+        {
+            batch.lines.push_back({ start, color });
+            batch.lines.push_back({ end, color });
+        });
+}
+
+void DebugDrawBuffer::AddLineStrip(const std::vector<XMFLOAT3>& points, const XMFLOAT4& color)
+{
+    if (points.size() < 2 || !Reserve(lineVertexCount, budget.maxLineVertices, (points.size() - 1) * 2))
+    {
+        return;
+    }
+    WriteLocal([&](Batch& batch)
+        {
+            for (size_t index = 1; index < points.size(); ++index)
+            {
+                batch.lines.push_back({ points[index - 1], color });
+                batch.lines.push_back({ points[index], color });
+            }
+        });
+}
+
+void DebugDrawBuffer::AddLineList(const std::vector<XMFLOAT3>& points, const XMFLOAT4& color)
+{
+    const size_t count = points.size() & ~size_t(1);
+    if (count == 0 || !Reserve(lineVertexCount, budget.maxLineVertices, count))
+    {
+        return;
+    }
+    WriteLocal([&](Batch& batch)
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                batch.lines.push_back({ points[index], color });
+            }
+        });
+}
+
+void DebugDrawBuffer::AddPoint(const XMFLOAT3& position, const XMFLOAT4& color)
+{
+    if (!Reserve(pointCount, budget.maxPoints, 1))
+    {
+        return;
+    }
+    WriteLocal([&](Batch& batch)
+        {
+            batch.points.push_back({ position, color });
+        });
+}
+
+void DebugDrawBuffer::AddShape(Shape shape, const XMFLOAT4X4& world, const XMFLOAT4& color)
+{
+    if (!Reserve(shapeCount, budget.maxShapes, 1))
+    {
+        return;
+    }
+    WriteLocal([&](Batch& batch)
+        {
+            batch.shapes[static_cast<size_t>(shape)].push_back({ world, color });
+        });
+}
+
+void DebugDrawBuffer::Gather(Batch& out)
+{
+    out.Clear();
+    statistics = {};
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : threadBuffers)
+    {
+        // ؂ւāAO̕ɏĂrȂÎ҂
+        const uint32_t readIndex = buffer->writeIndex.load();
+        buffer->writeIndex.store(readIndex ^ 1);
+        while (buffer->writing.load())
+        {
+            std::this_thread::yield();
+        }
+
+        Batch& batch = buffer->batches[readIndex];
+        out.lines.insert(out.lines.end(), batch.lines.begin(), batch.lines.end());
+        out.points.insert(out.points.end(), batch.points.begin(), batch.points.end());
+        for (size_t shape = 0; shape < ShapeCount; ++shape)
+        {
+            out.shapes[shape].insert(out.shapes[shape].end(), batch.shapes[shape].begin(), batch.shapes[shape].end());
+        }
+        batch.Clear();
+    }
+
+    statistics.lineVertices = out.lines.size();
+    statistics.points = out.points.size();
+    statistics.shapes = out.ShapeInstanceCount();
+    statistics.dropped = droppedCount.exchange(0);
+    statistics.threads = threadBuffers.size();
+    lineVertexCount.store(0);
+    pointCount.store(0);
+    shapeCount.store(0);
+}
+
+void DebugDrawBuffer::BuildShapeMesh(Shape shape, std::vector<XMFLOAT3>& positions, std::vector<uint16_t>& indices)
+{
+    positions.clear();
+    indices.clear();
+
+    // outward (O) ƓɂȂ悤ɕт߂ĎOp`𑫂
+    auto addTriangle = [&](uint16_t a, uint16_t b, uint16_t c, const XMFLOAT3& outward)
+        {
+            const XMVECTOR A = XMLoadFloat3(&positions[a]);
+            const XMVECTOR normal = XMVector3Cross(XMLoadFloat3(&positions[b]) - A, XMLoadFloat3(&positions[c]) - A);
+            if (XMVectorGetX(XMVector3LengthSq(normal)) < 1e-12f)
+            {// ɂׂ̒ꂽOp`
+                return;
+            }
+            if (XMVectorGetX(XMVector3Dot(normal, XMLoadFloat3(&outward))) < 0.0f)
+            {
+                std::swap(b, c);
+            }
+            indices.push_back(a);
+            indices.push_back(b);
+            indices.push_back(c);
+        };
+    auto centroid = [&](uint16_t a, uint16_t b, uint16_t c)
+        {
+            XMFLOAT3 center;
+            XMStoreFloat3(&center, (XMLoadFloat3(&positions[a]) + XMLoadFloat3(&positions[b]) + XMLoadFloat3(&positions[c])) / 3.0f);
+            return center;
+        };
+
+    constexpr int slices = 24;
+    auto addSphere = [&](float theta0, float theta1, int stacks)
+        {
+            const uint16_t base = static_cast<uint16_t>(positions.size());
+            for (int stack = 0; stack <= stacks; ++stack)
+            {
+                const float theta = theta0 + (theta1 - theta0) * stack / stacks;
+                for (int slice = 0; slice <= slices; ++slice)
+                {
+                    const float phi = XM_2PI * slice / slices;
+                    positions.push_back({ sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi) });
+                }
+            }
+            for (int stack = 0; stack < stacks; ++stack)
+            {
+                for (int slice = 0; slice < slices; ++slice)
+                {
+                    const uint16_t a = base + static_cast<uint16_t>(stack * (slices + 1) + slice);
+                    const uint16_t b = a + (slices + 1);
+                    const uint16_t c = b + 1;
+                    const uint16_t d = a + 1;
+                    addTriangle(a, d, b, centroid(a, d, b));
+                    addTriangle(d, c, b, centroid(d, c, b));
+                }
+            }
+        };
+    auto addBox = [&](const XMFLOAT3& minimum, const XMFLOAT3& maximum)
+        {
+            const float x[] = { minimum.x, maximum.x };
+            const float y[] = { minimum.y, maximum.y };
+            const float z[] = { minimum.z, maximum.z };
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                for (int side = 0; side < 2; ++side)
+                {
+                    const uint16_t base = static_cast<uint16_t>(positions.size());
+                    for (int corner = 0; corner < 4; ++corner)
+                    {
+                        const int u = corner & 1;
+                        const int v = corner >> 1;
+                        if (axis == 0) positions.push_back({ x[side], y[u], z[v] });
+                        if (axis == 1) positions.push_back({ x[u], y[side], z[v] });
+                        if (axis == 2) positions.push_back({ x[u], y[v], z[side] });
+                    }
+                    XMFLOAT3 outward = { 0, 0, 0 };
+                    (&outward.x)[axis] = side ? 1.0f : -1.0f;
+                    addTriangle(base + 0, base + 1, base + 3, outward);
+                    addTriangle(base + 0, base + 3, base + 2, outward);
+                }
+            }
+        };
+
+    switch (shape)
+    {
+    case Shape::Sphere:
+        addSphere(0.0f, XM_PI, 12);
+        break;
+    case Shape::TopHalfSphere:
+        addSphere(0.0f, XM_PIDIV2, 6);
+        break;
+    case Shape::BottomHalfSphere:
+        addSphere(XM_PIDIV2, XM_PI, 6);
+        break;
+    case Shape::Cylinder:
+    {
+        //  (̗ւƏ̗) ƁA㉺̂ӂ
+        for (int ring = 0; ring < 2; ++ring)
+        {
+            for (int slice = 0; slice <= slices; ++slice)
+            {
+                const float phi = XM_2PI * slice / slices;
+                positions.push_back({ cosf(phi), static_cast<float>(ring), sinf(phi) });
+            }
+        }
+        const uint16_t bottomCenter = static_cast<uint16_t>(positions.size());
+        positions.push_back({ 0, 0, 0 });
+        const uint16_t topCenter = static_cast<uint16_t>(positions.size());
+        positions.push_back({ 0, 1, 0 });
+        for (int slice = 0; slice < slices; ++slice)
+        {
+            const uint16_t a = static_cast<uint16_t>(slice);
+            const uint16_t b = a + 1;
+            const uint16_t c = b + (slices + 1);
+            const uint16_t d = a + (slices + 1);
+            const XMFLOAT3 side = { positions[a].x + positions[b].x, 0.0f, positions[a].z + positions[b].z };
+            addTriangle(a, d, b, side);
+            addTriangle(d, c, b, side);
+            addTriangle(bottomCenter, a, b, { 0, -1, 0 });
+            addTriangle(topCenter, d, c, { 0, 1, 0 });
+        }
+        break;
+    }
+    case Shape::Cube:
+        addBox({ -0.5f, 0.0f, -0.5f }, { 0.5f, 1.0f, 0.5f });
+        break;
+    case Shape::CubeCenter:
+        addBox({ -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f });
+        break;
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// fobO` (E_E`)  CPU ł߂Ăobt@
+// ǂ̃XbhłǉłAXbhƂ̃obt@ɏ̂Œǉ̎̓bNȂ
+// ߂̂ 1 t[ 1  Gather ŎoAShapeRenderer::Flush ܂Ƃ߂ (CX^X) `悷
+class DebugDrawBuffer
+{
+public:
+    struct Vertex
+    {
+        DirectX::XMFLOAT3 position;
+        DirectX::XMFLOAT4 color;
+    };
+
+    // ShapeRenderer ̃fobOp̌` (Data/Debug/Primitives  glb Ɠ傫E_)
+    enum class Shape : uint8_t
+    {
+        Sphere,             // a 1
+        TopHalfSphere,      // a 1Ay = 0 
+        BottomHalfSphere,   // a 1Ay = 0 牺
+        Cylinder,           // a 1Ay = 0  1
+        Cube,               // 1  1Aʂ_
+        CubeCenter,         // 1  1A^񒆂_
+    };
+    static constexpr size_t ShapeCount = 6;
+
+    struct ShapeInstance
+    {
+        DirectX::XMFLOAT4X4 world;
+        DirectX::XMFLOAT4 color;
+    };
+
+    // 1 t[ɂ߂鐔 (͎̂Ă dropped ɐ)
+    struct Budget
+    {
+        size_t maxLineVertices = 1 << 18;
+        size_t maxPoints = 1 << 16;
+        size_t maxShapes = 1 << 14;
+    };
+
+    struct Batch
+    {
+        std::vector<Vertex> lines;  // 2 _ 1 { (LINELIST)
+        std::vector<Vertex> points;
+        std::vector<ShapeInstance> shapes[ShapeCount];
+
+        void Clear();
+        bool Empty() const;
+        size_t ShapeInstanceCount() const;
+    };
+
+    struct Statistics
+    {
+        size_t lineVertices = 0;
+        size_t points = 0;
+        size_t shapes = 0;
+        size_t dropped = 0;
+        size_t threads = 0;
+
+        std::string ToString() const;
+    };
+
+    DebugDrawBuffer();
+    ~DebugDrawBuffer();
+
+    DebugDrawBuffer(const DebugDrawBuffer&) = delete;
+    DebugDrawBuffer& operator=(const DebugDrawBuffer&) = delete;
+
+    void AddLine(const DirectX::XMFLOAT3& start, const DirectX::XMFLOAT3& end, const DirectX::XMFLOAT4& color);
+    // ĂȂ (LINESTRIP Ɠ)
+    void AddLineStrip(const std::vector<DirectX::XMFLOAT3>& points, const DirectX::XMFLOAT4& color);
+    // 2 _̐ (LINELIST Ɠ)
+    void AddLineList(const std::vector<DirectX::XMFLOAT3>& points, const DirectX::XMFLOAT4& color);
+    void AddPoint(const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& color);
+    void AddShape(Shape shape, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4& color);
+
+    // SẴXbhł߂̂ out Ɉڂċɂ (`悷Xbh 1 t[ 1 Ă)
+    // ǉĂr̃XbhĂ悢 (͎̕ Gather Ŏo)
+    void Gather(Batch& out);
+
+    // Ō Gather Ŏo
+    const Statistics& GetStatistics() const { return statistics; }
+
+    Budget budget;
+
+    // `̒_ƃCfbNX (Op`͊O猩ĔvBglTF ̍Wn)
+    static void BuildShapeMesh(Shape shape, std::vector<DirectX::XMFLOAT3>& positions, std::vector<uint16_t>& indices);
+
+private:
+    // XbhƂ̃obt@
+    // ǉ鑤 writing 𗧂ĂĂ writeIndex ̕ɏBGather  writeIndex ؂ւāA
+    // writing ̂҂ĂO̕ǂ (ǂ seq_cst Ȃ̂ŁAǂނƂ͂Ȃ)
+    struct ThreadBuffer
+    {
+        std::atomic<uint32_t> writeIndex{ 0 };
+        std::atomic<bool> writing{ false };
+        Batch batches[2];
+    };
+    ThreadBuffer& LocalBuffer();
+    // count ǉĂ悢 (\Z𒴂 false)
+    bool Reserve(std::atomic<size_t>& counter, size_t max, size_t count);
+
+    // ̃Xbh̃obt@́A Batch ɏ
+    template<class Write>
+    void WriteLocal(Write&& write)
+    {
+        ThreadBuffer& buffer = LocalBuffer();
+        buffer.writing.store(true);
+        write(buffer.batches[buffer.writeIndex.load()]);
+        buffer.writing.store(false);
+    }
+
+    const uint64_t id;
+    std::mutex registryMutex;   // Xbh̓o^ (XbhƂ 1 )  Gather ̎g
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+    std::atomic<size_t> lineVertexCount{ 0 };
+    std::atomic<size_t> pointCount{ 0 };
+    std::atomic<size_t> shapeCount{ 0 };
+    std::atomic<size_t> droppedCount{ 0 };
+    Statistics statistics;
+};
@@ -0,0 +1,92 @@
+#include "InstanceBuffer.h"
+
+#include <windows.h>
+#include <crtdbg.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Engine/Utility/Win32Utils.h"
+
+InstanceBuffer::InstanceBuffer(ID3D11Device* device, UINT stride, UINT initialCapacity)
+    : stride(stride)
+{
+    Create(device, (std::max)(initialCapacity, 1u));
+}
+
+void InstanceBuffer::Create(ID3D11Device* device, UINT capacity)
+{
+    D3D11_BUFFER_DESC bufferDesc = {};
+    bufferDesc.ByteWidth = stride * capacity;
+    bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    HRESULT hr = device->CreateBuffer(&bufferDesc, NULL, buffer.ReleaseAndGetAddressOf());
+    _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    statistics.capacity = capacity;
+    statistics.cursor = 0;
+}
+
+void* InstanceBuffer::Map(ID3D11DeviceContext* immediateContext, UINT count, UINT& firstInstance)
+{
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (count > statistics.capacity)
+    {// 蒼 (Oɔs`͌Âobt@QƂ܂ GPU Ă)
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        immediateContext->GetDevice(device.GetAddressOf());
+        UINT capacity = statistics.capacity;
+        while (capacity < count)
+        {
+            capacity *= 2;
+        }
+        Create(device.Get(), capacity);
+        ++statistics.grows;
+        mapType = D3D11_MAP_WRITE_DISCARD;
+    }
+    else if (statistics.cursor + count > statistics.capacity || statistics.cursor == 0)
+    {// 擪珑
+        if (statistics.cursor > 0)
+        {
+            ++statistics.wraps;
+        }
+        statistics.cursor = 0;
+        mapType = D3D11_MAP_WRITE_DISCARD;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+    HRESULT hr = immediateContext->Map(buffer.Get(), 0, mapType, 0, &mappedSubresource);
+    _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+    firstInstance = statistics.cursor;
+    statistics.cursor += count;
+    ++statistics.allocations;
+    statistics.instances += count;
+    return static_cast<BYTE*>(mappedSubresource.pData) + static_cast<size_t>(firstInstance) * stride;
+}
+
+void InstanceBuffer::Unmap(ID3D11DeviceContext* immediateContext)
+{
+    immediateContext->Unmap(buffer.Get(), 0);
+}
+
+void InstanceBuffer::Bind(ID3D11DeviceContext* immediateContext, UINT slot, UINT firstInstance) const
+{
+    UINT offset = firstInstance * stride;
+    immediateContext->IASetVertexBuffers(slot, 1, buffer.GetAddressOf(), &stride, &offset);
+}
+
+void InstanceBuffer::ResetStatistics()
+{
+    statistics.allocations = 0;
+    statistics.instances = 0;
+    statistics.wraps = 0;
+    statistics.grows = 0;
+}
+
+std::string InstanceBuffer::Statistics::ToString() const
+{
+    char buf[256];
+    sprintf_s(buf, "  instance buffer : %u / %u, %zu allocations, %zu instances, %zu wraps, %zu grows\n",
+        cursor, capacity, allocations, instances, wraps, grows);
+    return buf;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <d3d11.h>
+#include <wrl.h>
+
+#include <string>
+
+// CX^XƂ̃f[^uIȒ_obt@
+// t[܂ŃOobt@ƂĎgAr NO_OVERWRITE Ōɏ
+// ܂ŗ DISCARD Ő擪ɖ߂A1 ̗veʂ𒴂鎞͔{̑傫ō蒼
+class InstanceBuffer
+{
+public:
+    struct Statistics
+    {
+        UINT capacity = 0;      // vf
+        UINT cursor = 0;        // ɏʒu
+        size_t allocations = 0;
+        size_t instances = 0;
+        size_t wraps = 0;       // 擪ɖ߂
+        size_t grows = 0;       // 蒼
+
+        std::string ToString() const;
+    };
+
+    InstanceBuffer(ID3D11Device* device, UINT stride, UINT initialCapacity);
+
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    // count ̏ݐԂBfirstInstance  Bind ɓnvf̈ʒu
+    // IK Unmap 
+    void* Map(ID3D11DeviceContext* immediateContext, UINT count, UINT& firstInstance);
+    void Unmap(ID3D11DeviceContext* immediateContext);
+
+    // firstInstance ̗vfCX^X 0 ɂȂ悤ɃItZbgtăoCh
+    void Bind(ID3D11DeviceContext* immediateContext, UINT slot, UINT firstInstance) const;
+
+    UINT Stride() const { return stride; }
+    const Statistics& GetStatistics() const { return statistics; }
+    // v 0 ɖ߂ (obt@̈ʒu͂̂܂)
+    void ResetStatistics();
+
+private:
+    void Create(ID3D11Device* device, UINT capacity);
+
+    Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+    UINT stride = 0;
+    Statistics statistics;
+};
@@ -0,0 +1,227 @@
+#include "MeshletCulling.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace DirectX;
+
+void MeshletCulling::Statistics::Add(const Statistics& statistics)
+{
+    meshlets += statistics.meshlets;
+    frustumCulled += statistics.frustumCulled;
+    coneCulled += statistics.coneCulled;
+    triangles += statistics.triangles;
+    visibleTriangles += statistics.visibleTriangles;
+    drawnTriangles += statistics.drawnTriangles;
+    ranges += statistics.ranges;
+    milliseconds += statistics.milliseconds;
+}
+
+std::string MeshletCulling::Statistics::ToString() const
+{
+    char buf[256];
+    sprintf_s(buf, "%zu meshlets (frustum %zu, cone %zu culled), tris %zu / %zu drawn (visible %zu, culled %.1f%%), %zu ranges, %.3f ms",
+        meshlets, frustumCulled, coneCulled, drawnTriangles, triangles, visibleTriangles, 100.0f * CulledRatio(), ranges, milliseconds);
+    return buf;
+}
+
+bool MeshletCulling::ExtractCameraPosition(const XMFLOAT4X4& modelViewProjection, XMFLOAT3& cameraPosition)
+{
+    // J̈ʒu̓NbvԂ x = y = w = 0 ɂȂ_Ȃ̂ŁA(0, 0, 1, 0) tsŖ߂
+    const XMMATRIX inverse = XMMatrixInverse(nullptr, XMLoadFloat4x4(&modelViewProjection));
+    const XMVECTOR position = XMVector4Transform(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), inverse);
+    const float w = XMVectorGetW(position);
+    const float length = XMVectorGetX(XMVector3Length(position));
+    // ˉe͖ɂȂ (ts񂪖gȂ)
+    if (!std::isfinite(w) || !std::isfinite(length) || std::fabs(w) <= FLT_EPSILON * length)
+    {
+        return false;
+    }
+    XMStoreFloat3(&cameraPosition, XMVectorScale(position, 1.0f / w));
+    return true;
+}
+
+MeshletCulling::Result MeshletCulling::TestMeshlet(const VisibilityCulling::Frustum& frustum, const XMFLOAT3* cameraPosition, const MeshletBuilder::Meshlet& meshlet)
+{
+    const XMFLOAT3& center = meshlet.center;
+    for (int i = 0; i < frustum.planeCount; ++i)
+    {
+        const XMFLOAT4& plane = frustum.planes[i];
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -meshlet.radius)
+        {
+            return Result::OutsideFrustum;
+        }
+    }
+    if (cameraPosition)
+    {
+        const XMFLOAT3 offset = { center.x - cameraPosition->x, center.y - cameraPosition->y, center.z - cameraPosition->z };
+        const float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+        if (offset.x * meshlet.coneAxis.x + offset.y * meshlet.coneAxis.y + offset.z * meshlet.coneAxis.z >= meshlet.coneCutoff * distance + meshlet.radius)
+        {
+            return Result::Backface;
+        }
+    }
+    return Result::Visible;
+}
+
+void MeshletCulling::CullMeshlets(const MeshletBuilder::Clusters& clusters, const XMFLOAT4X4& modelViewProjection, bool coneCulling,
+    std::vector<uint32_t>& visible, Statistics* statistics)
+{
+    const auto begin = std::chrono::steady_clock::now();
+    visible.clear();
+    const VisibilityCulling::Frustum frustum = VisibilityCulling::ExtractFrustum(modelViewProjection, false);
+    XMFLOAT3 camera = { 0, 0, 0 };
+    const bool useCone = coneCulling && ExtractCameraPosition(modelViewProjection, camera);
+
+    XMVECTOR planes[6][4];
+    for (int i = 0; i < frustum.planeCount; ++i)
+    {
+        const XMFLOAT4& plane = frustum.planes[i];
+        planes[i][0] = XMVectorReplicate(plane.x);
+        planes[i][1] = XMVectorReplicate(plane.y);
+        planes[i][2] = XMVectorReplicate(plane.z);
+        planes[i][3] = XMVectorReplicate(plane.w);
+    }
+    const XMVECTOR cameraX = XMVectorReplicate(camera.x);
+    const XMVECTOR cameraY = XMVectorReplicate(camera.y);
+    const XMVECTOR cameraZ = XMVectorReplicate(camera.z);
+
+    size_t frustumCulled = 0;
+    size_t coneCulled = 0;
+    for (size_t group = 0; group < clusters.count; group += 4)
+    {
+        const XMVECTOR centerX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.centerX[group]));
+        const XMVECTOR centerY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.centerY[group]));
+        const XMVECTOR centerZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.centerZ[group]));
+        const XMVECTOR radius = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.radius[group]));
+        const XMVECTOR negativeRadius = XMVectorNegate(radius);
+
+        XMVECTOR outside = XMVectorFalseInt();
+        for (int i = 0; i < frustum.planeCount; ++i)
+        {
+            XMVECTOR distance = XMVectorMultiplyAdd(centerX, planes[i][0], planes[i][3]);
+            distance = XMVectorMultiplyAdd(centerY, planes[i][1], distance);
+            distance = XMVectorMultiplyAdd(centerZ, planes[i][2], distance);
+            outside = XMVectorOrInt(outside, XMVectorLess(distance, negativeRadius));
+        }
+
+        // SĂ̖ʂ : dot(S - J, ) >= cutoff * |S - J| + a
+        XMVECTOR backface = XMVectorFalseInt();
+        if (useCone)
+        {
+            const XMVECTOR offsetX = XMVectorSubtract(centerX, cameraX);
+            const XMVECTOR offsetY = XMVectorSubtract(centerY, cameraY);
+            const XMVECTOR offsetZ = XMVectorSubtract(centerZ, cameraZ);
+            XMVECTOR dot = XMVectorMultiply(offsetX, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.axisX[group])));
+            dot = XMVectorMultiplyAdd(offsetY, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.axisY[group])), dot);
+            dot = XMVectorMultiplyAdd(offsetZ, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.axisZ[group])), dot);
+            XMVECTOR lengthSquared = XMVectorMultiply(offsetX, offsetX);
+            lengthSquared = XMVectorMultiplyAdd(offsetY, offsetY, lengthSquared);
+            lengthSquared = XMVectorMultiplyAdd(offsetZ, offsetZ, lengthSquared);
+            const XMVECTOR cutoff = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&clusters.cutoff[group]));
+            backface = XMVectorGreaterOrEqual(dot, XMVectorMultiplyAdd(cutoff, XMVectorSqrt(lengthSquared), radius));
+        }
+
+        XMUINT4 outsideMask, backfaceMask;
+        XMStoreUInt4(&outsideMask, outside);
+        XMStoreUInt4(&backfaceMask, backface);
+        const uint32_t outsideLanes[4] = { outsideMask.x, outsideMask.y, outsideMask.z, outsideMask.w };
+        const uint32_t backfaceLanes[4] = { backfaceMask.x, backfaceMask.y, backfaceMask.z, backfaceMask.w };
+        const size_t laneCount = (std::min)(clusters.count - group, static_cast<size_t>(4));
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            if (outsideLanes[lane])
+            {
+                ++frustumCulled;
+            }
+            else if (backfaceLanes[lane])
+            {
+                ++coneCulled;
+            }
+            else
+            {
+                visible.push_back(static_cast<uint32_t>(group + lane));
+            }
+        }
+    }
+
+    if (statistics)
+    {
+        statistics->meshlets += clusters.count;
+        statistics->frustumCulled += frustumCulled;
+        statistics->coneCulled += coneCulled;
+        statistics->triangles += clusters.triangleCount;
+        statistics->milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+size_t MeshletCulling::BuildRanges(const MeshletBuilder::Clusters& clusters, const std::vector<uint32_t>& visible, size_t maxRanges,
+    std::vector<Range>& ranges, Statistics* statistics)
+{
+    const size_t first = ranges.size();
+    size_t visibleTriangles = 0;
+    // ̓CfbNXobt@̒őĕł̂ŁAԍ̑ 1 ͈̔͂ɂȂ
+    for (uint32_t meshlet : visible)
+    {
+        const Range range = { clusters.firstIndex[meshlet], clusters.indexCount[meshlet] };
+        visibleTriangles += range.indexCount / 3;
+        if (ranges.size() > first && ranges.back().firstIndex + ranges.back().indexCount == range.firstIndex)
+        {
+            ranges.back().indexCount += range.indexCount;
+        }
+        else
+        {
+            ranges.push_back(range);
+        }
+    }
+
+    const size_t count = ranges.size() - first;
+    if (maxRanges > 0 && count > maxRanges)
+    {
+        // Ԃ̒ maxRanges - 1 cāÅԂ͌Ȃ򂲂ƕ`
+        std::vector<uint32_t> gaps(count - 1);
+        for (size_t i = 0; i < gaps.size(); ++i)
+        {
+            gaps[i] = static_cast<uint32_t>(i);
+        }
+        auto gapLength = [&](uint32_t i)
+            {
+                const Range& range = ranges[first + i];
+                return ranges[first + i + 1].firstIndex - (range.firstIndex + range.indexCount);
+            };
+        std::stable_sort(gaps.begin(), gaps.end(), [&](uint32_t a, uint32_t b) { return gapLength(a) > gapLength(b); });
+        std::vector<uint8_t> split(count - 1, 0);
+        for (size_t i = 0; i < maxRanges - 1; ++i)
+        {
+            split[gaps[i]] = 1;
+        }
+        size_t merged = first;
+        for (size_t i = 1; i < count; ++i)
+        {
+            const Range range = ranges[first + i];
+            if (split[i - 1])
+            {
+                ranges[++merged] = range;
+            }
+            else
+            {
+                ranges[merged].indexCount = range.firstIndex + range.indexCount - ranges[merged].firstIndex;
+            }
+        }
+        ranges.resize(merged + 1);
+    }
+
+    if (statistics)
+    {
+        statistics->visibleTriangles += visibleTriangles;
+        for (size_t i = first; i < ranges.size(); ++i)
+        {
+            statistics->drawnTriangles += ranges[i].indexCount / 3;
+        }
+        statistics->ranges += ranges.size() - first;
+    }
+    return ranges.size() - first;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Graphics/Resource/MeshletBuilder.h"
+#include "Graphics/Renderer/VisibilityCulling.h"
+
+// 1 t[ 1 A傫ȃob`bṼbVbg (MeshletBuilder)  CPU őIʂ
+//   ̓fԂōs (̕ʂƃJ̈ʒufԂɖ߂)
+//   oEfBOXtBAƎA@̉~ƃJ̈ʒu (SĂ̖ʂĂ邩)  4 ܂Ƃ߂Ĕ肷
+//   ̃CfbNX͈̔͂́AĂ̂ 1 ɂ܂Ƃ߂ĕ`͈͂̈ꗗɂ
+class MeshletCulling
+{
+public:
+    // CfbNXobt@̒̕`͈
+    struct Range
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+    };
+
+    enum class Result
+    {
+        Visible,
+        OutsideFrustum,
+        Backface,
+    };
+
+    struct Statistics
+    {
+        size_t meshlets = 0;
+        size_t frustumCulled = 0;
+        size_t coneCulled = 0;
+        size_t triangles = 0;
+        size_t visibleTriangles = 0;
+        size_t drawnTriangles = 0;  // ͈͂܂Ƃ߂邽߂ɕ`ȂOp`܂߂
+        size_t ranges = 0;
+        double milliseconds = 0.0;
+
+        void Add(const Statistics& statistics);
+        // IʂŌ炵Op`̊
+        float CulledRatio() const { return triangles ? 1.0f - static_cast<float>(drawnTriangles) / triangles : 0.0f; }
+        std::string ToString() const;
+    };
+
+    // modelViewProjection ̓fԂNbvԂւ̍s
+    // coneCulling  false (g嗦ƂɈႤȂ) Ȃ王䂾őIʂ
+    // ̔ԍ visible ɕԂ
+    static void CullMeshlets(const MeshletBuilder::Clusters& clusters, const DirectX::XMFLOAT4X4& modelViewProjection, bool coneCulling,
+        std::vector<uint32_t>& visible, Statistics* statistics = nullptr);
+    // ͈̔͂ ranges ̌ɒǉāAǉԂ
+    // Ă 1 ͈̔͂ɂ܂Ƃ߁AmaxRanges 𒴂Ԃ̒Z疄߂ (Ȃ`)
+    static size_t BuildRanges(const MeshletBuilder::Clusters& clusters, const std::vector<uint32_t>& visible, size_t maxRanges,
+        std::vector<Range>& ranges, Statistics* statistics = nullptr);
+
+    // SIMD g킸 1 肷 (mFp)
+    static Result TestMeshlet(const VisibilityCulling::Frustum& frustum, const DirectX::XMFLOAT3* cameraPosition, const MeshletBuilder::Meshlet& meshlet);
+    // fԂ̃J̈ʒu (ˉeȂǂňʒu false)
+    static bool ExtractCameraPosition(const DirectX::XMFLOAT4X4& modelViewProjection, DirectX::XMFLOAT3& cameraPosition);
+};
@@ -0,0 +1,285 @@
+#include "RenderQueue.h"
+
+#include <crtdbg.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+void RenderQueue::BeginFrame()
+{
+    items.clear();
+    entries.clear();
+    for (size_t& count : passCounts)
+    {
+        count = 0;
+    }
+    isSorted = false;
+    pipelineIds.clear();
+    modelIds.clear();
+}
+
+uint32_t RenderQueue::InternPipeline(const std::string& pipeline)
+{
+    auto it = pipelineIds.find(pipeline);
+    if (it != pipelineIds.end())
+    {
+        return it->second;
+    }
+    const uint32_t id = static_cast<uint32_t>(pipelineIds.size());
+    pipelineIds.emplace(pipeline, id);
+    return id;
+}
+
+uint32_t RenderQueue::InternModel(const void* model)
+{
+    auto it = modelIds.find(model);
+    if (it != modelIds.end())
+    {
+        return it->second;
+    }
+    const uint32_t id = static_cast<uint32_t>(modelIds.size());
+    modelIds.emplace(model, id);
+    return id;
+}
+
+void RenderQueue::AddItem(DrawItem item, float depth)
+{
+    item.order = static_cast<uint32_t>(items.size());
+    item.key = MakeKey(item, depth);
+    ++passCounts[static_cast<size_t>(item.pass)];
+    items.push_back(item);
+    isSorted = false;
+}
+
+uint16_t RenderQueue::QuantizeDepth(float depth)
+{
+    //  float ̓rbĝ܂ܔׂĂ召ςȂ̂ŁA 16bit (w + ̏) g
+    depth = (std::max)(depth, 0.0f);
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return static_cast<uint16_t>(bits >> 16);
+}
+
+uint64_t RenderQueue::MakeKey(const DrawItem& item, float depth)
+{
+    const uint64_t pass = static_cast<uint64_t>(item.pass) & 0x3;
+    const uint64_t pipeline = item.pipeline & 0xfff;
+    const uint64_t model = item.model & 0xfff;
+    const uint64_t material = static_cast<uint32_t>(item.material) & 0x3ff;
+    const uint64_t vertexBuffer = static_cast<uint32_t>(item.vertexBuffer) & 0xfff;
+    const uint64_t quantized = QuantizeDepth(depth);
+    const uint64_t instanceGroup = static_cast<uint32_t>(item.instanceGroup + 1) & 0xf;
+    const uint64_t lod = static_cast<uint32_t>(item.lod) & 0x3;
+
+    // ӂꂵʎq͓lɏdȂ邾ŁAXe[g̔r͎ʎq̂̂ōŝŕ`͐
+    if (item.pass == Pass::Blend)
+    {// pass:2 | :16 | pipeline:12 | model:12 | material:10 | vertexBuffer:12
+        return pass << 62 | (~quantized & 0xffff) << 46 | pipeline << 34 | model << 22 | material << 12 | vertexBuffer;
+    }
+    // pass:2 | pipeline:12 | model:12 | material:10 | vertexBuffer:12 | instanceGroup:4 | lod:2 | O:10
+    // (instanceGroup  lod [xɒuāA܂Ƃ߂ACeĕԂ悤ɂ)
+    return pass << 62 | pipeline << 50 | model << 38 | material << 28 | vertexBuffer << 16 | instanceGroup << 12 | lod << 10 | quantized >> 6;
+}
+
+void RenderQueue::Sort()
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    entries.resize(items.size());
+    for (uint32_t itemIndex = 0; itemIndex < static_cast<uint32_t>(items.size()); ++itemIndex)
+    {
+        entries[itemIndex] = { items[itemIndex].key, itemIndex };
+    }
+    scratch.resize(entries.size());
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        size_t counts[256] = {};
+        for (const SortEntry& entry : entries)
+        {
+            ++counts[(entry.key >> shift) & 0xff];
+        }
+        if (std::any_of(std::begin(counts), std::end(counts), [&](size_t count) { return count == entries.size(); }))
+        {// SēȂבւȂĂ悢
+            continue;
+        }
+        size_t offsets[256];
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            offsets[digit] = offset;
+            offset += counts[digit];
+        }
+        for (const SortEntry& entry : entries)
+        {
+            scratch[offsets[(entry.key >> shift) & 0xff]++] = entry;
+        }
+        entries.swap(scratch);
+    }
+    isSorted = true;
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    sortMilliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+bool RenderQueue::CanInstance(const DrawItem& first, const DrawItem& item)
+{
+    return first.instanceGroup > -1 && first.instanceGroup == item.instanceGroup && first.pass == item.pass &&
+        first.pipeline == item.pipeline && first.model == item.model && first.node == item.node && first.primitive == item.primitive &&
+        first.material == item.material && first.vertexBuffer == item.vertexBuffer && first.indexBuffer == item.indexBuffer && first.skin == item.skin && first.lod == item.lod;
+}
+
+void RenderQueue::Submit(Pass pass, SubmitBackend& backend, bool sorted, bool elideStateChanges) const
+{
+    _ASSERT_EXPR(!sorted || isSorted || items.empty(), L"RenderQueue::Sort must be called before Submit.");
+
+    // pass ̕`悷ACe`ɕׂ
+    std::vector<const DrawItem*> passItems;
+    passItems.reserve(ItemCount(pass));
+    auto gather = [&](const DrawItem& item)
+        {
+            if (item.pass == pass && backend.IsValid(item))
+            {
+                passItems.push_back(&item);
+            }
+        };
+    if (sorted)
+    {
+        for (const SortEntry& entry : entries)
+        {
+            gather(items[entry.item]);
+        }
+    }
+    else
+    {
+        for (const DrawItem& item : items)
+        {
+            gather(item);
+        }
+    }
+    const bool instancing = enableInstancing && sorted && elideStateChanges;
+
+    // ݒ肳ĂXe[g
+    bool hasState = false;
+    bool instanced = false;
+    uint32_t pipeline = 0;
+    uint32_t model = 0;
+    int32_t material = -1;
+    int32_t vertexBuffer = -1;
+    uint32_t indexModel = 0;
+    int32_t indexBuffer = -1;
+    int32_t skin = -1;
+
+    for (size_t first = 0; first < passItems.size();)
+    {
+        const DrawItem& item = *passItems[first];
+
+        // Xe[gőACe𐔂
+        size_t count = 1;
+        if (instancing)
+        {
+            while (first + count < passItems.size() && CanInstance(item, *passItems[first + count]))
+            {
+                ++count;
+            }
+            if (count < (std::max)(minInstanceCount, size_t(2)))
+            {
+                count = 1;
+            }
+        }
+        const bool drawInstanced = count > 1;
+
+        const bool force = !elideStateChanges || !hasState;
+        const bool pipelineChanged = force || pipeline != item.pipeline || instanced != drawInstanced;
+        const bool modelChanged = force || model != item.model;
+        if (pipelineChanged)
+        {
+            backend.BindPipeline(item, drawInstanced);
+        }
+        if (modelChanged)
+        {
+            backend.BindModel(item);
+        }
+        if (modelChanged || material != item.material)
+        {
+            backend.BindMaterial(item);
+        }
+        if (pipelineChanged || modelChanged || vertexBuffer != item.vertexBuffer)
+        {
+            backend.BindVertexBuffer(item, drawInstanced);
+        }
+        if (item.indexBuffer > -1 && (force || indexModel != item.model || indexBuffer != item.indexBuffer))
+        {
+            backend.BindIndexBuffer(item);
+            indexModel = item.model;
+            indexBuffer = item.indexBuffer;
+        }
+        if (item.skin > -1 && (force || skin != item.skin))
+        {
+            backend.BindSkin(item);
+            skin = item.skin;
+        }
+        if (drawInstanced)
+        {
+            backend.DrawInstanced(&passItems[first], count);
+        }
+        else
+        {
+            backend.Draw(item);
+        }
+
+        hasState = true;
+        instanced = drawInstanced;
+        pipeline = item.pipeline;
+        model = item.model;
+        material = item.material;
+        vertexBuffer = item.vertexBuffer;
+        first += count;
+    }
+}
+
+RenderQueue::SubmitStatistics RenderQueue::Measure() const
+{
+    SubmitStatistics statistics;
+    statistics.itemCount = items.size();
+    statistics.sortMilliseconds = sortMilliseconds;
+
+    RecordingBackend unsorted;
+    RecordingBackend sorted;
+    for (size_t pass = 0; pass < PassCount; ++pass)
+    {
+        Submit(static_cast<Pass>(pass), unsorted, false, false);
+        if (isSorted)
+        {
+            Submit(static_cast<Pass>(pass), sorted, true, true);
+        }
+    }
+    statistics.unsorted = unsorted.counters;
+    statistics.sorted = sorted.counters;
+    return statistics;
+}
+
+std::string RenderQueue::SubmitStatistics::ToString() const
+{
+    char buf[256];
+    std::string text;
+    sprintf_s(buf, "  items %zu, sort %.3f ms\n", itemCount, sortMilliseconds);
+    text += buf;
+    sprintf_s(buf, "  %-8s : %5s %5s %5s %5s %5s %5s | %6s %5s %5s %6s\n", "", "pso", "model", "mat", "vb", "ib", "skin", "binds", "draws", "inst", "items");
+    text += buf;
+    auto line = [&](const char* name, const Counters& counters)
+        {
+            sprintf_s(buf, "  %-8s : %5zu %5zu %5zu %5zu %5zu %5zu | %6zu %5zu %5zu %6zu\n", name, counters.pipelines, counters.models, counters.materials,
+                counters.vertexBuffers, counters.indexBuffers, counters.skins, counters.Binds(), counters.draws, counters.instancedDraws, counters.instances);
+            text += buf;
+        };
+    line("unsorted", unsorted);
+    line("sorted", sorted);
+    if (unsorted.Binds() > 0)
+    {
+        sprintf_s(buf, "  state changes : %.1f%%\n", 100.0 * static_cast<double>(sorted.Binds()) / static_cast<double>(unsorted.Binds()));
+        text += buf;
+    }
+    return text;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 1 t[̕`ACe (t[pPbg) W߂āA64bit ̃\[gL[ŕבւĂ`悷
+// \[gL[͏ʂ pX / pCvC / f / }eA / _obt@ / [x ̏ɋl߂
+// (͐[x pX̎ɒuĉ`)
+// `̎͑ÕACeƓXe[g̐ݒȂ
+// בւőĕԓXe[gE instanceGroup ̃ACe 1 ̃CX^X`ɂ܂Ƃ߂
+class RenderQueue
+{
+public:
+    enum class Pass : uint32_t
+    {
+        Opaque,
+        Mask,
+        Blend,
+        Shadow,
+    };
+    static constexpr size_t PassCount = 4;
+
+    struct DrawItem
+    {
+        uint64_t key = 0;
+        uint32_t order = 0;         // o (AddItem ̏)
+        Pass pass = Pass::Opaque;
+
+        // `悷鑤g߂ԍ
+        uint32_t drawable = 0;
+        int32_t node = -1;          // XLbṼm[h (ob` -1)
+        int32_t primitive = 0;      // v~eBu / ob`bV̔ԍ
+
+        // Xe[g̎ʎq (ÕACeƓȂݒȂ)
+        uint32_t pipeline = 0;      // InternPipeline ̖߂l
+        uint32_t model = 0;         // InternModel ̖߂l
+        int32_t material = -1;
+        int32_t vertexBuffer = -1;
+        int32_t indexBuffer = -1;   // -1 ȂCfbNXȂ
+        int32_t skin = -1;          // joint ̒萔obt@ (lȂ瓯s)
+        int32_t instanceGroup = -1; // -1 Ȃ܂Ƃ߂ȂBlmCX^X`ɂ܂Ƃ߂
+        int32_t lod = 0;            // CfbNX LOD ̒i (imCX^X`ɂ܂Ƃ߂)
+        int32_t meshletDraw = -1;   // 郁bVbg`͈̔͂̈ꗗ (`悷鑤߂ԍB-1 ȂS)
+    };
+
+    // Xe[g̐ݒƕ`s
+    class SubmitBackend
+    {
+    public:
+        virtual ~SubmitBackend() = default;
+        // false Ȃ`悵Ȃ (ǒŃAN^[jꂽȂ)
+        virtual bool IsValid(const DrawItem& item) const { return true; }
+        // instanced ̓CX^X`p̃VF[_[E̓CAEggǂ
+        virtual void BindPipeline(const DrawItem& item, bool instanced) = 0;
+        virtual void BindModel(const DrawItem& item) = 0;
+        virtual void BindMaterial(const DrawItem& item) = 0;
+        // pCvCݒ肷Ɠ̓CAEg㏑̂ŁǍ͕KĂ΂
+        virtual void BindVertexBuffer(const DrawItem& item, bool instanced) = 0;
+        virtual void BindIndexBuffer(const DrawItem& item) = 0;
+        virtual void BindSkin(const DrawItem& item) = 0;
+        virtual void Draw(const DrawItem& item) = 0;
+        // items[0] ̃Xe[g count ܂Ƃ߂ĕ`悷
+        virtual void DrawInstanced(const DrawItem* const* items, size_t count) = 0;
+    };
+
+    struct Counters
+    {
+        size_t pipelines = 0;
+        size_t models = 0;
+        size_t materials = 0;
+        size_t vertexBuffers = 0;
+        size_t indexBuffers = 0;
+        size_t skins = 0;
+        size_t draws = 0;
+        size_t instancedDraws = 0;  // draws ̂CX^X`̉
+        size_t instances = 0;       // CX^X`ŕ`ACe̐
+
+        size_t Binds() const { return pipelines + models + materials + vertexBuffers + indexBuffers + skins; }
+    };
+
+    // Ă΂ꂽ񐔂𐔂邾 SubmitBackend (GPU ȂŌv)
+    class RecordingBackend : public SubmitBackend
+    {
+    public:
+        void BindPipeline(const DrawItem&, bool) override { ++counters.pipelines; }
+        void BindModel(const DrawItem&) override { ++counters.models; }
+        void BindMaterial(const DrawItem&) override { ++counters.materials; }
+        void BindVertexBuffer(const DrawItem&, bool) override { ++counters.vertexBuffers; }
+        void BindIndexBuffer(const DrawItem&) override { ++counters.indexBuffers; }
+        void BindSkin(const DrawItem&) override { ++counters.skins; }
+        void Draw(const DrawItem& item) override { ++counters.draws; items.push_back(item.order); }
+        void DrawInstanced(const DrawItem* const* instancedItems, size_t count) override
+        {
+            ++counters.draws;
+            ++counters.instancedDraws;
+            counters.instances += count;
+            groups.push_back({ items.size(), count });
+            for (size_t index = 0; index < count; ++index)
+            {
+                items.push_back(instancedItems[index]->order);
+            }
+        }
+
+        Counters counters;
+        std::vector<uint32_t> items;
+        // CX^X`ɂ܂Ƃ߂͈ (items ̐擪̈ʒu, )
+        std::vector<std::pair<size_t, size_t>> groups;
+    };
+
+    // oEȗȂ (܂ł̕`) ƁAבւEȗ ̔r
+    struct SubmitStatistics
+    {
+        size_t itemCount = 0;
+        Counters unsorted;
+        Counters sorted;
+        double sortMilliseconds = 0.0;
+
+        std::string ToString() const;
+    };
+
+    // ACeƎʎqɂ
+    void BeginFrame();
+
+    // ɂ͓ԍԂ
+    uint32_t InternPipeline(const std::string& pipeline);
+    uint32_t InternModel(const void* model);
+
+    // depth ̓J̋ (0 ȏ)Bitem.key ͂ō
+    void AddItem(DrawItem item, float depth);
+
+    // L[ňɕבւ (8bit  LSD \[g)
+    void Sort();
+
+    // pass ̃ACe`悷
+    // sorted = false Ȃ璊oAelideStateChanges = false Ȃ疈SẴXe[gݒ肷
+    // CX^X`ɂ܂Ƃ߂̂ sorted  elideStateChanges  true  enableInstancing ̎
+    void Submit(Pass pass, SubmitBackend& backend, bool sorted = true, bool elideStateChanges = true) const;
+
+    size_t ItemCount() const { return items.size(); }
+    size_t ItemCount(Pass pass) const { return passCounts[static_cast<size_t>(pass)]; }
+    const std::vector<DrawItem>& Items() const { return items; }
+    double SortMilliseconds() const { return sortMilliseconds; }
+
+    // RecordingBackend őSẴpX𗬂Đ
+    SubmitStatistics Measure() const;
+
+    // Xe[gőĕ`邩 (CX^X`ɂ܂Ƃ߂邩)
+    static bool CanInstance(const DrawItem& first, const DrawItem& item);
+
+    static uint64_t MakeKey(const DrawItem& item, float depth);
+    static uint16_t QuantizeDepth(float depth);
+
+    // false ȂCX^X`ɂ܂Ƃ߂Ȃ
+    bool enableInstancing = true;
+    // ̐ȏ㑱܂Ƃ߂
+    size_t minInstanceCount = 2;
+
+private:
+    // Source/Test/RenderQueueTest.cpp ׂԂm߂
+    friend class RenderQueueTest;
+
+    struct SortEntry
+    {
+        uint64_t key;
+        uint32_t item;
+    };
+
+    std::vector<DrawItem> items;
+    std::vector<SortEntry> entries;
+    std::vector<SortEntry> scratch;
+    size_t passCounts[PassCount] = {};
+    bool isSorted = false;
+    double sortMilliseconds = 0.0;
+
+    std::unordered_map<std::string, uint32_t> pipelineIds;
+    std::unordered_map<const void*, uint32_t> modelIds;
+};
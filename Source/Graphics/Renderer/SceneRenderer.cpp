@@ -1,6 +1,15 @@
 #include "SceneRenderer.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <optional>
+#include <string>
+
 #include "Engine/Scene/Scene.h"
+#include "Engine/Debug/Profiler.h"
 #include "Game/Actors/Stage/Cloth.h"
 
 UINT SizeofComponent(DXGI_FORMAT format)
@@ -26,13 +35,63 @@ UINT SizeofComponent(DXGI_FORMAT format)
 //    return true;
 //}
 
-void SceneRenderer::RenderOpaque(ID3D11DeviceContext* immediateContext/*, std::vector<std::shared_ptr<Actor>> allActors*/) const
+namespace
+{
+    // Draw Ɠf̍WnEPʂ̕ϊ
+    DirectX::XMMATRIX ModelCoordinateTransform(const InterleavedGltfModel* model)
+    {
+        const DirectX::XMFLOAT4X4 coordinateSystemTransforms[]
+        {
+            {//RHS Y-UP
+                -1,0,0,0,
+                 0,1,0,0,
+                 0,0,1,0,
+                 0,0,0,1,
+            },
+            {//LHS Y-UP
+                1,0,0,0,
+                0,1,0,0,
+                0,0,1,0,
+                0,0,0,1,
+            },
+            {//RHS Z-UP
+                -1,0, 0,0,
+                 0,0,-1,0,
+                 0,1, 0,0,
+                 0,0, 0,1,
+            },
+            {//LHS Z-UP
+                1,0,0,0,
+                0,0,1,0,
+                0,1,0,0,
+                0,0,0,1,
+            },
+        };
+        const float scaleFactor = model->isModelInMeters ? 1.0f : 0.01f;
+        return DirectX::XMLoadFloat4x4(&coordinateSystemTransforms[static_cast<int>(model->modelCoordinateSystem)]) * DirectX::XMMatrixScaling(scaleFactor, scaleFactor, scaleFactor);
+    }
+
+    AABB InfiniteBounds()
+    {
+        return { { -FLT_MAX, -FLT_MAX, -FLT_MAX }, { FLT_MAX, FLT_MAX, FLT_MAX } };
+    }
+
+    bool IsFiniteBounds(const AABB& bounds)
+    {
+        return bounds.min.x <= bounds.max.x && bounds.min.y <= bounds.max.y && bounds.min.z <= bounds.max.z &&
+            bounds.min.x > -FLT_MAX && bounds.min.y > -FLT_MAX && bounds.min.z > -FLT_MAX &&
+            bounds.max.x < FLT_MAX && bounds.max.y < FLT_MAX && bounds.max.z < FLT_MAX;
+    }
+}
+
+void SceneRenderer::CollectDrawables(std::vector<Drawable>& out) const
 {
+    out.clear();
     Scene* currentScene = Scene::GetCurrentScene();  // ݂̃V[擾
     if (!currentScene) return;
     auto& allActors = currentScene->GetActorManager()->GetAllActors();
 
-    for (auto actor : allActors)
+    for (auto& actor : allActors)
     {
         if (!actor->rootComponent_)
         {
@@ -48,174 +107,814 @@ void SceneRenderer::RenderOpaque(ID3D11DeviceContext* immediateContext/*, std::v
         std::vector<MeshComponent*> meshComponents;
         actor->GetComponents<MeshComponent>(meshComponents);
 
-        for (MeshComponent* meshComponent : meshComponents)
+        for (const MeshComponent* meshComponent : meshComponents)
         {
             if (!meshComponent->IsVisible())
             { // `tO false ȂXLbv
                 continue;
             }
-            // e MeshComponent g̍ŐV[hso
-            const auto& worldMat = meshComponent->GetComponentWorldTransform().ToWorldTransform();
-            // e MeshComponent  model o
-            const InterleavedGltfModel* model = meshComponent->model.get();
-
-            auto* convexComponent = actor->GetComponent<ConvexCollisionComponent>();
-            if (convexComponent = dynamic_cast<ConvexCollisionComponent*>(convexComponent))
-            {
-                //meshComponent->model->Render(immediateContext, worldMat, convexComponent->GetAnimatedNodes(), InterleavedGltfModel::RenderPass::Opaque);
-            }
-
-
-            if (meshComponent->model->mode == InterleavedGltfModel::Mode::SkeltalMesh)
-            {// 
-                Draw(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Opaque);
-            }
-            else if (meshComponent->model->mode == InterleavedGltfModel::Mode::StaticMesh)
+            if (!meshComponent->model)
             {
-                DrawWithStaticBatching(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Opaque);
+                continue;
             }
-
-            //  `Ăяo
-            //meshComponent->RenderOpaque(immediateContext, worldMat);
+            // e MeshComponent g̍ŐV[hso
+            out.push_back({ actor, meshComponent, meshComponent->GetComponentWorldTransform().ToWorldTransform() });
         }
     }
 }
 
-void SceneRenderer::RenderMask(ID3D11DeviceContext* immediateContext) const
+AABB SceneRenderer::ComputeWorldBounds(const MeshComponent* meshComponent, const DirectX::XMFLOAT4X4& world) const
 {
-    Scene* currentScene = Scene::GetCurrentScene();  // ݂̃V[擾
-    if (!currentScene) return;
-    auto& allActors = currentScene->GetActorManager()->GetAllActors();
+    using namespace DirectX;
 
-    for (auto actor : allActors)
-    {
-        if (!actor->rootComponent_)
+    const InterleavedGltfModel* model = meshComponent->model.get();
+    const XMMATRIX C = ModelCoordinateTransform(model);
+
+    if (model->mode == InterleavedGltfModel::Mode::StaticMesh)
+    {// ob`̒_̓fԂȂ̂ŁALbVɓĂ AABB ̂܂܎g
+        if (!model->hasLocalBounds)
         {
-            continue;
+            return InfiniteBounds();
         }
+        XMFLOAT4X4 transform;
+        XMStoreFloat4x4(&transform, C * XMLoadFloat4x4(&world));
+        return VisibilityCulling::TransformBounds(model->localBounds, transform);
+    }
 
-        if (!actor->isActive)
-        {// actor݂ĂȂXLbv
+    // XLbṼ͍m[h̎pŁAbVm[h AABB 킹
+    XMVECTOR minVec = XMVectorReplicate(FLT_MAX);
+    XMVECTOR maxVec = XMVectorReplicate(-FLT_MAX);
+    bool found = false;
+    for (const InterleavedGltfModel::Node& node : meshComponent->modelNodes)
+    {
+        if (node.mesh < 0)
+        {
             continue;
         }
+        const AABB nodeBounds{ node.minValue, node.maxValue };
+        if (!IsFiniteBounds(nodeBounds))
+        {// accessor  min/max ȂbV͑IʂłȂ
+            return InfiniteBounds();
+        }
+        XMFLOAT4X4 transform;
+        XMStoreFloat4x4(&transform, XMLoadFloat4x4(&node.globalTransform) * C * XMLoadFloat4x4(&world));
+        const AABB bounds = VisibilityCulling::TransformBounds(nodeBounds, transform);
+        XMVECTOR boundsMin = XMLoadFloat3(&bounds.min);
+        XMVECTOR boundsMax = XMLoadFloat3(&bounds.max);
+        if (node.skin > -1)
+        {
+            const XMVECTOR margin = XMVectorReplicate(skinnedBoundsMargin);
+            boundsMin = XMVectorSubtract(boundsMin, margin);
+            boundsMax = XMVectorAdd(boundsMax, margin);
+        }
+        minVec = XMVectorMin(minVec, boundsMin);
+        maxVec = XMVectorMax(maxVec, boundsMax);
+        found = true;
+    }
+    if (!found)
+    {
+        return InfiniteBounds();
+    }
+    AABB result;
+    XMStoreFloat3(&result.min, minVec);
+    XMStoreFloat3(&result.max, maxVec);
+    return IsFiniteBounds(result) ? result : InfiniteBounds();
+}
 
-        // actor ɕtĂSĂ meshComponent o
-        std::vector<MeshComponent*> meshComponents;
-        actor->GetComponents<MeshComponent>(meshComponents);
-
-        for (const MeshComponent* meshComponent : meshComponents)
+void SceneRenderer::PrepareVisibility(const DirectX::XMFLOAT4X4& cameraViewProjection, const std::vector<DirectX::XMFLOAT4X4>& cascadeViewProjections)
+{
+    PROFILE_ZONE("SceneRenderer::PrepareVisibility", "render");
+    CollectDrawables(drawables);
+    // CX^Xobt@̓v 1 t[ɂ
+    instanceBuffer->ResetStatistics();
+
+    // בւɎgJ̋ (AABB ̒S̃NbvԂ w)
+    const DirectX::XMFLOAT4X4& m = cameraViewProjection;
+    std::vector<float> depths(drawables.size());
+    //  1 Œ 1 ʏŉsNZɂȂ邩 (ˉes _22 ̓r[ˉes 2 ڂ̒)
+    const float projectionScale = std::sqrt(m._12 * m._12 + m._22 * m._22 + m._32 * m._32) * Graphics::GetScreenHeight() * 0.5f;
+    std::unordered_map<const MeshComponent*, int> previousLodLevels;
+    previousLodLevels.swap(lodLevels);
+    lodHistogram = {};
+    visibility.BeginFrame();
+    for (size_t object = 0; object < drawables.size(); ++object)
+    {
+        Drawable& drawable = drawables.at(object);
+        const AABB bounds = ComputeWorldBounds(drawable.meshComponent, drawable.world);
+        DirectX::XMFLOAT3 center = { drawable.world._41, drawable.world._42, drawable.world._43 };
+        float radius = 0.0f;
+        const bool isFinite = IsFiniteBounds(bounds);
+        if (isFinite)
         {
-            if (!meshComponent->IsVisible())
-            { // `tO false ȂXLbv
-                continue;
-            }
-            // e MeshComponent g̍ŐV[hso
-            const auto& worldMat = meshComponent->GetComponentWorldTransform().ToWorldTransform();
-            // e MeshComponent  model o
-            const InterleavedGltfModel* model = meshComponent->model.get();
+            center = { (bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f };
+            radius = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&bounds.max), DirectX::XMLoadFloat3(&bounds.min)))) * 0.5f;
+        }
+        depths.at(object) = center.x * m._14 + center.y * m._24 + center.z * m._34 + m._44;
+        if (enableCulling)
+        {
+            visibility.AddBounds(bounds);
+        }
 
-            if (meshComponent->model->mode == InterleavedGltfModel::Mode::SkeltalMesh)
-            {// 
-                Draw(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Mask);
-            }
-            else if (meshComponent->model->mode == InterleavedGltfModel::Mode::StaticMesh)
+        // LOD ̒iI (͈͂Ȃ́Ez͌̃bV)
+        const InterleavedGltfModel* model = drawable.meshComponent->model.get();
+        drawable.lod = 0;
+        if (enableLod && isFinite && !model->lodErrors.empty() && !dynamic_cast<const ClothMeshComponent*>(drawable.meshComponent))
+        {
+            // ԋ߂̌덷őI (傫̂̓oEfBOXtBA̎O܂ł̋)
+            const float distance = depths.at(object) - radius;
+            if (distance > 0.0f)
             {
-                DrawWithStaticBatching(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Mask);
+                const DirectX::XMMATRIX world = ModelCoordinateTransform(model) * DirectX::XMLoadFloat4x4(&drawable.world);
+                const float scale = (std::max)({ DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[0])),
+                    DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[1])), DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[2])) });
+                auto previous = previousLodLevels.find(drawable.meshComponent);
+                drawable.lod = MeshSimplifier::SelectLod(model->lodErrors.data(), model->lodErrors.size(), projectionScale * scale / distance,
+                    lodPixelError, lodHysteresis, previous != previousLodLevels.end() ? previous->second : 0);
             }
         }
+        lodLevels[drawable.meshComponent] = drawable.lod;
+        ++lodHistogram.at(drawable.lod);
+    }
+
+    if (enableCulling)
+    {
+        visibility.AddView({ "camera", cameraViewProjection, false });
+        for (size_t cascadeIndex = 0; cascadeIndex < cascadeViewProjections.size(); ++cascadeIndex)
+        {
+            visibility.AddView({ "cascade" + std::to_string(cascadeIndex), cascadeViewProjections.at(cascadeIndex), true });
+        }
+        visibility.Cull();
+        cameraVisible = visibility.Visible(0);
+    }
+    else
+    {// IʂȂ͑SČ
+        cameraVisible.resize(drawables.size());
+        std::iota(cameraVisible.begin(), cameraVisible.end(), 0u);
+    }
+
+    if (!enableCulling || cascadeViewProjections.empty())
+    {// Cg̍s񂪂ȂΉe͑Sĕ`
+        shadowVisible.resize(drawables.size());
+        std::iota(shadowVisible.begin(), shadowVisible.end(), 0u);
     }
+    else
+    {// JXP[h 1 ̕`őSď̂ŁAǂꂩɓĂΕ`
+        shadowVisible = visibility.VisibleInAny(1, cascadeViewProjections.size());
+    }
+
+    CullMeshlets(cameraViewProjection);
+
+    // SẴpX̕`ACe 1 񂾂W߂ĕבւ
+    renderQueue.BeginFrame();
+    renderQueue.enableInstancing = enableInstancing;
+    ExtractRenderQueue(drawables, cameraVisible, shadowVisible, depths, renderQueue);
+    renderQueue.Sort();
+    isVisibilityPrepared = true;
+    PROFILE_COUNTER("Drawables", drawables.size());
+    PROFILE_COUNTER("Camera visible", cameraVisible.size());
 }
 
-void SceneRenderer::RenderBlend(ID3D11DeviceContext* immediateContext) const
+void SceneRenderer::ClearVisibility()
 {
-    Scene* currentScene = Scene::GetCurrentScene();  // ݂̃V[擾
-    if (!currentScene) return;
-    auto& allActors = currentScene->GetActorManager()->GetAllActors();
+    isVisibilityPrepared = false;
+    drawables.clear();
+    cameraVisible.clear();
+    shadowVisible.clear();
+    lodLevels.clear();
+    lodHistogram = {};
+    meshletRanges.clear();
+    meshletDraws.clear();
+    meshletFirstDraw.clear();
+    meshletStatistics = {};
+    renderQueue.BeginFrame();
+}
 
-    for (auto actor : allActors)
+void SceneRenderer::CullMeshlets(const DirectX::XMFLOAT4X4& cameraViewProjection)
+{
+    PROFILE_ZONE("SceneRenderer::CullMeshlets", "render");
+    meshletRanges.clear();
+    meshletDraws.clear();
+    meshletFirstDraw.assign(drawables.size(), -1);
+    meshletStatistics = {};
+    if (!enableMeshletCulling)
     {
-        if (!actor->rootComponent_)
+        return;
+    }
+
+    std::vector<uint32_t> visibleMeshlets;
+    for (uint32_t object : cameraVisible)
+    {
+        const Drawable& drawable = drawables.at(object);
+        const InterleavedGltfModel* model = drawable.meshComponent->model.get();
+        // bVbg 0 iڂ̃CfbNX𕪂
+        if (model->mode != InterleavedGltfModel::Mode::StaticMesh || drawable.lod != 0 ||
+            std::none_of(model->batchMeshes.begin(), model->batchMeshes.end(), [](const InterleavedGltfModel::BatchMesh& batchMesh) { return !batchMesh.meshletClusters.empty(); }))
         {
             continue;
         }
 
-        if (!actor->isActive)
-        {// actor݂ĂȂXLbv
-            continue;
+        const DirectX::XMMATRIX world = ModelCoordinateTransform(model) * DirectX::XMLoadFloat4x4(&drawable.world);
+        DirectX::XMFLOAT4X4 modelViewProjection;
+        DirectX::XMStoreFloat4x4(&modelViewProjection, world * DirectX::XMLoadFloat4x4(&cameraViewProjection));
+        // g嗦ƂɈႤƉ~̊pxς̂ŁA䂾őIʂ
+        const float scales[3] = { DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[0])),
+            DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[1])), DirectX::XMVectorGetX(DirectX::XMVector3Length(world.r[2])) };
+        const auto [minScale, maxScale] = std::minmax({ scales[0], scales[1], scales[2] });
+        const bool coneCulling = maxScale - minScale <= maxScale * 1e-3f;
+
+        meshletFirstDraw.at(object) = static_cast<int32_t>(meshletDraws.size());
+        for (const InterleavedGltfModel::BatchMesh& batchMesh : model->batchMeshes)
+        {
+            MeshletDraw& draw = meshletDraws.emplace_back();
+            if (batchMesh.meshletClusters.empty())
+            {
+                continue;
+            }
+            draw.isCulled = true;
+            draw.firstRange = static_cast<uint32_t>(meshletRanges.size());
+            MeshletCulling::CullMeshlets(batchMesh.meshletClusters, modelViewProjection, coneCulling, visibleMeshlets, &meshletStatistics);
+            draw.rangeCount = static_cast<uint32_t>(MeshletCulling::BuildRanges(batchMesh.meshletClusters, visibleMeshlets,
+                static_cast<size_t>((std::max)(meshletMaxRanges, 1)), meshletRanges, &meshletStatistics));
         }
+    }
+}
 
-        // actor ɕtĂSĂ meshComponent o
-        std::vector<MeshComponent*> meshComponents;
-        actor->GetComponents<MeshComponent>(meshComponents);
+void SceneRenderer::ExtractRenderQueue(const std::vector<Drawable>& frameDrawables, const std::vector<uint32_t>& cameraObjects, const std::vector<uint32_t>& shadowObjects,
+    const std::vector<float>& depths, RenderQueue& queue) const
+{
+    // pCvC̖O͕`̎ currentRenderPath 猈߂̂ŁAł͖O߂ޗŋʂ
+    auto pipelineKey = [](const std::string& name, int alphaMode, InterleavedGltfModel::Mode mode)
+        {
+            return name + "|" + std::to_string(alphaMode) + "|" + std::to_string(static_cast<int>(mode));
+        };
+    // pCvCEob`bVłACX^X`ł̂͒_VF[_[
+    //  GltfModelStaticBatchingVS ̃pCvC (CX^X`p VS ɍւ)
+    const PipeLineStateDesc* defaultStaticPipeline = pipeLineStateSet->FindPipeLineState("forwardOpaqueStaticMesh");
+    std::unordered_map<std::string, bool> instanceablePipelines;
+    auto isInstanceable = [&](const std::string& name)
+        {
+            auto it = instanceablePipelines.find(name);
+            if (it == instanceablePipelines.end())
+            {
+                const PipeLineStateDesc* pipeline = pipeLineStateSet->FindPipeLineState(name);
+                it = instanceablePipelines.emplace(name, defaultStaticPipeline && pipeline && pipeline->vertexShader == defaultStaticPipeline->vertexShader).first;
+            }
+            return it->second;
+        };
+    // pCvCւ̂̓sNZVF[_[萔obt@̐FEG~bVEfB]uǂނ̂ŁA
+    // ̒l̓m܂Ƃ߂ (̃pCvC͓ǂ܂Ȃ̂őS 0 )
+    std::unordered_map<std::string, int32_t> instanceGroups;
+    auto instanceGroup = [&](const InterleavedGltfModel::InstanceParameters& instance)
+        {
+            char key[128];
+            sprintf_s(key, "%a %a %a %a %a %a", instance.cpuColor.x, instance.cpuColor.y, instance.cpuColor.z, instance.alpha, instance.emission, instance.disolveFactor);
+            return instanceGroups.emplace(key, static_cast<int32_t>(instanceGroups.size()) + 1).first->second;
+        };
 
-        for (const MeshComponent* meshComponent : meshComponents)
+    auto colorPass = [](int alphaMode, RenderQueue::Pass& pass)
         {
-            if (!meshComponent->IsVisible())
-            { // `tO false ȂXLbv
-                continue;
+            switch (alphaMode)
+            {
+            case 0/*OPAQUE*/: pass = RenderQueue::Pass::Opaque; return true;
+            case 1/*MASK*/: pass = RenderQueue::Pass::Mask; return true;
+            case 2/*BLEND*/: pass = RenderQueue::Pass::Blend; return true;
             }
-            // e MeshComponent g̍ŐV[hso
-            const auto& worldMat = meshComponent->GetComponentWorldTransform().ToWorldTransform();
-            // e MeshComponent  model o
+            return false;
+        };
+
+    auto extract = [&](uint32_t object, bool isShadow, int& skinCount)
+        {
+            const Drawable& drawable = frameDrawables.at(object);
+            const MeshComponent* meshComponent = drawable.meshComponent;
             const InterleavedGltfModel* model = meshComponent->model.get();
+            const float depth = depths.at(object);
 
-            if (meshComponent->model->mode == InterleavedGltfModel::Mode::SkeltalMesh)
-            {// 
-                Draw(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Blend);
+            RenderQueue::DrawItem item;
+            item.drawable = object;
+            item.model = queue.InternModel(model);
+            item.lod = drawable.lod;
+
+            if (model->mode == InterleavedGltfModel::Mode::StaticMesh)
+            {
+                for (size_t batchIndex = 0; batchIndex < model->batchMeshes.size(); ++batchIndex)
+                {
+                    const InterleavedGltfModel::BatchMesh& batchMesh = model->batchMeshes.at(batchIndex);
+                    const InterleavedGltfModel::Material& material = model->materials.at(batchMesh.material);
+                    item.node = -1;
+                    item.primitive = static_cast<int32_t>(batchIndex);
+                    item.material = batchMesh.material;
+                    item.vertexBuffer = batchMesh.vertexBufferView.buffer;
+                    item.indexBuffer = batchMesh.indexBufferView.buffer;
+                    item.skin = -1;
+                    item.meshletDraw = -1;
+                    if (isShadow)
+                    {// ob`̉e̓f̃VF[_[g
+                        item.pass = RenderQueue::Pass::Shadow;
+                        item.pipeline = queue.InternPipeline("#csm|" + std::to_string(item.model));
+                        item.instanceGroup = 0;
+                    }
+                    else
+                    {
+                        if (!colorPass(material.data.alphaMode, item.pass))
+                        {
+                            continue;
+                        }
+                        const std::string name = material.overridePipelineName.has_value() ? *material.overridePipelineName :
+                            meshComponent->overridePipelineName.has_value() ? *meshComponent->overridePipelineName : "#";
+                        item.pipeline = queue.InternPipeline(pipelineKey(name, material.data.alphaMode, model->mode));
+                        if (name == "#")
+                        {
+                            item.instanceGroup = 0;
+                        }
+                        else
+                        {
+                            item.instanceGroup = isInstanceable(name) ? instanceGroup(meshComponent->instanceParameters) : -1;
+                        }
+                        // bVbgIʂ (PrepareVisibility  drawables ) ͈͌͂` (͈͂ACeƂɈႤ̂ł܂Ƃ߂Ȃ)
+                        const int32_t firstDraw = &frameDrawables == &drawables && object < meshletFirstDraw.size() ? meshletFirstDraw[object] : -1;
+                        if (firstDraw > -1 && meshletDraws.at(firstDraw + batchIndex).isCulled)
+                        {
+                            if (meshletDraws.at(firstDraw + batchIndex).rangeCount == 0)
+                            {
+                                continue;
+                            }
+                            item.meshletDraw = firstDraw + static_cast<int32_t>(batchIndex);
+                            item.instanceGroup = -1;
+                        }
+                    }
+                    queue.AddItem(item, depth);
+                }
+                return;
             }
-            else if (meshComponent->model->mode == InterleavedGltfModel::Mode::StaticMesh)
+            if (model->mode != InterleavedGltfModel::Mode::SkeltalMesh)
             {
-                DrawWithStaticBatching(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Blend);
+                return;
             }
 
-        }
+            const std::vector<InterleavedGltfModel::Node>& nodes = meshComponent->modelNodes;
+            std::function<void(int)> traverse = [&](int nodeIndex)->void {
+                const InterleavedGltfModel::Node& node = nodes.at(nodeIndex);
+                if (node.mesh > -1)
+                {
+                    const int skin = node.skin > -1 ? skinCount++ : -1;
+                    const InterleavedGltfModel::Mesh& mesh = model->meshes.at(node.mesh);
+                    for (int primitiveIndex = 0; primitiveIndex < static_cast<int>(mesh.primitives.size()); ++primitiveIndex)
+                    {
+                        const InterleavedGltfModel::Mesh::Primitive& primitive = mesh.primitives.at(primitiveIndex);
+                        // CX^XƂ̃}eAւ𔽉f
+                        const int materialIndex = meshComponent->instanceParameters.GetPrimitiveMaterial(node.mesh, primitiveIndex, primitive.material);
+                        const InterleavedGltfModel::Material& material = model->materials.at(materialIndex);
+                        item.node = nodeIndex;
+                        item.primitive = primitiveIndex;
+                        item.material = materialIndex;
+                        item.vertexBuffer = primitive.vertexBufferView.buffer;
+                        item.indexBuffer = primitive.indexBufferView.buffer;
+                        item.skin = skin;
+                        item.instanceGroup = -1;
+
+                        std::string name;
+                        if (isShadow)
+                        {
+                            item.pass = RenderQueue::Pass::Shadow;
+                            name = material.overridePipelineName.has_value() ? *material.overridePipelineName :
+                                meshComponent->overrideCascadeShadowPipelineName.has_value() ? *meshComponent->overrideCascadeShadowPipelineName : "#";
+                        }
+                        else
+                        {
+                            if (!colorPass(material.data.alphaMode, item.pass))
+                            {
+                                continue;
+                            }
+                            name = material.overridePipelineName.has_value() ? *material.overridePipelineName :
+                                meshComponent->overridePipelineName.has_value() ? *meshComponent->overridePipelineName : "#";
+                        }
+                        item.pipeline = queue.InternPipeline(pipelineKey(name, material.data.alphaMode, model->mode));
+                        queue.AddItem(item, depth);
+                    }
+                }
+                for (std::vector<int>::value_type childIndex : node.children)
+                {
+                    traverse(childIndex);
+                }
+                };
+            for (std::vector<int>::value_type nodeIndex : model->scenes.at(model->defaultScene).nodes)
+            {
+                traverse(nodeIndex);
+            }
+        };
+
+    // joint ̒萔obt@ (drawable, m[h) ƂɔԍtāAĕ`͐ݒȂ
+    int skinCount = 0;
+    for (uint32_t object : cameraObjects)
+    {
+        extract(object, false, skinCount);
+    }
+    for (uint32_t object : shadowObjects)
+    {
+        extract(object, true, skinCount);
     }
 }
 
-void SceneRenderer::CastShadowRender(ID3D11DeviceContext* immediateContext)
+class SceneRenderer::QueueBackend : public RenderQueue::SubmitBackend
 {
-    Scene* currentScene = Scene::GetCurrentScene();  // ݂̃V[擾
-    if (!currentScene) return;
-    auto& allActors = currentScene->GetActorManager()->GetAllActors();
+public:
+    QueueBackend(const SceneRenderer& renderer, ID3D11DeviceContext* immediateContext, const std::vector<Drawable>& drawables)
+        : renderer(renderer), immediateContext(immediateContext), drawables(drawables)
+    {
+    }
 
-    for (auto actor : allActors)
+    bool IsValid(const RenderQueue::DrawItem& item) const override
+    {// W߂ŔjꂽAN^[͕`Ȃ
+        return !drawables.at(item.drawable).actor.expired();
+    }
+
+    void BindPipeline(const RenderQueue::DrawItem& item, bool instanced) override
     {
-        if (!actor->rootComponent_)
+        const MeshComponent* meshComponent = drawables.at(item.drawable).meshComponent;
+        const InterleavedGltfModel* model = meshComponent->model.get();
+        if (item.pass == RenderQueue::Pass::Shadow && item.node < 0)
+        {// CASCADED_SHADOW_MAPS (CastShadowWithStaticBatching Ɠ)
+            immediateContext->VSSetShader(instanced ? renderer.instancedCsmVertexShader.Get() : model->vertexShaderCSM.Get(), nullptr, 0);
+            immediateContext->GSSetShader(model->geometryShaderCSM.Get(), nullptr, 0);
+            immediateContext->PSSetShader(nullptr/*SHADOW*/, nullptr, 0);
+            immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            return;
+        }
+
+        const InterleavedGltfModel::Material& material = model->materials.at(item.material);
+        const std::optional<std::string>& overrideName = item.pass == RenderQueue::Pass::Shadow ? meshComponent->overrideCascadeShadowPipelineName : meshComponent->overridePipelineName;
+        std::string pipelineName;
+        if (material.overridePipelineName.has_value())
         {
-            continue;
+            pipelineName = *material.overridePipelineName;
+        }
+        else if (overrideName.has_value())
+        {
+            pipelineName = *overrideName;
+        }
+        else
+        {
+            pipelineName = GetPipelineName(renderer.currentRenderPath, static_cast<MaterialAlphaMode>(material.data.alphaMode), static_cast<ModelMode>(model->mode));
+        }
+        renderer.pipeLineStateSet->BindPipeLineState(immediateContext, pipelineName);
+        if (instanced)
+        {// _VF[_[CX^XƂ̍sĝɂ
+            immediateContext->VSSetShader(renderer.instancedVertexShader.Get(), nullptr, 0);
         }
 
-        if (!actor->isActive)
-        {// actor݂ĂȂXLbv
-            continue;
+        // pCvC̐ݒ㏑pXƂ̃Xe[g
+        switch (item.pass)
+        {
+        case RenderQueue::Pass::Opaque:
+        case RenderQueue::Pass::Mask:
+            RenderState::BindBlendState(immediateContext, BLEND_STATE::MULTIPLY_RENDER_TARGET_NONE);
+            break;
+        case RenderQueue::Pass::Blend:
+            if (item.node > -1)
+            {
+                RenderState::BindDepthStencilState(immediateContext, DEPTH_STATE::ZT_ON_ZW_OFF);
+            }
+            RenderState::BindBlendState(immediateContext, BLEND_STATE::MULTIPLY_RENDER_TARGET_ALPHA);
+            break;
+        case RenderQueue::Pass::Shadow:
+            // sNZVF[_mɉ
+            immediateContext->PSSetShader(nullptr, nullptr, 0);
+            break;
         }
+    }
 
-        // actor ɕtĂSĂ meshComponent o
-        std::vector<MeshComponent*> meshComponents;
-        actor->GetComponents<MeshComponent>(meshComponents);
+    void BindModel(const RenderQueue::DrawItem& item) override
+    {
+        const InterleavedGltfModel* model = Model(item);
+        immediateContext->PSSetShaderResources(0, 1, model->materialResourceView.GetAddressOf());
+    }
 
-        for (const MeshComponent* meshComponent : meshComponents)
+    void BindMaterial(const RenderQueue::DrawItem& item) override
+    {
+        const InterleavedGltfModel* model = Model(item);
+        const InterleavedGltfModel::Material& material = model->materials.at(item.material);
+        const int textureIndices[] =
         {
-            if (!meshComponent->IsVisible())
-            { // `tO false ȂXLbv
-                continue;
+            material.data.pbrMetallicRoughness.basecolorTexture.index,
+            material.data.pbrMetallicRoughness.metallicRoughnessTexture.index,
+            material.data.normalTexture.index,
+            material.data.emissiveTexture.index,
+            material.data.occlusionTexture.index,
+        };
+        ID3D11ShaderResourceView* shaderResourceViews[_countof(textureIndices)] = {};
+        for (int textureIndex = 0; textureIndex < _countof(textureIndices); ++textureIndex)
+        {
+            shaderResourceViews[textureIndex] = textureIndices[textureIndex] > -1 ? model->textureResourceViews.at(model->textures.at(textureIndices[textureIndex]).source).Get() : nullptr;
+        }
+        immediateContext->PSSetShaderResources(1, _countof(shaderResourceViews), shaderResourceViews);
+    }
+
+    void BindVertexBuffer(const RenderQueue::DrawItem& item, bool instanced) override
+    {
+        // pCvC̓̓CAEg𒸓_tH[}bgɍ킹čւ
+        const InterleavedGltfModel* model = Model(item);
+        if (item.node < 0)
+        {
+            const InterleavedGltfModel::BatchMesh& batchMesh = model->batchMeshes.at(item.primitive);
+            model->BindVertexBuffer(immediateContext, batchMesh.vertexFormat, batchMesh.vertexBufferView.buffer);
+            if (instanced)
+            {// CX^XƂ̃f[^ (2 ԃXbg) ܂ޓ̓CAEg
+                immediateContext->IASetInputLayout(renderer.GetInstancedInputLayout(batchMesh.vertexFormat, item.pass == RenderQueue::Pass::Shadow));
             }
-            // e MeshComponent g̍ŐV[hso
-            const auto& worldMat = meshComponent->GetComponentWorldTransform().ToWorldTransform();
-            // e MeshComponent  model o
-            const InterleavedGltfModel* model = meshComponent->model.get();
+        }
+        else
+        {
+            const InterleavedGltfModel::Mesh::Primitive& primitive = Primitive(item);
+            model->BindVertexBuffer(immediateContext, primitive.vertexFormat, primitive.vertexBufferView.buffer);
+        }
+    }
+
+    void BindIndexBuffer(const RenderQueue::DrawItem& item) override
+    {
+        const InterleavedGltfModel* model = Model(item);
+        const InterleavedGltfModel::IndexBufferView& indexBufferView = item.node < 0 ? model->batchMeshes.at(item.primitive).indexBufferView : Primitive(item).indexBufferView;
+        immediateContext->IASetIndexBuffer(model->buffers.at(indexBufferView.buffer).Get(), indexBufferView.format, 0);
+    }
+
+    void BindSkin(const RenderQueue::DrawItem& item) override
+    {
+        const MeshComponent* meshComponent = drawables.at(item.drawable).meshComponent;
+        const InterleavedGltfModel* model = meshComponent->model.get();
+        const std::vector<InterleavedGltfModel::Node>& nodes = meshComponent->modelNodes;
+        const InterleavedGltfModel::Node& node = nodes.at(item.node);
+        const InterleavedGltfModel::Skin& skin = model->skins.at(node.skin);
+        _ASSERT_EXPR(skin.joints.size() <= PRIMITIVE_MAX_JOINTS, L"The size of the joint array is insufficient, please expand it.");
+        const DirectX::XMMATRIX inverseNode = DirectX::XMMatrixInverse(NULL, DirectX::XMLoadFloat4x4(&node.globalTransform));
+        for (size_t jointIndex = 0; jointIndex < skin.joints.size(); ++jointIndex)
+        {
+            DirectX::XMStoreFloat4x4(&renderer.primitiveJointCBuffer->data.matrices[jointIndex],
+                DirectX::XMLoadFloat4x4(&skin.inverseBindMatrices.at(jointIndex)) *
+                DirectX::XMLoadFloat4x4(&nodes.at(skin.joints.at(jointIndex)).globalTransform) *
+                inverseNode
+            );
+        }
+        // 2Ԃɒ萔obt@𑗂
+        renderer.primitiveJointCBuffer->Activate(immediateContext, 2);
+    }
+
+    void Draw(const RenderQueue::DrawItem& item) override
+    {
+        const Drawable& drawable = drawables.at(item.drawable);
+        const MeshComponent* meshComponent = drawable.meshComponent;
+        const InterleavedGltfModel* model = meshComponent->model.get();
+        const DirectX::XMMATRIX C = ModelCoordinateTransform(model);
+        const bool isShadow = item.pass == RenderQueue::Pass::Shadow;
 
-            if (meshComponent->model->mode == InterleavedGltfModel::Mode::SkeltalMesh)
-            {// 
-                CastShadow(immediateContext, meshComponent, worldMat, meshComponent->modelNodes, InterleavedGltfModel::RenderPass::Blend);
+        if (item.node < 0)
+        {
+            const InterleavedGltfModel::BatchMesh& batchMesh = model->batchMeshes.at(item.primitive);
+            if (isShadow)
+            {// CastShadowWithStaticBatching Ɠf̒萔obt@g
+                PrimitiveConstants primitiveData = {};
+                batchMesh.vertexFormat.SetShaderConstants(primitiveData);
+                primitiveData.material = batchMesh.material;
+                primitiveData.hasTangent = batchMesh.has("TANGENT");
+                primitiveData.skin = -1;
+                primitiveData.world = drawable.world;
+                immediateContext->UpdateSubresource(model->primitiveCbuffer.Get(), 0, 0, &primitiveData, 0, 0);
+                immediateContext->VSSetConstantBuffers(0, 1, model->primitiveCbuffer.GetAddressOf());
+                immediateContext->PSSetConstantBuffers(0, 1, model->primitiveCbuffer.GetAddressOf());
             }
-            else if (meshComponent->model->mode == InterleavedGltfModel::Mode::StaticMesh)
+            else
             {
-                CastShadowWithStaticBatching(immediateContext, meshComponent, worldMat, meshComponent->modelNodes);
+                PrimitiveConstants& data = renderer.primitiveCBuffer->data;
+                data.material = batchMesh.material;
+                data.hasTangent = batchMesh.has("TANGENT");
+                data.skin = -1;
+                batchMesh.vertexFormat.SetShaderConstants(data);
+                DirectX::XMStoreFloat4x4(&data.world, C * DirectX::XMLoadFloat4x4(&drawable.world));
+                // 0Ԃɒ萔obt@𑗂
+                renderer.primitiveCBuffer->Activate(immediateContext, 0);
             }
 
+            const UINT instanceCount = isShadow ? 4 : 1;
+            if (item.meshletDraw > -1)
+            {// 郁bVbg͈̔͂`
+                const MeshletDraw& draw = renderer.meshletDraws.at(item.meshletDraw);
+                for (uint32_t range = draw.firstRange; range < draw.firstRange + draw.rangeCount; ++range)
+                {
+                    immediateContext->DrawIndexed(renderer.meshletRanges.at(range).indexCount, renderer.meshletRanges.at(range).firstIndex, 0);
+                }
+            }
+            else if (batchMesh.indexBufferView.buffer > -1)
+            {
+                const MeshSimplifier::Lod lod = batchMesh.GetLod(item.lod);
+                immediateContext->DrawIndexedInstanced(lod.indexCount, instanceCount, lod.firstIndex, 0, 0);
+            }
+            else if (isShadow)
+            {
+                immediateContext->DrawIndexedInstanced(batchMesh.vertexBufferView.sizeInBytes / batchMesh.vertexBufferView.strideInBytes, instanceCount, 0, 0, 0);
+            }
+            else
+            {
+                immediateContext->Draw(batchMesh.vertexBufferView.sizeInBytes / batchMesh.vertexBufferView.strideInBytes, 0);
+            }
+            return;
+        }
+
+        const InterleavedGltfModel::Node& node = meshComponent->modelNodes.at(item.node);
+        const InterleavedGltfModel::Mesh::Primitive& primitive = Primitive(item);
+        PrimitiveConstants& data = renderer.primitiveCBuffer->data;
+        data.material = item.material;
+        data.hasTangent = primitive.has("TANGENT");
+        data.skin = node.skin;
+        primitive.vertexFormat.SetShaderConstants(data);
+        const InterleavedGltfModel::InstanceParameters& instance = meshComponent->instanceParameters;
+        data.color = { instance.cpuColor.x,instance.cpuColor.y,instance.cpuColor.z,instance.alpha };
+        data.emission = instance.emission;
+        data.dissolveFactor = instance.disolveFactor;
+        DirectX::XMStoreFloat4x4(&data.world, DirectX::XMLoadFloat4x4(&node.globalTransform) * C * DirectX::XMLoadFloat4x4(&drawable.world));
+        // 0Ԃɒ萔obt@𑗂
+        renderer.primitiveCBuffer->Activate(immediateContext, 0);
+
+        const MeshSimplifier::Lod lod = primitive.GetLod(item.lod);
+        if (isShadow)
+        {
+            if (primitive.indexBufferView.buffer > -1)
+            {
+                immediateContext->DrawIndexedInstanced(lod.indexCount, 4, lod.firstIndex, 0, 0);
+            }
+            else
+            {
+                immediateContext->DrawIndexedInstanced(primitive.vertexBufferView.sizeInBytes / primitive.vertexBufferView.strideInBytes, 4, 0, 0, 0);
+            }
+        }
+        else if (auto cloth = dynamic_cast<const ClothMeshComponent*>(meshComponent))
+        {
+            immediateContext->VSSetShaderResources(0, 1, cloth->clothSRV[cloth->a].GetAddressOf());
+            immediateContext->DrawIndexed(lod.indexCount, lod.firstIndex, 0);
+        }
+        else if (primitive.indexBufferView.buffer > -1)
+        {
+            immediateContext->DrawIndexed(lod.indexCount, lod.firstIndex, 0);
+        }
+        else
+        {
+            immediateContext->Draw(primitive.vertexBufferView.sizeInBytes / primitive.vertexBufferView.strideInBytes, 0);
+        }
+    }
+
+    void DrawInstanced(const RenderQueue::DrawItem* const* items, size_t count) override
+    {
+        // ܂Ƃ߂ACe͓ob`bVE}eAȂ̂ŁA擪̃ACeŒ萔߂
+        const RenderQueue::DrawItem& item = *items[0];
+        const InterleavedGltfModel* model = Model(item);
+        const InterleavedGltfModel::BatchMesh& batchMesh = model->batchMeshes.at(item.primitive);
+        const bool isShadow = item.pass == RenderQueue::Pass::Shadow;
+        const DirectX::XMMATRIX C = ModelCoordinateTransform(model);
+
+        // CX^XƂ̃f[^Oobt@ɏ
+        UINT firstInstance = 0;
+        InstanceData* instances = static_cast<InstanceData*>(renderer.instanceBuffer->Map(immediateContext, static_cast<UINT>(count), firstInstance));
+        for (size_t index = 0; index < count; ++index)
+        {
+            const Drawable& drawable = drawables.at(items[index]->drawable);
+            const InterleavedGltfModel::InstanceParameters& instance = drawable.meshComponent->instanceParameters;
+            DirectX::XMStoreFloat4x4(&instances[index].world, C * DirectX::XMLoadFloat4x4(&drawable.world));
+            instances[index].color = { instance.cpuColor.x, instance.cpuColor.y, instance.cpuColor.z, instance.alpha };
+            instances[index].parameters = { instance.emission, instance.disolveFactor, 0.0f, 0.0f };
+        }
+        renderer.instanceBuffer->Unmap(immediateContext);
+        renderer.instanceBuffer->Bind(immediateContext, 2, firstInstance);
+
+        // s̓CX^XƂ̃f[^ǂނ̂ŁA萔obt@͒_tH[}bgƃ}eA
+        const InterleavedGltfModel::InstanceParameters& instance = drawables.at(item.drawable).meshComponent->instanceParameters;
+        if (isShadow)
+        {
+            PrimitiveConstants primitiveData = {};
+            batchMesh.vertexFormat.SetShaderConstants(primitiveData);
+            primitiveData.material = batchMesh.material;
+            primitiveData.hasTangent = batchMesh.has("TANGENT");
+            primitiveData.skin = -1;
+            DirectX::XMStoreFloat4x4(&primitiveData.world, DirectX::XMMatrixIdentity());
+            immediateContext->UpdateSubresource(model->primitiveCbuffer.Get(), 0, 0, &primitiveData, 0, 0);
+            immediateContext->VSSetConstantBuffers(0, 1, model->primitiveCbuffer.GetAddressOf());
+            immediateContext->PSSetConstantBuffers(0, 1, model->primitiveCbuffer.GetAddressOf());
+        }
+        else
+        {
+            PrimitiveConstants& data = renderer.primitiveCBuffer->data;
+            data.material = batchMesh.material;
+            data.hasTangent = batchMesh.has("TANGENT");
+            data.skin = -1;
+            batchMesh.vertexFormat.SetShaderConstants(data);
+            DirectX::XMStoreFloat4x4(&data.world, DirectX::XMMatrixIdentity());
+            // ւpCvC̃sNZVF[_[p (܂Ƃ߂ACe͑Sēl)
+            data.color = { instance.cpuColor.x, instance.cpuColor.y, instance.cpuColor.z, instance.alpha };
+            data.emission = instance.emission;
+            data.dissolveFactor = instance.disolveFactor;
+            // 0Ԃɒ萔obt@𑗂
+            renderer.primitiveCBuffer->Activate(immediateContext, 0);
+        }
+
+        // e 1 ̃CX^X 4 ̃JXP[hɕ`
+        const UINT instanceCount = static_cast<UINT>(count) * (isShadow ? 4 : 1);
+        if (batchMesh.indexBufferView.buffer > -1)
+        {// ܂Ƃ߂ACe͓i
+            const MeshSimplifier::Lod lod = batchMesh.GetLod(item.lod);
+            immediateContext->DrawIndexedInstanced(lod.indexCount, instanceCount, lod.firstIndex, 0, 0);
+        }
+        else
+        {
+            immediateContext->DrawInstanced(batchMesh.vertexBufferView.sizeInBytes / batchMesh.vertexBufferView.strideInBytes, instanceCount, 0, 0);
         }
     }
+
+private:
+    const InterleavedGltfModel* Model(const RenderQueue::DrawItem& item) const
+    {
+        return drawables.at(item.drawable).meshComponent->model.get();
+    }
+    const InterleavedGltfModel::Mesh::Primitive& Primitive(const RenderQueue::DrawItem& item) const
+    {
+        const MeshComponent* meshComponent = drawables.at(item.drawable).meshComponent;
+        const InterleavedGltfModel::Node& node = meshComponent->modelNodes.at(item.node);
+        return meshComponent->model->meshes.at(node.mesh).primitives.at(item.primitive);
+    }
+
+    const SceneRenderer& renderer;
+    ID3D11DeviceContext* immediateContext;
+    const std::vector<Drawable>& drawables;
+};
+
+void SceneRenderer::SubmitRenderQueue(ID3D11DeviceContext* immediateContext, RenderQueue::Pass pass) const
+{
+    if (isVisibilityPrepared)
+    {
+        QueueBackend backend(*this, immediateContext, drawables);
+        renderQueue.Submit(pass, backend);
+    }
+    else
+    {// PrepareVisibility Ă΂ĂȂ́ÃpX̏̕őSďW߂
+        std::vector<Drawable> all;
+        CollectDrawables(all);
+        std::vector<uint32_t> everything(all.size());
+        std::iota(everything.begin(), everything.end(), 0u);
+        const std::vector<float> depths(all.size(), 0.0f);
+        const bool isShadow = pass == RenderQueue::Pass::Shadow;
+
+        RenderQueue queue;
+        queue.BeginFrame();
+        queue.enableInstancing = enableInstancing;
+        ExtractRenderQueue(all, isShadow ? std::vector<uint32_t>{} : everything, isShadow ? everything : std::vector<uint32_t>{}, depths, queue);
+        queue.Sort();
+        QueueBackend backend(*this, immediateContext, all);
+        queue.Submit(pass, backend);
+    }
+
+    if (pass == RenderQueue::Pass::Shadow)
+    {
+        immediateContext->VSSetShader(NULL, NULL, 0);
+        immediateContext->GSSetShader(NULL, NULL, 0);
+        immediateContext->PSSetShader(NULL, NULL, 0);
+    }
+}
+
+ID3D11InputLayout* SceneRenderer::GetInstancedInputLayout(const VertexFormat& format, bool isShadow) const
+{
+    Microsoft::WRL::ComPtr<ID3D11InputLayout>& inputLayout = instancedInputLayouts[static_cast<uint64_t>(format.LayoutKey()) << 1 | (isShadow ? 1 : 0)];
+    if (!inputLayout)
+    {
+        std::vector<D3D11_INPUT_ELEMENT_DESC> inputElementDesc;
+        format.MakeInputElements(inputElementDesc, false, 1);
+        // e 1 ̃CX^X 4 ̃JXP[hɕ`̂ŁACX^XƂ̃f[^ 4 CX^X 1 i߂
+        const UINT stepRate = isShadow ? 4 : 1;
+        inputElementDesc.push_back({ "INSTANCE_WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        inputElementDesc.push_back({ "INSTANCE_WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        inputElementDesc.push_back({ "INSTANCE_WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        inputElementDesc.push_back({ "INSTANCE_WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        inputElementDesc.push_back({ "INSTANCE_COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        inputElementDesc.push_back({ "INSTANCE_PARAMETERS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 2, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        HRESULT hr = CreateInputLayoutFromCSO(Graphics::GetDevice(), isShadow ? "./Shader/GltfModelAutoInstancedCsmVS.cso" : "./Shader/GltfModelAutoInstancedVS.cso",
+            inputLayout.GetAddressOf(), inputElementDesc.data(), static_cast<UINT>(inputElementDesc.size()));
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    }
+    return inputLayout.Get();
+}
+
+void SceneRenderer::RenderOpaque(ID3D11DeviceContext* immediateContext/*, std::vector<std::shared_ptr<Actor>> allActors*/) const
+{
+    SubmitRenderQueue(immediateContext, RenderQueue::Pass::Opaque);
+}
+
+void SceneRenderer::RenderMask(ID3D11DeviceContext* immediateContext) const
+{
+    SubmitRenderQueue(immediateContext, RenderQueue::Pass::Mask);
+}
+
+void SceneRenderer::RenderBlend(ID3D11DeviceContext* immediateContext) const
+{
+    SubmitRenderQueue(immediateContext, RenderQueue::Pass::Blend);
+}
+
+void SceneRenderer::CastShadowRender(ID3D11DeviceContext* immediateContext)
+{
+    SubmitRenderQueue(immediateContext, RenderQueue::Pass::Shadow);
 }
 
 
@@ -247,22 +946,20 @@ void SceneRenderer::Draw(ID3D11DeviceContext* immediateContext, const MeshCompon
         if (node.mesh > -1)
         {
             const InterleavedGltfModel::Mesh& mesh = model->meshes.at(node.mesh);
-            for (const InterleavedGltfModel::Mesh::Primitive& primitive : mesh.primitives)
+            for (int primitiveIndex = 0; primitiveIndex < static_cast<int>(mesh.primitives.size()); ++primitiveIndex)
             {
-                // INTERLEAVED_GLTF_MODEL
-                UINT stride = sizeof(InterleavedGltfModel::Mesh::Vertex);
-                UINT offset = 0;
+                const InterleavedGltfModel::Mesh::Primitive& primitive = mesh.primitives.at(primitiveIndex);
+                // CX^XƂ̃}eAւ𔽉f
+                const int materialIndex = meshComponent->instanceParameters.GetPrimitiveMaterial(node.mesh, primitiveIndex, primitive.material);
 
-                {
-                    immediateContext->IASetVertexBuffers(0, 1, model->buffers.at(primitive.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
-                }
-
-                primitiveCBuffer->data.material = primitive.material;
+                primitiveCBuffer->data.material = materialIndex;
                 primitiveCBuffer->data.hasTangent = primitive.has("TANGENT");
                 primitiveCBuffer->data.skin = node.skin;
-                primitiveCBuffer->data.color = { model->cpuColor.x,model->cpuColor.y,model->cpuColor.z,model->alpha };
-                primitiveCBuffer->data.emission = model->emission;
-                primitiveCBuffer->data.dissolveFactor = model->disolveFactor;
+                primitive.vertexFormat.SetShaderConstants(primitiveCBuffer->data);
+                const InterleavedGltfModel::InstanceParameters& instance = meshComponent->instanceParameters;
+                primitiveCBuffer->data.color = { instance.cpuColor.x,instance.cpuColor.y,instance.cpuColor.z,instance.alpha };
+                primitiveCBuffer->data.emission = instance.emission;
+                primitiveCBuffer->data.dissolveFactor = instance.disolveFactor;
 
                 //Wn̕ϊs
                 const DirectX::XMFLOAT4X4 coordinateSystemTransforms[]
@@ -309,7 +1006,7 @@ void SceneRenderer::Draw(ID3D11DeviceContext* immediateContext, const MeshCompon
                 // 0Ԃɒ萔obt@𑗂
                 primitiveCBuffer->Activate(immediateContext, 0);
 
-                const InterleavedGltfModel::Material& material = model->materials.at(primitive.material);
+                const InterleavedGltfModel::Material& material = model->materials.at(materialIndex);
 
                 std::string pipelineName;
                 if (material.overridePipelineName.has_value())
@@ -325,6 +1022,8 @@ void SceneRenderer::Draw(ID3D11DeviceContext* immediateContext, const MeshCompon
                     pipelineName = GetPipelineName(currentRenderPath, static_cast<MaterialAlphaMode>(material.data.alphaMode), static_cast<ModelMode>(model->mode));
                 }
                 pipeLineStateSet->BindPipeLineState(immediateContext, pipelineName);
+                // pCvC̓̓CAEg𒸓_tH[}bgɍ킹čւ
+                model->BindVertexBuffer(immediateContext, primitive.vertexFormat, primitive.vertexBufferView.buffer);
                 ////Őݒ
                 //if (material.replacedPixelShader)
                 //{
@@ -393,12 +1092,12 @@ void SceneRenderer::Draw(ID3D11DeviceContext* immediateContext, const MeshCompon
 #if 0
                     immediateContext->IASetIndexBuffer(model->buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
                     immediateContext->VSSetShaderResources(0, 1, cloth->preVertexSRV.GetAddressOf());
-                    immediateContext->DrawIndexed(primitive.indexBufferView.sizeInBytes / SizeofComponent(primitive.indexBufferView.format), 0, 0);
+                    immediateContext->DrawIndexed(primitive.GetLod(0).indexCount, 0, 0);
 #else
                     immediateContext->IASetIndexBuffer(model->buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
                     //immediateContext->VSSetShaderResources(0, 1, cloth->currentVertexSRV.GetAddressOf());
                     immediateContext->VSSetShaderResources(0, 1, cloth->clothSRV[cloth->a].GetAddressOf());
-                    immediateContext->DrawIndexed(primitive.indexBufferView.sizeInBytes / SizeofComponent(primitive.indexBufferView.format), 0, 0);
+                    immediateContext->DrawIndexed(primitive.GetLod(0).indexCount, 0, 0);
 #endif // 0
 
                 }
@@ -408,7 +1107,7 @@ void SceneRenderer::Draw(ID3D11DeviceContext* immediateContext, const MeshCompon
                     {
                         // INTERLEAVED_GLTF_MODEL
                         immediateContext->IASetIndexBuffer(model->buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
-                        immediateContext->DrawIndexed(primitive.indexBufferView.sizeInBytes / SizeofComponent(primitive.indexBufferView.format), 0, 0);
+                        immediateContext->DrawIndexed(primitive.GetLod(0).indexCount, 0, 0);
                     }
                     else
                     {
@@ -452,14 +1151,11 @@ void SceneRenderer::DrawWithStaticBatching(ID3D11DeviceContext* immediateContext
 
     for (const InterleavedGltfModel::BatchMesh& batchMesh : model->batchMeshes)
     {
-        UINT stride = sizeof(InterleavedGltfModel::BatchMesh::Vertex);
-        UINT offset = 0;
-        immediateContext->IASetVertexBuffers(0, 1, model->buffers.at(batchMesh.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
-
         //PrimitiveConstants primitiveData = {};
         primitiveCBuffer->data.material = batchMesh.material;
         primitiveCBuffer->data.hasTangent = batchMesh.has("TANGENT");
         primitiveCBuffer->data.skin = -1;
+        batchMesh.vertexFormat.SetShaderConstants(primitiveCBuffer->data);
         const DirectX::XMFLOAT4X4 coordinateSystemTransforms[]
         {
             {//RHS Y-UP
@@ -530,6 +1226,8 @@ void SceneRenderer::DrawWithStaticBatching(ID3D11DeviceContext* immediateContext
             pipelineName = GetPipelineName(currentRenderPath, static_cast<MaterialAlphaMode>(material.data.alphaMode), static_cast<ModelMode>(model->mode));
         }
         pipeLineStateSet->BindPipeLineState(immediateContext, pipelineName);
+        // pCvC̓̓CAEg𒸓_tH[}bgɍ킹čւ
+        model->BindVertexBuffer(immediateContext, batchMesh.vertexFormat, batchMesh.vertexBufferView.buffer);
 
 
         bool passed = false;
@@ -588,7 +1286,7 @@ void SceneRenderer::DrawWithStaticBatching(ID3D11DeviceContext* immediateContext
         if (batchMesh.indexBufferView.buffer > -1)
         {
             immediateContext->IASetIndexBuffer(model->buffers.at(batchMesh.indexBufferView.buffer).Get(), batchMesh.indexBufferView.format, 0);
-            immediateContext->DrawIndexed(batchMesh.indexBufferView.sizeInBytes / SizeofComponent(batchMesh.indexBufferView.format), 0, 0);
+            immediateContext->DrawIndexed(batchMesh.GetLod(0).indexCount, 0, 0);
         }
         else
         {
@@ -614,7 +1312,6 @@ void SceneRenderer::CastShadow(ID3D11DeviceContext* immediateContext, const Mesh
     Microsoft::WRL::ComPtr <ID3D11PixelShader> nullPixelShader{ NULL };
     immediateContext->PSSetShader(nullPixelShader.Get()/*SHADOW*/, nullptr, 0);
 
-    immediateContext->IASetInputLayout(model->inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
 #endif // 0
@@ -640,18 +1337,20 @@ void SceneRenderer::CastShadow(ID3D11DeviceContext* immediateContext, const Mesh
         if (node.mesh > -1)
         {
             const InterleavedGltfModel::Mesh& mesh = model->meshes.at(node.mesh);
-            for (const InterleavedGltfModel::Mesh::Primitive& primitive : mesh.primitives)
+            for (int primitiveIndex = 0; primitiveIndex < static_cast<int>(mesh.primitives.size()); ++primitiveIndex)
             {
-                UINT stride = sizeof(InterleavedGltfModel::Mesh::Vertex);
-                UINT offset = 0;
-                immediateContext->IASetVertexBuffers(0, 1, model->buffers.at(primitive.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+                const InterleavedGltfModel::Mesh::Primitive& primitive = mesh.primitives.at(primitiveIndex);
+                // CX^XƂ̃}eAւ𔽉f
+                const int materialIndex = meshComponent->instanceParameters.GetPrimitiveMaterial(node.mesh, primitiveIndex, primitive.material);
 
-                primitiveCBuffer->data.material = primitive.material;
+                primitiveCBuffer->data.material = materialIndex;
                 primitiveCBuffer->data.hasTangent = primitive.has("TANGENT");
                 primitiveCBuffer->data.skin = node.skin;
-                primitiveCBuffer->data.color = { model->cpuColor.x,model->cpuColor.y,model->cpuColor.z,model->alpha };
-                primitiveCBuffer->data.emission = model->emission;
-                primitiveCBuffer->data.dissolveFactor = model->disolveFactor;
+                primitive.vertexFormat.SetShaderConstants(primitiveCBuffer->data);
+                const InterleavedGltfModel::InstanceParameters& instance = meshComponent->instanceParameters;
+                primitiveCBuffer->data.color = { instance.cpuColor.x,instance.cpuColor.y,instance.cpuColor.z,instance.alpha };
+                primitiveCBuffer->data.emission = instance.emission;
+                primitiveCBuffer->data.dissolveFactor = instance.disolveFactor;
 
                 //Wn̕ϊs
                 const DirectX::XMFLOAT4X4 coordinateSystemTransforms[]
@@ -699,7 +1398,7 @@ void SceneRenderer::CastShadow(ID3D11DeviceContext* immediateContext, const Mesh
                 //int materialIndex = primitive.GetCurrentMaterialIndex();
 
                 //const Material& material = materials[materialIndex];
-                const InterleavedGltfModel::Material& material = model->materials.at(primitive.material);
+                const InterleavedGltfModel::Material& material = model->materials.at(materialIndex);
                 const int textureIndices[] =
                 {
                     material.data.pbrMetallicRoughness.basecolorTexture.index,
@@ -724,6 +1423,8 @@ void SceneRenderer::CastShadow(ID3D11DeviceContext* immediateContext, const Mesh
                     pipelineName = GetPipelineName(currentRenderPath, static_cast<MaterialAlphaMode>(material.data.alphaMode), static_cast<ModelMode>(model->mode));
                 }
                 pipeLineStateSet->BindPipeLineState(immediateContext, pipelineName);
+                // pCvC̓̓CAEg𒸓_tH[}bgɍ킹čւ
+                model->BindVertexBuffer(immediateContext, primitive.vertexFormat, primitive.vertexBufferView.buffer);
                 // sNZVF[_mɉ
                 immediateContext->PSSetShader(nullptr, nullptr, 0);
 #endif // 0
@@ -739,7 +1440,7 @@ void SceneRenderer::CastShadow(ID3D11DeviceContext* immediateContext, const Mesh
                 {
                     // INTERLEAVED_GLTF_MODEL
                     immediateContext->IASetIndexBuffer(model->buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
-                    immediateContext->DrawIndexedInstanced(primitive.indexBufferView.sizeInBytes / SizeofComponent(primitive.indexBufferView.format), 4, 0, 0, 0);
+                    immediateContext->DrawIndexedInstanced(primitive.GetLod(0).indexCount, 4, 0, 0, 0);
                 }
                 else
                 {
@@ -779,16 +1480,14 @@ void SceneRenderer::CastShadowWithStaticBatching(ID3D11DeviceContext* immediateC
     immediateContext->PSSetShader(nullPixelShader.Get()/*SHADOW*/, nullptr, 0);
 
     //immediate_context->PSSetShader(pixelShader.Get(), nullptr, 0);
-    immediateContext->IASetInputLayout(model->inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     for (const InterleavedGltfModel::BatchMesh& batchMesh : model->batchMeshes)
     {
-        UINT stride = sizeof(InterleavedGltfModel::BatchMesh::Vertex);
-        UINT offset = 0;
-        immediateContext->IASetVertexBuffers(0, 1, model->buffers.at(batchMesh.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+        model->BindVertexBuffer(immediateContext, batchMesh.vertexFormat, batchMesh.vertexBufferView.buffer);
 
         PrimitiveConstants primitiveData = {};
+        batchMesh.vertexFormat.SetShaderConstants(primitiveData);
         primitiveData.material = batchMesh.material;
         primitiveData.hasTangent = batchMesh.has("TANGENT");
         primitiveData.skin = -1;
@@ -817,7 +1516,7 @@ void SceneRenderer::CastShadowWithStaticBatching(ID3D11DeviceContext* immediateC
         if (batchMesh.indexBufferView.buffer > -1)
         {
             immediateContext->IASetIndexBuffer(model->buffers.at(batchMesh.indexBufferView.buffer).Get(), batchMesh.indexBufferView.format, 0);
-            immediateContext->DrawIndexedInstanced(batchMesh.indexBufferView.sizeInBytes / SizeofComponent(batchMesh.indexBufferView.format), 4, 0, 0, 0);
+            immediateContext->DrawIndexedInstanced(batchMesh.GetLod(0).indexCount, 4, 0, 0, 0);
         }
         else
         {
@@ -1,7 +1,9 @@
 #pragma once
 #include<d3d11.h>
+#include <array>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 #include "Core/Actor.h"
 #include "Components/Render/MeshComponent.h"
@@ -10,6 +12,10 @@
 #include "Graphics/Core/ConstantBuffer.h"
 #include "Graphics/Core/PipleLineLibrary.h"
 #include "Engine/Camera/CameraConstants.h"
+#include "Graphics/Renderer/InstanceBuffer.h"
+#include "Graphics/Renderer/RenderQueue.h"
+#include "Graphics/Renderer/VisibilityCulling.h"
+#include "Graphics/Renderer/MeshletCulling.h"
 
 
 class SceneRenderer
@@ -27,6 +33,13 @@ public:
         pipeLineStateSet = std::make_unique<PipeLineStateSet>();
         pipeLineStateSet->InitStaticMesh(Graphics::GetDevice());
         pipeLineStateSet->InitSkeletalMesh(Graphics::GetDevice());
+
+        // CX^X`
+        instanceBuffer = std::make_unique<InstanceBuffer>(device, static_cast<UINT>(sizeof(InstanceData)), 1024);
+        HRESULT hr = CreateVsFromCSO(device, "./Shader/GltfModelAutoInstancedVS.cso", instancedVertexShader.ReleaseAndGetAddressOf(), NULL, NULL, 0);
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+        hr = CreateVsFromCSO(device, "./Shader/GltfModelAutoInstancedCsmVS.cso", instancedCsmVertexShader.ReleaseAndGetAddressOf(), NULL, NULL, 0);
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
     }
 
     //Rs[RXgN^ƃRs[Zq֎~ɂ
@@ -44,6 +57,21 @@ public:
         viewBuffer->Activate(immediateContext, 4);
     }
 
+    // 1 t[ 1 A`pX̑OɌĂ
+    // JƊeJXP[h̎ MeshComponent IʂÂ̕`ACe 1 ŏW߂ĕבւĂ
+    // epX͂̒̎̃pX̃ACe`悷
+    // Ă΂ĂȂt[͊epXőSĂ MeshComponent W߂ (܂łƓ)
+    void PrepareVisibility(const DirectX::XMFLOAT4X4& cameraViewProjection, const std::vector<DirectX::XMFLOAT4X4>& cascadeViewProjections);
+    // Iʂ̌ʂ̂ĂāASĕ`悷Ԃɖ߂
+    void ClearVisibility();
+    const VisibilityCulling& GetVisibility() const { return visibility; }
+    const RenderQueue& GetRenderQueue() const { return renderQueue; }
+    const InstanceBuffer& GetInstanceBuffer() const { return *instanceBuffer; }
+    // Ō PrepareVisibility ŒiƂɑI΂ꂽ MeshComponent ̐
+    const std::array<size_t, MeshSimplifier::MaxLodCount>& GetLodHistogram() const { return lodHistogram; }
+    // Ō PrepareVisibility ŃbVbgIʂob`bV̍v
+    const MeshletCulling::Statistics& GetMeshletStatistics() const { return meshletStatistics; }
+
     void RenderOpaque(ID3D11DeviceContext* immediateContext/*, std::vector<std::shared_ptr<Actor>> allActors*/) const;
 
     void RenderMask(ID3D11DeviceContext* immediateContext) const;
@@ -62,6 +90,51 @@ public:
 
     void DrawCloth(ID3D11DeviceContext* immediateContext, const MeshComponent* meshComponent, const DirectX::XMFLOAT4X4& world, const std::vector<InterleavedGltfModel::Node>& animatedNodes, InterleavedGltfModel::RenderPass pass);
 private:
+    struct Drawable
+    {
+        std::weak_ptr<Actor> actor;
+        const MeshComponent* meshComponent = nullptr;
+        DirectX::XMFLOAT4X4 world;
+        int lod = 0;    // CfbNX LOD ̒i (PrepareVisibility őI)
+    };
+    // `Ώۂ MeshComponent W߂
+    void CollectDrawables(std::vector<Drawable>& out) const;
+    // MeshComponent ̃[hԂ AABB (߂Ȃ͖)
+    AABB ComputeWorldBounds(const MeshComponent* meshComponent, const DirectX::XMFLOAT4X4& world) const;
+    // J猩傫ȃob`bṼbVbgIʂāA`͈͂ meshletDraws ɓ
+    void CullMeshlets(const DirectX::XMFLOAT4X4& cameraViewProjection);
+    //  MeshComponent ̃v~eBu (ob`bV) Ƃɕ`ACe
+    void ExtractRenderQueue(const std::vector<Drawable>& frameDrawables, const std::vector<uint32_t>& cameraObjects, const std::vector<uint32_t>& shadowObjects,
+        const std::vector<float>& depths, RenderQueue& queue) const;
+    // PrepareVisibility ̌ (Ȃ΂̏ŏW߂)  pass ̃ACe`悷
+    void SubmitRenderQueue(ID3D11DeviceContext* immediateContext, RenderQueue::Pass pass) const;
+    // RenderQueue ̃ACe D3D11 ŕ`悷
+    class QueueBackend;
+    // CX^X`̓̓CAEg (_tH[}bgƂɏ߂Ďgɍ)
+    ID3D11InputLayout* GetInstancedInputLayout(const VertexFormat& format, bool isShadow) const;
+
+    VisibilityCulling visibility;
+    RenderQueue renderQueue;
+    std::vector<Drawable> drawables;
+    std::vector<uint32_t> cameraVisible;
+    std::vector<uint32_t> shadowVisible;
+    bool isVisibilityPrepared = false;
+    // Õt[őI LOD ̒i (t[ drawables ō蒼)
+    std::unordered_map<const MeshComponent*, int> lodLevels;
+    std::array<size_t, MeshSimplifier::MaxLodCount> lodHistogram = {};
+    // ob`bVƂ̃bVbg̕`͈ (meshletRanges  firstRange  rangeCount )
+    struct MeshletDraw
+    {
+        uint32_t firstRange = 0;
+        uint32_t rangeCount = 0;
+        bool isCulled = false;  // false Ȃ烁bVbĝőŜ`
+    };
+    std::vector<MeshletCulling::Range> meshletRanges;
+    std::vector<MeshletDraw> meshletDraws;
+    // drawables Ƃ 1 ڂ̃ob`bV meshletDraws ̔ԍ (-1 ȂIʂĂȂ)
+    std::vector<int32_t> meshletFirstDraw;
+    MeshletCulling::Statistics meshletStatistics;
+
     // J̒萔obt@
     std::unique_ptr<ConstantBuffer<ViewConstants>> viewBuffer;
 
@@ -88,12 +161,48 @@ private:
         float dissolveFactor = 0.0f;
 
         float emission = 0.0f;
-        float pads[3];
+        uint32_t vertexFlags = 0; // VertexFormat::ShaderFlags
+        float pads[2] = {};
+
+        // GltfModel.hlsli  PRIMITIVE_CONSTANT_BUFFER ƕт𑵂
+        DirectX::XMFLOAT4X4 invWorld = {};
+        DirectX::XMFLOAT4 positionScale = { 1, 1, 1, 0 };
+        DirectX::XMFLOAT4 positionOffset = { 0, 0, 0, 0 };
     };
     std::unique_ptr<ConstantBuffer<PrimitiveConstants>> primitiveCBuffer;
 
+    // CX^X`̃CX^XƂ̃f[^ (GltfModel.hlsli  AUTO_INSTANCE_VS_IN ƕт𑵂)
+    struct InstanceData
+    {
+        DirectX::XMFLOAT4X4 world;
+        DirectX::XMFLOAT4 color;
+        DirectX::XMFLOAT4 parameters; // x : emission, y : dissolve
+    };
+    std::unique_ptr<InstanceBuffer> instanceBuffer;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> instancedVertexShader;
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> instancedCsmVertexShader;
+    // key : LayoutKey << 1 | eǂ
+    mutable std::unordered_map<uint64_t, Microsoft::WRL::ComPtr<ID3D11InputLayout>> instancedInputLayouts;
+
 public:
     // RenderPath
     RenderPath currentRenderPath = RenderPath::Deferred;
+
+    // false ȂIʂȂőSĕ`悷
+    bool enableCulling = true;
+    // XLbV̓Aj[VŃoCh|[Y͂ݏô AABB ̕ (m) L
+    float skinnedBoundsMargin = 0.5f;
+    // false Ȃob`bVŃCX^X`ɂ܂Ƃ߂Ȃ
+    bool enableInstancing = true;
+    // false Ȃ LOD g킸̃bV`
+    bool enableLod = true;
+    // ʏ̌덷̃sNZȉɂȂԑei`
+    float lodPixelError = 1.0f;
+    // eiւ lodPixelError * (1 - lodHysteresis) ȉɂȂĂ؂ւ (ڂŒisȂ悤)
+    float lodHysteresis = 0.25f;
+    // false Ȃ烁bVbgIʂob`bVŜ`
+    bool enableMeshletCulling = true;
+    // ob`bV 1 `͈͂̐̏ (Ԃ̌Ȃ򂲂Ƃ܂Ƃ߂ĕ`)
+    int meshletMaxRanges = 32;
 };
 
@@ -35,6 +35,59 @@ void ShapeRenderer::Initialize(ID3D11Device* device)
     hr = CreatePsFromCSO(device, "./Shader/LineSegmentPS.cso", pixelShader.GetAddressOf());
     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 
+    // ܂Ƃ߂ĕ`悷鎞̃VF[_[Eobt@
+    {
+        D3D11_INPUT_ELEMENT_DESC batchInputElementDesc[]
+        {
+            {"POSITION",0,DXGI_FORMAT_R32G32B32_FLOAT,0,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_VERTEX_DATA,0},
+            {"COLOR",0,DXGI_FORMAT_R32G32B32A32_FLOAT,0,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_VERTEX_DATA,0},
+        };
+        hr = CreateVsFromCSO(device, "./Shader/DebugDrawVS.cso", batchVertexShader.GetAddressOf(), batchInputLayout.GetAddressOf(), batchInputElementDesc, ARRAYSIZE(batchInputElementDesc));
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+        D3D11_INPUT_ELEMENT_DESC shapeInputElementDesc[]
+        {
+            {"POSITION",0,DXGI_FORMAT_R32G32B32_FLOAT,0,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_VERTEX_DATA,0},
+            {"INSTANCE_WORLD",0,DXGI_FORMAT_R32G32B32A32_FLOAT,1,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_INSTANCE_DATA,1},
+            {"INSTANCE_WORLD",1,DXGI_FORMAT_R32G32B32A32_FLOAT,1,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_INSTANCE_DATA,1},
+            {"INSTANCE_WORLD",2,DXGI_FORMAT_R32G32B32A32_FLOAT,1,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_INSTANCE_DATA,1},
+            {"INSTANCE_WORLD",3,DXGI_FORMAT_R32G32B32A32_FLOAT,1,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_INSTANCE_DATA,1},
+            {"INSTANCE_COLOR",0,DXGI_FORMAT_R32G32B32A32_FLOAT,1,D3D11_APPEND_ALIGNED_ELEMENT,D3D11_INPUT_PER_INSTANCE_DATA,1},
+        };
+        hr = CreateVsFromCSO(device, "./Shader/DebugShapeInstancedVS.cso", shapeInstancedVertexShader.GetAddressOf(), shapeInstancedInputLayout.GetAddressOf(), shapeInputElementDesc, ARRAYSIZE(shapeInputElementDesc));
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+        hr = CreatePsFromCSO(device, "./Shader/DebugDrawPS.cso", batchPixelShader.GetAddressOf());
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+        batchVertexBuffer = std::make_unique<InstanceBuffer>(device, static_cast<UINT>(sizeof(DebugDrawBuffer::Vertex)), 4096);
+        shapeInstanceBuffer = std::make_unique<InstanceBuffer>(device, static_cast<UINT>(sizeof(DebugDrawBuffer::ShapeInstance)), 256);
+
+        // `̃bV (glb Ɠ傫E_̂̂R[hō)
+        for (size_t shape = 0; shape < DebugDrawBuffer::ShapeCount; ++shape)
+        {
+            std::vector<DirectX::XMFLOAT3> positions;
+            std::vector<uint16_t> indices;
+            DebugDrawBuffer::BuildShapeMesh(static_cast<DebugDrawBuffer::Shape>(shape), positions, indices);
+
+            D3D11_BUFFER_DESC meshBufferDesc{};
+            meshBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+            D3D11_SUBRESOURCE_DATA subresourceData{};
+
+            meshBufferDesc.ByteWidth = static_cast<UINT>(sizeof(DirectX::XMFLOAT3) * positions.size());
+            meshBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+            subresourceData.pSysMem = positions.data();
+            hr = device->CreateBuffer(&meshBufferDesc, &subresourceData, shapeMeshes[shape].vertexBuffer.ReleaseAndGetAddressOf());
+            _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+            meshBufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint16_t) * indices.size());
+            meshBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+            subresourceData.pSysMem = indices.data();
+            hr = device->CreateBuffer(&meshBufferDesc, &subresourceData, shapeMeshes[shape].indexBuffer.ReleaseAndGetAddressOf());
+            _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+            shapeMeshes[shape].indexCount = static_cast<UINT>(indices.size());
+        }
+    }
+
     sphere = std::make_unique<GltfModel>(device, "./Data/Debug/Primitives/sphere.glb");
     capsule = std::make_unique<GltfModel>(device, "./Data/Debug/Primitives/capsule.glb");
     topHalfSphere = std::make_unique<GltfModel>(device, "./Data/Debug/Primitives/topHalfSphere.glb");
@@ -88,11 +141,6 @@ void ShapeRenderer::Initialize(ID3D11Device* device)
 // `
 void ShapeRenderer::DrawSphere(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& position, float radius, const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     constexpr DirectX::XMFLOAT4X4 coordinateSystemTransforms[]
     {
 { -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },	// 0:RHS Y-UP
@@ -113,17 +161,12 @@ void ShapeRenderer::DrawSphere(ID3D11DeviceContext* immediateContext, const Dire
     DirectX::XMFLOAT4X4 world;
     DirectX::XMStoreFloat4x4(&world, C * S * R * T);
 
-    sphere->Render(immediateContext, world, RenderPass::Opaque);
+    DrawShape(immediateContext, DebugDrawBuffer::Shape::Sphere, world, color);
 }
 
 // JvZ`
 void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& position, float radius, float height, const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     const DirectX::XMFLOAT4X4 coordinate_system_transforms[]{
 { -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },	// 0:RHS Y-UP
 { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },		// 1:LHS Y-UP
@@ -143,7 +186,7 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext, const Dir
         DirectX::XMFLOAT4X4 world;
         DirectX::XMStoreFloat4x4(&world, C * S * R * T);
         //TODO:03 debugShapeRenderPassOpaqueɂĂ
-        cylinder->Render(immediateContext, world, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::Cylinder, world, color);
     }
     {//topHalfSphere
         DirectX::XMMATRIX C{ DirectX::XMLoadFloat4x4(&coordinate_system_transforms[0]) * DirectX::XMMatrixScaling(scale_factor, scale_factor, scale_factor) };
@@ -153,7 +196,7 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext, const Dir
         DirectX::XMFLOAT4X4 world;
         DirectX::XMStoreFloat4x4(&world, C * S * R * T);
 
-        topHalfSphere->Render(immediateContext, world, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::TopHalfSphere, world, color);
     }
     {//bottomHalfSphere
         DirectX::XMMATRIX C{ DirectX::XMLoadFloat4x4(&coordinate_system_transforms[0]) * DirectX::XMMatrixScaling(scale_factor, scale_factor, scale_factor) };
@@ -163,7 +206,7 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext, const Dir
         DirectX::XMFLOAT4X4 world;
         DirectX::XMStoreFloat4x4(&world, C * S * R * T);
 
-        bottomHalfSphere->Render(immediateContext, world, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::BottomHalfSphere, world, color);
     }
 }
 
@@ -173,11 +216,6 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext,
     float radius, float height,
     const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     const float cylinderHeight = height - 2.0f * radius;  // [
     const float halfCylinderHeight = cylinderHeight * 0.5f;
 
@@ -194,7 +232,7 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext,
         DirectX::XMMATRIX world = S * finalRotation * T;
         DirectX::XMFLOAT4X4 m;
         DirectX::XMStoreFloat4x4(&m, world);
-        cylinder->Render(immediateContext, m, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::Cylinder, m, color);
     }
 
     // 㑤̔
@@ -204,7 +242,7 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext,
         DirectX::XMMATRIX world = S * offset * finalRotation * T;
         DirectX::XMFLOAT4X4 m;
         DirectX::XMStoreFloat4x4(&m, world);
-        topHalfSphere->Render(immediateContext, m, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::TopHalfSphere, m, color);
     }
 
     // ̔
@@ -214,7 +252,7 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext,
         DirectX::XMMATRIX world = S * offset * finalRotation * T;
         DirectX::XMFLOAT4X4 m;
         DirectX::XMStoreFloat4x4(&m, world);
-        bottomHalfSphere->Render(immediateContext, m, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::BottomHalfSphere, m, color);
     }
 }
 
@@ -225,11 +263,6 @@ void ShapeRenderer::DrawCapsule(
     float height,
     const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     const DirectX::XMFLOAT4X4 coordinate_system_transforms[]{
 { -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },	// 0:RHS Y-UP
 { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },		// 1:LHS Y-UP
@@ -254,7 +287,7 @@ void ShapeRenderer::DrawCapsule(
         DirectX::XMMATRIX world = S * T;
         DirectX::XMFLOAT4X4 finalMatrix;
         DirectX::XMStoreFloat4x4(&finalMatrix, world * baseTransform);
-        cylinder->Render(immediateContext, finalMatrix, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::Cylinder, finalMatrix, color);
     }
 
     {// Top Half Sphere
@@ -263,7 +296,7 @@ void ShapeRenderer::DrawCapsule(
         DirectX::XMMATRIX world = S * T;
         DirectX::XMFLOAT4X4 finalMatrix;
         DirectX::XMStoreFloat4x4(&finalMatrix, world * baseTransform);
-        topHalfSphere->Render(immediateContext, finalMatrix, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::TopHalfSphere, finalMatrix, color);
     }
 
     {// Bottom Half Sphere
@@ -272,18 +305,13 @@ void ShapeRenderer::DrawCapsule(
         DirectX::XMMATRIX world = S * T;
         DirectX::XMFLOAT4X4 finalMatrix;
         DirectX::XMStoreFloat4x4(&finalMatrix, world * baseTransform);
-        bottomHalfSphere->Render(immediateContext, finalMatrix, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::BottomHalfSphere, finalMatrix, color);
     }
 }
 
 
 void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& startPosition, const DirectX::XMFLOAT3& endPosition, float radius, const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     using namespace DirectX;
 
     XMVECTOR Start = XMLoadFloat3(&startPosition);
@@ -325,24 +353,19 @@ void ShapeRenderer::DrawCapsule(ID3D11DeviceContext* immediateContext, const Dir
 
     // CylinderiSj
     XMStoreFloat4x4(&world, C * scaleCylinder * R * T_center);
-    cylinder->Render(immediateContext, world, RenderPass::Opaque);
+    DrawShape(immediateContext, DebugDrawBuffer::Shape::Cylinder, world, color);
 
     // ̔
     XMStoreFloat4x4(&world, C * scaleSphere * R * T_top);
-    topHalfSphere->Render(immediateContext, world, RenderPass::Opaque);
+    DrawShape(immediateContext, DebugDrawBuffer::Shape::TopHalfSphere, world, color);
 
     // ̔
     XMStoreFloat4x4(&world, C * scaleSphere * R * T_bottom);
-    bottomHalfSphere->Render(immediateContext, world, RenderPass::Opaque);
+    DrawShape(immediateContext, DebugDrawBuffer::Shape::BottomHalfSphere, world, color);
 }
 // `
 void ShapeRenderer::DrawBox(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& angle, const DirectX::XMFLOAT3& size, const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     const DirectX::XMFLOAT4X4 coordinate_system_transforms[]{
 { -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },	// 0:RHS Y-UP
 { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },		// 1:LHS Y-UP
@@ -362,18 +385,13 @@ void ShapeRenderer::DrawBox(ID3D11DeviceContext* immediateContext, const DirectX
         DirectX::XMFLOAT4X4 world;
         DirectX::XMStoreFloat4x4(&world, C * S * R * T);
         //TODO:03 debugShapeRenderPassOpaqueɂĂ
-        cube->Render(immediateContext, world, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::Cube, world, color);
     }
 }
 
 // `
 void ShapeRenderer::DrawBoxCenter(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT3& angle, const DirectX::XMFLOAT3& size, const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     const DirectX::XMFLOAT4X4 coordinate_system_transforms[]{
 { -1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },	// 0:RHS Y-UP
 { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 },		// 1:LHS Y-UP
@@ -393,30 +411,45 @@ void ShapeRenderer::DrawBoxCenter(ID3D11DeviceContext* immediateContext, const D
         DirectX::XMFLOAT4X4 world;
         DirectX::XMStoreFloat4x4(&world, C * S * R * T);
         //TODO:03 debugShapeRenderPassOpaqueɂĂ
-        cubeCenter->Render(immediateContext, world, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::CubeCenter, world, color);
     }
 }
 
 void ShapeRenderer::DrawBox(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& transform, const DirectX::XMFLOAT3& size, const DirectX::XMFLOAT4& color)
 {
-    DebugConstants data1{ color };
-    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
-    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
-
     DirectX::XMMATRIX Transform = DirectX::XMLoadFloat4x4(&transform);
     Transform.r[0] = DirectX::XMVectorScale(Transform.r[0], size.x);
     Transform.r[1] = DirectX::XMVectorScale(Transform.r[1], size.y);
     Transform.r[2] = DirectX::XMVectorScale(Transform.r[2], size.z);
     DirectX::XMFLOAT4X4 world;
     DirectX::XMStoreFloat4x4(&world, Transform);
-    cube->Render(immediateContext, world, RenderPass::Opaque);
+    DrawShape(immediateContext, DebugDrawBuffer::Shape::Cube, world, color);
 
 }
 
 //`
 void ShapeRenderer::DrawSegment(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4& color, const std::vector<DirectX::XMFLOAT3>& points, Type type)
 {
+    if (enableBatching)
+    {
+        if (type == Type::Line)
+        {
+            debugDrawBuffer.AddLineStrip(points, color);
+        }
+        else if (type == Type::Segment)
+        {
+            debugDrawBuffer.AddLineList(points, color);
+        }
+        else// Type::Point
+        {
+            for (const DirectX::XMFLOAT3& point : points)
+            {
+                debugDrawBuffer.AddPoint(point, color);
+            }
+        }
+        return;
+    }
+
     _ASSERT_EXPR(points.size() <= maxPoints, L"Points are size over!!");
 
     HRESULT hr{ S_OK };
@@ -460,6 +493,7 @@ void ShapeRenderer::DrawSegment(ID3D11DeviceContext* immediateContext, const Dir
 {
     using namespace DirectX;
     const float radius = 0.05f;
+    const DirectX::XMFLOAT4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
     // directionVector = endPosition - startPosition 
     DirectX::XMFLOAT3 vector = { endPosition.x - startPosition.x,endPosition.y - startPosition.y,endPosition.z - startPosition.z };
     DirectX::XMVECTOR Vec = DirectX::XMLoadFloat3(&vector);
@@ -499,13 +533,19 @@ void ShapeRenderer::DrawSegment(ID3D11DeviceContext* immediateContext, const Dir
         DirectX::XMFLOAT4X4 world;
         DirectX::XMStoreFloat4x4(&world, C * S * R * T);
 
-        sphere->Render(immediateContext, world, RenderPass::Opaque);
+        DrawShape(immediateContext, DebugDrawBuffer::Shape::Sphere, world, color);
     }
 }
 
 // _`
 void ShapeRenderer::DrawPoint(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& position, const DirectX::XMFLOAT4& color)
 {
+    if (enableBatching)
+    {
+        debugDrawBuffer.AddPoint(position, color);
+        return;
+    }
+
     HRESULT hr{ S_OK };
     D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
     hr = immediateContext->Map(vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
@@ -534,6 +574,12 @@ void ShapeRenderer::DrawPoint(ID3D11DeviceContext* immediateContext, const Direc
 // `
 void ShapeRenderer::DrawLineSegment(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& startPosition, const DirectX::XMFLOAT3& endPosition, const DirectX::XMFLOAT4& color)
 {
+    if (enableBatching)
+    {
+        debugDrawBuffer.AddLine(startPosition, endPosition, color);
+        return;
+    }
+
     DirectX::XMFLOAT3 points[2] = { startPosition, endPosition };
 
     HRESULT hr{ S_OK };
@@ -562,6 +608,123 @@ void ShapeRenderer::DrawLineSegment(ID3D11DeviceContext* immediateContext, const
 }
 
 
+// ` 1 `
+void ShapeRenderer::DrawShape(ID3D11DeviceContext* immediateContext, DebugDrawBuffer::Shape shape, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4& color)
+{
+    if (enableBatching)
+    {
+        debugDrawBuffer.AddShape(shape, world, color);
+        return;
+    }
+
+    DebugConstants data1{ color };
+    immediateContext->UpdateSubresource(constantBuffer[1].Get(), 0, 0, &data1, 0, 0);
+    immediateContext->VSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
+    immediateContext->PSSetConstantBuffers(12, 1, constantBuffer[1].GetAddressOf());
+
+    GltfModel* model = nullptr;
+    switch (shape)
+    {
+    case DebugDrawBuffer::Shape::Sphere: model = sphere.get(); break;
+    case DebugDrawBuffer::Shape::TopHalfSphere: model = topHalfSphere.get(); break;
+    case DebugDrawBuffer::Shape::BottomHalfSphere: model = bottomHalfSphere.get(); break;
+    case DebugDrawBuffer::Shape::Cylinder: model = cylinder.get(); break;
+    case DebugDrawBuffer::Shape::Cube: model = cube.get(); break;
+    case DebugDrawBuffer::Shape::CubeCenter: model = cubeCenter.get(); break;
+    }
+    //TODO:03 debugShapeRenderPassOpaqueɂĂ
+    model->Render(immediateContext, world, RenderPass::Opaque);
+}
+
+// ߂̂܂Ƃ߂ĕ`
+void ShapeRenderer::Flush(ID3D11DeviceContext* immediateContext)
+{
+    debugDrawBuffer.Gather(flushBatch);
+
+    const DebugDrawBuffer::Statistics& statistics = debugDrawBuffer.GetStatistics();
+    ++flushStatistics.flushes;
+    flushStatistics.lines += statistics.lineVertices / 2;
+    flushStatistics.points += statistics.points;
+    flushStatistics.shapes += statistics.shapes;
+    flushStatistics.dropped += statistics.dropped;
+    if (flushBatch.Empty())
+    {
+        return;
+    }
+
+    immediateContext->PSSetShader(batchPixelShader.Get(), NULL, 0);
+
+    // Ɠ_ : 1 ̒_obt@ɑēāA 1 A_ 1 `
+    const size_t lineVertexCount = flushBatch.lines.size();
+    const size_t pointCount = flushBatch.points.size();
+    if (lineVertexCount + pointCount > 0)
+    {
+        UINT firstVertex = 0;
+        DebugDrawBuffer::Vertex* vertices = static_cast<DebugDrawBuffer::Vertex*>(batchVertexBuffer->Map(immediateContext, static_cast<UINT>(lineVertexCount + pointCount), firstVertex));
+        std::memcpy(vertices, flushBatch.lines.data(), lineVertexCount * sizeof(DebugDrawBuffer::Vertex));
+        std::memcpy(vertices + lineVertexCount, flushBatch.points.data(), pointCount * sizeof(DebugDrawBuffer::Vertex));
+        batchVertexBuffer->Unmap(immediateContext);
+        batchVertexBuffer->Bind(immediateContext, 0, firstVertex);
+
+        immediateContext->IASetInputLayout(batchInputLayout.Get());
+        immediateContext->VSSetShader(batchVertexShader.Get(), NULL, 0);
+        if (lineVertexCount > 0)
+        {
+            immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+            immediateContext->Draw(static_cast<UINT>(lineVertexCount), 0);
+            ++flushStatistics.drawCalls;
+        }
+        if (pointCount > 0)
+        {
+            immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+            immediateContext->Draw(static_cast<UINT>(pointCount), static_cast<UINT>(lineVertexCount));
+            ++flushStatistics.drawCalls;
+        }
+    }
+
+    // ` : CX^X 1 ̃obt@ɎނƂɑēāAނƂ 1 CX^X`悷
+    const size_t instanceCount = flushBatch.ShapeInstanceCount();
+    if (instanceCount > 0)
+    {
+        UINT firstInstance = 0;
+        DebugDrawBuffer::ShapeInstance* instances = static_cast<DebugDrawBuffer::ShapeInstance*>(shapeInstanceBuffer->Map(immediateContext, static_cast<UINT>(instanceCount), firstInstance));
+        for (const std::vector<DebugDrawBuffer::ShapeInstance>& shapeInstances : flushBatch.shapes)
+        {
+            std::memcpy(instances, shapeInstances.data(), shapeInstances.size() * sizeof(DebugDrawBuffer::ShapeInstance));
+            instances += shapeInstances.size();
+        }
+        shapeInstanceBuffer->Unmap(immediateContext);
+
+        immediateContext->IASetInputLayout(shapeInstancedInputLayout.Get());
+        immediateContext->VSSetShader(shapeInstancedVertexShader.Get(), NULL, 0);
+        immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        for (size_t shape = 0; shape < DebugDrawBuffer::ShapeCount; ++shape)
+        {
+            const UINT count = static_cast<UINT>(flushBatch.shapes[shape].size());
+            if (count == 0)
+            {
+                continue;
+            }
+            const ShapeMesh& mesh = shapeMeshes[shape];
+            UINT stride{ sizeof(DirectX::XMFLOAT3) };
+            UINT offset{ 0 };
+            immediateContext->IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &stride, &offset);
+            immediateContext->IASetIndexBuffer(mesh.indexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0);
+            shapeInstanceBuffer->Bind(immediateContext, 1, firstInstance);
+            immediateContext->DrawIndexedInstanced(mesh.indexCount, count, 0, 0, 0);
+            ++flushStatistics.drawCalls;
+            firstInstance += count;
+        }
+    }
+}
+
+std::string ShapeRenderer::FlushStatistics::ToString() const
+{
+    char buf[256];
+    sprintf_s(buf, "  debug draw : %zu flushes, %zu draw calls, %zu lines, %zu points, %zu shapes, %zu dropped\n", flushes, drawCalls, lines, points, shapes, dropped);
+    return buf;
+}
+
 
 LineSegment::LineSegment(ID3D11Device* device, size_t maxPoints) : max_points(maxPoints)
 {
@@ -3,8 +3,11 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <memory>
+#include <string>
 #include <vector>
 #include "Graphics/Resource/GltfModel.h"
+#include "Graphics/Renderer/DebugDrawBuffer.h"
+#include "Graphics/Renderer/InstanceBuffer.h"
 
 class ShapeRenderer
 {
@@ -58,7 +61,36 @@ public:
 
     //` Ȃ
     static void DrawSegment(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT3& startPosition, const DirectX::XMFLOAT3& endPosition);
+
+    // true ̎A Draw* ͂ɂ͕`悹 DebugDrawBuffer ɂ߂ (ǂ̃XbhĂł悢)
+    // ߂̂ Flush ŐE_E`̎ނƂ 1 񂸂܂Ƃ߂ĕ`悷
+    static inline bool enableBatching = true;
+
+    // ߂E_E`܂Ƃ߂ĕ`悷 (`悷XbhŁAfobO`̋؂育ƂɌĂ)
+    // X^CUE[xXe[g͌Ă񂾎̂̂̂܂܎g
+    static void Flush(ID3D11DeviceContext* immediateContext);
+
+    static DebugDrawBuffer& GetDebugDrawBuffer() { return debugDrawBuffer; }
+
+    // O ResetFlushStatistics Ă Flush ̍v
+    struct FlushStatistics
+    {
+        size_t flushes = 0;
+        size_t lines = 0;
+        size_t points = 0;
+        size_t shapes = 0;
+        size_t dropped = 0;
+        size_t drawCalls = 0;
+
+        std::string ToString() const;
+    };
+    static const FlushStatistics& GetFlushStatistics() { return flushStatistics; }
+    static void ResetFlushStatistics() { flushStatistics = {}; }
+
 private:
+    // ` 1 ` (enableBatching ̎͂߂邾)
+    static void DrawShape(ID3D11DeviceContext* immediateContext, DebugDrawBuffer::Shape shape, const DirectX::XMFLOAT4X4& world, const DirectX::XMFLOAT4& color);
+
     struct DebugConstants
     {
         DirectX::XMFLOAT4 color;
@@ -81,6 +113,28 @@ private:
     static inline std::unique_ptr<GltfModel> capsule = nullptr;
     static inline std::unique_ptr<GltfModel> cube = nullptr;        // ̒ʂ_
     static inline std::unique_ptr<GltfModel> cubeCenter = nullptr;  // ̐^񒆂_
+
+    // ܂Ƃ߂ĕ`悷鎞Ɏg
+    struct ShapeMesh
+    {
+        Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+        Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
+        UINT indexCount = 0;
+    };
+    static inline ShapeMesh shapeMeshes[DebugDrawBuffer::ShapeCount];
+
+    static inline Microsoft::WRL::ComPtr<ID3D11VertexShader> batchVertexShader;
+    static inline Microsoft::WRL::ComPtr<ID3D11InputLayout> batchInputLayout;
+    static inline Microsoft::WRL::ComPtr<ID3D11VertexShader> shapeInstancedVertexShader;
+    static inline Microsoft::WRL::ComPtr<ID3D11InputLayout> shapeInstancedInputLayout;
+    static inline Microsoft::WRL::ComPtr<ID3D11PixelShader> batchPixelShader;
+
+    static inline std::unique_ptr<InstanceBuffer> batchVertexBuffer;      // Ɠ_̒_ (DebugDrawBuffer::Vertex)
+    static inline std::unique_ptr<InstanceBuffer> shapeInstanceBuffer;    // `̃CX^X (DebugDrawBuffer::ShapeInstance)
+
+    static inline DebugDrawBuffer debugDrawBuffer;
+    static inline DebugDrawBuffer::Batch flushBatch;   // Flush Ŏg܂킷
+    static inline FlushStatistics flushStatistics;
 };
 
 
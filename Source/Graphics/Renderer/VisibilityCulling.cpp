@@ -0,0 +1,244 @@
+#include "VisibilityCulling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+using namespace DirectX;
+
+void VisibilityCulling::BeginFrame()
+{
+    objectCount = 0;
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+    views.clear();
+}
+
+uint32_t VisibilityCulling::AddBounds(const AABB& worldBounds)
+{
+    const uint32_t object = static_cast<uint32_t>(objectCount++);
+    // Cull ŕt]lߒ
+    minX.resize(object);
+    minY.resize(object);
+    minZ.resize(object);
+    maxX.resize(object);
+    maxY.resize(object);
+    maxZ.resize(object);
+    minX.push_back(worldBounds.min.x);
+    minY.push_back(worldBounds.min.y);
+    minZ.push_back(worldBounds.min.z);
+    maxX.push_back(worldBounds.max.x);
+    maxY.push_back(worldBounds.max.y);
+    maxZ.push_back(worldBounds.max.z);
+    return object;
+}
+
+size_t VisibilityCulling::AddView(const View& view)
+{
+    ViewData& data = views.emplace_back();
+    data.view = view;
+    data.frustum = ExtractFrustum(view.viewProjection, view.isShadowCaster);
+    return views.size() - 1;
+}
+
+void VisibilityCulling::Cull()
+{
+    // 4 ǂ߂悤ɗ]𖄂߂
+    const size_t paddedCount = (objectCount + 3) & ~static_cast<size_t>(3);
+    minX.resize(paddedCount, 0.0f);
+    minY.resize(paddedCount, 0.0f);
+    minZ.resize(paddedCount, 0.0f);
+    maxX.resize(paddedCount, 0.0f);
+    maxY.resize(paddedCount, 0.0f);
+    maxZ.resize(paddedCount, 0.0f);
+
+    for (ViewData& view : views)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        CullView(view);
+        view.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+}
+
+void VisibilityCulling::CullView(ViewData& view) const
+{
+    view.visible.clear();
+    const Frustum& frustum = view.frustum;
+
+    // ʂƂɁA@̌Ŕ̈ԓ̒_ (p-vertex) I
+    struct PlaneSimd
+    {
+        XMVECTOR a, b, c, d;
+        bool useMaxX, useMaxY, useMaxZ;
+    };
+    PlaneSimd planes[6];
+    for (int i = 0; i < frustum.planeCount; ++i)
+    {
+        const XMFLOAT4& plane = frustum.planes[i];
+        planes[i] = { XMVectorReplicate(plane.x), XMVectorReplicate(plane.y), XMVectorReplicate(plane.z), XMVectorReplicate(plane.w),
+            plane.x >= 0.0f, plane.y >= 0.0f, plane.z >= 0.0f };
+    }
+
+    const XMVECTOR zero = XMVectorZero();
+    for (size_t group = 0; group < objectCount; group += 4)
+    {
+        const XMVECTOR groupMinX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&minX[group]));
+        const XMVECTOR groupMinY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&minY[group]));
+        const XMVECTOR groupMinZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&minZ[group]));
+        const XMVECTOR groupMaxX = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&maxX[group]));
+        const XMVECTOR groupMaxY = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&maxY[group]));
+        const XMVECTOR groupMaxZ = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&maxZ[group]));
+
+        XMVECTOR outside = XMVectorFalseInt();
+        for (int i = 0; i < frustum.planeCount; ++i)
+        {
+            const PlaneSimd& plane = planes[i];
+            XMVECTOR distance = XMVectorMultiplyAdd(plane.useMaxX ? groupMaxX : groupMinX, plane.a, plane.d);
+            distance = XMVectorMultiplyAdd(plane.useMaxY ? groupMaxY : groupMinY, plane.b, distance);
+            distance = XMVectorMultiplyAdd(plane.useMaxZ ? groupMaxZ : groupMinZ, plane.c, distance);
+            outside = XMVectorOrInt(outside, XMVectorLess(distance, zero));
+        }
+
+        XMUINT4 mask;
+        XMStoreUInt4(&mask, outside);
+        const uint32_t lanes[4] = { mask.x, mask.y, mask.z, mask.w };
+        const size_t laneCount = (std::min)(objectCount - group, static_cast<size_t>(4));
+        for (size_t lane = 0; lane < laneCount; ++lane)
+        {
+            if (lanes[lane] == 0)
+            {
+                view.visible.push_back(static_cast<uint32_t>(group + lane));
+            }
+        }
+    }
+}
+
+std::vector<uint32_t> VisibilityCulling::VisibleInAny(size_t firstView, size_t viewCount) const
+{
+    std::vector<uint8_t> isVisible(objectCount, 0);
+    for (size_t view = firstView; view < firstView + viewCount && view < views.size(); ++view)
+    {
+        for (uint32_t object : views[view].visible)
+        {
+            isVisible[object] = 1;
+        }
+    }
+    // IuWFNg̏Ԃ͕ۂ
+    std::vector<uint32_t> visible;
+    for (size_t object = 0; object < objectCount; ++object)
+    {
+        if (isVisible[object])
+        {
+            visible.push_back(static_cast<uint32_t>(object));
+        }
+    }
+    return visible;
+}
+
+void VisibilityCulling::Dispatch(const std::vector<uint32_t>& visible, DrawBackend& backend) const
+{
+    for (uint32_t object : visible)
+    {
+        backend.Draw(object);
+    }
+}
+
+std::vector<VisibilityCulling::ViewStatistics> VisibilityCulling::Statistics() const
+{
+    std::vector<ViewStatistics> statistics;
+    for (const ViewData& view : views)
+    {
+        statistics.push_back({ view.view.name, objectCount, view.visible.size(), view.milliseconds });
+    }
+    return statistics;
+}
+
+std::string VisibilityCulling::Report() const
+{
+    std::string text;
+    char buf[256];
+    for (const ViewStatistics& statistics : Statistics())
+    {
+        sprintf_s(buf, "  %-10s : %5zu / %5zu visible, %.3f ms\n", statistics.name.c_str(), statistics.visibleCount, statistics.testedCount, statistics.milliseconds);
+        text += buf;
+    }
+    return text;
+}
+
+VisibilityCulling::Frustum VisibilityCulling::ExtractFrustum(const XMFLOAT4X4& viewProjection, bool isShadowCaster)
+{
+    // sxNg (v * M) Ȃ̂ŗ񂩂畽ʂo (Gribb / HartmannAD3D  0 <= z <= w)
+    const XMFLOAT4X4& m = viewProjection;
+    const XMFLOAT4 column0 = { m._11, m._21, m._31, m._41 };
+    const XMFLOAT4 column1 = { m._12, m._22, m._32, m._42 };
+    const XMFLOAT4 column2 = { m._13, m._23, m._33, m._43 };
+    const XMFLOAT4 column3 = { m._14, m._24, m._34, m._44 };
+    auto add = [](const XMFLOAT4& a, const XMFLOAT4& b) { return XMFLOAT4{ a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; };
+    auto subtract = [](const XMFLOAT4& a, const XMFLOAT4& b) { return XMFLOAT4{ a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; };
+
+    Frustum frustum;
+    frustum.planes[0] = add(column3, column0);      // left
+    frustum.planes[1] = subtract(column3, column0); // right
+    frustum.planes[2] = add(column3, column1);      // bottom
+    frustum.planes[3] = subtract(column3, column1); // top
+    frustum.planes[4] = subtract(column3, column2); // far
+    frustum.planes[5] = column2;                    // near
+    frustum.planeCount = isShadowCaster ? 5 : 6;
+    for (XMFLOAT4& plane : frustum.planes)
+    {
+        const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+        {
+            plane.x /= length;
+            plane.y /= length;
+            plane.z /= length;
+            plane.w /= length;
+        }
+    }
+    return frustum;
+}
+
+bool VisibilityCulling::TestBounds(const Frustum& frustum, const AABB& bounds)
+{
+    for (int i = 0; i < frustum.planeCount; ++i)
+    {
+        const XMFLOAT4& plane = frustum.planes[i];
+        const float x = plane.x >= 0.0f ? bounds.max.x : bounds.min.x;
+        const float y = plane.y >= 0.0f ? bounds.max.y : bounds.min.y;
+        const float z = plane.z >= 0.0f ? bounds.max.z : bounds.min.z;
+        if (plane.x * x + plane.y * y + plane.z * z + plane.w < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+AABB VisibilityCulling::TransformBounds(const AABB& bounds, const XMFLOAT4X4& transform)
+{
+    // SƔaϊ (a͍s̐ΒlōL)
+    const XMFLOAT3 center = { (bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f };
+    const XMFLOAT3 extent = { (bounds.max.x - bounds.min.x) * 0.5f, (bounds.max.y - bounds.min.y) * 0.5f, (bounds.max.z - bounds.min.z) * 0.5f };
+    const XMFLOAT4X4& m = transform;
+    const XMFLOAT3 worldCenter =
+    {
+        center.x * m._11 + center.y * m._21 + center.z * m._31 + m._41,
+        center.x * m._12 + center.y * m._22 + center.z * m._32 + m._42,
+        center.x * m._13 + center.y * m._23 + center.z * m._33 + m._43,
+    };
+    const XMFLOAT3 worldExtent =
+    {
+        extent.x * std::fabs(m._11) + extent.y * std::fabs(m._21) + extent.z * std::fabs(m._31),
+        extent.x * std::fabs(m._12) + extent.y * std::fabs(m._22) + extent.z * std::fabs(m._32),
+        extent.x * std::fabs(m._13) + extent.y * std::fabs(m._23) + extent.z * std::fabs(m._33),
+    };
+    AABB result;
+    result.min = { worldCenter.x - worldExtent.x, worldCenter.y - worldExtent.y, worldCenter.z - worldExtent.z };
+    result.max = { worldCenter.x + worldExtent.x, worldCenter.y + worldExtent.y, worldCenter.z + worldExtent.z };
+    return result;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Physics/Collider.h"
+
+// 1 t[ 1 A[hԂ AABB JEJXP[hƂ̃Cg̎őIʂ
+// AABB  SoA ̔zɕׁA4 ܂Ƃ߂ĕʂƔ肷
+// ʂ̓r[Ƃ̌IuWFNgԍ̈ꗗŁAepX͂ DrawBackend ɗĕ`悷
+class VisibilityCulling
+{
+public:
+    struct View
+    {
+        std::string name;
+        DirectX::XMFLOAT4X4 viewProjection;
+        // e𗎂Ƃ̔ (Cg̎Oɂ̂e𗎂Ƃ̂ŋߕʂł͑IʂȂ)
+        bool isShadowCaster = false;
+    };
+
+    //  (ax + by + cz + d >= 0 )
+    struct Frustum
+    {
+        DirectX::XMFLOAT4 planes[6];
+        int planeCount = 6;
+    };
+
+    struct ViewStatistics
+    {
+        std::string name;
+        size_t testedCount = 0;
+        size_t visibleCount = 0;
+        double milliseconds = 0.0;
+    };
+
+    // IuWFNg󂯎ĕ`悷 (wbhX̊mFł͋L^邾)
+    class DrawBackend
+    {
+    public:
+        virtual ~DrawBackend() = default;
+        virtual void Draw(uint32_t object) = 0;
+    };
+
+    // `悵ԍoĂ DrawBackend
+    class RecordingBackend : public DrawBackend
+    {
+    public:
+        void Draw(uint32_t object) override { objects.push_back(object); }
+        std::vector<uint32_t> objects;
+    };
+
+    // IuWFNgƃr[ɂ
+    void BeginFrame();
+    // ߂lIuWFNgԍ (AddBounds )
+    uint32_t AddBounds(const AABB& worldBounds);
+    // ߂lr[ԍ
+    size_t AddView(const View& view);
+    // SẴr[Iʂ
+    void Cull();
+
+    size_t ObjectCount() const { return objectCount; }
+    size_t ViewCount() const { return views.size(); }
+    const View& GetView(size_t view) const { return views.at(view).view; }
+    const std::vector<uint32_t>& Visible(size_t view) const { return views.at(view).visible; }
+    // firstView  viewCount ̂ǂꂩŌ (SJXP[hxɕ`ẽpXp)
+    std::vector<uint32_t> VisibleInAny(size_t firstView, size_t viewCount) const;
+    void Dispatch(const std::vector<uint32_t>& visible, DrawBackend& backend) const;
+
+    std::vector<ViewStatistics> Statistics() const;
+    std::string Report() const;
+
+    static Frustum ExtractFrustum(const DirectX::XMFLOAT4X4& viewProjection, bool isShadowCaster);
+    // SIMD g킸 1 肷 (mFp)
+    static bool TestBounds(const Frustum& frustum, const AABB& bounds);
+    // [J AABB sŕϊāA͂ރ[h AABB ɂ
+    static AABB TransformBounds(const AABB& bounds, const DirectX::XMFLOAT4X4& transform);
+
+private:
+    struct ViewData
+    {
+        View view;
+        Frustum frustum;
+        std::vector<uint32_t> visible;
+        double milliseconds = 0.0;
+    };
+
+    void CullView(ViewData& view) const;
+
+    // 4 ̔{ɐ؂グ SoA (]͔肵ĂʂɓȂ)
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+    size_t objectCount = 0;
+    std::vector<ViewData> views;
+};
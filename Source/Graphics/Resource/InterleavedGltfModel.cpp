@@ -2,13 +2,17 @@
 #include "InterleavedGltfModel.h"
 #include <functional>
 #include <filesystem>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <sstream>
 
 //#define TINYGLTF_IMPLEMENTATION
 #include "tiny_gltf.h"
 
 #include "Engine/Utility/Win32Utils.h"
 #include "Engine/Debug/Assert.h"
+#include "Engine/Debug/Logger.h"
 #include "Engine/Serialization/DirectXSerializers.h"
 #include "Graphics/Core/Shader.h"
 #include "Texture.h"
@@ -41,59 +45,135 @@ bool _NullLoadImageData(tinygltf::Image*, const int, std::string*, std::string*,
 }
 InterleavedGltfModel::InterleavedGltfModel(ID3D11Device* device, const std::string& filename, Mode mode, bool isSaveVerticesData) : filename(filename), mode(mode), isSaveVerticesData(isSaveVerticesData)
 {
+    // AssetLoader ƓiĂяoXbhŏԂɍs
+    ReadSourceFile();
+    ParseSource();
+    ProcessSource();
+    UploadResources(device);
+}
+
+std::shared_ptr<InterleavedGltfModel> InterleavedGltfModel::CreateUnloaded(const std::string& filename, Mode mode, bool isSaveVerticesData)
+{
+    std::shared_ptr<InterleavedGltfModel> model(new InterleavedGltfModel());
+    model->filename = filename;
+    model->mode = mode;
+    model->isSaveVerticesData = isSaveVerticesData;
+    return model;
+}
+
+void InterleavedGltfModel::ReadSourceFile()
+{
+    _ASSERT_EXPR(loadSource == LoadSource::None, L"ReadSourceFile has already been called");
+
+    if (std::shared_ptr<MappedCache::Reader> reader = OpenMappedCache(GetCacheFilename(filename, mode)))
+    {// _/CfbNX/摜̓Rs[A}bv܂ UploadResources  GPU ɑ
+        mappedCache = reader;
+        loadSource = LoadSource::MappedCache;
+        return;
+    }
+
+    auto readFile = [this](const std::filesystem::path& path)
+        {
+            std::ifstream ifs(path, std::ios::binary);
+            _ASSERT_EXPR_A(ifs, ("Failed to open " + path.string()).c_str());
+            sourceBytes.resize(static_cast<size_t>(std::filesystem::file_size(path)));
+            ifs.read(sourceBytes.data(), static_cast<std::streamsize>(sourceBytes.size()));
+        };
+
+    // `̃LbV
     std::filesystem::path cerealFilename(filename);
     cerealFilename.replace_extension(mode == Mode::StaticMesh || mode == Mode::InstancedStaticMesh ? "batchCereal" : "cereal");
-    if (std::filesystem::exists(cerealFilename.c_str()))
+    if (std::filesystem::exists(cerealFilename))
     {
-        std::ifstream ifs(cerealFilename.c_str(), std::ios::binary);
-        cereal::BinaryInputArchive deserialization(ifs);
-        deserialization(
-            cereal::make_nvp("scenes", scenes),
-            cereal::make_nvp("defaultScene", defaultScene),
-            cereal::make_nvp("nodes", nodes),
-            cereal::make_nvp("materials", materials)
-        );
-        deserialization(cereal::make_nvp("batchMeshes", batchMeshes));
-        deserialization(cereal::make_nvp("meshes", meshes));
-        deserialization(cereal::make_nvp("textures", textures), cereal::make_nvp("images", images));
-        deserialization(cereal::make_nvp("skins", skins), cereal::make_nvp("animations", animations));
+        readFile(cerealFilename);
+        loadSource = LoadSource::Cereal;
+        return;
     }
-    else
-    {
-        tinygltf::TinyGLTF tinyGltf;
-        tinyGltf.SetImageLoader(_NullLoadImageData, nullptr);
 
-        //gltfModel = std::make_shared<tinygltf::Model>();
-        //tinygltf::Model gltfModel;
-        std::string error, warning;
-        bool succeeded = false;
-
-        if (cachedGltfModels.find(filename) != cachedGltfModels.end() && !cachedGltfModels.at(filename).expired())
+    loadSource = LoadSource::Gltf;
+    {
+        std::lock_guard<std::mutex> lock(cachedGltfModelsMutex);
+        auto it = cachedGltfModels.find(filename);
+        if (it != cachedGltfModels.end())
         {
             //LbVꂽf[^烂ff[^擾
-            gltfModel = cachedGltfModels.at(filename).lock();
+            gltfModel = it->second.lock();
         }
-        else
+    }
+    if (!gltfModel)
+    {// O .bin ͉͂̒i tinygltf ǂ
+        readFile(filename);
+    }
+}
+
+void InterleavedGltfModel::ParseSource()
+{
+    switch (loadSource)
+    {
+    case LoadSource::MappedCache:
+        ReadMappedCache(mappedCache);
+        break;
+    case LoadSource::Cereal:
+    {
+        std::istringstream stream(std::move(sourceBytes));
+        LoadCerealCache(stream);
+        break;
+    }
+    case LoadSource::Gltf:
+        if (!gltfModel)
         {
-            gltfModel = std::make_shared<tinygltf::Model>();
+            tinygltf::TinyGLTF tinyGltf;
+            tinyGltf.SetImageLoader(_NullLoadImageData, nullptr);
 
+            std::string error, warning;
+            bool succeeded = false;
+            std::shared_ptr<tinygltf::Model> parsedModel = std::make_shared<tinygltf::Model>();
+            const std::string baseDirectory = std::filesystem::path(filename).parent_path().string();
             if (filename.find(".glb") != std::string::npos)
             {
-                succeeded = tinyGltf.LoadBinaryFromFile(gltfModel.get(), &error, &warning, filename.c_str());
+                succeeded = tinyGltf.LoadBinaryFromMemory(parsedModel.get(), &error, &warning, reinterpret_cast<const unsigned char*>(sourceBytes.data()), static_cast<unsigned int>(sourceBytes.size()), baseDirectory);
             }
             else if (filename.find(".gltf") != std::string::npos)
             {
-                succeeded = tinyGltf.LoadASCIIFromFile(gltfModel.get(), &error, &warning, filename.c_str());
+                succeeded = tinyGltf.LoadASCIIFromString(parsedModel.get(), &error, &warning, sourceBytes.data(), static_cast<unsigned int>(sourceBytes.size()), baseDirectory);
             }
 
             _ASSERT_EXPR_A(warning.empty(), warning.c_str());
             _ASSERT_EXPR_A(error.empty(), error.c_str());
             _ASSERT_EXPR_A(succeeded, L"Failed to load glTF file");
 
-            //LbVǉ
-            cachedGltfModels[filename] = gltfModel;
+            //LbVǉ (ɓt@C͂ꍇ͐ɓo^ꂽg)
+            std::lock_guard<std::mutex> lock(cachedGltfModelsMutex);
+            std::weak_ptr<tinygltf::Model>& cached = cachedGltfModels[filename];
+            gltfModel = cached.lock();
+            if (!gltfModel)
+            {
+                gltfModel = parsedModel;
+                cached = gltfModel;
+            }
         }
+        break;
+    default:
+        _ASSERT_EXPR(FALSE, L"ReadSourceFile must be called before ParseSource");
+        break;
+    }
+    sourceBytes.clear();
+    sourceBytes.shrink_to_fit();
+}
 
+void InterleavedGltfModel::ProcessSource()
+{
+    if (loadSource == LoadSource::Cereal)
+    {// `ǂݍŐV`ɏ
+        QuantizeVertices();
+        OptimizeMeshes();
+        GenerateLods();
+        GenerateMeshlets();
+        ComputeLocalBounds();
+        SaveMappedCache(GetCacheFilename(filename, mode));
+    }
+    else if (loadSource == LoadSource::Gltf)
+    {
         for (const tinygltf::Scene& gltfScene : gltfModel->scenes)
         {
             Scene& scene = scenes.emplace_back();
@@ -102,39 +182,759 @@ InterleavedGltfModel::InterleavedGltfModel(ID3D11Device* device, const std::stri
         }
         defaultScene = gltfModel->defaultScene < 0 ? 0 : gltfModel->defaultScene;
 
+        // Fetch* ̓foCXgȂ
         FetchNodes(*gltfModel);
-        FetchMaterials(device, *gltfModel);
-        FetchTextures(device, *gltfModel);
+        FetchMaterials(nullptr, *gltfModel);
+        FetchTextures(nullptr, *gltfModel);
 
         if (mode == Mode::StaticMesh || mode == Mode::InstancedStaticMesh)
         {
-            FetchAndBatchMeshes(device, *gltfModel);
+            FetchAndBatchMeshes(nullptr, *gltfModel);
         }
         else
         {
-            FetchMeshes(device, *gltfModel);
+            FetchMeshes(nullptr, *gltfModel);
             FetchAnimations(*gltfModel, animations); // ڂ̃f̓Aj[V̂܂ܒǉ
         }
+        QuantizeVertices();
+        OptimizeMeshes();
+        GenerateLods();
+        GenerateMeshlets();
+        ComputeLocalBounds();
 
-        std::ofstream ofs(cerealFilename.c_str(), std::ios::binary);
-        cereal::BinaryOutputArchive serialization(ofs);
-        serialization(
-            cereal::make_nvp("scenes", scenes),
-            cereal::make_nvp("defaultScene", defaultScene),
-            cereal::make_nvp("nodes", nodes),
-            cereal::make_nvp("materials", materials)
-        );
-        serialization(cereal::make_nvp("batchMeshes", batchMeshes));
-        serialization(cereal::make_nvp("meshes", meshes));
-        serialization(cereal::make_nvp("textures", textures), cereal::make_nvp("images", images));
-        serialization(cereal::make_nvp("skins", skins), cereal::make_nvp("animations", animations));
-    }
-    //if (!staticBatching)
-    //{// staticBatching Ȃ
-    //    //CompouteBoundingBox();
-    //}
+        SaveMappedCache(GetCacheFilename(filename, mode));
+    }
+}
+
+void InterleavedGltfModel::UploadResources(ID3D11Device* device)
+{
     CreateAndUploadResources(device);
+    // GPU ɑI}bsO͕sv
+    mappedCache.reset();
+}
+
+namespace
+{
+    // LbV̓v
+    int cacheHitCount = 0;
+    int cacheMissCount = 0;
+    double cacheTotalLoadMilliseconds = 0.0;
+}
+
+std::string InterleavedGltfModel::MakeCacheKey(const std::string& filename, Mode mode, bool isSaveVerticesData)
+{
+    return filename + "|" + std::to_string(static_cast<int>(mode)) + "|" + (isSaveVerticesData ? "1" : "0");
+}
+
+std::shared_ptr<InterleavedGltfModel> InterleavedGltfModel::FindCached(const std::string& filename, Mode mode, bool isSaveVerticesData)
+{
+    if (mode == Mode::InstancedStaticMesh)
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(cachedModelsMutex);
+    auto it = cachedModels.find(MakeCacheKey(filename, mode, isSaveVerticesData));
+    if (it != cachedModels.end())
+    {
+        if (std::shared_ptr<InterleavedGltfModel> model = it->second.lock())
+        {
+            ++cacheHitCount;
+            return model;
+        }
+    }
+    return nullptr;
 }
+
+std::shared_ptr<InterleavedGltfModel> InterleavedGltfModel::Publish(const std::shared_ptr<InterleavedGltfModel>& model, double loadMilliseconds)
+{
+    if (model->mode == Mode::InstancedStaticMesh)
+    {// CX^Xobt@͎gƂɕKvȂ̂ŋLȂ
+        return model;
+    }
+
+    std::lock_guard<std::mutex> lock(cachedModelsMutex);
+    std::weak_ptr<InterleavedGltfModel>& cached = cachedModels[MakeCacheKey(model->filename, model->mode, model->isSaveVerticesData)];
+    if (std::shared_ptr<InterleavedGltfModel> other = cached.lock())
+    {
+        ++cacheHitCount;
+        return other;
+    }
+    cached = model;
+    ++cacheMissCount;
+    cacheTotalLoadMilliseconds += loadMilliseconds;
+
+    char buf[512];
+    sprintf_s(buf, "InterleavedGltfModel loaded %s (%.2f ms, %zu bytes)", model->filename.c_str(), loadMilliseconds, model->gpuBufferBytes);
+    Logger::Log(buf);
+    return model;
+}
+
+std::shared_ptr<InterleavedGltfModel> InterleavedGltfModel::Load(ID3D11Device* device, const std::string& filename, Mode mode, bool isSaveVerticesData)
+{
+    if (mode == Mode::InstancedStaticMesh)
+    {// CX^Xobt@͎gƂɕKvȂ̂ŋLȂ
+        return std::make_shared<InterleavedGltfModel>(device, filename, mode, isSaveVerticesData);
+    }
+
+    if (std::shared_ptr<InterleavedGltfModel> model = FindCached(filename, mode, isSaveVerticesData))
+    {
+        return model;
+    }
+
+    // ǂݍ݂̓bN̊Oōs (ɓt@Cǂ񂾏ꍇ͐ɓo^ꂽg)
+    LARGE_INTEGER frequency, begin, end;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&begin);
+    std::shared_ptr<InterleavedGltfModel> model = std::make_shared<InterleavedGltfModel>(device, filename, mode, isSaveVerticesData);
+    QueryPerformanceCounter(&end);
+    const double milliseconds = static_cast<double>(end.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+    return Publish(model, milliseconds);
+}
+
+std::shared_ptr<InterleavedGltfModel> InterleavedGltfModel::MakeUnique(const std::shared_ptr<InterleavedGltfModel>& model)
+{
+    {
+        std::lock_guard<std::mutex> lock(cachedModelsMutex);
+        const bool isShared = std::any_of(cachedModels.begin(), cachedModels.end(), [&](const auto& cached) { return cached.second.lock() == model; });
+        if (!isShared)
+        {
+            return model;
+        }
+    }
+    // CPU ̃f[^Aobt@EeNX` (ComPtr) ͂̂܂܋L
+    return std::make_shared<InterleavedGltfModel>(*model);
+}
+
+std::shared_ptr<InterleavedGltfModel> InterleavedGltfModel::MakeVariant(const std::shared_ptr<InterleavedGltfModel>& model, const std::string& variant, const std::function<void(InterleavedGltfModel&)>& apply)
+{
+    std::lock_guard<std::mutex> lock(cachedModelsMutex);
+    const std::string baseKey = MakeCacheKey(model->filename, model->mode, model->isSaveVerticesData);
+    auto base = cachedModels.find(baseKey + model->variantKey);
+    if (model->mode == Mode::InstancedStaticMesh || base == cachedModels.end() || base->second.lock() != model)
+    {// LĂȂ̂ł̂܂܏
+        apply(*model);
+        return model;
+    }
+
+    const std::string variantKey = model->variantKey + "|" + variant;
+    std::weak_ptr<InterleavedGltfModel>& cached = cachedModels[baseKey + variantKey];
+    if (std::shared_ptr<InterleavedGltfModel> other = cached.lock())
+    {
+        ++cacheHitCount;
+        return other;
+    }
+    // CPU ̃f[^Aobt@EeNX` (ComPtr) ͂̂܂܋L
+    std::shared_ptr<InterleavedGltfModel> copy = std::make_shared<InterleavedGltfModel>(*model);
+    copy->variantKey = variantKey;
+    apply(*copy);
+    cached = copy;
+    return copy;
+}
+
+InterleavedGltfModel::CacheStatistics InterleavedGltfModel::GetCacheStatistics()
+{
+    std::lock_guard<std::mutex> lock(cachedModelsMutex);
+    CacheStatistics statistics;
+    statistics.hitCount = cacheHitCount;
+    statistics.missCount = cacheMissCount;
+    statistics.totalLoadMilliseconds = cacheTotalLoadMilliseconds;
+    for (const auto& [key, cached] : cachedModels)
+    {
+        if (std::shared_ptr<InterleavedGltfModel> model = cached.lock())
+        {
+            ++statistics.liveModelCount;
+            statistics.liveGpuBufferBytes += model->gpuBufferBytes;
+        }
+    }
+    return statistics;
+}
+
+namespace
+{
+    // LbVt@C̎
+    constexpr uint32_t SkeltalMeshCacheType = MappedCache::MakeFourCC('I', 'G', 'S', 'K');
+    constexpr uint32_t BatchMeshCacheType = MappedCache::MakeFourCC('I', 'G', 'B', 'T');
+    constexpr uint32_t AnimationCacheType = MappedCache::MakeFourCC('I', 'G', 'A', 'N');
+
+    bool IsBatchMode(InterleavedGltfModel::Mode mode)
+    {
+        return mode == InterleavedGltfModel::Mode::StaticMesh || mode == InterleavedGltfModel::Mode::InstancedStaticMesh;
+    }
+}
+
+std::filesystem::path InterleavedGltfModel::GetCacheFilename(const std::string& filename, Mode mode)
+{
+    std::filesystem::path cacheFilename(filename);
+    cacheFilename.replace_extension(IsBatchMode(mode) ? "batchModelCache" : "modelCache");
+    return cacheFilename;
+}
+
+bool InterleavedGltfModel::LoadMappedCache(const std::filesystem::path& cacheFilename)
+{
+    std::shared_ptr<MappedCache::Reader> reader = OpenMappedCache(cacheFilename);
+    if (!reader)
+    {
+        return false;
+    }
+    ReadMappedCache(reader);
+    // CreateAndUploadResources I܂Ń}bsOێ
+    mappedCache = reader;
+    return true;
+}
+
+std::shared_ptr<MappedCache::Reader> InterleavedGltfModel::OpenMappedCache(const std::filesystem::path& cacheFilename) const
+{
+    if (!std::filesystem::exists(cacheFilename))
+    {
+        return nullptr;
+    }
+    std::shared_ptr<MappedCache::Reader> reader = std::make_shared<MappedCache::Reader>();
+    std::string error;
+    if (!reader->Open(cacheFilename, IsBatchMode(mode) ? BatchMeshCacheType : SkeltalMeshCacheType, &error))
+    {// ĂEÂLbV͍蒼
+        OutputDebugStringA(("InterleavedGltfModel : " + cacheFilename.string() + " : " + error + "\n").c_str());
+        return nullptr;
+    }
+    std::string report;
+    if (!MappedCache::ValidateModelRecords(*reader, report, sizeof(Material::data)))
+    {
+        OutputDebugStringA(("InterleavedGltfModel : " + cacheFilename.string() + "\n" + report).c_str());
+        return nullptr;
+    }
+
+    std::span<const MappedCache::ModelRecord> model = reader->Section<MappedCache::ModelRecord>(MappedCache::SectionId::Model);
+    if (model.empty() || model[0].vertexOptions != vertexFormatOptions.Hash())
+    {// ʎq̐ݒ肪ς̂ō蒼
+        OutputDebugStringA(("InterleavedGltfModel : " + cacheFilename.string() + " : vertex format options changed\n").c_str());
+        return nullptr;
+    }
+    if (model[0].meshOptions != meshOptimizerOptions.Hash())
+    {// בւ̐ݒ肪ς̂ō蒼
+        OutputDebugStringA(("InterleavedGltfModel : " + cacheFilename.string() + " : mesh optimizer options changed\n").c_str());
+        return nullptr;
+    }
+    if (model[0].lodOptions != meshSimplifierOptions.Hash())
+    {// LOD ̐ݒ肪ς̂ō蒼
+        OutputDebugStringA(("InterleavedGltfModel : " + cacheFilename.string() + " : mesh simplifier options changed\n").c_str());
+        return nullptr;
+    }
+    if (model[0].meshletOptions != meshletBuilderOptions.Hash())
+    {// bVbg̐ݒ肪ς̂ō蒼
+        OutputDebugStringA(("InterleavedGltfModel : " + cacheFilename.string() + " : meshlet builder options changed\n").c_str());
+        return nullptr;
+    }
+    return reader;
+}
+
+void InterleavedGltfModel::ReadMappedCache(const std::shared_ptr<MappedCache::Reader>& reader)
+{
+    std::span<const MappedCache::ModelRecord> model = reader->Section<MappedCache::ModelRecord>(MappedCache::SectionId::Model);
+    defaultScene = model.empty() ? 0 : model[0].defaultScene;
+    if (!model.empty() && model[0].boundsMin.x <= model[0].boundsMax.x)
+    {
+        localBounds = { model[0].boundsMin, model[0].boundsMax };
+        hasLocalBounds = true;
+    }
+    MappedCache::ReadScenes(*reader, scenes);
+    MappedCache::ReadNodes(*reader, nodes);
+    MappedCache::ReadMaterials(*reader, materials);
+    // 摜̓}bṽf[^璼ڃeNX`
+    MappedCache::ReadTextures(*reader, textures, images, false);
+    // _f[^cꍇRs[
+    for (const MappedCache::PrimitiveRecord& record : reader->Section<MappedCache::PrimitiveRecord>(MappedCache::SectionId::BatchMeshes))
+    {
+        MappedCache::ReadPrimitive(*reader, record, batchMeshes.emplace_back(), isSaveVerticesData);
+    }
+    MappedCache::ReadMeshes(*reader, meshes, isSaveVerticesData);
+    MappedCache::ReadSkins(*reader, skins);
+    MappedCache::ReadAnimations(*reader, animations);
+    UpdateLodErrors();
+    UpdateMeshletClusters();
+}
+
+void InterleavedGltfModel::SaveMappedCache(const std::filesystem::path& cacheFilename) const
+{
+    MappedCache::Writer writer(IsBatchMode(mode) ? BatchMeshCacheType : SkeltalMeshCacheType);
+    writer.AddSection(MappedCache::SectionId::Model, std::vector<MappedCache::ModelRecord>{ { defaultScene, static_cast<int32_t>(mode), vertexFormatOptions.Hash(), meshOptimizerOptions.Hash(), meshSimplifierOptions.Hash(), meshletBuilderOptions.Hash(),
+        hasLocalBounds ? localBounds.min : DirectX::XMFLOAT3{ 1, 1, 1 }, hasLocalBounds ? localBounds.max : DirectX::XMFLOAT3{ -1, -1, -1 } } });
+    MappedCache::WriteScenes(writer, scenes);
+    MappedCache::WriteNodes(writer, nodes);
+    MappedCache::WriteMaterials(writer, materials);
+    MappedCache::WriteTextures(writer, textures, images);
+
+    std::vector<MappedCache::PrimitiveRecord> primitives;
+    std::vector<MappedCache::PrimitiveRecord> batchPrimitives;
+    std::vector<MappedCache::AttributeRecord> attributes;
+    MappedCache::WriteMeshes(writer, meshes, primitives, attributes);
+    for (const BatchMesh& batchMesh : batchMeshes)
+    {
+        batchPrimitives.push_back(MappedCache::MakePrimitiveRecord(writer, batchMesh, attributes));
+    }
+    writer.AddSection(MappedCache::SectionId::Primitives, primitives);
+    writer.AddSection(MappedCache::SectionId::BatchMeshes, batchPrimitives);
+    writer.AddSection(MappedCache::SectionId::Attributes, attributes);
+
+    MappedCache::WriteSkins(writer, skins);
+    MappedCache::WriteAnimations(writer, animations);
+
+    if (!writer.Save(cacheFilename))
+    {
+        OutputDebugStringA(("InterleavedGltfModel : failed to write " + cacheFilename.string() + "\n").c_str());
+    }
+}
+
+void InterleavedGltfModel::LoadCerealCache(std::istream& stream)
+{
+    cereal::BinaryInputArchive deserialization(stream);
+    deserialization(
+        cereal::make_nvp("scenes", scenes),
+        cereal::make_nvp("defaultScene", defaultScene),
+        cereal::make_nvp("nodes", nodes),
+        cereal::make_nvp("materials", materials)
+    );
+    deserialization(cereal::make_nvp("batchMeshes", batchMeshes));
+    deserialization(cereal::make_nvp("meshes", meshes));
+    deserialization(cereal::make_nvp("textures", textures), cereal::make_nvp("images", images));
+    deserialization(cereal::make_nvp("skins", skins), cereal::make_nvp("animations", animations));
+}
+
+namespace
+{
+    std::vector<VertexFormatBuilder::Attributes> DecodeAttributes(const VertexFormat& format, const std::vector<unsigned char>& vertices)
+    {
+        const UINT stride = format.Stride();
+        std::vector<VertexFormatBuilder::Attributes> attributes(vertices.size() / stride);
+        for (size_t i = 0; i < attributes.size(); ++i)
+        {
+            VertexFormatBuilder::DecodeVertex(format, vertices.data() + i * stride, attributes[i]);
+        }
+        return attributes;
+    }
+
+    // ʒu̗ʎq͈͂Lv~eBu܂Ƃ߂ėʎq
+    // (bVŔ͈͂Ⴄƌpڂ̒_)
+    template<class PrimitiveT>
+    void QuantizePrimitives(const std::vector<PrimitiveT*>& primitives, bool skinned, const VertexFormatBuilder::Options& options, VertexFormatBuilder::ErrorReport* report)
+    {
+        std::vector<std::vector<VertexFormatBuilder::Attributes>> vertices(primitives.size());
+        DirectX::XMFLOAT3 minimum = { FLT_MAX, FLT_MAX, FLT_MAX };
+        DirectX::XMFLOAT3 maximum = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (size_t i = 0; i < primitives.size(); ++i)
+        {
+            vertices[i] = DecodeAttributes(primitives[i]->vertexFormat, primitives[i]->cachedVertices);
+            for (const VertexFormatBuilder::Attributes& vertex : vertices[i])
+            {
+                minimum = { (std::min)(minimum.x, vertex.position.x), (std::min)(minimum.y, vertex.position.y), (std::min)(minimum.z, vertex.position.z) };
+                maximum = { (std::max)(maximum.x, vertex.position.x), (std::max)(maximum.y, vertex.position.y), (std::max)(maximum.z, vertex.position.z) };
+            }
+        }
+        for (size_t i = 0; i < primitives.size(); ++i)
+        {
+            PrimitiveT& primitive = *primitives[i];
+            if (vertices[i].empty())
+            {
+                continue;
+            }
+            VertexFormat format = VertexFormatBuilder::Choose(vertices[i], skinned && primitive.has("JOINTS_0"), options);
+            if (format.position == VertexFormat::Position::Unorm16)
+            {
+                VertexFormatBuilder::SetPositionBounds(format, minimum, maximum);
+            }
+            std::vector<unsigned char> encoded = VertexFormatBuilder::Encode(format, vertices[i]);
+            if (report)
+            {
+                VertexFormatBuilder::Measure(format, vertices[i], encoded, primitive.vertexFormat.Stride(), *report);
+            }
+            primitive.vertexFormat = format;
+            primitive.cachedVertices = std::move(encoded);
+            primitive.vertexBufferView.sizeInBytes = static_cast<UINT>(primitive.cachedVertices.size());
+            primitive.vertexBufferView.strideInBytes = format.Stride();
+        }
+    }
+}
+
+void InterleavedGltfModel::QuantizeVertices(VertexFormatBuilder::ErrorReport* report)
+{
+    for (Mesh& mesh : meshes)
+    {
+        std::vector<Mesh::Primitive*> primitives;
+        for (Mesh::Primitive& primitive : mesh.primitives)
+        {
+            primitives.push_back(&primitive);
+        }
+        QuantizePrimitives(primitives, true, vertexFormatOptions, report);
+    }
+    // ob`bV̓[hԂɏĂݍς݂Ȃ̂ 1 ͈͂߂
+    for (BatchMesh& batchMesh : batchMeshes)
+    {
+        QuantizePrimitives(std::vector<BatchMesh*>{ &batchMesh }, false, vertexFormatOptions, report);
+    }
+}
+
+void InterleavedGltfModel::OptimizeMeshes(MeshOptimizer::Report* report)
+{
+    const MeshOptimizer::Options& options = meshOptimizerOptions;
+    auto optimize = [&](const std::string& name, std::vector<uint32_t>& indices, std::vector<unsigned char>& vertices, const VertexFormat& format)
+        {
+            const size_t stride = format.Stride();
+            MeshOptimizer::Report::Entry entry;
+            entry.name = name;
+            if (report)
+            {
+                entry.before = MeshOptimizer::Analyze(indices, vertices.size() / stride, stride, options.cacheSize);
+            }
+            // ʒu͒_tFb`̕בւ̑OɂQƂȂ̂ŁAʎqς݂̒_炻̂܂ܕ
+            MeshOptimizer::Optimize(indices, vertices, stride, [&](uint32_t index)
+                {
+                    return VertexFormatBuilder::DecodePosition(format, vertices.data(), index);
+                }, options);
+            if (report)
+            {
+                entry.after = MeshOptimizer::Analyze(indices, vertices.size() / stride, stride, options.cacheSize);
+                report->entries.push_back(entry);
+            }
+        };
+
+    for (Mesh& mesh : meshes)
+    {
+        for (size_t i = 0; i < mesh.primitives.size(); ++i)
+        {
+            Mesh::Primitive& primitive = mesh.primitives[i];
+            const size_t indexSize = primitive.indexBufferView.format == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) :
+                primitive.indexBufferView.format == DXGI_FORMAT_R32_UINT ? sizeof(uint32_t) : 0;
+            if (indexSize == 0 || primitive.cachedIndices.empty() || primitive.cachedVertices.empty())
+            {
+                continue;
+            }
+            std::vector<uint32_t> indices = MeshOptimizer::ReadIndices(primitive.cachedIndices, indexSize);
+            optimize(mesh.name + "[" + std::to_string(i) + "]", indices, primitive.cachedVertices, primitive.vertexFormat);
+            MeshOptimizer::WriteIndices(indices, indexSize, primitive.cachedIndices);
+            primitive.vertexBufferView.sizeInBytes = static_cast<UINT>(primitive.cachedVertices.size());
+        }
+    }
+    for (BatchMesh& batchMesh : batchMeshes)
+    {
+        if (batchMesh.cachedIndices.empty() || batchMesh.cachedVertices.empty())
+        {
+            continue;
+        }
+        optimize("batch material " + std::to_string(batchMesh.material), batchMesh.cachedIndices, batchMesh.cachedVertices, batchMesh.vertexFormat);
+        batchMesh.vertexBufferView.sizeInBytes = static_cast<UINT>(batchMesh.cachedVertices.size());
+    }
+}
+
+void InterleavedGltfModel::GenerateLods(MeshSimplifier::Report* report)
+{
+    static_assert(MeshSimplifier::MaxLodCount == MappedCache::MaxLodCount, "LOD count must match the cache record");
+    const MeshSimplifier::Options& options = meshSimplifierOptions;
+    const auto start = std::chrono::high_resolution_clock::now();
+    auto generate = [&](const std::string& name, std::vector<uint32_t>& indices, const std::vector<unsigned char>& vertices, const VertexFormat& format)
+        {
+            const size_t vertexCount = vertices.size() / format.Stride();
+            MeshSimplifier::Report::Entry entry;
+            entry.name = name;
+            entry.vertexCount = vertexCount;
+            entry.lods = MeshSimplifier::GenerateLods(indices, vertexCount, [&](uint32_t index)
+                {
+                    return VertexFormatBuilder::DecodePosition(format, vertices.data(), index);
+                }, options, &entry.extent);
+            std::vector<MeshSimplifier::Lod> lods = entry.lods;
+            if (report)
+            {
+                report->entries.push_back(std::move(entry));
+            }
+            return lods;
+        };
+
+    for (Mesh& mesh : meshes)
+    {
+        for (size_t i = 0; i < mesh.primitives.size(); ++i)
+        {
+            Mesh::Primitive& primitive = mesh.primitives[i];
+            const size_t indexSize = primitive.indexBufferView.format == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) :
+                primitive.indexBufferView.format == DXGI_FORMAT_R32_UINT ? sizeof(uint32_t) : 0;
+            if (indexSize == 0 || primitive.cachedIndices.empty() || primitive.cachedVertices.empty())
+            {
+                continue;
+            }
+            // i͓_obt@ĝŁA16bit ̃CfbNX̂܂܌ɒǉł
+            std::vector<uint32_t> indices = MeshOptimizer::ReadIndices(primitive.cachedIndices, indexSize);
+            primitive.lods = generate(mesh.name + "[" + std::to_string(i) + "]", indices, primitive.cachedVertices, primitive.vertexFormat);
+            if (!primitive.lods.empty())
+            {
+                MeshOptimizer::WriteIndices(indices, indexSize, primitive.cachedIndices);
+                primitive.indexBufferView.sizeInBytes = static_cast<UINT>(primitive.cachedIndices.size());
+            }
+        }
+    }
+    for (BatchMesh& batchMesh : batchMeshes)
+    {
+        if (batchMesh.cachedIndices.empty() || batchMesh.cachedVertices.empty())
+        {
+            continue;
+        }
+        batchMesh.lods = generate("batch material " + std::to_string(batchMesh.material), batchMesh.cachedIndices, batchMesh.cachedVertices, batchMesh.vertexFormat);
+        batchMesh.indexBufferView.sizeInBytes = static_cast<UINT>(batchMesh.cachedIndices.size() * sizeof(UINT));
+    }
+    if (report)
+    {
+        report->milliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    UpdateLodErrors();
+}
+
+void InterleavedGltfModel::UpdateLodErrors()
+{
+    lodErrors.clear();
+    auto merge = [&](const std::vector<MeshSimplifier::Lod>& lods)
+        {
+            if (lods.size() > lodErrors.size())
+            {// iȂ͍̂Ō̒i`̂ŁǍ덷p
+                lodErrors.resize(lods.size(), lodErrors.empty() ? 0.0f : lodErrors.back());
+            }
+            for (size_t level = 0; level < lodErrors.size(); ++level)
+            {
+                lodErrors[level] = (std::max)(lodErrors[level], lods.empty() ? 0.0f : lods[(std::min)(level, lods.size() - 1)].error);
+            }
+        };
+    for (const Mesh& mesh : meshes)
+    {
+        for (const Mesh::Primitive& primitive : mesh.primitives)
+        {
+            merge(primitive.lods);
+        }
+    }
+    for (const BatchMesh& batchMesh : batchMeshes)
+    {
+        merge(batchMesh.lods);
+    }
+}
+
+void InterleavedGltfModel::GenerateMeshlets(MeshletBuilder::Report* report)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t batchIndex = 0; batchIndex < batchMeshes.size(); ++batchIndex)
+    {
+        BatchMesh& batchMesh = batchMeshes[batchIndex];
+        batchMesh.meshlets.clear();
+        if (batchMesh.cachedIndices.empty() || batchMesh.cachedVertices.empty())
+        {
+            continue;
+        }
+        // ʂ̃}eA͗`̂ŁA䂾őIʂ (}eAǂłȂꗗ͕̎ЖʂƂ݂Ȃ)
+        const bool coneCulling = batchMesh.material < 0 || static_cast<size_t>(batchMesh.material) >= materials.size() || materials[batchMesh.material].data.doubleSided == 0;
+        const MeshSimplifier::Lod lod = batchMesh.GetLod(0);
+        const size_t vertexCount = batchMesh.cachedVertices.size() / batchMesh.vertexFormat.Stride();
+        MeshletBuilder::Report::Entry entry;
+        entry.name = "batch material " + std::to_string(batchMesh.material);
+        entry.triangleCount = lod.indexCount / 3;
+        entry.meshlets = MeshletBuilder::Build(batchMesh.cachedIndices, lod.firstIndex, lod.indexCount, vertexCount, [&](uint32_t index)
+            {
+                return VertexFormatBuilder::DecodePosition(batchMesh.vertexFormat, batchMesh.cachedVertices.data(), index);
+            }, meshletBuilderOptions, coneCulling, &entry.vertexTotal);
+        batchMesh.meshlets = entry.meshlets;
+        if (report)
+        {
+            report->entries.push_back(std::move(entry));
+        }
+    }
+    if (report)
+    {
+        report->milliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    UpdateMeshletClusters();
+}
+
+void InterleavedGltfModel::UpdateMeshletClusters()
+{
+    for (BatchMesh& batchMesh : batchMeshes)
+    {
+        batchMesh.meshletClusters.Assign(batchMesh.meshlets);
+    }
+}
+
+bool InterleavedGltfModel::FetchVerticesOnly(const std::string& filename, Mode mode, InterleavedGltfModel& model, std::string& error)
+{
+    tinygltf::TinyGLTF tinyGltf;
+    tinyGltf.SetImageLoader(_NullLoadImageData, nullptr);
+    tinygltf::Model gltfModel;
+    std::string warning;
+    const bool succeeded = filename.find(".glb") != std::string::npos ?
+        tinyGltf.LoadBinaryFromFile(&gltfModel, &error, &warning, filename.c_str()) :
+        tinyGltf.LoadASCIIFromFile(&gltfModel, &error, &warning, filename.c_str());
+    if (!succeeded)
+    {
+        return false;
+    }
+
+    // GPU \[X͍炸A_ǂݍ
+    model.mode = mode;
+    for (const tinygltf::Scene& gltfScene : gltfModel.scenes)
+    {
+        Scene& scene = model.scenes.emplace_back();
+        scene.name = gltfScene.name;
+        scene.nodes = gltfScene.nodes;
+    }
+    model.defaultScene = gltfModel.defaultScene < 0 ? 0 : gltfModel.defaultScene;
+    model.FetchNodes(gltfModel);
+    if (IsBatchMode(mode))
+    {
+        model.FetchAndBatchMeshes(nullptr, gltfModel);
+    }
+    else
+    {
+        model.FetchMeshes(nullptr, gltfModel);
+    }
+    return true;
+}
+
+std::string InterleavedGltfModel::ReportVertexFormats(const std::string& filename, Mode mode)
+{
+    InterleavedGltfModel model;
+    std::string error;
+    if (!FetchVerticesOnly(filename, mode, model, error))
+    {
+        return filename + " : " + error + "\n";
+    }
+    VertexFormatBuilder::ErrorReport report;
+    model.QuantizeVertices(&report);
+
+    std::string text = filename + "\n";
+    auto line = [&](const std::string& name, const VertexFormat& format, size_t vertexCount)
+        {
+            text += "  " + name + " : " + std::to_string(vertexCount) + " vertices, " + format.ToString() + "\n";
+        };
+    for (const Mesh& mesh : model.meshes)
+    {
+        for (size_t i = 0; i < mesh.primitives.size(); ++i)
+        {
+            line(mesh.name + "[" + std::to_string(i) + "]", mesh.primitives[i].vertexFormat, mesh.primitives[i].VertexCount());
+        }
+    }
+    for (const BatchMesh& batchMesh : model.batchMeshes)
+    {
+        if (!batchMesh.cachedVertices.empty())
+        {
+            line("batch material " + std::to_string(batchMesh.material), batchMesh.vertexFormat, batchMesh.VertexCount());
+        }
+    }
+    text += report.ToString();
+    return text;
+}
+
+std::string InterleavedGltfModel::ReportMeshOptimization(const std::string& filename, Mode mode)
+{
+    InterleavedGltfModel model;
+    std::string error;
+    if (!FetchVerticesOnly(filename, mode, model, error))
+    {
+        return filename + " : " + error + "\n";
+    }
+    // LbVƓʎqɕבւ
+    model.QuantizeVertices();
+    MeshOptimizer::Report report;
+    model.OptimizeMeshes(&report);
+
+    std::string text = filename + " (FIFO " + std::to_string(meshOptimizerOptions.cacheSize) + ")\n" + report.ToString();
+    return text;
+}
+
+std::string InterleavedGltfModel::ReportLods(const std::string& filename, Mode mode)
+{
+    InterleavedGltfModel model;
+    std::string error;
+    if (!FetchVerticesOnly(filename, mode, model, error))
+    {
+        return filename + " : " + error + "\n";
+    }
+    // LbVƓʎqEבւ̌ɍ
+    model.QuantizeVertices();
+    model.OptimizeMeshes();
+    MeshSimplifier::Report report;
+    model.GenerateLods(&report);
+
+    std::string text = filename + " (LOD " + std::to_string(meshSimplifierOptions.levelCount) + ", reduction " + std::to_string(meshSimplifierOptions.reduction) + ")\n" + report.ToString();
+    return text;
+}
+
+std::string InterleavedGltfModel::ReportMeshlets(const std::string& filename, Mode mode)
+{
+    InterleavedGltfModel model;
+    std::string error;
+    if (!FetchVerticesOnly(filename, mode, model, error))
+    {
+        return filename + " : " + error + "\n";
+    }
+    // LbVƓʎqEבւELOD ̌ɕ
+    model.QuantizeVertices();
+    model.OptimizeMeshes();
+    model.GenerateLods();
+    MeshletBuilder::Report report;
+    model.GenerateMeshlets(&report);
+
+    std::string text = filename + " (meshlet " + std::to_string(meshletBuilderOptions.maxVertices) + " verts / " + std::to_string(meshletBuilderOptions.maxTriangles) + " tris)\n" + report.ToString();
+    return text;
+}
+
+bool InterleavedGltfModel::ValidateCacheFile(const std::string& filename, Mode mode, std::string& report)
+{
+    return MappedCache::ValidateFile(GetCacheFilename(filename, mode), report);
+}
+
+std::string InterleavedGltfModel::BenchmarkCacheLoad(const std::string& filename, Mode mode, int iterations)
+{
+    std::filesystem::path cerealFilename(filename);
+    cerealFilename.replace_extension(IsBatchMode(mode) ? "batchCereal" : "cereal");
+    const std::filesystem::path cacheFilename = GetCacheFilename(filename, mode);
+    if (!std::filesystem::exists(cerealFilename) || !std::filesystem::exists(cacheFilename))
+    {
+        return filename + " : both " + cerealFilename.filename().string() + " and " + cacheFilename.filename().string() + " are required\n";
+    }
+    iterations = (std::max)(iterations, 1);
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    // ǂݍłj܂ł̕ώ
+    auto measure = [&](const std::function<void(InterleavedGltfModel&)>& load) -> double
+        {
+            double totalMilliseconds = 0.0;
+            for (int i = 0; i < iterations; ++i)
+            {
+                LARGE_INTEGER begin, end;
+                QueryPerformanceCounter(&begin);
+                {
+                    InterleavedGltfModel model;
+                    model.mode = mode;
+                    load(model);
+                }
+                QueryPerformanceCounter(&end);
+                totalMilliseconds += static_cast<double>(end.QuadPart - begin.QuadPart) * 1000.0 / static_cast<double>(frequency.QuadPart);
+            }
+            return totalMilliseconds / iterations;
+        };
+
+    const double cerealMilliseconds = measure([&](InterleavedGltfModel& model)
+        {
+            std::ifstream ifs(cerealFilename, std::ios::binary);
+            model.LoadCerealCache(ifs);
+        });
+    const double mappedMilliseconds = measure([&](InterleavedGltfModel& model) { model.LoadMappedCache(cacheFilename); });
+    // _f[^cꍇ (isSaveVerticesData) ͒_ƃCfbNXRs[
+    const double mappedCopyMilliseconds = measure([&](InterleavedGltfModel& model)
+        {
+            model.isSaveVerticesData = true;
+            model.LoadMappedCache(cacheFilename);
+        });
+
+    char buf[1024];
+    sprintf_s(buf, "%s (%d iterations)\n  cereal             : %8.3f ms (%llu bytes)\n  mapped             : %8.3f ms (%llu bytes)\n  mapped + vertices  : %8.3f ms\n",
+        filename.c_str(), iterations,
+        cerealMilliseconds, static_cast<unsigned long long>(std::filesystem::file_size(cerealFilename)),
+        mappedMilliseconds, static_cast<unsigned long long>(std::filesystem::file_size(cacheFilename)),
+        mappedCopyMilliseconds);
+    return buf;
+}
+
 void InterleavedGltfModel::FetchNodes(const tinygltf::Model& gltfModel)
 {
     for (const tinygltf::Node& gltfNode : gltfModel.nodes)
@@ -189,6 +989,34 @@ void InterleavedGltfModel::FetchNodes(const tinygltf::Model& gltfModel)
     CumulateTransforms(nodes);
 }
 
+void InterleavedGltfModel::ComputeLocalBounds()
+{
+    using namespace DirectX;
+
+    XMVECTOR minVec = XMVectorSet(FLT_MAX, FLT_MAX, FLT_MAX, 0.0f);
+    XMVECTOR maxVec = XMVectorSet(-FLT_MAX, -FLT_MAX, -FLT_MAX, 0.0f);
+    if (IsBatchMode(mode))
+    {// ob`̒_̓fԂɏĂݍς
+        for (const BatchMesh& batchMesh : batchMeshes)
+        {
+            for (size_t vertexIndex = 0; vertexIndex < batchMesh.VertexCount(); ++vertexIndex)
+            {
+                const XMFLOAT3 position = batchMesh.GetPosition(vertexIndex);
+                const XMVECTOR pos = XMLoadFloat3(&position);
+                minVec = XMVectorMin(minVec, pos);
+                maxVec = XMVectorMax(maxVec, pos);
+            }
+        }
+        XMStoreFloat3(&localBounds.min, minVec);
+        XMStoreFloat3(&localBounds.max, maxVec);
+    }
+    else
+    {
+        localBounds = GetAABB();
+    }
+    hasLocalBounds = localBounds.min.x <= localBounds.max.x && localBounds.max.x < FLT_MAX && localBounds.min.x > -FLT_MAX;
+}
+
 AABB InterleavedGltfModel::GetAABB()const
 {
     using namespace DirectX;
@@ -351,9 +1179,11 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
             }
 
             // Create index buffer view
+            // U Vertex ɓWJāAŌɗʎqÕtH[}bgŋl߂ (QuantizeVertices őIђ)
+            std::vector<Mesh::Vertex> vertices;
             if (gltfPrimitive.attributes.size() > 0 && gltfPrimitive.attributes.find("POSITION") != gltfPrimitive.attributes.end())
             {
-                primitive.cachedVertices.resize(gltfModel.accessors.at(gltfPrimitive.attributes.at("POSITION")).count);
+                vertices.resize(gltfModel.accessors.at(gltfPrimitive.attributes.at("POSITION")).count);
             }
             else
             {
@@ -370,43 +1200,43 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                 if (gltfAttribute.first == "POSITION")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
-                    unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->position);
+                    unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->position);
                     _Copy<DirectX::XMFLOAT3>(dData, dStride, sData, sStride, count);
                 }
                 else if (gltfAttribute.first == "NORMAL")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
-                    unsigned char* d_data = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->normal);
+                    unsigned char* d_data = reinterpret_cast<unsigned char*>(&vertices.data()->normal);
                     _Copy<DirectX::XMFLOAT3>(d_data, dStride, sData, sStride, count);
                 }
                 else if (gltfAttribute.first == "TANGENT")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
-                    unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->tangent);
+                    unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->tangent);
                     _Copy<DirectX::XMFLOAT4>(dData, dStride, sData, sStride, count);
                 }
                 else if (gltfAttribute.first == "TEXCOORD_0")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
-                    unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->texcoord);
+                    unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->texcoord);
                     _Copy<DirectX::XMFLOAT2>(dData, dStride, sData, sStride, count);
                 }
                 else if (gltfAttribute.first == "JOINTS_0")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
                     if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
                     {
-                        unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->joints0);
+                        unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->joints0);
                         _Copy<DirectX::XMINT4>(dData, dStride, sData, sStride, count);
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
@@ -414,10 +1244,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const USHORT* data = reinterpret_cast<const USHORT*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).joints0.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
-                            primitive.cachedVertices.at(accessorIndex).joints0.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
-                            primitive.cachedVertices.at(accessorIndex).joints0.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
-                            primitive.cachedVertices.at(accessorIndex).joints0.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
+                            vertices.at(accessorIndex).joints0.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
+                            vertices.at(accessorIndex).joints0.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
+                            vertices.at(accessorIndex).joints0.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
+                            vertices.at(accessorIndex).joints0.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
                         }
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
@@ -425,10 +1255,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const BYTE* data = reinterpret_cast<const BYTE*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).joints0.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
-                            primitive.cachedVertices.at(accessorIndex).joints0.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
-                            primitive.cachedVertices.at(accessorIndex).joints0.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
-                            primitive.cachedVertices.at(accessorIndex).joints0.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
+                            vertices.at(accessorIndex).joints0.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
+                            vertices.at(accessorIndex).joints0.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
+                            vertices.at(accessorIndex).joints0.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
+                            vertices.at(accessorIndex).joints0.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
                         }
                     }
                     else
@@ -439,11 +1269,11 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                 else if (gltfAttribute.first == "JOINTS_1")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
                     if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT)
                     {
-                        unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->joints1);
+                        unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->joints1);
                         _Copy<DirectX::XMINT4>(dData, dStride, sData, sStride, count);
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
@@ -451,10 +1281,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const USHORT* data = reinterpret_cast<const USHORT*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).joints1.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
-                            primitive.cachedVertices.at(accessorIndex).joints1.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
-                            primitive.cachedVertices.at(accessorIndex).joints1.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
-                            primitive.cachedVertices.at(accessorIndex).joints1.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
+                            vertices.at(accessorIndex).joints1.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
+                            vertices.at(accessorIndex).joints1.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
+                            vertices.at(accessorIndex).joints1.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
+                            vertices.at(accessorIndex).joints1.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
                         }
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
@@ -462,10 +1292,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const BYTE* data = reinterpret_cast<const BYTE*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).joints1.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
-                            primitive.cachedVertices.at(accessorIndex).joints1.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
-                            primitive.cachedVertices.at(accessorIndex).joints1.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
-                            primitive.cachedVertices.at(accessorIndex).joints1.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
+                            vertices.at(accessorIndex).joints1.x = static_cast<UINT>(data[accessorIndex * 4 + 0]);
+                            vertices.at(accessorIndex).joints1.y = static_cast<UINT>(data[accessorIndex * 4 + 1]);
+                            vertices.at(accessorIndex).joints1.z = static_cast<UINT>(data[accessorIndex * 4 + 2]);
+                            vertices.at(accessorIndex).joints1.w = static_cast<UINT>(data[accessorIndex * 4 + 3]);
                         }
                     }
                     else
@@ -476,11 +1306,11 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                 if (gltfAttribute.first == "WEIGHTS_0")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
                     if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT)
                     {
-                        unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->weights0);
+                        unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->weights0);
                         _Copy<DirectX::XMFLOAT4>(dData, dStride, sData, sStride, count);
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
@@ -489,10 +1319,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const USHORT* data = reinterpret_cast<const USHORT*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).weights0.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFFFF;
-                            primitive.cachedVertices.at(accessorIndex).weights0.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFFFF;
-                            primitive.cachedVertices.at(accessorIndex).weights0.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFFFF;
-                            primitive.cachedVertices.at(accessorIndex).weights0.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights0.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights0.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights0.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights0.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFFFF;
                         }
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
@@ -501,10 +1331,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const BYTE* data = reinterpret_cast<const BYTE*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).weights0.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFF;
-                            primitive.cachedVertices.at(accessorIndex).weights0.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFF;
-                            primitive.cachedVertices.at(accessorIndex).weights0.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFF;
-                            primitive.cachedVertices.at(accessorIndex).weights0.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFF;
+                            vertices.at(accessorIndex).weights0.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFF;
+                            vertices.at(accessorIndex).weights0.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFF;
+                            vertices.at(accessorIndex).weights0.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFF;
+                            vertices.at(accessorIndex).weights0.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFF;
                         }
                     }
                     else
@@ -515,11 +1345,11 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                 else if (gltfAttribute.first == "WEIGHTS_1")
                 {
                     const size_t count = gltfAccessor.count;
-                    _ASSERT_EXPR(count == primitive.cachedVertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
+                    _ASSERT_EXPR(count == vertices.size(), L"The number of components on all vertices comprising the mesh must be the same.");
 
                     if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT)
                     {
-                        unsigned char* dData = reinterpret_cast<unsigned char*>(&primitive.cachedVertices.data()->weights1);
+                        unsigned char* dData = reinterpret_cast<unsigned char*>(&vertices.data()->weights1);
                         _Copy<DirectX::XMFLOAT4>(dData, dStride, sData, sStride, count);
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT)
@@ -528,10 +1358,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const USHORT* data = reinterpret_cast<const USHORT*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).weights1.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFFFF;
-                            primitive.cachedVertices.at(accessorIndex).weights1.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFFFF;
-                            primitive.cachedVertices.at(accessorIndex).weights1.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFFFF;
-                            primitive.cachedVertices.at(accessorIndex).weights1.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights1.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights1.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights1.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFFFF;
+                            vertices.at(accessorIndex).weights1.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFFFF;
                         }
                     }
                     else if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
@@ -540,10 +1370,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                         const BYTE* data = reinterpret_cast<const BYTE*>(gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset);
                         for (size_t accessorIndex = 0; accessorIndex < gltfAccessor.count; ++accessorIndex)
                         {
-                            primitive.cachedVertices.at(accessorIndex).weights1.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFF;
-                            primitive.cachedVertices.at(accessorIndex).weights1.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFF;
-                            primitive.cachedVertices.at(accessorIndex).weights1.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFF;
-                            primitive.cachedVertices.at(accessorIndex).weights1.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFF;
+                            vertices.at(accessorIndex).weights1.x = static_cast<FLOAT>(data[accessorIndex * 4 + 0]) / 0xFF;
+                            vertices.at(accessorIndex).weights1.y = static_cast<FLOAT>(data[accessorIndex * 4 + 1]) / 0xFF;
+                            vertices.at(accessorIndex).weights1.z = static_cast<FLOAT>(data[accessorIndex * 4 + 2]) / 0xFF;
+                            vertices.at(accessorIndex).weights1.w = static_cast<FLOAT>(data[accessorIndex * 4 + 3]) / 0xFF;
                         }
                     }
                     else
@@ -557,7 +1387,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                 }
                 primitive.attributes.emplace(gltfAttribute.first, _DxgiFormat(gltfAccessor));
             }
-            primitive.vertexBufferView.sizeInBytes = static_cast<UINT>(primitive.cachedVertices.size() * sizeof(Mesh::Vertex));
+            primitive.vertexFormat = VertexFormat::FullPrecision(true);
+            primitive.cachedVertices = VertexFormatBuilder::Encode(primitive.vertexFormat, VertexFormatBuilder::ToAttributes(vertices));
+            primitive.vertexBufferView.sizeInBytes = static_cast<UINT>(primitive.cachedVertices.size());
+            primitive.vertexBufferView.strideInBytes = primitive.vertexFormat.Stride();
 
         }
     }
@@ -581,9 +1414,10 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
                     OutputDebugStringA(("primitive empty: mesh=" + std::to_string(node.mesh) + "\n").c_str());
                     continue;
                 }
-                for (const auto& vertex : primitive.cachedVertices)
+                for (size_t vertexIndex = 0; vertexIndex < primitive.VertexCount(); ++vertexIndex)
                 {
-                    DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(&vertex.position);
+                    const DirectX::XMFLOAT3 position = primitive.GetPosition(vertexIndex);
+                    DirectX::XMVECTOR pos = DirectX::XMLoadFloat3(&position);
                     minVec = DirectX::XMVectorMin(minVec, pos);
                     maxVec = DirectX::XMVectorMax(maxVec, pos);
                 }
@@ -606,6 +1440,8 @@ void InterleavedGltfModel::FetchMeshes(ID3D11Device* device, const tinygltf::Mod
 void InterleavedGltfModel::FetchAndBatchMeshes(ID3D11Device* device, const tinygltf::Model& gltfModel)
 {
     batchMeshes.resize(gltfModel.materials.size());
+    // }eAƂɑSm[h̒_W߂Ăl߂
+    std::vector<std::vector<BatchMesh::Vertex>> batchMeshVertices(batchMeshes.size());
 
     std::function<void(int)> traverse = [&](int node_index)->void {
         const Node& node = nodes.at(node_index);
@@ -626,6 +1462,7 @@ void InterleavedGltfModel::FetchAndBatchMeshes(ID3D11Device* device, const tinyg
 #endif
 
                 BatchMesh& batchMesh = batchMeshes.at(gltfPrimitive.material);
+                std::vector<BatchMesh::Vertex>& batchVertices = batchMeshVertices.at(gltfPrimitive.material);
                 batchMesh.material = gltfPrimitive.material;
                 batchMesh.indexBufferView.format = DXGI_FORMAT_R32_UINT;
                 if (gltfPrimitive.indices > -1)
@@ -634,7 +1471,7 @@ void InterleavedGltfModel::FetchAndBatchMeshes(ID3D11Device* device, const tinyg
                     const tinygltf::BufferView& gltfBufferView = gltfModel.bufferViews.at(gltfAccessor.bufferView);
 
                     std::vector<UINT> cachedIndices(gltfAccessor.count);
-                    const size_t vertexOffset = batchMesh.cachedVertices.size();
+                    const size_t vertexOffset = batchVertices.size();
                     if (gltfAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
                     {
                         const BYTE* data = gltfModel.buffers.at(gltfBufferView.buffer).data.data() + gltfBufferView.byteOffset + gltfAccessor.byteOffset;
@@ -726,8 +1563,7 @@ void InterleavedGltfModel::FetchAndBatchMeshes(ID3D11Device* device, const tinyg
                     cachedVertex.tangent.w = sigma;
                 }
 
-                batchMesh.cachedVertices.insert(batchMesh.cachedVertices.end(), cachedVertices.begin(), cachedVertices.end());
-                batchMesh.vertexBufferView.sizeInBytes += static_cast<UINT>(cachedVertices.size() * sizeof(BatchMesh::Vertex));
+                batchVertices.insert(batchVertices.end(), cachedVertices.begin(), cachedVertices.end());
             }
         }
         for (std::vector<int>::value_type childIndex : node.children)
@@ -739,6 +1575,16 @@ void InterleavedGltfModel::FetchAndBatchMeshes(ID3D11Device* device, const tinyg
     {
         traverse(nodeIndex);
     }
+
+    // ʎqÕtH[}bgŋl߂ (QuantizeVertices őIђ)
+    for (size_t materialIndex = 0; materialIndex < batchMeshes.size(); ++materialIndex)
+    {
+        BatchMesh& batchMesh = batchMeshes.at(materialIndex);
+        batchMesh.vertexFormat = VertexFormat::FullPrecision(false);
+        batchMesh.cachedVertices = VertexFormatBuilder::Encode(batchMesh.vertexFormat, VertexFormatBuilder::ToAttributes(batchMeshVertices.at(materialIndex)));
+        batchMesh.vertexBufferView.sizeInBytes = static_cast<UINT>(batchMesh.cachedVertices.size());
+        batchMesh.vertexBufferView.strideInBytes = batchMesh.vertexFormat.Stride();
+    }
 }
 
 void InterleavedGltfModel::FetchMaterials(ID3D11Device* device, const tinygltf::Model& gltfModel)
@@ -1083,15 +1929,17 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
                 bufferDesc.CPUAccessFlags = 0;
                 bufferDesc.MiscFlags = 0;
                 bufferDesc.StructureByteStride = 0;
-                subresourceData.pSysMem = batchMesh.cachedIndices.data();
+                subresourceData.pSysMem = batchMesh.cachedIndices.empty() ? batchMesh.mappedIndices : batchMesh.cachedIndices.data();
                 subresourceData.SysMemPitch = 0;
                 subresourceData.SysMemSlicePitch = 0;
                 hr = device->CreateBuffer(&bufferDesc, &subresourceData, buffers.emplace_back().GetAddressOf());
+                gpuBufferBytes += bufferDesc.ByteWidth;
                 _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
                 if (!isSaveVerticesData)
                 {
                     batchMesh.cachedIndices.clear();
                 }
+                batchMesh.mappedIndices = nullptr;
             }
 
             if (batchMesh.vertexBufferView.sizeInBytes > 0)
@@ -1103,15 +1951,17 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
                 bufferDesc.CPUAccessFlags = 0;
                 bufferDesc.MiscFlags = 0;
                 bufferDesc.StructureByteStride = 0;
-                subresourceData.pSysMem = batchMesh.cachedVertices.data();
+                subresourceData.pSysMem = batchMesh.cachedVertices.empty() ? batchMesh.mappedVertices : batchMesh.cachedVertices.data();
                 subresourceData.SysMemPitch = 0;
                 subresourceData.SysMemSlicePitch = 0;
                 hr = device->CreateBuffer(&bufferDesc, &subresourceData, buffers.emplace_back().GetAddressOf());
+                gpuBufferBytes += bufferDesc.ByteWidth;
                 _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
                 if (!isSaveVerticesData)
                 {
                     batchMesh.cachedVertices.clear();
                 }
+                batchMesh.mappedVertices = nullptr;
             }
         }
     }
@@ -1130,15 +1980,17 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
                     bufferDesc.CPUAccessFlags = 0;
                     bufferDesc.MiscFlags = 0;
                     bufferDesc.StructureByteStride = 0;
-                    subresourceData.pSysMem = primitive.cachedIndices.data();
+                    subresourceData.pSysMem = primitive.cachedIndices.empty() ? primitive.mappedIndices : primitive.cachedIndices.data();
                     subresourceData.SysMemPitch = 0;
                     subresourceData.SysMemSlicePitch = 0;
                     hr = device->CreateBuffer(&bufferDesc, &subresourceData, buffers.emplace_back().GetAddressOf());
+                    gpuBufferBytes += bufferDesc.ByteWidth;
                     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
                     if (!isSaveVerticesData)
                     {
                         primitive.cachedIndices.clear();
                     }
+                    primitive.mappedIndices = nullptr;
                 }
 
                 if (primitive.vertexBufferView.sizeInBytes > 0)
@@ -1152,15 +2004,17 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
                     bufferDesc.CPUAccessFlags = 0;
                     bufferDesc.MiscFlags = 0;
                     bufferDesc.StructureByteStride = 0;
-                    subresourceData.pSysMem = primitive.cachedVertices.data();
+                    subresourceData.pSysMem = primitive.cachedVertices.empty() ? primitive.mappedVertices : primitive.cachedVertices.data();
                     subresourceData.SysMemPitch = 0;
                     subresourceData.SysMemSlicePitch = 0;
                     hr = device->CreateBuffer(&bufferDesc, &subresourceData, buffers.emplace_back().GetAddressOf());
+                    gpuBufferBytes += bufferDesc.ByteWidth;
                     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
                     if (!isSaveVerticesData)
                     {
                         primitive.cachedVertices.clear();
                     }
+                    primitive.mappedVertices = nullptr;
                 }
             }
         }
@@ -1177,7 +2031,7 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
         bufferDesc.Usage = D3D11_USAGE_DEFAULT;
         bufferDesc.CPUAccessFlags = 0;
 #endif
-        bufferDesc.ByteWidth = static_cast<UINT>(sizeof(DirectX::XMFLOAT4X4) * 1000);
+        bufferDesc.ByteWidth = static_cast<UINT>(sizeof(DirectX::XMFLOAT4X4) * instanceCapacity_);
         bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         //D3D11_SUBRESOURCE_DATA subresourceData = {};
         //subresourceData.pSysMem = instanceMatrices_.data();
@@ -1214,15 +2068,20 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
     // Create and upload textures on GPU
     for (Image& image : images)
     {
-        if (image.cacheData.size() > 0)
+        // LbV}bv摜̓Rs[ɂ̂܂ܓn
+        const unsigned char* imageData = image.cacheData.empty() ? image.mappedData : image.cacheData.data();
+        const size_t imageSize = image.cacheData.empty() ? image.mappedSize : image.cacheData.size();
+        if (imageSize > 0)
         {
             ID3D11ShaderResourceView* textureResourceView = NULL;
-            hr = LoadTextureFromMemory(device, image.cacheData.data(), image.cacheData.size(), &textureResourceView);
+            hr = LoadTextureFromMemory(device, imageData, imageSize, &textureResourceView);
             if (hr == S_OK)
             {
                 textureResourceViews.emplace_back().Attach(textureResourceView);
             }
             image.cacheData.clear();
+            image.mappedData = nullptr;
+            image.mappedSize = 0;
         }
         else
         {
@@ -1237,16 +2096,12 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
         }
     }
 
+    // ̓CAEg͒_tH[}bgƂɍ (CreateInputLayouts)
+    const char* vertexShaderName = nullptr;
     if (mode == Mode::StaticMesh)
     {
-        D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
-        hr = CreateVsFromCSO(device, "./Shader/GltfModelStaticBatchingVS.cso", vertexShader.ReleaseAndGetAddressOf(), inputLayout.ReleaseAndGetAddressOf(), inputElementDesc, _countof(inputElementDesc));
+        vertexShaderName = "./Shader/GltfModelStaticBatchingVS.cso";
+        hr = CreateVsFromCSO(device, vertexShaderName, vertexShader.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
         hr = CreateVsFromCSO(device, "./Shader/GltfModelStaticBatchingCsmVS.cso", vertexShaderCSM.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
@@ -1254,43 +2109,38 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
     }
     else if (mode == Mode::SkeltalMesh)
     {
-        D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "JOINTS", 0, DXGI_FORMAT_R32G32B32A32_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "JOINTS", 1, DXGI_FORMAT_R32G32B32A32_UINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "WEIGHTS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "WEIGHTS", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        };
-        hr = CreateVsFromCSO(device, "./Shader/GltfModelVS.cso", vertexShader.ReleaseAndGetAddressOf(), inputLayout.ReleaseAndGetAddressOf(), inputElementDesc, _countof(inputElementDesc));
+        vertexShaderName = "./Shader/GltfModelVS.cso";
+        hr = CreateVsFromCSO(device, vertexShaderName, vertexShader.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
         //hr = CreateVsFromCSO(device, "./Shader/GltfModelCsmVS.cso", vertexShaderCSM.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         hr = CreateVsFromCSO(device, "./Shader/ElasticBuildingCsmVS.cso", vertexShaderCSM.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 
+        // JOINTS / WEIGHTS Ȃ (4 eȂ) _tH[}bg 1 ԃXbg̊lǂ
+        bufferDesc.ByteWidth = sizeof(VertexFormat::SkinDefaults);
+        bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+        bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        bufferDesc.CPUAccessFlags = 0;
+        bufferDesc.MiscFlags = 0;
+        bufferDesc.StructureByteStride = 0;
+        subresourceData.pSysMem = VertexFormat::SkinDefaults;
+        subresourceData.SysMemPitch = 0;
+        subresourceData.SysMemSlicePitch = 0;
+        hr = device->CreateBuffer(&bufferDesc, &subresourceData, skinDefaultsBuffer.ReleaseAndGetAddressOf());
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
     }
     else if (mode == Mode::InstancedStaticMesh)
     {
-        D3D11_INPUT_ELEMENT_DESC instancedStaticMeshInputElementDesc[] =
-        {
-            { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-
-            { "INSTANCE_MATRIX", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_MATRIX", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_MATRIX", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_MATRIX", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
-        };
-        hr = CreateVsFromCSO(device, "./Shader/GltfModelInstancedBatchingVS.cso", vertexShader.ReleaseAndGetAddressOf(), inputLayout.ReleaseAndGetAddressOf(), instancedStaticMeshInputElementDesc, _countof(instancedStaticMeshInputElementDesc));
+        vertexShaderName = "./Shader/GltfModelInstancedBatchingVS.cso";
+        hr = CreateVsFromCSO(device, vertexShaderName, vertexShader.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
         hr = CreateVsFromCSO(device, "./Shader/GltfModelInstancedBatchingCsmVS.cso", vertexShaderCSM.ReleaseAndGetAddressOf(), NULL, NULL, 0);
         _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
     }
+    if (vertexShaderName)
+    {
+        CreateInputLayouts(device, vertexShaderName);
+    }
 
     hr = CreatePsFromCSO(device, "./Shader/GltfModelPS.cso", pixelShader.ReleaseAndGetAddressOf());
     //hr = CreatePsFromCSO(device, "./Shader/GltfModelDeferredPS.cso", pixelShader.ReleaseAndGetAddressOf());
@@ -1319,7 +2169,63 @@ void InterleavedGltfModel::CreateAndUploadResources(ID3D11Device* device)
 }
 
 
-void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world, const std::vector<Node>& animated_nodes, RenderPass pass, const PipeLineStateDesc& pipeline)
+void InterleavedGltfModel::CreateInputLayouts(ID3D11Device* device, const char* vertexShaderName)
+{
+    std::vector<VertexFormat> vertexFormats;
+    for (const Mesh& mesh : meshes)
+    {
+        for (const Mesh::Primitive& primitive : mesh.primitives)
+        {
+            vertexFormats.push_back(primitive.vertexFormat);
+        }
+    }
+    for (const BatchMesh& batchMesh : batchMeshes)
+    {
+        vertexFormats.push_back(batchMesh.vertexFormat);
+    }
+
+    for (const VertexFormat& format : vertexFormats)
+    {
+        Microsoft::WRL::ComPtr<ID3D11InputLayout>& inputLayout = inputLayouts[format.LayoutKey()];
+        if (inputLayout)
+        {
+            continue;
+        }
+        std::vector<D3D11_INPUT_ELEMENT_DESC> inputElementDesc;
+        format.MakeInputElements(inputElementDesc, mode == Mode::SkeltalMesh, 1);
+        if (mode == Mode::InstancedStaticMesh)
+        {
+            inputElementDesc.push_back({ "INSTANCE_MATRIX", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+            inputElementDesc.push_back({ "INSTANCE_MATRIX", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+            inputElementDesc.push_back({ "INSTANCE_MATRIX", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+            inputElementDesc.push_back({ "INSTANCE_MATRIX", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 });
+        }
+        HRESULT hr = CreateInputLayoutFromCSO(device, vertexShaderName, inputLayout.GetAddressOf(), inputElementDesc.data(), static_cast<UINT>(inputElementDesc.size()));
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    }
+}
+
+ID3D11InputLayout* InterleavedGltfModel::GetInputLayout(const VertexFormat& format) const
+{
+    auto it = inputLayouts.find(format.LayoutKey());
+    _ASSERT_EXPR(it != inputLayouts.end(), L"No input layout for this vertex format.");
+    return it->second.Get();
+}
+
+void InterleavedGltfModel::BindVertexBuffer(ID3D11DeviceContext* immediateContext, const VertexFormat& format, int buffer) const
+{
+    immediateContext->IASetInputLayout(GetInputLayout(format));
+    UINT stride = format.Stride();
+    UINT offset = 0;
+    immediateContext->IASetVertexBuffers(0, 1, buffers.at(buffer).GetAddressOf(), &stride, &offset);
+    if (skinDefaultsBuffer && format.influenceSets < 2)
+    {
+        UINT defaultsStride = sizeof(VertexFormat::SkinDefaults);
+        immediateContext->IASetVertexBuffers(1, 1, skinDefaultsBuffer.GetAddressOf(), &defaultsStride, &offset);
+    }
+}
+
+void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world, const std::vector<Node>& animated_nodes, RenderPass pass, const PipeLineStateDesc& pipeline, const InstanceParameters& instance)
 {
     if (mode == Mode::StaticMesh)
     {
@@ -1327,7 +2233,7 @@ void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const D
     }
     else if (mode == Mode::InstancedStaticMesh)
     {
-        return InstancedStaticBatchRender(immediateContext/*, world*/, pass, pipeline);
+        return InstancedStaticBatchRender(immediateContext/*, world*/, pass, pipeline, instance);
     }
     const std::vector<Node>& nodes = animated_nodes.size() > 0 ? animated_nodes : InterleavedGltfModel::nodes;
 
@@ -1335,7 +2241,6 @@ void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const D
 
     immediateContext->VSSetShader(pipeline.vertexShader ? pipeline.vertexShader.Get() : vertexShader.Get(), nullptr, 0);
     //immediateContext->PSSetShader(pipeline.pixelShader ? pipeline.pixelShader.Get() : pixelShader.Get(), nullptr, 0);
-    immediateContext->IASetInputLayout(inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     std::function<void(int)> traverse = [&](int nodeIndex)->void {
@@ -1359,20 +2264,23 @@ void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const D
         if (node.mesh > -1)
         {
             const Mesh& mesh = meshes.at(node.mesh);
-            for (const Mesh::Primitive& primitive : mesh.primitives)
+            for (int primitiveIndex = 0; primitiveIndex < static_cast<int>(mesh.primitives.size()); ++primitiveIndex)
             {
+                const Mesh::Primitive& primitive = mesh.primitives.at(primitiveIndex);
+                // CX^XƂɍւꂽ}eA
+                const int materialIndex = instance.GetPrimitiveMaterial(node.mesh, primitiveIndex, primitive.material);
+
                 // INTERLEAVED_GLTF_MODEL
-                UINT stride = sizeof(Mesh::Vertex);
-                UINT offset = 0;
-                immediateContext->IASetVertexBuffers(0, 1, buffers.at(primitive.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+                BindVertexBuffer(immediateContext, primitive.vertexFormat, primitive.vertexBufferView.buffer);
 
                 PrimitiveConstants primitiveData = {};
-                primitiveData.material = primitive.material;
+                primitive.vertexFormat.SetShaderConstants(primitiveData);
+                primitiveData.material = materialIndex;
                 primitiveData.hasTangent = primitive.has("TANGENT");
                 primitiveData.skin = node.skin;
-                primitiveData.color = { cpuColor.x,cpuColor.y,cpuColor.z,alpha };
-                primitiveData.emission = emission;
-                primitiveData.disolveFactor = disolveFactor;
+                primitiveData.color = { instance.cpuColor.x,instance.cpuColor.y,instance.cpuColor.z,instance.alpha };
+                primitiveData.emission = instance.emission;
+                primitiveData.disolveFactor = instance.disolveFactor;
                 // ŃfWnϊH
                 //Wn̕ϊs
                 const DirectX::XMFLOAT4X4 coordinateSystemTransforms[]
@@ -1422,7 +2330,7 @@ void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const D
 
                 //int currentMaterialIndex = primitive.GetCurrentMaterialIndex();
                 //auto& material = materials[currentMaterialIndex];
-                const Material& material = materials.at(primitive.material);
+                const Material& material = materials.at(materialIndex);
                 //Őݒ
                 if (material.replacedPixelShader)
                 {
@@ -1486,7 +2394,7 @@ void InterleavedGltfModel::Render(ID3D11DeviceContext* immediateContext, const D
                 {
                     // INTERLEAVED_GLTF_MODEL
                     immediateContext->IASetIndexBuffer(buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
-                    immediateContext->DrawIndexed(primitive.indexBufferView.sizeInBytes / _SizeofComponent(primitive.indexBufferView.format), 0, 0);
+                    immediateContext->DrawIndexed(primitive.GetLod(0).indexCount, 0, 0);
                 }
                 else
                 {
@@ -1514,16 +2422,14 @@ void InterleavedGltfModel::BatchRender(ID3D11DeviceContext* immediateContext, co
 
     immediateContext->VSSetShader(pipeline.vertexShader ? pipeline.vertexShader.Get() : vertexShader.Get(), nullptr, 0);
     immediateContext->PSSetShader(pipeline.pixelShader ? pipeline.pixelShader.Get() : pixelShader.Get(), nullptr, 0);
-    immediateContext->IASetInputLayout(inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     for (const BatchMesh& batchMesh : batchMeshes)
     {
-        UINT stride = sizeof(BatchMesh::Vertex);
-        UINT offset = 0;
-        immediateContext->IASetVertexBuffers(0, 1, buffers.at(batchMesh.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+        BindVertexBuffer(immediateContext, batchMesh.vertexFormat, batchMesh.vertexBufferView.buffer);
 
         PrimitiveConstants primitiveData = {};
+        batchMesh.vertexFormat.SetShaderConstants(primitiveData);
         primitiveData.material = batchMesh.material;
         primitiveData.hasTangent = batchMesh.has("TANGENT");
         primitiveData.skin = -1;
@@ -1626,7 +2532,7 @@ void InterleavedGltfModel::BatchRender(ID3D11DeviceContext* immediateContext, co
         if (batchMesh.indexBufferView.buffer > -1)
         {
             immediateContext->IASetIndexBuffer(buffers.at(batchMesh.indexBufferView.buffer).Get(), batchMesh.indexBufferView.format, 0);
-            immediateContext->DrawIndexed(batchMesh.indexBufferView.sizeInBytes / _SizeofComponent(batchMesh.indexBufferView.format), 0, 0);
+            immediateContext->DrawIndexed(batchMesh.GetLod(0).indexCount, 0, 0);
         }
         else
         {
@@ -1635,7 +2541,35 @@ void InterleavedGltfModel::BatchRender(ID3D11DeviceContext* immediateContext, co
     }
 }
 
-void InterleavedGltfModel::InstancedStaticBatchRender(ID3D11DeviceContext* immediateContext/*, const DirectX::XMFLOAT4X4& world*/, RenderPass pass, const PipeLineStateDesc& pipeline)
+void InterleavedGltfModel::UpdateInstances(ID3D11DeviceContext* immediateContext, const std::vector<DirectX::XMFLOAT4X4>& matrices)
+{
+    _ASSERT_EXPR(mode == Mode::InstancedStaticMesh, L"This function only works with instance_static_batching data.");
+
+    HRESULT hr = S_OK;
+    if (matrices.size() > instanceCapacity_)
+    {
+        while (instanceCapacity_ < matrices.size())
+        {
+            instanceCapacity_ *= 2;
+        }
+        Microsoft::WRL::ComPtr<ID3D11Device> device;
+        immediateContext->GetDevice(device.GetAddressOf());
+        D3D11_BUFFER_DESC bufferDesc = {};
+        instanceBuffer->GetDesc(&bufferDesc);
+        bufferDesc.ByteWidth = static_cast<UINT>(sizeof(DirectX::XMFLOAT4X4) * instanceCapacity_);
+        hr = device->CreateBuffer(&bufferDesc, NULL, instanceBuffer.ReleaseAndGetAddressOf());
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedSubresource = {};
+    hr = immediateContext->Map(instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+    _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    memcpy_s(mappedSubresource.pData, sizeof(DirectX::XMFLOAT4X4) * instanceCapacity_, matrices.data(), sizeof(DirectX::XMFLOAT4X4) * matrices.size());
+    immediateContext->Unmap(instanceBuffer.Get(), 0);
+    instanceCount_ = static_cast<int>(matrices.size());
+}
+
+void InterleavedGltfModel::InstancedStaticBatchRender(ID3D11DeviceContext* immediateContext/*, const DirectX::XMFLOAT4X4& world*/, RenderPass pass, const PipeLineStateDesc& pipeline, const InstanceParameters& instance)
 {
     _ASSERT_EXPR(mode == Mode::InstancedStaticMesh, L"This function only works with instance_static_batching data.");
 
@@ -1643,7 +2577,6 @@ void InterleavedGltfModel::InstancedStaticBatchRender(ID3D11DeviceContext* immed
 
     immediateContext->VSSetShader(pipeline.vertexShader ? pipeline.vertexShader.Get() : vertexShader.Get(), nullptr, 0);
     immediateContext->PSSetShader(pipeline.pixelShader ? pipeline.pixelShader.Get() : pixelShader.Get(), nullptr, 0);
-    immediateContext->IASetInputLayout(inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     //immediateContext->IASetVertexBuffers(1, 1, buffers.at(batchMesh.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
@@ -1664,17 +2597,16 @@ void InterleavedGltfModel::InstancedStaticBatchRender(ID3D11DeviceContext* immed
     for (const BatchMesh& batchMesh : batchMeshes)
     {
         PrimitiveConstants primitiveData = {};
+        batchMesh.vertexFormat.SetShaderConstants(primitiveData);
         primitiveData.material = batchMesh.material;
         primitiveData.hasTangent = batchMesh.has("TANGENT");
         primitiveData.skin = -1;
-        primitiveData.emission = emission;
+        primitiveData.emission = instance.emission;
         //primitiveData.world = world;
         immediateContext->UpdateSubresource(primitiveCbuffer.Get(), 0, 0, &primitiveData, 0, 0);
         immediateContext->VSSetConstantBuffers(0, 1, primitiveCbuffer.GetAddressOf());
         immediateContext->PSSetConstantBuffers(0, 1, primitiveCbuffer.GetAddressOf());
-        UINT stride = sizeof(BatchMesh::Vertex);
-        UINT offset = 0;
-        immediateContext->IASetVertexBuffers(0, 1, buffers.at(batchMesh.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+        BindVertexBuffer(immediateContext, batchMesh.vertexFormat, batchMesh.vertexBufferView.buffer);
         const Material& material = materials.at(batchMesh.material);
         bool passed = false;
         switch (pass)
@@ -1730,7 +2662,7 @@ void InterleavedGltfModel::InstancedStaticBatchRender(ID3D11DeviceContext* immed
         //if (batchMesh.indexBufferView.buffer > -1)
         {
             immediateContext->IASetIndexBuffer(buffers.at(batchMesh.indexBufferView.buffer).Get(), batchMesh.indexBufferView.format, 0);
-            immediateContext->DrawIndexedInstanced(batchMesh.indexBufferView.sizeInBytes / _SizeofComponent(batchMesh.indexBufferView.format), instanceCount, 0, 0, 0);
+            immediateContext->DrawIndexedInstanced(batchMesh.GetLod(0).indexCount, instanceCount, 0, 0, 0);
         }
         //else
         {
@@ -1753,16 +2685,14 @@ void InterleavedGltfModel::CastShadowBatch(ID3D11DeviceContext* immediateContext
     immediateContext->PSSetShader(nullPixelShader.Get()/*SHADOW*/, nullptr, 0);
 
     //immediate_context->PSSetShader(pixelShader.Get(), nullptr, 0);
-    immediateContext->IASetInputLayout(inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     for (const BatchMesh& batchMesh : batchMeshes)
     {
-        UINT stride = sizeof(BatchMesh::Vertex);
-        UINT offset = 0;
-        immediateContext->IASetVertexBuffers(0, 1, buffers.at(batchMesh.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+        BindVertexBuffer(immediateContext, batchMesh.vertexFormat, batchMesh.vertexBufferView.buffer);
 
         PrimitiveConstants primitiveData = {};
+        batchMesh.vertexFormat.SetShaderConstants(primitiveData);
         primitiveData.material = batchMesh.material;
         primitiveData.hasTangent = batchMesh.has("TANGENT");
         primitiveData.skin = -1;
@@ -1791,7 +2721,7 @@ void InterleavedGltfModel::CastShadowBatch(ID3D11DeviceContext* immediateContext
         if (batchMesh.indexBufferView.buffer > -1)
         {
             immediateContext->IASetIndexBuffer(buffers.at(batchMesh.indexBufferView.buffer).Get(), batchMesh.indexBufferView.format, 0);
-            immediateContext->DrawIndexedInstanced(batchMesh.indexBufferView.sizeInBytes / _SizeofComponent(batchMesh.indexBufferView.format), 4, 0, 0, 0);
+            immediateContext->DrawIndexedInstanced(batchMesh.GetLod(0).indexCount, 4, 0, 0, 0);
         }
         else
         {
@@ -1826,7 +2756,6 @@ void InterleavedGltfModel::CastShadow(ID3D11DeviceContext* immediateContext, con
     immediateContext->PSSetShader(nullPixelShader.Get()/*SHADOW*/, nullptr, 0);
 
 
-    immediateContext->IASetInputLayout(inputLayout.Get());
     immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     std::function<void(int)> traverse = [&](int nodeIndex)->void {
@@ -1853,11 +2782,10 @@ void InterleavedGltfModel::CastShadow(ID3D11DeviceContext* immediateContext, con
             for (const Mesh::Primitive& primitive : mesh.primitives)
             {
                 // INTERLEAVED_GLTF_MODEL
-                UINT stride = sizeof(Mesh::Vertex);
-                UINT offset = 0;
-                immediateContext->IASetVertexBuffers(0, 1, buffers.at(primitive.vertexBufferView.buffer).GetAddressOf(), &stride, &offset);
+                BindVertexBuffer(immediateContext, primitive.vertexFormat, primitive.vertexBufferView.buffer);
 
                 PrimitiveConstants primitiveData = {};
+                primitive.vertexFormat.SetShaderConstants(primitiveData);
                 primitiveData.material = primitive.material;
                 primitiveData.hasTangent = primitive.has("TANGENT");
                 primitiveData.skin = node.skin;
@@ -1937,7 +2865,7 @@ void InterleavedGltfModel::CastShadow(ID3D11DeviceContext* immediateContext, con
                 {
                     // INTERLEAVED_GLTF_MODEL
                     immediateContext->IASetIndexBuffer(buffers.at(primitive.indexBufferView.buffer).Get(), primitive.indexBufferView.format, 0);
-                    immediateContext->DrawIndexedInstanced(primitive.indexBufferView.sizeInBytes / _SizeofComponent(primitive.indexBufferView.format), 4, 0, 0, 0);
+                    immediateContext->DrawIndexedInstanced(primitive.GetLod(0).indexCount, 4, 0, 0, 0);
                 }
                 else
                 {
@@ -2030,22 +2958,38 @@ void InterleavedGltfModel::AddAnimations(const std::vector<std::string>& filenam
 {
     for (std::vector<std::string>::const_reference filename : filenames)
     {
+        // Lfɂ͊ɒǉĂ邱Ƃ
+        if (!appendedAnimationFilenames.insert(filename).second)
+        {
+            continue;
+        }
         AddAnimation(filename);
     }
 }
 
 void InterleavedGltfModel::AddAnimation(const std::string& filename)
 {
+    std::filesystem::path cacheFilename(filename);
+    cacheFilename.replace_extension("animationCache");
+    // `̃LbV
     std::filesystem::path cerealFilename(filename);
     cerealFilename.replace_extension("animationCereal");
+
+    MappedCache::Reader reader;
+    std::string report;
+    if (std::filesystem::exists(cacheFilename) && reader.Open(cacheFilename, AnimationCacheType) && MappedCache::ValidateModelRecords(reader, report))
+    {
+        MappedCache::ReadAnimations(reader, animations);
+        return;
+    }
+
+    std::vector<Animation> newAnimations;
     if (std::filesystem::exists(cerealFilename.c_str()))
     {
         std::ifstream ifs(cerealFilename.c_str(), std::ios::binary);
         cereal::BinaryInputArchive deserialization(ifs);
-        std::vector<Animation> cerealAnimations;
         //@ǂݍݎ
-        deserialization(cereal::make_nvp("animations", cerealAnimations));
-        animations.insert(animations.end(), cerealAnimations.begin(), cerealAnimations.end());
+        deserialization(cereal::make_nvp("animations", newAnimations));
     }
     else
     {
@@ -2068,15 +3012,32 @@ void InterleavedGltfModel::AddAnimation(const std::string& filename)
         _ASSERT_EXPR_A(error.empty(), error.c_str());
         _ASSERT_EXPR_A(succeeded, L"Failed to load glTF file");
 
-        std::vector<Animation> newAnimations;
         FetchAnimations(gltfModel, newAnimations);
-        animations.insert(animations.end(), newAnimations.begin(), newAnimations.end());
+    }
+    animations.insert(animations.end(), newAnimations.begin(), newAnimations.end());
 
-        std::ofstream ofs(cerealFilename.c_str(), std::ios::binary);
-        cereal::BinaryOutputArchive serialization(ofs);
-        // ݎ
-        serialization(cereal::make_nvp("animations", newAnimations));
+    // ݎ
+    MappedCache::Writer writer(AnimationCacheType);
+    MappedCache::WriteAnimations(writer, newAnimations);
+    if (!writer.Save(cacheFilename))
+    {
+        OutputDebugStringA(("InterleavedGltfModel : failed to write " + cacheFilename.string() + "\n").c_str());
+    }
+}
+
+void InterleavedGltfModel::PrepareAnimationCache(const std::string& filename)
+{
+    std::filesystem::path cacheFilename(filename);
+    cacheFilename.replace_extension("animationCache");
+    MappedCache::Reader reader;
+    std::string report;
+    if (std::filesystem::exists(cacheFilename) && reader.Open(cacheFilename, AnimationCacheType) && MappedCache::ValidateModelRecords(reader, report))
+    {
+        return;
     }
+    // ǂݍݐ͎̂Ă (AddAnimation LbVo)
+    InterleavedGltfModel model;
+    model.AddAnimation(filename);
 }
 
 void InterleavedGltfModel::ComputeAABBFromMesh(const InterleavedGltfModel::Node& node, const InterleavedGltfModel& model, DirectX::XMFLOAT3& outMin, DirectX::XMFLOAT3& outMax)
@@ -2096,9 +3057,10 @@ void InterleavedGltfModel::ComputeAABBFromMesh(const InterleavedGltfModel::Node&
     const auto& mesh = model.meshes[node.mesh];
     for (const auto& primitive : mesh.primitives)
     {
-        for (const auto& vertex : primitive.cachedVertices)
+        for (size_t vertexIndex = 0; vertexIndex < primitive.VertexCount(); ++vertexIndex)
         {
-            XMVECTOR pos = XMLoadFloat3(&vertex.position);
+            const XMFLOAT3 position = primitive.GetPosition(vertexIndex);
+            XMVECTOR pos = XMLoadFloat3(&position);
             minVec = XMVectorMin(minVec, pos);
             maxVec = XMVectorMax(maxVec, pos);
         }
@@ -8,7 +8,11 @@
 
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <optional>
+#include <mutex>
+#include <filesystem>
+#include <functional>
 
 #define TINYGLTF_NO_EXTERNAL_IMAGE
 #define TINYGLTF_NO_STB_IMAGE
@@ -25,18 +29,33 @@
 
 #include "Physics/Collider.h"
 #include "Graphics/Core/PipelineState.h"
+#include "Engine/Serialization/MappedCache.h"
+#include "Graphics/Resource/MeshOptimizer.h"
+#include "Graphics/Resource/MeshSimplifier.h"
+#include "Graphics/Resource/MeshletBuilder.h"
+#include "Graphics/Resource/VertexFormat.h"
 
 
 class MeshComponent;
 
+// DXGI_FORMAT  1 vf̃oCg (InterleavedGltfModel.cpp)
+UINT _SizeofComponent(DXGI_FORMAT format);
+
 class InterleavedGltfModel
 {
     //\[XLbV
     std::shared_ptr<tinygltf::Model> gltfModel;
     static inline std::unordered_map<std::string, std::weak_ptr<tinygltf::Model>> cachedGltfModels;
+    static inline std::mutex cachedGltfModelsMutex;
+
+    // ς݃f̃LbV (key : t@C + Mode + _f[^c)
+    static inline std::unordered_map<std::string, std::weak_ptr<InterleavedGltfModel>> cachedModels;
+    static inline std::mutex cachedModelsMutex;
 
     MeshComponent* meshComponent;
     std::string filename;
+    // MakeVariant ŕςݒ (LbṼL[ɑBǂݍ񂾂܂܂Ȃ)
+    std::string variantKey;
 public:
     enum class Mode
     {
@@ -69,28 +88,116 @@ public:
     //fŗL̍Wn //@LH_Y_UP
     CoordinateSystem modelCoordinateSystem = CoordinateSystem::RH_Y_UP;
 
-    // disolve p
-    float disolveFactor = 0.0f;
-    void SetDisolveFactor(float factor) { this->disolveFactor = factor; }
-
+    // CX^XƂɕς`p[^
+    // f͕ MeshComponent ŋL̂ŁAɓꂽ̂ MeshComponent 
+    struct InstanceParameters
+    {
+        // disolve p
+        float disolveFactor = 0.0f;
+        // rp alpha
+        float alpha = 1.0f;
+        // G~bV
+        float emission = 5.0f;
+        // J[
+        DirectX::XMFLOAT3 cpuColor = { 1.0f,1.0f,1.0f };
 
-    float alpha = 1.0f;
-    // rp alpha Zbg֐
-    void SetAlpha(float alpha) { this->alpha = alpha; }
+        // primitive Ƃ̃}eA̍ւ (key : mesh << 16 | primitive)
+        std::unordered_map<int, int> overrideMaterials;
 
-    // G~bVZbg֐
-    float emission = 5.0f;
+        void SetDisolveFactor(float factor) { this->disolveFactor = factor; }
+        void SetAlpha(float alpha) { this->alpha = alpha; }
 
-    // J[Zbg֐
-    DirectX::XMFLOAT3 cpuColor = { 1.0f,1.0f,1.0f };
+        void SetPrimitiveMaterial(int mesh, int primitive, int material)
+        {
+            overrideMaterials[(mesh << 16) | primitive] = material;
+        }
+        int GetPrimitiveMaterial(int mesh, int primitive, int defaultMaterial) const
+        {
+            if (overrideMaterials.empty())
+            {
+                return defaultMaterial;
+            }
+            auto it = overrideMaterials.find((mesh << 16) | primitive);
+            return it != overrideMaterials.end() ? it->second : defaultMaterial;
+        }
+    };
 
     InterleavedGltfModel(ID3D11Device* device, const std::string& filename, Mode mode, bool isSaveVerticesData = false);
     virtual ~InterleavedGltfModel() = default;
 
+    // LbV狤Lf擾 (Γǂݍ)
+    // InstancedStaticMesh ̓CX^Xobt@̂ŋLȂ
+    static std::shared_ptr<InterleavedGltfModel> Load(ID3D11Device* device, const std::string& filename, Mode mode, bool isSaveVerticesData = false);
+
+    // LĂ郂fOɕ (GPU \[X͋L܂)
+    static std::shared_ptr<InterleavedGltfModel> MakeUnique(const std::shared_ptr<InterleavedGltfModel>& model);
+    // LĂ郂fɁAݒςԂ (ݒ̓̕LbVċL)
+    // variant : ςݒ\ (LbṼL[ɑ), apply : ɐݒ
+    // LĂȂf (MakeUnique ̂Ȃ) ͂̂܂܏ĕԂ
+    static std::shared_ptr<InterleavedGltfModel> MakeVariant(const std::shared_ptr<InterleavedGltfModel>& model, const std::string& variant, const std::function<void(InterleavedGltfModel&)>& apply);
+
+    // iKIȓǂݍ (AssetLoader WuOt̒iƂɌĂ)
+    // ReadSourceFile -> ParseSource -> ProcessSource ̓[J[Xbh珇ԂɌĂł悢
+    // UploadResources  D3D ̃\[XƃeNX`̂ŁAAbv[hSXbh 1 {Ă
+    static std::shared_ptr<InterleavedGltfModel> CreateUnloaded(const std::string& filename, Mode mode, bool isSaveVerticesData = false);
+    // 1. LbV}bv ( glTF / `̃LbVɓǂ)
+    void ReadSourceFile();
+    // 2. LbṼR[hWJ / glTF ͂
+    void ParseSource();
+    // 3. _̎oEob`EʎqƃLbV̏o
+    void ProcessSource();
+    // 4. GPU Ƀobt@EeNX`EVF[_[
+    void UploadResources(ID3D11Device* device);
+
+    // ǂݍݏIfLLbVɓo^ (ɓo^ꂽ̂΂Ԃ)
+    static std::shared_ptr<InterleavedGltfModel> Publish(const std::shared_ptr<InterleavedGltfModel>& model, double loadMilliseconds);
+    // LLbVɐĂ郂fΕԂ
+    static std::shared_ptr<InterleavedGltfModel> FindCached(const std::string& filename, Mode mode, bool isSaveVerticesData);
+
+    struct CacheStatistics
+    {
+        int hitCount = 0;       // LbV擾ł
+        int missCount = 0;      // t@Cǂݍ񂾉
+        int liveModelCount = 0; // ݐĂ鋤Lf
+        double totalLoadMilliseconds = 0.0; // ǂݍ݂ɂv
+        size_t liveGpuBufferBytes = 0;      // Ă鋤Lf̒_/CfbNXobt@̍v
+    };
+    static CacheStatistics GetCacheStatistics();
+
+    // .cereal  .modelCache ̓ǂݍݎԂr (GPU ւ̃Abv[h͊܂܂Ȃ)
+    static std::string BenchmarkCacheLoad(const std::string& filename, Mode mode, int iterations = 10);
+
+    // _̗ʎqݒ (ςƎ̓ǂݍ݂ŃLbV蒼)
+    static inline VertexFormatBuilder::Options vertexFormatOptions;
+    // glTF ǂݍŃv~eBuƂ̒_tH[}bgETCYE덷ꗗɂ
+    static std::string ReportVertexFormats(const std::string& filename, Mode mode);
+    // CfbNXE_̕בւ̐ݒ (ςƎ̓ǂݍ݂ŃLbV蒼)
+    static inline MeshOptimizer::Options meshOptimizerOptions;
+    // glTF ǂݍŃbVƂ̕בւO ACMR / ATVR ꗗɂ
+    static std::string ReportMeshOptimization(const std::string& filename, Mode mode);
+    // LOD ̍ (ςƎ̓ǂݍ݂ŃLbV蒼)
+    static inline MeshSimplifier::Options meshSimplifierOptions;
+    // glTF ǂݍŃbVƂ LOD AiƂ̎Op`̐ƌ덷ꗗɂ
+    static std::string ReportLods(const std::string& filename, Mode mode);
+    // ob`bṼbVbg̕ (ςƎ̓ǂݍ݂ŃLbV蒼)
+    static inline MeshletBuilder::Options meshletBuilderOptions;
+    // glTF ǂݍŃob`bVbVbgɕA̐Ƒ傫ꗗɂ
+    static std::string ReportMeshlets(const std::string& filename, Mode mode);
+    // .modelCache ̌`؂
+    static bool ValidateCacheFile(const std::string& filename, Mode mode, std::string& report);
+    static std::filesystem::path GetCacheFilename(const std::string& filename, Mode mode);
+
     // Instance Ŏgp
     void SetMeshComponent(MeshComponent* mesh) { this->meshComponent = mesh; }
 
     AABB GetAABB()const;
+    // f (Wn̕ϊO)  AABBBJOŎg
+    // X^eBbNbV̓ob`̒_AXP^bV̓oCh|[Ỹm[h狁߂ăLbVɕۑ
+    AABB localBounds = {};
+    bool hasLocalBounds = false;
+    // iƂ̌덷 (fԂ̒)BSẴv~eBuEob`bV̒̍ő (Ȃ LOD Ȃ)
+    // i̓fŜőđI (v~eBűڂɌԂłȂ悤)
+    std::vector<float> lodErrors;
 
     struct Scene
     {
@@ -223,27 +330,50 @@ public:
             std::vector<unsigned char> cachedIndices;
             IndexBufferView indexBufferView;
 
-            std::vector<Vertex> cachedVertices;
+            // vertexFormat ŗʎq_ (Vertex ~ DecodeVertices)
+            std::vector<unsigned char> cachedVertices;
             VertexBufferView vertexBufferView;
+            VertexFormat vertexFormat = VertexFormat::FullPrecision(true);
 
             std::unordered_map<std::string, DXGI_FORMAT> attributes;
 
+            // }bvLbṼf[^ (CreateAndUploadResources ܂ŗL)
+            const void* mappedIndices = nullptr;
+            const void* mappedVertices = nullptr;
+
+            // CfbNXobt@̒ LOD ͈̔ (lods[0] ̃bVBȂŜ 1 i)
+            std::vector<MeshSimplifier::Lod> lods;
+            // lod iڂ̕`͈ (iȂ΍Ō̒i)
+            MeshSimplifier::Lod GetLod(int lod) const
+            {
+                return MeshSimplifier::GetLod(lods, lod, indexBufferView.sizeInBytes / _SizeofComponent(indexBufferView.format));
+            }
+
             bool has(const char* attribute) const
             {
                 return attributes.find(attribute) != attributes.end();
             }
 
+            // cachedVertices ̒_ (isSaveVerticesData łȂ GPU ɑ 0)
+            size_t VertexCount() const { return cachedVertices.size() / vertexFormat.Stride(); }
+            DirectX::XMFLOAT3 GetPosition(size_t index) const { return VertexFormatBuilder::DecodePosition(vertexFormat, cachedVertices.data(), index); }
+            std::vector<Vertex> DecodeVertices() const { return VertexFormatBuilder::Decode<Vertex>(vertexFormat, cachedVertices.data(), VertexCount()); }
+
+            // ` (.cereal) ͗ʎqO Vertex Ă
             template<class T>
-            void serialize(T& archive)
+            void load(T& archive)
             {
+                std::vector<Vertex> vertices;
                 archive(
                     cereal::make_nvp("material", material),
                     cereal::make_nvp("cachedIndices", cachedIndices),
                     cereal::make_nvp("indexBufferView", indexBufferView),
-                    cereal::make_nvp("cachedVertices", cachedVertices),
+                    cereal::make_nvp("cachedVertices", vertices),
                     cereal::make_nvp("vertexBufferView", vertexBufferView),
                     cereal::make_nvp("attributes", attributes)
                 );
+                vertexFormat = VertexFormat::FullPrecision(true);
+                cachedVertices = VertexFormatBuilder::Encode(vertexFormat, VertexFormatBuilder::ToAttributes(vertices));
             }
         };
         std::vector<Primitive> primitives;
@@ -285,27 +415,55 @@ public:
         std::vector<UINT> cachedIndices;
         IndexBufferView indexBufferView;
 
-        std::vector<Vertex> cachedVertices;
+        // vertexFormat ŗʎq_ (Vertex ~ DecodeVertices)
+        std::vector<unsigned char> cachedVertices;
         VertexBufferView vertexBufferView;
+        VertexFormat vertexFormat = VertexFormat::FullPrecision(false);
 
         std::unordered_map<std::string, DXGI_FORMAT> attributes;
 
+        // }bvLbṼf[^ (CreateAndUploadResources ܂ŗL)
+        const void* mappedIndices = nullptr;
+        const void* mappedVertices = nullptr;
+
+        // CfbNXobt@̒ LOD ͈̔ (lods[0] ̃bVBȂŜ 1 i)
+        std::vector<MeshSimplifier::Lod> lods;
+        // lod iڂ̕`͈ (iȂ΍Ō̒i)
+        MeshSimplifier::Lod GetLod(int lod) const
+        {
+            return MeshSimplifier::GetLod(lods, lod, indexBufferView.sizeInBytes / sizeof(UINT));
+        }
+
+        // 0 iڂ̃CfbNX𕪂bVbg (Ȃ番ĂȂ)
+        std::vector<MeshletBuilder::Meshlet> meshlets;
+        // meshlets 𖈃t[̑Iʗpɕג (UpdateMeshletClusters ō)
+        MeshletBuilder::Clusters meshletClusters;
+
         bool has(const char* attribute) const
         {
             return attributes.find(attribute) != attributes.end();
         }
 
+        // cachedVertices ̒_ (isSaveVerticesData łȂ GPU ɑ 0)
+        size_t VertexCount() const { return cachedVertices.size() / vertexFormat.Stride(); }
+        DirectX::XMFLOAT3 GetPosition(size_t index) const { return VertexFormatBuilder::DecodePosition(vertexFormat, cachedVertices.data(), index); }
+        std::vector<Vertex> DecodeVertices() const { return VertexFormatBuilder::Decode<Vertex>(vertexFormat, cachedVertices.data(), VertexCount()); }
+
+        // ` (.batchCereal) ͗ʎqO Vertex Ă
         template<class T>
-        void serialize(T& archive)
+        void load(T& archive)
         {
+            std::vector<Vertex> vertices;
             archive(
                 cereal::make_nvp("material", material),
                 cereal::make_nvp("cachedIndices", cachedIndices),
                 cereal::make_nvp("indexBufferView", indexBufferView),
-                cereal::make_nvp("cachedVertices", cachedVertices),
+                cereal::make_nvp("cachedVertices", vertices),
                 cereal::make_nvp("vertexBufferView", vertexBufferView),
                 cereal::make_nvp("attributes", attributes)
             );
+            vertexFormat = VertexFormat::FullPrecision(false);
+            cachedVertices = VertexFormatBuilder::Encode(vertexFormat, VertexFormatBuilder::ToAttributes(vertices));
         }
     };
     std::vector<BatchMesh> batchMeshes;
@@ -315,11 +473,13 @@ public:
     // INTERLEAVED_GLTF_MODEL
     std::vector<Microsoft::WRL::ComPtr<ID3D11Buffer>> buffers;
 
-    void Render(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world, const std::vector<Node>& animated_nodes, RenderPass pass, const PipeLineStateDesc& pipeline = {});
+    void Render(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& world, const std::vector<Node>& animated_nodes, RenderPass pass, const PipeLineStateDesc& pipeline = {}, const InstanceParameters& instance = {});
     // INTERLEAVED_GLTF_MODEL
     void BatchRender(ID3D11DeviceContext* immediate_context, const DirectX::XMFLOAT4X4& world, RenderPass pass, const PipeLineStateDesc& pipeline);
 
-    void InstancedStaticBatchRender(ID3D11DeviceContext* immediate_context/*, const DirectX::XMFLOAT4X4& world*/, RenderPass pass, const PipeLineStateDesc& pipeline = {});
+    void InstancedStaticBatchRender(ID3D11DeviceContext* immediate_context/*, const DirectX::XMFLOAT4X4& world*/, RenderPass pass, const PipeLineStateDesc& pipeline = {}, const InstanceParameters& instance = {});
+    // CX^X̍s instanceBuffer ɏ instanceCount_ XV (肫Ȃ͔{̑傫ō蒼)
+    void UpdateInstances(ID3D11DeviceContext* immediateContext, const std::vector<DirectX::XMFLOAT4X4>& matrices);
 
 
     struct TextureInfo
@@ -478,6 +638,9 @@ public:
         bool asIs = false;
 
         std::vector<unsigned char> cacheData;
+        // }bvLbV̉摜f[^ (CreateAndUploadResources ܂ŗL)
+        const unsigned char* mappedData = nullptr;
+        size_t mappedSize = 0;
 
         template<class T>
         void serialize(T& archive)
@@ -592,6 +755,33 @@ private:
     // INTERLEAVED_GLTF_MODEL
     void FetchAndBatchMeshes(ID3D11Device* device, const tinygltf::Model& gltf_model);
 
+    // LbV̓ǂݏ
+    bool LoadMappedCache(const std::filesystem::path& cacheFilename);
+    // }bvăwb_ER[hEʎq̐ݒ؂ (gȂ nullptr)
+    std::shared_ptr<MappedCache::Reader> OpenMappedCache(const std::filesystem::path& cacheFilename) const;
+    void ReadMappedCache(const std::shared_ptr<MappedCache::Reader>& reader);
+    void SaveMappedCache(const std::filesystem::path& cacheFilename) const;
+    void LoadCerealCache(std::istream& stream);
+
+    static std::string MakeCacheKey(const std::string& filename, Mode mode, bool isSaveVerticesData);
+
+    // ǂݍ񂾒_v~eBuƂɑI񂾃tH[}bg֗ʎq
+    void QuantizeVertices(VertexFormatBuilder::ErrorReport* report = nullptr);
+    // _LbVEI[o[h[E_tFb`ɍ킹ăCfbNXƒ_בւ
+    void OptimizeMeshes(MeshOptimizer::Report* report = nullptr);
+    // 񎟌덷ŃCfbNX炵 LOD CfbNXobt@̌ɒǉ (בւ̌ɌĂ)
+    void GenerateLods(MeshSimplifier::Report* report = nullptr);
+    // v~eBuEob`bV lods  lodErrors ߂
+    void UpdateLodErrors();
+    // 傫ȃob`bV 0 iڂbVbgɕĕבւ (LOD ̌ɌĂ)
+    void GenerateMeshlets(MeshletBuilder::Report* report = nullptr);
+    // ob`bV meshlets  meshletClusters 
+    void UpdateMeshletClusters();
+    // localBounds 𒸓_Em[h狁߂ (CPU ɒ_cĂԂɌĂ)
+    void ComputeLocalBounds();
+    // |[gp GPU \[X炸_ǂݍ
+    static bool FetchVerticesOnly(const std::string& filename, Mode mode, InterleavedGltfModel& model, std::string& error);
+
 public:
     // CascadedShadowMaps
     Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShaderCSM;
@@ -599,7 +789,16 @@ public:
 
     Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
     Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
-    Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayout;
+    // _tH[}bg (VertexFormat::LayoutKey) Ƃ̓̓CAEg
+    std::unordered_map<uint32_t, Microsoft::WRL::ComPtr<ID3D11InputLayout>> inputLayouts;
+    // JOINTS / WEIGHTS Ȃ_tH[}bgp̊l (VertexFormat::SkinDefaults)
+    Microsoft::WRL::ComPtr<ID3D11Buffer> skinDefaultsBuffer;
+
+    void CreateInputLayouts(ID3D11Device* device, const char* vertexShaderName);
+    ID3D11InputLayout* GetInputLayout(const VertexFormat& format) const;
+    // ̓CAEgƒ_obt@ (KvȂXL̊l) ݒ肷
+    void BindVertexBuffer(ID3D11DeviceContext* immediateContext, const VertexFormat& format, int buffer) const;
+
     struct PrimitiveConstants
     {
         DirectX::XMFLOAT4X4 world;
@@ -612,9 +811,14 @@ public:
         float disolveFactor = 0.0f;
 
         float emission = 0.0f;
-        float pads[3];
+        uint32_t vertexFlags = 0; // VertexFormat::ShaderFlags
+        float pads[2];
 
         DirectX::XMFLOAT4X4 invWorld;
+
+        // ʎqʒu̕ (VertexFormat::SetShaderConstants)
+        DirectX::XMFLOAT4 positionScale = { 1, 1, 1, 0 };
+        DirectX::XMFLOAT4 positionOffset = { 0, 0, 0, 0 };
     };
     Microsoft::WRL::ComPtr<ID3D11Buffer> primitiveCbuffer;
 
@@ -639,6 +843,8 @@ public:
 public:
     // Aj[Vǉ֐
     void AddAnimations(const std::vector<std::string>& filenames);
+    // Aj[ṼLbV (.animationCache) ΍Ă (AssetLoader ɌĂ)
+    static void PrepareAnimationCache(const std::string& filename);
 
     // f̃WCg̃[hԂ position Ԃ֐
     DirectX::XMFLOAT3 GetJointWorldPosition(/*size_t nodeIndex,*/const std::string& name, const std::vector<Node>& animatedNodes, const DirectX::XMFLOAT4X4& transform);
@@ -670,9 +876,35 @@ private:
     // _̃f[^cĂ
     bool isSaveVerticesData = false;
 
+    // ǉς݂̃Aj[Vt@C (LfɓAj[VdɒǉȂ)
+    std::unordered_set<std::string> appendedAnimationFilenames;
+
+    // GPU ɍ_/CfbNXobt@̍vTCY
+    size_t gpuBufferBytes = 0;
+
+    // ǂݍݒێLbṼ}bsO (_/摜͂璼 GPU ɑ)
+    std::shared_ptr<MappedCache::Reader> mappedCache;
+
+    // iKIȓǂݍ݂̓ȑ (ReadSourceFile Ō܂)
+    enum class LoadSource
+    {
+        None,
+        MappedCache,    // .modelCache / .batchModelCache
+        Cereal,         // `̃LbV
+        Gltf,           // .gltf / .glb
+    };
+    LoadSource loadSource = LoadSource::None;
+    // ReadSourceFile œǂ񂾃t@C̒g (ParseSource ŉ)
+    std::string sourceBytes;
+
+    // x`}[Np (GPU \[XȂ)
+    InterleavedGltfModel() = default;
+
 public:
     // CX^Xp̃obt@
     Microsoft::WRL::ComPtr<ID3D11Buffer> instanceBuffer;
+    // instanceBuffer ɓs̐
+    UINT instanceCapacity_ = 1000;
     // CX^Xp̍s
     std::vector<DirectX::XMFLOAT4X4> instanceMatrices_;
 
@@ -0,0 +1,414 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+#include "Engine/Utility/Deterministic.h"
+
+using namespace DirectX;
+
+uint32_t MeshOptimizer::Options::Hash() const
+{
+    return Deterministic::Fnv1a32(
+        {
+            optimizeVertexCache ? 1u : 0u, optimizeOverdraw ? 1u : 0u, optimizeVertexFetch ? 1u : 0u,
+            static_cast<uint32_t>(cacheSize), Deterministic::FloatBits(overdrawThreshold),
+        });
+}
+
+std::string MeshOptimizer::Statistics::ToString() const
+{
+    char buf[160];
+    sprintf_s(buf, "%zu tris, %zu verts, ACMR %.3f, ATVR %.3f, overfetch %.3f", triangleCount, vertexCount, acmr, atvr, overfetch);
+    return buf;
+}
+
+std::string MeshOptimizer::Report::ToString() const
+{
+    std::string text;
+    Statistics totalBefore;
+    Statistics totalAfter;
+    for (const Entry& entry : entries)
+    {
+        text += "  " + entry.name + "\n    before : " + entry.before.ToString() + "\n    after  : " + entry.after.ToString() + "\n";
+        totalBefore.triangleCount += entry.before.triangleCount;
+        totalBefore.vertexCount += entry.before.vertexCount;
+        totalBefore.cacheMisses += entry.before.cacheMisses;
+        totalAfter.triangleCount += entry.after.triangleCount;
+        totalAfter.vertexCount += entry.after.vertexCount;
+        totalAfter.cacheMisses += entry.after.cacheMisses;
+    }
+    if (totalBefore.triangleCount > 0 && totalBefore.vertexCount > 0)
+    {
+        char buf[160];
+        sprintf_s(buf, "  total ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+            static_cast<float>(totalBefore.cacheMisses) / totalBefore.triangleCount, static_cast<float>(totalAfter.cacheMisses) / totalAfter.triangleCount,
+            static_cast<float>(totalBefore.cacheMisses) / totalBefore.vertexCount, static_cast<float>(totalAfter.cacheMisses) / totalAfter.vertexCount);
+        text += buf;
+    }
+    return text;
+}
+
+void MeshOptimizer::Optimize(std::vector<uint32_t>& indices, std::vector<unsigned char>& vertices, size_t stride,
+    const std::function<XMFLOAT3(uint32_t)>& getPosition, const Options& options)
+{
+    if (indices.size() < 3 || indices.size() % 3 != 0 || stride == 0)
+    {
+        return;
+    }
+    const size_t vertexCount = vertices.size() / stride;
+    for (uint32_t index : indices)
+    {
+        if (index >= vertexCount)
+        {// ꂽCfbNX͕בւȂ
+            return;
+        }
+    }
+
+    if (options.optimizeVertexCache)
+    {
+        std::vector<uint32_t> clusters;
+        indices = OptimizeVertexCache(indices, vertexCount, options.cacheSize, &clusters);
+        if (options.optimizeOverdraw && getPosition)
+        {
+            indices = OptimizeOverdraw(indices, clusters, getPosition, vertexCount, options.cacheSize, options.overdrawThreshold);
+        }
+    }
+    if (options.optimizeVertexFetch)
+    {
+        OptimizeVertexFetch(indices, vertices, stride);
+    }
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize, std::vector<uint32_t>* clusters)
+{
+    const size_t triangleCount = indices.size() / 3;
+    const int k = (std::max)(cacheSize, 3);
+
+    // _ƂɎgĂOp`̈ꗗ
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint32_t index : indices)
+    {
+        ++liveTriangles[index];
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        offsets[v + 1] = offsets[v] + liveTriangles[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            adjacency[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    // cacheTime : _LbVɓ (timestamp - cacheTime > k ȂLbVɖ)
+    std::vector<int64_t> cacheTime(vertexCount, 0);
+    int64_t timestamp = k + 1;
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEndStack;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+
+    size_t scanCursor = 0;
+    auto nextLiveVertex = [&]() -> int64_t
+        {
+            for (; scanCursor < vertexCount; ++scanCursor)
+            {
+                if (liveTriangles[scanCursor] > 0)
+                {
+                    return static_cast<int64_t>(scanCursor);
+                }
+            }
+            return -1;
+        };
+
+    int64_t fanning = nextLiveVertex();
+    bool isNewCluster = true;
+    while (fanning >= 0)
+    {
+        if (isNewCluster && clusters)
+        {
+            clusters->push_back(static_cast<uint32_t>(result.size() / 3));
+        }
+        // ̒S̒_gOp`Sďo͂
+        candidates.clear();
+        for (uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a)
+        {
+            const uint32_t triangle = adjacency[a];
+            if (emitted[triangle])
+            {
+                continue;
+            }
+            for (int corner = 0; corner < 3; ++corner)
+            {
+                const uint32_t v = indices[triangle * 3 + corner];
+                result.push_back(v);
+                deadEndStack.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+                if (timestamp - cacheTime[v] > k)
+                {
+                    cacheTime[v] = timestamp++;
+                }
+            }
+            emitted[triangle] = true;
+        }
+
+        // ̐̒S : o͂ĂLbVɎc钸_̂AԌÂ
+        int64_t best = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates)
+        {
+            if (liveTriangles[v] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            if (timestamp - cacheTime[v] + 2 * static_cast<int64_t>(liveTriangles[v]) <= k)
+            {
+                priority = timestamp - cacheTime[v];
+            }
+            if (priority > bestPriority)
+            {
+                best = v;
+                bestPriority = priority;
+            }
+        }
+        if (best < 0)
+        {// s~܂ : ŋߏo͂_߂
+            while (!deadEndStack.empty())
+            {
+                const uint32_t v = deadEndStack.back();
+                deadEndStack.pop_back();
+                if (liveTriangles[v] > 0)
+                {
+                    best = v;
+                    break;
+                }
+            }
+            if (best < 0)
+            {
+                best = nextLiveVertex();
+            }
+        }
+        // LbVOꂽ_ĊJ鏊NX^̋Eɂ
+        isNewCluster = best >= 0 && timestamp - cacheTime[best] > k;
+        fanning = best;
+    }
+    return result;
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters,
+    const std::function<XMFLOAT3(uint32_t)>& getPosition, size_t vertexCount, int cacheSize, float threshold)
+{
+    if (clusters.size() <= 1)
+    {
+        return indices;
+    }
+    const size_t triangleCount = indices.size() / 3;
+
+    std::vector<XMFLOAT3> positions(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        positions[v] = getPosition(static_cast<uint32_t>(v));
+    }
+
+    // NX^Ƃ̖ʐςŏdݕtdSƖ@
+    struct Cluster
+    {
+        uint32_t begin;
+        uint32_t end;
+        XMFLOAT3 centroid;
+        XMFLOAT3 normal;
+        float area;
+        float sortKey;
+    };
+    std::vector<Cluster> clusterInfos(clusters.size());
+    XMVECTOR meshCentroid = XMVectorZero();
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        Cluster& cluster = clusterInfos[c];
+        cluster.begin = clusters[c];
+        cluster.end = c + 1 < clusters.size() ? clusters[c + 1] : static_cast<uint32_t>(triangleCount);
+        XMVECTOR centroid = XMVectorZero();
+        XMVECTOR normal = XMVectorZero();
+        float area = 0.0f;
+        for (uint32_t triangle = cluster.begin; triangle < cluster.end; ++triangle)
+        {
+            const XMVECTOR p0 = XMLoadFloat3(&positions[indices[triangle * 3 + 0]]);
+            const XMVECTOR p1 = XMLoadFloat3(&positions[indices[triangle * 3 + 1]]);
+            const XMVECTOR p2 = XMLoadFloat3(&positions[indices[triangle * 3 + 2]]);
+            const XMVECTOR cross = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+            const float triangleArea = XMVectorGetX(XMVector3Length(cross)) * 0.5f;
+            centroid = XMVectorAdd(centroid, XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), p2), triangleArea / 3.0f));
+            normal = XMVectorAdd(normal, cross);
+            area += triangleArea;
+        }
+        XMStoreFloat3(&cluster.centroid, area > 0.0f ? XMVectorScale(centroid, 1.0f / area) : centroid);
+        XMStoreFloat3(&cluster.normal, normal);
+        cluster.area = area;
+        meshCentroid = XMVectorAdd(meshCentroid, centroid);
+        meshArea += area;
+    }
+    if (meshArea <= 0.0f)
+    {
+        return indices;
+    }
+    meshCentroid = XMVectorScale(meshCentroid, 1.0f / meshArea);
+
+    // bV̒SOĂNX^قǎO𕢂̂Őɕ`
+    for (Cluster& cluster : clusterInfos)
+    {
+        const XMVECTOR normal = XMLoadFloat3(&cluster.normal);
+        const float length = XMVectorGetX(XMVector3Length(normal));
+        cluster.sortKey = length > 0.0f ?
+            XMVectorGetX(XMVector3Dot(XMVectorSubtract(XMLoadFloat3(&cluster.centroid), meshCentroid), normal)) / length : 0.0f;
+    }
+    std::vector<uint32_t> order(clusterInfos.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return clusterInfos[a].sortKey > clusterInfos[b].sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (uint32_t c : order)
+    {
+        result.insert(result.end(), indices.begin() + clusterInfos[c].begin * 3, indices.begin() + clusterInfos[c].end * 3);
+    }
+
+    // EŃLbVȂȂ镪傫Ό̏Ԃ̂܂܂ɂ
+    const float acmrBefore = Analyze(indices, vertexCount, 0, cacheSize).acmr;
+    const float acmrAfter = Analyze(result, vertexCount, 0, cacheSize).acmr;
+    return acmrAfter <= acmrBefore * threshold ? result : indices;
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<unsigned char>& vertices, size_t stride)
+{
+    const size_t vertexCount = vertices.size() / stride;
+    constexpr uint32_t unused = ~0u;
+    std::vector<uint32_t> remap(vertexCount, unused);
+    uint32_t nextVertex = 0;
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == unused)
+        {
+            remap[index] = nextVertex++;
+        }
+        index = remap[index];
+    }
+
+    std::vector<unsigned char> remapped(static_cast<size_t>(nextVertex) * stride);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] != unused)
+        {
+            memcpy(remapped.data() + remap[v] * stride, vertices.data() + v * stride, stride);
+        }
+    }
+    vertices = std::move(remapped);
+}
+
+MeshOptimizer::Statistics MeshOptimizer::Analyze(const std::vector<uint32_t>& indices, size_t vertexCount, size_t stride, int cacheSize)
+{
+    Statistics statistics;
+    statistics.triangleCount = indices.size() / 3;
+    if (statistics.triangleCount == 0)
+    {
+        return statistics;
+    }
+
+    // FIFO ̒_LbV
+    const int64_t k = (std::max)(cacheSize, 1);
+    std::vector<int64_t> cacheTime(vertexCount, 0);
+    std::vector<bool> isReferenced(vertexCount, false);
+    int64_t timestamp = k + 1;
+
+    // 64 oCg̃LbVC 64 { (4KB)  FIFO Œ_tFb`𐔂
+    constexpr size_t lineSize = 64;
+    constexpr int64_t lineCount = 64;
+    const size_t bufferLines = stride > 0 ? (vertexCount * stride + lineSize - 1) / lineSize : 0;
+    std::vector<int64_t> lineTime(bufferLines, 0);
+    int64_t lineTimestamp = lineCount + 1;
+    size_t fetchedBytes = 0;
+
+    for (uint32_t index : indices)
+    {
+        if (index >= vertexCount)
+        {
+            continue;
+        }
+        if (!isReferenced[index])
+        {
+            isReferenced[index] = true;
+            ++statistics.vertexCount;
+        }
+        if (timestamp - cacheTime[index] <= k)
+        {
+            continue;
+        }
+        cacheTime[index] = timestamp++;
+        ++statistics.cacheMisses;
+
+        if (stride > 0)
+        {
+            const size_t firstLine = index * stride / lineSize;
+            const size_t lastLine = ((index + 1) * stride - 1) / lineSize;
+            for (size_t line = firstLine; line <= lastLine; ++line)
+            {
+                if (lineTimestamp - lineTime[line] > lineCount)
+                {
+                    lineTime[line] = lineTimestamp++;
+                    fetchedBytes += lineSize;
+                }
+            }
+        }
+    }
+
+    statistics.acmr = static_cast<float>(statistics.cacheMisses) / statistics.triangleCount;
+    statistics.atvr = statistics.vertexCount > 0 ? static_cast<float>(statistics.cacheMisses) / statistics.vertexCount : 0.0f;
+    statistics.overfetch = stride > 0 && vertexCount > 0 ? static_cast<float>(fetchedBytes) / (vertexCount * stride) : 0.0f;
+    return statistics;
+}
+
+std::vector<uint32_t> MeshOptimizer::ReadIndices(const std::vector<unsigned char>& bytes, size_t indexSize)
+{
+    std::vector<uint32_t> indices(bytes.size() / indexSize);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        if (indexSize == sizeof(uint16_t))
+        {
+            uint16_t index;
+            memcpy(&index, bytes.data() + i * indexSize, sizeof(index));
+            indices[i] = index;
+        }
+        else
+        {
+            memcpy(&indices[i], bytes.data() + i * indexSize, sizeof(uint32_t));
+        }
+    }
+    return indices;
+}
+
+void MeshOptimizer::WriteIndices(const std::vector<uint32_t>& indices, size_t indexSize, std::vector<unsigned char>& bytes)
+{
+    bytes.resize(indices.size() * indexSize);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+        if (indexSize == sizeof(uint16_t))
+        {
+            const uint16_t index = static_cast<uint16_t>(indices[i]);
+            memcpy(bytes.data() + i * indexSize, &index, sizeof(index));
+        }
+        else
+        {
+            memcpy(bytes.data() + i * indexSize, &indices[i], sizeof(uint32_t));
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <DirectXMath.h>
+
+// C|[g (LbV鎞) ɍsCfbNXE_̕בւ
+//   _LbV : Tipsify (Sander et al. 2007) ŎOp`בւ
+//   I[o[h[ : Tipsify ̃NX^Ô̂`悤ɕבւ
+//   _tFb`   : _CfbNXōŏɎg鏇ɕבւ
+// S CPU ݂̂ŁA͂͏ɓʂɂȂ
+class MeshOptimizer
+{
+public:
+    struct Options
+    {
+        bool optimizeVertexCache = true;
+        bool optimizeOverdraw = true;
+        bool optimizeVertexFetch = true;
+        int cacheSize = 16;             // Tipsify Ɠvőz肷 FIFO LbV̑傫
+        float overdrawThreshold = 1.05f; // NX^̕בւ ACMR ̔{舫ȂȂבւȂ
+
+        // LbVɋL^āAݒ肪ς蒼
+        uint32_t Hash() const;
+    };
+
+    // _LbVE_tFb`̓v
+    struct Statistics
+    {
+        size_t triangleCount = 0;
+        size_t vertexCount = 0;     // CfbNXQƂ钸_̐
+        size_t cacheMisses = 0;
+        float acmr = 0.0f;          // Op`̃LbV~X (0.5 - 3)
+        float atvr = 0.0f;          // _̃LbV~X (1 z)
+        float overfetch = 0.0f;     // ǂݍ񂾃LbVC̃oCg / _obt@̃oCg (1 z)
+
+        std::string ToString() const;
+    };
+
+    // œǨ (bVƂ̑O̓v)
+    struct Report
+    {
+        struct Entry
+        {
+            std::string name;
+            Statistics before;
+            Statistics after;
+        };
+        std::vector<Entry> entries;
+
+        std::string ToString() const;
+    };
+
+    // indices ͎Op`XgBvertices  stride oCg̒_̕
+    // getPosition ̓I[o[h[̕בւŎg (̒_ԍŌĂ΂)
+    // gĂȂ_͒_tFb`̍œKŎ菜
+    static void Optimize(std::vector<uint32_t>& indices, std::vector<unsigned char>& vertices, size_t stride,
+        const std::function<DirectX::XMFLOAT3(uint32_t)>& getPosition, const Options& options);
+
+    // _LbVɍ킹ĎOp`בւ (clusters ɊeNX^̐擪̎Op`ԍԂ)
+    static std::vector<uint32_t> OptimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize, std::vector<uint32_t>* clusters = nullptr);
+    // NX^PʂŊÔ̂`悤ɕבւ
+    static std::vector<uint32_t> OptimizeOverdraw(const std::vector<uint32_t>& indices, const std::vector<uint32_t>& clusters,
+        const std::function<DirectX::XMFLOAT3(uint32_t)>& getPosition, size_t vertexCount, int cacheSize, float threshold);
+    // _ŏɎg鏇ɕבւACfbNX (gȂ_͎菜)
+    static void OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<unsigned char>& vertices, size_t stride);
+
+    static Statistics Analyze(const std::vector<uint32_t>& indices, size_t vertexCount, size_t stride, int cacheSize);
+
+    // 16bit / 32bit ̃CfbNXobt@ (oCg) Ƃ̕ϊ
+    static std::vector<uint32_t> ReadIndices(const std::vector<unsigned char>& bytes, size_t indexSize);
+    static void WriteIndices(const std::vector<uint32_t>& indices, size_t indexSize, std::vector<unsigned char>& bytes);
+};
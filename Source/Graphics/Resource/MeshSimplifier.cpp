@@ -0,0 +1,646 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+#include "MeshOptimizer.h"
+#include "Engine/Utility/Deterministic.h"
+
+using namespace DirectX;
+
+uint32_t MeshSimplifier::Options::Hash() const
+{
+    return Deterministic::Fnv1a32(
+        {
+            enable ? 1u : 0u, static_cast<uint32_t>(levelCount), Deterministic::FloatBits(reduction), Deterministic::FloatBits(maxError),
+            Deterministic::FloatBits(minReduction), static_cast<uint32_t>(cacheSize),
+        });
+}
+
+std::string MeshSimplifier::Report::ToString() const
+{
+    std::string text;
+    size_t totalTriangles[MaxLodCount] = {};
+    for (const Entry& entry : entries)
+    {
+        char buf[160];
+        sprintf_s(buf, "  %s : %zu verts, extent %.3f\n", entry.name.c_str(), entry.vertexCount, entry.extent);
+        text += buf;
+        for (size_t level = 0; level < entry.lods.size(); ++level)
+        {
+            const Lod& lod = entry.lods[level];
+            const size_t triangles = lod.indexCount / 3;
+            sprintf_s(buf, "    LOD%zu : %zu tris (%.1f%%), error %.5f (%.3f%%)\n", level, triangles,
+                100.0f * lod.indexCount / (std::max)(entry.lods[0].indexCount, 1u), lod.error, entry.extent > 0 ? 100.0f * lod.error / entry.extent : 0.0f);
+            text += buf;
+        }
+        // iȂbV͍Ō̒i`̂ŁAvɍ킹
+        for (size_t level = 0; level < MaxLodCount && !entry.lods.empty(); ++level)
+        {
+            totalTriangles[level] += entry.lods[(std::min)(level, entry.lods.size() - 1)].indexCount / 3;
+        }
+    }
+    if (!entries.empty())
+    {
+        char buf[160];
+        sprintf_s(buf, "  total tris %zu / %zu / %zu / %zu (%.3f ms)\n", totalTriangles[0], totalTriangles[1], totalTriangles[2], totalTriangles[3], milliseconds);
+        text += buf;
+    }
+    return text;
+}
+
+namespace
+{
+    //  (a, b, c, d) ̋̓dݕtő (Ώ̍s 10 vf)
+    struct Quadric
+    {
+        double a2 = 0, ab = 0, ac = 0, ad = 0;
+        double b2 = 0, bc = 0, bd = 0;
+        double c2 = 0, cd = 0;
+        double d2 = 0;
+        double weight = 0;
+
+        static Quadric FromPlane(double a, double b, double c, double d, double weight)
+        {
+            Quadric q;
+            q.a2 = a * a * weight; q.ab = a * b * weight; q.ac = a * c * weight; q.ad = a * d * weight;
+            q.b2 = b * b * weight; q.bc = b * c * weight; q.bd = b * d * weight;
+            q.c2 = c * c * weight; q.cd = c * d * weight;
+            q.d2 = d * d * weight;
+            q.weight = weight;
+            return q;
+        }
+        Quadric& operator+=(const Quadric& r)
+        {
+            a2 += r.a2; ab += r.ab; ac += r.ac; ad += r.ad;
+            b2 += r.b2; bc += r.bc; bd += r.bd;
+            c2 += r.c2; cd += r.cd;
+            d2 += r.d2;
+            weight += r.weight;
+            return *this;
+        }
+        // _ p ł̌덷̒PʂŕԂ
+        float Error(const XMFLOAT3& p) const
+        {
+            const double x = p.x, y = p.y, z = p.z;
+            const double e = a2 * x * x + b2 * y * y + c2 * z * z + 2 * (ab * x * y + ac * x * z + bc * y * z) + 2 * (ad * x + bd * y + cd * z) + d2;
+            return weight > 0 ? static_cast<float>(std::sqrt((std::max)(e, 0.0) / weight)) : 0.0f;
+        }
+    };
+
+    XMVECTOR TriangleNormal(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+    {
+        const XMVECTOR v0 = XMLoadFloat3(&p0);
+        return XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&p1), v0), XMVectorSubtract(XMLoadFloat3(&p2), v0));
+    }
+
+    // ʒu̒_ (UVE@̌p)  1 ̓_ɂ܂Ƃ߂āA_̏ŕӂk񂷂
+    class Simplifier
+    {
+    public:
+        Simplifier(const std::vector<uint32_t>& indices, size_t vertexCount, const std::function<XMFLOAT3(uint32_t)>& getPosition)
+        {
+            WeldPositions(vertexCount, getPosition);
+
+            const size_t triangleCount = indices.size() / 3;
+            corners.assign(indices.begin(), indices.end());
+            deadTriangles.assign(triangleCount, false);
+            pointTriangles.resize(positions.size());
+            for (uint32_t t = 0; t < triangleCount; ++t)
+            {
+                const uint32_t a = points[corners[t * 3 + 0]], b = points[corners[t * 3 + 1]], c = points[corners[t * 3 + 2]];
+                if (a == b || b == c || c == a)
+                {// ׂĂOp`͒iɊ܂߂Ȃ
+                    deadTriangles[t] = true;
+                    continue;
+                }
+                pointTriangles[a].push_back(t);
+                pointTriangles[b].push_back(t);
+                pointTriangles[c].push_back(t);
+                ++liveTriangles;
+            }
+            ClassifyPoints();
+            ComputeQuadrics();
+
+            for (uint32_t t = 0; t < triangleCount; ++t)
+            {
+                if (deadTriangles[t])
+                {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t a = points[corners[t * 3 + k]], b = points[corners[t * 3 + (k + 1) % 3]];
+                    Push(a, b);
+                    Push(b, a);
+                }
+            }
+        }
+
+        size_t TriangleCount() const { return liveTriangles; }
+
+        // Op` targetTriangles ȉɂȂ邩Ȁǩ덷 maxError 𒴂܂ŏk񂷂
+        // ܂ł̏k̍ő̌덷Ԃ
+        float Collapse(size_t targetTriangles, float maxError)
+        {
+            while (liveTriangles > targetTriangles && !candidates.empty())
+            {
+                const Candidate candidate = candidates.top();
+                if (candidate.error > maxError)
+                {
+                    break;
+                }
+                candidates.pop();
+                if (removed[candidate.from] || removed[candidate.to] ||
+                    versions[candidate.from] != candidate.fromVersion || versions[candidate.to] != candidate.toVersion)
+                {// kŎ肪ςÂ
+                    continue;
+                }
+                if (TryCollapse(candidate.from, candidate.to))
+                {
+                    maxCollapseError = (std::max)(maxCollapseError, candidate.error);
+                }
+            }
+            return maxCollapseError;
+        }
+
+        // cĂOp`̒_ԍŏo
+        void Emit(std::vector<uint32_t>& out) const
+        {
+            out.clear();
+            out.reserve(liveTriangles * 3);
+            for (size_t t = 0; t < deadTriangles.size(); ++t)
+            {
+                if (!deadTriangles[t])
+                {
+                    out.insert(out.end(), corners.begin() + t * 3, corners.begin() + t * 3 + 3);
+                }
+            }
+        }
+
+    private:
+        enum class Kind : uint8_t
+        {
+            Interior,   // ǂ̕ɂkł
+            Border,     // J̏ (ɉĂkł)
+            Locked,     // pځE񑽗l (Ȃ)
+        };
+
+        struct Candidate
+        {
+            float error;
+            uint32_t from;
+            uint32_t to;
+            uint32_t fromVersion;
+            uint32_t toVersion;
+
+            // 덷ȂԍŌ߂ (͂瓯ʂɂ)
+            bool operator>(const Candidate& rhs) const
+            {
+                if (error != rhs.error) return error > rhs.error;
+                if (from != rhs.from) return from > rhs.from;
+                return to > rhs.to;
+            }
+        };
+
+        void WeldPositions(size_t vertexCount, const std::function<XMFLOAT3(uint32_t)>& getPosition)
+        {
+            std::vector<XMFLOAT3> wedgePositions(vertexCount);
+            std::vector<uint32_t> order(vertexCount);
+            for (uint32_t v = 0; v < vertexCount; ++v)
+            {
+                wedgePositions[v] = getPosition(v);
+                order[v] = v;
+            }
+            // ʎq_畜ʒuȂ̂ŁApڂ̒_̓rbgPʂœɂȂ
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                {
+                    return memcmp(&wedgePositions[a], &wedgePositions[b], sizeof(XMFLOAT3)) < 0;
+                });
+            points.resize(vertexCount);
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                if (i == 0 || memcmp(&wedgePositions[order[i]], &wedgePositions[order[i - 1]], sizeof(XMFLOAT3)) != 0)
+                {
+                    positions.push_back(wedgePositions[order[i]]);
+                }
+                points[order[i]] = static_cast<uint32_t>(positions.size() - 1);
+            }
+        }
+
+        void ClassifyPoints()
+        {
+            const size_t pointCount = positions.size();
+            kinds.assign(pointCount, Kind::Interior);
+            removed.assign(pointCount, false);
+            versions.assign(pointCount, 0);
+
+            // 2 ȏ̒_ (̈Ⴄʒu) _͌pڂȂ̂œȂ
+            constexpr uint32_t NoWedge = UINT32_MAX;
+            std::vector<uint32_t> wedges(pointCount, NoWedge);
+            for (size_t t = 0; t < deadTriangles.size(); ++t)
+            {
+                if (deadTriangles[t])
+                {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t wedge = corners[t * 3 + k];
+                    const uint32_t point = points[wedge];
+                    if (wedges[point] == NoWedge)
+                    {
+                        wedges[point] = wedge;
+                    }
+                    else if (wedges[point] != wedge)
+                    {
+                        kinds[point] = Kind::Locked;
+                    }
+                }
+            }
+
+            // 1 ̎Op`ɂgȂӂ͉A3 ȏ͔񑽗l
+            std::unordered_map<uint64_t, uint32_t> edgeTriangles;
+            for (size_t t = 0; t < deadTriangles.size(); ++t)
+            {
+                if (deadTriangles[t])
+                {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    ++edgeTriangles[EdgeKey(points[corners[t * 3 + k]], points[corners[t * 3 + (k + 1) % 3]])];
+                }
+            }
+            for (const auto& [key, count] : edgeTriangles)
+            {
+                if (count == 2)
+                {
+                    continue;
+                }
+                for (uint32_t point : { static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & 0xffffffff) })
+                {
+                    if (count > 2)
+                    {
+                        kinds[point] = Kind::Locked;
+                    }
+                    else if (kinds[point] == Kind::Interior)
+                    {
+                        kinds[point] = Kind::Border;
+                    }
+                }
+            }
+        }
+
+        void ComputeQuadrics()
+        {
+            // ͐ȕʂāǍ`ۂ
+            constexpr double BorderWeight = 10.0;
+
+            quadrics.assign(positions.size(), Quadric{});
+            for (size_t t = 0; t < deadTriangles.size(); ++t)
+            {
+                if (deadTriangles[t])
+                {
+                    continue;
+                }
+                const uint32_t p[3] = { points[corners[t * 3 + 0]], points[corners[t * 3 + 1]], points[corners[t * 3 + 2]] };
+                const XMVECTOR normal = TriangleNormal(positions[p[0]], positions[p[1]], positions[p[2]]);
+                const float length = XMVectorGetX(XMVector3Length(normal));
+                if (length <= 0.0f)
+                {
+                    continue;
+                }
+                XMFLOAT3 n;
+                XMStoreFloat3(&n, XMVectorScale(normal, 1.0f / length));
+                const double d = -(n.x * positions[p[0]].x + n.y * positions[p[0]].y + n.z * positions[p[0]].z);
+                // ʐςŏdݕt
+                const Quadric plane = Quadric::FromPlane(n.x, n.y, n.z, d, length * 0.5);
+                for (uint32_t point : p)
+                {
+                    quadrics[point] += plane;
+                }
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t a = p[k], b = p[(k + 1) % 3];
+                    if (kinds[a] == Kind::Interior || kinds[b] == Kind::Interior || LiveTrianglesOnEdge(a, b) != 1)
+                    {
+                        continue;
+                    }
+                    const XMVECTOR edge = XMVectorSubtract(XMLoadFloat3(&positions[b]), XMLoadFloat3(&positions[a]));
+                    const XMVECTOR perpendicular = XMVector3Cross(edge, normal);
+                    const float perpendicularLength = XMVectorGetX(XMVector3Length(perpendicular));
+                    if (perpendicularLength <= 0.0f)
+                    {
+                        continue;
+                    }
+                    XMFLOAT3 m;
+                    XMStoreFloat3(&m, XMVectorScale(perpendicular, 1.0f / perpendicularLength));
+                    const double md = -(m.x * positions[a].x + m.y * positions[a].y + m.z * positions[a].z);
+                    const Quadric border = Quadric::FromPlane(m.x, m.y, m.z, md, XMVectorGetX(XMVector3LengthSq(edge)) * BorderWeight);
+                    quadrics[a] += border;
+                    quadrics[b] += border;
+                }
+            }
+        }
+
+        static uint64_t EdgeKey(uint32_t a, uint32_t b)
+        {
+            return a < b ? (static_cast<uint64_t>(a) << 32 | b) : (static_cast<uint64_t>(b) << 32 | a);
+        }
+
+        bool HasPoint(uint32_t triangle, uint32_t point) const
+        {
+            return points[corners[triangle * 3 + 0]] == point || points[corners[triangle * 3 + 1]] == point || points[corners[triangle * 3 + 2]] == point;
+        }
+
+        size_t LiveTrianglesOnEdge(uint32_t a, uint32_t b) const
+        {
+            size_t count = 0;
+            for (uint32_t t : pointTriangles[a])
+            {
+                if (!deadTriangles[t] && HasPoint(t, b))
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // from  to Ɋ񂹂ς
+        void Push(uint32_t from, uint32_t to)
+        {
+            if (kinds[from] == Kind::Locked)
+            {
+                return;
+            }
+            if (kinds[from] == Kind::Border && LiveTrianglesOnEdge(from, to) != 1)
+            {// ̓_͉ɉĂ
+                return;
+            }
+            Quadric q = quadrics[from];
+            q += quadrics[to];
+            candidates.push({ q.Error(positions[to]), from, to, versions[from], versions[to] });
+        }
+
+        void AppendNeighbors(uint32_t point, std::vector<uint32_t>& out) const
+        {
+            for (uint32_t t : pointTriangles[point])
+            {
+                if (deadTriangles[t])
+                {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t neighbor = points[corners[t * 3 + k]];
+                    if (neighbor != point)
+                    {
+                        out.push_back(neighbor);
+                    }
+                }
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+        }
+
+        bool TryCollapse(uint32_t p, uint32_t q)
+        {
+            //  pq LOp`͏
+            shared.clear();
+            for (uint32_t t : pointTriangles[p])
+            {
+                if (!deadTriangles[t] && HasPoint(t, q))
+                {
+                    shared.push_back(t);
+                }
+            }
+            if (shared.size() != (kinds[p] == Kind::Border ? 1u : 2u))
+            {
+                return false;
+            }
+
+            // ʂׂ̗̓_Op`̕葽ƁAǩŔ񑽗l̂ɂȂ
+            neighborsP.clear();
+            neighborsQ.clear();
+            AppendNeighbors(p, neighborsP);
+            AppendNeighbors(q, neighborsQ);
+            size_t common = 0;
+            for (size_t i = 0, j = 0; i < neighborsP.size() && j < neighborsQ.size();)
+            {
+                if (neighborsP[i] < neighborsQ[j]) ++i;
+                else if (neighborsQ[j] < neighborsP[i]) ++j;
+                else { ++common; ++i; ++j; }
+            }
+            if (common != shared.size())
+            {
+                return false;
+            }
+
+            // p ̒_ q ̒_ (Op`ŎgĂ) ɒu
+            uint32_t qWedge = UINT32_MAX;
+            for (uint32_t t : shared)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t wedge = corners[t * 3 + k];
+                    if (points[wedge] != q)
+                    {
+                        continue;
+                    }
+                    if (qWedge != UINT32_MAX && qWedge != wedge)
+                    {// q ̌pڂ܂̂ő܂Ȃ
+                        return false;
+                    }
+                    qWedge = wedge;
+                }
+            }
+
+            // cOp`ԂȂ
+            for (uint32_t t : pointTriangles[p])
+            {
+                if (deadTriangles[t] || HasPoint(t, q))
+                {
+                    continue;
+                }
+                XMFLOAT3 before[3];
+                XMFLOAT3 after[3];
+                for (int k = 0; k < 3; ++k)
+                {
+                    const uint32_t point = points[corners[t * 3 + k]];
+                    before[k] = positions[point];
+                    after[k] = point == p ? positions[q] : positions[point];
+                }
+                const XMVECTOR n0 = TriangleNormal(before[0], before[1], before[2]);
+                const XMVECTOR n1 = TriangleNormal(after[0], after[1], after[2]);
+                if (XMVectorGetX(XMVector3Dot(n0, n1)) <= 0.0f)
+                {
+                    return false;
+                }
+            }
+
+            // k񂷂
+            for (uint32_t t : pointTriangles[p])
+            {
+                if (deadTriangles[t])
+                {
+                    continue;
+                }
+                if (HasPoint(t, q))
+                {
+                    deadTriangles[t] = true;
+                    --liveTriangles;
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (points[corners[t * 3 + k]] == p)
+                    {
+                        corners[t * 3 + k] = qWedge;
+                    }
+                }
+                pointTriangles[q].push_back(t);
+            }
+            std::vector<uint32_t>& qTriangles = pointTriangles[q];
+            qTriangles.erase(std::remove_if(qTriangles.begin(), qTriangles.end(), [&](uint32_t t) { return deadTriangles[t]; }), qTriangles.end());
+            pointTriangles[p].clear();
+            pointTriangles[p].shrink_to_fit();
+            removed[p] = true;
+            quadrics[q] += quadrics[p];
+            ++versions[q];
+
+            // q ̎̕ӂ̌ςݒ
+            neighborsQ.clear();
+            AppendNeighbors(q, neighborsQ);
+            for (uint32_t neighbor : neighborsQ)
+            {
+                Push(q, neighbor);
+                Push(neighbor, q);
+            }
+            return true;
+        }
+
+        // _ (wedge) Ƃ̓_̔ԍƁA_̈ʒu
+        std::vector<uint32_t> points;
+        std::vector<XMFLOAT3> positions;
+        // Op`̒_ԍ (kŏ)
+        std::vector<uint32_t> corners;
+        std::vector<bool> deadTriangles;
+        size_t liveTriangles = 0;
+
+        // _Ƃ̏
+        std::vector<std::vector<uint32_t>> pointTriangles;
+        std::vector<Kind> kinds;
+        std::vector<Quadric> quadrics;
+        std::vector<uint32_t> versions;
+        std::vector<bool> removed;
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+        float maxCollapseError = 0.0f;
+
+        // TryCollapse ̍Ɨp
+        std::vector<uint32_t> shared;
+        std::vector<uint32_t> neighborsP;
+        std::vector<uint32_t> neighborsQ;
+    };
+}
+
+std::vector<MeshSimplifier::Lod> MeshSimplifier::GenerateLods(std::vector<uint32_t>& indices, size_t vertexCount,
+    const std::function<XMFLOAT3(uint32_t)>& getPosition, const Options& options, float* extent)
+{
+    if (!options.enable || options.levelCount <= 0 || indices.size() < 3 || indices.size() % 3 != 0 || !getPosition)
+    {
+        return {};
+    }
+    XMVECTOR minimum = XMVectorReplicate(FLT_MAX);
+    XMVECTOR maximum = XMVectorReplicate(-FLT_MAX);
+    for (uint32_t index : indices)
+    {
+        if (index >= vertexCount)
+        {// ꂽCfbNX͌炳Ȃ
+            return {};
+        }
+        const XMFLOAT3 position = getPosition(index);
+        minimum = XMVectorMin(minimum, XMLoadFloat3(&position));
+        maximum = XMVectorMax(maximum, XMLoadFloat3(&position));
+    }
+    const float diagonal = XMVectorGetX(XMVector3Length(XMVectorSubtract(maximum, minimum)));
+    if (extent)
+    {
+        *extent = diagonal;
+    }
+    if (!(diagonal > 0.0f))
+    {
+        return {};
+    }
+
+    std::vector<Lod> lods{ { 0, static_cast<uint32_t>(indices.size()), 0.0f } };
+    Simplifier simplifier(indices, vertexCount, getPosition);
+    const int levelCount = (std::min)(options.levelCount, static_cast<int>(MaxLodCount) - 1);
+    std::vector<uint32_t> lodIndices;
+    for (int level = 0; level < levelCount; ++level)
+    {
+        const size_t previous = simplifier.TriangleCount();
+        const size_t target = static_cast<size_t>(previous * options.reduction);
+        const float error = simplifier.Collapse(target, options.maxError * diagonal);
+        const size_t remaining = simplifier.TriangleCount();
+        if (remaining == 0 || remaining > previous * options.minReduction)
+        {// 덷̏Epڂłȏ㌸点Ȃ
+            break;
+        }
+        simplifier.Emit(lodIndices);
+        if (options.cacheSize > 0)
+        {
+            lodIndices = MeshOptimizer::OptimizeVertexCache(lodIndices, vertexCount, options.cacheSize);
+        }
+        lods.push_back({ static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(lodIndices.size()), error });
+        indices.insert(indices.end(), lodIndices.begin(), lodIndices.end());
+    }
+    if (lods.size() == 1)
+    {
+        return {};
+    }
+    return lods;
+}
+
+MeshSimplifier::Lod MeshSimplifier::GetLod(const std::vector<Lod>& lods, int lod, uint32_t indexCount)
+{
+    if (lods.empty())
+    {
+        return { 0, indexCount, 0.0f };
+    }
+    return lods[(std::clamp)(lod, 0, static_cast<int>(lods.size()) - 1)];
+}
+
+int MeshSimplifier::SelectLod(const float* errors, size_t count, float pixelsPerUnit, float threshold, float hysteresis, int current)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    current = (std::clamp)(current, 0, static_cast<int>(count) - 1);
+    int target = 0;
+    for (int level = static_cast<int>(count) - 1; level > 0; --level)
+    {
+        if (errors[level] * pixelsPerUnit <= threshold)
+        {
+            target = level;
+            break;
+        }
+    }
+    if (target > current)
+    {// e鎞臒l菭Ȃ܂ő҂ (ׂ鎞͂ɐ؂ւ)
+        const float coarser = threshold * (1.0f - hysteresis);
+        while (target > current && errors[target] * pixelsPerUnit > coarser)
+        {
+            --target;
+        }
+    }
+    return target;
+}
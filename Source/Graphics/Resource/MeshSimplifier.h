@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <DirectXMath.h>
+
+// C|[g (LbV鎞) ɍ LOD (ڍדx) ̃CfbNX
+//   񎟌덷 (Garland & Heckbert 1997) ŕӂk񂵂ĎOp`炷
+//   k͕Б̒_Е֊񂹂 (half-edge collapse) Ȃ̂ŁASĂ̒i̒_obt@Lł
+//   i͂ЂƂO̒i𑱂Č炵č (덷͒iiނقǑ傫Ȃ)
+//   UVE@̌pځAJ͌`Ȃ悤ɏk𐧌
+// S CPU ݂̂ŁA͂͏ɓʂɂȂ
+class MeshSimplifier
+{
+public:
+    // ̃bV (0 i) ܂߂ő̒i (MappedCache::MaxLodCount Ƒ)
+    static constexpr uint32_t MaxLodCount = 4;
+
+    struct Options
+    {
+        bool enable = true;
+        int levelCount = 3;             // 0 iڂ̑ɍi (MaxLodCount - 1 ܂)
+        float reduction = 0.5f;         // iƂ̎Op`̐̊
+        float maxError = 0.05f;         // 덷̏ (oEfBO{bNX̑Ίpɑ΂銄)BiȂ
+        float minReduction = 0.9f;      // Op`̊܂łȂi͍Ȃ
+        int cacheSize = 16;             // iבւ钸_LbV̑傫 (0 ȂבւȂ)
+
+        // LbVɋL^āAݒ肪ς蒼
+        uint32_t Hash() const;
+    };
+
+    // CfbNXobt@̒ 1 i͈̔
+    struct Lod
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;             // ̃bV̖̋ڈ (fԂ̒)
+    };
+
+    // LOD  (bVƂ̒i̎Op`̐ƌ덷)
+    struct Report
+    {
+        struct Entry
+        {
+            std::string name;
+            size_t vertexCount = 0;
+            float extent = 0.0f;        // oEfBO{bNX̑Ίp̒
+            std::vector<Lod> lods;
+        };
+        std::vector<Entry> entries;
+        double milliseconds = 0.0;
+
+        std::string ToString() const;
+    };
+
+    // indices (Op`Xg) ̌ 1 iڂ̎Op`ǉāASĂ̒i͈̔͂Ԃ (擪̃bV)
+    // ꂽCfbNXE点ȂbV͉ȂŋԂBextent ɂ̓oEfBO{bNX̑Ίp̒Ԃ
+    static std::vector<Lod> GenerateLods(std::vector<uint32_t>& indices, size_t vertexCount,
+        const std::function<DirectX::XMFLOAT3(uint32_t)>& getPosition, const Options& options, float* extent = nullptr);
+
+    // lod iڂ͈̔ (i΍Ō̒iAlods ȂCfbNXS)
+    static Lod GetLod(const std::vector<Lod>& lods, int lod, uint32_t indexCount);
+
+    // ʏ̌덷 (sNZ)  threshold ȉɂȂԑeiI
+    // errors ͒iƂ̌덷ApixelsPerUnit ͒ 1 ʏŉsNZɂȂ邩
+    // e鎞 threshold * (1 - hysteresis) ȉɂȂ܂ő҂āAڂŒisȂ悤ɂ
+    static int SelectLod(const float* errors, size_t count, float pixelsPerUnit, float threshold, float hysteresis, int current);
+};
@@ -0,0 +1,299 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+
+#include "Engine/Utility/Deterministic.h"
+
+using namespace DirectX;
+
+uint32_t MeshletBuilder::Options::Hash() const
+{
+    return Deterministic::Fnv1a32(
+        {
+            enable ? 1u : 0u, static_cast<uint32_t>(maxVertices), static_cast<uint32_t>(maxTriangles), static_cast<uint32_t>(minTriangles),
+        });
+}
+
+void MeshletBuilder::Clusters::Assign(const std::vector<Meshlet>& meshlets)
+{
+    count = meshlets.size();
+    triangleCount = 0;
+    // 4 ǂ߂悤ɗ]𖄂߂ (]͔肵ĂʂɓȂ)
+    const size_t paddedCount = (count + 3) & ~static_cast<size_t>(3);
+    for (std::vector<float>* values : { &centerX, &centerY, &centerZ, &axisX, &axisY, &axisZ })
+    {
+        values->assign(paddedCount, 0.0f);
+    }
+    radius.assign(paddedCount, 0.0f);
+    cutoff.assign(paddedCount, 1.0f);
+    firstIndex.assign(count, 0);
+    indexCount.assign(count, 0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Meshlet& meshlet = meshlets[i];
+        centerX[i] = meshlet.center.x;
+        centerY[i] = meshlet.center.y;
+        centerZ[i] = meshlet.center.z;
+        radius[i] = meshlet.radius;
+        axisX[i] = meshlet.coneAxis.x;
+        axisY[i] = meshlet.coneAxis.y;
+        axisZ[i] = meshlet.coneAxis.z;
+        cutoff[i] = meshlet.coneCutoff;
+        firstIndex[i] = meshlet.firstIndex;
+        indexCount[i] = meshlet.indexCount;
+        triangleCount += meshlet.indexCount / 3;
+    }
+}
+
+std::string MeshletBuilder::Report::ToString() const
+{
+    std::string text;
+    size_t totalTriangles = 0;
+    size_t totalMeshlets = 0;
+    for (const Entry& entry : entries)
+    {
+        size_t coneCount = 0;
+        for (const Meshlet& meshlet : entry.meshlets)
+        {
+            coneCount += meshlet.coneCutoff < 1.0f ? 1 : 0;
+        }
+        const size_t meshletCount = (std::max)(entry.meshlets.size(), static_cast<size_t>(1));
+        char buf[192];
+        sprintf_s(buf, "  %s : %zu tris -> %zu meshlets (avg %.1f verts, %.1f tris, cone %.1f%%)\n", entry.name.c_str(), entry.triangleCount, entry.meshlets.size(),
+            static_cast<float>(entry.vertexTotal) / meshletCount, static_cast<float>(entry.triangleCount) / meshletCount, 100.0f * coneCount / meshletCount);
+        text += buf;
+        if (!entry.meshlets.empty())
+        {
+            totalTriangles += entry.triangleCount;
+            totalMeshlets += entry.meshlets.size();
+        }
+    }
+    char buf[128];
+    sprintf_s(buf, "  total %zu tris in %zu meshlets (%.3f ms)\n", totalTriangles, totalMeshlets, milliseconds);
+    return text + buf;
+}
+
+std::vector<MeshletBuilder::Meshlet> MeshletBuilder::Build(std::vector<uint32_t>& indices, uint32_t firstIndex, uint32_t indexCount, size_t vertexCount,
+    const std::function<XMFLOAT3(uint32_t)>& getPosition, const Options& options, bool coneCulling, size_t* vertexTotal)
+{
+    const size_t triangleCount = indexCount / 3;
+    const size_t maxVertices = static_cast<size_t>((std::clamp)(options.maxVertices, 3, static_cast<int>(MaxVertices)));
+    const size_t maxTriangles = static_cast<size_t>((std::clamp)(options.maxTriangles, 1, static_cast<int>(MaxTriangles)));
+    if (!options.enable || triangleCount == 0 || triangleCount < static_cast<size_t>((std::max)(options.minTriangles, 0)) ||
+        static_cast<size_t>(firstIndex) + indexCount > indices.size())
+    {
+        return {};
+    }
+    const uint32_t* triangles = indices.data() + firstIndex;
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        if (triangles[i] >= vertexCount)
+        {
+            return {};
+        }
+    }
+
+    std::vector<XMFLOAT3> positions(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        positions[v] = getPosition(static_cast<uint32_t>(v));
+    }
+
+    // _Op`\
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        ++adjacencyOffsets[triangles[i] + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            adjacency[fill[triangles[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    // ʂ̌ (ʐ 0 ̎Op`͌Ȃ)
+    std::vector<XMFLOAT3> faceNormals(triangleCount);
+    std::vector<uint8_t> hasNormal(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        const XMVECTOR p0 = XMLoadFloat3(&positions[triangles[t * 3 + 0]]);
+        const XMVECTOR p1 = XMLoadFloat3(&positions[triangles[t * 3 + 1]]);
+        const XMVECTOR p2 = XMLoadFloat3(&positions[triangles[t * 3 + 2]]);
+        // glTF ͔v肪\
+        const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+        const float length = XMVectorGetX(XMVector3Length(normal));
+        if (length > FLT_MIN)
+        {
+            XMStoreFloat3(&faceNormals[t], XMVectorScale(normal, 1.0f / length));
+            hasNormal[t] = 1;
+        }
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    // _ǂ̉ɓĂ邩 (̔ԍ)
+    std::vector<uint32_t> vertexOwner(vertexCount, UINT32_MAX);
+    std::vector<uint32_t> order;
+    order.reserve(triangleCount);
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint32_t> meshletTriangles;
+    size_t cursor = 0;
+    size_t totalVertices = 0;
+
+    while (order.size() < triangleCount)
+    {
+        const uint32_t id = static_cast<uint32_t>(meshlets.size());
+        meshletVertices.clear();
+        meshletTriangles.clear();
+        auto newVertexCount = [&](size_t t)
+            {
+                size_t added = 0;
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    added += vertexOwner[triangles[t * 3 + corner]] != id ? 1 : 0;
+                }
+                return added;
+            };
+        auto add = [&](size_t t)
+            {
+                for (int corner = 0; corner < 3; ++corner)
+                {
+                    const uint32_t vertex = triangles[t * 3 + corner];
+                    if (vertexOwner[vertex] != id)
+                    {
+                        vertexOwner[vertex] = id;
+                        meshletVertices.push_back(vertex);
+                    }
+                }
+                emitted[t] = 1;
+                meshletTriangles.push_back(static_cast<uint32_t>(t));
+                order.push_back(static_cast<uint32_t>(t));
+            };
+
+        // ̕ (_LbV) ōŏ̎c̎Op`n߂
+        while (emitted[cursor])
+        {
+            ++cursor;
+        }
+        add(cursor);
+        while (meshletTriangles.size() < maxTriangles)
+        {
+            // ̒_ɌqOp`̂A钸_ԏȂ (Ȃ猳̕тŐ̂)
+            size_t best = SIZE_MAX;
+            size_t bestAdded = SIZE_MAX;
+            for (size_t i = 0; i < meshletVertices.size(); ++i)
+            {
+                const uint32_t vertex = meshletVertices[i];
+                for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a)
+                {
+                    const uint32_t t = adjacency[a];
+                    if (emitted[t])
+                    {
+                        continue;
+                    }
+                    const size_t added = newVertexCount(t);
+                    if (meshletVertices.size() + added <= maxVertices && (added < bestAdded || (added == bestAdded && t < best)))
+                    {
+                        best = t;
+                        bestAdded = added;
+                    }
+                }
+            }
+            if (best == SIZE_MAX && meshletTriangles.size() * 2 < maxTriangles)
+            {// qOp`ȉ́A̕тŎ̎Op`Ŗ߂ (ꂽ 1 ̉ɂȂȂ悤)
+                size_t next = cursor;
+                while (next < triangleCount && emitted[next])
+                {
+                    ++next;
+                }
+                if (next < triangleCount && meshletVertices.size() + newVertexCount(next) <= maxVertices)
+                {
+                    best = next;
+                }
+            }
+            if (best == SIZE_MAX)
+            {
+                break;
+            }
+            add(best);
+        }
+
+        // oEfBOXtBA (AABB ̒Sԉ_܂)
+        Meshlet& meshlet = meshlets.emplace_back();
+        meshlet.firstIndex = firstIndex + static_cast<uint32_t>((order.size() - meshletTriangles.size()) * 3);
+        meshlet.indexCount = static_cast<uint32_t>(meshletTriangles.size() * 3);
+        XMVECTOR minimum = XMVectorReplicate(FLT_MAX);
+        XMVECTOR maximum = XMVectorReplicate(-FLT_MAX);
+        for (uint32_t vertex : meshletVertices)
+        {
+            const XMVECTOR position = XMLoadFloat3(&positions[vertex]);
+            minimum = XMVectorMin(minimum, position);
+            maximum = XMVectorMax(maximum, position);
+        }
+        const XMVECTOR center = XMVectorScale(XMVectorAdd(minimum, maximum), 0.5f);
+        float radius = 0.0f;
+        for (uint32_t vertex : meshletVertices)
+        {
+            radius = (std::max)(radius, XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&positions[vertex]), center))));
+        }
+        XMStoreFloat3(&meshlet.center, center);
+        meshlet.radius = radius;
+        totalVertices += meshletVertices.size();
+
+        // @̉~ : ͖ʂ̌̕ρAԊOꂽʂƂ̊px cutoff = sin ߂
+        // 90 x߂܂ŊJ͑IʂĂO邾Ȃ̂ōȂ
+        if (coneCulling)
+        {
+            XMVECTOR axis = XMVectorZero();
+            for (uint32_t t : meshletTriangles)
+            {
+                if (hasNormal[t])
+                {
+                    axis = XMVectorAdd(axis, XMLoadFloat3(&faceNormals[t]));
+                }
+            }
+            const float axisLength = XMVectorGetX(XMVector3Length(axis));
+            if (axisLength > FLT_MIN)
+            {
+                axis = XMVectorScale(axis, 1.0f / axisLength);
+                float minDot = 1.0f;
+                for (uint32_t t : meshletTriangles)
+                {
+                    if (hasNormal[t])
+                    {
+                        minDot = (std::min)(minDot, XMVectorGetX(XMVector3Dot(axis, XMLoadFloat3(&faceNormals[t]))));
+                    }
+                }
+                if (minDot > 0.1f)
+                {
+                    XMStoreFloat3(&meshlet.coneAxis, axis);
+                    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+                }
+            }
+        }
+    }
+
+    // ̏ɃCfbNX
+    std::vector<uint32_t> reordered;
+    reordered.reserve(triangleCount * 3);
+    for (uint32_t t : order)
+    {
+        reordered.insert(reordered.end(), { triangles[t * 3 + 0], triangles[t * 3 + 1], triangles[t * 3 + 2] });
+    }
+    std::copy(reordered.begin(), reordered.end(), indices.begin() + firstIndex);
+    if (vertexTotal)
+    {
+        *vertexTotal = totalVertices;
+    }
+    return meshlets;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <DirectXMath.h>
+
+// C|[g (LbV鎞) ɑ傫ȃob`bVbVbg (ȎOp`̉) ɕ
+//   _ 64 EOp` 124 ܂ł̉A_LOp`珇×~ɏW߂č
+//   򂲂Ƃ̎Op`ĕԂ悤ɃCfbNX (0 iڂ͈̔͂) בւ̂ŁA 1 ̕`͈͂ɂȂ
+//   򂲂ƂɃoEfBOXtBAƁAʂ̌܂Ƃ߂@̉~ (̑Iʗp) 
+// t[̑Iʂ MeshletCulling ōs
+class MeshletBuilder
+{
+public:
+    static constexpr uint32_t MaxVertices = 64;
+    static constexpr uint32_t MaxTriangles = 124;
+
+    struct Options
+    {
+        bool enable = true;
+        int maxVertices = MaxVertices;  // ̒_̐̏
+        int maxTriangles = MaxTriangles;// ̎Op`̐̏
+        int minTriangles = 4096;        // Op`̏ȂbV͕Ȃ (`͈͂邾Ȃ̂)
+
+        // LbVɋL^āAݒ肪ς蒼
+        uint32_t Hash() const;
+    };
+
+    // CfbNXobt@̒ 1 ̉ (MappedCache::MeshletRecord Ɠ)
+    struct Meshlet
+    {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        DirectX::XMFLOAT3 center = { 0, 0, 0 };    // oEfBOXtBA (f)
+        float radius = 0.0f;
+        DirectX::XMFLOAT3 coneAxis = { 0, 0, 1 };   // ʂ̌̕
+        float coneCutoff = 1.0f;                    // 1 Ȃ痠̑IʂȂ
+    };
+
+    // t[̑Iʗp 4 ǂ߂悤ɕג (vf̐ 4 ̔{ɐ؂グ)
+    struct Clusters
+    {
+        std::vector<float> centerX, centerY, centerZ, radius;
+        std::vector<float> axisX, axisY, axisZ, cutoff;
+        std::vector<uint32_t> firstIndex, indexCount;
+        size_t count = 0;
+        uint32_t triangleCount = 0;
+
+        void Assign(const std::vector<Meshlet>& meshlets);
+        bool empty() const { return count == 0; }
+    };
+
+    // ɕ (bVƂ̉̐Ƒ傫)
+    struct Report
+    {
+        struct Entry
+        {
+            std::string name;
+            size_t triangleCount = 0;
+            std::vector<Meshlet> meshlets;
+            size_t vertexTotal = 0;     // 򂲂Ƃ̒_̐̍v (L_򂲂Ƃɐ)
+        };
+        std::vector<Entry> entries;
+        double milliseconds = 0.0;
+
+        std::string ToString() const;
+    };
+
+    // indices[firstIndex, firstIndex + indexCount) ̎Op`ɕāȀɂ͈̔͂בւ
+    // Op` minTriangles 菭ȂEꂽCfbNX͉ȂŋԂ
+    // coneCulling  false (ʂ̃}eAȂ) Ȃ~Ȃ
+    // vertexTotal ɂ͉򂲂Ƃ̒_̐̍vԂ
+    static std::vector<Meshlet> Build(std::vector<uint32_t>& indices, uint32_t firstIndex, uint32_t indexCount, size_t vertexCount,
+        const std::function<DirectX::XMFLOAT3(uint32_t)>& getPosition, const Options& options, bool coneCulling, size_t* vertexTotal = nullptr);
+};
@@ -9,6 +9,7 @@
 #include <string>   
 
 #include "Engine/Utility/Win32Utils.h"
+#include "Graphics/Sprite/TextureAtlas.h"
 using namespace DirectX;
 
 using namespace std;
@@ -128,4 +129,5 @@ HRESULT LoadTextureFromMemory(ID3D11Device* device, const void* data, size_t siz
 void ReleaseAllTextures()
 {
     resources.clear();// eNX`LbVNA
+    TextureAtlas::Get().Clear();// AgX̃y[W蒼
 }
\ No newline at end of file
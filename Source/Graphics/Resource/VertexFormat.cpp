@@ -0,0 +1,678 @@
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <DirectXPackedVector.h>
+
+#include "Engine/Utility/Deterministic.h"
+
+namespace
+{
+    UINT PositionSize(VertexFormat::Position position)
+    {
+        return position == VertexFormat::Position::Unorm16 ? 8 : 12;
+    }
+    UINT NormalSize(VertexFormat::Direction normal)
+    {
+        return normal == VertexFormat::Direction::Octahedral ? 4 : 12;
+    }
+    UINT TangentSize(VertexFormat::Direction tangent)
+    {
+        return tangent == VertexFormat::Direction::Octahedral ? 4 : 16;
+    }
+    UINT TexcoordSize(VertexFormat::Texcoord texcoord)
+    {
+        return texcoord == VertexFormat::Texcoord::Half2 ? 4 : 8;
+    }
+    UINT JointsSize(VertexFormat::Joints joints)
+    {
+        switch (joints)
+        {
+        case VertexFormat::Joints::Uint8: return 4;
+        case VertexFormat::Joints::Uint16: return 8;
+        case VertexFormat::Joints::Uint32: return 16;
+        default: return 0;
+        }
+    }
+    UINT WeightsSize(VertexFormat::Weights weights)
+    {
+        switch (weights)
+        {
+        case VertexFormat::Weights::Unorm8: return 4;
+        case VertexFormat::Weights::Unorm16: return 8;
+        case VertexFormat::Weights::Float: return 16;
+        default: return 0;
+        }
+    }
+    DXGI_FORMAT JointsFormat(VertexFormat::Joints joints)
+    {
+        switch (joints)
+        {
+        case VertexFormat::Joints::Uint8: return DXGI_FORMAT_R8G8B8A8_UINT;
+        case VertexFormat::Joints::Uint16: return DXGI_FORMAT_R16G16B16A16_UINT;
+        default: return DXGI_FORMAT_R32G32B32A32_UINT;
+        }
+    }
+    DXGI_FORMAT WeightsFormat(VertexFormat::Weights weights)
+    {
+        switch (weights)
+        {
+        case VertexFormat::Weights::Unorm8: return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case VertexFormat::Weights::Unorm16: return DXGI_FORMAT_R16G16B16A16_UNORM;
+        default: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        }
+    }
+
+    template<class T>
+    void Store(unsigned char* destination, const T& value)
+    {
+        memcpy(destination, &value, sizeof(T));
+    }
+    template<class T>
+    T Load(const unsigned char* source)
+    {
+        T value;
+        memcpy(&value, source, sizeof(T));
+        return value;
+    }
+
+    // SNORM (D3D ̕ϊK: -MAX  -1 Ɋۂ߂)
+    int QuantizeSnorm(float value, int maxValue)
+    {
+        return static_cast<int>(std::lround(std::clamp(value, -1.0f, 1.0f) * maxValue));
+    }
+    float DequantizeSnorm(int value, int maxValue)
+    {
+        return (std::max)(static_cast<float>(value) / maxValue, -1.0f);
+    }
+
+    // ʑ̎ʑ
+    DirectX::XMFLOAT2 OctEncode(const DirectX::XMFLOAT3& n)
+    {
+        const float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+        if (l1 <= 0.0f)
+        {
+            return { 0.0f, 0.0f };
+        }
+        DirectX::XMFLOAT2 e = { n.x / l1, n.y / l1 };
+        if (n.z < 0.0f)
+        {
+            const float x = e.x;
+            e.x = (1.0f - fabsf(e.y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            e.y = (1.0f - fabsf(x)) * (e.y >= 0.0f ? 1.0f : -1.0f);
+        }
+        return e;
+    }
+    DirectX::XMFLOAT3 OctDecode(float x, float y)
+    {
+        DirectX::XMFLOAT3 n = { x, y, 1.0f - fabsf(x) - fabsf(y) };
+        const float t = (std::max)(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        DirectX::XMStoreFloat3(&n, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&n)));
+        return n;
+    }
+    // ʎqɈԋ߂Ȃiq_lI
+    void OctEncodeSnorm(const DirectX::XMFLOAT3& direction, int maxValue, int& x, int& y)
+    {
+        DirectX::XMFLOAT3 n;
+        DirectX::XMStoreFloat3(&n, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&direction)));
+        const DirectX::XMFLOAT2 e = OctEncode(n);
+        const int baseX = static_cast<int>(std::floor(std::clamp(e.x, -1.0f, 1.0f) * maxValue));
+        const int baseY = static_cast<int>(std::floor(std::clamp(e.y, -1.0f, 1.0f) * maxValue));
+        float best = -2.0f;
+        x = QuantizeSnorm(e.x, maxValue);
+        y = QuantizeSnorm(e.y, maxValue);
+        for (int dy = 0; dy <= 1; ++dy)
+        {
+            for (int dx = 0; dx <= 1; ++dx)
+            {
+                const int cx = (std::min)(baseX + dx, maxValue);
+                const int cy = (std::min)(baseY + dy, maxValue);
+                const DirectX::XMFLOAT3 decoded = OctDecode(DequantizeSnorm(cx, maxValue), DequantizeSnorm(cy, maxValue));
+                const float d = decoded.x * n.x + decoded.y * n.y + decoded.z * n.z;
+                if (d > best)
+                {
+                    best = d;
+                    x = cx;
+                    y = cy;
+                }
+            }
+        }
+    }
+
+    uint16_t QuantizeUnorm16(float value)
+    {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    float AngleDegrees(const DirectX::XMFLOAT3& a, const DirectX::XMFLOAT3& b)
+    {
+        const DirectX::XMVECTOR va = DirectX::XMLoadFloat3(&a);
+        const DirectX::XMVECTOR vb = DirectX::XMLoadFloat3(&b);
+        if (DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(va)) <= 0.0f || DirectX::XMVectorGetX(DirectX::XMVector3LengthSq(vb)) <= 0.0f)
+        {
+            return 0.0f;
+        }
+        const float d = DirectX::XMVectorGetX(DirectX::XMVector3Dot(DirectX::XMVector3Normalize(va), DirectX::XMVector3Normalize(vb)));
+        return DirectX::XMConvertToDegrees(acosf(std::clamp(d, -1.0f, 1.0f)));
+    }
+
+    // Sg̍v 1 ɂȂ悤ɑEFCg
+    void NormalizedWeights(const VertexFormatBuilder::Attributes& vertex, int sets, float weights[8])
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < 8; ++i)
+        {
+            const DirectX::XMFLOAT4& w = vertex.weights[i / 4];
+            weights[i] = i / 4 < sets ? (&w.x)[i % 4] : 0.0f;
+            weights[i] = (std::max)(weights[i], 0.0f);
+            sum += weights[i];
+        }
+        if (sum > 0.0f)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                weights[i] /= sum;
+            }
+        }
+    }
+}
+
+const unsigned char VertexFormat::SkinDefaults[16] =
+{
+    0, 0, 0, 0,     // JOINTS 0
+    0, 0, 0, 0,     // JOINTS 1
+    255, 0, 0, 0,   // WEIGHTS 0
+    0, 0, 0, 0,     // WEIGHTS 1
+};
+
+VertexFormat VertexFormat::FullPrecision(bool hasSkin)
+{
+    VertexFormat format;
+    if (hasSkin)
+    {
+        format.joints = Joints::Uint32;
+        format.weights = Weights::Float;
+        format.influenceSets = 2;
+    }
+    return format;
+}
+
+UINT VertexFormat::NormalOffset() const
+{
+    return PositionOffset() + PositionSize(position);
+}
+
+UINT VertexFormat::TangentOffset() const
+{
+    return NormalOffset() + NormalSize(normal);
+}
+
+UINT VertexFormat::TexcoordOffset() const
+{
+    return TangentOffset() + TangentSize(tangent);
+}
+
+UINT VertexFormat::JointsOffset(int set) const
+{
+    return TexcoordOffset() + TexcoordSize(texcoord) + set * JointsSize(joints);
+}
+
+UINT VertexFormat::WeightsOffset(int set) const
+{
+    return JointsOffset(influenceSets) + set * WeightsSize(weights);
+}
+
+UINT VertexFormat::Stride() const
+{
+    return WeightsOffset(influenceSets);
+}
+
+uint32_t VertexFormat::ShaderFlags() const
+{
+    uint32_t flags = 0;
+    if (position == Position::Unorm16)
+    {
+        flags |= QuantizedPosition;
+    }
+    if (normal == Direction::Octahedral)
+    {
+        flags |= OctahedralNormal;
+    }
+    if (tangent == Direction::Octahedral)
+    {
+        flags |= OctahedralTangent;
+    }
+    return flags;
+}
+
+uint32_t VertexFormat::LayoutKey() const
+{
+    return static_cast<uint32_t>(position)
+        | static_cast<uint32_t>(normal) << 1
+        | static_cast<uint32_t>(tangent) << 2
+        | static_cast<uint32_t>(texcoord) << 3
+        | static_cast<uint32_t>(joints) << 4
+        | static_cast<uint32_t>(weights) << 6
+        | static_cast<uint32_t>(influenceSets) << 8;
+}
+
+VertexFormat VertexFormat::FromLayoutKey(uint32_t key)
+{
+    VertexFormat format;
+    format.position = static_cast<Position>(key & 0x01);
+    format.normal = static_cast<Direction>((key >> 1) & 0x01);
+    format.tangent = static_cast<Direction>((key >> 2) & 0x01);
+    format.texcoord = static_cast<Texcoord>((key >> 3) & 0x01);
+    format.joints = static_cast<Joints>((key >> 4) & 0x03);
+    format.weights = static_cast<Weights>((key >> 6) & 0x03);
+    format.influenceSets = static_cast<uint8_t>((key >> 8) & 0x03);
+    return format;
+}
+
+std::string VertexFormat::ToString() const
+{
+    static const char* jointNames[] = { "-", "u8", "u16", "u32" };
+    static const char* weightNames[] = { "-", "unorm8", "unorm16", "float" };
+    std::string text;
+    text += position == Position::Unorm16 ? "pos unorm16" : "pos float3";
+    text += normal == Direction::Octahedral ? ", nrm oct16" : ", nrm float3";
+    text += tangent == Direction::Octahedral ? ", tan oct8" : ", tan float4";
+    text += texcoord == Texcoord::Half2 ? ", uv half2" : ", uv float2";
+    if (influenceSets > 0)
+    {
+        text += ", joints " + std::string(jointNames[static_cast<int>(joints)]) + "x" + std::to_string(influenceSets);
+        text += ", weights " + std::string(weightNames[static_cast<int>(weights)]) + "x" + std::to_string(influenceSets);
+    }
+    text += " (" + std::to_string(Stride()) + " bytes)";
+    return text;
+}
+
+void VertexFormat::MakeInputElements(std::vector<D3D11_INPUT_ELEMENT_DESC>& elements, bool requireSkin, UINT defaultSlot) const
+{
+    elements.push_back({ "POSITION", 0, position == Position::Unorm16 ? DXGI_FORMAT_R16G16B16A16_UNORM : DXGI_FORMAT_R32G32B32_FLOAT, 0, PositionOffset(), D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    elements.push_back({ "NORMAL", 0, normal == Direction::Octahedral ? DXGI_FORMAT_R16G16_SNORM : DXGI_FORMAT_R32G32B32_FLOAT, 0, NormalOffset(), D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    elements.push_back({ "TANGENT", 0, tangent == Direction::Octahedral ? DXGI_FORMAT_R8G8B8A8_SNORM : DXGI_FORMAT_R32G32B32A32_FLOAT, 0, TangentOffset(), D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    elements.push_back({ "TEXCOORD", 0, texcoord == Texcoord::Half2 ? DXGI_FORMAT_R16G16_FLOAT : DXGI_FORMAT_R32G32_FLOAT, 0, TexcoordOffset(), D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    for (int set = 0; set < influenceSets; ++set)
+    {
+        elements.push_back({ "JOINTS", static_cast<UINT>(set), JointsFormat(joints), 0, JointsOffset(set), D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    }
+    for (int set = 0; set < influenceSets; ++set)
+    {
+        elements.push_back({ "WEIGHTS", static_cast<UINT>(set), WeightsFormat(weights), 0, WeightsOffset(set), D3D11_INPUT_PER_VERTEX_DATA, 0 });
+    }
+    if (requireSkin)
+    {
+        // SCX^XŐ擪̗vfǂ (CSM  DrawIndexedInstanced łi߂Ȃ)
+        const UINT stepRate = 0xFFFFFFFF;
+        for (int set = influenceSets; set < 2; ++set)
+        {
+            elements.push_back({ "JOINTS", static_cast<UINT>(set), DXGI_FORMAT_R8G8B8A8_UINT, defaultSlot, static_cast<UINT>(set * 4), D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+            elements.push_back({ "WEIGHTS", static_cast<UINT>(set), DXGI_FORMAT_R8G8B8A8_UNORM, defaultSlot, static_cast<UINT>(8 + set * 4), D3D11_INPUT_PER_INSTANCE_DATA, stepRate });
+        }
+    }
+}
+
+uint32_t VertexFormatBuilder::Options::Hash() const
+{
+    return Deterministic::Fnv1a32(
+        {
+            quantizePosition ? 1u : 0u, octahedralNormal ? 1u : 0u, octahedralTangent ? 1u : 0u,
+            halfTexcoord ? 1u : 0u, compactSkin ? 1u : 0u, static_cast<uint32_t>(weightBits), Deterministic::FloatBits(maxTexcoordError),
+        });
+}
+
+VertexFormat VertexFormatBuilder::Choose(const std::vector<Attributes>& vertices, bool hasSkin, const Options& options)
+{
+    VertexFormat format;
+    format.position = options.quantizePosition ? VertexFormat::Position::Unorm16 : VertexFormat::Position::Float3;
+    format.normal = options.octahedralNormal ? VertexFormat::Direction::Octahedral : VertexFormat::Direction::Float;
+    format.tangent = options.octahedralTangent ? VertexFormat::Direction::Octahedral : VertexFormat::Direction::Float;
+
+    if (options.halfTexcoord)
+    {
+        using DirectX::PackedVector::XMConvertFloatToHalf;
+        using DirectX::PackedVector::XMConvertHalfToFloat;
+        // ^CO UV 傫 half ̐xȂȂ
+        const bool fits = std::all_of(vertices.begin(), vertices.end(), [&](const Attributes& vertex)
+            {
+                const float u = XMConvertHalfToFloat(XMConvertFloatToHalf(vertex.texcoord.x));
+                const float v = XMConvertHalfToFloat(XMConvertFloatToHalf(vertex.texcoord.y));
+                return fabsf(u - vertex.texcoord.x) <= options.maxTexcoordError && fabsf(v - vertex.texcoord.y) <= options.maxTexcoordError;
+            });
+        format.texcoord = fits ? VertexFormat::Texcoord::Half2 : VertexFormat::Texcoord::Float2;
+    }
+
+    if (hasSkin)
+    {
+        if (options.compactSkin)
+        {
+            // 2 gڂ̃EFCgS 0 Ȃ 4 eő
+            const bool useSecondSet = std::any_of(vertices.begin(), vertices.end(), [](const Attributes& vertex)
+                {
+                    return vertex.weights[1].x > 0.0f || vertex.weights[1].y > 0.0f || vertex.weights[1].z > 0.0f || vertex.weights[1].w > 0.0f;
+                });
+            format.influenceSets = useSecondSet ? 2 : 1;
+            uint32_t maxJoint = 0;
+            for (const Attributes& vertex : vertices)
+            {
+                for (int set = 0; set < format.influenceSets; ++set)
+                {
+                    maxJoint = (std::max)({ maxJoint, vertex.joints[set].x, vertex.joints[set].y, vertex.joints[set].z, vertex.joints[set].w });
+                }
+            }
+            format.joints = maxJoint < 256 ? VertexFormat::Joints::Uint8 : maxJoint < 65536 ? VertexFormat::Joints::Uint16 : VertexFormat::Joints::Uint32;
+            format.weights = options.weightBits == 16 ? VertexFormat::Weights::Unorm16 : VertexFormat::Weights::Unorm8;
+        }
+        else
+        {
+            format.joints = VertexFormat::Joints::Uint32;
+            format.weights = VertexFormat::Weights::Float;
+            format.influenceSets = 2;
+        }
+    }
+    return format;
+}
+
+void VertexFormatBuilder::SetPositionBounds(VertexFormat& format, const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum)
+{
+    format.positionOffset = minimum;
+    format.positionScale = { maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z };
+}
+
+void VertexFormatBuilder::EncodeVertex(const VertexFormat& format, const Attributes& vertex, unsigned char* destination)
+{
+    if (format.position == VertexFormat::Position::Unorm16)
+    {
+        const float* p = &vertex.position.x;
+        const float* scale = &format.positionScale.x;
+        const float* offset = &format.positionOffset.x;
+        uint16_t q[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < 3; ++i)
+        {
+            q[i] = scale[i] > 0.0f ? QuantizeUnorm16((p[i] - offset[i]) / scale[i]) : 0;
+        }
+        memcpy(destination + format.PositionOffset(), q, sizeof(q));
+    }
+    else
+    {
+        Store(destination + format.PositionOffset(), vertex.position);
+    }
+
+    if (format.normal == VertexFormat::Direction::Octahedral)
+    {
+        int x, y;
+        OctEncodeSnorm(vertex.normal, 32767, x, y);
+        const int16_t q[2] = { static_cast<int16_t>(x), static_cast<int16_t>(y) };
+        memcpy(destination + format.NormalOffset(), q, sizeof(q));
+    }
+    else
+    {
+        Store(destination + format.NormalOffset(), vertex.normal);
+    }
+
+    if (format.tangent == VertexFormat::Direction::Octahedral)
+    {
+        int x, y;
+        OctEncodeSnorm({ vertex.tangent.x, vertex.tangent.y, vertex.tangent.z }, 127, x, y);
+        const int8_t q[4] = { static_cast<int8_t>(x), static_cast<int8_t>(y), static_cast<int8_t>(vertex.tangent.w < 0.0f ? -127 : 127), 0 };
+        memcpy(destination + format.TangentOffset(), q, sizeof(q));
+    }
+    else
+    {
+        Store(destination + format.TangentOffset(), vertex.tangent);
+    }
+
+    if (format.texcoord == VertexFormat::Texcoord::Half2)
+    {
+        const DirectX::PackedVector::HALF q[2] =
+        {
+            DirectX::PackedVector::XMConvertFloatToHalf(vertex.texcoord.x),
+            DirectX::PackedVector::XMConvertFloatToHalf(vertex.texcoord.y),
+        };
+        memcpy(destination + format.TexcoordOffset(), q, sizeof(q));
+    }
+    else
+    {
+        Store(destination + format.TexcoordOffset(), vertex.texcoord);
+    }
+
+    for (int set = 0; set < format.influenceSets; ++set)
+    {
+        const uint32_t* j = &vertex.joints[set].x;
+        unsigned char* d = destination + format.JointsOffset(set);
+        for (int i = 0; i < 4; ++i)
+        {
+            switch (format.joints)
+            {
+            case VertexFormat::Joints::Uint8: d[i] = static_cast<uint8_t>(j[i]); break;
+            case VertexFormat::Joints::Uint16: Store(d + i * 2, static_cast<uint16_t>(j[i])); break;
+            default: Store(d + i * 4, j[i]); break;
+            }
+        }
+    }
+
+    if (format.influenceSets > 0)
+    {
+        if (format.weights == VertexFormat::Weights::Float)
+        {
+            for (int set = 0; set < format.influenceSets; ++set)
+            {
+                Store(destination + format.WeightsOffset(set), vertex.weights[set]);
+            }
+        }
+        else
+        {
+            // ۂ߂v 1 ɂȂ悤ɁAԑ傫EFCgŌ덷z
+            const int maxValue = format.weights == VertexFormat::Weights::Unorm16 ? 65535 : 255;
+            const int count = format.influenceSets * 4;
+            float weights[8];
+            NormalizedWeights(vertex, format.influenceSets, weights);
+            int q[8] = {};
+            int sum = 0;
+            int largest = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                q[i] = static_cast<int>(std::lround(weights[i] * maxValue));
+                sum += q[i];
+                largest = weights[i] > weights[largest] ? i : largest;
+            }
+            if (sum > 0)
+            {
+                q[largest] = std::clamp(q[largest] + maxValue - sum, 0, maxValue);
+            }
+            for (int i = 0; i < count; ++i)
+            {
+                unsigned char* d = destination + format.WeightsOffset(i / 4);
+                if (maxValue == 255)
+                {
+                    d[i % 4] = static_cast<uint8_t>(q[i]);
+                }
+                else
+                {
+                    Store(d + (i % 4) * 2, static_cast<uint16_t>(q[i]));
+                }
+            }
+        }
+    }
+}
+
+void VertexFormatBuilder::DecodeVertex(const VertexFormat& format, const unsigned char* source, Attributes& vertex)
+{
+    vertex = {};
+    if (format.position == VertexFormat::Position::Unorm16)
+    {
+        const unsigned char* s = source + format.PositionOffset();
+        const float* scale = &format.positionScale.x;
+        const float* offset = &format.positionOffset.x;
+        float* p = &vertex.position.x;
+        for (int i = 0; i < 3; ++i)
+        {
+            p[i] = Load<uint16_t>(s + i * 2) / 65535.0f * scale[i] + offset[i];
+        }
+    }
+    else
+    {
+        vertex.position = Load<DirectX::XMFLOAT3>(source + format.PositionOffset());
+    }
+
+    if (format.normal == VertexFormat::Direction::Octahedral)
+    {
+        const unsigned char* s = source + format.NormalOffset();
+        vertex.normal = OctDecode(DequantizeSnorm(Load<int16_t>(s), 32767), DequantizeSnorm(Load<int16_t>(s + 2), 32767));
+    }
+    else
+    {
+        vertex.normal = Load<DirectX::XMFLOAT3>(source + format.NormalOffset());
+    }
+
+    if (format.tangent == VertexFormat::Direction::Octahedral)
+    {
+        const int8_t* s = reinterpret_cast<const int8_t*>(source + format.TangentOffset());
+        const DirectX::XMFLOAT3 t = OctDecode(DequantizeSnorm(s[0], 127), DequantizeSnorm(s[1], 127));
+        vertex.tangent = { t.x, t.y, t.z, s[2] < 0 ? -1.0f : 1.0f };
+    }
+    else
+    {
+        vertex.tangent = Load<DirectX::XMFLOAT4>(source + format.TangentOffset());
+    }
+
+    if (format.texcoord == VertexFormat::Texcoord::Half2)
+    {
+        const unsigned char* s = source + format.TexcoordOffset();
+        vertex.texcoord.x = DirectX::PackedVector::XMConvertHalfToFloat(Load<DirectX::PackedVector::HALF>(s));
+        vertex.texcoord.y = DirectX::PackedVector::XMConvertHalfToFloat(Load<DirectX::PackedVector::HALF>(s + 2));
+    }
+    else
+    {
+        vertex.texcoord = Load<DirectX::XMFLOAT2>(source + format.TexcoordOffset());
+    }
+
+    for (int set = 0; set < format.influenceSets; ++set)
+    {
+        const unsigned char* s = source + format.JointsOffset(set);
+        uint32_t* j = &vertex.joints[set].x;
+        for (int i = 0; i < 4; ++i)
+        {
+            switch (format.joints)
+            {
+            case VertexFormat::Joints::Uint8: j[i] = s[i]; break;
+            case VertexFormat::Joints::Uint16: j[i] = Load<uint16_t>(s + i * 2); break;
+            default: j[i] = Load<uint32_t>(s + i * 4); break;
+            }
+        }
+
+        const unsigned char* w = source + format.WeightsOffset(set);
+        float* weights = &vertex.weights[set].x;
+        for (int i = 0; i < 4; ++i)
+        {
+            switch (format.weights)
+            {
+            case VertexFormat::Weights::Unorm8: weights[i] = w[i] / 255.0f; break;
+            case VertexFormat::Weights::Unorm16: weights[i] = Load<uint16_t>(w + i * 2) / 65535.0f; break;
+            default: weights[i] = Load<float>(w + i * 4); break;
+            }
+        }
+    }
+}
+
+DirectX::XMFLOAT3 VertexFormatBuilder::DecodePosition(const VertexFormat& format, const unsigned char* vertices, size_t index)
+{
+    const unsigned char* s = vertices + index * format.Stride() + format.PositionOffset();
+    if (format.position == VertexFormat::Position::Unorm16)
+    {
+        return
+        {
+            Load<uint16_t>(s + 0) / 65535.0f * format.positionScale.x + format.positionOffset.x,
+            Load<uint16_t>(s + 2) / 65535.0f * format.positionScale.y + format.positionOffset.y,
+            Load<uint16_t>(s + 4) / 65535.0f * format.positionScale.z + format.positionOffset.z,
+        };
+    }
+    return Load<DirectX::XMFLOAT3>(s);
+}
+
+std::vector<unsigned char> VertexFormatBuilder::Encode(const VertexFormat& format, const std::vector<Attributes>& vertices)
+{
+    const UINT stride = format.Stride();
+    std::vector<unsigned char> encoded(vertices.size() * stride);
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        EncodeVertex(format, vertices[i], encoded.data() + i * stride);
+    }
+    return encoded;
+}
+
+void VertexFormatBuilder::Measure(const VertexFormat& format, const std::vector<Attributes>& vertices, const std::vector<unsigned char>& encoded, size_t sourceStride, ErrorReport& report)
+{
+    const UINT stride = format.Stride();
+    ++report.primitiveCount;
+    report.vertexCount += vertices.size();
+    report.sourceBytes += vertices.size() * sourceStride;
+    report.encodedBytes += encoded.size();
+    for (size_t i = 0; i < vertices.size() && (i + 1) * stride <= encoded.size(); ++i)
+    {
+        const Attributes& source = vertices[i];
+        Attributes decoded;
+        DecodeVertex(format, encoded.data() + i * stride, decoded);
+
+        const float dx = decoded.position.x - source.position.x;
+        const float dy = decoded.position.y - source.position.y;
+        const float dz = decoded.position.z - source.position.z;
+        report.maxPositionError = (std::max)(report.maxPositionError, sqrtf(dx * dx + dy * dy + dz * dz));
+        report.maxNormalDegrees = (std::max)(report.maxNormalDegrees, AngleDegrees(source.normal, decoded.normal));
+        report.maxTangentDegrees = (std::max)(report.maxTangentDegrees, AngleDegrees({ source.tangent.x, source.tangent.y, source.tangent.z }, { decoded.tangent.x, decoded.tangent.y, decoded.tangent.z }));
+        if ((source.tangent.w < 0.0f) != (decoded.tangent.w < 0.0f))
+        {
+            ++report.tangentSignErrors;
+        }
+        report.maxTexcoordError = (std::max)({ report.maxTexcoordError, fabsf(decoded.texcoord.x - source.texcoord.x), fabsf(decoded.texcoord.y - source.texcoord.y) });
+
+        if (format.influenceSets > 0 && format.weights != VertexFormat::Weights::Float)
+        {
+            float weights[8];
+            NormalizedWeights(source, format.influenceSets, weights);
+            for (int w = 0; w < format.influenceSets * 4; ++w)
+            {
+                const float value = (&decoded.weights[w / 4].x)[w % 4];
+                report.maxWeightError = (std::max)(report.maxWeightError, fabsf(value - weights[w]));
+            }
+        }
+    }
+}
+
+void VertexFormatBuilder::ErrorReport::Merge(const ErrorReport& other)
+{
+    primitiveCount += other.primitiveCount;
+    vertexCount += other.vertexCount;
+    sourceBytes += other.sourceBytes;
+    encodedBytes += other.encodedBytes;
+    maxPositionError = (std::max)(maxPositionError, other.maxPositionError);
+    maxNormalDegrees = (std::max)(maxNormalDegrees, other.maxNormalDegrees);
+    maxTangentDegrees = (std::max)(maxTangentDegrees, other.maxTangentDegrees);
+    maxTexcoordError = (std::max)(maxTexcoordError, other.maxTexcoordError);
+    maxWeightError = (std::max)(maxWeightError, other.maxWeightError);
+    tangentSignErrors += other.tangentSignErrors;
+}
+
+std::string VertexFormatBuilder::ErrorReport::ToString() const
+{
+    // _tFb` (1 `悠) _obt@̃TCYƓ䗦Ō
+    char buf[512];
+    sprintf_s(buf,
+        "  %zu primitives, %zu vertices\n"
+        "  vertex memory / fetch : %zu -> %zu bytes (%.1f%%)\n"
+        "  position : max %.6f\n"
+        "  normal   : max %.3f deg\n"
+        "  tangent  : max %.3f deg, %d sign errors\n"
+        "  texcoord : max %.6f\n"
+        "  weights  : max %.6f\n",
+        primitiveCount, vertexCount,
+        sourceBytes, encodedBytes, sourceBytes > 0 ? 100.0 * encodedBytes / sourceBytes : 100.0,
+        maxPositionError, maxNormalDegrees, maxTangentDegrees, tangentSignErrors, maxTexcoordError, maxWeightError);
+    return buf;
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <d3d11.h>
+#include <DirectXMath.h>
+
+// v~eBuƂ̒_tH[}bg
+// ʎq͓̓AZu (UNORM/SNORM/FLOAT16/UINT) 
+// GltfModel.hlsli  DecodeVertex  float ɖ߂
+struct VertexFormat
+{
+    enum class Position : uint8_t
+    {
+        Float3,     // R32G32B32_FLOAT
+        Unorm16,    // R16G16B16A16_UNORM (positionScale / positionOffset ŕ)
+    };
+    enum class Direction : uint8_t
+    {
+        Float,      // @ R32G32B32_FLOAT / ڐ R32G32B32A32_FLOAT
+        Octahedral, // @ R16G16_SNORM / ڐ R8G8B8A8_SNORM (xy: ʑ, z: ]ڐ̕)
+    };
+    enum class Texcoord : uint8_t
+    {
+        Float2,     // R32G32_FLOAT
+        Half2,      // R16G16_FLOAT
+    };
+    enum class Joints : uint8_t
+    {
+        None,       // lobt@ǂ (WCg 0)
+        Uint8,      // R8G8B8A8_UINT
+        Uint16,     // R16G16B16A16_UINT
+        Uint32,     // R32G32B32A32_UINT
+    };
+    enum class Weights : uint8_t
+    {
+        None,       // lobt@ǂ (1, 0, 0, 0)
+        Unorm8,     // R8G8B8A8_UNORM
+        Unorm16,    // R16G16B16A16_UNORM
+        Float,      // R32G32B32A32_FLOAT
+    };
+
+    // GltfModel.hlsli  VERTEX_FORMAT_* Ƒ
+    enum ShaderFlag : uint32_t
+    {
+        QuantizedPosition = 0x01,
+        OctahedralNormal = 0x02,
+        OctahedralTangent = 0x04,
+    };
+
+    Position position = Position::Float3;
+    Direction normal = Direction::Float;
+    Direction tangent = Direction::Float;
+    Texcoord texcoord = Texcoord::Float2;
+    Joints joints = Joints::None;
+    Weights weights = Weights::None;
+    uint8_t influenceSets = 0; // JOINTS_n / WEIGHTS_n ̑g (0 - 2)
+
+    // Unorm16 ̈ʒu𕜌 (position = unorm * positionScale + positionOffset)
+    DirectX::XMFLOAT3 positionScale = { 1, 1, 1 };
+    DirectX::XMFLOAT3 positionOffset = { 0, 0, 0 };
+
+    // ʎqȂ] Mesh::Vertex (112 bytes) / BatchMesh::Vertex (48 bytes) Ɠ
+    static VertexFormat FullPrecision(bool hasSkin);
+
+    // ẽoCgItZbg
+    UINT PositionOffset() const { return 0; }
+    UINT NormalOffset() const;
+    UINT TangentOffset() const;
+    UINT TexcoordOffset() const;
+    UINT JointsOffset(int set) const;
+    UINT WeightsOffset(int set) const;
+    UINT Stride() const;
+
+    uint32_t ShaderFlags() const;
+    // ̓CAEgL邽߂̃L[ (positionScale / positionOffset ͊܂܂Ȃ)
+    uint32_t LayoutKey() const;
+    static VertexFormat FromLayoutKey(uint32_t key);
+    std::string ToString() const;
+
+    // PrimitiveConstants (GltfModel.hlsli  PRIMITIVE_CONSTANT_BUFFER) ɕp̒l
+    template<class ConstantsT>
+    void SetShaderConstants(ConstantsT& constants) const
+    {
+        constants.vertexFlags = ShaderFlags();
+        constants.positionScale = { positionScale.x, positionScale.y, positionScale.z, 0.0f };
+        constants.positionOffset = { positionOffset.x, positionOffset.y, positionOffset.z, 0.0f };
+    }
+
+    // requireSkin : JOINTS/WEIGHTS Kǂޒ_VF[_[ (GltfModelVS) p
+    // Ȃg defaultSlot ̃CX^Xf[^ (SkinDefaults) ǂ
+    void MakeInputElements(std::vector<D3D11_INPUT_ELEMENT_DESC>& elements, bool requireSkin, UINT defaultSlot) const;
+
+    // XLȂ_̊l (JOINTS 0 / WEIGHTS (1, 0, 0, 0)) 16 bytes
+    static const unsigned char SkinDefaults[16];
+};
+
+// _tH[}bgIсAʎqEE덷vs
+class VertexFormatBuilder
+{
+public:
+    struct Options
+    {
+        bool quantizePosition = false;  // 16bit ʒu (bVPʂ̕XP[)
+        bool octahedralNormal = true;
+        bool octahedralTangent = true;
+        bool halfTexcoord = true;       // 덷 maxTexcoordError ȉȂ half ɂ
+        bool compactSkin = true;        // 8/16bit WCgAunorm EFCg
+        int weightBits = 8;             // 8 or 16
+        float maxTexcoordError = 1.0f / 4096.0f;
+
+        // LbVɋL^āAݒ肪ς蒼
+        uint32_t Hash() const;
+    };
+
+    // ʎqO̒_
+    struct Attributes
+    {
+        DirectX::XMFLOAT3 position = { 0, 0, 0 };
+        DirectX::XMFLOAT3 normal = { 0, 0, 1 };
+        DirectX::XMFLOAT4 tangent = { 1, 0, 0, 1 };
+        DirectX::XMFLOAT2 texcoord = { 0, 0 };
+        DirectX::XMUINT4 joints[2] = { { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+        DirectX::XMFLOAT4 weights[2] = { { 1, 0, 0, 0 }, { 0, 0, 0, 0 } };
+    };
+
+    struct ErrorReport
+    {
+        size_t primitiveCount = 0;
+        size_t vertexCount = 0;
+        size_t sourceBytes = 0;     // ʎqO
+        size_t encodedBytes = 0;    // ʎq
+        float maxPositionError = 0.0f;      // fԂ̋
+        float maxNormalDegrees = 0.0f;
+        float maxTangentDegrees = 0.0f;
+        float maxTexcoordError = 0.0f;
+        float maxWeightError = 0.0f;
+        int tangentSignErrors = 0;
+
+        void Merge(const ErrorReport& other);
+        std::string ToString() const;
+    };
+
+    // hasSkin : JOINTS_0 / WEIGHTS_0 v~eBu
+    static VertexFormat Choose(const std::vector<Attributes>& vertices, bool hasSkin, const Options& options);
+    // ʒu̗ʎq͈ (bVPʂŋL)
+    static void SetPositionBounds(VertexFormat& format, const DirectX::XMFLOAT3& minimum, const DirectX::XMFLOAT3& maximum);
+    static void EncodeVertex(const VertexFormat& format, const Attributes& vertex, unsigned char* destination);
+    static void DecodeVertex(const VertexFormat& format, const unsigned char* source, Attributes& vertex);
+    static DirectX::XMFLOAT3 DecodePosition(const VertexFormat& format, const unsigned char* vertices, size_t index);
+    static void Measure(const VertexFormat& format, const std::vector<Attributes>& vertices, const std::vector<unsigned char>& encoded, size_t sourceStride, ErrorReport& report);
+
+    // InterleavedGltfModel::Mesh::Vertex / BatchMesh::Vertex Ƃ̕ϊ
+    template<class VertexT>
+    static Attributes ToAttributes(const VertexT& vertex)
+    {
+        Attributes attributes;
+        attributes.position = vertex.position;
+        attributes.normal = vertex.normal;
+        attributes.tangent = vertex.tangent;
+        attributes.texcoord = vertex.texcoord;
+        if constexpr (requires { vertex.joints0; })
+        {
+            attributes.joints[0] = vertex.joints0;
+            attributes.joints[1] = vertex.joints1;
+            attributes.weights[0] = vertex.weights0;
+            attributes.weights[1] = vertex.weights1;
+        }
+        return attributes;
+    }
+    template<class VertexT>
+    static void FromAttributes(const Attributes& attributes, VertexT& vertex)
+    {
+        vertex.position = attributes.position;
+        vertex.normal = attributes.normal;
+        vertex.tangent = attributes.tangent;
+        vertex.texcoord = attributes.texcoord;
+        if constexpr (requires { vertex.joints0; })
+        {
+            vertex.joints0 = attributes.joints[0];
+            vertex.joints1 = attributes.joints[1];
+            vertex.weights0 = attributes.weights[0];
+            vertex.weights1 = attributes.weights[1];
+        }
+    }
+    template<class VertexT>
+    static std::vector<Attributes> ToAttributes(const std::vector<VertexT>& vertices)
+    {
+        std::vector<Attributes> attributes;
+        attributes.reserve(vertices.size());
+        for (const VertexT& vertex : vertices)
+        {
+            attributes.push_back(ToAttributes(vertex));
+        }
+        return attributes;
+    }
+
+    static std::vector<unsigned char> Encode(const VertexFormat& format, const std::vector<Attributes>& vertices);
+    template<class VertexT>
+    static std::vector<VertexT> Decode(const VertexFormat& format, const unsigned char* data, size_t vertexCount)
+    {
+        std::vector<VertexT> vertices(vertexCount);
+        const UINT stride = format.Stride();
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            Attributes attributes;
+            DecodeVertex(format, data + i * stride, attributes);
+            FromAttributes(attributes, vertices[i]);
+        }
+        return vertices;
+    }
+};
@@ -87,12 +87,8 @@ CascadedShadowMaps::CascadedShadowMaps(ID3D11Device* device, UINT width, UINT he
     _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 }
 
-void CascadedShadowMaps::Activate(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& cameraView, const DirectX::XMFLOAT4X4& cameraProjection, const DirectX::XMFLOAT4& lightDirection,
-    float criticalDepthValue/* If this value is 0, the camera's far panel distance is used.*/, UINT cbSlot)
+void CascadedShadowMaps::UpdateCascades(const DirectX::XMFLOAT4X4& cameraView, const DirectX::XMFLOAT4X4& cameraProjection, const DirectX::XMFLOAT4& lightDirection, float criticalDepthValue)
 {
-	immediateContext->RSGetViewports(&viewportCount, catchedViewports);
-	immediateContext->OMGetRenderTargets(1, catchedRenderTargetView.ReleaseAndGetAddressOf(), catchedDepthStencilView.ReleaseAndGetAddressOf());
-
     // near/far value from perspective projection matrix
     float m33 = cameraProjection._33;
     float m43 = cameraProjection._43;
@@ -180,6 +176,15 @@ void CascadedShadowMaps::Activate(ID3D11DeviceContext* immediateContext, const D
 		DirectX::XMMATRIX P = DirectX::XMMatrixOrthographicOffCenterLH(minX, maxX, minY, maxY, minZ, maxZ);
 		DirectX::XMStoreFloat4x4(&cascadedMatrices.at(cascadeIndex), V * P);
 	}
+}
+
+void CascadedShadowMaps::Activate(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& cameraView, const DirectX::XMFLOAT4X4& cameraProjection, const DirectX::XMFLOAT4& lightDirection,
+    float criticalDepthValue/* If this value is 0, the camera's far panel distance is used.*/, UINT cbSlot)
+{
+	immediateContext->RSGetViewports(&viewportCount, catchedViewports);
+	immediateContext->OMGetRenderTargets(1, catchedRenderTargetView.ReleaseAndGetAddressOf(), catchedDepthStencilView.ReleaseAndGetAddressOf());
+
+	UpdateCascades(cameraView, cameraProjection, lightDirection, criticalDepthValue);
 
 	Constants data;
 	data.cascadedMatrices[0] = cascadedMatrices.at(0);
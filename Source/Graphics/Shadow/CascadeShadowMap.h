@@ -37,6 +37,10 @@ public:
     void Activate(ID3D11DeviceContext* immediateContext, const DirectX::XMFLOAT4X4& cameraView, const DirectX::XMFLOAT4X4& cameraProjection,const DirectX::XMFLOAT4& lightDirection,
         float criticalDepthValue/* If this value is 0, the camera's far panel distance is used.*/,UINT cbSlot);
     void Deactive(ID3D11DeviceContext* immediateContext);
+    // JXP[hƂ̃Cg̍s񂾂vZ (GPU ͎gȂAActivate Ă΂)
+    void UpdateCascades(const DirectX::XMFLOAT4X4& cameraView, const DirectX::XMFLOAT4X4& cameraProjection, const DirectX::XMFLOAT4& lightDirection, float criticalDepthValue);
+    // Ō UpdateCascades JXP[h view * projection
+    const std::vector<DirectX::XMFLOAT4X4>& GetCascadedMatrices() const { return cascadedMatrices; }
     void Clear(ID3D11DeviceContext* immediateContext)
     {
         immediateContext->ClearDepthStencilView(depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1, 0);
@@ -0,0 +1,330 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <memory>
+
+#include "Engine/Utility/Win32Utils.h"
+
+using Microsoft::WRL::ComPtr;
+
+SkylinePacker::SkylinePacker(int width, int height, int padding)
+    : width(width), height(height), padding(padding)
+{
+    skyline.push_back({ 0, 0, width });
+}
+
+int SkylinePacker::Fit(size_t index, int fitWidth, int fitHeight) const
+{
+    const int x = skyline[index].x;
+    if (x + fitWidth > width)
+    {
+        return -1;
+    }
+    int y = skyline[index].y;
+    int remaining = fitWidth;
+    for (size_t i = index; remaining > 0; ++i)
+    {
+        y = (std::max)(y, skyline[i].y);
+        if (y + fitHeight > height)
+        {
+            return -1;
+        }
+        remaining -= skyline[i].width;
+    }
+    return y;
+}
+
+void SkylinePacker::AddSegment(size_t index, int x, int y, int segmentWidth, int segmentHeight)
+{
+    skyline.insert(skyline.begin() + index, { x, y + segmentHeight, segmentWidth });
+
+    //VỉɉBꂽi
+    for (size_t i = index + 1; i < skyline.size();)
+    {
+        const Segment& previous = skyline[i - 1];
+        Segment& segment = skyline[i];
+        const int overlap = previous.x + previous.width - segment.x;
+        if (overlap <= 0)
+        {
+            break;
+        }
+        segment.x += overlap;
+        segment.width -= overlap;
+        if (segment.width > 0)
+        {
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    //ŗׂ荇i͂Ȃ
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+bool SkylinePacker::Insert(int insertWidth, int insertHeight, int& x, int& y)
+{
+    const int paddedWidth = insertWidth + padding;
+    const int paddedHeight = insertHeight + padding;
+
+    //ȕ[ԒႭAȂi̕ԋɒu
+    size_t bestIndex = skyline.size();
+    int bestTop = INT_MAX;
+    int bestWidth = INT_MAX;
+    int bestY = 0;
+    for (size_t i = 0; i < skyline.size(); ++i)
+    {
+        const int fitY = Fit(i, paddedWidth, paddedHeight);
+        if (fitY < 0)
+        {
+            continue;
+        }
+        const int top = fitY + paddedHeight;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth))
+        {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestY = fitY;
+        }
+    }
+    if (bestIndex == skyline.size())
+    {
+        return false;
+    }
+
+    const int left = skyline[bestIndex].x;
+    AddSegment(bestIndex, left, bestY, paddedWidth, paddedHeight);
+    usedArea += static_cast<size_t>(insertWidth) * insertHeight;
+
+    //padding ̔㉺Ẻɂ
+    x = left + padding / 2;
+    y = bestY + padding / 2;
+    return true;
+}
+
+float SkylinePacker::Occupancy() const
+{
+    return static_cast<float>(usedArea) / (static_cast<float>(width) * height);
+}
+
+TextureAtlas& TextureAtlas::Get()
+{
+    static TextureAtlas instance;
+    return instance;
+}
+
+bool TextureAtlas::IsSupportedFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+        return true;
+    default:
+        //ktH[}bg̓ubNPʂłuȂ̂ōڂȂ
+        return false;
+    }
+}
+
+bool TextureAtlas::PlaceLocked(const std::wstring& key, UINT width, UINT height, DXGI_FORMAT format, Region& region)
+{
+    auto it = regions.find(key);
+    if (it != regions.end())
+    {
+        region = it->second;
+        return true;
+    }
+    if (width == 0 || height == 0 || width > MaxImageSize || height > MaxImageSize || !IsSupportedFormat(format))
+    {
+        ++rejected;
+        return false;
+    }
+
+    int x = 0, y = 0;
+    size_t pageIndex = 0;
+    for (; pageIndex < pages.size(); ++pageIndex)
+    {
+        Page& page = pages[pageIndex];
+        if (page.format == format && page.packer.Insert(static_cast<int>(width), static_cast<int>(height), x, y))
+        {
+            break;
+        }
+    }
+    if (pageIndex == pages.size())
+    {
+        pages.push_back({ format, SkylinePacker(PageSize, PageSize, Padding) });
+        const bool inserted = pages.back().packer.Insert(static_cast<int>(width), static_cast<int>(height), x, y);
+        _ASSERT_EXPR(inserted, L"TextureAtlas: ̃y[WɍڂȂ");
+    }
+
+    region.page = pageIndex;
+    region.x = static_cast<UINT>(x);
+    region.y = static_cast<UINT>(y);
+    region.width = width;
+    region.height = height;
+    region.u0 = static_cast<float>(x) / PageSize;
+    region.v0 = static_cast<float>(y) / PageSize;
+    region.u1 = static_cast<float>(x + width) / PageSize;
+    region.v1 = static_cast<float>(y + height) / PageSize;
+    regions.emplace(key, region);
+    return true;
+}
+
+bool TextureAtlas::Place(const std::wstring& key, UINT width, UINT height, DXGI_FORMAT format, Region& region)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return PlaceLocked(key, width, height, format, region);
+}
+
+bool TextureAtlas::Acquire(ID3D11Device* device, const std::wstring& key, ID3D11ShaderResourceView* source,
+    Region& region, ComPtr<ID3D11ShaderResourceView>& pageView)
+{
+    if (!source)
+    {
+        return false;
+    }
+    ComPtr<ID3D11Resource> resource;
+    source->GetResource(resource.GetAddressOf());
+    ComPtr<ID3D11Texture2D> texture;
+    if (FAILED(resource.As(&texture)))
+    {
+        return false;
+    }
+    D3D11_TEXTURE2D_DESC desc{};
+    texture->GetDesc(&desc);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (desc.MipLevels != 1 || desc.ArraySize != 1 || desc.SampleDesc.Count != 1)
+    {
+        //~bv}bvEz̓y[WɍڂƏk̎ɂɂނ̂ŁÂ܂ܕ`
+        ++rejected;
+        return false;
+    }
+    const bool placed = regions.count(key) != 0;
+    if (!PlaceLocked(key, desc.Width, desc.Height, desc.Format, region))
+    {
+        return false;
+    }
+
+    Page& page = pages[region.page];
+    if (!page.texture)
+    {
+        D3D11_TEXTURE2D_DESC pageDesc{};
+        pageDesc.Width = PageSize;
+        pageDesc.Height = PageSize;
+        pageDesc.MipLevels = 1;
+        pageDesc.ArraySize = 1;
+        pageDesc.Format = page.format;
+        pageDesc.SampleDesc.Count = 1;
+        pageDesc.Usage = D3D11_USAGE_DEFAULT;
+        pageDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+        //󂢂Ă鏊͓ɂĂ
+        std::unique_ptr<DWORD[]> sysmem{ std::make_unique<DWORD[]>(static_cast<size_t>(PageSize) * PageSize) };
+        D3D11_SUBRESOURCE_DATA subresourceData{};
+        subresourceData.pSysMem = sysmem.get();
+        subresourceData.SysMemPitch = sizeof(DWORD) * PageSize;
+
+        HRESULT hr = device->CreateTexture2D(&pageDesc, &subresourceData, page.texture.GetAddressOf());
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+        hr = device->CreateShaderResourceView(page.texture.Get(), nullptr, page.view.GetAddressOf());
+        _ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+    }
+    if (!placed)
+    {
+        pending.push_back({ page.texture, region.x, region.y, desc, texture });
+    }
+    pageView = page.view;
+    return true;
+}
+
+void TextureAtlas::Commit(ID3D11DeviceContext* immediateContext)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.empty())
+    {
+        return;
+    }
+    for (const PendingCopy& copy : pending)
+    {
+        ID3D11Texture2D* destination = copy.destination.Get();
+        ID3D11Texture2D* source = copy.source.Get();
+        const UINT w = copy.desc.Width;
+        const UINT h = copy.desc.Height;
+        const UINT x = copy.x;
+        const UINT y = copy.y;
+        immediateContext->CopySubresourceRegion(destination, 0, x, y, 0, source, 0, nullptr);
+
+        // 1 sNZO֐L΂āAoCjAŗׂ̉摜ɂ܂Ȃ悤ɂ
+        const D3D11_BOX left{ 0, 0, 0, 1, h, 1 };
+        const D3D11_BOX right{ w - 1, 0, 0, w, h, 1 };
+        const D3D11_BOX top{ 0, 0, 0, w, 1, 1 };
+        const D3D11_BOX bottom{ 0, h - 1, 0, w, h, 1 };
+        immediateContext->CopySubresourceRegion(destination, 0, x - 1, y, 0, source, 0, &left);
+        immediateContext->CopySubresourceRegion(destination, 0, x + w, y, 0, source, 0, &right);
+        immediateContext->CopySubresourceRegion(destination, 0, x, y - 1, 0, source, 0, &top);
+        immediateContext->CopySubresourceRegion(destination, 0, x, y + h, 0, source, 0, &bottom);
+        const D3D11_BOX topLeft{ 0, 0, 0, 1, 1, 1 };
+        const D3D11_BOX topRight{ w - 1, 0, 0, w, 1, 1 };
+        const D3D11_BOX bottomLeft{ 0, h - 1, 0, 1, h, 1 };
+        const D3D11_BOX bottomRight{ w - 1, h - 1, 0, w, h, 1 };
+        immediateContext->CopySubresourceRegion(destination, 0, x - 1, y - 1, 0, source, 0, &topLeft);
+        immediateContext->CopySubresourceRegion(destination, 0, x + w, y - 1, 0, source, 0, &topRight);
+        immediateContext->CopySubresourceRegion(destination, 0, x - 1, y + h, 0, source, 0, &bottomLeft);
+        immediateContext->CopySubresourceRegion(destination, 0, x + w, y + h, 0, source, 0, &bottomRight);
+        ++copies;
+    }
+    pending.clear();
+}
+
+void TextureAtlas::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pages.clear();
+    regions.clear();
+    rejected = 0;
+    copies = 0;
+}
+
+TextureAtlas::Statistics TextureAtlas::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Statistics result;
+    result.pages = pages.size();
+    result.regions = regions.size();
+    result.rejected = rejected;
+    result.copies = copies;
+    if (!pages.empty())
+    {
+        float occupancy = 0;
+        for (const Page& page : pages)
+        {
+            occupancy += page.packer.Occupancy();
+        }
+        result.occupancy = occupancy / pages.size();
+    }
+    return result;
+}
+
+std::string TextureAtlas::Statistics::ToString() const
+{
+    char buf[256];
+    sprintf_s(buf, "pages:%zu regions:%zu rejected:%zu copies:%zu occupancy:%.1f%%", pages, regions, rejected, copies, occupancy * 100.0f);
+    return buf;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// XJCC@Œ`l߂ (D3D gȂ̂ŃwbhXłg)
+// ̗֊s (XJCC) 珇ɎĂAuɈԒႭȂ鏊ɒu
+class SkylinePacker
+{
+public:
+    // padding ͒`ǂ̊Ԃɋ󂯂镝 (ɂݎ~߂ 1 sNZ̉ɂg)
+    SkylinePacker(int width, int height, int padding);
+
+    // u獶Ԃ trueBuȂ false (ςȂ)
+    bool Insert(int width, int height, int& x, int& y);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    // u`̖ʐς̊ (padding ͊܂܂Ȃ)
+    float Occupancy() const;
+
+private:
+    struct Segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+    // index ̏畝 width Œu y (uȂ -1)
+    int Fit(size_t index, int width, int height) const;
+    void AddSegment(size_t index, int x, int y, int width, int height);
+
+    int width;
+    int height;
+    int padding;
+    std::vector<Segment> skyline;
+    size_t usedArea = 0;
+};
+
+// UI ̏eNX`傫ȃy[WeNX` (AgX) ɂ܂Ƃ߂
+// ʂ̉摜ły[WɍڂĂ΃VF[_[\[XɂȂ̂ŁAUIBatch  1  Draw ɂ܂Ƃ߂
+// y[W̓tH[}bgƂɍB~bv}bvEzE傫摜EktH[}bg͍ڂȂ
+class TextureAtlas
+{
+public:
+    static constexpr UINT PageSize = 2048;
+    static constexpr UINT MaxImageSize = 1024;  // 傫ӂ̉摜͍ڂȂ
+    static constexpr int Padding = 2;           // 摜̊ ( 1 sNZ + ɂݎ~)
+
+    // y[W̒ 1 
+    struct Region
+    {
+        size_t page = 0;
+        UINT x = 0, y = 0;              // y[W̒̍ (sNZ)
+        UINT width = 0, height = 0;     // ̉摜̑傫
+        float u0 = 0, v0 = 0, u1 = 0, v1 = 0;
+
+        // ̉摜 UV (0`1) y[W UV ɂ
+        float U(float u) const { return u0 + (u1 - u0) * u; }
+        float V(float v) const { return v0 + (v1 - v0) * v; }
+    };
+
+    struct Statistics
+    {
+        size_t pages = 0;
+        size_t regions = 0;
+        size_t rejected = 0;    // ڂȂ摜 (傫EkȂ)
+        size_t copies = 0;      // y[Wɏ񂾉摜
+        float occupancy = 0;    // y[WŜ̎gp
+
+        std::string ToString() const;
+    };
+
+    // `ŎgAgX
+    static TextureAtlas& Get();
+
+    TextureAtlas() = default;
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // 摜ڂ ( key  1 񂾂ڂ)BڂȂ false (̃eNX`̂܂ܕ`)
+    // y[Wւ̃Rs[ Commit ܂ő҂
+    bool Acquire(ID3D11Device* device, const std::wstring& key, ID3D11ShaderResourceView* source,
+        Region& region, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& pageView);
+
+    // ꏊ߂ (eNX`͍ȂBwbhX̌vp)
+    bool Place(const std::wstring& key, UINT width, UINT height, DXGI_FORMAT format, Region& region);
+
+    // ҂ĂRs[y[Wɏ (`̑OɌĂ)
+    void Commit(ID3D11DeviceContext* immediateContext);
+
+    // SẴy[ŴĂ (gĂ Image ̓y[WĂ̂ŁA`͂̂܂ܑ)
+    // ɓǂݍ񂾎̃V[ Image ̂߂ɃRs[͑҂܂܂ɂ
+    void Clear();
+
+    Statistics GetStatistics() const;
+
+    static bool IsSupportedFormat(DXGI_FORMAT format);
+
+private:
+    struct Page
+    {
+        DXGI_FORMAT format;
+        SkylinePacker packer;
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> view;
+    };
+    // Clear ̌ł߂悤ɁAy[W̓CfbNXł͂ȂeNX`Ŏ
+    struct PendingCopy
+    {
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> destination;
+        UINT x, y;
+        D3D11_TEXTURE2D_DESC desc;
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> source;
+    };
+
+    bool PlaceLocked(const std::wstring& key, UINT width, UINT height, DXGI_FORMAT format, Region& region);
+
+    mutable std::mutex mutex;   // ǂݍ݂̃Xbh Acquire 
+    std::vector<Page> pages;
+    std::unordered_map<std::wstring, Region> regions;
+    std::vector<PendingCopy> pending;
+    size_t rejected = 0;
+    size_t copies = 0;
+};
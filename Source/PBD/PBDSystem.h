@@ -120,6 +120,9 @@ namespace PBD
                 ShapeRenderer::DrawLineSegment(immediateContext, p[b.p1].position, p[b.p4].position, { 0,1,1,1 });
                 ShapeRenderer::DrawLineSegment(immediateContext, p[b.p2].position, p[b.p3].position, { 0,1,1,1 });
             }
+
+            // ߂_Ɛ܂Ƃ߂ĕ`
+            ShapeRenderer::Flush(immediateContext);
         }
 
         void DrawGui()
@@ -11,6 +11,7 @@
 #include "Core/Actor.h"
 #include "Components/CollisionShape/CollisionComponent.h"
 #include "Components/CollisionShape/ShapeComponent.h"
+#include "Engine/Debug/Profiler.h"
 
 
 // Ll}eBbNmp̃RWVXe
@@ -30,6 +31,7 @@ public:
     static void DetectAndResolveCollisions()
     {
         using namespace physx;
+        PROFILE_ZONE("CollisionSystem::DetectAndResolveCollisions", "collision");
 
         actorPushMap_.clear(); // 
 
@@ -203,6 +205,7 @@ public:
     // o
     static void ApplyPushAll()
     {
+        PROFILE_ZONE("CollisionSystem::ApplyPushAll", "collision");
         for (auto& [actor, pushVec] : actorPushMap_)
         {
             if (!actor) continue;
@@ -3,6 +3,7 @@
 #include "Physics.h"
 #include "CollisionEvent.h"
 #include "Graphics/Core/Graphics.h"
+#include "Engine/Debug/Profiler.h"
 
 #include "Core/Actor.h"
 
@@ -117,9 +118,12 @@ void Physics::Update(float elapsedTime)
     //{
 
 #if 1
-
-    pxScene->simulate(elapsedTime);//simulateJnĂ}
-    pxScene->fetchResults(true);//	vZI܂ő҂
+    PROFILE_ZONE("Physics::Update", "physics");
+    {
+        PROFILE_ZONE("Physics::Simulate", "physics");
+        pxScene->simulate(elapsedTime);//simulateJnĂ}
+        pxScene->fetchResults(true);//	vZI܂ő҂
+    }
     PostSimulate();
 
 #endif // 0
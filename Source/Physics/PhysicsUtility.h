@@ -200,7 +200,7 @@ public:
     void DebugRender(ID3D11DeviceContext* immediateContext)
     {
         ShapeRenderer::DrawSegment(immediateContext, DirectX::XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f), points, ShapeRenderer::Type::Segment);
-
+        ShapeRenderer::Flush(immediateContext);
     }
     DirectX::XMFLOAT3 end{};
 
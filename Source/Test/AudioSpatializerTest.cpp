@@ -0,0 +1,223 @@
+#include "Components/Audio/AudioSpatializer.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Engine/Framework/SelfTest.h"
+
+// SIMD  1 ̌vZAEpEhbv[EՕ̒lA
+// 炳ȂfoCXŉzƖ炵̈ʒuA4096 ̌vZ
+SELF_TEST(AudioSpatializer)
+{
+	using Settings = AudioSpatializer::Settings;
+	using Batch = AudioSpatializer::Batch;
+	using EmitterId = AudioSpatializer::EmitterId;
+	auto isNear = [](float a, float b, float epsilon) { return std::fabs(a - b) <= epsilon * (std::max)(1.0f, std::fabs(b)); };
+
+	const Settings settings;
+	AudioListener listener;
+
+	// ܂l :  +ZAE +X ̃Xi[ɑ΂
+	{
+		AudioEmitterSettings base;
+		AudioEmitterSettings occluded = base;
+		occluded.occlusion = 1.0f;
+		Batch batch;
+		batch.Resize(6);
+		batch.Set(0, { 10.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, base);			// E
+		batch.Set(1, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, base);			// minDistance ̓
+		batch.Set(2, { 0.0f, 0.0f, 100.0f }, { 0.0f, 0.0f, 0.0f }, base);			// maxDistance ̊O
+		batch.Set(3, { 0.0f, 0.0f, 75.0f }, { 0.0f, 0.0f, 0.0f }, base);			// Ă
+		batch.Set(4, { 0.0f, 0.0f, 34.3f }, { 0.0f, 0.0f, -34.3f }, base);		//  1 ŋ߂Â
+		batch.Set(5, { 10.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, occluded);		// EŎՂĂ
+		AudioSpatializer::ComputeBatch(listener, settings, batch);
+
+		test.Check(isNear(batch.gain[0], 0.2f, 1e-5f) && batch.left[0] < 1e-3f && isNear(batch.right[0], 1.0f, 1e-5f), "a source on the right must pan right with inverse distance attenuation");
+		test.Check(isNear(batch.gain[1], 1.0f, 1e-5f) && isNear(batch.left[1], 1.0f, 1e-5f) && isNear(batch.right[1], 1.0f, 1e-5f), "a source inside minDistance must be centered at full volume");
+		test.Check(batch.gain[2] == 0.0f, "a source beyond maxDistance must be silent");
+		test.Check(isNear(batch.gain[3], 2.0f / 75.0f * 0.625f, 1e-4f), "a source near maxDistance must fade out");
+		test.Check(isNear(batch.frequencyRatio[4], 343.0f / (343.0f - 34.3f), 1e-4f), "an approaching source must be pitched up");
+		test.Check(isNear(batch.gain[5], batch.gain[0] * settings.occlusionVolume, 1e-5f) && isNear(batch.lowPass[5], settings.occludedLowPass, 1e-3f) && batch.lowPass[0] == 0.0f,
+			"occlusion must lower the volume and apply the low-pass filter");
+	}
+
+	// 4 ̌vZ 1 ̌vZɂȂ邩 (_ 1001 A] 1 ܂߂)
+	std::mt19937 random(47);
+	std::uniform_real_distribution<float> position(-120.0f, 120.0f), speed(-60.0f, 60.0f), unit(0.0f, 1.0f);
+	auto fill = [&](Batch& batch, size_t count)
+		{
+			batch.Resize(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				AudioEmitterSettings emitterSettings;
+				emitterSettings.volume = unit(random);
+				emitterSettings.minDistance = 0.5f + unit(random) * 4.0f;
+				emitterSettings.maxDistance = 20.0f + unit(random) * 100.0f;
+				emitterSettings.rolloff = 0.5f + unit(random) * 2.0f;
+				emitterSettings.occlusion = unit(random) < 0.3f ? unit(random) : 0.0f;
+				batch.Set(i, { position(random), position(random) * 0.2f, position(random) }, { speed(random), 0.0f, speed(random) }, emitterSettings);
+			}
+		};
+	listener.position = { 3.0f, 1.5f, -7.0f };
+	listener.front = { 0.6f, 0.0f, 0.8f };
+	listener.velocity = { 5.0f, 0.0f, 12.0f };
+	{
+		Batch simd, scalar;
+		fill(simd, 1001);
+		scalar = simd;
+		AudioSpatializer::ComputeBatch(listener, settings, simd);
+		for (size_t i = 0; i < scalar.count; ++i)
+		{
+			AudioSpatializer::ComputeOne(listener, settings, scalar, i);
+		}
+		size_t mismatches = 0;
+		for (size_t i = 0; i < simd.count; ++i)
+		{
+			const bool same = isNear(simd.gain[i], scalar.gain[i], 1e-4f) && isNear(simd.left[i], scalar.left[i], 1e-4f) && isNear(simd.right[i], scalar.right[i], 1e-4f) &&
+				isNear(simd.frequencyRatio[i], scalar.frequencyRatio[i], 1e-4f) && isNear(simd.lowPass[i], scalar.lowPass[i], 1e-4f) && isNear(simd.distance[i], scalar.distance[i], 1e-4f);
+			mismatches += same ? 0 : 1;
+		}
+		test.Check(mismatches == 0, "the SIMD batch must match the scalar reference");
+	}
+
+	// [vԂ̓r炵ʒu (1 b̃NbvA0.5 b 0.25 b̋Ԃ 2 JԂ)
+	auto makeClip = [](uint32_t samplesPerSec, float seconds)
+		{
+			VoiceClip clip;
+			clip.format = { 1, 1, samplesPerSec, 16, 2 };
+			clip.seconds = seconds;
+			clip.bytes = static_cast<uint32_t>(samplesPerSec * seconds) * 2;
+			return clip;
+		};
+	{
+		VoiceClip clip = makeClip(44100, 1.0f);
+		clip.loopBegin = 22050;
+		clip.loopLength = 11025;
+		struct Expected { float elapsed; bool playing; uint32_t beginFrame; uint32_t loopsLeft; };
+		const Expected expected[] =
+		{
+			{ 0.25f, true, 11025, 2 }, { 0.6f, true, 26460, 2 }, { 0.8f, true, 24255, 1 }, { 1.1f, true, 26460, 0 }, { 1.3f, true, 35280, 0 }, { 1.6f, false, 0, 0 },
+		};
+		bool isCorrect = true;
+		for (const Expected& e : expected)
+		{
+			uint32_t beginFrame = 0, loopsLeft = 0;
+			const bool playing = AudioSpatializer::Seek(clip, 2, e.elapsed, beginFrame, loopsLeft);
+			isCorrect &= playing == e.playing && (!playing || (beginFrame == e.beginFrame && loopsLeft == e.loopsLeft));
+		}
+		uint32_t beginFrame = 0, loopsLeft = 0;
+		isCorrect &= AudioSpatializer::Seek(clip, AudioVoiceDevice::LoopInfinite, 100.3f, beginFrame, loopsLeft) && loopsLeft == AudioVoiceDevice::LoopInfinite &&
+			beginFrame >= 22050 && beginFrame < 33075;
+		test.Check(isCorrect, "Seek must follow the loop region");
+	}
+
+	// z : 5m ɕׂ 32 ̃[vA8 ܂Ŗ点ݒŖ炷
+	{
+		NullAudioVoiceDevice device;
+		AudioVoicePool pool(&device);
+		Settings limited;
+		limited.maxRealVoices = 8;
+		AudioSpatializer spatializer(&pool, limited);
+		const VoiceClip loopClip = makeClip(44100, 1.0f);
+		AudioListener origin;
+		constexpr float deltaTime = 1.0f / 60.0f;
+
+		std::vector<EmitterId> line;
+		AudioEmitterSettings emitterSettings;
+		for (int i = 0; i < 32; ++i)
+		{
+			line.push_back(spatializer.Play(loopClip, SE, AudioVoiceDevice::LoopInfinite, { i * 5.0f, 0.0f, 0.0f }, emitterSettings));
+		}
+		for (int frame = 0; frame < 3; ++frame)
+		{
+			pool.Update(deltaTime);
+			spatializer.Update(origin, deltaTime);
+		}
+		bool nearestAreReal = true;
+		for (int i = 0; i < 32; ++i)
+		{
+			nearestAreReal &= spatializer.GetResult(line[i]).isVirtual == (i >= 8);
+		}
+		test.Check(spatializer.GetStatistics().real == 8 && pool.GetPlayingCount(SE) == 8, "only maxRealVoices sources may hold a voice");
+		test.Check(nearestAreReal, "the loudest sources must hold the voices");
+		test.Check(spatializer.GetStatistics().audible > 8, "quieter audible sources must be virtualized");
+		test.Check(device.GetSpatial(0).left < device.GetSpatial(0).right || device.GetSpatial(0).left == 1.0f, "spatial results must reach the device");
+
+		// ΂̒[ɈڂƁA 8 ɐڂ
+		AudioListener farEnd = origin;
+		farEnd.position = { 155.0f, 0.0f, 0.0f };
+		const size_t restoredBefore = spatializer.GetStatistics().restored;
+		pool.Update(deltaTime);
+		spatializer.Update(farEnd, deltaTime);
+		bool farthestAreReal = true;
+		for (int i = 0; i < 32; ++i)
+		{
+			farthestAreReal &= spatializer.GetResult(line[i]).isVirtual == (i < 24);
+		}
+		test.Check(farthestAreReal && spatializer.GetStatistics().restored - restoredBefore == 8, "moving the listener must move the voices");
+		test.Check(device.GetLiveCount() <= pool.GetBudget().maxVoices, "voices must stay within the pool budget");
+
+		// zĂԂ̎Ԃi߂ʒu炷 (0.5 bɂĂ߂Â)
+		spatializer.StopAll();
+		const VoiceClip longClip = makeClip(44100, 2.0f);
+		const EmitterId late = spatializer.Play(longClip, SE, 0, { 500.0f, 0.0f, 0.0f }, emitterSettings);
+		test.Check(spatializer.GetResult(late).isVirtual, "an inaudible source must start virtual");
+		for (int frame = 0; frame < 30; ++frame)
+		{
+			pool.Update(deltaTime);
+			spatializer.Update(origin, deltaTime);
+		}
+		spatializer.SetPosition(late, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f });
+		pool.Update(deltaTime);
+		spatializer.Update(origin, deltaTime);
+		test.Check(!spatializer.GetResult(late).isVirtual && std::abs(static_cast<int>(device.GetLastBeginFrame()) - 44100 * 31 / 60) <= 2,
+			"a restored source must resume where it would have been");
+
+		// z܂ܒ߂ƁA炵I͊O
+		const VoiceClip shortClip = makeClip(44100, 0.25f);
+		const EmitterId quiet = spatializer.Play(shortClip, SE, 0, { 500.0f, 0.0f, 0.0f }, emitterSettings);
+		const EmitterId loud = spatializer.Play(shortClip, SE, 0, { 1.0f, 0.0f, 0.0f }, emitterSettings);
+		test.Check(!spatializer.GetResult(loud).isVirtual, "an audible source must start with a voice");
+		for (int frame = 0; frame < 20; ++frame)
+		{
+			pool.Update(deltaTime);
+			spatializer.Update(origin, deltaTime);
+		}
+		test.Check(!spatializer.IsPlaying(quiet) && !spatializer.IsPlaying(loud), "finished sources must be removed");
+		spatializer.Stop(late);
+		pool.Update(deltaTime);
+		spatializer.Update(origin, deltaTime);
+		test.Check(pool.GetPlayingCount(SE) == 0 && spatializer.GetStatistics().emitters == 0, "every voice must be returned");
+
+		const AudioSpatializer::Statistics& statistics = spatializer.GetStatistics();
+		test.Print("virtualization : started %zu, finished %zu, virtualized %zu, restored %zu, rejected %zu, voices created %zu",
+			statistics.started, statistics.finished, statistics.virtualized, statistics.restored, statistics.rejected, device.GetCreatedCount());
+	}
+
+	// vZ : 4096 
+	{
+		Batch simd, scalar;
+		fill(simd, 4096);
+		scalar = simd;
+		constexpr int repeat = 200;
+		auto begin = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeat; ++r)
+		{
+			AudioSpatializer::ComputeBatch(listener, settings, simd);
+		}
+		const double simdMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / repeat;
+		begin = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeat; ++r)
+		{
+			for (size_t i = 0; i < scalar.count; ++i)
+			{
+				AudioSpatializer::ComputeOne(listener, settings, scalar, i);
+			}
+		}
+		const double scalarMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / repeat;
+		test.Print("4096 emitters : batch %.1f us, one by one %.1f us (x%.1f)", simdMicroseconds, scalarMicroseconds,
+			simdMicroseconds > 0.0 ? scalarMicroseconds / simdMicroseconds : 0.0);
+	}
+}
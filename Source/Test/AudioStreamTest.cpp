@@ -0,0 +1,248 @@
+#include "Components/Audio/AudioStream.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include "Engine/Framework/SelfTest.h"
+
+// ꎞtH_ɍ WAV (PCM  IMA ADPCM) ŁAt@CŜǂލ܂ł̕@ƃXg[̃ƓǂݍݎԂׁA
+// ԂŎgfoCXŃ[vƓr؂m߂
+class AudioStreamTest
+{
+public:
+	static void Run(SelfTest& test);
+};
+
+void AudioStreamTest::Run(SelfTest& test)
+{
+	using Clock = std::chrono::steady_clock;
+	auto milliseconds = [](Clock::time_point begin) { return std::chrono::duration<double, std::milli>(Clock::now() - begin).count(); };
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "graphicEngine4_audio_stream";
+	std::error_code errorCode;
+	std::filesystem::create_directories(directory, errorCode);
+
+	// WAV  (fmt  data ̊Ԃɔ΂`NĂ)
+	auto writeWav = [](const std::filesystem::path& path, const std::vector<uint8_t>& fmt, const std::vector<uint8_t>& data)
+		{
+			std::ofstream stream(path, std::ios::binary);
+			auto write32 = [&stream](uint32_t value) { stream.write(reinterpret_cast<const char*>(&value), 4); };
+			const char list[] = "graphicEngine4";
+			write32(0);
+			stream.seekp(0);
+			stream.write("RIFF", 4);
+			write32(static_cast<uint32_t>(4 + 8 + fmt.size() + 8 + sizeof(list) + 1 + 8 + data.size()));
+			stream.write("WAVE", 4);
+			stream.write("fmt ", 4);
+			write32(static_cast<uint32_t>(fmt.size()));
+			stream.write(reinterpret_cast<const char*>(fmt.data()), fmt.size());
+			stream.write("LIST", 4);
+			write32(sizeof(list));
+			stream.write(list, sizeof(list));
+			stream.put(0);	// ̑傫̃`Ňɂ 1 oCgl߂
+			stream.write("data", 4);
+			write32(static_cast<uint32_t>(data.size()));
+			stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+			return static_cast<bool>(stream);
+		};
+	auto makeFmt = [](uint16_t tag, uint16_t channels, uint32_t rate, uint32_t averageBytes, uint16_t blockAlign, uint16_t bits, int samplesPerBlock)
+		{
+			std::vector<uint8_t> fmt;
+			auto push = [&fmt](uint32_t value, int bytes) { for (int i = 0; i < bytes; ++i) fmt.push_back(static_cast<uint8_t>(value >> (i * 8))); };
+			push(tag, 2); push(channels, 2); push(rate, 4); push(averageBytes, 4); push(blockAlign, 2); push(bits, 2);
+			if (samplesPerBlock > 0)
+			{
+				push(2, 2); push(static_cast<uint32_t>(samplesPerBlock), 2);
+			}
+			return fmt;
+		};
+
+	// 60 b BGM  (44.1kHz XeI 16 rbg) : ͒ʂԍAE͐g
+	constexpr uint32_t rate = 44100;
+	constexpr uint32_t longFrames = rate * 60;
+	auto sine = [](uint64_t frame) { return static_cast<int16_t>(std::sin(frame * 2.0 * 3.14159265358979 * 440.0 / rate) * 12000.0); };
+	std::vector<uint8_t> pcm(static_cast<size_t>(longFrames) * 4);
+	for (uint32_t frame = 0; frame < longFrames; ++frame)
+	{
+		const int16_t samples[2] = { static_cast<int16_t>(frame & 0xFFFF), sine(frame) };
+		std::memcpy(&pcm[frame * 4], samples, 4);
+	}
+	const std::filesystem::path pcmPath = directory / "stream_pcm.wav";
+	test.Check(writeWav(pcmPath, makeFmt(WavStreamReader::FormatPcm, 2, rate, rate * 4, 4, 16, 0), pcm), "failed to write the PCM file");
+
+	//  IMA ADPCM (`lƂgAubN 1024 oCg)
+	constexpr uint16_t adpcmBlockAlign = 1024;
+	constexpr uint32_t adpcmFramesPerBlock = (adpcmBlockAlign - 8) * 2 / 2 + 1;
+	std::vector<uint8_t> adpcm;
+	{
+		int predictors[2] = {}, indices[2] = {};
+		for (uint32_t first = 0; first < longFrames; first += adpcmFramesPerBlock)
+		{
+			const size_t blockStart = adpcm.size();
+			adpcm.resize(blockStart + adpcmBlockAlign, 0);
+			for (int channel = 0; channel < 2; ++channel)
+			{
+				predictors[channel] = sine(first);
+				uint8_t* header = &adpcm[blockStart + channel * 4];
+				header[0] = static_cast<uint8_t>(predictors[channel] & 0xFF);
+				header[1] = static_cast<uint8_t>((predictors[channel] >> 8) & 0xFF);
+				header[2] = static_cast<uint8_t>(indices[channel]);
+			}
+			for (uint32_t i = 1; i < adpcmFramesPerBlock; ++i)
+			{
+				const uint32_t group = (i - 1) / 8, slot = (i - 1) % 8;
+				for (int channel = 0; channel < 2; ++channel)
+				{
+					const int target = first + i < longFrames ? sine(first + i) : 0;
+					int difference = target - predictors[channel];
+					int nibble = 0;
+					if (difference < 0)
+					{
+						nibble = 8;
+						difference = -difference;
+					}
+					int step = WavStreamReader::GetImaStep(indices[channel]);
+					for (int mask = 4; mask > 0; mask >>= 1, step >>= 1)
+					{
+						if (difference >= step)
+						{
+							nibble |= mask;
+							difference -= step;
+						}
+					}
+					WavStreamReader::DecodeImaNibble(nibble, predictors[channel], indices[channel]);
+					adpcm[blockStart + 8 + (group * 2 + channel) * 4 + slot / 2] |= static_cast<uint8_t>(nibble << ((slot & 1) * 4));
+				}
+			}
+		}
+	}
+	const std::filesystem::path adpcmPath = directory / "stream_adpcm.wav";
+	test.Check(writeWav(adpcmPath, makeFmt(WavStreamReader::FormatImaAdpcm, 2, rate, rate * adpcmBlockAlign / adpcmFramesPerBlock, adpcmBlockAlign, 4, adpcmFramesPerBlock), adpcm),
+		"failed to write the IMA ADPCM file");
+
+	auto nullFactory = [](double timeScale, NullAudioStreamVoice** created)
+		{
+			return [timeScale, created](const VoiceFormat& format) -> std::unique_ptr<AudioStreamVoice>
+				{
+					auto voice = std::make_unique<NullAudioStreamVoice>(format, format.samplesPerSec * format.blockAlign);
+					voice->SetTimeScale(timeScale);
+					*created = voice.get();
+					return voice;
+				};
+		};
+
+	// ܂ : t@CŜɓǂ (AudioBuffer::GetResource Ɠ)
+	{
+		const Clock::time_point begin = Clock::now();
+		std::ifstream stream(pcmPath, std::ios::binary);
+		std::vector<uint8_t> whole(static_cast<size_t>(std::filesystem::file_size(pcmPath, errorCode)));
+		stream.read(reinterpret_cast<char*>(whole.data()), static_cast<std::streamsize>(whole.size()));
+		test.Print("before (whole file, PCM 60 s)   : %.2f MB resident, load %.2f ms", whole.size() / (1024.0 * 1024.0), milliseconds(begin));
+	}
+	// Xg[ : wb_[ǂނ̎ԂƁAŏ̃obt@ǂނ܂ł̎
+	for (const std::filesystem::path& path : { pcmPath, adpcmPath })
+	{
+		NullAudioStreamVoice* voice = nullptr;
+		const Clock::time_point begin = Clock::now();
+		AudioStream stream(path, nullFactory(1.0, &voice));
+		const double openMilliseconds = milliseconds(begin);
+		test.Check(stream.IsValid(), "failed to open the stream");
+		if (!stream.IsValid())
+		{
+			continue;
+		}
+		std::vector<uint8_t> first(stream.bufferBytes);
+		uint32_t loops = 0;
+		bool isEnd = false;
+		const Clock::time_point fillBegin = Clock::now();
+		stream.Fill(first.data(), loops, isEnd);
+		const double fillMilliseconds = milliseconds(fillBegin);
+		test.Print("after  (stream, %-5s 60 s)     : %.2f MB resident (%zu x %.0f ms buffers), open %.3f ms, first buffer %.3f ms, file %.2f MB",
+			path == pcmPath ? "PCM" : "ADPCM", stream.GetResidentBytes() / (1024.0 * 1024.0), AudioStream::BufferCount,
+			1000.0 * stream.bufferBytes / (stream.GetFormat().samplesPerSec * stream.GetFormat().blockAlign), openMilliseconds, fillMilliseconds,
+			std::filesystem::file_size(path, errorCode) / (1024.0 * 1024.0));
+	}
+
+	// IMA ADPCM ̃fR[h : ̐gƂ̍ (SNR) ƁAr Seek ɏɓǂ񂾎ƓɂȂ邩
+	{
+		WavStreamReader reader;
+		test.Check(reader.Open(adpcmPath), "failed to open the IMA ADPCM file");
+		test.Check(reader.GetFrameCount() >= longFrames, "IMA ADPCM frame count is too small");
+		std::vector<int16_t> decoded(static_cast<size_t>(reader.GetFrameCount()) * 2);
+		const Clock::time_point begin = Clock::now();
+		const size_t read = reader.Read(reinterpret_cast<uint8_t*>(decoded.data()), static_cast<size_t>(reader.GetFrameCount()));
+		const double decodeMilliseconds = milliseconds(begin);
+		double signal = 0.0, noise = 0.0;
+		for (uint32_t frame = 0; frame < longFrames && frame < read; ++frame)
+		{
+			const double expected = sine(frame);
+			signal += expected * expected;
+			noise += (decoded[frame * 2] - expected) * (decoded[frame * 2] - expected);
+		}
+		const double snr = 10.0 * std::log10(signal / (std::max)(noise, 1.0));
+		test.Check(read == reader.GetFrameCount() && snr > 30.0, "IMA ADPCM decode is too noisy");
+
+		const uint64_t seekFrame = adpcmFramesPerBlock * 7 + 123;
+		int16_t samples[64] = {};
+		reader.Seek(seekFrame);
+		reader.Read(reinterpret_cast<uint8_t*>(samples), 32);
+		test.Check(decoded.size() > (seekFrame + 32) * 2 && std::memcmp(samples, &decoded[seekFrame * 2], sizeof(samples)) == 0, "IMA ADPCM seek must match sequential decode");
+		test.Print("IMA ADPCM decode : %.1f ms for 60 s (x%.0f real time), SNR %.1f dB", decodeMilliseconds,
+			decodeMilliseconds > 0.0 ? 60000.0 / decodeMilliseconds : 0.0, snr);
+	}
+
+	// [vĐ : 2 b PCM  [0.5, 1.0) b̋Ԃ 2 񃋁[vAgꂽԂ
+	// [0, 1.0) [0.5, 1.0) [0.5, 2.0) ɂȂ邩Ar؂Ȃm߂ (4 {̑Ŏg)
+	{
+		const uint32_t frames = rate * 2;
+		std::vector<uint8_t> shortPcm(pcm.begin(), pcm.begin() + frames * 4);
+		const std::filesystem::path shortPath = directory / "stream_loop.wav";
+		test.Check(writeWav(shortPath, makeFmt(WavStreamReader::FormatPcm, 2, rate, rate * 4, 4, 16, 0), shortPcm), "failed to write the loop file");
+
+		NullAudioStreamVoice* voice = nullptr;
+		AudioStream stream(shortPath, nullFactory(4.0, &voice), 0.05f);
+		std::vector<uint16_t> consumed;
+		if (voice)
+		{
+			voice->SetConsumer([&consumed](const uint8_t* data, uint32_t bytes)
+				{
+					for (uint32_t offset = 0; offset + 4 <= bytes; offset += 4)
+					{
+						uint16_t index = 0;
+						std::memcpy(&index, data + offset, 2);
+						consumed.push_back(index);
+					}
+				});
+		}
+		stream.SetLoop(0.5f, 0.5f);
+		const Clock::time_point begin = Clock::now();
+		stream.Play(2);
+		while (stream.IsPlaying() && milliseconds(begin) < 5000.0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		const double playMilliseconds = milliseconds(begin);
+		test.Check(!stream.IsPlaying(), "the stream did not finish");
+		stream.Stop();
+
+		std::vector<uint16_t> expected;
+		const uint32_t loopBegin = rate / 2, loopEnd = rate;
+		for (uint32_t frame = 0; frame < loopEnd; ++frame) expected.push_back(static_cast<uint16_t>(frame));
+		for (uint32_t frame = loopBegin; frame < loopEnd; ++frame) expected.push_back(static_cast<uint16_t>(frame));
+		for (uint32_t frame = loopBegin; frame < frames; ++frame) expected.push_back(static_cast<uint16_t>(frame));
+		test.Check(consumed == expected, "consumed samples must follow the loop region");
+		test.Check(voice && voice->GetUnderrunCount() == 0, "the stream must not underrun");
+		test.Print("loop playback : %zu frames (expected %zu), %u underruns, %.0f ms for %.2f s of audio at x4", consumed.size(), expected.size(),
+			voice ? voice->GetUnderrunCount() : 0u, playMilliseconds, expected.size() / static_cast<double>(rate));
+		std::filesystem::remove(shortPath, errorCode);
+	}
+	std::filesystem::remove(pcmPath, errorCode);
+	std::filesystem::remove(adpcmPath, errorCode);
+}
+
+SELF_TEST(AudioStream)
+{
+	AudioStreamTest::Run(test);
+}
@@ -0,0 +1,95 @@
+#include "Components/Audio/AudioVoicePool.h"
+
+#include <chrono>
+#include <iterator>
+#include <random>
+
+#include "Engine/Framework/SelfTest.h"
+
+// 炳ȂfoCXőʂɖ炵āAEg񂵁E~߂鏇Ԃm߂
+SELF_TEST(AudioVoicePool)
+{
+	using Handle = AudioVoicePool::Handle;
+	using Budget = AudioVoicePool::Budget;
+	constexpr Handle InvalidHandle = AudioVoicePool::InvalidHandle;
+
+	auto makeClip = [](uint32_t samplesPerSec, uint16_t channels, float seconds)
+		{
+			VoiceClip clip;
+			clip.format = { 1, channels, samplesPerSec, 16, static_cast<uint16_t>(channels * 2) };
+			clip.seconds = seconds;
+			clip.bytes = static_cast<uint32_t>(samplesPerSec * channels * 2 * seconds);
+			return clip;
+		};
+
+	// ~߂鏇 : SE  2 ܂łɂĊm߂
+	{
+		NullAudioVoiceDevice device;
+		Budget budget;
+		budget.maxVoices = 4;
+		budget.maxPlaying[SE] = 2;
+		AudioVoicePool pool(&device, budget);
+		const VoiceClip clip = makeClip(44100, 2, 1.0f);
+
+		const Handle a = pool.Play(clip, SE, { 1.0f, 1, 0.0f });
+		const Handle b = pool.Play(clip, SE, { 1.0f, 0, 1.0f });
+		// DxŁAĂ b 艓̂Ŗ炳Ȃ
+		const Handle c = pool.Play(clip, SE, { 1.0f, 0, 10.0f });
+		test.Check(a != InvalidHandle && b != InvalidHandle && c == InvalidHandle, "a farther sound with the same priority must be rejected");
+		// Dx̂ŁAԗDxႢ b ~߂
+		const Handle d = pool.Play(clip, SE, { 1.0f, 2, 10.0f });
+		test.Check(d != InvalidHandle && pool.IsPlaying(a) && !pool.IsPlaying(b) && pool.IsPlaying(d), "the lowest priority voice must be stolen");
+		// ~߂ꂽ b  Handle ŐGĂAg񂵂 d ɂ͉eȂ
+		pool.Stop(b);
+		test.Check(pool.IsPlaying(d), "a stale handle must not stop the recycled voice");
+		// Dxŋ߂̂ŁAa ~߂
+		const Handle e = pool.Play(clip, SE, { 1.0f, 1, 0.0f });
+		test.Check(e != InvalidHandle && !pool.IsPlaying(a) && pool.IsPlaying(d), "an equally important older voice must be stolen");
+		test.Check(device.GetCreatedCount() == 2, "stealing must reuse the stolen voice");
+		// BGM  SE ̏Ƃ͕ʂɖ点
+		const Handle bgm = pool.Play(clip, BGM, { 1.0f, 0, 0.0f });
+		test.Check(bgm != InvalidHandle && pool.GetPlayingCount(SE) == 2 && pool.GetPlayingCount(BGM) == 1, "the budget must be per SoundType");
+	}
+
+	// ʂɖ炷 : 3 ̌`퓬̂悤ɂ܂Ƃ߂Ė炷
+	{
+		NullAudioVoiceDevice device;
+		Budget budget;
+		AudioVoicePool pool(&device, budget);
+		const VoiceClip clips[] = { makeClip(44100, 2, 0.4f), makeClip(44100, 2, 1.5f), makeClip(48000, 1, 0.25f), makeClip(22050, 1, 0.8f) };
+		pool.Prewarm(clips[0], SE, 8);
+		const size_t prewarmed = pool.GetStatistics().created;
+
+		std::mt19937 random(2024);
+		constexpr int frameCount = 1200;
+		constexpr float deltaTime = 1.0f / 60.0f;
+		size_t accepted = 0;
+		const auto begin = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < frameCount; ++frame)
+		{
+			// 1 bƂ 60 ܂Ƃ߂Ė炷 (̘AȂ)
+			const int count = frame % 60 == 0 ? 60 : static_cast<int>(random() % 4);
+			for (int i = 0; i < count; ++i)
+			{
+				const VoiceClip& clip = clips[random() % std::size(clips)];
+				AudioVoicePool::PlayParams params;
+				params.priority = static_cast<int>(random() % 4);
+				params.distance = static_cast<float>(random() % 5000) / 100.0f;
+				accepted += pool.Play(clip, SE, params) != InvalidHandle ? 1 : 0;
+			}
+			pool.Update(deltaTime);
+
+			test.Check(pool.GetPlayingCount(SE) <= budget.maxPlaying[SE], "SE voices must stay within the budget");
+			test.Check(pool.GetStatistics().voices <= budget.maxVoices && device.GetLiveCount() == pool.GetStatistics().voices, "voice count must stay within the budget");
+		}
+		const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		pool.StopAll();
+		test.Check(pool.GetStatistics().playing == 0, "StopAll must release every voice");
+
+		const AudioVoicePool::Statistics& statistics = pool.GetStatistics();
+		test.Check(statistics.created - prewarmed + statistics.reused == accepted, "every accepted play must create or reuse a voice");
+		test.Print("%d frames, %zu plays, %zu played : created %zu voices (%zu without the pool), reused %zu, stolen %zu, rejected %zu, evicted %zu, peak %zu, %.3f ms",
+			frameCount, statistics.plays, accepted, statistics.created, accepted, statistics.reused, statistics.stolen, statistics.rejected, statistics.evicted,
+			statistics.peakPlaying, milliseconds);
+	}
+}
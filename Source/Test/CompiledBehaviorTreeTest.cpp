@@ -0,0 +1,289 @@
+#include "Game/Actors/Enemy/CompiledBehaviorTree.h"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Engine/Utility/Deterministic.h"
+#include "Game/Actors/Enemy/ActionBase.h"
+#include "Game/Actors/Enemy/BehaviorData.h"
+#include "Game/Actors/Enemy/JudgmentBase.h"
+#include "Game/Actors/Enemy/NodeBase.h"
+
+namespace
+{
+	//vp̓G̏ (RiderEnemy ̑ owner Ƃēn)
+	struct FakeEnemy
+	{
+		Deterministic::Random random{ 1u };
+		uint32_t lastRandom = 0;	//̃t[̗ (Advance ōXV)
+		uint32_t flags = 0;
+		uint64_t history = 0;	//ss̕т̃nbV
+	};
+
+	FakeEnemy* ToFake(RiderEnemy* owner) { return reinterpret_cast<FakeEnemy*>(owner); }
+	RiderEnemy* ToOwner(FakeEnemy* enemy) { return reinterpret_cast<RiderEnemy*>(enemy); }
+
+	template<int Flag>
+	class FlagJudgment :public JudgmentBase
+	{
+	public:
+		FlagJudgment(RiderEnemy* enemy) :JudgmentBase(enemy) {}
+		bool Judgment() override { return (ToFake(owner)->flags >> Flag) & 1; }
+	};
+
+	//ʂtO낷 (TerrainJudgment ̂悤ɔŏԂς)
+	template<int Flag>
+	class ConsumeJudgment :public JudgmentBase
+	{
+	public:
+		ConsumeJudgment(RiderEnemy* enemy) :JudgmentBase(enemy) {}
+		bool Judgment() override
+		{
+			FakeEnemy* enemy = ToFake(owner);
+			const bool result = (enemy->flags >> Flag) & 1;
+			enemy->flags &= ~(1u << Flag);
+			return result;
+		}
+	};
+
+	template<int Id, int Frames>
+	class FrameAction :public ActionBase
+	{
+	public:
+		FrameAction(RiderEnemy* enemy) :ActionBase(enemy) {}
+		ActionBase::State Run(float elapsedTime) override
+		{
+			FakeEnemy* enemy = ToFake(owner);
+			enemy->history = enemy->history * 1099511628211ull + Id;
+			if (++step >= Frames)
+			{
+				step = 0;
+				//Id  9 ̍s͂܂Ɏs
+				return (Id == 9 && (enemy->lastRandom & 4)) ? ActionBase::State::Failed : ActionBase::State::Complete;
+			}
+			return ActionBase::State::Run;
+		}
+	};
+
+	//1 t[AG̏Ԃς
+	void Advance(FakeEnemy& enemy)
+	{
+		enemy.lastRandom = enemy.random.Next();
+		const uint32_t r = enemy.lastRandom;
+		uint32_t flags = 0;
+		flags |= ((r >> 24) < 2) ? 1u << 0 : 0;		//StartPerf
+		flags |= ((r >> 16) & 0x3F) < 3 ? 1u << 1 : 0;	//Damage
+		flags |= (r >> 3) & 1 ? 1u << 2 : 0;			//Battle
+		flags |= ((r >> 8) & 0x1F) == 0 ? 1u << 3 : 0;	//Special
+		flags |= ((r >> 13) & 0x7) == 0 ? 1u << 4 : 0;	//Terrain
+		flags |= (r >> 5) & 1 ? 1u << 5 : 0;			//Pursuit
+		flags |= (r >> 6) & 1 ? 1u << 6 : 0;			//Attack
+		flags |= (r >> 7) & 1 ? 1u << 7 : 0;			//Normal
+		flags |= (r >> 9) & 1 ? 1u << 8 : 0;			//Charge
+		flags |= (r >> 10) & 1 ? 1u << 9 : 0;			//Summon
+		flags |= (r >> 11) & 1 ? 1u << 10 : 0;			//CoolPursuit
+		flags |= (r >> 12) & 1 ? 1u << 11 : 0;			//Patrol
+		enemy.flags = flags;
+	}
+
+	using Rule = BehaviorTree::SelectRule;
+
+	//RiderEnemy Ɠ`̃c[ (Scout ̉ɃV[PX𑫂Ă)
+	template<class AddNode>
+	void BuildTestTree(AddNode&& add)
+	{
+		add("", "Root", 0, Rule::Priority, -1, -1);
+		add("Root", "StartPerf", 0, Rule::Non, 0, 0);
+		add("Root", "Damage", 1, Rule::Non, 1, 1);
+		add("Root", "Battle", 2, Rule::Priority, 2, -1);
+		add("Root", "Scout", 3, Rule::Priority, -1, -1);
+		add("Battle", "Special", 0, Rule::Non, 3, 2);
+		add("Battle", "Terrain", 1, Rule::Non, 4, 3);
+		add("Battle", "Pursuit", 2, Rule::Non, 5, 4);
+		add("Battle", "Attack", 3, Rule::Random, 6, -1);
+		add("Attack", "Normal", 0, Rule::Non, 7, 5);
+		add("Attack", "Dash", 1, Rule::Non, 8, 6);
+		add("Attack", "Bombing", 2, Rule::Non, -1, 7);
+		add("Attack", "Summon", 3, Rule::Non, 9, 8);
+		add("Scout", "CoolPursuit", 0, Rule::Non, 10, 9);
+		add("Scout", "Patrol", 1, Rule::Sequence, 11, -1);
+		add("Scout", "Idle", 2, Rule::Non, -1, 10);
+		add("Patrol", "Walk", 0, Rule::Non, -1, 11);
+		add("Patrol", "Look", 1, Rule::Non, -1, 12);
+	}
+
+	template<int Index>
+	JudgmentBase* NewJudgment(RiderEnemy* owner)
+	{
+		if constexpr (Index == 4)
+		{
+			return new ConsumeJudgment<Index>(owner);
+		}
+		else
+		{
+			return new FlagJudgment<Index>(owner);
+		}
+	}
+	template<int Index>
+	std::unique_ptr<JudgmentBase> MakeTestJudgment(RiderEnemy* owner) { return std::unique_ptr<JudgmentBase>(NewJudgment<Index>(owner)); }
+	template<int Index>
+	std::unique_ptr<ActionBase> MakeTestAction(RiderEnemy* owner) { return std::make_unique<FrameAction<Index, 1 + Index % 4>>(owner); }
+
+	template<size_t... I>
+	constexpr std::array<CompiledBehaviorTree::JudgmentFactory, sizeof...(I)> JudgmentFactories(std::index_sequence<I...>) { return { &MakeTestJudgment<I>... }; }
+	template<size_t... I>
+	constexpr std::array<CompiledBehaviorTree::ActionFactory, sizeof...(I)> ActionFactories(std::index_sequence<I...>) { return { &MakeTestAction<I>... }; }
+}
+
+//BehaviorTree Ɠm[hIԂA܂Ƃ߂čXVĂA
+//̂̓G BehaviorTree (GƂ̃m[h) ƋLc[ (1 ̂E܂Ƃ߂) ōXV 1 ̂̎
+SELF_TEST(CompiledBehaviorTree)
+{
+	using Builder = CompiledBehaviorTree::Builder;
+	using Node = CompiledBehaviorTree::Node;
+	constexpr uint16_t InvalidIndex = CompiledBehaviorTree::InvalidIndex;
+
+	constexpr auto judgmentFactories = JudgmentFactories(std::make_index_sequence<12>());
+	constexpr auto actionFactories = ActionFactories(std::make_index_sequence<13>());
+
+	Builder builder;
+	BuildTestTree([&](const char* parent, const char* name, int priority, Rule rule, int judgment, int action)
+		{
+			builder.AddNode(parent, name, priority, rule, judgment < 0 ? nullptr : judgmentFactories[judgment], action < 0 ? nullptr : actionFactories[action]);
+		});
+	const std::shared_ptr<const CompiledBehaviorTree> tree = builder.Compile();
+
+	//DŕсAqĂ
+	{
+		bool contiguous = tree->GetNodeCount() == 18 && tree->GetName(tree->GetRoot()) == "Root" && tree->GetSequenceCount() == 1;
+		for (uint16_t i = 0; i < tree->GetNodeCount() && contiguous; ++i)
+		{
+			const Node& node = tree->GetNode(i);
+			contiguous &= node.childCount == 0 || node.firstChild > i;
+		}
+		const uint16_t attack = tree->FindNode("Attack");
+		contiguous &= attack != InvalidIndex && tree->GetNode(attack).childCount == 4 && tree->GetName(tree->GetNode(attack).firstChild + 2) == "Bombing";
+		test.Check(contiguous, "the compiled tree must be breadth-first with contiguous children");
+	}
+
+	constexpr size_t AgentCount = 4096;
+	constexpr int Frames = 240;
+	constexpr float ElapsedTime = 1.0f / 60.0f;
+	struct Result
+	{
+		std::vector<uint64_t> history;
+		double buildMicroseconds = 0.0;
+		double tickMicroseconds = 0.0;
+	};
+
+	//BehaviorTree (GƂ NodeBase  new AOŐeTđgݗĂ)
+	auto runOld = [&]()
+		{
+			Result result;
+			std::vector<FakeEnemy> enemies(AgentCount);
+			std::vector<std::unique_ptr<BehaviorTree>> trees(AgentCount);
+			std::vector<std::unique_ptr<BehaviorData>> data(AgentCount);
+			std::vector<NodeBase*> activeNodes(AgentCount, nullptr);
+			auto begin = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < AgentCount; ++i)
+			{
+				enemies[i].random = Deterministic::Random(static_cast<uint32_t>(i * 7919 + 1));
+				RiderEnemy* owner = ToOwner(&enemies[i]);
+				trees[i] = std::make_unique<BehaviorTree>(owner);
+				data[i] = std::make_unique<BehaviorData>();
+				BuildTestTree([&](const char* parent, const char* name, int priority, Rule rule, int judgment, int action)
+					{
+						trees[i]->AddNode(parent, name, priority, rule,
+							judgment < 0 ? nullptr : judgmentFactories[judgment](owner).release(), action < 0 ? nullptr : actionFactories[action](owner).release());
+					});
+			}
+			result.buildMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+			std::srand(48);
+			for (int frame = 0; frame < Frames; ++frame)
+			{
+				for (FakeEnemy& enemy : enemies)
+				{
+					Advance(enemy);
+				}
+				begin = std::chrono::steady_clock::now();
+				for (size_t i = 0; i < AgentCount; ++i)
+				{
+					if (activeNodes[i] == nullptr)
+					{
+						activeNodes[i] = trees[i]->ActiveNodeInference(data[i].get());
+					}
+					if (activeNodes[i] != nullptr)
+					{
+						activeNodes[i] = trees[i]->Run(activeNodes[i], data[i].get(), ElapsedTime);
+					}
+				}
+				result.tickMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+			}
+			for (const FakeEnemy& enemy : enemies)
+			{
+				result.history.push_back(enemy.history);
+			}
+			return result;
+		};
+
+	//Lc[ (1 ̂ TickA܂͂܂Ƃ߂ TickBatch)
+	auto runCompiled = [&](bool batch)
+		{
+			Result result;
+			std::vector<FakeEnemy> enemies(AgentCount);
+			std::vector<std::unique_ptr<BehaviorAgent>> agents(AgentCount);
+			std::vector<BehaviorAgent*> agentPointers(AgentCount);
+			auto begin = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < AgentCount; ++i)
+			{
+				enemies[i].random = Deterministic::Random(static_cast<uint32_t>(i * 7919 + 1));
+				agents[i] = std::make_unique<BehaviorAgent>(tree, ToOwner(&enemies[i]));
+				agentPointers[i] = agents[i].get();
+			}
+			result.buildMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+			std::srand(48);
+			for (int frame = 0; frame < Frames; ++frame)
+			{
+				for (FakeEnemy& enemy : enemies)
+				{
+					Advance(enemy);
+				}
+				begin = std::chrono::steady_clock::now();
+				if (batch)
+				{
+					BehaviorAgent::TickBatch(agentPointers.data(), agentPointers.size(), ElapsedTime);
+				}
+				else
+				{
+					for (BehaviorAgent* agent : agentPointers)
+					{
+						agent->Tick(ElapsedTime);
+					}
+				}
+				result.tickMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+			}
+			for (const FakeEnemy& enemy : enemies)
+			{
+				result.history.push_back(enemy.history);
+			}
+			return result;
+		};
+
+	const Result old = runOld();
+	const Result single = runCompiled(false);
+	const Result batch = runCompiled(true);
+	test.Check(old.history == single.history, "the compiled tree must run the same actions as BehaviorTree");
+	test.Check(single.history == batch.history, "TickBatch must run the same actions as Tick");
+
+	const double ticks = static_cast<double>(AgentCount) * Frames;
+	test.Print("%zu agents x %d frames, %zu nodes (%u judgments, %u actions) shared",
+		AgentCount, Frames, tree->GetNodeCount(), tree->GetJudgmentCount(), tree->GetActionCount());
+	test.Print("build / agent : BehaviorTree %.2f us, compiled %.2f us", old.buildMicroseconds / AgentCount, single.buildMicroseconds / AgentCount);
+	test.Print("tick / agent : BehaviorTree %.1f ns, compiled %.1f ns, batch %.1f ns",
+		old.tickMicroseconds * 1000.0 / ticks, single.tickMicroseconds * 1000.0 / ticks, batch.tickMicroseconds * 1000.0 / ticks);
+}
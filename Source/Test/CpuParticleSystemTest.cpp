@@ -0,0 +1,241 @@
+#include "Graphics/Effect/CpuParticleSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Graphics/Effect/ParticleEmitterPool.h"
+
+using namespace DirectX;
+
+// SIMD  1 ̌vZAƐA\[g̏ԁA
+// G~b^[ 100 𓯎ɓ̐ (v[EȂ) ƍXVE\[g̎
+SELF_TEST(CpuParticleSystem)
+{
+    using EmitterSettings = CpuParticleSystem::EmitterSettings;
+    using Sample = CpuParticleSystem::Sample;
+    constexpr float deltaTime = 1.0f / 60.0f;
+
+    auto makeSettings = [](bool loop)
+        {
+            EmitterSettings settings;
+            settings.emissionPosition = { 1.0f, 2.0f, 3.0f };
+            settings.emissionOffset = { 0.0f, 0.5f };
+            settings.emissionConeAngle = { 0.0f, 0.8f };
+            settings.emissionSpeed = { 1.0f, 4.0f };
+            settings.lifespan = { 0.3f, 1.2f };
+            settings.spawnDelay = { 0.0f, 0.2f };
+            settings.fadeDuration = { 0.1f, 0.3f };
+            settings.gravity = -2.0f;
+            settings.direction = { 0.3f, 1.0f, 0.2f };
+            settings.strength = 1.0f;
+            settings.spriteSheetGrid = { 5, 4 };
+            settings.loop = loop;
+            return settings;
+        };
+
+    // SIMD  1 ̌vZɂȂ邩 (4 ̔{łȂArŐ)
+    {
+        CpuParticleSystem simd(1000, 7);
+        simd.settings = makeSettings(true);
+        simd.Emit(997);
+        CpuParticleSystem scalar = simd;
+        bool sameCount = true;
+        for (int frame = 0; frame < 120; ++frame)
+        {
+            simd.Update(deltaTime);
+            scalar.UpdateScalar(deltaTime);
+            sameCount &= simd.GetParticleCount() == scalar.GetParticleCount();
+        }
+        float maxError = 0.0f;
+        for (uint32_t i = 0; i < simd.GetParticleCount() && sameCount; ++i)
+        {
+            const Sample a = simd.GetSample(i);
+            const Sample b = scalar.GetSample(i);
+            for (float error : { a.position.x - b.position.x, a.position.y - b.position.y, a.position.z - b.position.z, a.velocity.y - b.velocity.y,
+                a.age - b.age, a.angle - b.angle, a.colorT - b.colorT, a.alpha - b.alpha })
+            {
+                maxError = (std::max)(maxError, std::fabs(error));
+            }
+        }
+        test.Check(sameCount && maxError < 1e-4f, "the SIMD update must match the scalar update");
+        test.Check(simd.GetParticleCount() == 997 && simd.GetStatistics().respawned > 0, "looping particles must be respawned");
+        test.Print("SIMD vs scalar : %u particles, max error %.2e, respawned %zu", simd.GetParticleCount(), maxError, simd.GetStatistics().respawned);
+    }
+
+    //  : [vȂ (x + ) ̍ő̌ɑSĊO
+    {
+        CpuParticleSystem system(256, 3);
+        system.settings = makeSettings(false);
+        system.Emit(300);
+        test.Check(system.GetParticleCount() == 256, "Emit must stop at the particle limit");
+        uint32_t peak = 0;
+        for (int frame = 0; frame < 90; ++frame)
+        {
+            system.Update(deltaTime);
+            peak = (std::max)(peak, system.GetParticleCount());
+        }
+        test.Check(!system.IsAlive() && system.GetStatistics().expired == 256, "expired particles must be removed");
+
+        // 1 b̐Ő
+        system.Reset(128);
+        system.settings = makeSettings(false);
+        system.SetEmissionRate(60.0f);
+        for (int frame = 0; frame < 30; ++frame)
+        {
+            system.Update(deltaTime);
+        }
+        const size_t spawned = system.GetStatistics().spawned;
+        test.Check(spawned >= 29 && spawned <= 30, "the emission rate must spawn particles per second");
+    }
+
+    // [̃\[g : ŁAstd::stable_sort Ɠ
+    {
+        CpuParticleSystem system(1000, 11);
+        system.settings = makeSettings(false);
+        system.settings.emissionOffset = { 0.0f, 30.0f };
+        system.settings.spawnDelay = { 0.0f, 0.0f };
+        system.Emit(1000);
+        system.Update(deltaTime);
+        const XMFLOAT3 camera = { 0.0f, 1.0f, -20.0f };
+        const XMFLOAT3 forward = { 0.0f, 0.0f, 1.0f };
+        system.SortByDepth(camera, forward);
+        std::vector<uint32_t> expected(system.GetParticleCount());
+        std::iota(expected.begin(), expected.end(), 0u);
+        auto depth = [&](uint32_t i)
+            {
+                const Sample s = system.GetSample(i);
+                return (s.position.x - camera.x) * forward.x + (s.position.y - camera.y) * forward.y + (s.position.z - camera.z) * forward.z;
+            };
+        std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return depth(a) > depth(b); });
+        test.Check(system.GetDrawOrder() == expected, "the radix sort must order particles far to near");
+
+        // GPU  Particle ƓO̍\̂ɏo
+        struct ParticleLayout
+        {
+            int state;
+            XMFLOAT4 color;
+            XMFLOAT3 position;
+            float mass, angle, angularSpeed;
+            XMFLOAT3 velocity;
+            float lifespan, age;
+            XMFLOAT2 size;
+            int chip;
+        };
+        std::vector<ParticleLayout> written(system.GetParticleCount());
+        const uint32_t writtenCount = system.Write(written.data(), static_cast<uint32_t>(written.size()));
+        test.Check(writtenCount == written.size() && written[0].position.z == system.GetSample(expected[0]).position.z && written[0].chip < 20,
+            "Write must output particles in draw order");
+    }
+
+    // G~b^[ 100  : I (qȂ) G~b^[ԂāAVG~b^[𐶐
+    struct Churn
+    {
+        double spawnMicroseconds = 0.0;
+        double updateMicroseconds = 0.0;
+        double sortMicroseconds = 0.0;
+        size_t spawns = 0;
+        size_t particles = 0;
+    };
+    constexpr int EmitterCount = 100;
+    constexpr int Frames = 600;
+    auto runChurn = [&](bool usePool, bool useSimd, bool useRadix)
+        {
+            Churn churn;
+            ParticleEmitterPool<CpuParticleSystem> pool([](uint32_t capacity) { return std::make_unique<CpuParticleSystem>(capacity); });
+            std::mt19937 random(48);
+            std::uniform_int_distribution<uint32_t> particleCount(32, 512);
+            std::vector<std::unique_ptr<CpuParticleSystem>> emitters;
+            auto spawn = [&]()
+                {
+                    const uint32_t n = particleCount(random);
+                    const auto begin = std::chrono::steady_clock::now();
+                    std::unique_ptr<CpuParticleSystem> emitter;
+                    if (usePool)
+                    {
+                        emitter = pool.Acquire(n);
+                    }
+                    else
+                    {
+                        emitter = std::make_unique<CpuParticleSystem>(n);
+                    }
+                    emitter->settings = makeSettings(false);
+                    emitter->Emit(n);
+                    churn.spawnMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+                    ++churn.spawns;
+                    return emitter;
+                };
+            for (int i = 0; i < EmitterCount; ++i)
+            {
+                emitters.push_back(spawn());
+            }
+            std::vector<float> depths;
+            std::vector<uint32_t> order;
+            for (int frame = 0; frame < Frames; ++frame)
+            {
+                auto begin = std::chrono::steady_clock::now();
+                for (auto& emitter : emitters)
+                {
+                    useSimd ? emitter->Update(deltaTime) : emitter->UpdateScalar(deltaTime);
+                    churn.particles += emitter->GetParticleCount();
+                }
+                churn.updateMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+                begin = std::chrono::steady_clock::now();
+                for (auto& emitter : emitters)
+                {
+                    if (useRadix)
+                    {
+                        emitter->SortByDepth({ 0.0f, 1.0f, -20.0f }, { 0.0f, 0.0f, 1.0f });
+                    }
+                    else
+                    {
+                        // ׂp : [߂ std::sort
+                        const uint32_t n = emitter->GetParticleCount();
+                        depths.resize(n);
+                        order.resize(n);
+                        for (uint32_t i = 0; i < n; ++i)
+                        {
+                            depths[i] = emitter->GetSample(i).position.z + 20.0f;
+                            order[i] = i;
+                        }
+                        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return depths[a] > depths[b]; });
+                    }
+                }
+                churn.sortMicroseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+                for (auto& emitter : emitters)
+                {
+                    if (!emitter->IsAlive())
+                    {
+                        if (usePool)
+                        {
+                            pool.Release(std::move(emitter));
+                        }
+                        emitter = spawn();
+                    }
+                }
+            }
+            if (usePool && useSimd)
+            {
+                const ParticleEmitterPool<CpuParticleSystem>::Statistics& statistics = pool.GetStatistics();
+                test.Print("pool : acquired %zu, created %zu, reused %zu, destroyed %zu",
+                    statistics.acquired, statistics.created, statistics.reused, statistics.destroyed);
+                test.Check(statistics.created < statistics.acquired / 2, "the pool must reuse emitters");
+            }
+            return churn;
+        };
+    const Churn pooled = runChurn(true, true, true);
+    const Churn unpooled = runChurn(false, true, true);
+    const Churn scalar = runChurn(true, false, false);
+    test.Check(pooled.particles == unpooled.particles && pooled.particles == scalar.particles, "the pool and the update path must not change the simulation");
+
+    test.Print("%d emitters x %d frames (%.0f particles / frame), %zu spawns", EmitterCount, Frames,
+        static_cast<double>(pooled.particles) / Frames, pooled.spawns);
+    test.Print("spawn : pooled %.2f us, new buffers %.2f us", pooled.spawnMicroseconds / pooled.spawns, unpooled.spawnMicroseconds / unpooled.spawns);
+    test.Print("update / frame : SIMD %.1f us, scalar %.1f us", pooled.updateMicroseconds / Frames, scalar.updateMicroseconds / Frames);
+    test.Print("depth sort / frame : radix %.1f us, std::sort %.1f us", pooled.sortMicroseconds / Frames, scalar.sortMicroseconds / Frames);
+}
@@ -0,0 +1,143 @@
+#include "Graphics/Renderer/DebugDrawBuffer.h"
+
+#include <cfloat>
+#include <thread>
+
+#include "Engine/Framework/SelfTest.h"
+
+using namespace DirectX;
+
+// ̃XbhǉȂ Gather āAƒgA
+// \Z𒴂̂Ă邩A`̃bVmF
+SELF_TEST(DebugDrawBuffer)
+{
+    using Batch = DebugDrawBuffer::Batch;
+    using Shape = DebugDrawBuffer::Shape;
+    constexpr size_t ThreadCount = 4;
+    constexpr size_t ItemsPerThread = 20000;
+    constexpr size_t ShapeCount = DebugDrawBuffer::ShapeCount;
+
+    // (1) ̃XbhǉȂA`悷Xbhŉx Gather 
+    DebugDrawBuffer buffer;
+    buffer.budget.maxLineVertices = ThreadCount * ItemsPerThread * 2;
+    buffer.budget.maxPoints = ThreadCount * ItemsPerThread;
+    buffer.budget.maxShapes = ThreadCount * ItemsPerThread;
+    std::atomic<size_t> finished{ 0 };
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < ThreadCount; ++thread)
+    {
+        threads.emplace_back([&buffer, &finished, thread]()
+            {
+                // F x ɃXbhAy ɔԍāAoőSđĂ邩
+                for (size_t item = 0; item < ItemsPerThread; ++item)
+                {
+                    const XMFLOAT4 color = { static_cast<float>(thread), static_cast<float>(item), 0.0f, 1.0f };
+                    switch (item % 3)
+                    {
+                    case 0: buffer.AddLine({ 0, 0, 0 }, { 1, 1, 1 }, color); break;
+                    case 1: buffer.AddPoint({ 0, 0, 0 }, color); break;
+                    case 2: buffer.AddShape(static_cast<Shape>(item % ShapeCount), {}, color); break;
+                    }
+                }
+                ++finished;
+            });
+    }
+    std::vector<std::vector<bool>> seen(ThreadCount, std::vector<bool>(ItemsPerThread, false));
+    size_t gathered = 0;
+    size_t gatherCount = 0;
+    Batch batch;
+    auto collect = [&](const XMFLOAT4& color)
+        {
+            const size_t thread = static_cast<size_t>(color.x);
+            const size_t item = static_cast<size_t>(color.y);
+            if (test.Check(thread < ThreadCount && item < ItemsPerThread && !seen[thread][item], "gathered an unknown or duplicated item"))
+            {
+                seen[thread][item] = true;
+                ++gathered;
+            }
+        };
+    bool done = false;
+    while (!done)
+    {
+        // SẴXbhIɂ 1 o
+        done = finished.load() == ThreadCount;
+        buffer.Gather(batch);
+        ++gatherCount;
+        for (size_t index = 0; index < batch.lines.size(); index += 2)
+        {
+            collect(batch.lines[index].color);
+        }
+        for (const DebugDrawBuffer::Vertex& point : batch.points)
+        {
+            collect(point.color);
+        }
+        for (const std::vector<DebugDrawBuffer::ShapeInstance>& instances : batch.shapes)
+        {
+            for (const DebugDrawBuffer::ShapeInstance& instance : instances)
+            {
+                collect(instance.color);
+            }
+        }
+        test.Check(buffer.GetStatistics().dropped == 0, "items were dropped within the budget");
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    test.Check(gathered == ThreadCount * ItemsPerThread, "gathered item count differs from the added count");
+
+    // (2) \Z𒴂͎̂Ă
+    DebugDrawBuffer limited;
+    limited.budget.maxPoints = 10;
+    for (int point = 0; point < 15; ++point)
+    {
+        limited.AddPoint({ 0, 0, 0 }, { 1, 1, 1, 1 });
+    }
+    limited.Gather(batch);
+    test.Check(batch.points.size() == 10 && limited.GetStatistics().dropped == 5, "points over the budget are not dropped");
+    // ̃t[͂܂ǉł
+    limited.AddPoint({ 0, 0, 0 }, { 1, 1, 1, 1 });
+    limited.Gather(batch);
+    test.Check(batch.points.size() == 1, "budget is not reset on the next frame");
+
+    // (3) `̃bV : CfbNX͈͓AOp`OA傫 glb Ɠ
+    const XMFLOAT3 expectedMin[ShapeCount] = { { -1, -1, -1 }, { -1, 0, -1 }, { -1, -1, -1 }, { -1, 0, -1 }, { -0.5f, 0, -0.5f }, { -0.5f, -0.5f, -0.5f } };
+    const XMFLOAT3 expectedMax[ShapeCount] = { { 1, 1, 1 }, { 1, 1, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0.5f, 1, 0.5f }, { 0.5f, 0.5f, 0.5f } };
+    size_t triangleCount = 0;
+    for (size_t shape = 0; shape < ShapeCount; ++shape)
+    {
+        std::vector<XMFLOAT3> positions;
+        std::vector<uint16_t> indices;
+        DebugDrawBuffer::BuildShapeMesh(static_cast<Shape>(shape), positions, indices);
+        if (!test.Check(!indices.empty() && indices.size() % 3 == 0, "shape mesh is not a triangle list"))
+        {
+            continue;
+        }
+        XMVECTOR minimum = XMVectorReplicate(FLT_MAX);
+        XMVECTOR maximum = XMVectorReplicate(-FLT_MAX);
+        for (const XMFLOAT3& position : positions)
+        {
+            minimum = XMVectorMin(minimum, XMLoadFloat3(&position));
+            maximum = XMVectorMax(maximum, XMLoadFloat3(&position));
+        }
+        const XMVECTOR center = (minimum + maximum) * 0.5f;
+        test.Check(XMVector3NearEqual(minimum, XMLoadFloat3(&expectedMin[shape]), XMVectorReplicate(1e-4f)) &&
+            XMVector3NearEqual(maximum, XMLoadFloat3(&expectedMax[shape]), XMVectorReplicate(1e-4f)), "shape mesh bounds differ from the glb");
+        for (size_t index = 0; index < indices.size(); index += 3)
+        {
+            if (!test.Check(indices[index] < positions.size() && indices[index + 1] < positions.size() && indices[index + 2] < positions.size(), "shape index out of range"))
+            {
+                break;
+            }
+            const XMVECTOR a = XMLoadFloat3(&positions[indices[index]]);
+            const XMVECTOR b = XMLoadFloat3(&positions[indices[index + 1]]);
+            const XMVECTOR c = XMLoadFloat3(&positions[indices[index + 2]]);
+            const XMVECTOR normal = XMVector3Cross(b - a, c - a);
+            // `͑SēʂȂ̂ŁAOȂ (S  Op`) Ɠ
+            test.Check(XMVectorGetX(XMVector3Dot(normal, (a + b + c) / 3.0f - center)) > 0.0f, "shape triangle faces inward");
+        }
+        triangleCount += indices.size() / 3;
+    }
+
+    test.Print("%zu threads x %zu items, %zu gathers, %zu shape triangles", ThreadCount, ItemsPerThread, gatherCount, triangleCount);
+}
@@ -0,0 +1,122 @@
+#include "Components/Effect/EffectRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Engine/Framework/SelfTest.h"
+
+// R|[lg炸ɁAnh̐Av̏ԁA
+// o^ 10000 EĐ 16 ̎ɗvƍĐ̃Xg鎞 (SČĉ鎞Ƃ̔r) m߂
+SELF_TEST(EffectRegistry)
+{
+    using Handle = EffectRegistry::Handle;
+    using Request = EffectRegistry::Request;
+    using RequestType = EffectRegistry::RequestType;
+    constexpr Handle InvalidHandle = EffectRegistry::InvalidHandle;
+
+    // R|[lg̑̃AhX (Resolve ŕԂ邩ׂ邾ŁAg͐GȂ)
+    static char fakeComponents[10000];
+    auto fake = [](size_t i) { return reinterpret_cast<EffectComponent*>(&fakeComponents[i]); };
+
+    // nh : Xbgg񂵂ĂAÂnh nullptr ɂȂ
+    {
+        EffectRegistry registry(16);
+        const Handle a = registry.Register(fake(0));
+        const Handle b = registry.Register(fake(1));
+        const Handle c = registry.Register(fake(2));
+        test.Check(registry.Resolve(a) == fake(0) && registry.Resolve(b) == fake(1) && registry.Resolve(c) == fake(2), "registered handles must resolve");
+        registry.Unregister(b);
+        registry.Unregister(b);
+        const Handle d = registry.Register(fake(3));
+        test.Check((d & 0xFFFF) == (b & 0xFFFF) && d != b, "a freed slot must be reused with a new generation");
+        test.Check(registry.Resolve(b) == nullptr && registry.Resolve(d) == fake(3), "a stale handle must not resolve");
+        test.Check(registry.Resolve(InvalidHandle) == nullptr && registry.GetStatistics().registered == 3, "the registered count must follow Unregister");
+    }
+
+    // v : ς񂾏ɑSĎoAoIɂ܂ς߂
+    {
+        EffectRegistry registry(4);
+        for (Handle h = 1; h <= 10; ++h)
+        {
+            registry.Push(h, (h & 1) ? RequestType::Play : RequestType::Stop);
+        }
+        Request request;
+        Handle expected = 1;
+        bool inOrder = true;
+        while (registry.Pop(request))
+        {
+            inOrder &= request.handle == expected && request.type == ((expected & 1) ? RequestType::Play : RequestType::Stop);
+            ++expected;
+        }
+        test.Check(expected == 11 && inOrder, "every pushed request must be popped once and in order");
+        registry.Push(11, RequestType::Play);
+        test.Check(registry.Pop(request) && request.handle == 11 && !registry.Pop(request), "the queue must be reusable after it is drained");
+        const EffectRegistry::Statistics statistics = registry.GetStatistics();
+        test.Check(statistics.pushed == 11 && statistics.popped == 11, "the pushed and popped counts must match");
+    }
+
+    // o^ 10000 EĐ 16  : vƍĐ̃XgꍇƁASĂĉꍇ (ȑO EffectSystem::Update)
+    {
+        constexpr size_t Registered = 10000;
+        constexpr size_t Playing = 16;
+        constexpr int Frames = 200;
+        EffectRegistry registry(1024);
+        std::vector<Handle> handles;
+        std::vector<uint8_t> isPlaying(Registered, 0);
+        for (size_t i = 0; i < Registered; ++i)
+        {
+            handles.push_back(registry.Register(fake(i)));
+        }
+
+        size_t eventSpawned = 0;
+        std::vector<Handle> active;
+        auto begin = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < Frames; ++frame)
+        {
+            // t[AႤGtFNg 16 ĐđÕt[̕~߂
+            for (size_t k = 0; k < Playing; ++k)
+            {
+                const size_t i = (frame * Playing + k) * 613 % Registered;
+                registry.Push(handles[i], RequestType::Play);
+            }
+            Request request;
+            while (registry.Pop(request))
+            {
+                auto it = std::find(active.begin(), active.end(), request.handle);
+                if (request.type == RequestType::Play && it == active.end())
+                {
+                    active.push_back(request.handle);
+                }
+            }
+            for (Handle handle : active)
+            {
+                eventSpawned += registry.Resolve(handle) ? 1 : 0;
+            }
+            active.clear();     // 1 񂾂̃GtFNg (Initialized)
+        }
+        const double eventMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / Frames;
+
+        size_t scanSpawned = 0;
+        begin = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < Frames; ++frame)
+        {
+            for (size_t k = 0; k < Playing; ++k)
+            {
+                isPlaying[(frame * Playing + k) * 613 % Registered] = 1;
+            }
+            for (size_t i = 0; i < Registered; ++i)
+            {
+                // SẴR|[lgĉ镪 (vector ̊mۂȂǂ͊܂߂Ȃ)
+                EffectComponent* component = registry.Resolve(handles[i]);
+                if (isPlaying[i] && component)
+                {
+                    ++scanSpawned;
+                    isPlaying[i] = 0;
+                }
+            }
+        }
+        const double scanMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / Frames;
+        test.Check(eventSpawned == scanSpawned && eventSpawned == Frames * Playing, "the event queue must spawn the same effects as the scan");
+        test.Print("%zu registered, %zu playing / frame : queue %.2f us, scan %.2f us", Registered, Playing, eventMicroseconds, scanMicroseconds);
+    }
+}
@@ -0,0 +1,161 @@
+#include "Engine/Input/InputSystem.h"
+
+#include <Windows.h>
+
+#include <chrono>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Engine/Utility/Deterministic.h"
+
+class InputSystemTest
+{
+public:
+    // 1 t[ 10000 ₢킹āAOň (ȑÕL[𒲂ׂ@ƍ̕@) Ɣԍňׂ̂
+    // L^͂ĕʂ InputSystem ōĐ̂ŁAQ[̓́EL^EĐɂ͉eȂ
+    // ʂSĂ̕@œm߂
+    static void Run(SelfTest& test);
+};
+
+SELF_TEST(InputSystem)
+{
+    InputSystemTest::Run(test);
+}
+
+void InputSystemTest::Run(SelfTest& test)
+{
+    // Q[ InputSystem (L^EĐł) ͐G炸Aʂ InputSystem ɓL[蓖ĂĎg
+    InputSystem headless;
+    InputSystem* const previous = InputSystem::active;
+    InputSystem::active = &headless;
+    InputSystem::Initialize();
+
+    // ܂ŃL[{[hE}EXEQ[pbh藣肷͂
+    constexpr size_t frameCount = 600;
+    constexpr size_t queriesPerFrame = 10000;
+    const int keyboardKeys[] = { 'W', 'A', 'S', 'D', 'E', 'Q', VK_SHIFT, VK_RETURN, VK_SPACE, VK_F8, VK_LBUTTON, VK_RBUTTON };
+    const WORD gamepadButtons[] = { XINPUT_GAMEPAD_A, XINPUT_GAMEPAD_B, XINPUT_GAMEPAD_X };
+    std::vector<InputSnapshot> frames(frameCount);
+    Deterministic::Random random;
+    auto next = [&random]() { return random.Next() >> 16; };
+    for (size_t frame = 0; frame < frameCount; ++frame)
+    {
+        InputSnapshot& snapshot = frames[frame];
+        snapshot = frame > 0 ? frames[frame - 1] : InputSnapshot{};
+        snapshot.deltaTime = 1.0f / 60.0f;
+        for (int vkey : keyboardKeys)
+        {
+            if (next() % 8 == 0)
+            {
+                snapshot.keys[vkey >> 5] ^= 1u << (vkey & 31);
+            }
+        }
+        snapshot.gamepadConnected = frame % 200 < 100 ? 1 : 0;
+        for (WORD button : gamepadButtons)
+        {
+            if (next() % 8 == 0)
+            {
+                snapshot.gamepad.wButtons ^= button;
+            }
+        }
+        snapshot.gamepad.sThumbLY = static_cast<SHORT>(next() % 3 == 0 ? 30000 : 0);
+    }
+
+    // ₢킹 (ANV, , foCX) ̑gݍ킹
+    struct Query
+    {
+        std::string name;
+        InputActionId action;
+        InputStateMask state;
+        DeviceFlags flag;
+    };
+    std::vector<Query> queries;
+    queries.reserve(queriesPerFrame);
+    for (size_t i = 0; i < queriesPerFrame; ++i)
+    {
+        const InputActionId action = static_cast<InputActionId>(i % headless.actionNames.size());
+        queries.push_back({ headless.actionNames[action], action, static_cast<InputStateMask>(i % 3), static_cast<DeviceFlags>((i / 3) % 7) });
+    }
+
+    InputSystem::StartReplay(std::move(frames));
+    using Clock = std::chrono::high_resolution_clock;
+    double legacySeconds = 0.0, nameSeconds = 0.0, idSeconds = 0.0, updateSeconds = 0.0;
+    size_t legacyCount = 0, nameCount = 0, idCount = 0, mismatches = 0, eventMismatches = 0, eventCount = 0;
+    for (size_t frame = 0; frame < frameCount; ++frame)
+    {
+        Clock::time_point start = Clock::now();
+        InputSystem::Update(1.0f / 60.0f);
+        updateSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        // ȑO̖₢킹 : ÕnbVŒTāAL[ 1 ׂ
+        start = Clock::now();
+        for (const Query& query : queries)
+        {
+            legacyCount += InputSystem::QueryKeys(InputSystem::FindAction(query.name), query.state, query.flag) ? 1 : 0;
+        }
+        legacySeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const Query& query : queries)
+        {
+            nameCount += InputSystem::GetInputState(query.name, query.state, query.flag) ? 1 : 0;
+        }
+        nameSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (const Query& query : queries)
+        {
+            idCount += InputSystem::GetInputState(query.action, query.state, query.flag) ? 1 : 0;
+        }
+        idSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+        // SĂ̑gݍ킹ňȑǑʂƓ
+        size_t transitions = 0;
+        for (InputActionId action = 0; action < headless.actionNames.size(); ++action)
+        {
+            for (int state = 0; state < 3; ++state)
+            {
+                for (int flag = 0; flag < 7; ++flag)
+                {
+                    if (InputSystem::QueryKeys(action, static_cast<InputStateMask>(state), static_cast<DeviceFlags>(flag)) !=
+                        InputSystem::GetInputState(action, static_cast<InputStateMask>(state), static_cast<DeviceFlags>(flag)))
+                    {
+                        ++mismatches;
+                    }
+                }
+            }
+            for (int device = 0; device < 3; ++device)
+            {
+                transitions += ((headless.actionStates[action] >> (device * 3 + 1)) & 1u) + ((headless.actionStates[action] >> (device * 3 + 2)) & 1u);
+            }
+        }
+        // Đ͉ꂽEꂽ̂ƓL^
+        const uint64_t frameEvents = headless.eventEnd - headless.frameEventBegin;
+        eventCount += static_cast<size_t>(frameEvents);
+        if (frameEvents != transitions)
+        {
+            ++eventMismatches;
+        }
+        for (uint64_t sequence = headless.frameEventBegin; sequence < headless.eventEnd; ++sequence)
+        {
+            const InputEvent* event = InputSystem::FindEvent(sequence);
+            if (event && event->frame != headless.frameIndex)
+            {
+                ++eventMismatches;
+            }
+        }
+    }
+    const size_t actionCount = headless.actionNames.size();
+    InputSystem::active = previous;
+
+    test.Check(mismatches == 0, "packed states differ from the key scan");
+    test.Check(eventMismatches == 0, "recorded events differ from the state transitions");
+    test.Check(legacyCount == nameCount && nameCount == idCount, "query methods hit different counts");
+
+    const double queryCount = static_cast<double>(frameCount * queriesPerFrame);
+    test.Print("%zu frames x %zu queries, %zu actions, %zu events", frameCount, queriesPerFrame, actionCount, eventCount);
+    test.Print("legacy (hash + key scan) : %.3f ms/frame (%.1f ns/query)", legacySeconds * 1000.0 / frameCount, legacySeconds * 1.0e9 / queryCount);
+    test.Print("name (hash + packed)     : %.3f ms/frame (%.1f ns/query)", nameSeconds * 1000.0 / frameCount, nameSeconds * 1.0e9 / queryCount);
+    test.Print("id (packed)              : %.3f ms/frame (%.1f ns/query), x%.1f", idSeconds * 1000.0 / frameCount, idSeconds * 1.0e9 / queryCount,
+        idSeconds > 0.0 ? legacySeconds / idSeconds : 0.0);
+    test.Print("Update : %.3f ms/frame", updateSeconds * 1000.0 / frameCount);
+}
@@ -0,0 +1,144 @@
+#include "Engine/Debug/Logger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <queue>
+#include <vector>
+
+#include "Engine/Framework/SelfTest.h"
+
+using namespace std::chrono;
+
+class LoggerTest
+{
+public:
+	//8 Xbh珑̑v (ꎞtH_̃t@Cɏ)
+	//ȑO std::mutex  std::queue ̏Ƃׂ
+	static void Run(SelfTest& test);
+};
+
+SELF_TEST(Logger)
+{
+	LoggerTest::Run(test);
+}
+
+void LoggerTest::Run(SelfTest& test) {
+	using Level = Logger::Level;
+	using OverflowPolicy = Logger::OverflowPolicy;
+	constexpr int ProducerCount = 8;
+	constexpr int MessagesPerProducer = 50000;
+	constexpr uint64_t Total = static_cast<uint64_t>(ProducerCount) * MessagesPerProducer;
+
+	//炩ߍbZ[W (̎Ԃ͌vȂ)
+	std::vector<std::vector<std::string>> messages(ProducerCount);
+	for (int p = 0; p < ProducerCount; ++p) {
+		messages[p].reserve(MessagesPerProducer);
+		for (int i = 0; i < MessagesPerProducer; ++i) {
+			char buf[64];
+			sprintf_s(buf, "producer %d message %d", p, i);
+			messages[p].push_back(buf);
+		}
+	}
+
+	auto runProducers = [&messages](const auto& push) {
+		std::vector<std::thread> producers;
+		const auto begin = steady_clock::now();
+		for (int p = 0; p < ProducerCount; ++p) {
+			producers.emplace_back([&messages, &push, p]() {
+				for (const std::string& message : messages[p]) {
+					push(message.c_str());
+				}
+			});
+		}
+		for (std::thread& producer : producers) {
+			producer.join();
+		}
+		return duration<double>(steady_clock::now() - begin).count();
+	};
+
+	test.Print("%d producers x %d messages (%zu records x %zu bytes)", ProducerCount, MessagesPerProducer,
+		static_cast<size_t>(Logger::RecordCapacity), sizeof(Logger::Cell));
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "logger_benchmark.txt";
+
+	//ȑȌ : std::mutex  std::queue ɕς (ǂޑbNŎo)
+	{
+		std::mutex mutex;
+		std::queue<std::pair<time_t, std::string>> queue;
+		std::atomic<bool> isRunning = true;
+		uint64_t consumed = 0;
+		std::thread consumer([&]() {
+			for (;;) {
+				std::lock_guard lock(mutex);
+				while (!queue.empty()) {
+					queue.pop();
+					++consumed;
+				}
+				if (!isRunning && queue.empty()) {
+					break;
+				}
+			}
+		});
+		const double seconds = runProducers([&](const char* message) {
+			std::lock_guard lock(mutex);
+			queue.emplace(std::time(nullptr), message);
+		});
+		isRunning = false;
+		consumer.join();
+		test.Print("mutex queue      : %8.1f ms producers, %6.2f M msg/s", seconds * 1000.0, Total / seconds / 1.0e6);
+	}
+
+	//ӂꂽɎ̂ĂE㏑ꍇƁÂĂꂽ珑 (Ȃ) ꍇ
+	struct Case
+	{
+		const char* name;
+		OverflowPolicy policy;
+		bool retry;
+	};
+	for (const Case& benchmarkCase : { Case{ "drop newest", OverflowPolicy::DropNewest, false }, Case{ "overwrite oldest", OverflowPolicy::OverwriteOldest, false },
+		Case{ "lossless (retry)", OverflowPolicy::DropNewest, true } }) {
+		std::filesystem::remove(path);
+		Logger::Statistics statistics;
+		double seconds = 0.0;
+		double drainSeconds = 0.0;
+		{
+			Logger logger(Logger::RecordCapacity, benchmarkCase.policy);
+			logger.Open(path);
+			const bool retry = benchmarkCase.retry;
+			seconds = runProducers([&logger, retry](const char* message) {
+				while (!logger.Push(Level::Info, message, nullptr) && retry) {
+					std::this_thread::yield();
+				}
+			});
+			const auto begin = steady_clock::now();
+			logger.WaitDrained();
+			drainSeconds = seconds + duration<double>(steady_clock::now() - begin).count();
+			statistics = logger.CollectStatistics();
+		}
+
+		//̊mF :  + ̂Ă = S (ꍇ͏ = S)At@C̍s̐ = 
+		const uint64_t counted = benchmarkCase.retry ? statistics.written : statistics.written + statistics.dropped + statistics.overwritten;
+		test.Check(counted == Total, "written + dropped differs from the pushed count");
+		//Xbh̃O͏ɕł͂
+		std::ifstream input(path, std::ios::binary);
+		std::string line;
+		uint64_t lines = 0;
+		std::vector<int> last(ProducerCount, -1);
+		while (std::getline(input, line)) {
+			int producer = 0;
+			int index = 0;
+			const size_t position = line.find(" : producer ");
+			if (!test.Check(position != std::string::npos && sscanf_s(line.c_str() + position, " : producer %d message %d", &producer, &index) == 2 &&
+				producer >= 0 && producer < ProducerCount && index > last[producer], "lines of one thread are out of order")) {
+				break;
+			}
+			last[producer] = index;
+			++lines;
+		}
+		test.Check(lines == statistics.written, "file line count differs from the written count");
+		test.Print("%-16s : %8.1f ms producers, %6.2f M msg/s, %6.2f M msg/s drained", benchmarkCase.name, seconds * 1000.0, Total / seconds / 1.0e6,
+			statistics.written / drainSeconds / 1.0e6);
+		test.Print("  %s", statistics.ToString().c_str());
+	}
+	std::filesystem::remove(path);
+}
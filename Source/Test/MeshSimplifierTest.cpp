@@ -0,0 +1,183 @@
+#include "Graphics/Resource/MeshSimplifier.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "Engine/Framework/SelfTest.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // _Op`܂ł̋
+    float PointTriangleDistance(const XMFLOAT3& point, const XMFLOAT3& a, const XMFLOAT3& b, const XMFLOAT3& c)
+    {
+        const XMVECTOR p = XMLoadFloat3(&point);
+        const XMVECTOR va = XMLoadFloat3(&a);
+        const XMVECTOR vb = XMLoadFloat3(&b);
+        const XMVECTOR vc = XMLoadFloat3(&c);
+        const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(vb, va), XMVectorSubtract(vc, va));
+        const float lengthSq = XMVectorGetX(XMVector3LengthSq(normal));
+        if (lengthSq > 0.0f)
+        {// ʂ̓ɗȂʂ܂ł̋
+            const float distance = XMVectorGetX(XMVector3Dot(XMVectorSubtract(p, va), normal)) / std::sqrt(lengthSq);
+            const XMVECTOR projected = XMVectorSubtract(p, XMVectorScale(normal, distance / std::sqrt(lengthSq)));
+            const bool inside =
+                XMVectorGetX(XMVector3Dot(XMVector3Cross(XMVectorSubtract(vb, va), XMVectorSubtract(projected, va)), normal)) >= 0 &&
+                XMVectorGetX(XMVector3Dot(XMVector3Cross(XMVectorSubtract(vc, vb), XMVectorSubtract(projected, vb)), normal)) >= 0 &&
+                XMVectorGetX(XMVector3Dot(XMVector3Cross(XMVectorSubtract(va, vc), XMVectorSubtract(projected, vc)), normal)) >= 0;
+            if (inside)
+            {
+                return std::fabs(distance);
+            }
+        }
+        // OȂ 3 ӂ܂ł̋̍ŏ
+        auto segment = [&](XMVECTOR s0, XMVECTOR s1)
+            {
+                const XMVECTOR d = XMVectorSubtract(s1, s0);
+                const float dd = XMVectorGetX(XMVector3LengthSq(d));
+                const float t = dd > 0 ? (std::clamp)(XMVectorGetX(XMVector3Dot(XMVectorSubtract(p, s0), d)) / dd, 0.0f, 1.0f) : 0.0f;
+                return XMVectorGetX(XMVector3Length(XMVectorSubtract(p, XMVectorAdd(s0, XMVectorScale(d, t)))));
+            };
+        return (std::min)({ segment(va, vb), segment(vb, vc), segment(vc, va) });
+    }
+}
+
+// ʉ̋Ɖ̂iq炵āAiƂ̎Op`̐E덷ƕsȃCfbNX𒲂ׂ
+SELF_TEST(MeshSimplifier)
+{
+    using Lod = MeshSimplifier::Lod;
+    struct TestMesh
+    {
+        std::string name;
+        std::vector<XMFLOAT3> positions;
+        std::vector<uint32_t> indices;
+    };
+    std::vector<TestMesh> meshes;
+
+    {// ʉ̋ (ox 0  360 xŒ_𕪂 UV ̌pڂ)
+        TestMesh& mesh = meshes.emplace_back();
+        mesh.name = "bumpy sphere";
+        constexpr int Rings = 48;
+        constexpr int Segments = 96;
+        for (int ring = 0; ring <= Rings; ++ring)
+        {
+            const float theta = XM_PI * ring / Rings;
+            for (int segment = 0; segment <= Segments; ++segment)
+            {
+                const float phi = XM_2PI * (segment % Segments) / Segments;
+                const float radius = 1.0f + 0.05f * std::sin(5.0f * theta) * std::sin(7.0f * phi);
+                mesh.positions.push_back({ radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi) });
+            }
+        }
+        for (int ring = 0; ring < Rings; ++ring)
+        {
+            for (int segment = 0; segment < Segments; ++segment)
+            {
+                const uint32_t i0 = ring * (Segments + 1) + segment;
+                const uint32_t i1 = i0 + Segments + 1;
+                if (ring > 0)
+                {
+                    mesh.indices.insert(mesh.indices.end(), { i0, i0 + 1, i1 });
+                }
+                if (ring < Rings - 1)
+                {
+                    mesh.indices.insert(mesh.indices.end(), { i0 + 1, i1 + 1, i1 });
+                }
+            }
+        }
+    }
+    {// ̂N̂iq
+        TestMesh& mesh = meshes.emplace_back();
+        mesh.name = "open terrain";
+        constexpr int Size = 80;
+        for (int z = 0; z <= Size; ++z)
+        {
+            for (int x = 0; x <= Size; ++x)
+            {
+                const float u = static_cast<float>(x) / Size;
+                const float v = static_cast<float>(z) / Size;
+                mesh.positions.push_back({ u * 10.0f, 0.3f * std::sin(u * 6.0f) * std::cos(v * 4.0f), v * 10.0f });
+            }
+        }
+        for (int z = 0; z < Size; ++z)
+        {
+            for (int x = 0; x < Size; ++x)
+            {
+                const uint32_t i0 = z * (Size + 1) + x;
+                const uint32_t i1 = i0 + Size + 1;
+                mesh.indices.insert(mesh.indices.end(), { i0, i1, i0 + 1, i0 + 1, i1, i1 + 1 });
+            }
+        }
+    }
+
+    MeshSimplifier::Options options;
+    MeshSimplifier::Report report;
+    std::vector<std::string> details;
+    for (TestMesh& mesh : meshes)
+    {
+        MeshSimplifier::Report::Entry& entry = report.entries.emplace_back();
+        entry.name = mesh.name;
+        entry.vertexCount = mesh.positions.size();
+        std::vector<uint32_t> indices = mesh.indices;
+        const auto start = std::chrono::high_resolution_clock::now();
+        entry.lods = MeshSimplifier::GenerateLods(indices, mesh.positions.size(), [&](uint32_t index) { return mesh.positions[index]; }, options, &entry.extent);
+        report.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        // iāAOp`A덷Ă
+        test.Check(entry.lods.size() >= 3, "too few LODs");
+        for (size_t level = 0; level < entry.lods.size(); ++level)
+        {
+            const Lod& lod = entry.lods[level];
+            test.Check(lod.indexCount % 3 == 0 && lod.firstIndex + lod.indexCount <= indices.size(), "LOD index range is out of the buffer");
+            if (level > 0)
+            {
+                test.Check(lod.indexCount < entry.lods[level - 1].indexCount && lod.error >= entry.lods[level - 1].error, "LOD does not reduce triangles or grow the error");
+                test.Check(lod.firstIndex == entry.lods[level - 1].firstIndex + entry.lods[level - 1].indexCount, "LOD ranges are not contiguous");
+            }
+            // _͋L܂܁AׂꂽOp`͏oȂ
+            float measured = 0.0f;
+            for (uint32_t i = lod.firstIndex; i + 2 < lod.firstIndex + lod.indexCount; i += 3)
+            {
+                test.Check(indices[i] < mesh.positions.size() && indices[i + 1] < mesh.positions.size() && indices[i + 2] < mesh.positions.size(), "LOD index out of range");
+                test.Check(indices[i] != indices[i + 1] && indices[i + 1] != indices[i + 2] && indices[i + 2] != indices[i], "degenerate LOD triangle");
+            }
+            // ̒_i̖ʂ܂ł̋̍ő (덷̖ڈƔׂ)
+            if (level > 0)
+            {
+                for (size_t v = 0; v < mesh.positions.size(); v += 23)
+                {
+                    float nearest = FLT_MAX;
+                    for (uint32_t i = lod.firstIndex; i + 2 < lod.firstIndex + lod.indexCount; i += 3)
+                    {
+                        nearest = (std::min)(nearest, PointTriangleDistance(mesh.positions[v], mesh.positions[indices[i]], mesh.positions[indices[i + 1]], mesh.positions[indices[i + 2]]));
+                    }
+                    measured = (std::max)(measured, nearest);
+                }
+                char buf[128];
+                sprintf_s(buf, "%s LOD%zu : measured max distance %.5f", mesh.name.c_str(), level, measured);
+                details.push_back(buf);
+                test.Check(measured <= options.maxError * entry.extent * 2.0f, "LOD is farther from the mesh than its error");
+            }
+        }
+    }
+
+    // 臒l̋߂ŒisȂ
+    const float errors[] = { 0.0f, 0.01f, 0.04f, 0.1f };
+    const float threshold = 1.0f;
+    const float pixelsPerUnit = 0.9f / errors[1];  // 1 iڂ 0.9 sNZ
+    test.Check(MeshSimplifier::SelectLod(errors, 4, pixelsPerUnit, threshold, 0.25f, 0) == 0, "switched to a coarser LOD too early");
+    test.Check(MeshSimplifier::SelectLod(errors, 4, pixelsPerUnit, threshold, 0.25f, 1) == 1, "switched back inside the hysteresis");
+    test.Check(MeshSimplifier::SelectLod(errors, 4, 0.7f / errors[1], threshold, 0.25f, 0) == 1, "did not switch to a coarser LOD");
+    test.Check(MeshSimplifier::SelectLod(errors, 4, 1.1f / errors[1], threshold, 0.25f, 1) == 0, "did not switch to a finer LOD at once");
+    test.Check(MeshSimplifier::SelectLod(errors, 4, 0.0f, threshold, 0.25f, 0) == 3, "did not pick the coarsest LOD");
+
+    test.Append(report.ToString());
+    for (const std::string& detail : details)
+    {
+        test.Print("%s", detail.c_str());
+    }
+}
@@ -0,0 +1,263 @@
+#include "Graphics/Renderer/MeshletCulling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Engine/Utility/Deterministic.h"
+
+using namespace DirectX;
+
+// N̂nʂƔׂXe[WɕāA܂J̌oHőIʂ
+// 1 ̔ƌʂׁA\ĎɓOp`IʂĂȂ𒲂ׂāA炵Op`̊o
+SELF_TEST(MeshletCulling)
+{
+    using Statistics = MeshletCulling::Statistics;
+    using Range = MeshletCulling::Range;
+    // Xe[W : N̂nʁǍA 1 ̃ob`bVɂ܂Ƃ߂
+    std::vector<XMFLOAT3> positions;
+    std::vector<uint32_t> indices;
+    {
+        constexpr int Size = 192;
+        constexpr float Extent = 200.0f;
+        for (int z = 0; z <= Size; ++z)
+        {
+            for (int x = 0; x <= Size; ++x)
+            {
+                const float px = (static_cast<float>(x) / Size - 0.5f) * Extent;
+                const float pz = (static_cast<float>(z) / Size - 0.5f) * Extent;
+                positions.push_back({ px, 4.0f * std::sin(px * 0.05f) * std::cos(pz * 0.07f), pz });
+            }
+        }
+        for (int z = 0; z < Size; ++z)
+        {
+            for (int x = 0; x < Size; ++x)
+            {
+                const uint32_t i0 = z * (Size + 1) + x;
+                const uint32_t i1 = i0 + Size + 1;
+                indices.insert(indices.end(), { i0, i1, i0 + 1, i0 + 1, i1, i1 + 1 });
+            }
+        }
+    }
+    // 񓯂zuɂȂ悤ɎO̗g
+    Deterministic::Random random;
+    for (int box = 0; box < 400; ++box)
+    {
+        const XMFLOAT3 center = { (random.NextFloat() - 0.5f) * 180.0f, 3.0f + random.NextFloat() * 4.0f, (random.NextFloat() - 0.5f) * 180.0f };
+        const XMFLOAT3 size = { 1.0f + random.NextFloat() * 3.0f, 2.0f + random.NextFloat() * 4.0f, 1.0f + random.NextFloat() * 3.0f };
+        // ʂƂ (@, u, v)  u x v = @ ɂāAO猩Ĕvɂ
+        const XMFLOAT3 faces[6][3] =
+        {
+            { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }, { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+            { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } }, { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+            { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } }, { { 0, 0, -1 }, { 0, 1, 0 }, { 1, 0, 0 } },
+        };
+        for (const auto& face : faces)
+        {
+            const uint32_t base = static_cast<uint32_t>(positions.size());
+            const float corners[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+            for (const auto& corner : corners)
+            {
+                positions.push_back({
+                    center.x + size.x * (face[0].x + corner[0] * face[1].x + corner[1] * face[2].x),
+                    center.y + size.y * (face[0].y + corner[0] * face[1].y + corner[1] * face[2].y),
+                    center.z + size.z * (face[0].z + corner[0] * face[1].z + corner[1] * face[2].z) });
+            }
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+    }
+    {
+        constexpr int Rings = 64;
+        constexpr int Segments = 128;
+        const uint32_t base = static_cast<uint32_t>(positions.size());
+        for (int ring = 0; ring <= Rings; ++ring)
+        {
+            const float theta = XM_PI * ring / Rings;
+            for (int segment = 0; segment <= Segments; ++segment)
+            {
+                const float phi = XM_2PI * segment / Segments;
+                positions.push_back({ 20.0f * std::sin(theta) * std::cos(phi), 30.0f + 20.0f * std::cos(theta), 20.0f * std::sin(theta) * std::sin(phi) });
+            }
+        }
+        for (int ring = 0; ring < Rings; ++ring)
+        {
+            for (int segment = 0; segment < Segments; ++segment)
+            {
+                const uint32_t i0 = base + ring * (Segments + 1) + segment;
+                const uint32_t i1 = i0 + Segments + 1;
+                if (ring > 0)
+                {
+                    indices.insert(indices.end(), { i0, i0 + 1, i1 });
+                }
+                if (ring < Rings - 1)
+                {
+                    indices.insert(indices.end(), { i0 + 1, i1 + 1, i1 });
+                }
+            }
+        }
+    }
+
+    MeshletBuilder::Options options;
+    options.minTriangles = 0;
+    MeshletBuilder::Report report;
+    MeshletBuilder::Report::Entry& entry = report.entries.emplace_back();
+    entry.name = "stage";
+    entry.triangleCount = indices.size() / 3;
+    const std::vector<uint32_t> original = indices;
+    const auto buildStart = std::chrono::high_resolution_clock::now();
+    entry.meshlets = MeshletBuilder::Build(indices, 0, static_cast<uint32_t>(indices.size()), positions.size(),
+        [&](uint32_t index) { return positions[index]; }, options, true, &entry.vertexTotal);
+    report.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+    const std::vector<MeshletBuilder::Meshlet>& meshlets = entry.meshlets;
+
+    // ͈̔͂ԂȂсA傫̏AבւĂOp`̏W܂ɂȂĂ
+    test.Check(!meshlets.empty(), "no meshlets were built");
+    std::vector<uint32_t> triangleMeshlet(indices.size() / 3, 0);
+    uint32_t expectedFirst = 0;
+    for (size_t m = 0; m < meshlets.size(); ++m)
+    {
+        const MeshletBuilder::Meshlet& meshlet = meshlets[m];
+        test.Check(meshlet.firstIndex == expectedFirst && meshlet.indexCount % 3 == 0 && meshlet.indexCount / 3 <= MeshletBuilder::MaxTriangles, "meshlet range is not contiguous or too large");
+        expectedFirst = meshlet.firstIndex + meshlet.indexCount;
+        std::vector<uint32_t> vertices(indices.begin() + meshlet.firstIndex, indices.begin() + meshlet.firstIndex + meshlet.indexCount);
+        std::sort(vertices.begin(), vertices.end());
+        test.Check(std::unique(vertices.begin(), vertices.end()) - vertices.begin() <= static_cast<ptrdiff_t>(MeshletBuilder::MaxVertices), "meshlet has too many vertices");
+        for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i)
+        {
+            triangleMeshlet[i / 3] = static_cast<uint32_t>(m);
+            // _͋̒ɓ
+            const XMFLOAT3& p = positions[indices[i]];
+            const float dx = p.x - meshlet.center.x, dy = p.y - meshlet.center.y, dz = p.z - meshlet.center.z;
+            test.Check(std::sqrt(dx * dx + dy * dy + dz * dz) <= meshlet.radius * 1.0001f + 1e-5f, "vertex is outside the meshlet sphere");
+        }
+    }
+    test.Check(expectedFirst == indices.size(), "meshlets do not cover every index");
+    {
+        auto sortedTriangles = [](const std::vector<uint32_t>& source)
+            {
+                std::vector<uint64_t> keys;
+                for (size_t i = 0; i + 2 < source.size(); i += 3)
+                {
+                    keys.push_back(static_cast<uint64_t>(source[i]) << 42 ^ static_cast<uint64_t>(source[i + 1]) << 21 ^ source[i + 2]);
+                }
+                std::sort(keys.begin(), keys.end());
+                return keys;
+            };
+        test.Check(sortedTriangles(original) == sortedTriangles(indices), "reordering changed the triangles");
+    }
+
+    MeshletBuilder::Clusters clusters;
+    clusters.Assign(meshlets);
+
+    // ܂J̌oH (Xe[WE낷EnʂꂷE̒)
+    struct CameraPoint
+    {
+        const char* name;
+        XMFLOAT3 eye;
+        XMFLOAT3 focus;
+    };
+    const CameraPoint path[] =
+    {
+        { "orbit 0", { 90.0f, 20.0f, 0.0f }, { 0.0f, 10.0f, 0.0f } },
+        { "orbit 90", { 0.0f, 20.0f, 90.0f }, { 0.0f, 10.0f, 0.0f } },
+        { "orbit 180", { -90.0f, 20.0f, 0.0f }, { 0.0f, 10.0f, 0.0f } },
+        { "orbit 270", { 0.0f, 20.0f, -90.0f }, { 0.0f, 10.0f, 0.0f } },
+        { "street", { -60.0f, 6.0f, -60.0f }, { 0.0f, 4.0f, 0.0f } },
+        { "top down", { 0.0f, 150.0f, 0.1f }, { 0.0f, 0.0f, 0.0f } },
+        { "below", { 0.0f, -30.0f, 0.0f }, { 40.0f, -5.0f, 40.0f } },
+        { "skyward", { 30.0f, 8.0f, 30.0f }, { 60.0f, 60.0f, 60.0f } },
+    };
+    // f̍s (]EړEg嗦)
+    const XMMATRIX world = XMMatrixScaling(1.5f, 1.5f, 1.5f) * XMMatrixRotationY(0.3f) * XMMatrixTranslation(5.0f, 0.0f, -3.0f);
+    const XMMATRIX projection = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    constexpr size_t MaxRanges = 32;
+
+    test.Append(report.ToString());
+    Statistics total;
+    size_t mismatches = 0;
+    size_t missed = 0;
+    size_t uncovered = 0;
+    for (const CameraPoint& point : path)
+    {
+        XMFLOAT3 eye = { point.eye.x * 1.5f, point.eye.y * 1.5f, point.eye.z * 1.5f };
+        const XMMATRIX view = XMMatrixLookAtLH(XMLoadFloat3(&eye), XMVectorScale(XMLoadFloat3(&point.focus), 1.5f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        XMFLOAT4X4 modelViewProjection;
+        XMStoreFloat4x4(&modelViewProjection, world * view * projection);
+
+        Statistics statistics;
+        std::vector<uint32_t> visible;
+        std::vector<Range> ranges;
+        MeshletCulling::CullMeshlets(clusters, modelViewProjection, true, visible, &statistics);
+        MeshletCulling::BuildRanges(clusters, visible, MaxRanges, ranges, &statistics);
+        total.Add(statistics);
+
+        // 1 ̔Ɣׂ
+        const VisibilityCulling::Frustum frustum = VisibilityCulling::ExtractFrustum(modelViewProjection, false);
+        XMFLOAT3 camera;
+        const bool hasCamera = MeshletCulling::ExtractCameraPosition(modelViewProjection, camera);
+        std::vector<uint32_t> expected;
+        std::vector<uint8_t> isVisible(meshlets.size(), 0);
+        for (size_t m = 0; m < meshlets.size(); ++m)
+        {
+            if (MeshletCulling::TestMeshlet(frustum, hasCamera ? &camera : nullptr, meshlets[m]) == MeshletCulling::Result::Visible)
+            {
+                expected.push_back(static_cast<uint32_t>(m));
+            }
+        }
+        for (uint32_t m : visible)
+        {
+            isVisible[m] = 1;
+        }
+        const size_t mismatch = visible == expected ? 0 : (std::max)(visible.size(), expected.size());
+        mismatches += mismatch;
+
+        // \Ē_ɓOp`́AKɓĂ
+        size_t cameraMissed = 0;
+        for (size_t t = 0; t < indices.size() / 3; ++t)
+        {
+            const XMVECTOR p0 = XMLoadFloat3(&positions[indices[t * 3 + 0]]);
+            const XMVECTOR p1 = XMLoadFloat3(&positions[indices[t * 3 + 1]]);
+            const XMVECTOR p2 = XMLoadFloat3(&positions[indices[t * 3 + 2]]);
+            const XMVECTOR normal = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+            if (XMVectorGetX(XMVector3Dot(normal, XMVectorSubtract(XMLoadFloat3(&camera), p0))) <= 0.0f)
+            {
+                continue;
+            }
+            bool inside = false;
+            for (XMVECTOR p : { p0, p1, p2 })
+            {
+                bool pointInside = true;
+                for (int i = 0; i < frustum.planeCount; ++i)
+                {
+                    pointInside = pointInside && XMVectorGetX(XMPlaneDotCoord(XMLoadFloat4(&frustum.planes[i]), p)) >= 0.0f;
+                }
+                inside = inside || pointInside;
+            }
+            if (inside && !isVisible[triangleMeshlet[t]])
+            {
+                ++cameraMissed;
+            }
+        }
+        missed += cameraMissed;
+
+        // ͈͂܂Ƃ߂Ă͑Sĕ`
+        for (uint32_t m : visible)
+        {
+            const bool covered = std::any_of(ranges.begin(), ranges.end(), [&](const Range& range)
+                {
+                    return range.firstIndex <= meshlets[m].firstIndex && meshlets[m].firstIndex + meshlets[m].indexCount <= range.firstIndex + range.indexCount;
+                });
+            uncovered += covered ? 0 : 1;
+        }
+        test.Check(ranges.size() <= MaxRanges, "too many draw ranges");
+
+        test.Print("%-10s : %s%s%s", point.name, statistics.ToString().c_str(), mismatch ? " (MISMATCH)" : "", cameraMissed ? " (MISSED)" : "");
+    }
+    test.Check(mismatches == 0, "batched culling differs from the per-meshlet test");
+    test.Check(missed == 0, "culled a front-facing triangle inside the frustum");
+    test.Check(uncovered == 0, "draw ranges skip a visible meshlet");
+    test.Print("average culled %.1f%% of tris (frustum %zu, cone %zu meshlets), %.3f ms per camera",
+        100.0f * total.CulledRatio(), total.frustumCulled, total.coneCulled, total.milliseconds / std::size(path));
+}
@@ -0,0 +1,294 @@
+#include "Widgets/ObjectManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Widgets/GameObject.h"
+
+using namespace DirectX;
+
+namespace
+{
+	//vp D3D gȂR|[lgiMask / Image ̑j
+	class HeadlessGauge : public UIComponent
+	{
+	public:
+		float value = 0.0f;
+	};
+	class HeadlessLabel : public UIComponent
+	{
+	};
+}
+
+class ObjectManagerTest
+{
+public:
+	//widgetCount  UI ̂ changeRatio ̊𖈃t[A
+	//܂ł̍XVit[\[gEstd::function ̍ċAESẴCAEgvZjƔׂ
+	static void RunHierarchy(SelfTest& test);
+	//MainScene  HUDiQ[WEtF[hj𖈃t[OŒTď鏈A
+	//܂ł̐`TEdynamic_cast ƁA\EnhE^Ƃ̃LbVŔׂ
+	static void RunLookup(SelfTest& test);
+};
+
+SELF_TEST(ObjectManagerHierarchy)
+{
+	ObjectManagerTest::RunHierarchy(test);
+}
+
+SELF_TEST(ObjectManagerLookup)
+{
+	ObjectManagerTest::RunLookup(test);
+}
+
+void ObjectManagerTest::RunHierarchy(SelfTest& test)
+{
+	constexpr size_t widgetCount = 2000;
+	constexpr size_t frameCount = 600;
+	constexpr float changeRatio = 0.01f;
+	const size_t rootCount = (std::max)(size_t(1), widgetCount / 250);
+
+	//` UI  2 iaF܂ł̍XVAbF̃NX̍XVj
+	ObjectManager a, b;
+	std::vector<GameObject*> widgetsA, widgetsB;
+	{
+		std::mt19937 random(1234);
+		for (size_t i = 0; i < widgetCount; ++i) {
+			const XMFLOAT2 position{ static_cast<float>(random() % 1920), static_cast<float>(random() % 1080) };
+			const int priority = static_cast<int>(random() % 10);
+			const size_t parent = i < rootCount ? ObjectManager::InvalidIndex : random() % i;
+			for (int k = 0; k < 2; ++k) {
+				ObjectManager& manager = k == 0 ? a : b;
+				std::vector<GameObject*>& widgets = k == 0 ? widgetsA : widgetsB;
+				std::shared_ptr<GameObject> object = std::make_shared<GameObject>();
+				object->Create("HeadlessWidget");
+				manager.Register(object);
+				if (parent != ObjectManager::InvalidIndex) {
+					object->SetParent(widgets[parent]);
+				}
+				else {
+					object->priority = priority;
+				}
+				object->rect->anchoredPosition = position;
+				object->rect->size = { 64.0f, 32.0f };
+				object->rect->angle = i % 7 == 0 ? 10.0f : 0.0f;
+				widgets.push_back(object.get());
+			}
+		}
+	}
+
+	//܂ł ObjectManager::Update Ɠit[\[g std::function ōċAj
+	auto legacyUpdate = [](ObjectManager& manager, float elapsedTime) {
+		std::sort(manager.objects.begin(), manager.objects.end(),
+			[](const std::shared_ptr<GameObject>& a, const std::shared_ptr<GameObject>& b) {
+				return a->priority < b->priority;
+			});
+		std::function<void(float, GameObject*)> Update = [&](float elapsedTime, GameObject* object)
+			{
+				object->Update(elapsedTime);
+				for (auto child : object->children) {
+					Update(elapsedTime, child);
+				}
+			};
+		for (auto& object : manager.objects) {
+			if (!object || object->parent) continue;
+			Update(elapsedTime, object.get());
+		}
+		};
+
+	using Clock = std::chrono::high_resolution_clock;
+	double legacySeconds = 0.0;
+	double retainedSeconds = 0.0;
+	size_t legacyLayouts = 0;
+	size_t retainedLayouts = 0;
+	const size_t changeCount = (std::max)(size_t(1), static_cast<size_t>(widgetCount * changeRatio));
+	const bool layoutCache = RectTransform::enableLayoutCache;
+	std::mt19937 random(5678);
+	for (size_t frame = 0; frame < frameCount; ++frame) {
+		//changeRatio ̊𓮂BX[g̗Dxς
+		for (size_t i = 0; i < changeCount; ++i) {
+			const size_t index = random() % widgetCount;
+			widgetsA[index]->rect->anchoredPosition.x += 1.0f;
+			widgetsB[index]->rect->anchoredPosition.x += 1.0f;
+		}
+		if (frame % 60 == 59) {
+			const size_t index = random() % rootCount;
+			const int priority = static_cast<int>(random() % 10);
+			widgetsA[index]->priority = priority;
+			widgetsB[index]->priority = priority;
+		}
+
+		RectTransform::enableLayoutCache = false;
+		size_t count = RectTransform::layoutRecomputeCount;
+		Clock::time_point start = Clock::now();
+		legacyUpdate(a, 1.0f / 60.0f);
+		legacySeconds += std::chrono::duration<double>(Clock::now() - start).count();
+		legacyLayouts += RectTransform::layoutRecomputeCount - count;
+
+		RectTransform::enableLayoutCache = true;
+		count = RectTransform::layoutRecomputeCount;
+		start = Clock::now();
+		b.Update(1.0f / 60.0f);
+		retainedSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+		retainedLayouts += RectTransform::layoutRecomputeCount - count;
+	}
+	RectTransform::enableLayoutCache = layoutCache;
+
+	//ʂ̈ʒu
+	for (size_t i = 0; i < widgetCount; ++i) {
+		const XMFLOAT2 a0 = widgetsA[i]->rect->TopLeft(), a1 = widgetsA[i]->rect->BottomRight();
+		const XMFLOAT2 b0 = widgetsB[i]->rect->TopLeft(), b1 = widgetsB[i]->rect->BottomRight();
+		test.Check(a0.x == b0.x && a0.y == b0.y && a1.x == b1.x && a1.y == b1.y, "retained layout differs from the legacy update");
+	}
+	//S 1 񂸂A[g͗Dx
+	test.Check(b.nodes.size() == widgetCount && std::is_sorted(b.roots.begin(), b.roots.end(), ObjectManager::ComparePriority), "update list is not complete or roots are not in priority order");
+	const ObjectManager::Statistics statistics = b.statistics;
+
+	//^񒆂qƏFւʒu
+	{
+		std::vector<GameObject*> stack{ widgetsB[widgetCount / 2] };
+		size_t erased = 0;
+		while (!stack.empty()) {
+			GameObject* object = stack.back();
+			stack.pop_back();
+			b.erases.push_back(b.objects[object->managerIndex]);
+			stack.insert(stack.end(), object->children.begin(), object->children.end());
+			++erased;
+		}
+		b.Update(1.0f / 60.0f);
+		test.Check(b.objects.size() == widgetCount - erased && b.nodes.size() == b.objects.size(), "erased subtree is still listed");
+		for (size_t i = 0; i < b.objects.size(); ++i) {
+			test.Check(b.objects[i]->managerIndex == i && b.objects[i]->manager == &b, "manager index is stale after erase");
+		}
+	}
+
+	test.Print("%zu widgets (%zu roots) x %zu frames, %zu changed / frame", widgetCount, rootCount, frameCount, changeCount);
+	test.Print("every frame : %.3f ms / frame, %.1f layouts / frame",
+		legacySeconds * 1000.0 / frameCount, static_cast<double>(legacyLayouts) / frameCount);
+	test.Print("retained    : %.3f ms / frame, %.1f layouts / frame, %zu rebuilds, %zu resorts",
+		retainedSeconds * 1000.0 / frameCount, static_cast<double>(retainedLayouts) / frameCount, statistics.rebuilds, statistics.resorts);
+}
+
+void ObjectManagerTest::RunLookup(SelfTest& test)
+{
+	constexpr size_t widgetCount = 400;
+	constexpr size_t frameCount = 6000;
+
+	//MainScene  HUD t[TOiGameUIFactory Ɠj
+	const char* hudNames[] = { "HPGuage", "LeftGauge", "RightGauge", "BossHP", "BossEnergy", "Fade" };
+	const size_t hudCount = _countof(hudNames);
+
+	//HUD ȊO UI ̊Ԃ HUD U΂点
+	ObjectManager manager;
+	std::mt19937 random(4321);
+	std::vector<size_t> hudPositions;
+	for (size_t i = 0; i < hudCount; ++i) {
+		hudPositions.push_back(widgetCount * (i + 1) / (hudCount + 1));
+	}
+	for (size_t i = 0, hud = 0; i < widgetCount; ++i) {
+		std::shared_ptr<GameObject> object = std::make_shared<GameObject>();
+		object->Create("HeadlessLookup");
+		manager.Register(object);
+		if (hud < hudCount && hudPositions[hud] == i) {
+			manager.Rename(object.get(), hudNames[hud++]);
+		}
+		else {
+			manager.Rename(object.get(), "HeadlessWidget" + std::to_string(i));
+		}
+		object->AddComponent<HeadlessLabel>();
+		object->AddComponent<HeadlessGauge>();
+	}
+
+	//܂ł Find  GetComponentiO̐`T dynamic_castj
+	auto legacyFind = [&manager](const std::string& name) -> GameObject* {
+		for (auto& object : manager.objects) {
+			if (object->name == name) {
+				return object.get();
+			}
+		}
+		return nullptr;
+		};
+	auto legacyGetGauge = [](GameObject* object) -> HeadlessGauge* {
+		for (auto& component : object->_components) {
+			if (HeadlessGauge* p = dynamic_cast<HeadlessGauge*>(component.get())) {
+				return p;
+			}
+		}
+		return nullptr;
+		};
+
+	std::vector<std::string> names(std::begin(hudNames), std::end(hudNames));
+	std::vector<GameObjectHandle> handles(hudCount);
+	for (size_t i = 0; i < hudCount; ++i) {
+		handles[i] = manager.FindGameObject(names[i])->GetHandle();
+	}
+
+	using Clock = std::chrono::high_resolution_clock;
+	double legacySeconds = 0.0, indexedSeconds = 0.0, handleSeconds = 0.0;
+	float legacySum = 0.0f, indexedSum = 0.0f, handleSum = 0.0f;
+	for (size_t frame = 0; frame < frameCount; ++frame) {
+		const float value = static_cast<float>(frame % 100) / 100.0f;
+
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < hudCount; ++i) {
+			HeadlessGauge* gauge = legacyGetGauge(legacyFind(names[i]));
+			gauge->value = value;
+			legacySum += gauge->value;
+		}
+		legacySeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+		start = Clock::now();
+		for (size_t i = 0; i < hudCount; ++i) {
+			HeadlessGauge* gauge = manager.FindGameObject(names[i])->GetComponent<HeadlessGauge>();
+			gauge->value = value;
+			indexedSum += gauge->value;
+		}
+		indexedSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+		start = Clock::now();
+		for (size_t i = 0; i < hudCount; ++i) {
+			HeadlessGauge* gauge = manager.FindGameObject(handles[i])->GetComponent<HeadlessGauge>();
+			gauge->value = value;
+			handleSum += gauge->value;
+		}
+		handleSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	test.Check(legacySum == indexedSum && legacySum == handleSum, "lookups wrote different gauges");
+
+	//id ̕\EO̕ύX
+	GameObject* fade = manager.FindGameObject(std::string("Fade"));
+	test.Check(manager.idIndex.find(fade->id) != manager.idIndex.end() && manager.idIndex[fade->id] == fade, "id index does not point at the object");
+	manager.Rename(fade, "FadeRenamed");
+	test.Check(!manager.FindGameObject(std::string("Fade")) && manager.FindGameObject(std::string("FadeRenamed")) == fade, "rename did not update the name index");
+
+	//R|[lgLbV
+	GameObject* bossHp = manager.FindGameObject(std::string("BossHP"));
+	bossHp->RemoveComponent<HeadlessGauge>();
+	bossHp->Update(0.0f);
+	test.Check(!bossHp->GetComponent<HeadlessGauge>() && bossHp->GetComponent<HeadlessLabel>(), "component cache kept a removed component");
+
+	//nh͖AOō蒼ʂ̃nh
+	const GameObjectHandle oldHandle = bossHp->GetHandle();
+	const int oldId = bossHp->id;
+	manager.erases.push_back(manager.objects[bossHp->managerIndex]);
+	manager.Update(0.0f);
+	test.Check(!manager.FindGameObject(oldHandle) && !manager.FindGameObject(std::string("BossHP")) && !manager.idIndex.count(oldId), "erased object is still found");
+	{
+		std::shared_ptr<GameObject> object = std::make_shared<GameObject>();
+		object->Create("HeadlessLookup");
+		manager.Register(object);
+		manager.Rename(object.get(), "BossHP");
+		test.Check(object->GetHandle() != oldHandle && !manager.FindGameObject(oldHandle) &&
+			manager.FindGameObject(object->GetHandle()) == object.get() && manager.FindGameObject(std::string("BossHP")) == object.get(),
+			"recreated object reuses the old handle");
+	}
+
+	const double lookups = static_cast<double>(frameCount * hudCount);
+	test.Print("MainScene HUD (%zu lookups / frame) among %zu widgets x %zu frames", hudCount, widgetCount, frameCount);
+	test.Print("linear find + dynamic_cast : %.1f ns / lookup", legacySeconds * 1e9 / lookups);
+	test.Print("name index + cached slot   : %.1f ns / lookup", indexedSeconds * 1e9 / lookups);
+	test.Print("handle + cached slot       : %.1f ns / lookup", handleSeconds * 1e9 / lookups);
+}
@@ -0,0 +1,192 @@
+#include "Engine/Debug/Profiler.h"
+
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include "Engine/Framework/SelfTest.h"
+
+// ̃Xbhœq̋ԂL^āA񐔁EqEWvEom߂
+SELF_TEST(Profiler)
+{
+    using ZoneId = Profiler::ZoneId;
+    using ScopedZone = Profiler::ScopedZone;
+    constexpr int WorkerCount = 4;
+    constexpr int FrameCount = 120;
+    constexpr int InnerCount = 3;
+    constexpr uint64_t InnerNanoseconds = 20000;
+    constexpr uint64_t FrameNanoseconds = 50000;
+
+    auto spin = [](uint64_t nanoseconds)
+        {
+            const uint64_t start = Profiler::Now();
+            while (Profiler::Now() - start < nanoseconds)
+            {
+            }
+        };
+
+    const bool wasEnabled = Profiler::IsEnabled();
+    Profiler::SetEnabled(true);
+    // L^ς݂̏Wv͏
+    Profiler::Reset();
+
+    static const ZoneId outerZone = Profiler::RegisterZone("Headless::Outer", "test", __FILE__, __LINE__);
+    static const ZoneId innerZone = Profiler::RegisterZone("Headless::Inner", "test", __FILE__, __LINE__);
+    static const ZoneId frameZone = Profiler::RegisterZone("Headless::Frame", "test", __FILE__, __LINE__);
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < WorkerCount; ++w)
+    {
+        workers.emplace_back([w, &spin]()
+            {
+                char name[32];
+                std::snprintf(name, sizeof(name), "Headless Worker %d", w);
+                Profiler::SetThreadName(name);
+                for (int frame = 0; frame < FrameCount; ++frame)
+                {
+                    const ScopedZone outer(outerZone);
+                    for (int i = 0; i < InnerCount; ++i)
+                    {
+                        const ScopedZone inner(innerZone);
+                        spin(InnerNanoseconds);
+                    }
+                }
+            });
+    }
+    for (int frame = 0; frame < FrameCount; ++frame)
+    {
+        {
+            const ScopedZone zone(frameZone);
+            spin(FrameNanoseconds);
+        }
+        PROFILE_COUNTER("Headless::Counter", frame);
+        Profiler::NewFrame();
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+    Profiler::Collect();
+
+    // Ԃ̉񐔂̌vɎĝŁAI[o[wbh͍Ōɑ
+    const Profiler::Summary summary = Profiler::Summarize();
+    auto find = [&summary](const char* name) -> const Profiler::ZoneSummary*
+        {
+            for (const Profiler::ZoneSummary& zone : summary.zones)
+            {
+                if (zone.name == name)
+                {
+                    return &zone;
+                }
+            }
+            return nullptr;
+        };
+    const Profiler::ZoneSummary* outer = find("Headless::Outer");
+    const Profiler::ZoneSummary* inner = find("Headless::Inner");
+    const Profiler::ZoneSummary* frame = find("Headless::Frame");
+    test.Check(outer && outer->totalCount == WorkerCount * FrameCount, "outer count");
+    test.Check(inner && inner->totalCount == WorkerCount * FrameCount * InnerCount, "inner count");
+    test.Check(frame && frame->totalCount == FrameCount, "frame zone count");
+    test.Check(summary.frames == FrameCount - 1, "frame marker count");
+    test.Check(summary.droppedEvents == 0, "dropped events");
+    for (const Profiler::ZoneSummary& zone : summary.zones)
+    {
+        test.Check(zone.p50 <= zone.p95 && zone.p95 <= zone.p99 && zone.p99 <= zone.max && zone.mean <= zone.max, "percentile order");
+    }
+    test.Check(!inner || inner->p50 >= InnerNanoseconds / 1.0e6, "inner duration");
+    test.Check(!outer || !inner || outer->p50 >= inner->p50 * InnerCount, "outer duration");
+
+    // q : Ԃ͏Iɏ̂ŁA̋Ԃ̎ɗŐԂ܂ł͂
+    size_t nested = 0;
+    size_t zoneEvents = 0;
+    const std::vector<Profiler::TraceEvent> events = Profiler::GetTrace();
+    {
+        std::unordered_map<uint32_t, std::vector<const Profiler::Event*>> pending;
+        for (const Profiler::TraceEvent& trace : events)
+        {
+            const Profiler::Event& event = trace.event;
+            zoneEvents += event.type == Profiler::EventType::Zone ? 1 : 0;
+            if (event.type != Profiler::EventType::Zone)
+            {
+                continue;
+            }
+            if (event.zone == innerZone)
+            {
+                pending[trace.threadId].push_back(&event);
+            }
+            else if (event.zone == outerZone)
+            {
+                std::vector<const Profiler::Event*>& children = pending[trace.threadId];
+                for (const Profiler::Event* child : children)
+                {
+                    if (!test.Check(child->start >= event.start && child->end <= event.end && child->depth == event.depth + 1, "nesting"))
+                    {
+                        break;
+                    }
+                    ++nested;
+                }
+                children.clear();
+            }
+        }
+    }
+    test.Check(nested == static_cast<size_t>(WorkerCount * FrameCount * InnerCount), "nested count");
+
+    // o : ʂ̑ΉƋԂ̐
+    std::ostringstream trace;
+    Profiler::ExportChromeTrace(trace);
+    const std::string json = trace.str();
+    {
+        int braces = 0;
+        bool inString = false;
+        size_t completeEvents = 0;
+        for (size_t i = 0; i < json.size(); ++i)
+        {
+            const char c = json[i];
+            if (inString)
+            {
+                i += c == '\\' ? 1 : 0;
+                inString = c != '"';
+                continue;
+            }
+            inString = c == '"';
+            braces += c == '{' ? 1 : c == '}' ? -1 : 0;
+            if (braces < 0)
+            {
+                break;
+            }
+        }
+        for (size_t position = json.find("\"ph\":\"X\""); position != std::string::npos; position = json.find("\"ph\":\"X\"", position + 1))
+        {
+            ++completeEvents;
+        }
+        test.Check(braces == 0 && !inString, "json braces");
+        test.Check(completeEvents == zoneEvents, "json events");
+    }
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "profiler_headless_trace.json";
+    test.Check(Profiler::ExportChromeTrace(path), "file export");
+
+    const std::string report = Profiler::Report();
+
+    // 1 Ԃ̃I[o[wbh (ӂȂ悤ɋ؂ďW߂)
+    constexpr int OverheadBatch = 8192;
+    constexpr int OverheadBatches = 16;
+    uint64_t overhead = 0;
+    for (int batch = 0; batch < OverheadBatches; ++batch)
+    {
+        const uint64_t start = Profiler::Now();
+        for (int i = 0; i < OverheadBatch; ++i)
+        {
+            const ScopedZone zone(innerZone);
+        }
+        overhead += Profiler::Now() - start;
+        Profiler::Collect();
+    }
+    Profiler::Reset();
+    Profiler::SetEnabled(wasEnabled);
+
+    test.Print("%d threads x %d frames, %zu zone events, %zu nested, %zu bytes json", WorkerCount + 1, FrameCount, zoneEvents, nested, json.size());
+    test.Print("overhead %.1f ns/zone", static_cast<double>(overhead) / (OverheadBatch * OverheadBatches));
+    test.Print("trace : %s", path.string().c_str());
+    test.Append(report);
+}
@@ -0,0 +1,95 @@
+#include "Graphics/Renderer/RenderQueue.h"
+
+#include <algorithm>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Engine/Utility/Deterministic.h"
+
+// KȃACeבւāAԂƃXe[g̐؂ւ̉񐔁A
+// CX^X`̂܂Ƃߕ (܂Ƃ߂͈͂S CanInstance ) mF
+class RenderQueueTest
+{
+public:
+    static void Run(SelfTest& test);
+};
+
+SELF_TEST(RenderQueue)
+{
+    RenderQueueTest::Run(test);
+}
+
+void RenderQueueTest::Run(SelfTest& test)
+{
+    using Pass = RenderQueue::Pass;
+    using DrawItem = RenderQueue::DrawItem;
+    constexpr size_t ItemCount = 10000;
+
+    // 񓯂ACeɂȂ悤ɎO̗g
+    Deterministic::Random random;
+
+    // KȃV[ : 64 ̃fAfƂ 8 }eAE16 _obt@ApCvC 6 
+    // Ԃ̃f̓XLbVAԂ̓}eAƂ 1 ̒_obt@ob`bV (CX^X`ł)
+    RenderQueue queue;
+    queue.BeginFrame();
+    const char* pipelines[] = { "opaqueStatic", "opaqueSkinned", "maskStatic", "maskSkinned", "blendStatic", "shadow" };
+    for (size_t itemIndex = 0; itemIndex < ItemCount; ++itemIndex)
+    {
+        DrawItem item;
+        item.pass = static_cast<Pass>(random.NextRange(static_cast<uint32_t>(RenderQueue::PassCount)));
+        item.drawable = static_cast<uint32_t>(itemIndex);
+        const uint32_t model = random.NextRange(64);
+        item.model = queue.InternModel(reinterpret_cast<const void*>(static_cast<uintptr_t>(model + 1)));
+        item.pipeline = queue.InternPipeline(pipelines[item.pass == Pass::Shadow ? 5 : static_cast<uint32_t>(item.pass) * 2 + (model & 1)]);
+        item.material = static_cast<int32_t>(random.NextRange(8));
+        item.vertexBuffer = (model & 1) ? static_cast<int32_t>(random.NextRange(16)) : item.material;
+        item.indexBuffer = item.vertexBuffer + 16;
+        item.skin = (model & 1) ? static_cast<int32_t>(itemIndex / 4) : -1;
+        item.primitive = (model & 1) ? 0 : item.material;
+        item.instanceGroup = (model & 1) ? -1 : 0;
+        queue.AddItem(item, static_cast<float>(random.NextRange(10000)) * 0.01f);
+    }
+    queue.Sort();
+
+    // L[̏EpX̐ESẴACe 1 񂸂`邩mF
+    bool isKeyOrdered = true;
+    for (size_t entry = 1; entry < queue.entries.size(); ++entry)
+    {
+        isKeyOrdered = isKeyOrdered && queue.entries[entry - 1].key <= queue.entries[entry].key;
+    }
+    test.Check(isKeyOrdered, "sort keys are not in ascending order");
+    RenderQueue::RecordingBackend sorted;
+    for (size_t pass = 0; pass < RenderQueue::PassCount; ++pass)
+    {
+        const size_t before = sorted.items.size();
+        queue.Submit(static_cast<Pass>(pass), sorted);
+        test.Check(sorted.items.size() - before == queue.ItemCount(static_cast<Pass>(pass)), "submitted item count differs from the pass count");
+    }
+    // ܂Ƃ߂͈͂͑SĐ擪ƓXe[głȂ΂ȂȂ
+    std::vector<uint32_t> orderToItem(queue.items.size());
+    for (uint32_t itemIndex = 0; itemIndex < static_cast<uint32_t>(queue.items.size()); ++itemIndex)
+    {
+        orderToItem[queue.items[itemIndex].order] = itemIndex;
+    }
+    for (const std::pair<size_t, size_t>& group : sorted.groups)
+    {
+        const DrawItem& first = queue.items[orderToItem[sorted.items[group.first]]];
+        for (size_t index = 1; index < group.second; ++index)
+        {
+            test.Check(RenderQueue::CanInstance(first, queue.items[orderToItem[sorted.items[group.first + index]]]), "instanced group mixes states");
+        }
+    }
+    // ꂾΓXe[g̃ob`bVK
+    test.Check(sorted.counters.instancedDraws > 0, "no instanced draws");
+
+    std::vector<uint32_t> drawn = sorted.items;
+    std::sort(drawn.begin(), drawn.end());
+    bool isEachDrawnOnce = drawn.size() == ItemCount;
+    for (size_t itemIndex = 0; isEachDrawnOnce && itemIndex < drawn.size(); ++itemIndex)
+    {
+        isEachDrawnOnce = drawn[itemIndex] == itemIndex;
+    }
+    test.Check(isEachDrawnOnce, "items are not drawn exactly once");
+
+    test.Print("%zu items", ItemCount);
+    test.Append(queue.Measure().ToString());
+}
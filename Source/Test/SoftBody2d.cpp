@@ -65,7 +65,7 @@ void Engine::Update(float deltaTime)
         p.velocity.y = vn.y + vt.y;
     }
 
-    if (InputSystem::GetInputState("MouseLeft"))
+    if (InputSystem::GetInputState(INPUT_ACTION("MouseLeft")))
     {
         DirectX::XMFLOAT2 cursor = InputSystem::GetMousePosition();
         for (auto& point : points)
@@ -85,7 +85,7 @@ void Engine::Update(float deltaTime)
             }
         }
     }
-    if (InputSystem::GetInputState("MouseLeft", InputStateMask::Release))
+    if (InputSystem::GetInputState(INPUT_ACTION("MouseLeft"), InputStateMask::Release))
     {// }EX𗣂u
         DirectX::XMFLOAT2 cursor = InputSystem::GetMousePosition();
         for (auto& point : points)
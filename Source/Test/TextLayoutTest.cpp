@@ -0,0 +1,147 @@
+#include "Widgets/TextLayout.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "Engine/Framework/SelfTest.h"
+
+using namespace DirectX;
+
+//ς葱郉xi^C}[EJE^[j𖈃t[גꍇƁALbVꍇ̔r
+SELF_TEST(TextLayout)
+{
+	using Font = TextLayout::Font;
+	using Glyph = TextLayout::Glyph;
+	using Settings = TextLayout::Settings;
+	using Placement = TextLayout::Placement;
+	using Quad = TextLayout::Quad;
+	using Vertex = TextLayout::Vertex;
+	constexpr size_t labelCount = 500;
+	constexpr size_t frameCount = 600;
+
+	//ASCII ̉̃tHgi512x256 ̃AgXj
+	Font font;
+	font.size = 32.0f;
+	font.lineHeight = 36;
+	font.textureWidth = 512.0f;
+	font.textureHeight = 256.0f;
+	for (wchar_t character = 33; character < 127; ++character) {
+		Glyph& c = font.glyphs[character];
+		c.x = (character % 16) * 32;
+		c.y = (character / 16) * 32;
+		c.width = 20 + character % 5;
+		c.height = 30;
+		c.xoffset = character % 3;
+		c.yoffset = 2;
+		c.xadvance = 22 + character % 4;
+	}
+
+	//ו̊mF
+	{
+		std::vector<Quad> checkQuads;
+		std::vector<XMFLOAT2> pens;
+		Settings settings;
+		settings.fontSize = 32.0f;
+		//񂹁FsŎ̍sAXy[X͕`Ȃ
+		test.Check(TextLayout::Layout(font, L"ab c\nde", settings, checkQuads, &pens) == 2 && checkQuads.size() == 5 &&
+			checkQuads[3].y == 36.0f + 2.0f && pens[4].x == pens[0].x + 0.0f + (font.glyphs[L'a'].xadvance + font.glyphs[L'b'].xadvance + 31.0f + font.glyphs[L'c'].xadvance),
+			"left aligned layout");
+		//E񂹁FŌ̕_AsƂɉ
+		settings.alignRight = true;
+		test.Check(TextLayout::Layout(font, L"12\n345", settings, checkQuads, &pens) == 2 && checkQuads.size() == 5 &&
+			checkQuads[0].x == static_cast<float>(font.glyphs[L'2'].xoffset) && checkQuads[2].y == 36.0f + 2.0f,
+			"right aligned layout");
+		//܂ԂF 3 
+		settings.alignRight = false;
+		settings.overflow = TextLayout::HorizontalOverflow::Wrap;
+		settings.wrapWidth = 80.0f;
+		test.Check(TextLayout::Layout(font, L"abcdefgh", settings, checkQuads) == 3, "wrapped layout");
+	}
+
+	//xF1/5 ̓^C}[it[ςjA2/5 ̓JE^[i30 t[ƂɕςjAc͌Œ
+	struct Label
+	{
+		Settings settings;
+		Placement placement;
+		TextLayout cached;
+		std::vector<Quad> quads;
+		std::vector<Vertex> vertices;
+	};
+	std::vector<Label> labels(labelCount);
+	for (size_t i = 0; i < labelCount; ++i) {
+		Label& label = labels[i];
+		label.settings.fontSize = 32.0f + static_cast<float>(i % 3) * 16.0f;
+		label.settings.alignRight = (i % 5) >= 1 && (i % 5) <= 2;
+		label.placement.anchor = { static_cast<float>(i % 20) * 96.0f, static_cast<float>(i / 20) * 40.0f };
+		label.placement.center = { label.placement.anchor.x + 48.0f, label.placement.anchor.y + 20.0f };
+		label.placement.angle = i % 10 == 0 ? 15.0f : 0.0f;
+		label.placement.viewportWidth = 1920.0f;
+		label.placement.viewportHeight = 1080.0f;
+	}
+	auto labelText = [](size_t i, size_t frame) {
+		wchar_t buffer[64];
+		if (i % 5 == 0) {
+			const size_t centiseconds = frame * 100 / 60;
+			swprintf_s(buffer, L"%02zu %02zu.%02zu", centiseconds / 6000, centiseconds / 100 % 60, centiseconds % 100);
+		}
+		else if (i % 5 <= 2) {
+			swprintf_s(buffer, L"%zu/50", (i + frame / 30) % 50);
+		}
+		else {
+			swprintf_s(buffer, L"LABEL %zu", i);
+		}
+		return std::wstring(buffer);
+		};
+
+	using Clock = std::chrono::high_resolution_clock;
+	double uncachedSeconds = 0.0;
+	double cachedSeconds = 0.0;
+	size_t uncachedBytes = 0;
+	size_t cachedBytes = 0;
+	size_t quadCount = 0;
+	std::vector<std::wstring> texts(labelCount);
+	for (size_t frame = 0; frame < frameCount; ++frame) {
+		for (size_t i = 0; i < labelCount; ++i) {
+			texts[i] = labelText(i, frame);
+		}
+		//t[SĕגĒ_i܂ł Text::Draw Ɠj
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < labelCount; ++i) {
+			Label& label = labels[i];
+			TextLayout::Layout(font, texts[i], label.settings, label.quads);
+			TextLayout::BuildVertices(label.quads, label.placement, label.vertices);
+			uncachedBytes += label.vertices.size() * sizeof(Vertex);
+		}
+		uncachedSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+		//ς̂ג
+		start = Clock::now();
+		for (size_t i = 0; i < labelCount; ++i) {
+			Label& label = labels[i];
+			label.cached.UpdateLayout(font, texts[i], label.settings);
+			if (label.cached.UpdateVertices(label.placement)) {
+				cachedBytes += label.cached.GetVertices().size() * sizeof(Vertex);
+			}
+		}
+		cachedSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	//Ō̃t[̒_
+	size_t layouts = 0;
+	for (Label& label : labels) {
+		const std::vector<Vertex>& cachedVertices = label.cached.GetVertices();
+		test.Check(cachedVertices.size() == label.vertices.size() &&
+			std::memcmp(cachedVertices.data(), label.vertices.data(), cachedVertices.size() * sizeof(Vertex)) == 0,
+			"cached vertices differ from the uncached ones");
+		layouts += label.cached.GetStatistics().layouts;
+		quadCount += label.quads.size();
+	}
+
+	test.Print("%zu labels x %zu frames (%zu quads / frame)", labelCount, frameCount, quadCount);
+	test.Print("every frame : %.3f ms / frame, %.1f KB / frame uploaded",
+		uncachedSeconds * 1000.0 / frameCount, uncachedBytes / 1024.0 / frameCount);
+	test.Print("cached      : %.3f ms / frame, %.1f KB / frame uploaded, %zu layouts (%.1f%%)",
+		cachedSeconds * 1000.0 / frameCount, cachedBytes / 1024.0 / frameCount, layouts, 100.0 * layouts / (labelCount * frameCount));
+	test.Print("draw calls  : %zu -> 1 (one atlas, batched per canvas)", labelCount);
+}
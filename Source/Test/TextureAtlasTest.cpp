@@ -0,0 +1,78 @@
+#include "Graphics/Sprite/TextureAtlas.h"
+
+#include <chrono>
+#include <random>
+
+#include "Engine/Framework/SelfTest.h"
+
+// _ȑ傫̒`l߂āAdȂȂE͂ݏoȂ𒲂ׂ
+SELF_TEST(TextureAtlasPacker)
+{
+    using Region = TextureAtlas::Region;
+    constexpr size_t rectCount = 2000;
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<UINT> small(4, 96);
+    std::uniform_int_distribution<UINT> large(96, 512);
+    std::bernoulli_distribution isLarge(0.1);
+
+    TextureAtlas atlas;
+    std::vector<Region> placed;
+    placed.reserve(rectCount);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < rectCount; ++i)
+    {
+        auto& size = isLarge(random) ? large : small;
+        const UINT width = size(random);
+        const UINT height = size(random);
+        Region region;
+        if (atlas.Place(std::to_wstring(i), width, height, DXGI_FORMAT_R8G8B8A8_UNORM, region))
+        {
+            placed.push_back(region);
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    test.Check(placed.size() == rectCount, "some rects were not placed");
+    // key ͓ꏊԂ
+    Region again;
+    test.Check(!placed.empty() && atlas.Place(L"0", 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, again) && again.x == placed[0].x && again.y == placed[0].y,
+        "the same key was placed twice");
+    //傫摜EktH[}bg͍ڂȂ
+    test.Check(!atlas.Place(L"large", TextureAtlas::MaxImageSize + 1, 16, DXGI_FORMAT_R8G8B8A8_UNORM, again), "placed an image over MaxImageSize");
+    test.Check(!atlas.Place(L"bc", 64, 64, DXGI_FORMAT_BC3_UNORM, again), "placed a compressed image");
+
+    //܂߂ăy[W͂ݏoAdȂȂ
+    const int border = TextureAtlas::Padding / 2;
+    size_t overlaps = 0;
+    size_t outOfBounds = 0;
+    for (size_t i = 0; i < placed.size(); ++i)
+    {
+        const Region& a = placed[i];
+        if (static_cast<int>(a.x) - border < 0 || static_cast<int>(a.y) - border < 0 ||
+            a.x + a.width + border > TextureAtlas::PageSize || a.y + a.height + border > TextureAtlas::PageSize)
+        {
+            ++outOfBounds;
+        }
+        for (size_t j = i + 1; j < placed.size(); ++j)
+        {
+            const Region& b = placed[j];
+            if (a.page != b.page)
+            {
+                continue;
+            }
+            const bool separate =
+                a.x + a.width + border <= b.x - border || b.x + b.width + border <= a.x - border ||
+                a.y + a.height + border <= b.y - border || b.y + b.height + border <= a.y - border;
+            if (!separate)
+            {
+                ++overlaps;
+            }
+        }
+    }
+    test.Check(overlaps == 0, "placed rects overlap");
+    test.Check(outOfBounds == 0, "placed rects go out of the page");
+
+    test.Print("%zu rects in %.3f ms, %s", placed.size(), std::chrono::duration<double, std::milli>(end - start).count(), atlas.GetStatistics().ToString().c_str());
+}
@@ -0,0 +1,140 @@
+#include "Widgets/UIBatch.h"
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Graphics/Sprite/TextureAtlas.h"
+
+namespace
+{
+	//wbhX̌vŕ` 1  GraphiciGameUIFactory / ResultUIFactory ō鏇j
+	struct HeadlessGraphic
+	{
+		int canvas;
+		const wchar_t* source;	//nullptr ̓_~[ij
+		bool masked;
+		bool text;
+	};
+
+	//PNG ̃wb_[傫ǂށiǂ߂Ȃ 64x64j
+	void ReadPngSize(const wchar_t* path, UINT& width, UINT& height)
+	{
+		width = height = 64;
+		FILE* file = nullptr;
+		if (_wfopen_s(&file, path, L"rb") != 0 || !file) {
+			return;
+		}
+		unsigned char header[24]{};
+		if (fread(header, 1, sizeof(header), file) == sizeof(header) && std::memcmp(header + 12, "IHDR", 4) == 0) {
+			width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+			height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+		}
+		fclose(file);
+	}
+}
+
+//GameUIFactory / ResultUIFactory Ɠт UI ` Draw ̐A
+//ob`ȂEeNX`Ƃ̃ob`EAgX + CPU ł̃}XN 3 ʂŐ
+SELF_TEST(UIBatchAtlas)
+{
+	static const HeadlessGraphic gameLayout[]
+	{
+		//PlayerCanvas
+		{ 0, L"./Data/Textures/UI/player_energy_frame.png", true, false },
+		{ 0, L"./Data/Textures/UI/player_energy.png", true, false },
+		{ 0, L"./Data/Textures/UI/player_energy_frame.png", true, false },
+		{ 0, L"./Data/Textures/UI/player_energy.png", true, false },
+		{ 0, L"./Data/Textures/UI/player_hp_frame.png", true, false },
+		{ 0, L"./Data/Textures/UI/player_hp.png", true, false },
+		{ 0, L"./Data/Textures/UI/icon_chara.png", false, false },
+		//BossCanvas
+		{ 1, L"./Data/Textures/UI/icon_boss.png", false, false },
+		{ 1, L"./Data/Textures/UI/boss_hp_frame.png", true, false },
+		{ 1, L"./Data/Textures/UI/boss_hp.png", true, false },
+		{ 1, L"./Data/Textures/UI/boss_energy.png", true, false },
+		//TimerCanvas
+		{ 2, L"./Data/Textures/UI/timer_frame.png", false, false },
+		{ 2, nullptr, false, true },
+		//WarningCanvas
+		{ 3, L"./Data/Textures/UI/WARNING.png", false, false },
+		//BossIndicatorCanvas
+		{ 4, L"./Data/Textures/UI/BossIndicator/bos_icon.png", false, false },
+		{ 4, L"./Data/Textures/UI/BossIndicator/bos_icon_fream.png", false, false },
+		//FadeCanvas
+		{ 5, nullptr, false, false },
+	};
+	static const HeadlessGraphic resultLayout[]
+	{
+		//ResultCanvas
+		{ 0, L"./Data/Textures/UI/Result/result.png", false, false },
+		{ 0, nullptr, false, true },
+		{ 0, nullptr, false, true },
+		{ 0, nullptr, false, true },
+		{ 0, L"./Data/Textures/UI/Result/rank_S.png", false, false },
+		{ 0, L"./Data/Textures/UI/Result/back_to_title.png", false, false },
+		{ 0, L"./Data/Textures/UI/Result/retry.png", false, false },
+		//ResultFadeCanvas
+		{ 1, nullptr, false, false },
+	};
+
+	auto measure = [&](const char* name, const HeadlessGraphic* layout, size_t count) {
+		TextureAtlas atlas;
+		std::unordered_map<std::wstring, uintptr_t> textureIds;
+		//邾Ȃ̂ŁAVF[_[\[X͋ʂłlł΂悢
+		auto textureId = [&](const std::wstring& key) {
+			auto it = textureIds.emplace(key, textureIds.size() + 1).first;
+			return reinterpret_cast<ID3D11ShaderResourceView*>(it->second);
+		};
+
+		size_t draws[3]{};
+		for (int mode = 1; mode < 3; ++mode) {
+			const bool useAtlas = mode == 2;
+			UIBatch batch(nullptr);
+			int canvas = layout[0].canvas;
+			for (size_t i = 0; i < count; ++i) {
+				const HeadlessGraphic& graphic = layout[i];
+				if (graphic.canvas != canvas) {
+					//LoXς鏊ŕ`
+					batch.Flush(nullptr);
+					canvas = graphic.canvas;
+				}
+				const std::wstring key = graphic.text ? L"<font>" : graphic.source ? graphic.source : L"<dummy:FFFFFFFF>";
+				UIBatch::State state{ textureId(key) };
+				if (useAtlas && !graphic.text) {
+					UINT width = 16, height = 16;
+					if (graphic.source) {
+						ReadPngSize(graphic.source, width, height);
+					}
+					TextureAtlas::Region region;
+					if (atlas.Place(key, width, height, DXGI_FORMAT_R8G8B8A8_UNORM, region)) {
+						state.shaderResourceView = textureId(L"<page:" + std::to_wstring(region.page) + L">");
+					}
+				}
+				//VU[Ő؂鎞 Mask Oŕ`iAgX̎ Image  CPU Ő؂j
+				const bool scissor = graphic.masked && !useAtlas;
+				if (scissor) {
+					batch.Flush(nullptr);
+				}
+				//eLXg 2 
+				const UIBatch::Vertex quads[6 * 2]{};
+				batch.Add(state, quads, graphic.text ? 6 * 2 : 6);
+				if (scissor) {
+					batch.Flush(nullptr);
+				}
+			}
+			batch.Flush(nullptr);
+			batch.NewFrame();
+			draws[mode] = batch.GetStatistics().draws;
+		}
+		//ob`Ȃ Graphic Ƃ 1 
+		draws[0] = count;
+
+		test.Check(draws[2] <= draws[1] && draws[1] <= draws[0], "batching increased the draw count");
+		test.Print("%s draws per frame: graphics:%zu unbatched:%zu batched:%zu atlas+cpuClip:%zu (%s)",
+			name, count, draws[0], draws[1], draws[2], atlas.GetStatistics().ToString().c_str());
+	};
+	measure("GameUI", gameLayout, _countof(gameLayout));
+	measure("ResultUI", resultLayout, _countof(resultLayout));
+}
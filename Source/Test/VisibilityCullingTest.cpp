@@ -0,0 +1,92 @@
+#include "Graphics/Renderer/VisibilityCulling.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "Engine/Framework/SelfTest.h"
+#include "Engine/Utility/Deterministic.h"
+
+using namespace DirectX;
+
+namespace
+{
+    // JƁAJXP[h 1 ĩCg (e𗎂Ƃ) ̎
+    std::vector<VisibilityCulling::View> MakeViews()
+    {
+        std::vector<VisibilityCulling::View> views(2);
+        const XMMATRIX cameraView = XMMatrixLookAtLH(XMVectorSet(0.0f, 5.0f, -20.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX cameraProjection = XMMatrixPerspectiveFovLH(XMConvertToRadians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+        views[0].name = "camera";
+        XMStoreFloat4x4(&views[0].viewProjection, cameraView * cameraProjection);
+
+        const XMMATRIX lightView = XMMatrixLookAtLH(XMVectorSet(-30.0f, 40.0f, -30.0f, 1.0f), XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+        const XMMATRIX lightProjection = XMMatrixOrthographicLH(40.0f, 40.0f, 1.0f, 120.0f);
+        views[1].name = "cascade0";
+        views[1].isShadowCaster = true;
+        XMStoreFloat4x4(&views[1].viewProjection, lightView * lightProjection);
+        return views;
+    }
+}
+
+// J̎̎ɔׂđIʂARecordingBackend ɋL^` 1 ̔̌ʂׂ
+SELF_TEST(VisibilityCulling)
+{
+    constexpr size_t ObjectCount = 10000;
+    const std::vector<VisibilityCulling::View> views = MakeViews();
+
+    // ŏ̃r[̎͂ޔ͈͂ 1.5 {ɔׂ
+    XMVECTOR regionMin = XMVectorReplicate(FLT_MAX);
+    XMVECTOR regionMax = XMVectorReplicate(-FLT_MAX);
+    const XMMATRIX inverseViewProjection = XMMatrixInverse(nullptr, XMLoadFloat4x4(&views[0].viewProjection));
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        const XMVECTOR ndc = XMVectorSet(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : 0.0f, 1.0f);
+        const XMVECTOR world = XMVector3TransformCoord(ndc, inverseViewProjection);
+        regionMin = XMVectorMin(regionMin, world);
+        regionMax = XMVectorMax(regionMax, world);
+    }
+    XMFLOAT3 center, extent;
+    XMStoreFloat3(&center, XMVectorScale(XMVectorAdd(regionMin, regionMax), 0.5f));
+    XMStoreFloat3(&extent, XMVectorScale(XMVectorSubtract(regionMax, regionMin), 0.75f));
+
+    // 񓯂zuɂȂ悤ɎO̗g
+    Deterministic::Random random;
+    const float boxSize = (std::max)((std::max)(extent.x, extent.y), extent.z) * 0.01f;
+
+    VisibilityCulling culling;
+    culling.BeginFrame();
+    std::vector<AABB> bounds(ObjectCount);
+    for (AABB& box : bounds)
+    {
+        const XMFLOAT3 position = { center.x + (random.NextFloat() * 2.0f - 1.0f) * extent.x, center.y + (random.NextFloat() * 2.0f - 1.0f) * extent.y, center.z + (random.NextFloat() * 2.0f - 1.0f) * extent.z };
+        const float size = boxSize * (0.5f + random.NextFloat());
+        box.min = { position.x - size, position.y - size, position.z - size };
+        box.max = { position.x + size, position.y + size, position.z + size };
+        culling.AddBounds(box);
+    }
+    for (const VisibilityCulling::View& view : views)
+    {
+        culling.AddView(view);
+    }
+    culling.Cull();
+
+    const std::vector<VisibilityCulling::ViewStatistics> statistics = culling.Statistics();
+    for (size_t view = 0; view < culling.ViewCount(); ++view)
+    {
+        VisibilityCulling::RecordingBackend backend;
+        culling.Dispatch(culling.Visible(view), backend);
+
+        // 1 ̔Ɣׂ
+        const VisibilityCulling::Frustum frustum = VisibilityCulling::ExtractFrustum(views[view].viewProjection, views[view].isShadowCaster);
+        std::vector<uint32_t> expected;
+        for (size_t object = 0; object < ObjectCount; ++object)
+        {
+            if (VisibilityCulling::TestBounds(frustum, bounds[object]))
+            {
+                expected.push_back(static_cast<uint32_t>(object));
+            }
+        }
+        test.Check(backend.objects == expected, "the SIMD culling must draw the same objects as the scalar test");
+        test.Print("%-10s : %5zu / %5zu drawn, %.3f ms", views[view].name.c_str(), backend.objects.size(), ObjectCount, statistics[view].milliseconds);
+    }
+}
@@ -2,21 +2,54 @@
 #include "Utils/Dialog.h"
 #include "Utils/stdUtiles.h"
 
+#include <algorithm>
+
 void AudioSource::SetSource(const wchar_t* filePath)
 {
 	this->type = std::wstring(filePath).find(L"BGM") != std::wstring::npos ? SoundType::BGM : SoundType::SE;
 	this->filePath = filePath;
+
+	// Õ\[X
+	stream.reset();
+	if (sourceVoice)
+	{
+		Stop();
+		sourceVoice->DestroyVoice();
+		sourceVoice = nullptr;
+	}
+	sptrBuffer.reset();
+
+	if (type == SoundType::BGM)
+	{
+		stream = Audio::CreateStream(filePath, type);
+		stream->SetVolume(streamVolume);
+		return;
+	}
 	sptrBuffer = Audio::AudioBuffer::GetResource(filePath);
 	Audio::CreateAudioSource(sptrBuffer, &sourceVoice, type);
 }
 AudioSource::~AudioSource()
 {
-	Stop();
-	sourceVoice->DestroyVoice();
+	stream.reset();
+	if (sourceVoice)
+	{
+		Stop();
+		sourceVoice->DestroyVoice();
+	}
 }
 
 void AudioSource::Play(int loopCount)
 {
+	if (stream)
+	{
+		// ĂԂ͉Ȃ (obt@Ŗ炷Ɠ)
+		if (!stream->IsPlaying())
+		{
+			stream->Play(loopCount);
+		}
+		return;
+	}
+
 	_ASSERT_EXPR(sourceVoice, L"\[Xݒ肳Ă܂B");
 
 	HRESULT hr;
@@ -42,6 +75,12 @@ void AudioSource::Play(int loopCount)
 
 void AudioSource::Stop(bool playTails, bool waitForBufferToUnqueue)
 {
+	if (stream)
+	{
+		stream->Stop();
+		return;
+	}
+
 	XAUDIO2_VOICE_STATE voiceState{};
 	sourceVoice->GetState(&voiceState);
 	if (!voiceState.BuffersQueued)
@@ -64,12 +103,24 @@ void AudioSource::Stop(bool playTails, bool waitForBufferToUnqueue)
 
 void AudioSource::SetVolume(float volume)
 {
+	if (stream)
+	{
+		streamVolume = volume;
+		stream->SetVolume(volume);
+		return;
+	}
+
 	HRESULT hr = sourceVoice->SetVolume(volume);
 	_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 }
 
 uint32_t AudioSource::GetBufferQueueCount()
 {
+	if (stream)
+	{
+		return stream->IsPlaying() ? (std::max)(stream->GetVoice()->GetQueuedCount(), 1u) : 0u;
+	}
+
 	XAUDIO2_VOICE_STATE voiceState{};
 	sourceVoice->GetState(&voiceState);
 	return voiceState.BuffersQueued;
@@ -99,7 +150,14 @@ void AudioSource::DrawProperty()
 	}
 
 	static float volume;
-	if (sourceVoice)
+	if (stream)
+	{
+		if (ImGui::SliderFloat("Volume", &streamVolume, 0, 1)) {
+			stream->SetVolume(streamVolume);
+		}
+		ImGui::Text("Stream : %.1f KB resident / %.1f KB decoded", stream->GetResidentBytes() / 1024.0f, stream->GetDecodedBytes() / 1024.0f);
+	}
+	else if (sourceVoice)
 	{
 		sourceVoice->GetVolume(&volume);
 		if (ImGui::SliderFloat("Volume", &volume, 0, 1)) {
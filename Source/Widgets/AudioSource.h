@@ -22,6 +22,13 @@ public:
 
 	void SetLoopOption(float begin, float length)
 	{
+		// BGM ̓Xg[̃[vԂɂ
+		if (stream)
+		{
+			stream->SetLoop(begin, length);
+			return;
+		}
+
 		XAUDIO2_BUFFER* pBuffer = &sptrBuffer->buffer;
 		const WAVEFORMATEX& format = sptrBuffer->wfx.Format;
 
@@ -59,7 +66,10 @@ private:
 	SoundType type;
 
 	std::shared_ptr<Audio::AudioBuffer> sptrBuffer;
-	IXAudio2SourceVoice* sourceVoice;
+	IXAudio2SourceVoice* sourceVoice = nullptr;
+	// BGM ̓t@CŜǂ܂ɃXg[Ŗ炷
+	std::unique_ptr<AudioStream> stream;
+	float streamVolume = 1.0f;
 
 	static inline float masterVolume = 1.0f;
 	static inline float bgmVolume = 1.0f;
@@ -1,6 +1,8 @@
 #pragma once
+#include <memory>
 #include "UIComponent.h"
 #include "GameObject.h"
+#include "UIBatch.h"
 
 class Graphic;
 
@@ -8,12 +10,14 @@ class Canvas : public UIComponent
 {
 	std::vector<Graphic*> graphics;
 	std::vector<Graphic*> erases;
+	std::unique_ptr<UIBatch> batch;
 public:
 	Canvas() = default;
 	~Canvas() override = default;
 
 	void Initialize() override {
 		rect->size = { Graphics::GetScreenWidth(), Graphics::GetScreenHeight() };
+		batch = std::make_unique<UIBatch>(Graphics::GetDevice());
 	}
 
 	void Update(float elapsedTime) override {
@@ -28,6 +32,10 @@ public:
 
 		//ʃTCYXV
 		rect->size = { Graphics::GetScreenWidth(), Graphics::GetScreenHeight() };
+
+		if (batch) {
+			batch->NewFrame();
+		}
 	}
 
 	std::vector<Graphic*> GetGraphics() const {
@@ -43,10 +51,24 @@ public:
 			erases.emplace_back(graphic);
 	}
 
+	//true ̎Aq Text / Image ͂ɕ`悹ɂ̃LoX̃ob`ɂ߂
+	static inline bool enableBatching = true;
+	UIBatch* GetBatch() const { return enableBatching ? batch.get() : nullptr; }
+	//߂lp``悷iObjectManager q`IƁAMask Xe[gςOɌĂԁj
+	void FlushBatch(ID3D11DeviceContext* immediateContext) {
+		if (batch) {
+			batch->Flush(immediateContext);
+		}
+	}
+
 
 	void DrawProperty() override {
 #ifdef USE_IMGUI
 		ImGui::Text("GraphicsCount:%d", static_cast<int>(graphics.size()));
+		ImGui::Checkbox("Batching", &enableBatching);
+		if (batch) {
+			ImGui::Text("%s", batch->GetStatistics().ToString().c_str());
+		}
 #endif // USE_IMGUI
 	}
 };
\ No newline at end of file
@@ -26,7 +26,7 @@ void InputModule::Process(float deltaTime) {
     }
     //}EX̏ԂƂ̏
     {
-        if (InputSystem::GetInputState("ok", InputStateMask::Trigger, DeviceFlags::MouseOnly)) {
+        if (InputSystem::GetInputState(INPUT_ACTION("ok"), InputStateMask::Trigger, DeviceFlags::MouseOnly)) {
             pointerEventData->pointerPressRaycast = result;
             //IIuWFNgƂ̍XV
             if (result.IsValid()) {
@@ -44,7 +44,7 @@ void InputModule::Process(float deltaTime) {
             }
             eventSystem->SetSelectedGameObject(result.gameObject);
         }
-        else if (InputSystem::GetInputState("ok", InputStateMask::None, DeviceFlags::MouseOnly)) {
+        else if (InputSystem::GetInputState(INPUT_ACTION("ok"), InputStateMask::None, DeviceFlags::MouseOnly)) {
             //}EẌړʍXV
             pointerEventData->delta.x = pointerEventData->position.x - pointerEventData->lastPosition.x;
             pointerEventData->delta.y = pointerEventData->position.y - pointerEventData->lastPosition.y;
@@ -68,7 +68,7 @@ void InputModule::Process(float deltaTime) {
                 ExecuteEvent<IDragHandler>(pointerEventData->pointerDrag, pointerEventData, &IDragHandler::Execute);
             }
         }
-        else if (InputSystem::GetInputState("ok", InputStateMask::Release, DeviceFlags::MouseOnly)) {
+        else if (InputSystem::GetInputState(INPUT_ACTION("ok"), InputStateMask::Release, DeviceFlags::MouseOnly)) {
             pointerEventData->lastPress = pointerEventData->pointerPress;
             pointerEventData->pointerPress = nullptr;
 
@@ -85,7 +85,7 @@ void InputModule::Process(float deltaTime) {
     }
 
     //L[{[hQ[pbhSubmit
-    if (InputSystem::GetInputState("ok", InputStateMask::Release, DeviceFlags::KeyboardAndGamePad)) {
+    if (InputSystem::GetInputState(INPUT_ACTION("ok"), InputStateMask::Release, DeviceFlags::KeyboardAndGamePad)) {
         ExecuteEvent<ISubmitHandler>(eventSystem->GetSelectedGameObject(), axisEventData, &ISubmitHandler::Execute);
     }
 
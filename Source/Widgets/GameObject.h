@@ -18,6 +18,10 @@ public:
     virtual ~GameObject() {
         for (auto child : children) {
             child->parent = nullptr;
+            //cq̓[gɂȂ
+            if (child->manager) {
+                child->manager->OnHierarchyChanged(child);
+            }
         }
         SetParent(nullptr);
     }
@@ -53,6 +57,7 @@ public:
         std::shared_ptr<UIComponent> component = std::shared_ptr<T>(new T(args...));
         std::shared_ptr<T> instance = std::dynamic_pointer_cast<T>(component);
         _components.emplace_back(component);
+        componentSlots.clear();
         component->SetOwner(this);
         component->rect = rect;
         std::string className = typeid(T).name();
@@ -61,6 +66,10 @@ public:
         component->Awake();
         component->SetEnable(true);
         component->Initialize();
+        //Canvas Ȃǂŕ`惊Xgς
+        if (manager) {
+            manager->OnHierarchyChanged(this);
+        }
         return instance.get();
     }
 
@@ -71,12 +80,23 @@ public:
     /// <returns>R|[lgNX̃|C^[</returns>
     template<typename T>
     T* GetComponent() {
+        //^ƂɈxTĊoĂiR|[lgYj
+        const size_t slot = ComponentTypeIndex<T>();
+        if (slot < componentSlots.size() && componentSlots[slot].cached) {
+            return static_cast<T*>(componentSlots[slot].component);
+        }
+        T* found = nullptr;
         for (auto& component : _components) {
             if (T* p = dynamic_cast<T*>(component.get())) {
-                return p;
+                found = p;
+                break;
             }
         }
-        return nullptr;
+        if (slot >= componentSlots.size()) {
+            componentSlots.resize(slot + 1);
+        }
+        componentSlots[slot] = { found, true };
+        return found;
     }
     /// <summary>
     /// X}[g|C^̃R|[lg擾
@@ -166,10 +186,15 @@ public:
             newParent->children.push_back(this);
             SetActive(parent->IsActive());
         }
+        //[g̈ꗗƍXVE`惊Xg ObjectManager ɒĂ炤
+        if (manager) {
+            manager->OnHierarchyChanged(this);
+        }
     }
 private:
     friend class ObjectManager;
     friend class Canvas;
+    friend class ObjectManagerTest;
     //ׂẴR|[lgUpdate֐Ăяo
     void Update(float elapsedTime) {
         if (!removes.empty()) {
@@ -180,16 +205,22 @@ private:
                 }),
                 _components.end());
             removes.clear();
+            componentSlots.clear();
+            if (manager) {
+                manager->OnHierarchyChanged(this);
+            }
+        }
+        //DxŃ\[giтꂽj
+        auto comparePriority = [](const std::shared_ptr<UIComponent>& a, const std::shared_ptr<UIComponent>& b) {
+            if (a == nullptr && b == nullptr)
+                return false;
+            if (a == nullptr) return false;
+            if (b == nullptr) return true;
+            return a->priority < b->priority;
+            };
+        if (!std::is_sorted(_components.begin(), _components.end(), comparePriority)) {
+            std::stable_sort(_components.begin(), _components.end(), comparePriority);
         }
-        //DxŃ\[g
-        std::sort(_components.begin(), _components.end(),
-            [](const std::shared_ptr<UIComponent>& a, const std::shared_ptr<UIComponent>& b) {
-                if (a == nullptr && b == nullptr)
-                    return false;
-                if (a == nullptr) return false;
-                if (b == nullptr) return true;
-                return a->priority < b->priority;
-            });
 
         if (isActive) {
             for (auto& component : _components) {
@@ -257,6 +288,9 @@ public:
 
     bool IsActive() const { return isActive; }
 
+    // ObjectManager::Find  nullptr ɂȂԍ
+    GameObjectHandle GetHandle() const { return handle; }
+
     void SetActive(bool set) {
         isActive = set;
         for (auto& component : _components) {
@@ -289,4 +323,23 @@ private:
     std::vector<std::shared_ptr<UIComponent>> removes;
     bool isActive = true;
     bool isCreated = false;
+
+    //o^ ObjectManager  objects ̒̈ʒui폜̎ɖƓւj
+    ObjectManager* manager = nullptr;
+    size_t managerIndex = ObjectManager::InvalidIndex;
+    GameObjectHandle handle;
+
+    //GetComponent ̃LbViY͌^Ƃ̔ԍj
+    struct ComponentSlot
+    {
+        void* component = nullptr;
+        bool cached = false;
+    };
+    std::vector<ComponentSlot> componentSlots;
+    static inline size_t componentTypeCount = 0;
+    template<typename T>
+    static size_t ComponentTypeIndex() {
+        static const size_t index = componentTypeCount++;
+        return index;
+    }
 };
\ No newline at end of file
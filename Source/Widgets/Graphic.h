@@ -14,9 +14,18 @@ public:
 	}
 
 	void Awake() override {
-		gameObject->GetComponentInParent<Canvas>()->RegisterGraphic(this);
+		canvas = gameObject->GetComponentInParent<Canvas>();
+		canvas->RegisterGraphic(this);
 	}
 
+	//LoXł܂Ƃ߂ĕ`悷鎞̃ob`i܂Ƃ߂Ȃ nullptrj
+	UIBatch* GetBatch() const {
+		return canvas ? canvas->GetBatch() : nullptr;
+	}
+
+	//Mask ̋`Ŏlp` CPU Ő؂邩iłȂ̂̓VU[Ő؂j
+	virtual bool SupportsCpuClip() const { return false; }
+
 	bool Raycast(const XMFLOAT2& position) {
 		if (isRaycastTarget) {
 			return rect->Contains(position);
@@ -30,4 +39,6 @@ public:
 		ImGui::Checkbox("RaycastTarget", &isRaycastTarget);
 #endif // USE_IMGUI
 	}
+protected:
+	Canvas* canvas = nullptr;
 };
\ No newline at end of file
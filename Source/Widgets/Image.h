@@ -1,9 +1,13 @@
 #pragma once
+#include <algorithm>
+
 #include "Graphic.h"
+#include "Mask.h"
 
 #include "Engine/Utility/Win32Utils.h"
 
 #include "../Graphics/Resource/Texture.h"
+#include "../Graphics/Sprite/TextureAtlas.h"
 #include "../Graphics/Core/Shader.h"
 #include "Color.h"
 #if 1
@@ -77,6 +81,12 @@ public:
 		HRESULT hr = source ?
 			LoadTextureFromFile(device, source, shaderResourceView.ReleaseAndGetAddressOf(), &texture2dDesc) :
 			MakeDummyTexture(device, shaderResourceView.ReleaseAndGetAddressOf(), 0xFFFFFFFF, 16);
+		//AgXɍڂi_~[͔FȂ̂ŁASĂ Image  1 g񂷁j
+		atlasSolid = source == nullptr;
+		atlasView.Reset();
+		if (SUCCEEDED(hr) && !TextureAtlas::Get().Acquire(device, source ? source : L"<dummy:FFFFFFFF>", shaderResourceView.Get(), atlasRegion, atlasView)) {
+			atlasView.Reset();
+		}
 		if (reload) {
 			Initialize();
 		}
@@ -88,6 +98,15 @@ public:
 		rect->size.x = sw, rect->size.y = sh;
 	}
 
+	//ڂꂽ Image ̓AgX̃y[Wŕ`iy[W Image  1  Draw ɂ܂Ƃ܂j
+	static inline bool enableAtlas = true;
+
+	//]ĂȂ Mask ̋` CPU Ő؂
+	bool SupportsCpuClip() const override {
+		return rect->TopLeft().x == rect->BottomLeft().x && rect->TopRight().x == rect->BottomRight().x &&
+			rect->TopLeft().y == rect->TopRight().y && rect->BottomLeft().y == rect->BottomRight().y;
+	}
+
 	void Draw(ID3D11DeviceContext* immediateContext) override {
 		D3D11_VIEWPORT viewport{};
 		UINT numViewports{ 1 };
@@ -121,6 +140,27 @@ public:
 		float tx3{ sx + sw };
 		float ty3{ sy + sh };
 
+		//Mask ̋`Ő؂i]ĂȂ̂ŁAEE㉺̕ӂꂼk߂ UV ŏk߂j
+		D3D11_RECT clip{};
+		Mask* mask = gameObject->GetComponent<Mask>();
+		if (mask && mask->GetCpuClipRect(clip)) {
+			const float left = static_cast<float>(clip.left), right = static_cast<float>(clip.right);
+			const float top = static_cast<float>(clip.top), bottom = static_cast<float>(clip.bottom);
+			const float cx0 = (std::clamp)(x0, left, right), cx1 = (std::clamp)(x1, left, right);
+			const float cy0 = (std::clamp)(y0, top, bottom), cy2 = (std::clamp)(y2, top, bottom);
+			if (cx0 == cx1 || cy0 == cy2) {
+				return;
+			}
+			const float u0 = tx0 + (tx1 - tx0) * (cx0 - x0) / (x1 - x0);
+			const float u1 = tx0 + (tx1 - tx0) * (cx1 - x0) / (x1 - x0);
+			const float v0 = ty0 + (ty2 - ty0) * (cy0 - y0) / (y2 - y0);
+			const float v1 = ty0 + (ty2 - ty0) * (cy2 - y0) / (y2 - y0);
+			x0 = x2 = cx0, x1 = x3 = cx1;
+			y0 = y1 = cy0, y2 = y3 = cy2;
+			tx0 = tx2 = u0, tx1 = tx3 = u1;
+			ty0 = ty1 = v0, ty2 = ty3 = v1;
+		}
+
 		//XN[WnNDCւ̍Wϊs
 		x0 = 2.0f * x0 / viewport.Width - 1.0f;
 		y0 = 1.0f - 2.0f * y0 / viewport.Height;
@@ -131,6 +171,47 @@ public:
 		x3 = 2.0f * x3 / viewport.Width - 1.0f;
 		y3 = 1.0f - 2.0f * y3 / viewport.Height;
 
+		//eNX`WiAgXɍڂĂ΃y[W̒ UV ɂj
+		XMFLOAT2 t0{ tx0 / texture2dDesc.Width, ty0 / texture2dDesc.Height };
+		XMFLOAT2 t1{ tx1 / texture2dDesc.Width, ty1 / texture2dDesc.Height };
+		XMFLOAT2 t2{ tx2 / texture2dDesc.Width, ty2 / texture2dDesc.Height };
+		XMFLOAT2 t3{ tx3 / texture2dDesc.Width, ty3 / texture2dDesc.Height };
+		ID3D11ShaderResourceView* view = shaderResourceView.Get();
+		if (enableAtlas && atlasView) {
+			if (atlasSolid) {
+				//FȂ̂łǂǂł悢iłɂ܂Ȃ悤ɐ^񒆂ǂށj
+				const XMFLOAT2 center{ atlasRegion.U(0.5f), atlasRegion.V(0.5f) };
+				t0 = t1 = t2 = t3 = center;
+				view = atlasView.Get();
+			}
+			else if (InUnitRange(t0) && InUnitRange(t1) && InUnitRange(t2) && InUnitRange(t3)) {
+				//͈͊OǂށiJԂj͌̃eNX`ŕ`
+				for (XMFLOAT2* t : { &t0, &t1, &t2, &t3 }) {
+					*t = { atlasRegion.U(t->x), atlasRegion.V(t->y) };
+				}
+				view = atlasView.Get();
+			}
+		}
+
+		//LoX̃ob`ɂ߂ieNX` 1  Draw ɂȂj
+		if (UIBatch* batch = GetBatch()) {
+			const XMFLOAT4 c = color;
+			const UIBatch::Vertex quad[6]
+			{
+				{ { x0, y0, 0 }, c, t0 },
+				{ { x1, y1, 0 }, c, t1 },
+				{ { x2, y2, 0 }, c, t2 },
+				{ { x2, y2, 0 }, c, t2 },
+				{ { x1, y1, 0 }, c, t1 },
+				{ { x3, y3, 0 }, c, t3 },
+			};
+			batch->Add({ view, vertexShader.Get(), pixelShader.Get(), inputLayout.Get() }, quad, _countof(quad));
+			return;
+		}
+		if (view == atlasView.Get()) {
+			TextureAtlas::Get().Commit(immediateContext);
+		}
+
 		//vZʂŒ_obt@IuWFNgXV
 		HRESULT hr{ S_OK };
 		D3D11_MAPPED_SUBRESOURCE mapped_subresource{};
@@ -146,10 +227,10 @@ public:
 			vertices[3].position = { x3, y3, 0 };
 			vertices[0].color = vertices[1].color = vertices[2].color = vertices[3].color = color;
 
-			vertices[0].texcoord = { tx0 / texture2dDesc.Width,ty0 / texture2dDesc.Height };
-			vertices[1].texcoord = { tx1 / texture2dDesc.Width,ty1 / texture2dDesc.Height };
-			vertices[2].texcoord = { tx2 / texture2dDesc.Width,ty2 / texture2dDesc.Height };
-			vertices[3].texcoord = { tx3 / texture2dDesc.Width,ty3 / texture2dDesc.Height };
+			vertices[0].texcoord = t0;
+			vertices[1].texcoord = t1;
+			vertices[2].texcoord = t2;
+			vertices[3].texcoord = t3;
 		}
 		immediateContext->Unmap(vertexBuffer.Get(), 0);
 
@@ -165,7 +246,7 @@ public:
 		immediateContext->IASetInputLayout(inputLayout.Get());
 
 		//VF[_[\[X̃oCh
-		immediateContext->PSSetShaderResources(0, 1, shaderResourceView.GetAddressOf());
+		immediateContext->PSSetShaderResources(0, 1, &view);
 
 		//VF[_[̃oCh
 		immediateContext->VSSetShader(vertexShader.Get(), nullptr, 0);
@@ -206,4 +287,13 @@ private:
 	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> shaderResourceView;
 	Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayout;
 	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+
+	//AgX̃y[WiڂȂ͋j
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> atlasView;
+	TextureAtlas::Region atlasRegion;
+	bool atlasSolid = false;
+
+	static bool InUnitRange(const XMFLOAT2& t) {
+		return t.x >= 0.0f && t.x <= 1.0f && t.y >= 0.0f && t.y <= 1.0f;
+	}
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <DirectXMath.h>
 #include "UIComponent.h"
 #include "RectTransform.h"
+#include "Canvas.h"
+#include "Graphic.h"
 #include "Graphics/Core/Graphics.h"
 #include "Graphics/Core/RenderState.h"
 
@@ -13,15 +15,50 @@ public:
 	XMFLOAT2 minValue{ 0,0 };
 	XMFLOAT2 maxValue{ 1,1 };
 
+	//Image ̃IuWFNg̓VU[g킸AImage  CPU Ŏlp`؂
+	//iDraw 𕪂ȂĂ悢̂ŁAO̎lp` 1  Draw ɂ܂Ƃ߂j
+	static inline bool enableCpuClip = true;
+
 	void Begin(ID3D11DeviceContext* immediateContext) override {
+		const D3D11_RECT scissorRect = ComputeClipRect();
+		clippingOnCpu = enableCpuClip && CanClipOnCpu();
+		if (clippingOnCpu) {
+			cpuClipRect = scissorRect;
+			return;
+		}
 #if 1
-		RectTransform* maskRect = gameObject->rect;
+		//܂łɂ߂lp`̓}XNȂŕ`
+		if (Canvas* canvas = gameObject->GetComponentInParent<Canvas>()) {
+			canvas->FlushBatch(immediateContext);
+		}
 		RenderState::BindRasterizerState(immediateContext, RASTERRIZER_STATE::USE_SCISSOR_RECTS);
-		D3D11_VIEWPORT viewport{};
-		UINT numViewports{ 1 };
-		immediateContext->RSGetViewports(&numViewports, &viewport);
-		//DirectX::XMFLOAT2 _pos = maskRect->GetWorldPosition();
-		//DirectX::XMFLOAT2 _size = maskRect->GetWorldSize();
+		immediateContext->RSSetScissorRects(1, &scissorRect);
+#endif
+	}
+
+	void End(ID3D11DeviceContext* immediateContext) override {
+		if (clippingOnCpu) {
+			clippingOnCpu = false;
+			return;
+		}
+		//}XNlp``ĂXe[g߂
+		if (Canvas* canvas = gameObject->GetComponentInParent<Canvas>()) {
+			canvas->FlushBatch(immediateContext);
+		}
+		RenderState::BindRasterizerState(immediateContext, RASTERRIZER_STATE::SOLID_CULL_NONE);
+	}
+
+	//Begin`End ̊Ԃ CPU Ő؂鎞́A؂`iXN[WnjԂ
+	bool GetCpuClipRect(D3D11_RECT& rect) const {
+		if (clippingOnCpu) {
+			rect = cpuClipRect;
+		}
+		return clippingOnCpu;
+	}
+
+	//VU[`iCPU Ő؂鎞̋`ĝŁAڂ͕ςȂj
+	D3D11_RECT ComputeClipRect() const {
+		RectTransform* maskRect = gameObject->rect;
 		D3D11_RECT scissorRect{};
 
 		XMFLOAT2 size = { maskRect->UnrotatedBottomRight().x - maskRect->UnrotatedTopLeft().x, maskRect->UnrotatedBottomRight().y - maskRect->UnrotatedTopLeft().y };
@@ -37,13 +74,7 @@ public:
 		scissorRect.right = static_cast<LONG>(max(left, right));
 		scissorRect.top = static_cast<LONG>(min(top, bottom));
 		scissorRect.bottom = static_cast<LONG>(max(top, bottom));
-
-		immediateContext->RSSetScissorRects(1, &scissorRect);
-#endif
-	}
-
-	void End(ID3D11DeviceContext* immediateContext) override {
-		RenderState::BindRasterizerState(immediateContext, RASTERRIZER_STATE::SOLID_CULL_NONE);
+		return scissorRect;
 	}
 
 	void DrawProperty() override {
@@ -54,4 +85,18 @@ public:
 		ImGui::DragFloat2("maxVlaue", &maxValue.x, 0.01f, 0.0f, 1.0f);
 #endif // !USE_IMGUI
 	}
+
+private:
+	//̃IuWFNgŕ`̂S CPU Ő؂邩
+	bool CanClipOnCpu() const {
+		for (Graphic* graphic : gameObject->GetComponents<Graphic>()) {
+			if (graphic->IsEnable() && !graphic->SupportsCpuClip()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool clippingOnCpu = false;
+	D3D11_RECT cpuClipRect{};
 };
\ No newline at end of file
@@ -1,57 +1,193 @@
 #include "ObjectManager.h"
+
+#include <algorithm>
 #include <functional>
 
 #include "GameObject.h"
+#include "Canvas.h"
+#include "Engine/Debug/Profiler.h"
 #ifdef USE_IMGUI
 #include <imgui.h>
 #endif // USE_IMGUI
 
 #include "../Engine/Scene/Scene.h"
 
-void ObjectManager::Update(float elapsedTime)
+ObjectManager::~ObjectManager()
+{
+	//cIuWFNg鎞ɂ̃NXĂ΂Ȃ悤ɂ
+	for (auto& object : objects) {
+		if (object) {
+			object->manager = nullptr;
+			object->managerIndex = InvalidIndex;
+		}
+	}
+}
+
+void ObjectManager::Register(std::shared_ptr<GameObject> object)
+{
+	object->manager = this;
+	object->managerIndex = objects.size();
+	objects.emplace_back(object);
+
+	//p̕\ɓ
+	uint32_t slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slot = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+	slots[slot] = { object.get(), ++nextSerial };
+	object->handle = { slot, slots[slot].serial };
+	nameIndex.emplace(object->name, object.get());
+	idIndex[object->id] = object.get();
+
+	if (!object->parent) {
+		InsertRoot(object.get());
+	}
+	hierarchyDirty = true;
+}
+
+void ObjectManager::Unregister(GameObject* object)
 {
+	size_t index = object->managerIndex;
+	if (index == InvalidIndex || index >= objects.size() || objects[index].get() != object) {
+		return;
+	}
+	RemoveRoot(object);
+
+	//p̕\Oinh͖ɂȂj
+	if (object->handle.index < slots.size() && slots[object->handle.index].object == object) {
+		slots[object->handle.index] = {};
+		freeSlots.push_back(object->handle.index);
+	}
+	object->handle = {};
+	auto range = nameIndex.equal_range(object->name);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second == object) {
+			nameIndex.erase(it);
+			break;
+		}
+	}
+	auto id = idIndex.find(object->id);
+	if (id != idIndex.end() && id->second == object) {
+		idIndex.erase(id);
+	}
+
+	//Ɠւď
+	if (index != objects.size() - 1) {
+		objects[index] = std::move(objects.back());
+		objects[index]->managerIndex = index;
+	}
+	objects.pop_back();
+	object->manager = nullptr;
+	object->managerIndex = InvalidIndex;
+	hierarchyDirty = true;
+	++statistics.removals;
+}
+
+void ObjectManager::OnHierarchyChanged(GameObject* object)
+{
+	if (object->managerIndex != InvalidIndex) {
+		if (object->parent) {
+			RemoveRoot(object);
+		}
+		else {
+			InsertRoot(object);
+		}
+	}
+	hierarchyDirty = true;
+}
+
+bool ObjectManager::ComparePriority(const GameObject* a, const GameObject* b)
+{
+	if (a->priority != b->priority) {
+		return a->priority < b->priority;
+	}
+	return a->id < b->id;
+}
+
+void ObjectManager::InsertRoot(GameObject* object)
+{
+	if (std::find(roots.begin(), roots.end(), object) != roots.end()) {
+		return;
+	}
+	roots.insert(std::upper_bound(roots.begin(), roots.end(), object, ComparePriority), object);
+}
+
+void ObjectManager::RemoveRoot(GameObject* object)
+{
+	auto it = std::find(roots.begin(), roots.end(), object);
+	if (it != roots.end()) {
+		roots.erase(it);
+	}
+}
+
+void ObjectManager::RefreshHierarchy()
+{
+	//Dx͒ڏ̂ŁAтĂג
+	if (!std::is_sorted(roots.begin(), roots.end(), ComparePriority)) {
+		std::sort(roots.begin(), roots.end(), ComparePriority);
+		hierarchyDirty = true;
+		++statistics.resorts;
+	}
+	if (!hierarchyDirty) {
+		return;
+	}
+	hierarchyDirty = false;
+	++statistics.rebuilds;
 
+	nodes.clear();
+	std::vector<GameObject*> stack;
+	for (GameObject* root : roots) {
+		//[Diq children ̏j
+		stack.push_back(root);
+		while (!stack.empty()) {
+			GameObject* object = stack.back();
+			stack.pop_back();
+			nodes.push_back({ object, nullptr });
+			for (auto it = object->children.rbegin(); it != object->children.rend(); ++it) {
+				stack.push_back(*it);
+			}
+		}
+		//q Text / Image ߂lp`܂Ƃ߂ĕ`
+		if (Canvas* canvas = root->GetComponent<Canvas>()) {
+			nodes.back().flushCanvas = canvas;
+		}
+	}
+}
+
+void ObjectManager::Update(float elapsedTime)
+{
+	PROFILE_ZONE("ObjectManager::Update", "ui");
 	if (!erases.empty()) {
-		objects.erase(std::remove_if(objects.begin(), objects.end(),
-			[&](const auto& obj) {
-				return std::find(erases.begin(), erases.end(), obj) != erases.end();
-			}),
-			objects.end());
+		for (auto& object : erases) {
+			Unregister(object.get());
+		}
+		// GameObject 
 		erases.clear();
 	}
-	//DxŃ\[g
-	std::sort(objects.begin(), objects.end(),
-		[](const std::shared_ptr<GameObject>& a, const std::shared_ptr<GameObject>& b) {
-			return a->priority < b->priority;
-		});
+	RefreshHierarchy();
 
-	std::function<void(float, GameObject*)> Update = [&](float elapsedTime, GameObject* object)
-		{
-			object->Update(elapsedTime);
-			for (auto child : object->children) {
-				Update(elapsedTime, child);
-			}
-		};
-	for (auto& object : objects) {
-		if (!object || object->parent) continue;
-		Update(elapsedTime, object.get());
+	//rōꂽeς肵ĂÃXgōŌ܂ŉ񂷁ĩt[甽fj
+	for (size_t i = 0, count = nodes.size(); i < count; ++i) {
+		nodes[i].object->Update(elapsedTime);
 	}
 }
 
 void ObjectManager::Draw(ID3D11DeviceContext* immediateContext)
 {
-	std::function<void(ID3D11DeviceContext*, GameObject*)> Draw = [&](ID3D11DeviceContext* immediateContext, GameObject* object)
-		{
-			object->Begin(immediateContext);
-			object->Draw(immediateContext);
-			object->End(immediateContext);
-			for (auto child : object->children) {
-				Draw(immediateContext, child);
-			}
-		};
-	for (auto& object : objects) {
-		if (!object || object->parent) continue;
-		Draw(immediateContext, object.get());
+	PROFILE_ZONE("ObjectManager::Draw", "ui");
+	RefreshHierarchy();
+	for (const Node& node : nodes) {
+		node.object->Begin(immediateContext);
+		node.object->Draw(immediateContext);
+		node.object->End(immediateContext);
+		if (node.flushCanvas) {
+			node.flushCanvas->FlushBatch(immediateContext);
+		}
 	}
 }
 
@@ -126,10 +262,9 @@ void ObjectManager::DrawHierarchy()
 				}
 			};
 		
-		for (auto& object : objects) {
-			//JĂꍇAqKwɂ
-			if (!object || object->parent) continue;
-			DrawNodeTree(object.get());
+		RefreshHierarchy();
+		for (GameObject* root : roots) {
+			DrawNodeTree(root);
 		}
 	}
 	//ImGui::End();
@@ -165,7 +300,7 @@ void ObjectManager::DrawProperty()
 			}
 			ImGui::InputText("GameObjectName", buffer, sizeof(buffer), ImGuiInputTextFlags_AutoSelectAll);
 			if (ImGui::IsItemEdited()) {
-				inspectorNode->name = buffer;
+				Rename(inspectorNode, buffer);
 			}
 #else
 			ImGui::Text(inspectorNode->name.c_str());
@@ -179,22 +314,31 @@ void ObjectManager::DrawProperty()
 }
 GameObject* ObjectManager::FindGameObject(const std::string& name)
 {
-	for (auto& object : objects) {
-		if (object->name == name) {
-			return object.get();
-		}
+	auto it = nameIndex.find(name);
+	return it != nameIndex.end() ? it->second : nullptr;
+}
+GameObject* ObjectManager::FindGameObject(GameObjectHandle handle) const
+{
+	if (handle.index < slots.size() && handle.serial != 0 && slots[handle.index].serial == handle.serial) {
+		return slots[handle.index].object;
 	}
 	return nullptr;
 }
+std::shared_ptr<GameObject> ObjectManager::FindShared(const std::string& name) const
+{
+	auto it = nameIndex.find(name);
+	return it != nameIndex.end() ? objects[it->second->managerIndex] : nullptr;
+}
+std::shared_ptr<GameObject> ObjectManager::FindShared(int id) const
+{
+	auto it = idIndex.find(id);
+	return it != idIndex.end() ? objects[it->second->managerIndex] : nullptr;
+}
 GameObject* ObjectManager::Find(const std::string& name)
 {
 	if (Scene* scene = Scene::GetCurrentScene())
 	{
-		for (auto& object : scene->objectManager.objects) {
-			if (object->name == name) {
-				return object.get();
-			}
-		}
+		return scene->objectManager.FindGameObject(name);
 	}
 	return nullptr;
 }
@@ -202,11 +346,16 @@ GameObject* ObjectManager::Find(const int& id)
 {
 	if (Scene* scene = Scene::GetCurrentScene())
 	{
-		for (auto& object : scene->objectManager.objects) {
-			if (object->id == id) {
-				return object.get();
-			}
-		}
+		auto it = scene->objectManager.idIndex.find(id);
+		return it != scene->objectManager.idIndex.end() ? it->second : nullptr;
+	}
+	return nullptr;
+}
+GameObject* ObjectManager::Find(GameObjectHandle handle)
+{
+	if (Scene* scene = Scene::GetCurrentScene())
+	{
+		return scene->objectManager.FindGameObject(handle);
 	}
 	return nullptr;
 }
@@ -215,11 +364,7 @@ std::shared_ptr<GameObject> ObjectManager::Find_Ptr(const std::string& name)
 {
 	if (Scene* scene = Scene::GetCurrentScene())
 	{
-		for (auto& object : scene->objectManager.objects) {
-			if (object->name == name) {
-				return object;
-			}
-		}
+		return scene->objectManager.FindShared(name);
 	}
 	return nullptr;
 }
@@ -227,13 +372,34 @@ std::shared_ptr<GameObject> ObjectManager::Find_Ptr(const int& id)
 {
 	if (Scene* scene = Scene::GetCurrentScene())
 	{
-		for (auto& object : scene->objectManager.objects) {
-			if (object->id == id) {
-				return object;
+		return scene->objectManager.FindShared(id);
+	}
+	return nullptr;
+}
+
+void ObjectManager::Rename(GameObject* object, const std::string& name)
+{
+	if (object->manager == this) {
+		auto range = nameIndex.equal_range(object->name);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second == object) {
+				nameIndex.erase(it);
+				break;
 			}
 		}
+		nameIndex.emplace(name, object);
 	}
-	return nullptr;
+	object->name = name;
+}
+
+GameObject* GameObjectRef::Get()
+{
+	if (GameObject* object = ObjectManager::Find(handle)) {
+		return object;
+	}
+	GameObject* object = ObjectManager::Find(name);
+	handle = object ? object->GetHandle() : GameObjectHandle{};
+	return object;
 }
 
 void ObjectManager::Destroy(const std::string& name) {
@@ -255,4 +421,4 @@ void ObjectManager::DestroyChildren(GameObject* object) {
 			Destroy(child->name);
 		}
 	}
-}
\ No newline at end of file
+}
@@ -1,16 +1,49 @@
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <d3d11.h>
 class GameObject;
+class Canvas;
 
+//GameObject wԍBiV[ςj Find  nullptr ɂȂ
+struct GameObjectHandle
+{
+	uint32_t index = UINT32_MAX;	//ObjectManager  slots ̈ʒu
+	uint32_t serial = 0;			//o^ƂɈႤԍi0 ͖j
+
+	bool IsValid() const { return serial != 0; }
+	bool operator==(const GameObjectHandle& other) const { return index == other.index && serial == other.serial; }
+};
+
+//OňxTA̓nhňit[G HUD pj
+//Ă疼OŒT
+class GameObjectRef
+{
+public:
+	explicit GameObjectRef(std::string name) : name(std::move(name)) {}
+	GameObject* Get();
+	GameObject* operator->() { return Get(); }
+	explicit operator bool() { return Get() != nullptr; }
+	const std::string& GetName() const { return name; }
+private:
+	std::string name;
+	GameObjectHandle handle;
+};
+
+//UI  GameObject NX
+//[g͗Dxɕׂ܂܎A[g[DŕׂXVE`惊Xg͐eq֌Wς蒼
 class ObjectManager
 {
-	//ObjectManager() = default;
-	//~ObjectManager() { objects.clear(); }
 public:
+	ObjectManager() = default;
+	~ObjectManager();
+
+	static constexpr size_t InvalidIndex = static_cast<size_t>(-1);
+
 	void Update(float elapsedTime);
 
 	void Draw(ID3D11DeviceContext* immediateContext);
@@ -18,11 +51,17 @@ public:
 	void DrawHierarchy();
 	void DrawProperty();
 
+	//OEidEnh̕\ňiO(1)jBstatic ͍̃̕V[ ObjectManager T
 	GameObject* FindGameObject(const std::string& name);
+	GameObject* FindGameObject(GameObjectHandle handle) const;
 	static GameObject* Find(const std::string& name);
 	static GameObject* Find(const int& id);
+	static GameObject* Find(GameObjectHandle handle);
 	static std::shared_ptr<GameObject> Find_Ptr(const std::string& name);
 	static std::shared_ptr<GameObject> Find_Ptr(const int& id);
+
+	//OςiO̕\Bname 𒼐ڏ Find ŌȂȂj
+	void Rename(GameObject* object, const std::string& name);
 	
 	void Destroy(const std::string& name);
 
@@ -32,18 +71,62 @@ public:
 		selectNode = nullptr;
 		inspectorNode = nullptr;
 	}
+
+	struct Statistics
+	{
+		size_t rebuilds = 0;	//XVE`惊Xg蒼
+		size_t resorts = 0;		//[g̗Dxςĕג
+		size_t removals = 0;	//폜
+	};
+	const Statistics& GetStatistics() const { return statistics; }
+
 private:
 	void DestroyChildren(GameObject* object);
 
 	friend class Scene;
 	friend class UIFactory;
-	void Register(std::shared_ptr<GameObject> object) {
-		objects.emplace_back(object);
-	}
-	GameObject* selectNode;
-	GameObject* inspectorNode;
+	friend class GameObject;
+	//Source/Test/ObjectManagerTest.cpp \ƍXVXgm߂
+	friend class ObjectManagerTest;
+	void Register(std::shared_ptr<GameObject> object);
+	//objects OiƓւďj
+	void Unregister(GameObject* object);
+	//eq֌WER|[lgς GameObject Ă
+	void OnHierarchyChanged(GameObject* object);
+	//[g̗DxςĂגAKvȂXVE`惊Xg蒼
+	void RefreshHierarchy();
+	void InsertRoot(GameObject* object);
+	void RemoveRoot(GameObject* object);
+	static bool ComparePriority(const GameObject* a, const GameObject* b);
+	std::shared_ptr<GameObject> FindShared(const std::string& name) const;
+	std::shared_ptr<GameObject> FindShared(int id) const;
+
+	GameObject* selectNode = nullptr;
+	GameObject* inspectorNode = nullptr;
 	static inline bool lockInspector = false;
+
+	struct Node
+	{
+		GameObject* object;
+		Canvas* flushCanvas;	//[g̎q`IŁÃ[g Canvas ̃ob``
+	};
+	std::vector<GameObject*> roots;	//êȂIuWFNgiDxADx͍j
+	std::vector<Node> nodes;		//[g[Dŕׂ́ȉɍXVE`悷j
+	bool hierarchyDirty = true;
+	Statistics statistics;
+
+	//p̕\iRegister / Unregister / Rename Œj
+	struct Slot
+	{
+		GameObject* object = nullptr;
+		uint32_t serial = 0;
+	};
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+	static inline uint32_t nextSerial = 0;
+	std::unordered_multimap<std::string, GameObject*> nameIndex;
+	std::unordered_map<int, GameObject*> idIndex;
 public:
-	std::vector<std::shared_ptr<GameObject>> objects;
+	std::vector<std::shared_ptr<GameObject>> objects;	//тɈӖ͂Ȃi폜œւj
 	std::vector<std::shared_ptr<GameObject>> erases;
 };
\ No newline at end of file
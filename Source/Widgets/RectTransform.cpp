@@ -7,4 +7,16 @@ RectTransform* RectTransform::GetParent() const {
 		return nullptr;
 	//eIuWFNgRectTransformԂ
 	return gameObject->parent->rect;
+}
+
+static bool Equal(const DirectX::XMFLOAT2& a, const DirectX::XMFLOAT2& b) {
+	return a.x == b.x && a.y == b.y;
+}
+
+bool RectTransform::LayoutInput::operator==(const LayoutInput& other) const {
+	return Equal(anchoredPosition, other.anchoredPosition) && Equal(size, other.size) && Equal(pivot, other.pivot) &&
+		Equal(anchorMin, other.anchorMin) && Equal(anchorMax, other.anchorMax) &&
+		Equal(offsetMin, other.offsetMin) && Equal(offsetMax, other.offsetMax) &&
+		angle == other.angle && hasParent == other.hasParent &&
+		(!hasParent || (Equal(parentPos, other.parentPos) && Equal(parentSize, other.parentSize)));
 }
\ No newline at end of file
@@ -34,6 +34,24 @@ private:
 
 	DirectX::XMFLOAT2 offsetMin = { 0.f, 0.f };// anchorMinからのオフセット（ピクセル）
 	DirectX::XMFLOAT2 offsetMax = { 0.f, 0.f };// anchorMaxからのオフセット（ピクセル）
+
+	//前回計算した時の入力（自分の値と親の結果）。同じなら計算し直さない
+	struct LayoutInput
+	{
+		DirectX::XMFLOAT2 anchoredPosition, size, pivot, anchorMin, anchorMax, offsetMin, offsetMax;
+		float angle;
+		bool hasParent;
+		DirectX::XMFLOAT2 parentPos, parentSize;
+
+		bool operator==(const LayoutInput& other) const;
+	};
+	LayoutInput layoutInput{};
+	bool layoutValid = false;
+public:
+	//false の時は変わっていなくても毎回計算し直す（比較用）
+	static inline bool enableLayoutCache = true;
+	//実際に計算し直した回数（計測用）
+	static inline size_t layoutRecomputeCount = 0;
 public:
 	float angle = 0.0f;
 	DirectX::XMFLOAT2 size{};
@@ -48,9 +66,22 @@ public:
 	RectTransform* GetParent() const;
 
 	void Update(float elapsedTime) override {
+		//自分の値も親の位置・サイズも変わっていなければ前回の結果のまま
+		RectTransform* p = GetParent();
+		LayoutInput input{ anchoredPosition, size, pivot, anchorMin, anchorMax, offsetMin, offsetMax, angle, p != nullptr };
+		if (p) {
+			input.parentPos = p->worldPos;
+			input.parentSize = p->worldSize;
+		}
+		if (enableLayoutCache && layoutValid && input == layoutInput) {
+			return;
+		}
+		layoutInput = input;
+		layoutValid = true;
+		++layoutRecomputeCount;
 
 		//中心座標とサイズ計算
-		if (RectTransform* p = GetParent()) {
+		if (p) {
 
 			XMVECTOR parentPos = XMLoadFloat2(&p->worldPos);
 			XMVECTOR parentSize = XMLoadFloat2(&p->worldSize);
@@ -135,8 +166,13 @@ public:
 			ImGui::DragFloat2("Pos", &anchoredPosition.x);
 			ImGui::DragFloat2("Size", &size.x);
 		}
-		ImGui::DragFloat2("WorldPos", &worldPos.x);
-		ImGui::DragFloat2("WorldSize", &worldSize.x);
+		//直接書き換えた時は次の Update で計算し直す
+		if (ImGui::DragFloat2("WorldPos", &worldPos.x)) {
+			layoutValid = false;
+		}
+		if (ImGui::DragFloat2("WorldSize", &worldSize.x)) {
+			layoutValid = false;
+		}
 		
 		if (ImGui::TreeNodeEx("Anchor", ImGuiTreeNodeFlags_DefaultOpen)) {
 			XMFLOAT2 min = anchorMin;
@@ -6,21 +6,15 @@
 
 #include "Graphics/Resource/Texture.h"
 #include "Image.h"
+#include "TextLayout.h"
 #include "Utils/stdUtiles.h"
 
 class Text : public Graphic
 {
-	struct Character 
-	{
-		int x, y, width, height;
-		int xoffset, yoffset;
-		int xadvance;
-		int page, chnl;
-	};
-	std::map<wchar_t, Character> characters;
+	//Ƃ̏EsizeElineHeight
+	TextLayout::Font font;
 
 	const wchar_t* face;
-	float size;
 	int bold;
 	int italic;
 	//char* charset;
@@ -32,7 +26,6 @@ class Text : public Graphic
 	//int spacing[2];
 	//int outline;
 	//friend class InputField;
-	int lineHeight;
 public:
 	/*enum class Alignment {
 		TopLeft,
@@ -84,6 +77,8 @@ public:
 
 	//E񂹂邩
 	bool alignRight = false;
+	//𒴂ɐ܂Ԃ
+	TextLayout::HorizontalOverflow horizontalOverflow = TextLayout::HorizontalOverflow::Overflow;
 
 public:
 
@@ -97,13 +92,13 @@ public:
 			if (line.find("info") != std::string::npos) {
 				char name[256] = { 0 };
 				sscanf_s(line.c_str(), "info face=\"%255[^\"]\" size=%f bold=%d italic=%d",// ... charset=%c unicode=%d stretchH=%d smooth=%d aa=%d padding=\"%3[^\"]\" spacing=\"%1[^\"]\" outline=%d
-					name, (unsigned)_countof(name), &size, &bold, &italic/*, charset, &unicode, &stretchH, &smooth, &aa, &padding, _countof(padding), &spacing, _countof(spacing), &outline*/);
+					name, (unsigned)_countof(name), &font.size, &bold, &italic/*, charset, &unicode, &stretchH, &smooth, &aa, &padding, _countof(padding), &spacing, _countof(spacing), &outline*/);
 				std::string buffer(name);
 				std::wstring wstr = std::wstring(buffer.begin(), buffer.end());
 				face = wstr.c_str();
 			}
 			if (line.find("common") != std::string::npos) {
-				sscanf_s(line.c_str(), "common lineHeight=%d", &lineHeight);
+				sscanf_s(line.c_str(), "common lineHeight=%d", &font.lineHeight);
 			}
 			if (line.find("page id=") != std::string::npos) {
 				char fileName[256] = { 0 };
@@ -112,13 +107,13 @@ public:
 				filePath = std::wstring(str.begin(), str.end());
 			}
 			if (line.find("char") != std::string::npos) {
-				Character c{};
-				unsigned int id;
+				TextLayout::Glyph c{};
+				unsigned int id = 0;
 				//͂Đݒ
 				sscanf_s(line.c_str(), "char id=%d x=%d y=%d width=%d height=%d xoffset=%d yoffset=%d xadvance=%d page=%d chnl=%d",
 					&id, &c.x, &c.y, &c.width, &c.height, &c.xoffset, &c.yoffset, &c.xadvance, &c.page, &c.chnl);
 
-				characters[id] = c;
+				font.glyphs[static_cast<wchar_t>(id)] = c;
 			}
 		}
 
@@ -162,6 +157,8 @@ public:
 
 		hr = LoadTextureFromFile(device, filePath.c_str(), shaderResourceView.ReleaseAndGetAddressOf(), &texture2dDesc);
 		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+		font.textureWidth = static_cast<float>(texture2dDesc.Width);
+		font.textureHeight = static_cast<float>(texture2dDesc.Height);
 	}
 	~Text() override = default;
 
@@ -169,75 +166,52 @@ public:
 		rect->size = { 200,200 };
 	}
 
-	void Begin(ID3D11DeviceContext* immediateContext) override {
-		vertices.clear();
-	}
-
 	void Draw(ID3D11DeviceContext* immediateContext) override {
-		if (!alignRight)
-		{
-			XMFLOAT2 _pos = rect->UnrotatedTopLeft();
-			float x = _pos.x, y = _pos.y;
-			for (int i = 0; text.c_str()[i] != '\0'; ++i) {
-				wchar_t character = text.c_str()[i];
-				//TODO: sɁA摜͈̔͂𒴂ĂƂǉ
-				if (character == '\n') {
-					x = _pos.x;
-					y += static_cast<float>(lineHeight * lineSpacing * (fontSize / size));
-					continue;
-				}
-				if (character == L' ') {
-					//̈̕ʒuɈړ(̂)
-					x += static_cast<float>(31.0f * (fontSize / size));
-					continue;
-				}
-				const Character& c = characters[character];
-				//̕`ɕKvȒ_ݒ
-				DrawCharacter(c, x, y, immediateContext);
-				//̈̕ʒuɈړ
-				x += static_cast<float>(c.xadvance * (fontSize / size));
-			}
+		D3D11_VIEWPORT viewport{};
+		UINT numViewports{ 1 };
+		immediateContext->RSGetViewports(&numViewports, &viewport);
+
+		//EtHgTCYȂǂςגAʒuEFȂǂς_蒼
+		layout.UpdateLayout(font, text, GetLayoutSettings());
+		TextLayout::Placement placement;
+		placement.anchor = alignRight ? rect->UnrotatedTopRight() : rect->UnrotatedTopLeft();
+		//]̒S`̒S_ɂꍇ
+		placement.center = rect->GetWorldPosition();
+		placement.angle = rect->angle;
+		placement.viewportWidth = viewport.Width;
+		placement.viewportHeight = viewport.Height;
+		placement.color = color;
+		if (layout.UpdateVertices(placement)) {
+			uploaded = false;
 		}
-		else
-		{
-			for(std::wstring line : SplitTextToLines())
-			{
-				XMFLOAT2 _pos = rect->UnrotatedTopRight();
-				float x = _pos.x, y = _pos.y;
-				for (int i = static_cast<int>(line.size() - 1); i >= 0; --i) {
-					wchar_t character = line.c_str()[i];
-					//TODO: sɁA摜͈̔͂𒴂ĂƂǉ
-					if (character == '\n') {
-						x = _pos.x;
-						y += static_cast<float>(lineHeight * lineSpacing * (fontSize / size));
-						continue;
-					}
-					if (character == L' ') {
-						//̈̕ʒuɈړ(̂)
-						x -= static_cast<float>(31.0f * (fontSize / size));
-						continue;
-					}
-					const Character& c = characters[character];
-					//̕`ɕKvȒ_ݒ
-					DrawCharacter(c, x, y, immediateContext);
-					//̈̕ʒuɈړ
-					x -= static_cast<float>(c.xadvance * (fontSize / size));
-				}
-			}
+		const std::vector<TextLayout::Vertex>& vertices = layout.GetVertices();
+		if (vertices.empty()) {
+			return;
 		}
-		HRESULT hr{ S_OK };
-		D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
-		hr = immediateContext->Map(vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
-		_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
 
-		size_t vertexCount = vertices.size();
-		_ASSERT_EXPR(maxVertices >= vertexCount, "Buffer overflow");
-		Vertex* data{ reinterpret_cast<Vertex*>(mappedSubresource.pData) };
-		if (data != nullptr) {
-			const Vertex* p = vertices.data();
-			memcpy_s(data, maxVertices * sizeof(Vertex), p, vertexCount * sizeof(Vertex));
+		//LoX̃ob`ɂ߂itHg̃eLXg 1  Draw ɂȂj
+		if (UIBatch* batch = GetBatch()) {
+			batch->Add({ shaderResourceView.Get(), vertexShader.Get(), pixelShader.Get(), inputLayout.Get() }, vertices.data(), vertices.size());
+			return;
+		}
+
+		//_ς
+		if (!uploaded) {
+			HRESULT hr{ S_OK };
+			D3D11_MAPPED_SUBRESOURCE mappedSubresource{};
+			hr = immediateContext->Map(vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+			_ASSERT_EXPR(SUCCEEDED(hr), hr_trace(hr));
+
+			size_t vertexCount = vertices.size();
+			_ASSERT_EXPR(maxVertices >= vertexCount, "Buffer overflow");
+			Vertex* data{ reinterpret_cast<Vertex*>(mappedSubresource.pData) };
+			if (data != nullptr) {
+				const TextLayout::Vertex* p = vertices.data();
+				memcpy_s(data, maxVertices * sizeof(Vertex), p, vertexCount * sizeof(Vertex));
+			}
+			immediateContext->Unmap(vertexBuffer.Get(), 0);
+			uploaded = true;
 		}
-		immediateContext->Unmap(vertexBuffer.Get(), 0);
 
 		UINT stride{ sizeof(Vertex) };
 		UINT offset{ 0 };
@@ -271,35 +245,43 @@ public:
 		}
 		ImGui::Text("TextSize:%d", text.size());
 		ImGui::Text("FontName:%lc", face);
-		ImGui::Text("lineHeight:%d", lineHeight);
+		ImGui::Text("lineHeight:%d", font.lineHeight);
 		ImGui::ColorEdit4("Color", &color.r);
 		ImGui::DragFloat("FontSize", &fontSize);
+		ImGui::DragFloat("LineSpacing", &lineSpacing, 0.01f);
+		ImGui::Checkbox("AlignRight", &alignRight);
+		bool wrap = horizontalOverflow == TextLayout::HorizontalOverflow::Wrap;
+		if (ImGui::Checkbox("Wrap", &wrap)) {
+			horizontalOverflow = wrap ? TextLayout::HorizontalOverflow::Wrap : TextLayout::HorizontalOverflow::Overflow;
+		}
+		const TextLayout::Statistics& statistics = layout.GetStatistics();
+		ImGui::Text("Lines:%zu Layouts:%zu VertexBuilds:%zu", layout.GetLineCount(), statistics.layouts, statistics.vertexBuilds);
 #endif // USE_IMGUI
 	}
 
 	//J[\ʒũXN[W擾([hW)
 	void GetCursorPos(size_t cursorPos, _Out_ float& x, _Out_ float& y) {
-		XMFLOAT2 _pos = rect->UnrotatedTopLeft();
-		x = _pos.x, y = _pos.y;
-		for (size_t i = 0; i < cursorPos; ++i) {
-			wchar_t character = text.c_str()[i];
-			//TODO: sɁA摜͈̔͂𒴂ĂƂǉ
-			if (character == '\n') {
-				x = _pos.x;
-				y += static_cast<float>(lineHeight * (fontSize / size));
-				continue;
-			}
-			//̈̕ʒuɈړ
-			x += static_cast<float>(characters[character].xadvance * (fontSize / size));
-		}
+		//`ƓוisԁEE񂹁E܂Ԃ݁j̃yʒug
+		layout.UpdateLayout(font, text, GetLayoutSettings());
+		XMFLOAT2 _pos = alignRight ? rect->UnrotatedTopRight() : rect->UnrotatedTopLeft();
+		XMFLOAT2 pen = layout.GetPenPosition(cursorPos);
+		x = _pos.x + pen.x, y = _pos.y + pen.y;
 	}
 
 	//eLXg񂲂ƂɕiL"\n"̂݉sj
 	std::vector<std::wstring> SplitTextToLines() const {
 		std::vector<std::wstring> lines;
-		for (size_t i = 0; i < text.size(); i++) {
-			size_t pos = text.find(L"\n", i);
-			lines.push_back(text.substr(i, pos - i));
+		if (text.empty()) {
+			return lines;
+		}
+		size_t begin = 0;
+		while (true) {
+			size_t pos = text.find(L'\n', begin);
+			lines.push_back(text.substr(begin, pos == std::wstring::npos ? std::wstring::npos : pos - begin));
+			if (pos == std::wstring::npos) {
+				break;
+			}
+			begin = pos + 1;
 		}
 		return lines;
 	}
@@ -318,7 +300,7 @@ public:
 				currentWidth = 0.0f;
 			}
 			else {
-				float charWidth = static_cast<float>(characters[ch].xadvance * (fontSize / size));
+				float charWidth = static_cast<float>(font.Find(ch).xadvance * (fontSize / font.size));
 				if (currentWidth + charWidth > maxWidth && !currentLine.empty()) {
 					//Wrapɂ܂Ԃ
 					lines.push_back(currentLine);
@@ -337,80 +319,6 @@ public:
 		return lines;
 	}
 
-	void DrawCharacter(const Character& c, float x, float y, ID3D11DeviceContext* immediateConext) {
-		float scale = fontSize / size;
-		float dx = x + static_cast<float>(c.xoffset);
-		float dy = y + static_cast<float>(c.yoffset);
-		float dw = static_cast<float>(c.width * scale), dh = static_cast<float>(c.height * scale);
-		float sx = static_cast<float>(c.x), sy = static_cast<float>(c.y);
-		float sw = static_cast<float>(c.width), sh = static_cast<float>(c.height);
-		UINT numViewports{ 1 };
-		D3D11_VIEWPORT viewport{};
-		immediateConext->RSGetViewports(&numViewports, &viewport);
-		XMFLOAT2 pivot = rect->pivot;
-		//`̊e_̈ʒuiXN[WnjvZ
-		// left-top
-		float x0{ dx };
-		float y0{ dy };
-		// right-top
-		float x1{ dx + dw };
-		float y1{ dy };
-		// left-bottom
-		float x2{ dx };
-		float y2{ dy + dh };
-		// right-bottom
-		float x3{ dx + dw };
-		float y3{ dy + dh };
-
-		//؂ʒu
-		//left-top
-		float tx0{ sx };
-		float ty0{ sy };
-		//right-top
-		float tx1{ sx + sw };
-		float ty1{ sy };
-		//left-bottom
-		float tx2{ sx };
-		float ty2{ sy + sh };
-		//right-bottom
-		float tx3{ sx + sw };
-		float ty3{ sy + sh };
-
-		//]̒S`̒S_ɂꍇ
-		float cx = rect->GetWorldPosition().x;
-		float cy = rect->GetWorldPosition().y;
-
-		//]
-		float angle = rect->angle;
-		Rotate(x0, y0, cx, cy, angle);
-		Rotate(x1, y1, cx, cy, angle);
-		Rotate(x2, y2, cx, cy, angle);
-		Rotate(x3, y3, cx, cy, angle);
-
-		//XN[WnNDCւ̍Wϊs
-		x0 = 2.0f * x0 / viewport.Width - 1.0f;
-		y0 = 1.0f - 2.0f * y0 / viewport.Height;
-		x1 = 2.0f * x1 / viewport.Width - 1.0f;
-		y1 = 1.0f - 2.0f * y1 / viewport.Height;
-		x2 = 2.0f * x2 / viewport.Width - 1.0f;
-		y2 = 1.0f - 2.0f * y2 / viewport.Height;
-		x3 = 2.0f * x3 / viewport.Width - 1.0f;
-		y3 = 1.0f - 2.0f * y3 / viewport.Height;
-
-		float u0{ sx / texture2dDesc.Width };
-		float v0{ sy / texture2dDesc.Height };
-		float u1{ (sx + sw) / texture2dDesc.Width };
-		float v1{ (sy + sh) / texture2dDesc.Height };
-
-
-		vertices.push_back({ { x0, y0,0 }, color, { u0, v0 } });
-		vertices.push_back({ { x1, y1,0 }, color, { u1, v0 } });
-		vertices.push_back({ { x2, y2,0 }, color, { u0, v1 } });
-		vertices.push_back({ { x2, y2,0 }, color, { u0, v1 } });
-		vertices.push_back({ { x1, y1,0 }, color, { u1, v0 } });
-		vertices.push_back({ { x3, y3,0 }, color, { u1, v1 } });
-	}
-
 	void Rotate(float& x, float& y, float cx, float cy, float angle)
 	{
 		x -= cx;
@@ -432,13 +340,22 @@ public:
 private:
 	std::wstring filePath;
 	D3D11_TEXTURE2D_DESC texture2dDesc{};
-	struct Vertex
-	{
-		DirectX::XMFLOAT3 position;
-		DirectX::XMFLOAT4 color;
-		DirectX::XMFLOAT2 texcoord;
-	};
-	std::vector<Vertex> vertices;
+	//UIBatchETextLayout Ɠ_tH[}bg
+	using Vertex = TextLayout::Vertex;
+	//וƒ_̃LbV
+	TextLayout layout;
+	//layout ̒_ vertexBuffer ɏݍς݂
+	bool uploaded = false;
+
+	TextLayout::Settings GetLayoutSettings() const {
+		TextLayout::Settings settings;
+		settings.fontSize = fontSize;
+		settings.lineSpacing = lineSpacing;
+		settings.alignRight = alignRight;
+		settings.overflow = horizontalOverflow;
+		settings.wrapWidth = rect->UnrotatedTopRight().x - rect->UnrotatedTopLeft().x;
+		return settings;
+	}
 
 	Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
 	Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
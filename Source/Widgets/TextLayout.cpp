@@ -0,0 +1,169 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+const TextLayout::Glyph& TextLayout::Font::Find(wchar_t character) const
+{
+	static const Glyph empty{};
+	auto it = glyphs.find(character);
+	return it != glyphs.end() ? it->second : empty;
+}
+
+bool TextLayout::Settings::operator==(const Settings& other) const
+{
+	return fontSize == other.fontSize && lineSpacing == other.lineSpacing && alignRight == other.alignRight &&
+		overflow == other.overflow && (overflow != HorizontalOverflow::Wrap || wrapWidth == other.wrapWidth);
+}
+
+bool TextLayout::Placement::operator==(const Placement& other) const
+{
+	return anchor.x == other.anchor.x && anchor.y == other.anchor.y && center.x == other.center.x && center.y == other.center.y &&
+		angle == other.angle && viewportWidth == other.viewportWidth && viewportHeight == other.viewportHeight &&
+		color.x == other.color.x && color.y == other.color.y && color.z == other.color.z && color.w == other.color.w;
+}
+
+bool TextLayout::UpdateLayout(const Font& newFont, const std::wstring& newText, const Settings& newSettings)
+{
+	if (hasLayout && font == &newFont && settings == newSettings && text == newText) {
+		return false;
+	}
+	font = &newFont;
+	text = newText;
+	settings = newSettings;
+	lineCount = Layout(newFont, newText, newSettings, quads, &penPositions);
+	hasLayout = true;
+	hasVertices = false;
+	++statistics.layouts;
+	return true;
+}
+
+bool TextLayout::UpdateVertices(const Placement& newPlacement)
+{
+	if (hasVertices && placement == newPlacement) {
+		return false;
+	}
+	placement = newPlacement;
+	BuildVertices(quads, newPlacement, vertices);
+	hasVertices = true;
+	++statistics.vertexBuilds;
+	return true;
+}
+
+XMFLOAT2 TextLayout::GetPenPosition(size_t index) const
+{
+	if (penPositions.empty()) {
+		return { 0, 0 };
+	}
+	return penPositions[(std::min)(index, penPositions.size() - 1)];
+}
+
+size_t TextLayout::Layout(const Font& font, const std::wstring& text, const Settings& settings, std::vector<Quad>& quads, std::vector<XMFLOAT2>* penPositions)
+{
+	quads.clear();
+	if (penPositions) {
+		penPositions->assign(text.size() + 1, { 0, 0 });
+	}
+
+	const float scale = settings.fontSize / font.size;
+	const float lineAdvance = static_cast<float>(font.lineHeight * settings.lineSpacing * scale);
+	auto advance = [&](wchar_t character) {
+		//Xy[X͌Œ蕝
+		return character == L' ' ? 31.0f * scale : static_cast<float>(font.Find(character).xadvance * scale);
+		};
+
+	//1 sׂi[begin, end) ̕AE񂹂͌̕_ׂ̍֕j
+	size_t lineCount = 0;
+	auto placeLine = [&](size_t begin, size_t end) {
+		const float y = lineAdvance * lineCount;
+		float x = 0.0f;
+		float lastAdvance = 0.0f;
+		for (size_t n = 0; n < end - begin; ++n) {
+			const size_t i = settings.alignRight ? end - 1 - n : begin + n;
+			const wchar_t character = text[i];
+			if (penPositions) {
+				(*penPositions)[i] = { x, y };
+			}
+			if (character != L' ') {
+				const Glyph& c = font.Find(character);
+				Quad quad;
+				quad.x = x + static_cast<float>(c.xoffset);
+				quad.y = y + static_cast<float>(c.yoffset);
+				quad.width = static_cast<float>(c.width * scale);
+				quad.height = static_cast<float>(c.height * scale);
+				quad.u0 = static_cast<float>(c.x) / font.textureWidth;
+				quad.v0 = static_cast<float>(c.y) / font.textureHeight;
+				quad.u1 = static_cast<float>(c.x + c.width) / font.textureWidth;
+				quad.v1 = static_cast<float>(c.y + c.height) / font.textureHeight;
+				quads.push_back(quad);
+			}
+			lastAdvance = advance(character);
+			x += settings.alignRight ? -lastAdvance : lastAdvance;
+		}
+		if (penPositions) {
+			//sisEŌj̈ʒu
+			XMFLOAT2 endPosition = { 0.0f, y };
+			if (end > begin) {
+				endPosition.x = settings.alignRight ? (*penPositions)[end - 1].x + lastAdvance : x;
+			}
+			(*penPositions)[end] = endPosition;
+		}
+		++lineCount;
+		};
+
+	size_t lineBegin = 0;
+	float lineWidth = 0.0f;
+	for (size_t i = 0; i < text.size(); ++i) {
+		const wchar_t character = text[i];
+		if (character == L'\n') {
+			placeLine(lineBegin, i);
+			lineBegin = i + 1;
+			lineWidth = 0.0f;
+			continue;
+		}
+		const float width = advance(character);
+		if (settings.overflow == HorizontalOverflow::Wrap && lineWidth + width > settings.wrapWidth && i > lineBegin) {
+			//Wrap ɂ܂Ԃ
+			placeLine(lineBegin, i);
+			lineBegin = i;
+			lineWidth = 0.0f;
+		}
+		lineWidth += width;
+	}
+	placeLine(lineBegin, text.size());
+	return lineCount;
+}
+
+void TextLayout::BuildVertices(const std::vector<Quad>& quads, const Placement& placement, std::vector<Vertex>& vertices)
+{
+	vertices.resize(quads.size() * 6);
+
+	const float cos{ cosf(XMConvertToRadians(placement.angle)) };
+	const float sin{ sinf(XMConvertToRadians(placement.angle)) };
+	//]ĂAXN[WnNDCւ̍Wϊs
+	auto toNdc = [&](float x, float y) {
+		x -= placement.center.x;
+		y -= placement.center.y;
+		const float rx = cos * x + -sin * y + placement.center.x;
+		const float ry = sin * x + cos * y + placement.center.y;
+		return XMFLOAT3(2.0f * rx / placement.viewportWidth - 1.0f, 1.0f - 2.0f * ry / placement.viewportHeight, 0.0f);
+		};
+
+	Vertex* v = vertices.data();
+	for (const Quad& quad : quads) {
+		const float x = placement.anchor.x + quad.x;
+		const float y = placement.anchor.y + quad.y;
+		const XMFLOAT3 p0 = toNdc(x, y);								// left-top
+		const XMFLOAT3 p1 = toNdc(x + quad.width, y);					// right-top
+		const XMFLOAT3 p2 = toNdc(x, y + quad.height);				// left-bottom
+		const XMFLOAT3 p3 = toNdc(x + quad.width, y + quad.height);	// right-bottom
+		*v++ = { p0, placement.color, { quad.u0, quad.v0 } };
+		*v++ = { p1, placement.color, { quad.u1, quad.v0 } };
+		*v++ = { p2, placement.color, { quad.u0, quad.v1 } };
+		*v++ = { p2, placement.color, { quad.u0, quad.v1 } };
+		*v++ = { p1, placement.color, { quad.u1, quad.v0 } };
+		*v++ = { p3, placement.color, { quad.u1, quad.v1 } };
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <DirectXMath.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//eLXg̕וisEE񂹁E܂ԂE]jvZāAʂLbVĂNX
+//EtHgEݒ肪ςגAʒuE]EFEʃTCYς_蒼
+//D3D gȂ̂ŁAwbhXłvł
+class TextLayout
+{
+public:
+	//.fnt  char 1 
+	struct Glyph
+	{
+		int x, y, width, height;
+		int xoffset, yoffset;
+		int xadvance;
+		int page, chnl;
+	};
+	//.fnt ̃tHg
+	struct Font
+	{
+		std::unordered_map<wchar_t, Glyph> glyphs;
+		float size = 1.0f;
+		int lineHeight = 0;
+		float textureWidth = 1.0f;
+		float textureHeight = 1.0f;
+
+		//͑傫 0 ̃OtԂ
+		const Glyph& Find(wchar_t character) const;
+	};
+
+	enum class HorizontalOverflow
+	{
+		Overflow,	//͂ݏoĂ̂܂܁i'\n' łsj
+		Wrap,		//𒴂܂Ԃ
+	};
+
+	//וɊւݒiςגj
+	struct Settings
+	{
+		float fontSize = 64.0f;
+		float lineSpacing = 1.0f;
+		bool alignRight = false;
+		HorizontalOverflow overflow = HorizontalOverflow::Overflow;
+		float wrapWidth = 0.0f;		//Wrap ̎̕iXN[Wnj
+
+		bool operator==(const Settings& other) const;
+		bool operator!=(const Settings& other) const { return !(*this == other); }
+	};
+	//ʏ̒uiςגɒ_蒼j
+	struct Placement
+	{
+		DirectX::XMFLOAT2 anchor{};			//]O̊_i񂹂͍AE񂹂͉Ej
+		DirectX::XMFLOAT2 center{};			//]̒S
+		float angle = 0.0f;					//degree
+		float viewportWidth = 1.0f;
+		float viewportHeight = 1.0f;
+		DirectX::XMFLOAT4 color{ 1, 1, 1, 1 };
+
+		bool operator==(const Placement& other) const;
+		bool operator!=(const Placement& other) const { return !(*this == other); }
+	};
+
+	//XvCgƓ_tH[}bgiNDCj
+	struct Vertex
+	{
+		DirectX::XMFLOAT3 position;
+		DirectX::XMFLOAT4 color;
+		DirectX::XMFLOAT2 texcoord;
+	};
+
+	//׏I 1 i_̈ʒuAXN[Wnj
+	struct Quad
+	{
+		float x, y, width, height;
+		float u0, v0, u1, v1;
+	};
+
+	struct Statistics
+	{
+		size_t layouts = 0;			//ג
+		size_t vertexBuilds = 0;	//_蒼
+	};
+
+	//EtHgEݒ肪OƓȂ牽ȂBג true
+	bool UpdateLayout(const Font& font, const std::wstring& text, const Settings& settings);
+	//גuς_蒼B蒼 true
+	bool UpdateVertices(const Placement& placement);
+
+	//TRIANGLELISTA1  6 _
+	const std::vector<Vertex>& GetVertices() const { return vertices; }
+	const std::vector<Quad>& GetQuads() const { return quads; }
+	size_t GetLineCount() const { return lineCount; }
+	//index ڂ̒Õyʒui_Aindex  0`j
+	DirectX::XMFLOAT2 GetPenPosition(size_t index) const;
+
+	const Statistics& GetStatistics() const { return statistics; }
+
+	//LbVg킸ɕׂ / _
+	static size_t Layout(const Font& font, const std::wstring& text, const Settings& settings, std::vector<Quad>& quads, std::vector<DirectX::XMFLOAT2>* penPositions = nullptr);
+	static void BuildVertices(const std::vector<Quad>& quads, const Placement& placement, std::vector<Vertex>& vertices);
+
+private:
+	const Font* font = nullptr;
+	std::wstring text;
+	Settings settings;
+	Placement placement;
+	bool hasLayout = false;
+	bool hasVertices = false;
+
+	std::vector<Quad> quads;
+	std::vector<DirectX::XMFLOAT2> penPositions;
+	size_t lineCount = 0;
+	std::vector<Vertex> vertices;
+
+	Statistics statistics;
+};
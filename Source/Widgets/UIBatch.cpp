@@ -0,0 +1,90 @@
+#include "UIBatch.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "Graphics/Sprite/TextureAtlas.h"
+
+UIBatch::UIBatch(ID3D11Device* device)
+{
+	if (!device) {
+		return;
+	}
+	vertexBuffer = std::make_unique<InstanceBuffer>(device, static_cast<UINT>(sizeof(Vertex)), 6 * 1024);
+}
+
+void UIBatch::Add(const State& state, const Vertex* addVertices, size_t count)
+{
+	if (count == 0) {
+		return;
+	}
+	const UINT first = static_cast<UINT>(vertices.size());
+	vertices.insert(vertices.end(), addVertices, addVertices + count);
+	if (!ranges.empty() && ranges.back().state == state) {
+		//eNX`EVF[_[̂őO Draw ɑ
+		ranges.back().count += static_cast<UINT>(count);
+	}
+	else {
+		ranges.push_back({ state, first, static_cast<UINT>(count) });
+	}
+}
+
+void UIBatch::Flush(ID3D11DeviceContext* immediateContext)
+{
+	if (ranges.empty()) {
+		return;
+	}
+
+	//wbhX̎͐邾
+	if (vertexBuffer) {
+		//AgXɍڂ摜y[Wɏł
+		TextureAtlas::Get().Commit(immediateContext);
+
+		//SĂ̒_ 1 ŏ
+		UINT firstVertex = 0;
+		Vertex* data = static_cast<Vertex*>(vertexBuffer->Map(immediateContext, static_cast<UINT>(vertices.size()), firstVertex));
+		std::memcpy(data, vertices.data(), vertices.size() * sizeof(Vertex));
+		vertexBuffer->Unmap(immediateContext);
+		vertexBuffer->Bind(immediateContext, 0, firstVertex);
+		immediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+		State current;
+		for (const Range& range : ranges) {
+			const State& state = range.state;
+			if (state.inputLayout != current.inputLayout) {
+				immediateContext->IASetInputLayout(state.inputLayout);
+			}
+			if (state.vertexShader != current.vertexShader) {
+				immediateContext->VSSetShader(state.vertexShader, nullptr, 0);
+			}
+			if (state.pixelShader != current.pixelShader) {
+				immediateContext->PSSetShader(state.pixelShader, nullptr, 0);
+			}
+			if (state.shaderResourceView != current.shaderResourceView) {
+				immediateContext->PSSetShaderResources(0, 1, &state.shaderResourceView);
+			}
+			current = state;
+			immediateContext->Draw(range.count, range.first);
+		}
+	}
+
+	++statistics.flushes;
+	statistics.draws += ranges.size();
+	statistics.vertices += vertices.size();
+	statistics.quads += vertices.size() / 6;
+	vertices.clear();
+	ranges.clear();
+}
+
+void UIBatch::NewFrame()
+{
+	lastStatistics = statistics;
+	statistics = {};
+}
+
+std::string UIBatch::Statistics::ToString() const
+{
+	char buf[256];
+	sprintf_s(buf, "flushes:%zu draws:%zu quads:%zu vertices:%zu", flushes, draws, quads, vertices);
+	return buf;
+}
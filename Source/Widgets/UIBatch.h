@@ -0,0 +1,73 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TextLayout.h"
+#include "Graphics/Renderer/InstanceBuffer.h"
+
+//LoXƂ Text / Image ̎lp`߂āA1 ̒_obt@ł܂Ƃ߂ĕ`悷
+//eNX`EVF[_[Ԃ 1  Draw ɂ܂Ƃ߂i`揇͒ǉ̂܂܁j
+class UIBatch
+{
+public:
+	using Vertex = TextLayout::Vertex;
+
+	//`Ɏǵiꂪς鏊 Draw 𕪂j
+	struct State
+	{
+		ID3D11ShaderResourceView* shaderResourceView = nullptr;
+		ID3D11VertexShader* vertexShader = nullptr;
+		ID3D11PixelShader* pixelShader = nullptr;
+		ID3D11InputLayout* inputLayout = nullptr;
+
+		bool operator==(const State& other) const {
+			return shaderResourceView == other.shaderResourceView && vertexShader == other.vertexShader &&
+				pixelShader == other.pixelShader && inputLayout == other.inputLayout;
+		}
+	};
+
+	struct Statistics
+	{
+		size_t flushes = 0;
+		size_t draws = 0;
+		size_t quads = 0;
+		size_t vertices = 0;
+
+		std::string ToString() const;
+	};
+
+	//device  nullptr ̎͒_obt@炸AFlush ͐邾iwbhX̌vpj
+	explicit UIBatch(ID3D11Device* device);
+
+	UIBatch(const UIBatch&) = delete;
+	UIBatch& operator=(const UIBatch&) = delete;
+
+	//TRIANGLELIST ̒_i1 ̎lp` 6 _jǉ
+	void Add(const State& state, const Vertex* vertices, size_t count);
+	//߂̂`悵ċɂ
+	void Flush(ID3D11DeviceContext* immediateContext);
+
+	//1 t[̋؂iÕt[̓vcĐj
+	void NewFrame();
+	const Statistics& GetStatistics() const { return lastStatistics; }
+	//߂Ă镪 Flush  Draw ̐
+	size_t PendingDraws() const { return ranges.size(); }
+
+private:
+	struct Range
+	{
+		State state;
+		UINT first;
+		UINT count;
+	};
+	std::vector<Vertex> vertices;
+	std::vector<Range> ranges;
+
+	std::unique_ptr<InstanceBuffer> vertexBuffer;
+
+	Statistics statistics;
+	Statistics lastStatistics;
+};
@@ -1,6 +1,7 @@
 #include <time.h>
 
 #include "Engine/Framework/Framework.h"
+#include "Engine/Framework/HeadlessRunner.h"
 
 
 
@@ -23,6 +24,15 @@ int WINAPI WinMain(_In_ HINSTANCE instance, _In_opt_  HINSTANCE prev_instance, _
 	//_CrtSetBreakAlloc(####);
 #endif
 
+	// --headless : EBhE炸ɌŒ̃t[ԂŃV[XVďI (vE̊mFp)
+	// --selftest : EBhE炸 SelfTest sďI
+	if (HeadlessRunner::IsRequested(cmd_line))
+	{
+		const int exitCode = HeadlessRunner::RunFromCommandLine(cmd_line);
+		CoUninitialize();
+		return exitCode;
+	}
+
 	WNDCLASSEXW wcex{};
 	wcex.cbSize = sizeof(WNDCLASSEX);
 	wcex.style = CS_HREDRAW | CS_VREDRAW;